@@ -0,0 +1,159 @@
+/*
+ * nghttp2 - HTTP/2 C Library
+ *
+ * Copyright (c) 2015 Tatsuhiro Tsujikawa
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif /* !HAVE_CONFIG_H */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <nghttp2/nghttp2.h>
+
+/*
+ * Measures HPACK encoding throughput against the size of header
+ * table.  The input is a stream of header blocks, each of which
+ * picks header fields from a pool of distinct name/value pairs, so
+ * that the header table is kept full and most fields are found in
+ * it.
+ */
+
+#define NUM_NAMES 32
+#define POOL_SIZE 4096
+#define BLOCK_LEN 16
+#define NUM_BLOCKS 100000
+
+typedef struct {
+  char name[32];
+  char value[64];
+} header;
+
+static header pool[POOL_SIZE];
+
+static void init_pool(void) {
+  size_t i;
+
+  for (i = 0; i < POOL_SIZE; ++i) {
+    snprintf(pool[i].name, sizeof(pool[i].name), "x-benchmark-header-%zu",
+             i % NUM_NAMES);
+    snprintf(pool[i].value, sizeof(pool[i].value), "value-%zu-%08zx", i,
+             i * 2654435761u);
+  }
+}
+
+static double timespec_sub(const struct timespec *a,
+                           const struct timespec *b) {
+  return (double)(a->tv_sec - b->tv_sec) * 1e9 +
+         (double)(a->tv_nsec - b->tv_nsec);
+}
+
+static int run(size_t table_size) {
+  nghttp2_hd_deflater *deflater;
+  nghttp2_nv nva[BLOCK_LEN];
+  uint8_t buf[16384];
+  uint32_t rnd = 1;
+  size_t i, j;
+  ssize_t rv;
+  size_t total = 0;
+  struct timespec start, end;
+  double elapsed;
+
+  rv = nghttp2_hd_deflate_new(&deflater, table_size);
+  if (rv != 0) {
+    return -1;
+  }
+
+  nghttp2_hd_deflate_change_table_size(deflater, table_size);
+
+  clock_gettime(CLOCK_MONOTONIC, &start);
+
+  for (i = 0; i < NUM_BLOCKS; ++i) {
+    for (j = 0; j < BLOCK_LEN; ++j) {
+      header *h;
+
+      /* Skew the choice, so that some header fields are picked up
+         more often than others, like real traffic does. */
+      rnd = rnd * 1103515245u + 12345u;
+      h = &pool[((rnd >> 8) % POOL_SIZE) * ((rnd >> 4) & 0xf) / 16];
+
+      nva[j].name = (uint8_t *)h->name;
+      nva[j].namelen = strlen(h->name);
+      nva[j].value = (uint8_t *)h->value;
+      nva[j].valuelen = strlen(h->value);
+      nva[j].flags = NGHTTP2_NV_FLAG_NONE;
+    }
+
+    rv = nghttp2_hd_deflate_hd(deflater, buf, sizeof(buf), nva, BLOCK_LEN);
+    if (rv < 0) {
+      fprintf(stderr, "nghttp2_hd_deflate_hd() failed: %s\n",
+              nghttp2_strerror((int)rv));
+      nghttp2_hd_deflate_del(deflater);
+      return -1;
+    }
+
+    total += (size_t)rv;
+  }
+
+  clock_gettime(CLOCK_MONOTONIC, &end);
+
+  elapsed = timespec_sub(&end, &start);
+
+  printf("%10zu %12.1f %12.1f %12.2f\n", table_size,
+         elapsed / (NUM_BLOCKS * BLOCK_LEN),
+         (double)NUM_BLOCKS * BLOCK_LEN / (elapsed / 1e9) / 1e6,
+         (double)total / (NUM_BLOCKS * BLOCK_LEN));
+
+  nghttp2_hd_deflate_del(deflater);
+
+  return 0;
+}
+
+int main(int argc, char **argv) {
+  size_t table_size;
+
+  init_pool();
+
+  printf("%10s %12s %12s %12s\n", "table", "ns/header", "Mheaders/s",
+         "bytes/header");
+
+  if (argc > 1) {
+    int i;
+    for (i = 1; i < argc; ++i) {
+      if (run((size_t)strtoul(argv[i], NULL, 10)) != 0) {
+        return EXIT_FAILURE;
+      }
+    }
+    return EXIT_SUCCESS;
+  }
+
+  for (table_size = 4096; table_size <= 65536; table_size *= 2) {
+    if (run(table_size) != 0) {
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,250 @@
+/*
+ * nghttp2 - HTTP/2 C Library
+ *
+ * Copyright (c) 2015 Tatsuhiro Tsujikawa
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif /* !HAVE_CONFIG_H */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "nghttp2_map.h"
+
+/*
+ * Measures the stream map operations the session performs on a
+ * connection with many concurrent streams.  Keys are client
+ * initiated stream IDs (odd and monotonically increasing).  Each
+ * stream is allocated separately, and the order of allocation is
+ * not the order of stream ID, like the heap of long lived process.
+ * The miss phase looks up the stream IDs which are not opened yet,
+ * which session does for each incoming HEADERS opening new stream.
+ * The churn phase closes the oldest stream and opens a new one,
+ * which is what a busy long lived connection does.
+ */
+
+#define NUM_FINDS 4000000
+#define NUM_CHURNS 2000000
+
+typedef struct {
+  nghttp2_map_entry map_entry;
+  int32_t stream_id;
+  /* Make the object roughly as large as nghttp2_stream */
+  uint8_t pad[160];
+} stream;
+
+static double timespec_sub(const struct timespec *a,
+                           const struct timespec *b) {
+  return (double)(a->tv_sec - b->tv_sec) * 1e9 +
+         (double)(a->tv_nsec - b->tv_nsec);
+}
+
+static void shuffle(stream **a, size_t n, uint32_t *prnd) {
+  size_t i, j;
+  stream *t;
+
+  for (i = n - 1; i >= 1; --i) {
+    *prnd = *prnd * 1103515245u + 12345u;
+    j = (*prnd >> 4) % (i + 1);
+    t = a[j];
+    a[j] = a[i];
+    a[i] = t;
+  }
+}
+
+static int eachfun(nghttp2_map_entry *entry, void *ptr) {
+  size_t *psum = ptr;
+
+  *psum += ((stream *)entry)->stream_id;
+
+  return 0;
+}
+
+static void free_streams(stream **streams, size_t nstreams) {
+  size_t i;
+
+  for (i = 0; i < nstreams; ++i) {
+    free(streams[i]);
+  }
+
+  free(streams);
+}
+
+static int run(size_t nstreams) {
+  nghttp2_map map;
+  stream **streams;
+  size_t i;
+  uint32_t rnd = 1;
+  int32_t next_stream_id = 1;
+  size_t oldest = 0;
+  size_t sum = 0;
+  struct timespec start, end;
+  double insert_ns, find_ns, miss_ns, churn_ns, each_ns;
+  int rv;
+
+  streams = calloc(nstreams, sizeof(stream *));
+  if (streams == NULL) {
+    return -1;
+  }
+
+  for (i = 0; i < nstreams; ++i) {
+    streams[i] = malloc(sizeof(stream));
+    if (streams[i] == NULL) {
+      goto fail_alloc;
+    }
+  }
+
+  shuffle(streams, nstreams, &rnd);
+
+  if (nghttp2_map_init(&map, nghttp2_mem_default()) != 0) {
+    goto fail_alloc;
+  }
+
+  clock_gettime(CLOCK_MONOTONIC, &start);
+
+  for (i = 0; i < nstreams; ++i) {
+    streams[i]->stream_id = next_stream_id;
+    next_stream_id += 2;
+    nghttp2_map_entry_init(&streams[i]->map_entry,
+                           (key_type)streams[i]->stream_id);
+    rv = nghttp2_map_insert(&map, &streams[i]->map_entry);
+    if (rv != 0) {
+      goto fail;
+    }
+  }
+
+  clock_gettime(CLOCK_MONOTONIC, &end);
+  insert_ns = timespec_sub(&end, &start) / (double)nstreams;
+
+  clock_gettime(CLOCK_MONOTONIC, &start);
+
+  for (i = 0; i < NUM_FINDS; ++i) {
+    nghttp2_map_entry *ent;
+
+    rnd = rnd * 1103515245u + 12345u;
+    ent = nghttp2_map_find(
+        &map, (key_type)streams[(rnd >> 4) % nstreams]->stream_id);
+    if (ent == NULL) {
+      goto fail;
+    }
+    sum += ((stream *)ent)->stream_id;
+  }
+
+  clock_gettime(CLOCK_MONOTONIC, &end);
+  find_ns = timespec_sub(&end, &start) / NUM_FINDS;
+
+  clock_gettime(CLOCK_MONOTONIC, &start);
+
+  for (i = 0; i < NUM_FINDS; ++i) {
+    rnd = rnd * 1103515245u + 12345u;
+    if (nghttp2_map_find(&map, (key_type)(next_stream_id +
+                                          ((rnd >> 4) % nstreams) * 2)) !=
+        NULL) {
+      goto fail;
+    }
+  }
+
+  clock_gettime(CLOCK_MONOTONIC, &end);
+  miss_ns = timespec_sub(&end, &start) / NUM_FINDS;
+
+  clock_gettime(CLOCK_MONOTONIC, &start);
+
+  for (i = 0; i < NUM_CHURNS; ++i) {
+    stream *st = streams[oldest];
+
+    rv = nghttp2_map_remove(&map, (key_type)st->stream_id);
+    if (rv != 0) {
+      goto fail;
+    }
+
+    st->stream_id = next_stream_id;
+    next_stream_id += 2;
+    nghttp2_map_entry_init(&st->map_entry, (key_type)st->stream_id);
+    rv = nghttp2_map_insert(&map, &st->map_entry);
+    if (rv != 0) {
+      goto fail;
+    }
+
+    if (++oldest == nstreams) {
+      oldest = 0;
+    }
+  }
+
+  clock_gettime(CLOCK_MONOTONIC, &end);
+  churn_ns = timespec_sub(&end, &start) / NUM_CHURNS;
+
+  clock_gettime(CLOCK_MONOTONIC, &start);
+
+  nghttp2_map_each(&map, eachfun, &sum);
+
+  clock_gettime(CLOCK_MONOTONIC, &end);
+  each_ns = timespec_sub(&end, &start) / (double)nstreams;
+
+  printf("%10zu %12.1f %12.1f %12.1f %12.1f %12.1f\n", nstreams, insert_ns,
+         find_ns, miss_ns, churn_ns, each_ns);
+
+  /* Keep the compiler from optimizing out the lookups */
+  if (sum == 0) {
+    goto fail;
+  }
+
+  nghttp2_map_free(&map);
+  free_streams(streams, nstreams);
+
+  return 0;
+
+fail:
+  fprintf(stderr, "map operation failed\n");
+  nghttp2_map_free(&map);
+
+fail_alloc:
+  free_streams(streams, nstreams);
+
+  return -1;
+}
+
+int main(int argc, char **argv) {
+  size_t nstreams;
+
+  printf("%10s %12s %12s %12s %12s %12s\n", "streams", "insert(ns)",
+         "find(ns)", "miss(ns)", "churn(ns)", "each(ns)");
+
+  if (argc > 1) {
+    int i;
+    for (i = 1; i < argc; ++i) {
+      if (run((size_t)strtoul(argv[i], NULL, 10)) != 0) {
+        return EXIT_FAILURE;
+      }
+    }
+    return EXIT_SUCCESS;
+  }
+
+  for (nstreams = 100; nstreams <= 100000; nstreams *= 10) {
+    if (run(nstreams) != 0) {
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,1189 @@
+/*
+ * nghttp2 - HTTP/2 C Library
+ *
+ * Copyright (c) 2015 Tatsuhiro Tsujikawa
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif /* !HAVE_CONFIG_H */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <nghttp2/nghttp2.h>
+
+#include "nghttp2_hd.h"
+
+/*
+ * Microbenchmark suite for the hot paths of the library: HPACK
+ * encoding and decoding, Huffman coding, nghttp2_session_mem_recv(),
+ * nghttp2_session_mem_send() and the DATA scheduler.
+ *
+ * Each benchmark is run with increasing number of operations until
+ * it takes at least the minimum duration (-t).  The results are
+ * written to stdout in JSON, and the human readable summary to
+ * stderr.  bytes_per_op and allocs_per_op are the number of bytes
+ * and the number of times the library allocated per operation,
+ * counted by custom nghttp2_mem.  Setup, such as building the input
+ * frames, is not included.
+ *
+ * The "page" header set is the request header fields of a browser
+ * loading a page and its subresources.  The "synthetic" header set
+ * is generated by pseudo random number generator, and has many
+ * unique values, which makes dynamic table churn.
+ *
+ * Usage: nghttp2bench [-t SECONDS] [PATTERN...]
+ *
+ * If PATTERN is given, only the benchmarks whose name contains one of
+ * them are run.
+ */
+
+#define NUM_SYNTHETIC_BLOCKS 64
+#define NUM_STREAMS 64
+#define RECV_CHUNK_SIZE 16384
+#define REQUEST_BODY_LEN 1024
+#define RESPONSE_BODY_LEN 16384
+#define DATA_CHUNK_LEN 1024
+
+typedef struct {
+  nghttp2_nv *nva;
+  size_t nvlen;
+} header_block;
+
+typedef struct {
+  header_block *blocks;
+  size_t nblocks;
+} header_set;
+
+typedef struct {
+  const uint8_t *s;
+  size_t len;
+} string_ref;
+
+typedef struct {
+  struct timespec start;
+  double elapsed;
+  size_t start_nalloc, start_nbytes;
+  size_t nalloc, nbytes;
+  /* The number of operations actually performed */
+  size_t ops;
+  /* The number of input bytes processed */
+  size_t processed;
+} bench_ctx;
+
+typedef int (*bench_func)(bench_ctx *ctx, size_t n, const void *arg);
+
+typedef struct {
+  const char *name;
+  bench_func func;
+  const void *arg;
+} bench_entry;
+
+static struct {
+  size_t nalloc;
+  size_t nbytes;
+} alloc_stat;
+
+static void *counting_malloc(size_t size, void *mem_user_data) {
+  (void)mem_user_data;
+
+  ++alloc_stat.nalloc;
+  alloc_stat.nbytes += size;
+
+  return malloc(size);
+}
+
+static void counting_free(void *ptr, void *mem_user_data) {
+  (void)mem_user_data;
+
+  free(ptr);
+}
+
+static void *counting_calloc(size_t nmemb, size_t size, void *mem_user_data) {
+  (void)mem_user_data;
+
+  ++alloc_stat.nalloc;
+  alloc_stat.nbytes += nmemb * size;
+
+  return calloc(nmemb, size);
+}
+
+static void *counting_realloc(void *ptr, size_t size, void *mem_user_data) {
+  (void)mem_user_data;
+
+  ++alloc_stat.nalloc;
+  alloc_stat.nbytes += size;
+
+  return realloc(ptr, size);
+}
+
+static nghttp2_mem counting_mem = {NULL, counting_malloc, counting_free,
+                                   counting_calloc, counting_realloc};
+
+static void timer_start(bench_ctx *ctx) {
+  ctx->start_nalloc = alloc_stat.nalloc;
+  ctx->start_nbytes = alloc_stat.nbytes;
+  clock_gettime(CLOCK_MONOTONIC, &ctx->start);
+}
+
+static void timer_stop(bench_ctx *ctx) {
+  struct timespec end;
+
+  clock_gettime(CLOCK_MONOTONIC, &end);
+
+  ctx->elapsed += (double)(end.tv_sec - ctx->start.tv_sec) * 1e9 +
+                  (double)(end.tv_nsec - ctx->start.tv_nsec);
+  ctx->nalloc += alloc_stat.nalloc - ctx->start_nalloc;
+  ctx->nbytes += alloc_stat.nbytes - ctx->start_nbytes;
+}
+
+/* Request header fields of a page load, separated by NULL name */
+static const char *page_headers[] = {
+    ":method", "GET", ":scheme", "https", ":authority", "www.example.com",
+    ":path", "/", "user-agent",
+    "Mozilla/5.0 (X11; Linux x86_64; rv:38.0) Gecko/20100101 Firefox/38.0",
+    "accept", "text/html,application/xhtml+xml,application/xml;q=0.9,*/*;q=0.8",
+    "accept-language", "en-US,en;q=0.5", "accept-encoding", "gzip, deflate",
+    "cookie", "_ga=GA1.2.1536281914.1430471722; sessionid=6c2a8b0f4e91d7a3",
+    NULL,
+    ":method", "GET", ":scheme", "https", ":authority", "www.example.com",
+    ":path", "/static/css/main.css?v=20150512", "user-agent",
+    "Mozilla/5.0 (X11; Linux x86_64; rv:38.0) Gecko/20100101 Firefox/38.0",
+    "accept", "text/css,*/*;q=0.1", "accept-language", "en-US,en;q=0.5",
+    "accept-encoding", "gzip, deflate", "referer", "https://www.example.com/",
+    "cookie", "_ga=GA1.2.1536281914.1430471722; sessionid=6c2a8b0f4e91d7a3",
+    NULL,
+    ":method", "GET", ":scheme", "https", ":authority", "www.example.com",
+    ":path", "/static/js/jquery-2.1.4.min.js", "user-agent",
+    "Mozilla/5.0 (X11; Linux x86_64; rv:38.0) Gecko/20100101 Firefox/38.0",
+    "accept", "*/*", "accept-language", "en-US,en;q=0.5", "accept-encoding",
+    "gzip, deflate", "referer", "https://www.example.com/", "cookie",
+    "_ga=GA1.2.1536281914.1430471722; sessionid=6c2a8b0f4e91d7a3", NULL,
+    ":method", "GET", ":scheme", "https", ":authority", "www.example.com",
+    ":path", "/static/js/app.js?v=20150512", "user-agent",
+    "Mozilla/5.0 (X11; Linux x86_64; rv:38.0) Gecko/20100101 Firefox/38.0",
+    "accept", "*/*", "accept-language", "en-US,en;q=0.5", "accept-encoding",
+    "gzip, deflate", "referer", "https://www.example.com/", "cookie",
+    "_ga=GA1.2.1536281914.1430471722; sessionid=6c2a8b0f4e91d7a3", NULL,
+    ":method", "GET", ":scheme", "https", ":authority", "www.example.com",
+    ":path", "/static/img/logo.png", "user-agent",
+    "Mozilla/5.0 (X11; Linux x86_64; rv:38.0) Gecko/20100101 Firefox/38.0",
+    "accept", "image/png,image/*;q=0.8,*/*;q=0.5", "accept-language",
+    "en-US,en;q=0.5", "accept-encoding", "gzip, deflate", "referer",
+    "https://www.example.com/", "cookie",
+    "_ga=GA1.2.1536281914.1430471722; sessionid=6c2a8b0f4e91d7a3", NULL,
+    ":method", "GET", ":scheme", "https", ":authority", "www.example.com",
+    ":path", "/static/img/banner-1280x400.jpg", "user-agent",
+    "Mozilla/5.0 (X11; Linux x86_64; rv:38.0) Gecko/20100101 Firefox/38.0",
+    "accept", "image/png,image/*;q=0.8,*/*;q=0.5", "accept-language",
+    "en-US,en;q=0.5", "accept-encoding", "gzip, deflate", "referer",
+    "https://www.example.com/", "cookie",
+    "_ga=GA1.2.1536281914.1430471722; sessionid=6c2a8b0f4e91d7a3", NULL,
+    ":method", "GET", ":scheme", "https", ":authority", "fonts.example.net",
+    ":path", "/css?family=Open+Sans:400,700", "user-agent",
+    "Mozilla/5.0 (X11; Linux x86_64; rv:38.0) Gecko/20100101 Firefox/38.0",
+    "accept", "text/css,*/*;q=0.1", "accept-language", "en-US,en;q=0.5",
+    "accept-encoding", "gzip, deflate", "referer", "https://www.example.com/",
+    NULL,
+    ":method", "POST", ":scheme", "https", ":authority", "www.example.com",
+    ":path", "/api/v1/events", "user-agent",
+    "Mozilla/5.0 (X11; Linux x86_64; rv:38.0) Gecko/20100101 Firefox/38.0",
+    "accept", "application/json, text/javascript, */*; q=0.01",
+    "accept-language", "en-US,en;q=0.5", "accept-encoding", "gzip, deflate",
+    "content-type", "application/json; charset=UTF-8", "x-requested-with",
+    "XMLHttpRequest", "referer", "https://www.example.com/", "cookie",
+    "_ga=GA1.2.1536281914.1430471722; sessionid=6c2a8b0f4e91d7a3", NULL};
+
+static uint32_t next_random(uint32_t *prnd) {
+  *prnd = *prnd * 1103515245u + 12345u;
+  return *prnd >> 8;
+}
+
+static void nv_set(nghttp2_nv *nv, const char *name, const char *value) {
+  nv->name = (uint8_t *)name;
+  nv->namelen = strlen(name);
+  nv->value = (uint8_t *)value;
+  nv->valuelen = strlen(value);
+  nv->flags = NGHTTP2_NV_FLAG_NONE;
+}
+
+static int page_header_set_init(header_set *hs) {
+  size_t i, j, nblocks = 0;
+
+  for (i = 0; i < sizeof(page_headers) / sizeof(page_headers[0]); ++i) {
+    if (page_headers[i] == NULL) {
+      ++nblocks;
+    }
+  }
+
+  hs->blocks = calloc(nblocks, sizeof(header_block));
+  if (hs->blocks == NULL) {
+    return -1;
+  }
+  hs->nblocks = nblocks;
+
+  for (i = 0, j = 0; j < nblocks; ++j) {
+    header_block *blk = &hs->blocks[j];
+    size_t k;
+
+    for (k = i; page_headers[k]; k += 2)
+      ;
+
+    blk->nva = malloc(sizeof(nghttp2_nv) * (k - i) / 2);
+    if (blk->nva == NULL) {
+      return -1;
+    }
+
+    for (; i < k; i += 2) {
+      nv_set(&blk->nva[blk->nvlen++], page_headers[i], page_headers[i + 1]);
+    }
+
+    /* skip NULL */
+    ++i;
+  }
+
+  return 0;
+}
+
+static char *random_token(uint32_t *prnd, size_t len) {
+  static const char alphabet[] =
+      "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789-_";
+  char *s;
+  size_t i;
+
+  s = malloc(len + 1);
+  if (s == NULL) {
+    return NULL;
+  }
+
+  for (i = 0; i < len; ++i) {
+    s[i] = alphabet[next_random(prnd) % (sizeof(alphabet) - 1)];
+  }
+  s[len] = '\0';
+
+  return s;
+}
+
+/*
+ * Generates NUM_SYNTHETIC_BLOCKS request header blocks.  Every 4th
+ * block is POST, so that the streams with request body can use them.
+ * The strings are never freed.
+ */
+static int synthetic_header_set_init(header_set *hs) {
+  static const char *authorities[] = {"a.example.com", "b.example.com",
+                                      "cdn.example.org", "api.example.net"};
+  static const char *common_names[] = {"accept", "accept-encoding",
+                                       "user-agent", "cache-control",
+                                       "if-none-match", "cookie"};
+  uint32_t rnd = 1;
+  size_t i, j, nextra;
+
+  hs->blocks = calloc(NUM_SYNTHETIC_BLOCKS, sizeof(header_block));
+  if (hs->blocks == NULL) {
+    return -1;
+  }
+  hs->nblocks = NUM_SYNTHETIC_BLOCKS;
+
+  for (i = 0; i < NUM_SYNTHETIC_BLOCKS; ++i) {
+    header_block *blk = &hs->blocks[i];
+    char *path, *value, *name;
+
+    nextra = 4 + next_random(&rnd) % 9;
+
+    blk->nva = malloc(sizeof(nghttp2_nv) * (4 + nextra));
+    path = random_token(&rnd, 8 + next_random(&rnd) % 56);
+    if (blk->nva == NULL || path == NULL) {
+      return -1;
+    }
+    path[0] = '/';
+
+    nv_set(&blk->nva[0], ":method", i % 4 == 0 ? "POST" : "GET");
+    nv_set(&blk->nva[1], ":scheme", "https");
+    nv_set(&blk->nva[2], ":authority",
+           authorities[next_random(&rnd) % (sizeof(authorities) /
+                                            sizeof(authorities[0]))]);
+    nv_set(&blk->nva[3], ":path", path);
+    blk->nvlen = 4;
+
+    for (j = 0; j < nextra; ++j) {
+      /* Mix the names in static table with custom ones */
+      if (next_random(&rnd) % 2) {
+        name = (char *)common_names[next_random(&rnd) %
+                                    (sizeof(common_names) /
+                                     sizeof(common_names[0]))];
+      } else {
+        name = random_token(&rnd, 4 + next_random(&rnd) % 12);
+        if (name == NULL) {
+          return -1;
+        }
+        name[0] = 'x';
+        for (value = name; *value; ++value) {
+          if ('A' <= *value && *value <= 'Z') {
+            *value = (char)(*value + 'a' - 'A');
+          }
+        }
+      }
+
+      value = random_token(&rnd, 1 + next_random(&rnd) % 64);
+      if (value == NULL) {
+        return -1;
+      }
+
+      nv_set(&blk->nva[blk->nvlen++], name, value);
+    }
+  }
+
+  return 0;
+}
+
+static size_t header_block_len(const header_block *blk) {
+  size_t i, len = 0;
+
+  for (i = 0; i < blk->nvlen; ++i) {
+    len += blk->nva[i].namelen + blk->nva[i].valuelen;
+  }
+
+  return len;
+}
+
+static int append(uint8_t **pbuf, size_t *plen, size_t *pcap,
+                  const uint8_t *data, size_t len) {
+  uint8_t *p;
+  size_t cap;
+
+  if (*plen + len > *pcap) {
+    for (cap = *pcap ? *pcap : 4096; cap < *plen + len; cap *= 2)
+      ;
+
+    p = realloc(*pbuf, cap);
+    if (p == NULL) {
+      return -1;
+    }
+
+    *pbuf = p;
+    *pcap = cap;
+  }
+
+  memcpy(*pbuf + *plen, data, len);
+  *plen += len;
+
+  return 0;
+}
+
+static ssize_t body_read_callback(nghttp2_session *session, int32_t stream_id,
+                                  uint8_t *buf, size_t length,
+                                  uint32_t *data_flags,
+                                  nghttp2_data_source *source,
+                                  void *user_data) {
+  size_t *premaining = source->ptr;
+  size_t n;
+  (void)session;
+  (void)stream_id;
+  (void)user_data;
+
+  n = *premaining;
+  if (n > length) {
+    n = length;
+  }
+  if (n > DATA_CHUNK_LEN) {
+    n = DATA_CHUNK_LEN;
+  }
+
+  memset(buf, 'a', n);
+  *premaining -= n;
+
+  if (*premaining == 0) {
+    *data_flags |= NGHTTP2_DATA_FLAG_EOF;
+  }
+
+  return (ssize_t)n;
+}
+
+typedef struct {
+  const header_set *hs;
+  /* Every |body_interval|-th stream sends request body if nonzero */
+  size_t body_interval;
+  /* Streams form 4-ary dependency tree with various weights if
+     nonzero */
+  int priority_tree;
+} stream_mix;
+
+/*
+ * Records the bytes a client sends for NUM_STREAMS requests
+ * described by |mix|.  The client advertises the largest flow
+ * control window, so that the server can send the responses without
+ * waiting for WINDOW_UPDATE.
+ */
+static int record_client(uint8_t **pout, size_t *poutlen,
+                         const stream_mix *mix) {
+  nghttp2_session *session;
+  nghttp2_session_callbacks *callbacks;
+  nghttp2_settings_entry iv[] = {
+      {NGHTTP2_SETTINGS_INITIAL_WINDOW_SIZE, NGHTTP2_MAX_WINDOW_SIZE}};
+  nghttp2_priority_spec pri_spec;
+  nghttp2_data_provider data_prd;
+  size_t remaining[NUM_STREAMS];
+  const header_block *blk;
+  const uint8_t *data;
+  size_t i, cap = 0;
+  ssize_t len;
+  int32_t stream_id;
+  int rv;
+
+  *pout = NULL;
+  *poutlen = 0;
+
+  nghttp2_session_callbacks_new(&callbacks);
+  rv = nghttp2_session_client_new(&session, callbacks, NULL);
+  nghttp2_session_callbacks_del(callbacks);
+
+  if (rv != 0) {
+    return -1;
+  }
+
+  nghttp2_submit_settings(session, NGHTTP2_FLAG_NONE, iv,
+                          sizeof(iv) / sizeof(iv[0]));
+  nghttp2_submit_window_update(session, NGHTTP2_FLAG_NONE, 0,
+                               NGHTTP2_MAX_WINDOW_SIZE -
+                                   NGHTTP2_INITIAL_WINDOW_SIZE);
+
+  for (i = 0; i < NUM_STREAMS; ++i) {
+    blk = &mix->hs->blocks[i % mix->hs->nblocks];
+
+    if (mix->priority_tree && i > 0) {
+      nghttp2_priority_spec_init(&pri_spec, (int32_t)((i - 1) / 4 * 2 + 1),
+                                 (int32_t)(1 + i * 37 % 256), 0);
+    } else {
+      nghttp2_priority_spec_default_init(&pri_spec);
+    }
+
+    remaining[i] = REQUEST_BODY_LEN;
+    data_prd.source.ptr = &remaining[i];
+    data_prd.read_callback = body_read_callback;
+
+    stream_id = nghttp2_submit_request(
+        session, &pri_spec, blk->nva, blk->nvlen,
+        mix->body_interval && i % mix->body_interval == 0 ? &data_prd : NULL,
+        NULL);
+    if (stream_id < 0) {
+      nghttp2_session_del(session);
+      return -1;
+    }
+  }
+
+  for (;;) {
+    len = nghttp2_session_mem_send(session, &data);
+    if (len <= 0) {
+      break;
+    }
+
+    if (append(pout, poutlen, &cap, data, (size_t)len) != 0) {
+      len = -1;
+      break;
+    }
+  }
+
+  nghttp2_session_del(session);
+
+  return len < 0 ? -1 : 0;
+}
+
+static int drain(nghttp2_session *session) {
+  const uint8_t *data;
+  ssize_t len;
+
+  for (;;) {
+    len = nghttp2_session_mem_send(session, &data);
+    if (len < 0) {
+      fprintf(stderr, "nghttp2_session_mem_send() failed: %s\n",
+              nghttp2_strerror((int)len));
+      return -1;
+    }
+    if (len == 0) {
+      return 0;
+    }
+  }
+}
+
+static int bench_hpack_deflate(bench_ctx *ctx, size_t n, const void *arg) {
+  const header_set *hs = arg;
+  nghttp2_hd_deflater *deflater;
+  uint8_t *buf;
+  size_t i, buflen = 0, bound;
+  ssize_t rv;
+
+  if (nghttp2_hd_deflate_new2(&deflater, NGHTTP2_DEFAULT_HEADER_TABLE_SIZE,
+                              &counting_mem) != 0) {
+    return -1;
+  }
+
+  for (i = 0; i < hs->nblocks; ++i) {
+    bound = nghttp2_hd_deflate_bound(deflater, hs->blocks[i].nva,
+                                     hs->blocks[i].nvlen);
+    if (bound > buflen) {
+      buflen = bound;
+    }
+  }
+
+  buf = malloc(buflen);
+  if (buf == NULL) {
+    nghttp2_hd_deflate_del(deflater);
+    return -1;
+  }
+
+  timer_start(ctx);
+
+  for (i = 0; i < n; ++i) {
+    const header_block *blk = &hs->blocks[i % hs->nblocks];
+
+    rv = nghttp2_hd_deflate_hd(deflater, buf, buflen, blk->nva, blk->nvlen);
+    if (rv < 0) {
+      break;
+    }
+
+    ctx->processed += header_block_len(blk);
+  }
+
+  timer_stop(ctx);
+
+  ctx->ops = i;
+
+  free(buf);
+  nghttp2_hd_deflate_del(deflater);
+
+  return i == n ? 0 : -1;
+}
+
+static int bench_hpack_inflate(bench_ctx *ctx, size_t n, const void *arg) {
+  const header_set *hs = arg;
+  nghttp2_hd_deflater *deflater;
+  nghttp2_hd_inflater *inflater;
+  uint8_t *buf = NULL;
+  size_t *offsets;
+  size_t i, k, len = 0, cap = 0, bound;
+  uint8_t tmp[65536];
+  uint8_t *in, *end;
+  nghttp2_nv nv;
+  int inflate_flags;
+  ssize_t rv;
+
+  offsets = malloc(sizeof(size_t) * (hs->nblocks + 1));
+  if (offsets == NULL) {
+    return -1;
+  }
+
+  /* Encode the whole set once.  The inflater is reset when it wraps
+     around, so that its dynamic table matches the encoder's. */
+  nghttp2_hd_deflate_new(&deflater, NGHTTP2_DEFAULT_HEADER_TABLE_SIZE);
+
+  for (i = 0; i < hs->nblocks; ++i) {
+    offsets[i] = len;
+
+    bound = nghttp2_hd_deflate_bound(deflater, hs->blocks[i].nva,
+                                     hs->blocks[i].nvlen);
+    if (bound > sizeof(tmp)) {
+      break;
+    }
+
+    rv = nghttp2_hd_deflate_hd(deflater, tmp, sizeof(tmp), hs->blocks[i].nva,
+                               hs->blocks[i].nvlen);
+    if (rv < 0 || append(&buf, &len, &cap, tmp, (size_t)rv) != 0) {
+      break;
+    }
+  }
+  offsets[i] = len;
+
+  nghttp2_hd_deflate_del(deflater);
+
+  if (i != hs->nblocks ||
+      nghttp2_hd_inflate_new2(&inflater, &counting_mem) != 0) {
+    free(buf);
+    free(offsets);
+    return -1;
+  }
+
+  timer_start(ctx);
+
+  for (i = 0; i < n; ++i) {
+    k = i % hs->nblocks;
+    if (k == 0) {
+      nghttp2_hd_inflate_reset(inflater);
+    }
+
+    in = buf + offsets[k];
+    end = buf + offsets[k + 1];
+
+    for (;;) {
+      inflate_flags = 0;
+      rv = nghttp2_hd_inflate_hd(inflater, &nv, &inflate_flags, in,
+                                 (size_t)(end - in), 1);
+      if (rv < 0) {
+        break;
+      }
+
+      in += rv;
+
+      if (inflate_flags & NGHTTP2_HD_INFLATE_FINAL) {
+        nghttp2_hd_inflate_end_headers(inflater);
+        break;
+      }
+    }
+
+    if (rv < 0) {
+      break;
+    }
+
+    ctx->processed += offsets[k + 1] - offsets[k];
+  }
+
+  timer_stop(ctx);
+
+  ctx->ops = i;
+
+  nghttp2_hd_inflate_del(inflater);
+  free(buf);
+  free(offsets);
+
+  return i == n ? 0 : -1;
+}
+
+typedef struct {
+  string_ref *strs;
+  size_t nstrs;
+} string_set;
+
+static int bench_huffman_encode(bench_ctx *ctx, size_t n, const void *arg) {
+  const string_set *ss = arg;
+  nghttp2_bufs bufs;
+  size_t i;
+  int rv = 0;
+
+  if (nghttp2_bufs_init(&bufs, 4096, 1, &counting_mem) != 0) {
+    return -1;
+  }
+
+  timer_start(ctx);
+
+  for (i = 0; i < n; ++i) {
+    const string_ref *str = &ss->strs[i % ss->nstrs];
+
+    rv = nghttp2_hd_huff_encode(&bufs, str->s, str->len);
+    if (rv != 0) {
+      break;
+    }
+
+    nghttp2_bufs_reset(&bufs);
+
+    ctx->processed += str->len;
+  }
+
+  timer_stop(ctx);
+
+  ctx->ops = i;
+
+  nghttp2_bufs_free(&bufs);
+
+  return rv;
+}
+
+static int bench_huffman_decode(bench_ctx *ctx, size_t n, const void *arg) {
+  const string_set *ss = arg;
+  nghttp2_hd_huff_decode_context dctx;
+  nghttp2_bufs bufs, outbufs;
+  string_ref *encoded;
+  uint8_t *p;
+  size_t i;
+  ssize_t len;
+  int rv = 0;
+
+  encoded = calloc(ss->nstrs, sizeof(string_ref));
+  if (encoded == NULL) {
+    return -1;
+  }
+
+  nghttp2_bufs_init(&bufs, 4096, 1, nghttp2_mem_default());
+
+  for (i = 0; i < ss->nstrs; ++i) {
+    nghttp2_bufs_reset(&bufs);
+
+    p = NULL;
+    if (nghttp2_hd_huff_encode(&bufs, ss->strs[i].s, ss->strs[i].len) != 0 ||
+        (p = malloc((size_t)nghttp2_bufs_len(&bufs))) == NULL) {
+      rv = -1;
+      break;
+    }
+
+    encoded[i].len = (size_t)nghttp2_bufs_len(&bufs);
+    memcpy(p, bufs.head->buf.pos, encoded[i].len);
+    encoded[i].s = p;
+  }
+
+  nghttp2_bufs_free(&bufs);
+
+  if (rv != 0 || nghttp2_bufs_init(&outbufs, 4096, 1, &counting_mem) != 0) {
+    n = 0;
+    rv = -1;
+  }
+
+  if (rv == 0) {
+    timer_start(ctx);
+
+    for (i = 0; i < n; ++i) {
+      const string_ref *str = &encoded[i % ss->nstrs];
+
+      nghttp2_hd_huff_decode_context_init(&dctx);
+      len = nghttp2_hd_huff_decode(&dctx, &outbufs, str->s, str->len, 1);
+      if (len < 0) {
+        rv = -1;
+        break;
+      }
+
+      nghttp2_bufs_reset(&outbufs);
+
+      ctx->processed += str->len;
+    }
+
+    timer_stop(ctx);
+
+    ctx->ops = i;
+
+    nghttp2_bufs_free(&outbufs);
+  }
+
+  for (i = 0; i < ss->nstrs; ++i) {
+    free((uint8_t *)encoded[i].s);
+  }
+  free(encoded);
+
+  return rv;
+}
+
+static int server_new(nghttp2_session **psession) {
+  nghttp2_session_callbacks *callbacks;
+  int rv;
+
+  nghttp2_session_callbacks_new(&callbacks);
+  rv = nghttp2_session_server_new3(psession, callbacks, NULL, NULL,
+                                   &counting_mem);
+  nghttp2_session_callbacks_del(callbacks);
+
+  return rv;
+}
+
+static int recv_all(nghttp2_session *session, const uint8_t *in,
+                    size_t inlen) {
+  size_t off, len;
+  ssize_t rv;
+
+  /* Feed the input in chunks like the data read from socket */
+  for (off = 0; off < inlen; off += len) {
+    len = inlen - off < RECV_CHUNK_SIZE ? inlen - off : RECV_CHUNK_SIZE;
+
+    rv = nghttp2_session_mem_recv(session, in + off, len);
+    if (rv < 0) {
+      fprintf(stderr, "nghttp2_session_mem_recv() failed: %s\n",
+              nghttp2_strerror((int)rv));
+      return -1;
+    }
+  }
+
+  return 0;
+}
+
+/*
+ * Measures nghttp2_session_mem_recv() receiving the requests.  An
+ * operation is one request stream.
+ */
+static int bench_session_recv(bench_ctx *ctx, size_t n, const void *arg) {
+  nghttp2_session *session;
+  uint8_t *in;
+  size_t inlen;
+  int rv = 0;
+
+  if (record_client(&in, &inlen, arg) != 0) {
+    return -1;
+  }
+
+  if (server_new(&session) != 0) {
+    free(in);
+    return -1;
+  }
+
+  while (ctx->ops < n) {
+    timer_start(ctx);
+    rv = recv_all(session, in, inlen);
+    timer_stop(ctx);
+
+    if (rv != 0) {
+      break;
+    }
+
+    ctx->ops += NUM_STREAMS;
+    ctx->processed += inlen;
+
+    /* Send SETTINGS ACK and WINDOW_UPDATE, then start over with the
+       next connection */
+    rv = drain(session);
+    if (rv != 0) {
+      break;
+    }
+
+    nghttp2_session_reset(session, NULL, NULL);
+  }
+
+  nghttp2_session_del(session);
+  free(in);
+
+  return rv;
+}
+
+/*
+ * Measures nghttp2_submit_request() and nghttp2_session_mem_send()
+ * sending the requests.  An operation is one request stream.
+ */
+static int bench_session_send(bench_ctx *ctx, size_t n, const void *arg) {
+  const header_set *hs = arg;
+  nghttp2_session *session;
+  nghttp2_session_callbacks *callbacks;
+  const header_block *blk;
+  const uint8_t *data;
+  ssize_t len;
+  size_t i;
+  int rv = 0;
+
+  nghttp2_session_callbacks_new(&callbacks);
+  rv = nghttp2_session_client_new3(&session, callbacks, NULL, NULL,
+                                   &counting_mem);
+  nghttp2_session_callbacks_del(callbacks);
+
+  if (rv != 0) {
+    return -1;
+  }
+
+  while (ctx->ops < n) {
+    timer_start(ctx);
+
+    for (i = 0; i < NUM_STREAMS; ++i) {
+      blk = &hs->blocks[i % hs->nblocks];
+
+      if (nghttp2_submit_request(session, NULL, blk->nva, blk->nvlen, NULL,
+                                 NULL) < 0) {
+        rv = -1;
+        break;
+      }
+    }
+
+    while (rv == 0) {
+      len = nghttp2_session_mem_send(session, &data);
+      if (len < 0) {
+        rv = -1;
+      }
+      if (len <= 0) {
+        break;
+      }
+
+      ctx->processed += (size_t)len;
+    }
+
+    timer_stop(ctx);
+
+    if (rv != 0) {
+      break;
+    }
+
+    ctx->ops += NUM_STREAMS;
+
+    nghttp2_session_reset(session, NULL, NULL);
+  }
+
+  nghttp2_session_del(session);
+
+  return rv;
+}
+
+/*
+ * Measures nghttp2_session_mem_send() scheduling DATA frames of
+ * NUM_STREAMS responses.  An operation is one DATA frame of
+ * DATA_CHUNK_LEN bytes.
+ */
+static int bench_scheduler(bench_ctx *ctx, size_t n, const void *arg) {
+  nghttp2_session *session;
+  nghttp2_data_provider data_prd;
+  nghttp2_nv nva[1];
+  size_t remaining[NUM_STREAMS];
+  size_t i;
+  uint8_t *in;
+  size_t inlen;
+  int rv = 0;
+
+  nv_set(&nva[0], ":status", "200");
+
+  if (record_client(&in, &inlen, arg) != 0) {
+    return -1;
+  }
+
+  if (server_new(&session) != 0) {
+    free(in);
+    return -1;
+  }
+
+  data_prd.read_callback = body_read_callback;
+
+  while (ctx->ops < n) {
+    rv = recv_all(session, in, inlen);
+    if (rv != 0) {
+      break;
+    }
+
+    for (i = 0; i < NUM_STREAMS; ++i) {
+      remaining[i] = RESPONSE_BODY_LEN;
+      data_prd.source.ptr = &remaining[i];
+
+      rv = nghttp2_submit_response(session, (int32_t)(i * 2 + 1), nva, 1,
+                                   &data_prd);
+      if (rv != 0) {
+        break;
+      }
+    }
+
+    if (rv != 0) {
+      break;
+    }
+
+    timer_start(ctx);
+    rv = drain(session);
+    timer_stop(ctx);
+
+    if (rv != 0) {
+      break;
+    }
+
+    /* Exclude SETTINGS ACK, WINDOW_UPDATE and HEADERS */
+    ctx->ops += NUM_STREAMS * (RESPONSE_BODY_LEN / DATA_CHUNK_LEN);
+    ctx->processed += NUM_STREAMS * RESPONSE_BODY_LEN;
+
+    nghttp2_session_reset(session, NULL, NULL);
+  }
+
+  nghttp2_session_del(session);
+  free(in);
+
+  return rv;
+}
+
+static int string_set_init(string_set *ss, const header_set *const *hss,
+                           size_t nhss) {
+  size_t i, j, k, n = 0;
+
+  for (i = 0; i < nhss; ++i) {
+    for (j = 0; j < hss[i]->nblocks; ++j) {
+      n += hss[i]->blocks[j].nvlen * 2;
+    }
+  }
+
+  ss->strs = malloc(sizeof(string_ref) * n);
+  if (ss->strs == NULL) {
+    return -1;
+  }
+  ss->nstrs = 0;
+
+  for (i = 0; i < nhss; ++i) {
+    for (j = 0; j < hss[i]->nblocks; ++j) {
+      const header_block *blk = &hss[i]->blocks[j];
+
+      for (k = 0; k < blk->nvlen; ++k) {
+        ss->strs[ss->nstrs].s = blk->nva[k].name;
+        ss->strs[ss->nstrs++].len = blk->nva[k].namelen;
+        ss->strs[ss->nstrs].s = blk->nva[k].value;
+        ss->strs[ss->nstrs++].len = blk->nva[k].valuelen;
+      }
+    }
+  }
+
+  return 0;
+}
+
+static int matches(const char *name, char **patterns, size_t npatterns) {
+  size_t i;
+
+  if (npatterns == 0) {
+    return 1;
+  }
+
+  for (i = 0; i < npatterns; ++i) {
+    if (strstr(name, patterns[i])) {
+      return 1;
+    }
+  }
+
+  return 0;
+}
+
+/*
+ * Runs |b| with increasing number of operations until it takes at
+ * least |min_ns| nanoseconds, and prints the result of the last run.
+ */
+static int run_bench(const bench_entry *b, double min_ns, int first) {
+  bench_ctx ctx;
+  size_t n = 1, next;
+  double opns;
+
+  for (;;) {
+    memset(&ctx, 0, sizeof(ctx));
+
+    if (b->func(&ctx, n, b->arg) != 0 || ctx.ops == 0) {
+      fprintf(stderr, "%s: failed\n", b->name);
+      return -1;
+    }
+
+    if (ctx.elapsed >= min_ns || n >= 1000000000) {
+      break;
+    }
+
+    /* Predict the number of operations, and grow at most 100
+       times */
+    opns = ctx.elapsed / (double)ctx.ops;
+    if (opns <= 0) {
+      next = n * 100;
+    } else {
+      next = (size_t)(min_ns / opns * 1.2);
+    }
+    if (next > n * 100) {
+      next = n * 100;
+    }
+    if (next <= ctx.ops) {
+      next = ctx.ops + 1;
+    }
+    n = next;
+  }
+
+  printf("%s\n    {\"name\": \"%s\", \"iterations\": %zu, "
+         "\"ns_per_op\": %.2f, \"bytes_per_op\": %.2f, "
+         "\"allocs_per_op\": %.4f, \"mb_per_s\": %.2f}",
+         first ? "" : ",", b->name, ctx.ops, ctx.elapsed / (double)ctx.ops,
+         (double)ctx.nbytes / (double)ctx.ops,
+         (double)ctx.nalloc / (double)ctx.ops,
+         (double)ctx.processed / (ctx.elapsed / 1e9) / 1e6);
+
+  fprintf(stderr, "%-30s %12zu %12.1f %12.1f %10.3f %10.1f\n", b->name,
+          ctx.ops, ctx.elapsed / (double)ctx.ops,
+          (double)ctx.nbytes / (double)ctx.ops,
+          (double)ctx.nalloc / (double)ctx.ops,
+          (double)ctx.processed / (ctx.elapsed / 1e9) / 1e6);
+
+  return 0;
+}
+
+static void print_usage(FILE *out) {
+  fprintf(out, "Usage: nghttp2bench [-t SECONDS] [PATTERN...]\n");
+}
+
+int main(int argc, char **argv) {
+  header_set page, synthetic;
+  string_set strs;
+  const header_set *hss[2];
+  stream_mix page_mix = {NULL, 0, 0};
+  stream_mix mixed_mix = {NULL, 4, 0};
+  stream_mix flat_mix = {NULL, 0, 0};
+  stream_mix tree_mix = {NULL, 0, 1};
+  double min_ns = 0.5e9;
+  int c, first = 1;
+  size_t i;
+  bench_entry benches[] = {
+      {"hpack_deflate/page", bench_hpack_deflate, &page},
+      {"hpack_deflate/synthetic", bench_hpack_deflate, &synthetic},
+      {"hpack_inflate/page", bench_hpack_inflate, &page},
+      {"hpack_inflate/synthetic", bench_hpack_inflate, &synthetic},
+      {"huffman_encode", bench_huffman_encode, &strs},
+      {"huffman_decode", bench_huffman_decode, &strs},
+      {"session_recv/page", bench_session_recv, &page_mix},
+      {"session_recv/mixed", bench_session_recv, &mixed_mix},
+      {"session_send/page", bench_session_send, &page},
+      {"session_send/synthetic", bench_session_send, &synthetic},
+      {"scheduler/flat", bench_scheduler, &flat_mix},
+      {"scheduler/tree", bench_scheduler, &tree_mix},
+  };
+
+  while ((c = getopt(argc, argv, "t:h")) != -1) {
+    switch (c) {
+    case 't':
+      min_ns = strtod(optarg, NULL) * 1e9;
+      if (min_ns <= 0) {
+        fprintf(stderr, "-t: invalid argument: %s\n", optarg);
+        return EXIT_FAILURE;
+      }
+      break;
+    case 'h':
+      print_usage(stdout);
+      return EXIT_SUCCESS;
+    default:
+      print_usage(stderr);
+      return EXIT_FAILURE;
+    }
+  }
+
+  if (page_header_set_init(&page) != 0 ||
+      synthetic_header_set_init(&synthetic) != 0) {
+    fprintf(stderr, "Could not generate header sets\n");
+    return EXIT_FAILURE;
+  }
+
+  hss[0] = &page;
+  hss[1] = &synthetic;
+
+  if (string_set_init(&strs, hss, 2) != 0) {
+    fprintf(stderr, "Could not generate string set\n");
+    return EXIT_FAILURE;
+  }
+
+  page_mix.hs = &page;
+  mixed_mix.hs = &synthetic;
+  flat_mix.hs = &page;
+  tree_mix.hs = &page;
+
+  printf("{\n  \"version\": \"%s\",\n  \"benchmarks\": [",
+         nghttp2_version(0)->version_str);
+
+  fprintf(stderr, "%-30s %12s %12s %12s %10s %10s\n", "benchmark", "ops",
+          "ns/op", "bytes/op", "allocs/op", "MB/s");
+
+  for (i = 0; i < sizeof(benches) / sizeof(benches[0]); ++i) {
+    if (!matches(benches[i].name, argv + optind, (size_t)(argc - optind))) {
+      continue;
+    }
+
+    if (run_bench(&benches[i], min_ns, first) != 0) {
+      return EXIT_FAILURE;
+    }
+
+    first = 0;
+  }
+
+  printf("\n  ]\n}\n");
+
+  /* The header sets live until exit */
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,261 @@
+/*
+ * nghttp2 - HTTP/2 C Library
+ *
+ * Copyright (c) 2015 Tatsuhiro Tsujikawa
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif /* !HAVE_CONFIG_H */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <nghttp2/nghttp2.h>
+
+/*
+ * Measures throughput of nghttp2_session_mem_recv() for bursts of
+ * small frames.  The frames are fed in chunks of CHUNK_SIZE bytes
+ * like the data read from socket, so that some frames straddle the
+ * chunk boundary.
+ */
+
+#define NUM_FRAMES 4096
+#define NUM_ROUNDS 500
+#define CHUNK_SIZE 16384
+#define DATA_LEN 16
+
+typedef enum {
+  BENCH_WINDOW_UPDATE,
+  BENCH_PRIORITY,
+  BENCH_PING,
+  BENCH_DATA,
+  BENCH_MIXED
+} bench_type;
+
+static const char *bench_names[] = {"window_update", "priority", "ping",
+                                    "data", "mixed"};
+
+static uint8_t *pack_frame_hd(uint8_t *p, size_t length, uint8_t type,
+                              uint8_t flags, int32_t stream_id) {
+  *p++ = (uint8_t)(length >> 16);
+  *p++ = (uint8_t)(length >> 8);
+  *p++ = (uint8_t)length;
+  *p++ = type;
+  *p++ = flags;
+  *p++ = (uint8_t)(stream_id >> 24);
+  *p++ = (uint8_t)(stream_id >> 16);
+  *p++ = (uint8_t)(stream_id >> 8);
+  *p++ = (uint8_t)stream_id;
+
+  return p;
+}
+
+static uint8_t *pack_uint32(uint8_t *p, uint32_t n) {
+  *p++ = (uint8_t)(n >> 24);
+  *p++ = (uint8_t)(n >> 16);
+  *p++ = (uint8_t)(n >> 8);
+  *p++ = (uint8_t)n;
+
+  return p;
+}
+
+static uint8_t *pack_frame(uint8_t *p, bench_type type) {
+  switch (type) {
+  case BENCH_WINDOW_UPDATE:
+    p = pack_frame_hd(p, 4, NGHTTP2_WINDOW_UPDATE, NGHTTP2_FLAG_NONE, 0);
+    return pack_uint32(p, 1);
+  case BENCH_PRIORITY:
+    p = pack_frame_hd(p, 5, NGHTTP2_PRIORITY, NGHTTP2_FLAG_NONE, 3);
+    p = pack_uint32(p, 0);
+    *p++ = 15;
+    return p;
+  case BENCH_PING:
+    p = pack_frame_hd(p, 8, NGHTTP2_PING, NGHTTP2_FLAG_NONE, 0);
+    memset(p, 0, 8);
+    return p + 8;
+  case BENCH_DATA:
+    p = pack_frame_hd(p, DATA_LEN, NGHTTP2_DATA, NGHTTP2_FLAG_NONE, 1);
+    memset(p, 'a', DATA_LEN);
+    return p + DATA_LEN;
+  default:
+    return p;
+  }
+}
+
+static double timespec_sub(const struct timespec *a,
+                           const struct timespec *b) {
+  return (double)(a->tv_sec - b->tv_sec) * 1e9 +
+         (double)(a->tv_nsec - b->tv_nsec);
+}
+
+/* Sends the connection preface, and opens stream 1 with HEADERS */
+static int open_session(nghttp2_session *session) {
+  nghttp2_hd_deflater *deflater;
+  nghttp2_nv nva[] = {
+      {(uint8_t *)":method", (uint8_t *)"POST", 7, 4, NGHTTP2_NV_FLAG_NONE},
+      {(uint8_t *)":scheme", (uint8_t *)"https", 7, 5, NGHTTP2_NV_FLAG_NONE},
+      {(uint8_t *)":path", (uint8_t *)"/", 5, 1, NGHTTP2_NV_FLAG_NONE},
+      {(uint8_t *)":authority", (uint8_t *)"localhost", 10, 9,
+       NGHTTP2_NV_FLAG_NONE}};
+  uint8_t buf[256];
+  uint8_t *p;
+  ssize_t rv;
+
+  p = buf;
+  memcpy(p, NGHTTP2_CLIENT_MAGIC, NGHTTP2_CLIENT_MAGIC_LEN);
+  p += NGHTTP2_CLIENT_MAGIC_LEN;
+  p = pack_frame_hd(p, 0, NGHTTP2_SETTINGS, NGHTTP2_FLAG_NONE, 0);
+
+  rv = nghttp2_hd_deflate_new(&deflater, 4096);
+  if (rv != 0) {
+    return -1;
+  }
+
+  rv = nghttp2_hd_deflate_hd(deflater, p + 9,
+                             sizeof(buf) - (size_t)(p - buf) - 9, nva,
+                             sizeof(nva) / sizeof(nva[0]));
+
+  nghttp2_hd_deflate_del(deflater);
+
+  if (rv < 0) {
+    return -1;
+  }
+
+  p = pack_frame_hd(p, (size_t)rv, NGHTTP2_HEADERS, NGHTTP2_FLAG_END_HEADERS,
+                    1);
+  p += rv;
+
+  rv = nghttp2_session_mem_recv(session, buf, (size_t)(p - buf));
+  if (rv < 0) {
+    return -1;
+  }
+
+  return 0;
+}
+
+static int drain(nghttp2_session *session) {
+  const uint8_t *data;
+  ssize_t rv;
+
+  for (;;) {
+    rv = nghttp2_session_mem_send(session, &data);
+    if (rv < 0) {
+      return -1;
+    }
+    if (rv == 0) {
+      return 0;
+    }
+  }
+}
+
+static int run(bench_type type, uint8_t *frames) {
+  nghttp2_session *session;
+  nghttp2_session_callbacks *callbacks;
+  nghttp2_option *option;
+  uint8_t *p;
+  size_t i, framelen, off, n;
+  ssize_t rv;
+  struct timespec start, end;
+  double elapsed;
+
+  p = frames;
+  for (i = 0; i < NUM_FRAMES; ++i) {
+    p = pack_frame(p, type == BENCH_MIXED ? (bench_type)(i % BENCH_MIXED)
+                                          : type);
+  }
+  framelen = (size_t)(p - frames);
+
+  nghttp2_session_callbacks_new(&callbacks);
+  nghttp2_option_new(&option);
+  nghttp2_option_set_no_http_messaging(option, 1);
+
+  rv = nghttp2_session_server_new2(&session, callbacks, NULL, option);
+
+  nghttp2_option_del(option);
+  nghttp2_session_callbacks_del(callbacks);
+
+  if (rv != 0 || open_session(session) != 0) {
+    fprintf(stderr, "Could not initialize session\n");
+    return -1;
+  }
+
+  clock_gettime(CLOCK_MONOTONIC, &start);
+
+  for (i = 0; i < NUM_ROUNDS; ++i) {
+    for (off = 0; off < framelen; off += n) {
+      n = framelen - off < CHUNK_SIZE ? framelen - off : CHUNK_SIZE;
+
+      rv = nghttp2_session_mem_recv(session, frames + off, n);
+      if (rv < 0) {
+        fprintf(stderr, "nghttp2_session_mem_recv() failed: %s\n",
+                nghttp2_strerror((int)rv));
+        nghttp2_session_del(session);
+        return -1;
+      }
+
+      /* Send PING ACK and WINDOW_UPDATE, so that they do not pile
+         up */
+      if (drain(session) != 0) {
+        nghttp2_session_del(session);
+        return -1;
+      }
+    }
+  }
+
+  clock_gettime(CLOCK_MONOTONIC, &end);
+
+  elapsed = timespec_sub(&end, &start);
+
+  printf("%14s %12.1f %12.2f %12.1f\n", bench_names[type],
+         elapsed / ((double)NUM_FRAMES * NUM_ROUNDS),
+         (double)NUM_FRAMES * NUM_ROUNDS / (elapsed / 1e9) / 1e6,
+         (double)framelen * NUM_ROUNDS / (elapsed / 1e9) / 1e6);
+
+  nghttp2_session_del(session);
+
+  return 0;
+}
+
+int main(void) {
+  uint8_t *frames;
+  int i;
+
+  frames = malloc(NUM_FRAMES * (9 + DATA_LEN));
+  if (frames == NULL) {
+    return EXIT_FAILURE;
+  }
+
+  printf("%14s %12s %12s %12s\n", "frame", "ns/frame", "Mframes/s", "MB/s");
+
+  for (i = BENCH_WINDOW_UPDATE; i <= BENCH_MIXED; ++i) {
+    if (run((bench_type)i, frames) != 0) {
+      free(frames);
+      return EXIT_FAILURE;
+    }
+  }
+
+  free(frames);
+
+  return EXIT_SUCCESS;
+}
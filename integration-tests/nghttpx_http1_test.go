@@ -162,6 +162,47 @@ func TestH1H1GracefulShutdown(t *testing.T) {
 	}
 }
 
+// TestH1H1Reuseport tests that workers which have their own
+// listening sockets with --reuseport serve requests, and shut down
+// gracefully.
+func TestH1H1Reuseport(t *testing.T) {
+	st := newServerTester([]string{"--reuseport", "-n2"}, t, noopHandler)
+	defer st.Close()
+
+	// Each request uses new connection, so that both workers are
+	// likely to accept some.
+	client := &http.Client{
+		Transport: &http.Transport{DisableKeepAlives: true},
+	}
+	for i := 0; i < 8; i++ {
+		res, err := client.Get(st.url)
+		if err != nil {
+			t.Fatalf("Error client.Get(%v) = %v", st.url, err)
+		}
+		res.Body.Close()
+		if got, want := res.StatusCode, 200; got != want {
+			t.Errorf("status: %v; want %v", got, want)
+		}
+	}
+
+	st.cmd.Process.Signal(syscall.SIGQUIT)
+
+	res, err := st.http1(requestParam{
+		name: "TestH1H1Reuseport",
+	})
+	if err != nil {
+		t.Fatalf("Error st.http1() = %v", err)
+	}
+
+	if got, want := res.status, 200; got != want {
+		t.Errorf("status: %v; want %v", got, want)
+	}
+
+	if got, want := res.connClose, true; got != want {
+		t.Errorf("res.connClose: %v; want %v", got, want)
+	}
+}
+
 // TestH1H1HostRewrite tests that server rewrites Host header field
 func TestH1H1HostRewrite(t *testing.T) {
 	st := newServerTester(nil, t, func(w http.ResponseWriter, r *http.Request) {
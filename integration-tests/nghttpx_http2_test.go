@@ -7,10 +7,13 @@ import (
 	"github.com/bradfitz/http2/hpack"
 	"io"
 	"io/ioutil"
+	"net"
 	"net/http"
+	"net/http/httptest"
 	"strings"
 	"syscall"
 	"testing"
+	"time"
 )
 
 // TestH2H1PlainGET tests whether simple HTTP/2 GET request works.
@@ -404,6 +407,114 @@ func TestH2H1ConnectFailure(t *testing.T) {
 	}
 }
 
+// TestH2H1RouteHostWithPort tests that the request host pattern
+// matches :authority which has port.
+func TestH2H1RouteHostWithPort(t *testing.T) {
+	ts := httptest.NewServer(http.HandlerFunc(func(w http.ResponseWriter, r *http.Request) {
+		w.Header().Add("backend", "host")
+	}))
+	defer ts.Close()
+
+	b := "-b" + strings.Replace(ts.Listener.Addr().String(), ":", ",", -1) + ";example.com/"
+
+	st := newServerTester([]string{b}, t, func(w http.ResponseWriter, r *http.Request) {
+		w.Header().Add("backend", "catch-all")
+	})
+	defer st.Close()
+
+	for _, tc := range []struct {
+		authority string
+		want      string
+	}{
+		{"example.com:3000", "host"},
+		{"EXAMPLE.COM", "host"},
+		{"[::1]:3000", "catch-all"},
+		{st.authority, "catch-all"},
+	} {
+		res, err := st.http2(requestParam{
+			name:      "TestH2H1RouteHostWithPort",
+			authority: tc.authority,
+		})
+		if err != nil {
+			t.Fatalf("Error st.http2() = %v", err)
+		}
+		if got, want := res.status, 200; got != want {
+			t.Errorf("%v: status: %v; want %v", tc.authority, got, want)
+		}
+		if got := res.header.Get("backend"); got != tc.want {
+			t.Errorf("%v: backend: %v; want %v", tc.authority, got, tc.want)
+		}
+	}
+}
+
+// TestH2H1HealthCheck tests that server stops sending requests to the
+// backend which fails health check, and resumes when the backend
+// passes health check again.
+func TestH2H1HealthCheck(t *testing.T) {
+	handler := http.HandlerFunc(func(w http.ResponseWriter, r *http.Request) {
+		w.Header().Add("backend", "checked")
+	})
+	ts := httptest.NewServer(handler)
+	addr := ts.Listener.Addr().String()
+
+	st := newServerTester([]string{
+		"-b" + strings.Replace(addr, ":", ",", -1),
+		"--backend-health-check-interval=100ms",
+		"--backend-health-check-fall=2",
+		"--backend-health-check-rise=2",
+		"--backend-health-check-path=/",
+	}, t, noopHandler)
+	defer st.Close()
+
+	// countChecked makes 4 requests, and returns the number of them
+	// served by the checked backend.
+	countChecked := func() int {
+		n := 0
+		for i := 0; i < 4; i++ {
+			res, err := st.http2(requestParam{
+				name: "TestH2H1HealthCheck",
+			})
+			if err != nil {
+				t.Fatalf("Error st.http2() = %v", err)
+			}
+			if got, want := res.status, 200; got != want {
+				t.Errorf("status: %v; want %v", got, want)
+			}
+			if res.header.Get("backend") == "checked" {
+				n++
+			}
+		}
+		return n
+	}
+
+	if got := countChecked(); got == 0 {
+		t.Errorf("healthy backend got no request")
+	}
+
+	ts.Close()
+	time.Sleep(time.Second)
+
+	if got := countChecked(); got != 0 {
+		t.Errorf("unhealthy backend got %v requests; want 0", got)
+	}
+
+	l, err := net.Listen("tcp", addr)
+	if err != nil {
+		t.Fatalf("Error net.Listen(%v) = %v", addr, err)
+	}
+	ts = httptest.NewUnstartedServer(handler)
+	ts.Listener.Close()
+	ts.Listener = l
+	ts.Start()
+	defer ts.Close()
+
+	time.Sleep(time.Second)
+
+	if got := countChecked(); got == 0 {
+		t.Errorf("recovered backend got no request")
+	}
+}
+
 // TestH2H1InvalidMethod tests that server rejects invalid method with
 // 501.
 func TestH2H1InvalidMethod(t *testing.T) {
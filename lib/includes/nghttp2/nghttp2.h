@@ -454,6 +454,49 @@ typedef struct {
   uint8_t flags;
 } nghttp2_nv;
 
+/**
+ * @struct
+ *
+ * The refcounted header field.  This is an opaque type, and it holds
+ * the name/value pair emitted by HPACK inflater.  The header field in
+ * dynamic header table is shared with it, rather than copied.  Use
+ * `nghttp2_rcnv_get_nv()` to get the name/value pair.
+ *
+ * An application can keep the header field beyond the callback
+ * invocation by calling `nghttp2_rcnv_incref()`, and release it with
+ * `nghttp2_rcnv_decref()`.  The header field stays valid even if it
+ * is evicted from dynamic header table, but all references must be
+ * released before the session which emitted it is deleted.
+ */
+typedef struct nghttp2_rcnv nghttp2_rcnv;
+
+/**
+ * @function
+ *
+ * Increments the reference count of |rcnv| by 1.
+ */
+NGHTTP2_EXTERN void nghttp2_rcnv_incref(nghttp2_rcnv *rcnv);
+
+/**
+ * @function
+ *
+ * Decrements the reference count of |rcnv| by 1.  If the reference
+ * count becomes zero, the object pointed by |rcnv| is freed.  In
+ * this case, application must not use |rcnv| again.  If |rcnv| is
+ * ``NULL``, this function does nothing.
+ */
+NGHTTP2_EXTERN void nghttp2_rcnv_decref(nghttp2_rcnv *rcnv);
+
+/**
+ * @function
+ *
+ * Returns the name/value pair held by |rcnv|.  The returned object
+ * is valid while the reference to |rcnv| is held.  The name and
+ * value are NULL-terminated.  The ``flags`` member of the returned
+ * object is always :enum:`NGHTTP2_NV_FLAG_NONE`.
+ */
+NGHTTP2_EXTERN const nghttp2_nv *nghttp2_rcnv_get_nv(nghttp2_rcnv *rcnv);
+
 /**
  * @enum
  *
@@ -1207,6 +1250,59 @@ typedef int (*nghttp2_send_data_callback)(nghttp2_session *session,
                                           nghttp2_data_source *source,
                                           void *user_data);
 
+/**
+ * @struct
+ *
+ * The struct to refer to a contiguous byte sequence.  It is used by
+ * `nghttp2_session_mem_sendv()` to return serialized data.
+ */
+typedef struct {
+  /**
+   * The pointer to the byte sequence.
+   */
+  const uint8_t *base;
+  /**
+   * The length of the byte sequence.
+   */
+  size_t len;
+} nghttp2_vec;
+
+/**
+ * @functypedef
+ *
+ * Callback function invoked by `nghttp2_session_mem_sendv()` when
+ * :enum:`NGHTTP2_DATA_FLAG_NO_COPY` is used in
+ * :type:`nghttp2_data_source_read_callback`, to get the application
+ * data of DATA frame without copying it.
+ *
+ * The |frame| is a DATA frame to send.  The |length| is the length of
+ * application data to send (this does not include padding).  The
+ * |source| is the same pointer passed to
+ * :type:`nghttp2_data_source_read_callback`.  The library sends frame
+ * header and padding by itself.
+ *
+ * The application must fill at most |veclen| elements of |vec| so
+ * that they refer to exactly |length| bytes of application data, and
+ * return the number of elements filled.  The data must stay valid
+ * until the next call of `nghttp2_session_mem_sendv()`,
+ * `nghttp2_session_mem_send()` or `nghttp2_session_send()`.
+ *
+ * If the data is not available yet, or it cannot be described in
+ * |veclen| elements, return :enum:`NGHTTP2_ERR_WOULDBLOCK`; the
+ * library ends the current batch and calls this callback with the
+ * same parameters in the next call of `nghttp2_session_mem_sendv()`.
+ * If application decided to reset this stream, return
+ * :enum:`NGHTTP2_ERR_TEMPORAL_CALLBACK_FAILURE`, then the library
+ * will send RST_STREAM with INTERNAL_ERROR as error code.  Returning
+ * any other negative value, or the elements which do not add up to
+ * |length| bytes, is treated as
+ * :enum:`NGHTTP2_ERR_CALLBACK_FAILURE`.
+ */
+typedef ssize_t (*nghttp2_get_data_vec_callback)(
+    nghttp2_session *session, nghttp2_frame *frame, nghttp2_vec *vec,
+    size_t veclen, size_t length, nghttp2_data_source *source,
+    void *user_data);
+
 /**
  * @functypedef
  *
@@ -1565,6 +1661,34 @@ typedef int (*nghttp2_on_header_callback)(nghttp2_session *session,
                                           const uint8_t *value, size_t valuelen,
                                           uint8_t flags, void *user_data);
 
+/**
+ * @functypedef
+ *
+ * Callback function invoked when a header name/value pair is received
+ * for the |frame|.  This is the same as
+ * :type:`nghttp2_on_header_callback`, but the header field is passed
+ * in |rcnv| as refcounted object.  The library owns the reference to
+ * |rcnv| only during this callback invocation.  If application wants
+ * to keep the header field after this callback returns, call
+ * `nghttp2_rcnv_incref()` instead of copying name and value.  The
+ * |flags| is bitwise OR of one or more of :type:`nghttp2_nv_flag`.
+ *
+ * Header fields taken from HPACK dynamic table are not copied at
+ * all.  Other header fields are allocated in a single memory block
+ * per header field.
+ *
+ * The return value and error handling are the same as
+ * :type:`nghttp2_on_header_callback`.
+ *
+ * To set this callback to :type:`nghttp2_session_callbacks`, use
+ * `nghttp2_session_callbacks_set_on_header_callback2()`.  If this
+ * callback is set, :type:`nghttp2_on_header_callback` is not invoked.
+ */
+typedef int (*nghttp2_on_header_callback2)(nghttp2_session *session,
+                                           const nghttp2_frame *frame,
+                                           nghttp2_rcnv *rcnv, uint8_t flags,
+                                           void *user_data);
+
 /**
  * @functypedef
  *
@@ -1792,6 +1916,19 @@ NGHTTP2_EXTERN void nghttp2_session_callbacks_set_on_header_callback(
     nghttp2_session_callbacks *cbs,
     nghttp2_on_header_callback on_header_callback);
 
+/**
+ * @function
+ *
+ * Sets callback function invoked when a header name/value pair is
+ * received, passing the header field as refcounted object.  If this
+ * callback is set, the callback set by
+ * `nghttp2_session_callbacks_set_on_header_callback()` is not
+ * invoked.
+ */
+NGHTTP2_EXTERN void nghttp2_session_callbacks_set_on_header_callback2(
+    nghttp2_session_callbacks *cbs,
+    nghttp2_on_header_callback2 on_header_callback2);
+
 /**
  * @function
  *
@@ -1834,6 +1971,17 @@ NGHTTP2_EXTERN void nghttp2_session_callbacks_set_send_data_callback(
     nghttp2_session_callbacks *cbs,
     nghttp2_send_data_callback send_data_callback);
 
+/**
+ * @function
+ *
+ * Sets callback function invoked by `nghttp2_session_mem_sendv()`
+ * when :enum:`NGHTTP2_DATA_FLAG_NO_COPY` is used in
+ * :type:`nghttp2_data_source_read_callback` to avoid data copy.
+ */
+NGHTTP2_EXTERN void nghttp2_session_callbacks_set_get_data_vec_callback(
+    nghttp2_session_callbacks *cbs,
+    nghttp2_get_data_vec_callback get_data_vec_callback);
+
 /**
  * @functypedef
  *
@@ -1929,6 +2077,20 @@ typedef struct {
   nghttp2_realloc realloc;
 } nghttp2_mem;
 
+struct nghttp2_hd_string_cache;
+
+/**
+ * @struct
+ *
+ * Cache of pre-encoded HPACK string literals.  Header field names
+ * and values which are emitted over and over, such as the value of
+ * "server" header field, can be registered to skip Huffman encoding
+ * for each header block.  Once populated, the cache is only read by
+ * the deflater, so one cache can be shared by many deflaters and
+ * sessions, even across threads.
+ */
+typedef struct nghttp2_hd_string_cache nghttp2_hd_string_cache;
+
 struct nghttp2_option;
 
 /**
@@ -2029,6 +2191,115 @@ nghttp2_option_set_no_recv_client_magic(nghttp2_option *option, int val);
 NGHTTP2_EXTERN void nghttp2_option_set_no_http_messaging(nghttp2_option *option,
                                                          int val);
 
+/**
+ * @function
+ *
+ * Enables per-session slab allocator for streams and outbound items,
+ * and sets the number of objects allocated at once in a single slab
+ * to |val|.  The released objects are kept in free list, and reused
+ * for the next allocation, rather than returned to the memory
+ * allocator.  The slabs are freed when the session is deleted.  Use
+ * `nghttp2_session_get_slab_stat()` to see the occupancy of slabs.
+ *
+ * If |val| is 0, slab allocator is disabled, and each object is
+ * allocated and freed individually.  By default, slab allocator is
+ * disabled.
+ */
+NGHTTP2_EXTERN void nghttp2_option_set_slab_size(nghttp2_option *option,
+                                                 size_t val);
+
+/**
+ * @function
+ *
+ * Enables automatic tuning of the local flow control window of the
+ * connection and streams, and sets the maximum window size to |val|
+ * bytes.  Since the remote endpoint may send that many bytes which
+ * the application has to buffer, |val| is the ceiling of memory
+ * spent for the incoming DATA per connection and per stream.
+ *
+ * While DATA is received, the library measures round trip time by
+ * PING, at most once per second.  Each time WINDOW_UPDATE is sent for
+ * the connection, the bytes it gives back divided by the time since
+ * the previous one is the rate the application consumes DATA.  If
+ * the window is smaller than the bytes consumed in 2 round trips, the
+ * window is doubled, and if it is more than 4 times larger, the
+ * window is halved, but not below the initial window size.  The
+ * window of the connection is updated by WINDOW_UPDATE immediately,
+ * and the window of each stream is updated when the next DATA is
+ * received on the stream.
+ *
+ * The PING sent by the library, and its acknowledgement, are passed
+ * to :type:`nghttp2_on_frame_send_callback` and
+ * :type:`nghttp2_on_frame_recv_callback` like other frames.  The
+ * opaque data of the PING is "nghttp2w".
+ *
+ * If |val| is 0, automatic tuning is disabled, which is the default.
+ * This option requires a monotonic clock; on platforms without it,
+ * it has no effect.
+ */
+NGHTTP2_EXTERN void
+nghttp2_option_set_window_auto_tuning(nghttp2_option *option, uint32_t val);
+
+/**
+ * @function
+ *
+ * Sets the cache of pre-encoded string literals which the header
+ * compressor of the session uses.  See
+ * :type:`nghttp2_hd_string_cache`.  The |cache| is not copied, and
+ * must outlive all sessions created with this option.
+ */
+NGHTTP2_EXTERN void
+nghttp2_option_set_hd_string_cache(nghttp2_option *option,
+                                   const nghttp2_hd_string_cache *cache);
+
+/**
+ * @function
+ *
+ * Sets the memory budget of the session in bytes.  When this option
+ * is set, the session counts the memory it allocates through
+ * :type:`nghttp2_mem`, excluding the session object itself and the
+ * unused objects kept in slabs (see `nghttp2_option_set_slab_size()`).
+ *
+ * Once the usage exceeds half of |val|, the session drops the closed
+ * streams retained for stream priority handling, oldest first.  The
+ * number of them retained shrinks linearly from the local
+ * SETTINGS_MAX_CONCURRENT_STREAMS, or 100 if it is unlimited, to 0 as
+ * the usage approaches |val|.  Once the usage reaches |val|, idle
+ * streams are dropped as well.  If
+ * this is not enough, the session refuses new streams initiated by
+ * the remote peer with RST_STREAM of :enum:`NGHTTP2_REFUSED_STREAM`
+ * until the usage falls below |val|.  The application can observe
+ * the usage and these events with `nghttp2_session_get_stats()`.
+ *
+ * The budget is enforced when a stream is opened, and allocations
+ * never fail because of it.  The usage can therefore exceed |val| by
+ * the memory required to process the frames already being received.
+ * Header table sizes and the number of concurrent streams should be
+ * bounded by SETTINGS as usual.
+ *
+ * If |val| is 0, this option has no effect.
+ */
+NGHTTP2_EXTERN void
+nghttp2_option_set_max_session_memory(nghttp2_option *option, size_t val);
+
+/**
+ * @function
+ *
+ * Sets the percentage of the connection-level flow control window
+ * which must be consumed before the library sends WINDOW_UPDATE for
+ * the connection automatically.  A larger value means fewer
+ * WINDOW_UPDATE frames for the connection, at the cost of the remote
+ * endpoint seeing a smaller window in the meantime.  The value is
+ * clamped to the range [1, 100], inclusive.  By default, it is 50.
+ *
+ * This option also applies to WINDOW_UPDATE sent by
+ * `nghttp2_session_consume()` for the connection.  The threshold for
+ * the streams is not affected.
+ */
+NGHTTP2_EXTERN void
+nghttp2_option_set_connection_window_update_threshold(nghttp2_option *option,
+                                                      uint32_t val);
+
 /**
  * @function
  *
@@ -2191,6 +2462,30 @@ NGHTTP2_EXTERN int nghttp2_session_server_new3(
  */
 NGHTTP2_EXTERN void nghttp2_session_del(nghttp2_session *session);
 
+/**
+ * @function
+ *
+ * Puts |session| back to the state right after it was created by
+ * `nghttp2_session_client_new3()` or `nghttp2_session_server_new3()`,
+ * so that it can serve a new connection.  All streams, queued frames
+ * and the HPACK dynamic tables are discarded without invoking any
+ * callback.  The role, the options and the memory allocator are
+ * kept, and so are the stream hash table, the memory pools and the
+ * buffers already allocated, which makes this cheaper than deleting
+ * and creating a session.
+ *
+ * If |callbacks| is not ``NULL``, it replaces the callback functions.
+ * |user_data| always replaces the user data.  The submission queue
+ * attached by `nghttp2_session_set_submission_queue()` is detached.
+ *
+ * This function must not be called from inside the callback
+ * functions.
+ */
+NGHTTP2_EXTERN void
+nghttp2_session_reset(nghttp2_session *session,
+                      const nghttp2_session_callbacks *callbacks,
+                      void *user_data);
+
 /**
  * @function
  *
@@ -2282,6 +2577,47 @@ NGHTTP2_EXTERN int nghttp2_session_send(nghttp2_session *session);
 NGHTTP2_EXTERN ssize_t nghttp2_session_mem_send(nghttp2_session *session,
                                                 const uint8_t **data_ptr);
 
+/**
+ * @function
+ *
+ * Stores the serialized data to send in |vec|.
+ *
+ * This function behaves like `nghttp2_session_mem_send()` except that
+ * it collects as many serialized frames as fit in at most |veclen|
+ * elements of |vec|, so that the application can transmit them at
+ * once, for example, using writev(2).  Frame headers and non-DATA
+ * frames are stored in the library memory.  If
+ * :enum:`NGHTTP2_DATA_FLAG_NO_COPY` is used in
+ * :type:`nghttp2_data_source_read_callback`, the application data of
+ * DATA frame is not copied; the elements of |vec| refer to the memory
+ * obtained by :type:`nghttp2_get_data_vec_callback`, which must be
+ * set in this case.  The other callbacks are called in the same way
+ * as they are in `nghttp2_session_mem_send()`.
+ *
+ * If no data is available to send, this function returns 0.
+ *
+ * This function may not return all serialized data in one invocation.
+ * To get all data, call this function repeatedly until it returns 0
+ * or one of negative error codes.
+ *
+ * The data referred by |vec| are valid until the next call of
+ * `nghttp2_session_mem_sendv()`, `nghttp2_session_mem_send()` or
+ * `nghttp2_session_send()`.
+ *
+ * The caller must send all data before calling these functions again.
+ *
+ * This function returns the number of elements of |vec| filled if it
+ * succeeds, or one of the following negative error codes:
+ *
+ * :enum:`NGHTTP2_ERR_NOMEM`
+ *     Out of memory.
+ * :enum:`NGHTTP2_ERR_CALLBACK_FAILURE`
+ *     The callback function failed.
+ */
+NGHTTP2_EXTERN ssize_t nghttp2_session_mem_sendv(nghttp2_session *session,
+                                                 nghttp2_vec *vec,
+                                                 size_t veclen);
+
 /**
  * @function
  *
@@ -2403,6 +2739,186 @@ NGHTTP2_EXTERN ssize_t nghttp2_session_mem_recv(nghttp2_session *session,
 NGHTTP2_EXTERN int nghttp2_session_resume_data(nghttp2_session *session,
                                                int32_t stream_id);
 
+/**
+ * @struct
+ *
+ * The queue through which threads other than the owner of a session
+ * submit frames to the session.  The producer side functions,
+ * `nghttp2_submission_queue_submit_headers()`,
+ * `nghttp2_submission_queue_submit_response()`,
+ * `nghttp2_submission_queue_resume_data()` and
+ * `nghttp2_submission_queue_submit_rst_stream()`, may be called from
+ * any thread concurrently.  They are lock-free.  The owning thread of
+ * the session applies the queued requests in
+ * `nghttp2_session_send()`, `nghttp2_session_mem_send()` and
+ * `nghttp2_session_mem_sendv()` in the order they were queued by each
+ * thread.  See `nghttp2_session_set_submission_queue()`.
+ *
+ * The details of this structure are intentionally hidden from the
+ * public API.
+ */
+typedef struct nghttp2_submission_queue nghttp2_submission_queue;
+
+/**
+ * @functypedef
+ *
+ * Callback function invoked by the producer thread when the queue
+ * |q| becomes non-empty, and the owning thread should call
+ * `nghttp2_session_send()` or `nghttp2_session_mem_send()`.  It is
+ * not called again until the owning thread starts to drain the
+ * queue, so writing to an eventfd or a pipe, or posting to an event
+ * loop here does not flood the owning thread.  The |user_data| is the
+ * pointer passed to `nghttp2_submission_queue_new()`.
+ *
+ * This callback runs in the producer thread, and must not touch the
+ * session.
+ */
+typedef void (*nghttp2_submission_queue_wakeup_callback)(
+    nghttp2_submission_queue *q, void *user_data);
+
+/**
+ * @function
+ *
+ * Initializes |*q_ptr| for a new submission queue.  The |wakeup_cb|
+ * is called as described in
+ * :type:`nghttp2_submission_queue_wakeup_callback`, and can be
+ * ``NULL``.  The producer threads allocate queued requests using
+ * |mem|, so it must be thread-safe.  If |mem| is ``NULL``, the
+ * default allocator, which uses malloc and friends, is used.
+ *
+ * This function returns 0 if it succeeds, or one of the following
+ * negative error codes:
+ *
+ * :enum:`NGHTTP2_ERR_NOMEM`
+ *     Out of memory.
+ * :enum:`NGHTTP2_ERR_INVALID_STATE`
+ *     The library was built without atomic operations.
+ */
+NGHTTP2_EXTERN int nghttp2_submission_queue_new(
+    nghttp2_submission_queue **q_ptr,
+    nghttp2_submission_queue_wakeup_callback wakeup_cb, void *user_data,
+    nghttp2_mem *mem);
+
+/**
+ * @function
+ *
+ * Frees any resources allocated for |q|, including the requests not
+ * applied yet.  No thread must use |q| after this call, and |q| must
+ * not be attached to a session.  If |q| is ``NULL``, this function
+ * does nothing.
+ */
+NGHTTP2_EXTERN void nghttp2_submission_queue_del(nghttp2_submission_queue *q);
+
+/**
+ * @function
+ *
+ * Attaches |q| to the |session|.  |q| must be attached to at most one
+ * session at a time, and must outlive it, or be detached by passing
+ * ``NULL`` as |q|.  This function must be called by the owning thread
+ * of the |session|.
+ *
+ * While |q| has requests, `nghttp2_session_want_write()` returns
+ * nonzero.  The requests are applied before the session picks the
+ * next frame to send.  If a request fails with a non-fatal error, for
+ * example because the stream has been closed in the meantime, it is
+ * discarded.  The application should release the resources it
+ * associated with the stream in
+ * :type:`nghttp2_on_stream_close_callback` as usual.
+ */
+NGHTTP2_EXTERN void
+nghttp2_session_set_submission_queue(nghttp2_session *session,
+                                     nghttp2_submission_queue *q);
+
+/**
+ * @function
+ *
+ * Queues the request to call `nghttp2_submit_headers()` with the
+ * |flags|, |stream_id|, |nva| and |nvlen| without priority and stream
+ * user data.  Only :enum:`NGHTTP2_FLAG_END_STREAM` in |flags| is
+ * used.  The |nva| is copied.  The |stream_id| must refer to an
+ * existing stream, since the assigned stream ID of a new stream
+ * cannot be returned to the producer thread.
+ *
+ * This function may be called from any thread.
+ *
+ * This function returns 0 if it succeeds, or one of the following
+ * negative error codes:
+ *
+ * :enum:`NGHTTP2_ERR_INVALID_ARGUMENT`
+ *     The |stream_id| is not positive.
+ * :enum:`NGHTTP2_ERR_NOMEM`
+ *     Out of memory.
+ */
+NGHTTP2_EXTERN int
+nghttp2_submission_queue_submit_headers(nghttp2_submission_queue *q,
+                                        uint8_t flags, int32_t stream_id,
+                                        const nghttp2_nv *nva, size_t nvlen);
+
+/**
+ * @function
+ *
+ * Queues the request to call `nghttp2_submit_response()` with the
+ * |stream_id|, |nva|, |nvlen| and |data_prd|.  The |nva| and
+ * |data_prd| are copied.  The callback in |data_prd| is called by the
+ * owning thread of the session; the application is responsible for
+ * synchronizing the data source with the producer.
+ *
+ * This function may be called from any thread.
+ *
+ * This function returns 0 if it succeeds, or one of the following
+ * negative error codes:
+ *
+ * :enum:`NGHTTP2_ERR_INVALID_ARGUMENT`
+ *     The |stream_id| is not positive.
+ * :enum:`NGHTTP2_ERR_NOMEM`
+ *     Out of memory.
+ */
+NGHTTP2_EXTERN int nghttp2_submission_queue_submit_response(
+    nghttp2_submission_queue *q, int32_t stream_id, const nghttp2_nv *nva,
+    size_t nvlen, const nghttp2_data_provider *data_prd);
+
+/**
+ * @function
+ *
+ * Queues the request to call `nghttp2_session_resume_data()` with the
+ * |stream_id|.  Typically, a producer thread appends data to the
+ * source of deferred stream, and calls this function.
+ *
+ * This function may be called from any thread.
+ *
+ * This function returns 0 if it succeeds, or one of the following
+ * negative error codes:
+ *
+ * :enum:`NGHTTP2_ERR_INVALID_ARGUMENT`
+ *     The |stream_id| is not positive.
+ * :enum:`NGHTTP2_ERR_NOMEM`
+ *     Out of memory.
+ */
+NGHTTP2_EXTERN int
+nghttp2_submission_queue_resume_data(nghttp2_submission_queue *q,
+                                     int32_t stream_id);
+
+/**
+ * @function
+ *
+ * Queues the request to call `nghttp2_submit_rst_stream()` with the
+ * |stream_id| and |error_code|.
+ *
+ * This function may be called from any thread.
+ *
+ * This function returns 0 if it succeeds, or one of the following
+ * negative error codes:
+ *
+ * :enum:`NGHTTP2_ERR_INVALID_ARGUMENT`
+ *     The |stream_id| is not positive.
+ * :enum:`NGHTTP2_ERR_NOMEM`
+ *     Out of memory.
+ */
+NGHTTP2_EXTERN int
+nghttp2_submission_queue_submit_rst_stream(nghttp2_submission_queue *q,
+                                           int32_t stream_id,
+                                           uint32_t error_code);
+
 /**
  * @function
  *
@@ -2474,6 +2990,119 @@ nghttp2_session_set_stream_user_data(nghttp2_session *session,
 NGHTTP2_EXTERN size_t
     nghttp2_session_get_outbound_queue_size(nghttp2_session *session);
 
+/**
+ * @macro
+ *
+ * The number of frame types counted in
+ * :type:`nghttp2_session_stats`.  Frame types from
+ * :enum:`NGHTTP2_DATA` to :enum:`NGHTTP2_CONTINUATION` are counted.
+ */
+#define NGHTTP2_STATS_NUM_FRAME_TYPES 10
+
+/**
+ * @struct
+ *
+ * The statistics of :type:`nghttp2_session`.  See
+ * `nghttp2_session_get_stats()`.
+ */
+typedef struct {
+  /**
+   * The number of frames sent, indexed by :type:`nghttp2_frame_type`.
+   * A frame is counted when its transmission completed.  The frames
+   * of extension types are not counted.
+   */
+  uint64_t frames_sent[NGHTTP2_STATS_NUM_FRAME_TYPES];
+  /**
+   * The number of bytes sent, including frame header and padding,
+   * indexed by :type:`nghttp2_frame_type`.
+   */
+  uint64_t bytes_sent[NGHTTP2_STATS_NUM_FRAME_TYPES];
+  /**
+   * The number of frames received, indexed by
+   * :type:`nghttp2_frame_type`.  A frame is counted when its frame
+   * header is received.  The frames of extension types are not
+   * counted.
+   */
+  uint64_t frames_recv[NGHTTP2_STATS_NUM_FRAME_TYPES];
+  /**
+   * The number of bytes received, including frame header and
+   * padding, indexed by :type:`nghttp2_frame_type`.
+   */
+  uint64_t bytes_recv[NGHTTP2_STATS_NUM_FRAME_TYPES];
+  /**
+   * The number of times DATA of a stream was deferred because flow
+   * control window was exhausted.
+   */
+  uint64_t data_blocked;
+  /**
+   * The total length of header names and values given to the header
+   * compressor.
+   */
+  uint64_t deflate_nv_bytes;
+  /**
+   * The total length of header blocks the header compressor
+   * produced.  Together with :member:`deflate_nv_bytes`, this gives
+   * the compression ratio of outgoing header fields.
+   */
+  uint64_t deflate_hd_bytes;
+  /**
+   * The total length of header blocks given to the header
+   * decompressor.
+   */
+  uint64_t inflate_hd_bytes;
+  /**
+   * The total length of header names and values the header
+   * decompressor produced.
+   */
+  uint64_t inflate_nv_bytes;
+  /**
+   * The number of streams initiated by the remote peer which were
+   * refused because the memory budget was exhausted.  See
+   * `nghttp2_option_set_max_session_memory()`.
+   */
+  uint64_t mem_refused_streams;
+  /**
+   * The number of retained closed and idle streams dropped early to
+   * keep the memory usage within the budget.
+   */
+  uint64_t mem_trimmed_streams;
+  /**
+   * The number of frames in the urgent queue (e.g., SETTINGS, PING
+   * and RST_STREAM).
+   */
+  size_t ob_urgent_len;
+  /**
+   * The number of frames in the regular queue of non-DATA frames.
+   */
+  size_t ob_reg_len;
+  /**
+   * The number of stream-creating HEADERS waiting for
+   * SETTINGS_MAX_CONCURRENT_STREAMS.
+   */
+  size_t ob_syn_len;
+  /**
+   * The number of streams which have DATA ready to send.  This does
+   * not include the deferred DATA.
+   */
+  size_t ob_data_len;
+  /**
+   * The number of bytes the session currently allocates, which is
+   * checked against the memory budget.  This is 0 unless
+   * `nghttp2_option_set_max_session_memory()` is used.
+   */
+  size_t mem_used;
+} nghttp2_session_stats;
+
+/**
+ * @function
+ *
+ * Stores the statistics of the |session| in |*stats|.  The counters
+ * are maintained while frames are sent and received, and this
+ * function just copies them.
+ */
+NGHTTP2_EXTERN void nghttp2_session_get_stats(nghttp2_session *session,
+                                              nghttp2_session_stats *stats);
+
 /**
  * @function
  *
@@ -2582,6 +3211,64 @@ NGHTTP2_EXTERN int
 nghttp2_session_get_stream_remote_close(nghttp2_session *session,
                                         int32_t stream_id);
 
+/**
+ * @enum
+ *
+ * The kind of objects allocated by per-session slab allocator.
+ */
+typedef enum {
+  /**
+   * Streams
+   */
+  NGHTTP2_SLAB_STREAM,
+  /**
+   * Outbound items, each of which holds a frame to send
+   */
+  NGHTTP2_SLAB_OUTBOUND_ITEM,
+  /**
+   * Compact records of closed streams which server keeps for the
+   * dependency tree
+   */
+  NGHTTP2_SLAB_STREAM_TOMBSTONE
+} nghttp2_slab_type;
+
+/**
+ * @struct
+ *
+ * The occupancy of per-session slab allocator.
+ */
+typedef struct {
+  /**
+   * The number of slabs allocated.
+   */
+  size_t nslabs;
+  /**
+   * The number of objects all allocated slabs can hold.
+   */
+  size_t capacity;
+  /**
+   * The number of objects currently in use.
+   */
+  size_t used;
+} nghttp2_slab_stat;
+
+/**
+ * @function
+ *
+ * Stores the occupancy of slab allocator for objects of the given
+ * |type| in |*stat|.  See `nghttp2_option_set_slab_size()`.  If slab
+ * allocator is disabled, all fields of |*stat| are 0.
+ *
+ * This function returns 0 if it succeeds, or one of the following
+ * negative error codes:
+ *
+ * :enum:`NGHTTP2_ERR_INVALID_ARGUMENT`
+ *     The |type| is not one of :type:`nghttp2_slab_type`.
+ */
+NGHTTP2_EXTERN int nghttp2_session_get_slab_stat(nghttp2_session *session,
+                                                 nghttp2_slab_type type,
+                                                 nghttp2_slab_stat *stat);
+
 /**
  * @function
  *
@@ -3660,6 +4347,118 @@ NGHTTP2_EXTERN int
 nghttp2_hd_deflate_change_table_size(nghttp2_hd_deflater *deflater,
                                      size_t settings_hd_table_bufsize_max);
 
+/**
+ * @enum
+ *
+ * The strategies the deflater uses to decide whether a header field
+ * is inserted into the dynamic table.
+ */
+typedef enum {
+  /**
+   * Inserts all header fields except for a few fields whose values
+   * are typically unique per request or response (e.g., ":path",
+   * "content-length", "etag"), and the fields too large for the
+   * dynamic table.  This is the default.
+   */
+  NGHTTP2_HD_INDEXING_DEFAULT = 0,
+  /**
+   * Inserts a header field only if the same name/value pair was seen
+   * recently enough that the entry would still be in the dynamic
+   * table when it is reused.  The first occurrence of a pair is
+   * always encoded without indexing, and pairs which never repeat do
+   * not evict other entries.
+   */
+  NGHTTP2_HD_INDEXING_FREQUENCY = 1,
+  /**
+   * Same as :enum:`NGHTTP2_HD_INDEXING_DEFAULT`, but never inserts
+   * header fields whose value is longer than the given number of
+   * bytes.
+   */
+  NGHTTP2_HD_INDEXING_VALUE_SIZE = 2
+} nghttp2_hd_indexing_strategy;
+
+/**
+ * @function
+ *
+ * Sets the indexing strategy of the |deflater| to |strategy|.  For
+ * :enum:`NGHTTP2_HD_INDEXING_VALUE_SIZE`, |param| is the maximum
+ * length of value to be indexed.  |param| is ignored for other
+ * strategies.
+ *
+ * The strategy only affects compression ratio.  The header block
+ * produced is valid for any inflater regardless of the strategy.
+ *
+ * This function returns 0 if it succeeds, or one of the following
+ * negative error codes:
+ *
+ * :enum:`NGHTTP2_ERR_INVALID_ARGUMENT`
+ *     The |strategy| is unknown.
+ * :enum:`NGHTTP2_ERR_NOMEM`
+ *     Out of memory.
+ */
+NGHTTP2_EXTERN int
+nghttp2_hd_deflate_set_indexing_strategy(nghttp2_hd_deflater *deflater,
+                                         nghttp2_hd_indexing_strategy strategy,
+                                         size_t param);
+
+/**
+ * @function
+ *
+ * Initializes |*cache_ptr| with an empty string cache.  The |mem|
+ * can be ``NULL`` and the call is equivalent to passing the default
+ * memory allocator.
+ *
+ * This function returns 0 if it succeeds, or one of the following
+ * negative error codes:
+ *
+ * :enum:`NGHTTP2_ERR_NOMEM`
+ *     Out of memory.
+ */
+NGHTTP2_EXTERN int
+nghttp2_hd_string_cache_new(nghttp2_hd_string_cache **cache_ptr,
+                            nghttp2_mem *mem);
+
+/**
+ * @function
+ *
+ * Deallocates any resources allocated for |cache|.  The |cache| must
+ * not be used by any deflater or session after this call.
+ */
+NGHTTP2_EXTERN void
+nghttp2_hd_string_cache_del(nghttp2_hd_string_cache *cache);
+
+/**
+ * @function
+ *
+ * Encodes the string |str| of length |len| as HPACK string literal,
+ * and stores it in the |cache|.  The |str| is copied.  Adding the
+ * same string again is no-op.
+ *
+ * This function must not be called while the |cache| is used by
+ * other threads.
+ *
+ * This function returns 0 if it succeeds, or one of the following
+ * negative error codes:
+ *
+ * :enum:`NGHTTP2_ERR_NOMEM`
+ *     Out of memory.
+ * :enum:`NGHTTP2_ERR_HEADER_COMP`
+ *     The |str| is too long to be encoded.
+ */
+NGHTTP2_EXTERN int nghttp2_hd_string_cache_add(nghttp2_hd_string_cache *cache,
+                                               const uint8_t *str, size_t len);
+
+/**
+ * @function
+ *
+ * Makes the |deflater| look up the |cache| before encoding each
+ * string literal.  The |cache| is not copied, and must outlive the
+ * |deflater|.  Passing ``NULL`` stops using the cache.
+ */
+NGHTTP2_EXTERN void
+nghttp2_hd_deflate_set_string_cache(nghttp2_hd_deflater *deflater,
+                                    const nghttp2_hd_string_cache *cache);
+
 /**
  * @function
  *
@@ -35,7 +35,7 @@
 #define MAKE_STATIC_ENT(N, V, T)                                               \
   {                                                                            \
     { (uint8_t *)(N), (uint8_t *)(V), sizeof((N)) - 1, sizeof((V)) - 1, 0 }    \
-    , (T), 1, NGHTTP2_HD_FLAG_NONE                                             \
+    , NULL, NULL, (T), 0, 0, 0, 1, NGHTTP2_HD_FLAG_NONE, NULL                  \
   }
 
 /* Generated by mkstatictbl.py */
@@ -537,9 +537,15 @@ int nghttp2_hd_entry_init(nghttp2_hd_entry *ent, uint8_t flags, uint8_t *name,
   }
   ent->nv.namelen = namelen;
   ent->nv.valuelen = valuelen;
+  ent->name_next = NULL;
+  ent->nv_next = NULL;
   ent->token = token;
+  ent->seq = 0;
+  ent->name_hash = 0;
+  ent->nv_hash = 0;
   ent->ref = 1;
   ent->flags = flags;
+  ent->mem = mem;
 
   return 0;
 
@@ -562,6 +568,41 @@ void nghttp2_hd_entry_free(nghttp2_hd_entry *ent, nghttp2_mem *mem) {
   }
 }
 
+void nghttp2_hd_entry_incref(nghttp2_hd_entry *ent) {
+  if (ent->mem == NULL) {
+    return;
+  }
+  ++ent->ref;
+}
+
+void nghttp2_hd_entry_decref(nghttp2_hd_entry *ent) {
+  nghttp2_mem *mem;
+
+  if (ent == NULL || ent->mem == NULL) {
+    return;
+  }
+
+  assert(ent->ref > 0);
+
+  if (--ent->ref == 0) {
+    mem = ent->mem;
+    nghttp2_hd_entry_free(ent, mem);
+    nghttp2_mem_free(mem, ent);
+  }
+}
+
+void nghttp2_rcnv_incref(nghttp2_rcnv *rcnv) {
+  nghttp2_hd_entry_incref((nghttp2_hd_entry *)(void *)rcnv);
+}
+
+void nghttp2_rcnv_decref(nghttp2_rcnv *rcnv) {
+  nghttp2_hd_entry_decref((nghttp2_hd_entry *)(void *)rcnv);
+}
+
+const nghttp2_nv *nghttp2_rcnv_get_nv(nghttp2_rcnv *rcnv) {
+  return &((nghttp2_hd_entry *)(void *)rcnv)->nv;
+}
+
 static int hd_ringbuf_init(nghttp2_hd_ringbuf *ringbuf, size_t bufsize,
                            nghttp2_mem *mem) {
   size_t size;
@@ -608,17 +649,28 @@ static int hd_ringbuf_reserve(nghttp2_hd_ringbuf *ringbuf, size_t bufsize,
   return 0;
 }
 
-static void hd_ringbuf_free(nghttp2_hd_ringbuf *ringbuf, nghttp2_mem *mem) {
+/*
+ * Releases all entries in |ringbuf|, keeping its buffer.
+ */
+static void hd_ringbuf_clear(nghttp2_hd_ringbuf *ringbuf, nghttp2_mem *mem) {
   size_t i;
-  if (ringbuf == NULL) {
-    return;
-  }
   for (i = 0; i < ringbuf->len; ++i) {
     nghttp2_hd_entry *ent = hd_ringbuf_get(ringbuf, i);
-    --ent->ref;
-    nghttp2_hd_entry_free(ent, mem);
-    nghttp2_mem_free(mem, ent);
+    /* Application may still hold the reference to this entry */
+    if (--ent->ref == 0) {
+      nghttp2_hd_entry_free(ent, mem);
+      nghttp2_mem_free(mem, ent);
+    }
+  }
+  ringbuf->first = 0;
+  ringbuf->len = 0;
+}
+
+static void hd_ringbuf_free(nghttp2_hd_ringbuf *ringbuf, nghttp2_mem *mem) {
+  if (ringbuf == NULL) {
+    return;
   }
+  hd_ringbuf_clear(ringbuf, mem);
   nghttp2_mem_free(mem, ringbuf->buffer);
 }
 
@@ -643,10 +695,113 @@ static void hd_ringbuf_pop_back(nghttp2_hd_ringbuf *ringbuf) {
   --ringbuf->len;
 }
 
+/* The maximum number of buckets in nghttp2_hd_map */
+#define HD_MAP_MAX_SIZE 4096
+
+/* 32 bit FNV-1a offset basis */
+#define HD_HASH_INIT 2166136261u
+
+static uint32_t hd_hash(uint32_t h, const uint8_t *s, size_t n) {
+  for (; n; --n) {
+    h ^= *s++;
+    h *= 16777619u;
+  }
+  return h;
+}
+
+/*
+ * Returns hash value of nv->name.  If |token| is not -1, we just use
+ * it as hash value, since it uniquely identifies the name.
+ */
+static uint32_t hd_name_hash(const nghttp2_nv *nv, int token) {
+  if (token != -1) {
+    return (uint32_t)token;
+  }
+  return hd_hash(HD_HASH_INIT, nv->name, nv->namelen);
+}
+
+static uint32_t hd_nv_hash(const nghttp2_nv *nv, uint32_t name_hash) {
+  return hd_hash(HD_HASH_INIT ^ name_hash, nv->value, nv->valuelen);
+}
+
+static int hd_map_init(nghttp2_hd_map *map, size_t bufsize_max,
+                       nghttp2_mem *mem) {
+  size_t size;
+
+  /* Sized assuming that a typical entry takes about 64 bytes of
+     table space, so that chains stay short even if the table is
+     full.  The number of buckets is capped so that absurdly large
+     table size does not make us allocate huge array. */
+  for (size = 16; size < bufsize_max / 64 && size < HD_MAP_MAX_SIZE;
+       size <<= 1)
+    ;
+
+  map->name_table = nghttp2_mem_calloc(mem, size, sizeof(nghttp2_hd_entry *));
+  if (map->name_table == NULL) {
+    return NGHTTP2_ERR_NOMEM;
+  }
+
+  map->nv_table = nghttp2_mem_calloc(mem, size, sizeof(nghttp2_hd_entry *));
+  if (map->nv_table == NULL) {
+    nghttp2_mem_free(mem, map->name_table);
+    return NGHTTP2_ERR_NOMEM;
+  }
+
+  map->mask = size - 1;
+
+  return 0;
+}
+
+static void hd_map_free(nghttp2_hd_map *map, nghttp2_mem *mem) {
+  nghttp2_mem_free(mem, map->nv_table);
+  nghttp2_mem_free(mem, map->name_table);
+}
+
+/*
+ * Inserts |ent| to |map|.  |ent| must have its name_hash and nv_hash
+ * set.  Newer entry is linked in front of older ones, so that lookup
+ * finds the entry with the smallest index first.
+ */
+static void hd_map_insert(nghttp2_hd_map *map, nghttp2_hd_entry *ent) {
+  nghttp2_hd_entry **bucket;
+
+  bucket = &map->name_table[ent->name_hash & map->mask];
+  ent->name_next = *bucket;
+  *bucket = ent;
+
+  bucket = &map->nv_table[ent->nv_hash & map->mask];
+  ent->nv_next = *bucket;
+  *bucket = ent;
+}
+
+static void hd_map_remove(nghttp2_hd_map *map, nghttp2_hd_entry *ent) {
+  nghttp2_hd_entry **dst;
+
+  for (dst = &map->name_table[ent->name_hash & map->mask]; *dst;
+       dst = &(*dst)->name_next) {
+    if (*dst == ent) {
+      *dst = ent->name_next;
+      break;
+    }
+  }
+
+  for (dst = &map->nv_table[ent->nv_hash & map->mask]; *dst;
+       dst = &(*dst)->nv_next) {
+    if (*dst == ent) {
+      *dst = ent->nv_next;
+      break;
+    }
+  }
+
+  ent->name_next = NULL;
+  ent->nv_next = NULL;
+}
+
 static int hd_context_init(nghttp2_hd_context *context, nghttp2_mem *mem) {
   int rv;
   context->mem = mem;
   context->bad = 0;
+  context->next_seq = 0;
   context->hd_table_bufsize_max = NGHTTP2_HD_DEFAULT_MAX_BUFFER_SIZE;
   rv = hd_ringbuf_init(&context->hd_table, context->hd_table_bufsize_max /
                                                NGHTTP2_HD_ENTRY_OVERHEAD,
@@ -663,6 +818,15 @@ static void hd_context_free(nghttp2_hd_context *context) {
   hd_ringbuf_free(&context->hd_table, context->mem);
 }
 
+static void hd_context_reset(nghttp2_hd_context *context) {
+  hd_ringbuf_clear(&context->hd_table, context->mem);
+
+  context->bad = 0;
+  context->next_seq = 0;
+  context->hd_table_bufsize_max = NGHTTP2_HD_DEFAULT_MAX_BUFFER_SIZE;
+  context->hd_table_bufsize = 0;
+}
+
 int nghttp2_hd_deflate_init(nghttp2_hd_deflater *deflater, nghttp2_mem *mem) {
   return nghttp2_hd_deflate_init2(
       deflater, NGHTTP2_HD_DEFAULT_MAX_DEFLATE_BUFFER_SIZE, mem);
@@ -677,6 +841,12 @@ int nghttp2_hd_deflate_init2(nghttp2_hd_deflater *deflater,
     return rv;
   }
 
+  rv = hd_map_init(&deflater->map, deflate_hd_table_bufsize_max, mem);
+  if (rv != 0) {
+    hd_context_free(&deflater->ctx);
+    return rv;
+  }
+
   if (deflate_hd_table_bufsize_max < NGHTTP2_HD_DEFAULT_MAX_BUFFER_SIZE) {
     deflater->notify_table_size_change = 1;
     deflater->ctx.hd_table_bufsize_max = deflate_hd_table_bufsize_max;
@@ -686,6 +856,11 @@ int nghttp2_hd_deflate_init2(nghttp2_hd_deflater *deflater,
 
   deflater->deflate_hd_table_bufsize_max = deflate_hd_table_bufsize_max;
   deflater->min_hd_table_bufsize_max = UINT32_MAX;
+  deflater->string_cache = NULL;
+  deflater->seen = NULL;
+  deflater->indexed_bytes = 0;
+  deflater->max_indexed_valuelen = 0;
+  deflater->indexing_strategy = NGHTTP2_HD_INDEXING_DEFAULT;
 
   return 0;
 }
@@ -745,7 +920,52 @@ static void hd_inflate_keep_free(nghttp2_hd_inflater *inflater) {
   inflater->nv_keep = NULL;
 }
 
+void nghttp2_hd_deflate_reset(nghttp2_hd_deflater *deflater) {
+  nghttp2_hd_map *map = &deflater->map;
+
+  hd_context_reset(&deflater->ctx);
+
+  memset(map->name_table, 0, sizeof(nghttp2_hd_entry *) * (map->mask + 1));
+  memset(map->nv_table, 0, sizeof(nghttp2_hd_entry *) * (map->mask + 1));
+
+  if (deflater->deflate_hd_table_bufsize_max <
+      NGHTTP2_HD_DEFAULT_MAX_BUFFER_SIZE) {
+    deflater->notify_table_size_change = 1;
+    deflater->ctx.hd_table_bufsize_max = deflater->deflate_hd_table_bufsize_max;
+  } else {
+    deflater->notify_table_size_change = 0;
+  }
+
+  deflater->min_hd_table_bufsize_max = UINT32_MAX;
+  deflater->indexed_bytes = 0;
+
+  if (deflater->seen) {
+    memset(deflater->seen, 0, sizeof(nghttp2_hd_seen) * NGHTTP2_HD_SEEN_LENGTH);
+  }
+}
+
+void nghttp2_hd_inflate_reset(nghttp2_hd_inflater *inflater) {
+  hd_inflate_keep_free(inflater);
+  nghttp2_bufs_reset(&inflater->nvbufs);
+  hd_context_reset(&inflater->ctx);
+
+  inflater->settings_hd_table_bufsize_max = NGHTTP2_HD_DEFAULT_MAX_BUFFER_SIZE;
+
+  inflater->opcode = NGHTTP2_HD_OPCODE_NONE;
+  inflater->state = NGHTTP2_HD_STATE_OPCODE;
+
+  inflater->huffman_encoded = 0;
+  inflater->index = 0;
+  inflater->left = 0;
+  inflater->shift = 0;
+  inflater->newnamelen = 0;
+  inflater->index_required = 0;
+  inflater->no_index = 0;
+}
+
 void nghttp2_hd_deflate_free(nghttp2_hd_deflater *deflater) {
+  nghttp2_mem_free(deflater->ctx.mem, deflater->seen);
+  hd_map_free(&deflater->map, deflater->ctx.mem);
   hd_context_free(&deflater->ctx);
 }
 
@@ -950,20 +1170,56 @@ static int emit_indexed_block(nghttp2_bufs *bufs, size_t idx) {
   return 0;
 }
 
-static int emit_string(nghttp2_bufs *bufs, const uint8_t *str, size_t len) {
+static const nghttp2_hd_cached_string *
+hd_string_cache_find(const nghttp2_hd_string_cache *cache, const uint8_t *str,
+                     size_t len) {
+  const nghttp2_hd_cached_string *ent;
+  uint32_t hash;
+
+  if ((cache->lenmask[(len & 0xff) >> 3] & (1 << (len & 0x7))) == 0) {
+    return NULL;
+  }
+
+  hash = hd_hash(HD_HASH_INIT, str, len);
+
+  for (ent = cache->table[hash & (NGHTTP2_HD_STRING_CACHE_LENGTH - 1)]; ent;
+       ent = ent->next) {
+    if (ent->hash == hash && ent->len == len &&
+        memcmp(ent->str, str, len) == 0) {
+      return ent;
+    }
+  }
+
+  return NULL;
+}
+
+/*
+ * Emits |str| of length |len| as string literal.  If |cache| is not
+ * NULL and has |str|, its pre-encoded form is copied instead of
+ * encoding |str| again.
+ */
+static int emit_string(nghttp2_bufs *bufs, const uint8_t *str, size_t len,
+                       const nghttp2_hd_string_cache *cache) {
   int rv;
   uint8_t sb[16];
   uint8_t *bufp;
   size_t blocklen;
   size_t enclen;
   int huffman = 0;
+  const nghttp2_hd_cached_string *ent;
+
+  if (cache) {
+    ent = hd_string_cache_find(cache, str, len);
+    if (ent) {
+      DEBUGF(fprintf(stderr, "deflatehd: emit cached string len=%zu\n", len));
+      return nghttp2_bufs_add(bufs, ent->encoded, ent->encodedlen);
+    }
+  }
 
-  enclen = nghttp2_hd_huff_encode_count(str, len);
+  enclen = nghttp2_hd_huff_encode_count_bounded(str, len);
 
   if (enclen < len) {
     huffman = 1;
-  } else {
-    enclen = len;
   }
 
   blocklen = count_encoded_length(enclen, 7);
@@ -1013,7 +1269,8 @@ static uint8_t pack_first_byte(int indexing_mode) {
 }
 
 static int emit_indname_block(nghttp2_bufs *bufs, size_t idx,
-                              const nghttp2_nv *nv, int indexing_mode) {
+                              const nghttp2_nv *nv, int indexing_mode,
+                              const nghttp2_hd_string_cache *cache) {
   int rv;
   uint8_t *bufp;
   size_t blocklen;
@@ -1047,7 +1304,7 @@ static int emit_indname_block(nghttp2_bufs *bufs, size_t idx,
     return rv;
   }
 
-  rv = emit_string(bufs, nv->value, nv->valuelen);
+  rv = emit_string(bufs, nv->value, nv->valuelen, cache);
   if (rv != 0) {
     return rv;
   }
@@ -1056,7 +1313,8 @@ static int emit_indname_block(nghttp2_bufs *bufs, size_t idx,
 }
 
 static int emit_newname_block(nghttp2_bufs *bufs, const nghttp2_nv *nv,
-                              int indexing_mode) {
+                              int indexing_mode,
+                              const nghttp2_hd_string_cache *cache) {
   int rv;
 
   DEBUGF(fprintf(stderr, "deflatehd: emit newname namelen=%zu, valuelen=%zu, "
@@ -1068,12 +1326,12 @@ static int emit_newname_block(nghttp2_bufs *bufs, const nghttp2_nv *nv,
     return rv;
   }
 
-  rv = emit_string(bufs, nv->name, nv->namelen);
+  rv = emit_string(bufs, nv->name, nv->namelen, cache);
   if (rv != 0) {
     return rv;
   }
 
-  rv = emit_string(bufs, nv->value, nv->valuelen);
+  rv = emit_string(bufs, nv->value, nv->valuelen, cache);
   if (rv != 0) {
     return rv;
   }
@@ -1081,10 +1339,19 @@ static int emit_newname_block(nghttp2_bufs *bufs, const nghttp2_nv *nv,
   return 0;
 }
 
+/*
+ * Adds |nv| to the dynamic header table of |context|, evicting old
+ * entries as needed.  If |map| is not NULL, the evicted entries are
+ * removed from it, and the new entry is added to it with
+ * |name_hash| and |nv_hash|.  The inflater passes NULL to |map|.
+ */
 static nghttp2_hd_entry *add_hd_table_incremental(nghttp2_hd_context *context,
                                                   const nghttp2_nv *nv,
                                                   int token,
-                                                  uint8_t entry_flags) {
+                                                  uint8_t entry_flags,
+                                                  nghttp2_hd_map *map,
+                                                  uint32_t name_hash,
+                                                  uint32_t nv_hash) {
   int rv;
   nghttp2_hd_entry *new_ent;
   size_t room;
@@ -1105,6 +1372,9 @@ static nghttp2_hd_entry *add_hd_table_incremental(nghttp2_hd_context *context,
                    ent->nv.name, ent->nv.value));
 
     hd_ringbuf_pop_back(&context->hd_table);
+    if (map) {
+      hd_map_remove(map, ent);
+    }
     if (--ent->ref == 0) {
       nghttp2_hd_entry_free(ent, mem);
       nghttp2_mem_free(mem, ent);
@@ -1152,6 +1422,14 @@ static nghttp2_hd_entry *add_hd_table_incremental(nghttp2_hd_context *context,
       return NULL;
     }
 
+    new_ent->seq = context->next_seq++;
+
+    if (map) {
+      new_ent->name_hash = name_hash;
+      new_ent->nv_hash = nv_hash;
+      hd_map_insert(map, new_ent);
+    }
+
     context->hd_table_bufsize += room;
   }
   return new_ent;
@@ -1192,11 +1470,22 @@ static search_result search_static_table(const nghttp2_nv *nv, int token,
   return res;
 }
 
+/*
+ * Returns the index of |ent| in the header table of |context|.  |ent|
+ * must be in the dynamic header table.
+ */
+static ssize_t hd_table_index(nghttp2_hd_context *context,
+                              nghttp2_hd_entry *ent) {
+  return (ssize_t)(context->next_seq - 1 - ent->seq) +
+         NGHTTP2_STATIC_TABLE_LENGTH;
+}
+
 static search_result search_hd_table(nghttp2_hd_context *context,
-                                     const nghttp2_nv *nv, int token,
-                                     int indexing_mode) {
+                                     nghttp2_hd_map *map, const nghttp2_nv *nv,
+                                     int token, uint32_t name_hash,
+                                     uint32_t nv_hash, int indexing_mode) {
   search_result res = {-1, 0};
-  size_t i;
+  nghttp2_hd_entry *ent;
 
   if (token >= 0 && token <= NGHTTP2_TOKEN_WWW_AUTHENTICATE) {
     res = search_static_table(nv, token, indexing_mode);
@@ -1205,27 +1494,43 @@ static search_result search_hd_table(nghttp2_hd_context *context,
     }
   }
 
-  for (i = 0; i < context->hd_table.len; ++i) {
-    nghttp2_hd_entry *ent = hd_ringbuf_get(&context->hd_table, i);
-    if (ent->token != token || (token == -1 && !name_eq(&ent->nv, nv))) {
-      continue;
-    }
-
-    if (res.index == -1) {
-      res.index = (ssize_t)(i + NGHTTP2_STATIC_TABLE_LENGTH);
-    }
+  if (indexing_mode != NGHTTP2_HD_NEVER_INDEXING) {
+    for (ent = map->nv_table[nv_hash & map->mask]; ent; ent = ent->nv_next) {
+      if (ent->nv_hash != nv_hash || ent->token != token ||
+          (token == -1 && !name_eq(&ent->nv, nv)) || !value_eq(&ent->nv, nv)) {
+        continue;
+      }
 
-    if (indexing_mode != NGHTTP2_HD_NEVER_INDEXING && value_eq(&ent->nv, nv)) {
-      res.index = (ssize_t)(i + NGHTTP2_STATIC_TABLE_LENGTH);
+      res.index = hd_table_index(context, ent);
       res.name_value_match = 1;
       return res;
     }
   }
 
+  if (res.index != -1) {
+    return res;
+  }
+
+  for (ent = map->name_table[name_hash & map->mask]; ent;
+       ent = ent->name_next) {
+    if (ent->token != token || (token == -1 && !name_eq(&ent->nv, nv))) {
+      continue;
+    }
+
+    res.index = hd_table_index(context, ent);
+    return res;
+  }
+
   return res;
 }
 
-static void hd_context_shrink_table_size(nghttp2_hd_context *context) {
+/*
+ * Evicts entries from the dynamic header table of |context| until it
+ * fits in hd_table_bufsize_max.  If |map| is not NULL, the evicted
+ * entries are removed from it as well.
+ */
+static void hd_context_shrink_table_size(nghttp2_hd_context *context,
+                                         nghttp2_hd_map *map) {
   nghttp2_mem *mem;
 
   mem = context->mem;
@@ -1236,6 +1541,9 @@ static void hd_context_shrink_table_size(nghttp2_hd_context *context) {
     nghttp2_hd_entry *ent = hd_ringbuf_get(&context->hd_table, idx);
     context->hd_table_bufsize -= entry_room(ent->nv.namelen, ent->nv.valuelen);
     hd_ringbuf_pop_back(&context->hd_table);
+    if (map) {
+      hd_map_remove(map, ent);
+    }
     if (--ent->ref == 0) {
       nghttp2_hd_entry_free(ent, mem);
       nghttp2_mem_free(mem, ent);
@@ -1255,7 +1563,36 @@ int nghttp2_hd_deflate_change_table_size(nghttp2_hd_deflater *deflater,
 
   deflater->notify_table_size_change = 1;
 
-  hd_context_shrink_table_size(&deflater->ctx);
+  hd_context_shrink_table_size(&deflater->ctx, &deflater->map);
+  return 0;
+}
+
+int nghttp2_hd_deflate_set_indexing_strategy(
+    nghttp2_hd_deflater *deflater, nghttp2_hd_indexing_strategy strategy,
+    size_t param) {
+  switch (strategy) {
+  case NGHTTP2_HD_INDEXING_DEFAULT:
+    break;
+  case NGHTTP2_HD_INDEXING_FREQUENCY:
+    if (deflater->seen) {
+      break;
+    }
+    deflater->seen = nghttp2_mem_calloc(deflater->ctx.mem,
+                                        NGHTTP2_HD_SEEN_LENGTH,
+                                        sizeof(nghttp2_hd_seen));
+    if (deflater->seen == NULL) {
+      return NGHTTP2_ERR_NOMEM;
+    }
+    break;
+  case NGHTTP2_HD_INDEXING_VALUE_SIZE:
+    deflater->max_indexed_valuelen = param;
+    break;
+  default:
+    return NGHTTP2_ERR_INVALID_ARGUMENT;
+  }
+
+  deflater->indexing_strategy = (uint8_t)strategy;
+
   return 0;
 }
 
@@ -1263,7 +1600,7 @@ int nghttp2_hd_inflate_change_table_size(nghttp2_hd_inflater *inflater,
                                          size_t settings_hd_table_bufsize_max) {
   inflater->settings_hd_table_bufsize_max = settings_hd_table_bufsize_max;
   inflater->ctx.hd_table_bufsize_max = settings_hd_table_bufsize_max;
-  hd_context_shrink_table_size(&inflater->ctx);
+  hd_context_shrink_table_size(&inflater->ctx, NULL);
   return 0;
 }
 
@@ -1285,15 +1622,56 @@ nghttp2_hd_entry *nghttp2_hd_table_get(nghttp2_hd_context *context,
   }
 }
 
+/*
+ * Returns nonzero if |nv| whose hash is |nv_hash| is likely reused
+ * while it is still in the dynamic table.  We remember the value of
+ * deflater->indexed_bytes when the pair was seen last time.  If less
+ * than the table size has been inserted since then, the entry added
+ * at that time would have been still alive now.  We use this as the
+ * estimate of the future reuse.
+ */
+static int hd_deflate_seen_recently(nghttp2_hd_deflater *deflater,
+                                    uint32_t nv_hash) {
+  nghttp2_hd_seen *seen;
+  int rv;
+
+  seen = &deflater->seen[nv_hash & (NGHTTP2_HD_SEEN_LENGTH - 1)];
+
+  rv = seen->mark != 0 && seen->hash == nv_hash &&
+       deflater->indexed_bytes + 1 - seen->mark <=
+           deflater->ctx.hd_table_bufsize_max;
+
+  seen->hash = nv_hash;
+  seen->mark = deflater->indexed_bytes + 1;
+
+  return rv;
+}
+
 static int hd_deflate_decide_indexing(nghttp2_hd_deflater *deflater,
-                                      const nghttp2_nv *nv, int token) {
+                                      const nghttp2_nv *nv, int token,
+                                      uint32_t nv_hash) {
+  if (entry_room(nv->namelen, nv->valuelen) >
+      deflater->ctx.hd_table_bufsize_max * 3 / 4) {
+    return NGHTTP2_HD_WITHOUT_INDEXING;
+  }
+
+  switch (deflater->indexing_strategy) {
+  case NGHTTP2_HD_INDEXING_FREQUENCY:
+    return hd_deflate_seen_recently(deflater, nv_hash)
+               ? NGHTTP2_HD_WITH_INDEXING
+               : NGHTTP2_HD_WITHOUT_INDEXING;
+  case NGHTTP2_HD_INDEXING_VALUE_SIZE:
+    if (nv->valuelen > deflater->max_indexed_valuelen) {
+      return NGHTTP2_HD_WITHOUT_INDEXING;
+    }
+    break;
+  }
+
   if (token == NGHTTP2_TOKEN__PATH || token == NGHTTP2_TOKEN_AGE ||
       token == NGHTTP2_TOKEN_CONTENT_LENGTH || token == NGHTTP2_TOKEN_ETAG ||
       token == NGHTTP2_TOKEN_IF_MODIFIED_SINCE ||
       token == NGHTTP2_TOKEN_IF_NONE_MATCH || token == NGHTTP2_TOKEN_LOCATION ||
-      token == NGHTTP2_TOKEN_SET_COOKIE ||
-      entry_room(nv->namelen, nv->valuelen) >
-          deflater->ctx.hd_table_bufsize_max * 3 / 4) {
+      token == NGHTTP2_TOKEN_SET_COOKIE) {
     return NGHTTP2_HD_WITHOUT_INDEXING;
   }
 
@@ -1307,6 +1685,8 @@ static int deflate_nv(nghttp2_hd_deflater *deflater, nghttp2_bufs *bufs,
   ssize_t idx;
   int indexing_mode;
   int token;
+  uint32_t name_hash;
+  uint32_t nv_hash;
   nghttp2_mem *mem;
 
   DEBUGF(fprintf(stderr, "deflatehd: deflating %s: %s\n", nv->name, nv->value));
@@ -1314,6 +1694,8 @@ static int deflate_nv(nghttp2_hd_deflater *deflater, nghttp2_bufs *bufs,
   mem = deflater->ctx.mem;
 
   token = lookup_token(nv->name, nv->namelen);
+  name_hash = hd_name_hash(nv, token);
+  nv_hash = hd_nv_hash(nv, name_hash);
 
   /* Don't index authorization header field since it may contain low
      entropy secret data (e.g., id/password).  Also cookie header
@@ -1324,9 +1706,10 @@ static int deflate_nv(nghttp2_hd_deflater *deflater, nghttp2_bufs *bufs,
               (token == NGHTTP2_TOKEN_COOKIE && nv->valuelen < 20) ||
               (nv->flags & NGHTTP2_NV_FLAG_NO_INDEX)
           ? NGHTTP2_HD_NEVER_INDEXING
-          : hd_deflate_decide_indexing(deflater, nv, token);
+          : hd_deflate_decide_indexing(deflater, nv, token, nv_hash);
 
-  res = search_hd_table(&deflater->ctx, nv, token, indexing_mode);
+  res = search_hd_table(&deflater->ctx, &deflater->map, nv, token, name_hash,
+                        nv_hash, indexing_mode);
 
   idx = res.index;
 
@@ -1352,25 +1735,29 @@ static int deflate_nv(nghttp2_hd_deflater *deflater, nghttp2_bufs *bufs,
       nghttp2_nv nv_indname;
       nv_indname = *nv;
       nv_indname.name = nghttp2_hd_table_get(&deflater->ctx, idx)->nv.name;
-      new_ent = add_hd_table_incremental(&deflater->ctx, &nv_indname, token,
-                                         NGHTTP2_HD_FLAG_VALUE_ALLOC);
+      new_ent = add_hd_table_incremental(
+          &deflater->ctx, &nv_indname, token, NGHTTP2_HD_FLAG_VALUE_ALLOC,
+          &deflater->map, name_hash, nv_hash);
     } else {
-      new_ent = add_hd_table_incremental(&deflater->ctx, nv, token,
-                                         NGHTTP2_HD_FLAG_NAME_ALLOC |
-                                             NGHTTP2_HD_FLAG_VALUE_ALLOC);
+      new_ent = add_hd_table_incremental(
+          &deflater->ctx, nv, token,
+          NGHTTP2_HD_FLAG_NAME_ALLOC | NGHTTP2_HD_FLAG_VALUE_ALLOC,
+          &deflater->map, name_hash, nv_hash);
     }
     if (!new_ent) {
       return NGHTTP2_ERR_HEADER_COMP;
     }
+    deflater->indexed_bytes += entry_room(nv->namelen, nv->valuelen);
     if (new_ent->ref == 0) {
       nghttp2_hd_entry_free(new_ent, mem);
       nghttp2_mem_free(mem, new_ent);
     }
   }
   if (idx == -1) {
-    rv = emit_newname_block(bufs, nv, indexing_mode);
+    rv = emit_newname_block(bufs, nv, indexing_mode, deflater->string_cache);
   } else {
-    rv = emit_indname_block(bufs, idx, nv, indexing_mode);
+    rv = emit_indname_block(bufs, idx, nv, indexing_mode,
+                            deflater->string_cache);
   }
   if (rv != 0) {
     return rv;
@@ -1534,6 +1921,106 @@ void nghttp2_hd_deflate_del(nghttp2_hd_deflater *deflater) {
   nghttp2_mem_free(mem, deflater);
 }
 
+int nghttp2_hd_string_cache_new(nghttp2_hd_string_cache **cache_ptr,
+                                nghttp2_mem *mem) {
+  nghttp2_hd_string_cache *cache;
+
+  if (mem == NULL) {
+    mem = nghttp2_mem_default();
+  }
+
+  cache = nghttp2_mem_calloc(mem, 1, sizeof(nghttp2_hd_string_cache));
+  if (cache == NULL) {
+    return NGHTTP2_ERR_NOMEM;
+  }
+
+  cache->mem = mem;
+
+  *cache_ptr = cache;
+
+  return 0;
+}
+
+void nghttp2_hd_string_cache_del(nghttp2_hd_string_cache *cache) {
+  nghttp2_hd_cached_string *ent, *next;
+  size_t i;
+
+  if (cache == NULL) {
+    return;
+  }
+
+  for (i = 0; i < NGHTTP2_HD_STRING_CACHE_LENGTH; ++i) {
+    for (ent = cache->table[i]; ent; ent = next) {
+      next = ent->next;
+      nghttp2_mem_free(cache->mem, ent);
+    }
+  }
+
+  nghttp2_mem_free(cache->mem, cache);
+}
+
+int nghttp2_hd_string_cache_add(nghttp2_hd_string_cache *cache,
+                                const uint8_t *str, size_t len) {
+  int rv;
+  nghttp2_hd_cached_string *ent;
+  nghttp2_bufs bufs;
+  size_t enclen;
+  size_t blocklen;
+  uint8_t *p;
+
+  if (hd_string_cache_find(cache, str, len)) {
+    return 0;
+  }
+
+  enclen = nghttp2_hd_huff_encode_count_bounded(str, len);
+  blocklen = count_encoded_length(enclen, 7) + enclen;
+
+  ent = nghttp2_mem_malloc(cache->mem,
+                           sizeof(nghttp2_hd_cached_string) + len + blocklen);
+  if (ent == NULL) {
+    return NGHTTP2_ERR_NOMEM;
+  }
+
+  p = (uint8_t *)ent + sizeof(nghttp2_hd_cached_string);
+
+  memcpy(p, str, len);
+  ent->str = p;
+  ent->len = len;
+
+  p += len;
+
+  rv = nghttp2_bufs_wrap_init(&bufs, p, blocklen, cache->mem);
+  if (rv != 0) {
+    nghttp2_mem_free(cache->mem, ent);
+    return rv;
+  }
+
+  rv = emit_string(&bufs, str, len, NULL);
+
+  nghttp2_bufs_wrap_free(&bufs);
+
+  if (rv != 0) {
+    nghttp2_mem_free(cache->mem, ent);
+    return NGHTTP2_ERR_HEADER_COMP;
+  }
+
+  ent->encoded = p;
+  ent->encodedlen = blocklen;
+  ent->hash = hd_hash(HD_HASH_INIT, str, len);
+
+  ent->next = cache->table[ent->hash & (NGHTTP2_HD_STRING_CACHE_LENGTH - 1)];
+  cache->table[ent->hash & (NGHTTP2_HD_STRING_CACHE_LENGTH - 1)] = ent;
+
+  cache->lenmask[(len & 0xff) >> 3] |= (uint8_t)(1 << (len & 0x7));
+
+  return 0;
+}
+
+void nghttp2_hd_deflate_set_string_cache(nghttp2_hd_deflater *deflater,
+                                         const nghttp2_hd_string_cache *cache) {
+  deflater->string_cache = cache;
+}
+
 static void hd_inflate_set_huffman_encoded(nghttp2_hd_inflater *inflater,
                                            const uint8_t *in) {
   inflater->huffman_encoded = (*in & (1 << 7)) != 0;
@@ -1654,11 +2141,17 @@ static ssize_t hd_inflate_read(nghttp2_hd_inflater *inflater,
  *   Out of memory
  */
 static int hd_inflate_commit_indexed(nghttp2_hd_inflater *inflater,
-                                     nghttp2_nv *nv_out, int *token_out) {
+                                     nghttp2_nv *nv_out, int *token_out,
+                                     nghttp2_hd_entry **ent_out) {
   nghttp2_hd_entry *ent = nghttp2_hd_table_get(&inflater->ctx, inflater->index);
 
   emit_indexed_header(nv_out, token_out, ent);
 
+  if (ent_out) {
+    nghttp2_hd_entry_incref(ent);
+    *ent_out = ent;
+  }
+
   return 0;
 }
 
@@ -1768,6 +2261,66 @@ static int hd_inflate_remove_bufs_with_name(nghttp2_hd_inflater *inflater,
   return 0;
 }
 
+/*
+ * Allocates new entry which holds the copy of |nv| in a single memory
+ * block, and assigns it to |*ent_out|.  If |copy_name| is zero,
+ * nv->name is not copied, and the entry just refers to it.  This is
+ * only allowed if nv->name outlives the entry (e.g., the name in
+ * static header table).  On success, nv->name and nv->value are
+ * updated to point to the memory held by the entry.
+ *
+ * This function returns 0 if it succeeds, or one of the following
+ * negative error codes:
+ *
+ * NGHTTP2_ERR_NOMEM
+ *   Out of memory
+ */
+static int hd_inflate_new_literal_entry(nghttp2_hd_inflater *inflater,
+                                        nghttp2_hd_entry **ent_out,
+                                        nghttp2_nv *nv, int token,
+                                        int copy_name) {
+  size_t buflen;
+  uint8_t *p;
+  nghttp2_hd_entry *ent;
+  nghttp2_mem *mem;
+
+  mem = inflater->ctx.mem;
+
+  buflen = sizeof(nghttp2_hd_entry) + nv->valuelen + 1;
+  if (copy_name) {
+    buflen += nv->namelen + 1;
+  }
+
+  p = nghttp2_mem_malloc(mem, buflen);
+  if (p == NULL) {
+    return NGHTTP2_ERR_NOMEM;
+  }
+
+  ent = (nghttp2_hd_entry *)(void *)p;
+  p += sizeof(nghttp2_hd_entry);
+
+  if (copy_name) {
+    memcpy(p, nv->name, nv->namelen);
+    p[nv->namelen] = '\0';
+    nv->name = p;
+    p += nv->namelen + 1;
+  }
+
+  memcpy(p, nv->value, nv->valuelen);
+  p[nv->valuelen] = '\0';
+  nv->value = p;
+
+  /* name and value live in the same memory block with ent, so they
+     are freed together with ent.  This never fails because no
+     allocation is done. */
+  nghttp2_hd_entry_init(ent, NGHTTP2_HD_FLAG_NONE, nv->name, nv->namelen,
+                        nv->value, nv->valuelen, token, mem);
+
+  *ent_out = ent;
+
+  return 0;
+}
+
 /*
  * Finalize literal header representation - new name- reception. If
  * header is emitted, |*nv_out| is filled with that value and 0 is
@@ -1780,7 +2333,8 @@ static int hd_inflate_remove_bufs_with_name(nghttp2_hd_inflater *inflater,
  *   Out of memory
  */
 static int hd_inflate_commit_newname(nghttp2_hd_inflater *inflater,
-                                     nghttp2_nv *nv_out, int *token_out) {
+                                     nghttp2_nv *nv_out, int *token_out,
+                                     nghttp2_hd_entry **ent_out) {
   int rv;
   nghttp2_nv nv;
   nghttp2_mem *mem;
@@ -1807,12 +2361,19 @@ static int hd_inflate_commit_newname(nghttp2_hd_inflater *inflater,
        management. */
     ent_flags = NGHTTP2_HD_FLAG_NAME_ALLOC | NGHTTP2_HD_FLAG_NAME_GIFT;
 
-    new_ent = add_hd_table_incremental(
-        &inflater->ctx, &nv, lookup_token(nv.name, nv.namelen), ent_flags);
+    new_ent = add_hd_table_incremental(&inflater->ctx, &nv,
+                                       lookup_token(nv.name, nv.namelen),
+                                       ent_flags, NULL, 0, 0);
 
     if (new_ent) {
       emit_indexed_header(nv_out, token_out, new_ent);
-      inflater->ent_keep = new_ent;
+
+      if (ent_out) {
+        nghttp2_hd_entry_incref(new_ent);
+        *ent_out = new_ent;
+      } else {
+        inflater->ent_keep = new_ent;
+      }
 
       return 0;
     }
@@ -1822,12 +2383,21 @@ static int hd_inflate_commit_newname(nghttp2_hd_inflater *inflater,
     return NGHTTP2_ERR_NOMEM;
   }
 
-  emit_literal_header(nv_out, token_out, &nv);
-
   if (nv.name != inflater->nvbufs.head->buf.pos) {
     inflater->nv_keep = nv.name;
   }
 
+  if (ent_out) {
+    rv = hd_inflate_new_literal_entry(inflater, ent_out, &nv,
+                                      lookup_token(nv.name, nv.namelen),
+                                      1 /* copy name */);
+    if (rv != 0) {
+      return rv;
+    }
+  }
+
+  emit_literal_header(nv_out, token_out, &nv);
+
   return 0;
 }
 
@@ -1843,7 +2413,8 @@ static int hd_inflate_commit_newname(nghttp2_hd_inflater *inflater,
  *   Out of memory
  */
 static int hd_inflate_commit_indname(nghttp2_hd_inflater *inflater,
-                                     nghttp2_nv *nv_out, int *token_out) {
+                                     nghttp2_nv *nv_out, int *token_out,
+                                     nghttp2_hd_entry **ent_out) {
   int rv;
   nghttp2_nv nv;
   nghttp2_hd_entry *ent_name;
@@ -1883,14 +2454,19 @@ static int hd_inflate_commit_indname(nghttp2_hd_inflater *inflater,
     }
 
     new_ent = add_hd_table_incremental(&inflater->ctx, &nv, ent_name->token,
-                                       ent_flags);
+                                       ent_flags, NULL, 0, 0);
 
     /* At this point, ent_name might be deleted. */
 
     if (new_ent) {
       emit_indexed_header(nv_out, token_out, new_ent);
 
-      inflater->ent_keep = new_ent;
+      if (ent_out) {
+        nghttp2_hd_entry_incref(new_ent);
+        *ent_out = new_ent;
+      } else {
+        inflater->ent_keep = new_ent;
+      }
 
       return 0;
     }
@@ -1909,15 +2485,26 @@ static int hd_inflate_commit_indname(nghttp2_hd_inflater *inflater,
     return NGHTTP2_ERR_NOMEM;
   }
 
+  if (nv.value != inflater->nvbufs.head->buf.pos) {
+    inflater->nv_keep = nv.value;
+  }
+
   nv.name = ent_name->nv.name;
   nv.namelen = ent_name->nv.namelen;
 
-  emit_literal_header(nv_out, token_out, &nv);
-
-  if (nv.value != inflater->nvbufs.head->buf.pos) {
-    inflater->nv_keep = nv.value;
+  if (ent_out) {
+    /* The name in static header table is never freed, so we don't
+       have to copy it. */
+    rv = hd_inflate_new_literal_entry(
+        inflater, ent_out, &nv, ent_name->token,
+        inflater->index >= NGHTTP2_STATIC_TABLE_LENGTH);
+    if (rv != 0) {
+      return rv;
+    }
   }
 
+  emit_literal_header(nv_out, token_out, &nv);
+
   return 0;
 }
 
@@ -1934,6 +2521,14 @@ ssize_t nghttp2_hd_inflate_hd2(nghttp2_hd_inflater *inflater,
                                nghttp2_nv *nv_out, int *inflate_flags,
                                int *token_out, uint8_t *in, size_t inlen,
                                int in_final) {
+  return nghttp2_hd_inflate_hd_ref(inflater, nv_out, inflate_flags, token_out,
+                                   NULL, in, inlen, in_final);
+}
+
+ssize_t nghttp2_hd_inflate_hd_ref(nghttp2_hd_inflater *inflater,
+                                  nghttp2_nv *nv_out, int *inflate_flags,
+                                  int *token_out, nghttp2_hd_entry **ent_out,
+                                  uint8_t *in, size_t inlen, int in_final) {
   ssize_t rv = 0;
   uint8_t *first = in;
   uint8_t *last = in + inlen;
@@ -1947,6 +2542,9 @@ ssize_t nghttp2_hd_inflate_hd2(nghttp2_hd_inflater *inflater,
   DEBUGF(fprintf(stderr, "inflatehd: start state=%d\n", inflater->state));
   hd_inflate_keep_free(inflater);
   *token_out = -1;
+  if (ent_out) {
+    *ent_out = NULL;
+  }
   *inflate_flags = NGHTTP2_HD_INFLATE_NONE;
   for (; in != last || busy;) {
     busy = 0;
@@ -1996,7 +2594,7 @@ ssize_t nghttp2_hd_inflate_hd2(nghttp2_hd_inflater *inflater,
       }
       DEBUGF(fprintf(stderr, "inflatehd: table_size=%zu\n", inflater->left));
       inflater->ctx.hd_table_bufsize_max = inflater->left;
-      hd_context_shrink_table_size(&inflater->ctx);
+      hd_context_shrink_table_size(&inflater->ctx, NULL);
       inflater->state = NGHTTP2_HD_STATE_OPCODE;
       break;
     case NGHTTP2_HD_STATE_READ_INDEX: {
@@ -2033,7 +2631,7 @@ ssize_t nghttp2_hd_inflate_hd2(nghttp2_hd_inflater *inflater,
         inflater->index = inflater->left;
         --inflater->index;
 
-        rv = hd_inflate_commit_indexed(inflater, nv_out, token_out);
+        rv = hd_inflate_commit_indexed(inflater, nv_out, token_out, ent_out);
         if (rv < 0) {
           goto fail;
         }
@@ -2192,9 +2790,9 @@ ssize_t nghttp2_hd_inflate_hd2(nghttp2_hd_inflater *inflater,
       }
 
       if (inflater->opcode == NGHTTP2_HD_OPCODE_NEWNAME) {
-        rv = hd_inflate_commit_newname(inflater, nv_out, token_out);
+        rv = hd_inflate_commit_newname(inflater, nv_out, token_out, ent_out);
       } else {
-        rv = hd_inflate_commit_indname(inflater, nv_out, token_out);
+        rv = hd_inflate_commit_indname(inflater, nv_out, token_out, ent_out);
       }
 
       if (rv != 0) {
@@ -2229,9 +2827,9 @@ ssize_t nghttp2_hd_inflate_hd2(nghttp2_hd_inflater *inflater,
       }
 
       if (inflater->opcode == NGHTTP2_HD_OPCODE_NEWNAME) {
-        rv = hd_inflate_commit_newname(inflater, nv_out, token_out);
+        rv = hd_inflate_commit_newname(inflater, nv_out, token_out, ent_out);
       } else {
-        rv = hd_inflate_commit_indname(inflater, nv_out, token_out);
+        rv = hd_inflate_commit_indname(inflater, nv_out, token_out, ent_out);
       }
 
       if (rv != 0) {
@@ -2329,12 +2927,12 @@ void nghttp2_hd_inflate_del(nghttp2_hd_inflater *inflater) {
 int nghttp2_hd_emit_indname_block(nghttp2_bufs *bufs, size_t idx,
                                   nghttp2_nv *nv, int indexing_mode) {
 
-  return emit_indname_block(bufs, idx, nv, indexing_mode);
+  return emit_indname_block(bufs, idx, nv, indexing_mode, NULL);
 }
 
 int nghttp2_hd_emit_newname_block(nghttp2_bufs *bufs, nghttp2_nv *nv,
                                   int indexing_mode) {
-  return emit_newname_block(bufs, nv, indexing_mode);
+  return emit_newname_block(bufs, nv, indexing_mode, NULL);
 }
 
 int nghttp2_hd_emit_table_size(nghttp2_bufs *bufs, size_t table_size) {
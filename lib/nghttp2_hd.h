@@ -126,15 +126,47 @@ typedef enum {
   NGHTTP2_HD_FLAG_VALUE_GIFT = 1 << 3
 } nghttp2_hd_flags;
 
-typedef struct {
+typedef struct nghttp2_hd_entry nghttp2_hd_entry;
+
+struct nghttp2_hd_entry {
   nghttp2_nv nv;
+  /* The next entry in the same bucket of nghttp2_hd_map, keyed by
+     name.  Only used by deflater. */
+  nghttp2_hd_entry *name_next;
+  /* The next entry in the same bucket of nghttp2_hd_map, keyed by
+     name/value pair.  Only used by deflater. */
+  nghttp2_hd_entry *nv_next;
   /* nghttp2_token value for nv.name.  It could be -1 if we have no
      token for that header field name. */
   int token;
-  /* Reference count */
-  uint8_t ref;
+  /* The sequence number of this entry.  This is used to compute the
+     index of this entry in dynamic header table.  Only used by
+     deflater. */
+  uint32_t seq;
+  /* Hash value of nv.name.  Only used by deflater. */
+  uint32_t name_hash;
+  /* Hash value of nv.name and nv.value.  Only used by deflater. */
+  uint32_t nv_hash;
+  /* Reference count.  The inflater hands out references to
+     application through nghttp2_rcnv. */
+  uint32_t ref;
   uint8_t flags;
-} nghttp2_hd_entry;
+  /* Memory allocator used to free this entry.  This is NULL for the
+     entries in static header table, which are never freed. */
+  nghttp2_mem *mem;
+};
+
+/* Hash index of entries in dynamic header table.  The deflater uses
+   this to find an entry without scanning the whole table. */
+typedef struct {
+  /* Buckets keyed by name hash */
+  nghttp2_hd_entry **name_table;
+  /* Buckets keyed by name/value hash */
+  nghttp2_hd_entry **nv_table;
+  /* The number of buckets minus 1.  The number of buckets is always
+     power of 2. */
+  size_t mask;
+} nghttp2_hd_map;
 
 typedef struct {
   nghttp2_hd_entry **buffer;
@@ -181,14 +213,75 @@ typedef struct {
   size_t hd_table_bufsize;
   /* The effective header table size. */
   size_t hd_table_bufsize_max;
+  /* The sequence number assigned to the next entry inserted into
+     hd_table. */
+  uint32_t next_seq;
   /* If inflate/deflate error occurred, this value is set to 1 and
      further invocation of inflate/deflate will fail with
      NGHTTP2_ERR_HEADER_COMP. */
   uint8_t bad;
 } nghttp2_hd_context;
 
+/* The number of buckets in nghttp2_hd_string_cache.  This must be
+   power of 2. */
+#define NGHTTP2_HD_STRING_CACHE_LENGTH 64
+
+typedef struct nghttp2_hd_cached_string nghttp2_hd_cached_string;
+
+/* Pre-encoded HPACK string literal.  The original string and its
+   encoded form are allocated in the same memory block following
+   this struct. */
+struct nghttp2_hd_cached_string {
+  nghttp2_hd_cached_string *next;
+  /* The original string */
+  const uint8_t *str;
+  /* The string literal representation, including length prefix and
+     Huffman flag */
+  const uint8_t *encoded;
+  size_t len;
+  size_t encodedlen;
+  uint32_t hash;
+};
+
+struct nghttp2_hd_string_cache {
+  nghttp2_mem *mem;
+  nghttp2_hd_cached_string *table[NGHTTP2_HD_STRING_CACHE_LENGTH];
+  /* Bit (len & 0xff) is set if a string of length len is cached.
+     This avoids hashing most strings which are not cached. */
+  uint8_t lenmask[32];
+};
+
+/* The number of slots in nghttp2_hd_deflater.seen.  This must be
+   power of 2. */
+#define NGHTTP2_HD_SEEN_LENGTH 256
+
+/* Record of name/value pair recently deflated, used by
+   NGHTTP2_HD_INDEXING_FREQUENCY */
+typedef struct {
+  /* The hash of name/value pair */
+  uint32_t hash;
+  /* nghttp2_hd_deflater.indexed_bytes + 1 when this pair was last
+     seen.  0 if this slot is unused. */
+  size_t mark;
+} nghttp2_hd_seen;
+
 struct nghttp2_hd_deflater {
   nghttp2_hd_context ctx;
+  /* Hash index of ctx.hd_table */
+  nghttp2_hd_map map;
+  /* Pre-encoded string literals consulted before Huffman encoding.
+     NULL if not set.  Not owned by deflater. */
+  const nghttp2_hd_string_cache *string_cache;
+  /* Array of NGHTTP2_HD_SEEN_LENGTH recently seen name/value pairs,
+     indexed by hash.  Allocated only if indexing_strategy is
+     NGHTTP2_HD_INDEXING_FREQUENCY. */
+  nghttp2_hd_seen *seen;
+  /* The total number of bytes of entries inserted into the dynamic
+     table so far */
+  size_t indexed_bytes;
+  /* The maximum length of value to be indexed.  Used by
+     NGHTTP2_HD_INDEXING_VALUE_SIZE. */
+  size_t max_indexed_valuelen;
   /* The upper limit of the header table size the deflater accepts. */
   size_t deflate_hd_table_bufsize_max;
   /* Minimum header table size notified in the next context update */
@@ -196,6 +289,8 @@ struct nghttp2_hd_deflater {
   /* If nonzero, send header table size using encoding context update
      in the next deflate process */
   uint8_t notify_table_size_change;
+  /* nghttp2_hd_indexing_strategy */
+  uint8_t indexing_strategy;
 };
 
 struct nghttp2_hd_inflater {
@@ -254,6 +349,19 @@ int nghttp2_hd_entry_init(nghttp2_hd_entry *ent, uint8_t flags, uint8_t *name,
 
 void nghttp2_hd_entry_free(nghttp2_hd_entry *ent, nghttp2_mem *mem);
 
+/*
+ * Increments the reference count of |ent| by 1.  This function does
+ * nothing for the entry in static header table.
+ */
+void nghttp2_hd_entry_incref(nghttp2_hd_entry *ent);
+
+/*
+ * Decrements the reference count of |ent| by 1, and frees it if the
+ * reference count becomes 0.  This function does nothing if |ent| is
+ * NULL or it is in static header table.
+ */
+void nghttp2_hd_entry_decref(nghttp2_hd_entry *ent);
+
 /*
  * Initializes |deflater| for deflating name/values pairs.
  *
@@ -292,6 +400,13 @@ int nghttp2_hd_deflate_init2(nghttp2_hd_deflater *deflater,
  */
 void nghttp2_hd_deflate_free(nghttp2_hd_deflater *deflater);
 
+/*
+ * Puts |deflater| back to the state right after initialization,
+ * keeping the memory allocated for its header table and hash index.
+ * The indexing strategy and the string cache are kept.
+ */
+void nghttp2_hd_deflate_reset(nghttp2_hd_deflater *deflater);
+
 /*
  * Deflates the |nva|, which has the |nvlen| name/value pairs, into
  * the |bufs|.
@@ -332,6 +447,12 @@ int nghttp2_hd_inflate_init(nghttp2_hd_inflater *inflater, nghttp2_mem *mem);
  */
 void nghttp2_hd_inflate_free(nghttp2_hd_inflater *inflater);
 
+/*
+ * Puts |inflater| back to the state right after initialization,
+ * keeping the memory allocated for its header table and buffers.
+ */
+void nghttp2_hd_inflate_reset(nghttp2_hd_inflater *inflater);
+
 /*
  * Similar to nghttp2_hd_inflate_hd(), but this takes additional
  * output parameter |token|.  On successful header emission, it
@@ -344,6 +465,22 @@ ssize_t nghttp2_hd_inflate_hd2(nghttp2_hd_inflater *inflater,
                                int *token, uint8_t *in, size_t inlen,
                                int in_final);
 
+/*
+ * Similar to nghttp2_hd_inflate_hd2(), but this takes additional
+ * output parameter |ent_out|.  On successful header emission, it
+ * contains the refcounted entry which holds the emitted header field,
+ * and the caller owns one reference to it.  The caller must release
+ * it with nghttp2_hd_entry_decref().  Header fields in header table
+ * are shared with it, and other header fields are copied into newly
+ * allocated entry.  *nv_out points to the memory held by *ent_out.
+ * If |ent_out| is NULL, this function is the same as
+ * nghttp2_hd_inflate_hd2().
+ */
+ssize_t nghttp2_hd_inflate_hd_ref(nghttp2_hd_inflater *inflater,
+                                  nghttp2_nv *nv_out, int *inflate_flags,
+                                  int *token, nghttp2_hd_entry **ent_out,
+                                  uint8_t *in, size_t inlen, int in_final);
+
 /* For unittesting purpose */
 int nghttp2_hd_emit_indname_block(nghttp2_bufs *bufs, size_t index,
                                   nghttp2_nv *nv, int indexing_mode);
@@ -375,6 +512,18 @@ ssize_t nghttp2_hd_decode_length(uint32_t *res, size_t *shift_ptr, int *final,
  */
 size_t nghttp2_hd_huff_encode_count(const uint8_t *src, size_t len);
 
+/*
+ * Counts the required bytes to encode |src| with length |len| like
+ * nghttp2_hd_huff_encode_count(), but this function gives up counting
+ * as soon as it finds that huffman encoding does not make |src|
+ * shorter.
+ *
+ * This function returns the number of required bytes to encode given
+ * data if it is strictly less than |len|.  Otherwise, it returns
+ * |len|.  This function always succeeds.
+ */
+size_t nghttp2_hd_huff_encode_count_bounded(const uint8_t *src, size_t len);
+
 /*
  * Encodes the given data |src| with length |srclen| to the |bufs|.
  * This function expands extra buffers in |bufs| if necessary.
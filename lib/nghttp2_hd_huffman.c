@@ -29,135 +29,274 @@
 #include <stdio.h>
 
 #include "nghttp2_hd.h"
+#include "nghttp2_net.h"
+#include "nghttp2_simd.h"
 
 extern const nghttp2_huff_sym huff_sym_table[];
 extern const nghttp2_huff_decode huff_decode_table[][16];
+extern const nghttp2_huff_decode_fast huff_decode_fast_table[];
+extern const nghttp2_huff_decode_long huff_decode_long_table[];
+extern const uint16_t huff_decode_long_sym_table[];
 
-/*
- * Encodes huffman code |sym| into |*dest_ptr|, whose least |rembits|
- * bits are not filled yet.  The |rembits| must be in range [1, 8],
- * inclusive.  At the end of the process, the |*dest_ptr| is updated
- * and points where next output should be placed. The number of
- * unfilled bits in the pointed location is returned.
- */
-static ssize_t huff_encode_sym(nghttp2_bufs *bufs, size_t *avail_ptr,
-                               size_t rembits, const nghttp2_huff_sym *sym) {
-  int rv;
-  size_t nbits = sym->nbits;
-  uint32_t code = sym->code;
+size_t nghttp2_hd_huff_encode_count(const uint8_t *src, size_t len) {
+  const uint8_t *end = src + len;
+  size_t nbits = 0;
+  size_t nbits2 = 0;
 
-  /* We assume that sym->nbits <= 32 */
-  if (rembits > nbits) {
-    nghttp2_bufs_fast_orb_hold(bufs, code << (rembits - nbits));
-    return (ssize_t)(rembits - nbits);
+  /* Use 2 independent accumulators, so that the table lookups of
+     consecutive bytes do not wait for each other. */
+  for (; end - src >= 4; src += 4) {
+    nbits += huff_sym_table[src[0]].nbits + huff_sym_table[src[1]].nbits;
+    nbits2 += huff_sym_table[src[2]].nbits + huff_sym_table[src[3]].nbits;
   }
 
-  if (rembits == nbits) {
-    nghttp2_bufs_fast_orb(bufs, code);
-    --*avail_ptr;
-    return 8;
+  for (; src != end; ++src) {
+    nbits += huff_sym_table[*src].nbits;
   }
 
-  nghttp2_bufs_fast_orb(bufs, code >> (nbits - rembits));
-  --*avail_ptr;
+  nbits += nbits2;
 
-  nbits -= rembits;
-  if (nbits & 0x7) {
-    /* align code to MSB byte boundary */
-    code <<= 8 - (nbits & 0x7);
-  }
+  /* pad the prefix of EOS (256) */
+  return (nbits + 7) / 8;
+}
 
-  /* we lose at most 3 bytes, but it is not critical in practice */
-  if (*avail_ptr < (nbits + 7) / 8) {
-    rv = nghttp2_bufs_advance(bufs);
-    if (rv != 0) {
-      return rv;
+#ifdef NGHTTP2_HAVE_AVX2_DISPATCH
+/* The lengths of huffman code of printable ASCII characters and DEL,
+   that is 0x20 through 0x7f, taken from huff_sym_table */
+static const uint8_t huff_print_nbits[] = {
+    6, 10, 10, 12, 13, 6, 8, 11, 10, 10, 8, 11, 8, 6, 6, 6,
+    5, 5, 5, 6, 6, 6, 6, 6, 6, 6, 7, 8, 15, 6, 12, 10,
+    13, 6, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7,
+    7, 7, 7, 7, 7, 7, 7, 7, 8, 7, 8, 13, 19, 13, 14, 6,
+    15, 5, 6, 5, 6, 5, 6, 6, 6, 5, 7, 7, 6, 6, 6, 5,
+    6, 7, 6, 5, 5, 6, 7, 7, 7, 7, 7, 15, 11, 14, 13, 28,
+};
+
+#define HUFF_PRINT_NBITS(K)                                                    \
+  _mm256_and_si256(_mm256_cmpeq_epi8(hi, k##K), _mm256_shuffle_epi8(t##K, lo))
+
+/*
+ * Returns the number of bits to encode |src| of length |len|, which
+ * must be at least 32.  The lengths of the bytes in [0x20, 0x7f] are
+ * looked up by 16 byte shuffles, one for each upper 4 bits from 2 to
+ * 7.  The other bytes are counted as the shortest code among them: 13
+ * bits for control characters and 19 bits for bytes >= 0x80.  If
+ * there is such byte, |*pexact| is set to 0, and the returned value
+ * is a lower bound, which may be returned before all bytes are seen.
+ * Otherwise, |*pexact| is set to 1, and the returned value is exact.
+ */
+__attribute__((target("avx2"))) static size_t
+huff_encode_count_avx2(const uint8_t *src, size_t len, int *pexact) {
+  const uint8_t *end = src + len;
+  const __m256i zero = _mm256_setzero_si256();
+  const __m256i lomask = _mm256_set1_epi8(0x0f);
+  const __m256i space = _mm256_set1_epi8(' ');
+  const __m256i ctrl_nbits = _mm256_set1_epi8(13);
+  /* 13 + 6 = 19 bits for bytes >= 0x80 */
+  const __m256i nonascii_nbits = _mm256_set1_epi8(6);
+  const __m256i t2 = _mm256_broadcastsi128_si256(
+      _mm_loadu_si128((const __m128i *)(const void *)&huff_print_nbits[0]));
+  const __m256i t3 = _mm256_broadcastsi128_si256(
+      _mm_loadu_si128((const __m128i *)(const void *)&huff_print_nbits[16]));
+  const __m256i t4 = _mm256_broadcastsi128_si256(
+      _mm_loadu_si128((const __m128i *)(const void *)&huff_print_nbits[32]));
+  const __m256i t5 = _mm256_broadcastsi128_si256(
+      _mm_loadu_si128((const __m128i *)(const void *)&huff_print_nbits[48]));
+  const __m256i t6 = _mm256_broadcastsi128_si256(
+      _mm_loadu_si128((const __m128i *)(const void *)&huff_print_nbits[64]));
+  const __m256i t7 = _mm256_broadcastsi128_si256(
+      _mm_loadu_si128((const __m128i *)(const void *)&huff_print_nbits[80]));
+  const __m256i k2 = _mm256_set1_epi8(2);
+  const __m256i k3 = _mm256_set1_epi8(3);
+  const __m256i k4 = _mm256_set1_epi8(4);
+  const __m256i k5 = _mm256_set1_epi8(5);
+  const __m256i k6 = _mm256_set1_epi8(6);
+  const __m256i k7 = _mm256_set1_epi8(7);
+  __m256i x, hi, lo, v, ctrl, sum, keep;
+  uint64_t res[4];
+  size_t rem, nbits;
+
+  *pexact = 1;
+
+  sum = zero;
+  keep = _mm256_set1_epi8(-1);
+
+  while (src != end) {
+    if (end - src >= 32) {
+      x = _mm256_loadu_si256((const __m256i *)(const void *)src);
+      src += 32;
+    } else {
+      /* Reload the last 32 bytes, and discard the ones counted
+         already.  They are replaced with ' ' so that they do not
+         clear |*pexact|. */
+      rem = (size_t)(end - src);
+      src = end;
+      x = _mm256_loadu_si256((const __m256i *)(const void *)(end - 32));
+      keep = _mm256_cmpgt_epi8(
+          _mm256_setr_epi8(1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+                           16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28,
+                           29, 30, 31, 32),
+          _mm256_set1_epi8((char)(32 - rem)));
+      x = _mm256_or_si256(_mm256_and_si256(keep, x),
+                          _mm256_andnot_si256(keep, space));
     }
-    *avail_ptr = nghttp2_bufs_cur_avail(bufs);
-    /* we assume that we at least 3 buffer space available */
-    assert(*avail_ptr >= 3);
-  }
 
-  /* fast path, since most code is less than 8 */
-  if (nbits < 8) {
-    nghttp2_bufs_fast_addb_hold(bufs, code);
-    *avail_ptr = nghttp2_bufs_cur_avail(bufs);
-    return (ssize_t)(8 - nbits);
-  }
+    lo = _mm256_and_si256(x, lomask);
+    hi = _mm256_and_si256(_mm256_srli_epi16(x, 4), lomask);
+    /* Bytes >= 0x80 are negative in signed comparison */
+    ctrl = _mm256_cmpgt_epi8(space, x);
 
-  /* handle longer code path */
-  if (nbits > 24) {
-    nghttp2_bufs_fast_addb(bufs, code >> 24);
-    nbits -= 8;
-  }
+    v = _mm256_or_si256(
+        _mm256_or_si256(HUFF_PRINT_NBITS(2), HUFF_PRINT_NBITS(3)),
+        _mm256_or_si256(HUFF_PRINT_NBITS(4), HUFF_PRINT_NBITS(5)));
+    v = _mm256_or_si256(
+        v, _mm256_or_si256(HUFF_PRINT_NBITS(6), HUFF_PRINT_NBITS(7)));
+    v = _mm256_or_si256(v, _mm256_and_si256(ctrl, ctrl_nbits));
+    v = _mm256_add_epi8(
+        v, _mm256_and_si256(_mm256_cmpgt_epi8(zero, x), nonascii_nbits));
+    v = _mm256_and_si256(v, keep);
 
-  if (nbits > 16) {
-    nghttp2_bufs_fast_addb(bufs, code >> 16);
-    nbits -= 8;
-  }
+    sum = _mm256_add_epi64(sum, _mm256_sad_epu8(v, zero));
 
-  if (nbits > 8) {
-    nghttp2_bufs_fast_addb(bufs, code >> 8);
-    nbits -= 8;
-  }
+    if (_mm256_movemask_epi8(ctrl)) {
+      *pexact = 0;
 
-  if (nbits == 8) {
-    nghttp2_bufs_fast_addb(bufs, code);
-    *avail_ptr = nghttp2_bufs_cur_avail(bufs);
-    return 8;
+      /* Like nghttp2_hd_huff_encode_count_bounded(), give up as soon
+         as huffman code turns out to be longer, assuming that the
+         remaining bytes get the shortest code. */
+      _mm256_storeu_si256((__m256i *)(void *)res, sum);
+      nbits = (size_t)(res[0] + res[1] + res[2] + res[3]) +
+              (size_t)(end - src) * 5;
+      if (nbits + 8 > len * 8) {
+        return nbits;
+      }
+    }
   }
 
-  nghttp2_bufs_fast_addb_hold(bufs, code);
-  *avail_ptr = nghttp2_bufs_cur_avail(bufs);
-  return (ssize_t)(8 - nbits);
+  _mm256_storeu_si256((__m256i *)(void *)res, sum);
+
+  return (size_t)(res[0] + res[1] + res[2] + res[3]);
 }
 
-size_t nghttp2_hd_huff_encode_count(const uint8_t *src, size_t len) {
-  size_t i;
+#undef HUFF_PRINT_NBITS
+#endif /* NGHTTP2_HAVE_AVX2_DISPATCH */
+
+size_t nghttp2_hd_huff_encode_count_bounded(const uint8_t *src, size_t len) {
+  const uint8_t *p = src;
+  const uint8_t *end = src + len;
   size_t nbits = 0;
+  size_t nbits2 = 0;
+#ifdef NGHTTP2_HAVE_AVX2_DISPATCH
+  int exact;
+
+  /* The vector kernel has fixed cost which is only paid off by long
+     strings. */
+  if (len >= 128 && __builtin_cpu_supports("avx2")) {
+    nbits = huff_encode_count_avx2(src, len, &exact);
 
-  for (i = 0; i < len; ++i) {
-    nbits += huff_sym_table[src[i]].nbits;
+    if (nbits + 8 > len * 8) {
+      return len;
+    }
+
+    if (exact) {
+      return (nbits + 7) / 8;
+    }
+
+    /* Count control characters and bytes >= 0x80 precisely */
+    nbits = 0;
   }
-  /* pad the prefix of EOS (256) */
+#endif /* NGHTTP2_HAVE_AVX2_DISPATCH */
+
+  for (; end - p >= 8; p += 8) {
+    nbits += huff_sym_table[p[0]].nbits + huff_sym_table[p[1]].nbits +
+             huff_sym_table[p[2]].nbits + huff_sym_table[p[3]].nbits;
+    nbits2 += huff_sym_table[p[4]].nbits + huff_sym_table[p[5]].nbits +
+              huff_sym_table[p[6]].nbits + huff_sym_table[p[7]].nbits;
+
+    /* The shortest code is 5 bits long.  If huffman code cannot be
+       shorter than |len| even if all remaining bytes get the
+       shortest code, stop here. */
+    if (nbits + nbits2 + (size_t)(end - p - 8) * 5 + 8 > len * 8) {
+      return len;
+    }
+  }
+
+  for (; p != end; ++p) {
+    nbits += huff_sym_table[*p].nbits;
+  }
+
+  nbits += nbits2;
+
+  if (nbits + 8 > len * 8) {
+    return len;
+  }
+
   return (nbits + 7) / 8;
 }
 
 int nghttp2_hd_huff_encode(nghttp2_bufs *bufs, const uint8_t *src,
                            size_t srclen) {
   int rv;
-  ssize_t rembits = 8;
-  size_t i;
+  const uint8_t *end = src + srclen;
+  /* Encoded bits are accumulated from MSB */
+  uint64_t code = 0;
+  /* The number of bits in |code| */
+  size_t nbits = 0;
   size_t avail;
+  uint32_t x;
 
   avail = nghttp2_bufs_cur_avail(bufs);
 
-  for (i = 0; i < srclen; ++i) {
-    const nghttp2_huff_sym *sym = &huff_sym_table[src[i]];
-    if (rembits == 8) {
-      if (avail) {
-        nghttp2_bufs_fast_addb_hold(bufs, 0);
-      } else {
-        rv = nghttp2_bufs_addb_hold(bufs, 0);
-        if (rv != 0) {
-          return rv;
-        }
-        avail = nghttp2_bufs_cur_avail(bufs);
+  for (; src != end; ++src) {
+    const nghttp2_huff_sym *sym = &huff_sym_table[*src];
+
+    /* We assume that sym->nbits <= 30, so we always have room for
+       it, since nbits < 32 here. */
+    code |= (uint64_t)sym->code << (64 - nbits - sym->nbits);
+    nbits += sym->nbits;
+
+    if (nbits < 32) {
+      continue;
+    }
+
+    if (avail >= 4) {
+      /* Write the filled 32 bits at once */
+      x = htonl((uint32_t)(code >> 32));
+      memcpy(bufs->cur->buf.last, &x, sizeof(x));
+      bufs->cur->buf.last += sizeof(x);
+      avail -= sizeof(x);
+      code <<= 32;
+      nbits -= 32;
+      continue;
+    }
+
+    /* Slow path; current buffer does not have enough space to store
+       the whole word */
+    for (; nbits >= 8; nbits -= 8, code <<= 8) {
+      rv = nghttp2_bufs_addb(bufs, (uint8_t)(code >> 56));
+      if (rv != 0) {
+        return rv;
       }
     }
-    rembits = huff_encode_sym(bufs, &avail, rembits, sym);
-    if (rembits < 0) {
-      return (int)rembits;
+
+    avail = nghttp2_bufs_cur_avail(bufs);
+  }
+
+  for (; nbits >= 8; nbits -= 8, code <<= 8) {
+    rv = nghttp2_bufs_addb(bufs, (uint8_t)(code >> 56));
+    if (rv != 0) {
+      return rv;
     }
   }
-  /* 256 is special terminal symbol, pad with its prefix */
-  if (rembits < 8) {
-    /* if rembits < 8, we should have at least 1 buffer space
-       available */
-    const nghttp2_huff_sym *sym = &huff_sym_table[256];
-    assert(avail);
-    /* Caution we no longer adjust avail here */
-    nghttp2_bufs_fast_orb(bufs, sym->code >> (sym->nbits - rembits));
+
+  if (nbits) {
+    /* 256 is special terminal symbol, pad with its prefix, which is
+       all 1 bits. */
+    rv = nghttp2_bufs_addb(
+        bufs, (uint8_t)((uint8_t)(code >> 56) | ((1 << (8 - nbits)) - 1)));
+    if (rv != 0) {
+      return rv;
+    }
   }
 
   return 0;
@@ -185,6 +324,129 @@ void nghttp2_hd_huff_decode_context_init(nghttp2_hd_huff_decode_context *ctx) {
     }                                                                          \
   } while (0)
 
+/*
+ * Decodes the huffman code longer than NGHTTP2_HUFF_DECODE_FAST_BITS
+ * bits, which is stored from MSB of |bits|.  Since HPACK huffman code
+ * is canonical, we can find the symbol by comparing the prefix of
+ * |bits| against the range of codes of each length.  The length of
+ * the code is stored in |*nbits_ptr|.
+ */
+static uint16_t huff_decode_long(size_t *nbits_ptr, uint64_t bits) {
+  size_t nbits;
+
+  for (nbits = NGHTTP2_HUFF_DECODE_FAST_BITS + 1;; ++nbits) {
+    const nghttp2_huff_decode_long *t = &huff_decode_long_table[nbits];
+    uint32_t code = (uint32_t)(bits >> (64 - nbits));
+
+    if (code - t->first < t->count) {
+      *nbits_ptr = nbits;
+      return huff_decode_long_sym_table[t->offset + code - t->first];
+    }
+  }
+}
+
+/*
+ * Decodes whole huffman encoded string |src| of length |srclen|,
+ * looking up NGHTTP2_HUFF_DECODE_FAST_BITS bits at once.  The
+ * decoding must start at the code boundary.  This function returns
+ * the same values as nghttp2_hd_huff_decode().
+ */
+static ssize_t huff_decode_fast(nghttp2_bufs *bufs, const uint8_t *src,
+                                size_t srclen) {
+  const uint8_t *end = src + srclen;
+  /* The bits to decode are stored from MSB */
+  uint64_t bits = 0;
+  /* The number of valid bits in |bits| */
+  size_t nbits = 0;
+  int rv;
+  size_t avail;
+
+  avail = nghttp2_bufs_cur_avail(bufs);
+
+  for (;;) {
+    const nghttp2_huff_decode_fast *t;
+    uint64_t look;
+
+    for (; nbits <= 56 && src != end; nbits += 8) {
+      bits |= (uint64_t)*src++ << (56 - nbits);
+    }
+
+    if (nbits == 0) {
+      break;
+    }
+
+    look = bits;
+    if (src == end && nbits < 64) {
+      /* Fill the rest with 1 bits, which is the prefix of EOS.  No
+         symbol other than EOS is decoded from them. */
+      look |= UINT64_MAX >> nbits;
+    }
+
+    t = &huff_decode_fast_table[look >> (64 - NGHTTP2_HUFF_DECODE_FAST_BITS)];
+
+    if (t->nbits == 0) {
+      size_t symlen;
+      uint16_t sym;
+
+      sym = huff_decode_long(&symlen, look);
+      if (symlen > nbits) {
+        /* Remaining bits are the padding, or truncated code */
+        break;
+      }
+      if (sym == 256) {
+        /* EOS must not be decoded */
+        return NGHTTP2_ERR_HEADER_COMP;
+      }
+
+      /* this is macro, and may return from this function on error */
+      hd_huff_decode_sym_emit(bufs, (uint8_t)sym, avail);
+
+      bits <<= symlen;
+      nbits -= symlen;
+
+      continue;
+    }
+
+    if (t->nbits <= nbits) {
+      if (t->nbits > t->nbits1 && avail >= 2) {
+        nghttp2_bufs_fast_addb(bufs, t->sym1);
+        nghttp2_bufs_fast_addb(bufs, t->sym2);
+        avail -= 2;
+      } else {
+        hd_huff_decode_sym_emit(bufs, t->sym1, avail);
+        if (t->nbits > t->nbits1) {
+          hd_huff_decode_sym_emit(bufs, t->sym2, avail);
+        }
+      }
+
+      bits <<= t->nbits;
+      nbits -= t->nbits;
+
+      continue;
+    }
+
+    /* We are at the end of input, and the second symbol, if any, is
+       made up of the padding. */
+    if (t->nbits1 <= nbits) {
+      hd_huff_decode_sym_emit(bufs, t->sym1, avail);
+
+      bits <<= t->nbits1;
+      nbits -= t->nbits1;
+    }
+
+    break;
+  }
+
+  /* The padding must be strictly less than 8 bits, and filled with
+     the most significant bits of EOS, which are all 1. */
+  if (nbits > 7 ||
+      (nbits > 0 && (bits >> (64 - nbits)) != (1u << nbits) - 1)) {
+    return NGHTTP2_ERR_HEADER_COMP;
+  }
+
+  return (ssize_t)srclen;
+}
+
 ssize_t nghttp2_hd_huff_decode(nghttp2_hd_huff_decode_context *ctx,
                                nghttp2_bufs *bufs, const uint8_t *src,
                                size_t srclen, int final) {
@@ -192,6 +454,15 @@ ssize_t nghttp2_hd_huff_decode(nghttp2_hd_huff_decode_context *ctx,
   int rv;
   size_t avail;
 
+  if (final && ctx->state == 0) {
+    /* We are at the code boundary, and have the rest of the string.
+       Use the faster decoder which processes multiple bits at
+       once. */
+    return huff_decode_fast(bufs, src, srclen);
+  }
+
+  /* Otherwise decode it incrementally, 4 bits at a time */
+
   avail = nghttp2_bufs_cur_avail(bufs);
 
   /* We use the decoding algorithm described in
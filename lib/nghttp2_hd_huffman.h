@@ -55,6 +55,33 @@ typedef struct {
 
 typedef nghttp2_huff_decode huff_decode_table_type[16];
 
+/* The number of bits the fast huffman decoder looks up at once.  It
+   must be the same value of HUFF_DECODE_FAST_BITS in mkhufftbl.py. */
+#define NGHTTP2_HUFF_DECODE_FAST_BITS 12
+
+typedef struct {
+  /* The number of bits consumed by all symbols in this entry.  If
+     this is 0, the code starting at this entry is longer than
+     NGHTTP2_HUFF_DECODE_FAST_BITS. */
+  uint8_t nbits;
+  /* The number of bits consumed by the first symbol */
+  uint8_t nbits1;
+  /* The first symbol */
+  uint8_t sym1;
+  /* The second symbol.  It is only valid if nbits > nbits1. */
+  uint8_t sym2;
+} nghttp2_huff_decode_fast;
+
+typedef struct {
+  /* The first huffman code of this length, aligned to LSB */
+  uint32_t first;
+  /* The number of huffman codes of this length */
+  uint16_t count;
+  /* The offset of the symbol for the first code in
+     huff_decode_long_sym_table */
+  uint16_t offset;
+} nghttp2_huff_decode_long;
+
 typedef struct {
   /* Current huffman decoding state. We stripped leaf nodes, so the
      value range is [0..255], inclusive. */
@@ -5150,3 +5150,4161 @@ const nghttp2_huff_decode huff_decode_table[][16] = {
      {0, 0x04, 0},
     },
 };
+
+const nghttp2_huff_decode_fast huff_decode_fast_table[] = {
+    {10, 5, 48, 48},
+    {10, 5, 48, 48},
+    {10, 5, 48, 48},
+    {10, 5, 48, 48},
+    {10, 5, 48, 49},
+    {10, 5, 48, 49},
+    {10, 5, 48, 49},
+    {10, 5, 48, 49},
+    {10, 5, 48, 50},
+    {10, 5, 48, 50},
+    {10, 5, 48, 50},
+    {10, 5, 48, 50},
+    {10, 5, 48, 97},
+    {10, 5, 48, 97},
+    {10, 5, 48, 97},
+    {10, 5, 48, 97},
+    {10, 5, 48, 99},
+    {10, 5, 48, 99},
+    {10, 5, 48, 99},
+    {10, 5, 48, 99},
+    {10, 5, 48, 101},
+    {10, 5, 48, 101},
+    {10, 5, 48, 101},
+    {10, 5, 48, 101},
+    {10, 5, 48, 105},
+    {10, 5, 48, 105},
+    {10, 5, 48, 105},
+    {10, 5, 48, 105},
+    {10, 5, 48, 111},
+    {10, 5, 48, 111},
+    {10, 5, 48, 111},
+    {10, 5, 48, 111},
+    {10, 5, 48, 115},
+    {10, 5, 48, 115},
+    {10, 5, 48, 115},
+    {10, 5, 48, 115},
+    {10, 5, 48, 116},
+    {10, 5, 48, 116},
+    {10, 5, 48, 116},
+    {10, 5, 48, 116},
+    {11, 5, 48, 32},
+    {11, 5, 48, 32},
+    {11, 5, 48, 37},
+    {11, 5, 48, 37},
+    {11, 5, 48, 45},
+    {11, 5, 48, 45},
+    {11, 5, 48, 46},
+    {11, 5, 48, 46},
+    {11, 5, 48, 47},
+    {11, 5, 48, 47},
+    {11, 5, 48, 51},
+    {11, 5, 48, 51},
+    {11, 5, 48, 52},
+    {11, 5, 48, 52},
+    {11, 5, 48, 53},
+    {11, 5, 48, 53},
+    {11, 5, 48, 54},
+    {11, 5, 48, 54},
+    {11, 5, 48, 55},
+    {11, 5, 48, 55},
+    {11, 5, 48, 56},
+    {11, 5, 48, 56},
+    {11, 5, 48, 57},
+    {11, 5, 48, 57},
+    {11, 5, 48, 61},
+    {11, 5, 48, 61},
+    {11, 5, 48, 65},
+    {11, 5, 48, 65},
+    {11, 5, 48, 95},
+    {11, 5, 48, 95},
+    {11, 5, 48, 98},
+    {11, 5, 48, 98},
+    {11, 5, 48, 100},
+    {11, 5, 48, 100},
+    {11, 5, 48, 102},
+    {11, 5, 48, 102},
+    {11, 5, 48, 103},
+    {11, 5, 48, 103},
+    {11, 5, 48, 104},
+    {11, 5, 48, 104},
+    {11, 5, 48, 108},
+    {11, 5, 48, 108},
+    {11, 5, 48, 109},
+    {11, 5, 48, 109},
+    {11, 5, 48, 110},
+    {11, 5, 48, 110},
+    {11, 5, 48, 112},
+    {11, 5, 48, 112},
+    {11, 5, 48, 114},
+    {11, 5, 48, 114},
+    {11, 5, 48, 117},
+    {11, 5, 48, 117},
+    {12, 5, 48, 58},
+    {12, 5, 48, 66},
+    {12, 5, 48, 67},
+    {12, 5, 48, 68},
+    {12, 5, 48, 69},
+    {12, 5, 48, 70},
+    {12, 5, 48, 71},
+    {12, 5, 48, 72},
+    {12, 5, 48, 73},
+    {12, 5, 48, 74},
+    {12, 5, 48, 75},
+    {12, 5, 48, 76},
+    {12, 5, 48, 77},
+    {12, 5, 48, 78},
+    {12, 5, 48, 79},
+    {12, 5, 48, 80},
+    {12, 5, 48, 81},
+    {12, 5, 48, 82},
+    {12, 5, 48, 83},
+    {12, 5, 48, 84},
+    {12, 5, 48, 85},
+    {12, 5, 48, 86},
+    {12, 5, 48, 87},
+    {12, 5, 48, 89},
+    {12, 5, 48, 106},
+    {12, 5, 48, 107},
+    {12, 5, 48, 113},
+    {12, 5, 48, 118},
+    {12, 5, 48, 119},
+    {12, 5, 48, 120},
+    {12, 5, 48, 121},
+    {12, 5, 48, 122},
+    {5, 5, 48, 0},
+    {5, 5, 48, 0},
+    {5, 5, 48, 0},
+    {5, 5, 48, 0},
+    {10, 5, 49, 48},
+    {10, 5, 49, 48},
+    {10, 5, 49, 48},
+    {10, 5, 49, 48},
+    {10, 5, 49, 49},
+    {10, 5, 49, 49},
+    {10, 5, 49, 49},
+    {10, 5, 49, 49},
+    {10, 5, 49, 50},
+    {10, 5, 49, 50},
+    {10, 5, 49, 50},
+    {10, 5, 49, 50},
+    {10, 5, 49, 97},
+    {10, 5, 49, 97},
+    {10, 5, 49, 97},
+    {10, 5, 49, 97},
+    {10, 5, 49, 99},
+    {10, 5, 49, 99},
+    {10, 5, 49, 99},
+    {10, 5, 49, 99},
+    {10, 5, 49, 101},
+    {10, 5, 49, 101},
+    {10, 5, 49, 101},
+    {10, 5, 49, 101},
+    {10, 5, 49, 105},
+    {10, 5, 49, 105},
+    {10, 5, 49, 105},
+    {10, 5, 49, 105},
+    {10, 5, 49, 111},
+    {10, 5, 49, 111},
+    {10, 5, 49, 111},
+    {10, 5, 49, 111},
+    {10, 5, 49, 115},
+    {10, 5, 49, 115},
+    {10, 5, 49, 115},
+    {10, 5, 49, 115},
+    {10, 5, 49, 116},
+    {10, 5, 49, 116},
+    {10, 5, 49, 116},
+    {10, 5, 49, 116},
+    {11, 5, 49, 32},
+    {11, 5, 49, 32},
+    {11, 5, 49, 37},
+    {11, 5, 49, 37},
+    {11, 5, 49, 45},
+    {11, 5, 49, 45},
+    {11, 5, 49, 46},
+    {11, 5, 49, 46},
+    {11, 5, 49, 47},
+    {11, 5, 49, 47},
+    {11, 5, 49, 51},
+    {11, 5, 49, 51},
+    {11, 5, 49, 52},
+    {11, 5, 49, 52},
+    {11, 5, 49, 53},
+    {11, 5, 49, 53},
+    {11, 5, 49, 54},
+    {11, 5, 49, 54},
+    {11, 5, 49, 55},
+    {11, 5, 49, 55},
+    {11, 5, 49, 56},
+    {11, 5, 49, 56},
+    {11, 5, 49, 57},
+    {11, 5, 49, 57},
+    {11, 5, 49, 61},
+    {11, 5, 49, 61},
+    {11, 5, 49, 65},
+    {11, 5, 49, 65},
+    {11, 5, 49, 95},
+    {11, 5, 49, 95},
+    {11, 5, 49, 98},
+    {11, 5, 49, 98},
+    {11, 5, 49, 100},
+    {11, 5, 49, 100},
+    {11, 5, 49, 102},
+    {11, 5, 49, 102},
+    {11, 5, 49, 103},
+    {11, 5, 49, 103},
+    {11, 5, 49, 104},
+    {11, 5, 49, 104},
+    {11, 5, 49, 108},
+    {11, 5, 49, 108},
+    {11, 5, 49, 109},
+    {11, 5, 49, 109},
+    {11, 5, 49, 110},
+    {11, 5, 49, 110},
+    {11, 5, 49, 112},
+    {11, 5, 49, 112},
+    {11, 5, 49, 114},
+    {11, 5, 49, 114},
+    {11, 5, 49, 117},
+    {11, 5, 49, 117},
+    {12, 5, 49, 58},
+    {12, 5, 49, 66},
+    {12, 5, 49, 67},
+    {12, 5, 49, 68},
+    {12, 5, 49, 69},
+    {12, 5, 49, 70},
+    {12, 5, 49, 71},
+    {12, 5, 49, 72},
+    {12, 5, 49, 73},
+    {12, 5, 49, 74},
+    {12, 5, 49, 75},
+    {12, 5, 49, 76},
+    {12, 5, 49, 77},
+    {12, 5, 49, 78},
+    {12, 5, 49, 79},
+    {12, 5, 49, 80},
+    {12, 5, 49, 81},
+    {12, 5, 49, 82},
+    {12, 5, 49, 83},
+    {12, 5, 49, 84},
+    {12, 5, 49, 85},
+    {12, 5, 49, 86},
+    {12, 5, 49, 87},
+    {12, 5, 49, 89},
+    {12, 5, 49, 106},
+    {12, 5, 49, 107},
+    {12, 5, 49, 113},
+    {12, 5, 49, 118},
+    {12, 5, 49, 119},
+    {12, 5, 49, 120},
+    {12, 5, 49, 121},
+    {12, 5, 49, 122},
+    {5, 5, 49, 0},
+    {5, 5, 49, 0},
+    {5, 5, 49, 0},
+    {5, 5, 49, 0},
+    {10, 5, 50, 48},
+    {10, 5, 50, 48},
+    {10, 5, 50, 48},
+    {10, 5, 50, 48},
+    {10, 5, 50, 49},
+    {10, 5, 50, 49},
+    {10, 5, 50, 49},
+    {10, 5, 50, 49},
+    {10, 5, 50, 50},
+    {10, 5, 50, 50},
+    {10, 5, 50, 50},
+    {10, 5, 50, 50},
+    {10, 5, 50, 97},
+    {10, 5, 50, 97},
+    {10, 5, 50, 97},
+    {10, 5, 50, 97},
+    {10, 5, 50, 99},
+    {10, 5, 50, 99},
+    {10, 5, 50, 99},
+    {10, 5, 50, 99},
+    {10, 5, 50, 101},
+    {10, 5, 50, 101},
+    {10, 5, 50, 101},
+    {10, 5, 50, 101},
+    {10, 5, 50, 105},
+    {10, 5, 50, 105},
+    {10, 5, 50, 105},
+    {10, 5, 50, 105},
+    {10, 5, 50, 111},
+    {10, 5, 50, 111},
+    {10, 5, 50, 111},
+    {10, 5, 50, 111},
+    {10, 5, 50, 115},
+    {10, 5, 50, 115},
+    {10, 5, 50, 115},
+    {10, 5, 50, 115},
+    {10, 5, 50, 116},
+    {10, 5, 50, 116},
+    {10, 5, 50, 116},
+    {10, 5, 50, 116},
+    {11, 5, 50, 32},
+    {11, 5, 50, 32},
+    {11, 5, 50, 37},
+    {11, 5, 50, 37},
+    {11, 5, 50, 45},
+    {11, 5, 50, 45},
+    {11, 5, 50, 46},
+    {11, 5, 50, 46},
+    {11, 5, 50, 47},
+    {11, 5, 50, 47},
+    {11, 5, 50, 51},
+    {11, 5, 50, 51},
+    {11, 5, 50, 52},
+    {11, 5, 50, 52},
+    {11, 5, 50, 53},
+    {11, 5, 50, 53},
+    {11, 5, 50, 54},
+    {11, 5, 50, 54},
+    {11, 5, 50, 55},
+    {11, 5, 50, 55},
+    {11, 5, 50, 56},
+    {11, 5, 50, 56},
+    {11, 5, 50, 57},
+    {11, 5, 50, 57},
+    {11, 5, 50, 61},
+    {11, 5, 50, 61},
+    {11, 5, 50, 65},
+    {11, 5, 50, 65},
+    {11, 5, 50, 95},
+    {11, 5, 50, 95},
+    {11, 5, 50, 98},
+    {11, 5, 50, 98},
+    {11, 5, 50, 100},
+    {11, 5, 50, 100},
+    {11, 5, 50, 102},
+    {11, 5, 50, 102},
+    {11, 5, 50, 103},
+    {11, 5, 50, 103},
+    {11, 5, 50, 104},
+    {11, 5, 50, 104},
+    {11, 5, 50, 108},
+    {11, 5, 50, 108},
+    {11, 5, 50, 109},
+    {11, 5, 50, 109},
+    {11, 5, 50, 110},
+    {11, 5, 50, 110},
+    {11, 5, 50, 112},
+    {11, 5, 50, 112},
+    {11, 5, 50, 114},
+    {11, 5, 50, 114},
+    {11, 5, 50, 117},
+    {11, 5, 50, 117},
+    {12, 5, 50, 58},
+    {12, 5, 50, 66},
+    {12, 5, 50, 67},
+    {12, 5, 50, 68},
+    {12, 5, 50, 69},
+    {12, 5, 50, 70},
+    {12, 5, 50, 71},
+    {12, 5, 50, 72},
+    {12, 5, 50, 73},
+    {12, 5, 50, 74},
+    {12, 5, 50, 75},
+    {12, 5, 50, 76},
+    {12, 5, 50, 77},
+    {12, 5, 50, 78},
+    {12, 5, 50, 79},
+    {12, 5, 50, 80},
+    {12, 5, 50, 81},
+    {12, 5, 50, 82},
+    {12, 5, 50, 83},
+    {12, 5, 50, 84},
+    {12, 5, 50, 85},
+    {12, 5, 50, 86},
+    {12, 5, 50, 87},
+    {12, 5, 50, 89},
+    {12, 5, 50, 106},
+    {12, 5, 50, 107},
+    {12, 5, 50, 113},
+    {12, 5, 50, 118},
+    {12, 5, 50, 119},
+    {12, 5, 50, 120},
+    {12, 5, 50, 121},
+    {12, 5, 50, 122},
+    {5, 5, 50, 0},
+    {5, 5, 50, 0},
+    {5, 5, 50, 0},
+    {5, 5, 50, 0},
+    {10, 5, 97, 48},
+    {10, 5, 97, 48},
+    {10, 5, 97, 48},
+    {10, 5, 97, 48},
+    {10, 5, 97, 49},
+    {10, 5, 97, 49},
+    {10, 5, 97, 49},
+    {10, 5, 97, 49},
+    {10, 5, 97, 50},
+    {10, 5, 97, 50},
+    {10, 5, 97, 50},
+    {10, 5, 97, 50},
+    {10, 5, 97, 97},
+    {10, 5, 97, 97},
+    {10, 5, 97, 97},
+    {10, 5, 97, 97},
+    {10, 5, 97, 99},
+    {10, 5, 97, 99},
+    {10, 5, 97, 99},
+    {10, 5, 97, 99},
+    {10, 5, 97, 101},
+    {10, 5, 97, 101},
+    {10, 5, 97, 101},
+    {10, 5, 97, 101},
+    {10, 5, 97, 105},
+    {10, 5, 97, 105},
+    {10, 5, 97, 105},
+    {10, 5, 97, 105},
+    {10, 5, 97, 111},
+    {10, 5, 97, 111},
+    {10, 5, 97, 111},
+    {10, 5, 97, 111},
+    {10, 5, 97, 115},
+    {10, 5, 97, 115},
+    {10, 5, 97, 115},
+    {10, 5, 97, 115},
+    {10, 5, 97, 116},
+    {10, 5, 97, 116},
+    {10, 5, 97, 116},
+    {10, 5, 97, 116},
+    {11, 5, 97, 32},
+    {11, 5, 97, 32},
+    {11, 5, 97, 37},
+    {11, 5, 97, 37},
+    {11, 5, 97, 45},
+    {11, 5, 97, 45},
+    {11, 5, 97, 46},
+    {11, 5, 97, 46},
+    {11, 5, 97, 47},
+    {11, 5, 97, 47},
+    {11, 5, 97, 51},
+    {11, 5, 97, 51},
+    {11, 5, 97, 52},
+    {11, 5, 97, 52},
+    {11, 5, 97, 53},
+    {11, 5, 97, 53},
+    {11, 5, 97, 54},
+    {11, 5, 97, 54},
+    {11, 5, 97, 55},
+    {11, 5, 97, 55},
+    {11, 5, 97, 56},
+    {11, 5, 97, 56},
+    {11, 5, 97, 57},
+    {11, 5, 97, 57},
+    {11, 5, 97, 61},
+    {11, 5, 97, 61},
+    {11, 5, 97, 65},
+    {11, 5, 97, 65},
+    {11, 5, 97, 95},
+    {11, 5, 97, 95},
+    {11, 5, 97, 98},
+    {11, 5, 97, 98},
+    {11, 5, 97, 100},
+    {11, 5, 97, 100},
+    {11, 5, 97, 102},
+    {11, 5, 97, 102},
+    {11, 5, 97, 103},
+    {11, 5, 97, 103},
+    {11, 5, 97, 104},
+    {11, 5, 97, 104},
+    {11, 5, 97, 108},
+    {11, 5, 97, 108},
+    {11, 5, 97, 109},
+    {11, 5, 97, 109},
+    {11, 5, 97, 110},
+    {11, 5, 97, 110},
+    {11, 5, 97, 112},
+    {11, 5, 97, 112},
+    {11, 5, 97, 114},
+    {11, 5, 97, 114},
+    {11, 5, 97, 117},
+    {11, 5, 97, 117},
+    {12, 5, 97, 58},
+    {12, 5, 97, 66},
+    {12, 5, 97, 67},
+    {12, 5, 97, 68},
+    {12, 5, 97, 69},
+    {12, 5, 97, 70},
+    {12, 5, 97, 71},
+    {12, 5, 97, 72},
+    {12, 5, 97, 73},
+    {12, 5, 97, 74},
+    {12, 5, 97, 75},
+    {12, 5, 97, 76},
+    {12, 5, 97, 77},
+    {12, 5, 97, 78},
+    {12, 5, 97, 79},
+    {12, 5, 97, 80},
+    {12, 5, 97, 81},
+    {12, 5, 97, 82},
+    {12, 5, 97, 83},
+    {12, 5, 97, 84},
+    {12, 5, 97, 85},
+    {12, 5, 97, 86},
+    {12, 5, 97, 87},
+    {12, 5, 97, 89},
+    {12, 5, 97, 106},
+    {12, 5, 97, 107},
+    {12, 5, 97, 113},
+    {12, 5, 97, 118},
+    {12, 5, 97, 119},
+    {12, 5, 97, 120},
+    {12, 5, 97, 121},
+    {12, 5, 97, 122},
+    {5, 5, 97, 0},
+    {5, 5, 97, 0},
+    {5, 5, 97, 0},
+    {5, 5, 97, 0},
+    {10, 5, 99, 48},
+    {10, 5, 99, 48},
+    {10, 5, 99, 48},
+    {10, 5, 99, 48},
+    {10, 5, 99, 49},
+    {10, 5, 99, 49},
+    {10, 5, 99, 49},
+    {10, 5, 99, 49},
+    {10, 5, 99, 50},
+    {10, 5, 99, 50},
+    {10, 5, 99, 50},
+    {10, 5, 99, 50},
+    {10, 5, 99, 97},
+    {10, 5, 99, 97},
+    {10, 5, 99, 97},
+    {10, 5, 99, 97},
+    {10, 5, 99, 99},
+    {10, 5, 99, 99},
+    {10, 5, 99, 99},
+    {10, 5, 99, 99},
+    {10, 5, 99, 101},
+    {10, 5, 99, 101},
+    {10, 5, 99, 101},
+    {10, 5, 99, 101},
+    {10, 5, 99, 105},
+    {10, 5, 99, 105},
+    {10, 5, 99, 105},
+    {10, 5, 99, 105},
+    {10, 5, 99, 111},
+    {10, 5, 99, 111},
+    {10, 5, 99, 111},
+    {10, 5, 99, 111},
+    {10, 5, 99, 115},
+    {10, 5, 99, 115},
+    {10, 5, 99, 115},
+    {10, 5, 99, 115},
+    {10, 5, 99, 116},
+    {10, 5, 99, 116},
+    {10, 5, 99, 116},
+    {10, 5, 99, 116},
+    {11, 5, 99, 32},
+    {11, 5, 99, 32},
+    {11, 5, 99, 37},
+    {11, 5, 99, 37},
+    {11, 5, 99, 45},
+    {11, 5, 99, 45},
+    {11, 5, 99, 46},
+    {11, 5, 99, 46},
+    {11, 5, 99, 47},
+    {11, 5, 99, 47},
+    {11, 5, 99, 51},
+    {11, 5, 99, 51},
+    {11, 5, 99, 52},
+    {11, 5, 99, 52},
+    {11, 5, 99, 53},
+    {11, 5, 99, 53},
+    {11, 5, 99, 54},
+    {11, 5, 99, 54},
+    {11, 5, 99, 55},
+    {11, 5, 99, 55},
+    {11, 5, 99, 56},
+    {11, 5, 99, 56},
+    {11, 5, 99, 57},
+    {11, 5, 99, 57},
+    {11, 5, 99, 61},
+    {11, 5, 99, 61},
+    {11, 5, 99, 65},
+    {11, 5, 99, 65},
+    {11, 5, 99, 95},
+    {11, 5, 99, 95},
+    {11, 5, 99, 98},
+    {11, 5, 99, 98},
+    {11, 5, 99, 100},
+    {11, 5, 99, 100},
+    {11, 5, 99, 102},
+    {11, 5, 99, 102},
+    {11, 5, 99, 103},
+    {11, 5, 99, 103},
+    {11, 5, 99, 104},
+    {11, 5, 99, 104},
+    {11, 5, 99, 108},
+    {11, 5, 99, 108},
+    {11, 5, 99, 109},
+    {11, 5, 99, 109},
+    {11, 5, 99, 110},
+    {11, 5, 99, 110},
+    {11, 5, 99, 112},
+    {11, 5, 99, 112},
+    {11, 5, 99, 114},
+    {11, 5, 99, 114},
+    {11, 5, 99, 117},
+    {11, 5, 99, 117},
+    {12, 5, 99, 58},
+    {12, 5, 99, 66},
+    {12, 5, 99, 67},
+    {12, 5, 99, 68},
+    {12, 5, 99, 69},
+    {12, 5, 99, 70},
+    {12, 5, 99, 71},
+    {12, 5, 99, 72},
+    {12, 5, 99, 73},
+    {12, 5, 99, 74},
+    {12, 5, 99, 75},
+    {12, 5, 99, 76},
+    {12, 5, 99, 77},
+    {12, 5, 99, 78},
+    {12, 5, 99, 79},
+    {12, 5, 99, 80},
+    {12, 5, 99, 81},
+    {12, 5, 99, 82},
+    {12, 5, 99, 83},
+    {12, 5, 99, 84},
+    {12, 5, 99, 85},
+    {12, 5, 99, 86},
+    {12, 5, 99, 87},
+    {12, 5, 99, 89},
+    {12, 5, 99, 106},
+    {12, 5, 99, 107},
+    {12, 5, 99, 113},
+    {12, 5, 99, 118},
+    {12, 5, 99, 119},
+    {12, 5, 99, 120},
+    {12, 5, 99, 121},
+    {12, 5, 99, 122},
+    {5, 5, 99, 0},
+    {5, 5, 99, 0},
+    {5, 5, 99, 0},
+    {5, 5, 99, 0},
+    {10, 5, 101, 48},
+    {10, 5, 101, 48},
+    {10, 5, 101, 48},
+    {10, 5, 101, 48},
+    {10, 5, 101, 49},
+    {10, 5, 101, 49},
+    {10, 5, 101, 49},
+    {10, 5, 101, 49},
+    {10, 5, 101, 50},
+    {10, 5, 101, 50},
+    {10, 5, 101, 50},
+    {10, 5, 101, 50},
+    {10, 5, 101, 97},
+    {10, 5, 101, 97},
+    {10, 5, 101, 97},
+    {10, 5, 101, 97},
+    {10, 5, 101, 99},
+    {10, 5, 101, 99},
+    {10, 5, 101, 99},
+    {10, 5, 101, 99},
+    {10, 5, 101, 101},
+    {10, 5, 101, 101},
+    {10, 5, 101, 101},
+    {10, 5, 101, 101},
+    {10, 5, 101, 105},
+    {10, 5, 101, 105},
+    {10, 5, 101, 105},
+    {10, 5, 101, 105},
+    {10, 5, 101, 111},
+    {10, 5, 101, 111},
+    {10, 5, 101, 111},
+    {10, 5, 101, 111},
+    {10, 5, 101, 115},
+    {10, 5, 101, 115},
+    {10, 5, 101, 115},
+    {10, 5, 101, 115},
+    {10, 5, 101, 116},
+    {10, 5, 101, 116},
+    {10, 5, 101, 116},
+    {10, 5, 101, 116},
+    {11, 5, 101, 32},
+    {11, 5, 101, 32},
+    {11, 5, 101, 37},
+    {11, 5, 101, 37},
+    {11, 5, 101, 45},
+    {11, 5, 101, 45},
+    {11, 5, 101, 46},
+    {11, 5, 101, 46},
+    {11, 5, 101, 47},
+    {11, 5, 101, 47},
+    {11, 5, 101, 51},
+    {11, 5, 101, 51},
+    {11, 5, 101, 52},
+    {11, 5, 101, 52},
+    {11, 5, 101, 53},
+    {11, 5, 101, 53},
+    {11, 5, 101, 54},
+    {11, 5, 101, 54},
+    {11, 5, 101, 55},
+    {11, 5, 101, 55},
+    {11, 5, 101, 56},
+    {11, 5, 101, 56},
+    {11, 5, 101, 57},
+    {11, 5, 101, 57},
+    {11, 5, 101, 61},
+    {11, 5, 101, 61},
+    {11, 5, 101, 65},
+    {11, 5, 101, 65},
+    {11, 5, 101, 95},
+    {11, 5, 101, 95},
+    {11, 5, 101, 98},
+    {11, 5, 101, 98},
+    {11, 5, 101, 100},
+    {11, 5, 101, 100},
+    {11, 5, 101, 102},
+    {11, 5, 101, 102},
+    {11, 5, 101, 103},
+    {11, 5, 101, 103},
+    {11, 5, 101, 104},
+    {11, 5, 101, 104},
+    {11, 5, 101, 108},
+    {11, 5, 101, 108},
+    {11, 5, 101, 109},
+    {11, 5, 101, 109},
+    {11, 5, 101, 110},
+    {11, 5, 101, 110},
+    {11, 5, 101, 112},
+    {11, 5, 101, 112},
+    {11, 5, 101, 114},
+    {11, 5, 101, 114},
+    {11, 5, 101, 117},
+    {11, 5, 101, 117},
+    {12, 5, 101, 58},
+    {12, 5, 101, 66},
+    {12, 5, 101, 67},
+    {12, 5, 101, 68},
+    {12, 5, 101, 69},
+    {12, 5, 101, 70},
+    {12, 5, 101, 71},
+    {12, 5, 101, 72},
+    {12, 5, 101, 73},
+    {12, 5, 101, 74},
+    {12, 5, 101, 75},
+    {12, 5, 101, 76},
+    {12, 5, 101, 77},
+    {12, 5, 101, 78},
+    {12, 5, 101, 79},
+    {12, 5, 101, 80},
+    {12, 5, 101, 81},
+    {12, 5, 101, 82},
+    {12, 5, 101, 83},
+    {12, 5, 101, 84},
+    {12, 5, 101, 85},
+    {12, 5, 101, 86},
+    {12, 5, 101, 87},
+    {12, 5, 101, 89},
+    {12, 5, 101, 106},
+    {12, 5, 101, 107},
+    {12, 5, 101, 113},
+    {12, 5, 101, 118},
+    {12, 5, 101, 119},
+    {12, 5, 101, 120},
+    {12, 5, 101, 121},
+    {12, 5, 101, 122},
+    {5, 5, 101, 0},
+    {5, 5, 101, 0},
+    {5, 5, 101, 0},
+    {5, 5, 101, 0},
+    {10, 5, 105, 48},
+    {10, 5, 105, 48},
+    {10, 5, 105, 48},
+    {10, 5, 105, 48},
+    {10, 5, 105, 49},
+    {10, 5, 105, 49},
+    {10, 5, 105, 49},
+    {10, 5, 105, 49},
+    {10, 5, 105, 50},
+    {10, 5, 105, 50},
+    {10, 5, 105, 50},
+    {10, 5, 105, 50},
+    {10, 5, 105, 97},
+    {10, 5, 105, 97},
+    {10, 5, 105, 97},
+    {10, 5, 105, 97},
+    {10, 5, 105, 99},
+    {10, 5, 105, 99},
+    {10, 5, 105, 99},
+    {10, 5, 105, 99},
+    {10, 5, 105, 101},
+    {10, 5, 105, 101},
+    {10, 5, 105, 101},
+    {10, 5, 105, 101},
+    {10, 5, 105, 105},
+    {10, 5, 105, 105},
+    {10, 5, 105, 105},
+    {10, 5, 105, 105},
+    {10, 5, 105, 111},
+    {10, 5, 105, 111},
+    {10, 5, 105, 111},
+    {10, 5, 105, 111},
+    {10, 5, 105, 115},
+    {10, 5, 105, 115},
+    {10, 5, 105, 115},
+    {10, 5, 105, 115},
+    {10, 5, 105, 116},
+    {10, 5, 105, 116},
+    {10, 5, 105, 116},
+    {10, 5, 105, 116},
+    {11, 5, 105, 32},
+    {11, 5, 105, 32},
+    {11, 5, 105, 37},
+    {11, 5, 105, 37},
+    {11, 5, 105, 45},
+    {11, 5, 105, 45},
+    {11, 5, 105, 46},
+    {11, 5, 105, 46},
+    {11, 5, 105, 47},
+    {11, 5, 105, 47},
+    {11, 5, 105, 51},
+    {11, 5, 105, 51},
+    {11, 5, 105, 52},
+    {11, 5, 105, 52},
+    {11, 5, 105, 53},
+    {11, 5, 105, 53},
+    {11, 5, 105, 54},
+    {11, 5, 105, 54},
+    {11, 5, 105, 55},
+    {11, 5, 105, 55},
+    {11, 5, 105, 56},
+    {11, 5, 105, 56},
+    {11, 5, 105, 57},
+    {11, 5, 105, 57},
+    {11, 5, 105, 61},
+    {11, 5, 105, 61},
+    {11, 5, 105, 65},
+    {11, 5, 105, 65},
+    {11, 5, 105, 95},
+    {11, 5, 105, 95},
+    {11, 5, 105, 98},
+    {11, 5, 105, 98},
+    {11, 5, 105, 100},
+    {11, 5, 105, 100},
+    {11, 5, 105, 102},
+    {11, 5, 105, 102},
+    {11, 5, 105, 103},
+    {11, 5, 105, 103},
+    {11, 5, 105, 104},
+    {11, 5, 105, 104},
+    {11, 5, 105, 108},
+    {11, 5, 105, 108},
+    {11, 5, 105, 109},
+    {11, 5, 105, 109},
+    {11, 5, 105, 110},
+    {11, 5, 105, 110},
+    {11, 5, 105, 112},
+    {11, 5, 105, 112},
+    {11, 5, 105, 114},
+    {11, 5, 105, 114},
+    {11, 5, 105, 117},
+    {11, 5, 105, 117},
+    {12, 5, 105, 58},
+    {12, 5, 105, 66},
+    {12, 5, 105, 67},
+    {12, 5, 105, 68},
+    {12, 5, 105, 69},
+    {12, 5, 105, 70},
+    {12, 5, 105, 71},
+    {12, 5, 105, 72},
+    {12, 5, 105, 73},
+    {12, 5, 105, 74},
+    {12, 5, 105, 75},
+    {12, 5, 105, 76},
+    {12, 5, 105, 77},
+    {12, 5, 105, 78},
+    {12, 5, 105, 79},
+    {12, 5, 105, 80},
+    {12, 5, 105, 81},
+    {12, 5, 105, 82},
+    {12, 5, 105, 83},
+    {12, 5, 105, 84},
+    {12, 5, 105, 85},
+    {12, 5, 105, 86},
+    {12, 5, 105, 87},
+    {12, 5, 105, 89},
+    {12, 5, 105, 106},
+    {12, 5, 105, 107},
+    {12, 5, 105, 113},
+    {12, 5, 105, 118},
+    {12, 5, 105, 119},
+    {12, 5, 105, 120},
+    {12, 5, 105, 121},
+    {12, 5, 105, 122},
+    {5, 5, 105, 0},
+    {5, 5, 105, 0},
+    {5, 5, 105, 0},
+    {5, 5, 105, 0},
+    {10, 5, 111, 48},
+    {10, 5, 111, 48},
+    {10, 5, 111, 48},
+    {10, 5, 111, 48},
+    {10, 5, 111, 49},
+    {10, 5, 111, 49},
+    {10, 5, 111, 49},
+    {10, 5, 111, 49},
+    {10, 5, 111, 50},
+    {10, 5, 111, 50},
+    {10, 5, 111, 50},
+    {10, 5, 111, 50},
+    {10, 5, 111, 97},
+    {10, 5, 111, 97},
+    {10, 5, 111, 97},
+    {10, 5, 111, 97},
+    {10, 5, 111, 99},
+    {10, 5, 111, 99},
+    {10, 5, 111, 99},
+    {10, 5, 111, 99},
+    {10, 5, 111, 101},
+    {10, 5, 111, 101},
+    {10, 5, 111, 101},
+    {10, 5, 111, 101},
+    {10, 5, 111, 105},
+    {10, 5, 111, 105},
+    {10, 5, 111, 105},
+    {10, 5, 111, 105},
+    {10, 5, 111, 111},
+    {10, 5, 111, 111},
+    {10, 5, 111, 111},
+    {10, 5, 111, 111},
+    {10, 5, 111, 115},
+    {10, 5, 111, 115},
+    {10, 5, 111, 115},
+    {10, 5, 111, 115},
+    {10, 5, 111, 116},
+    {10, 5, 111, 116},
+    {10, 5, 111, 116},
+    {10, 5, 111, 116},
+    {11, 5, 111, 32},
+    {11, 5, 111, 32},
+    {11, 5, 111, 37},
+    {11, 5, 111, 37},
+    {11, 5, 111, 45},
+    {11, 5, 111, 45},
+    {11, 5, 111, 46},
+    {11, 5, 111, 46},
+    {11, 5, 111, 47},
+    {11, 5, 111, 47},
+    {11, 5, 111, 51},
+    {11, 5, 111, 51},
+    {11, 5, 111, 52},
+    {11, 5, 111, 52},
+    {11, 5, 111, 53},
+    {11, 5, 111, 53},
+    {11, 5, 111, 54},
+    {11, 5, 111, 54},
+    {11, 5, 111, 55},
+    {11, 5, 111, 55},
+    {11, 5, 111, 56},
+    {11, 5, 111, 56},
+    {11, 5, 111, 57},
+    {11, 5, 111, 57},
+    {11, 5, 111, 61},
+    {11, 5, 111, 61},
+    {11, 5, 111, 65},
+    {11, 5, 111, 65},
+    {11, 5, 111, 95},
+    {11, 5, 111, 95},
+    {11, 5, 111, 98},
+    {11, 5, 111, 98},
+    {11, 5, 111, 100},
+    {11, 5, 111, 100},
+    {11, 5, 111, 102},
+    {11, 5, 111, 102},
+    {11, 5, 111, 103},
+    {11, 5, 111, 103},
+    {11, 5, 111, 104},
+    {11, 5, 111, 104},
+    {11, 5, 111, 108},
+    {11, 5, 111, 108},
+    {11, 5, 111, 109},
+    {11, 5, 111, 109},
+    {11, 5, 111, 110},
+    {11, 5, 111, 110},
+    {11, 5, 111, 112},
+    {11, 5, 111, 112},
+    {11, 5, 111, 114},
+    {11, 5, 111, 114},
+    {11, 5, 111, 117},
+    {11, 5, 111, 117},
+    {12, 5, 111, 58},
+    {12, 5, 111, 66},
+    {12, 5, 111, 67},
+    {12, 5, 111, 68},
+    {12, 5, 111, 69},
+    {12, 5, 111, 70},
+    {12, 5, 111, 71},
+    {12, 5, 111, 72},
+    {12, 5, 111, 73},
+    {12, 5, 111, 74},
+    {12, 5, 111, 75},
+    {12, 5, 111, 76},
+    {12, 5, 111, 77},
+    {12, 5, 111, 78},
+    {12, 5, 111, 79},
+    {12, 5, 111, 80},
+    {12, 5, 111, 81},
+    {12, 5, 111, 82},
+    {12, 5, 111, 83},
+    {12, 5, 111, 84},
+    {12, 5, 111, 85},
+    {12, 5, 111, 86},
+    {12, 5, 111, 87},
+    {12, 5, 111, 89},
+    {12, 5, 111, 106},
+    {12, 5, 111, 107},
+    {12, 5, 111, 113},
+    {12, 5, 111, 118},
+    {12, 5, 111, 119},
+    {12, 5, 111, 120},
+    {12, 5, 111, 121},
+    {12, 5, 111, 122},
+    {5, 5, 111, 0},
+    {5, 5, 111, 0},
+    {5, 5, 111, 0},
+    {5, 5, 111, 0},
+    {10, 5, 115, 48},
+    {10, 5, 115, 48},
+    {10, 5, 115, 48},
+    {10, 5, 115, 48},
+    {10, 5, 115, 49},
+    {10, 5, 115, 49},
+    {10, 5, 115, 49},
+    {10, 5, 115, 49},
+    {10, 5, 115, 50},
+    {10, 5, 115, 50},
+    {10, 5, 115, 50},
+    {10, 5, 115, 50},
+    {10, 5, 115, 97},
+    {10, 5, 115, 97},
+    {10, 5, 115, 97},
+    {10, 5, 115, 97},
+    {10, 5, 115, 99},
+    {10, 5, 115, 99},
+    {10, 5, 115, 99},
+    {10, 5, 115, 99},
+    {10, 5, 115, 101},
+    {10, 5, 115, 101},
+    {10, 5, 115, 101},
+    {10, 5, 115, 101},
+    {10, 5, 115, 105},
+    {10, 5, 115, 105},
+    {10, 5, 115, 105},
+    {10, 5, 115, 105},
+    {10, 5, 115, 111},
+    {10, 5, 115, 111},
+    {10, 5, 115, 111},
+    {10, 5, 115, 111},
+    {10, 5, 115, 115},
+    {10, 5, 115, 115},
+    {10, 5, 115, 115},
+    {10, 5, 115, 115},
+    {10, 5, 115, 116},
+    {10, 5, 115, 116},
+    {10, 5, 115, 116},
+    {10, 5, 115, 116},
+    {11, 5, 115, 32},
+    {11, 5, 115, 32},
+    {11, 5, 115, 37},
+    {11, 5, 115, 37},
+    {11, 5, 115, 45},
+    {11, 5, 115, 45},
+    {11, 5, 115, 46},
+    {11, 5, 115, 46},
+    {11, 5, 115, 47},
+    {11, 5, 115, 47},
+    {11, 5, 115, 51},
+    {11, 5, 115, 51},
+    {11, 5, 115, 52},
+    {11, 5, 115, 52},
+    {11, 5, 115, 53},
+    {11, 5, 115, 53},
+    {11, 5, 115, 54},
+    {11, 5, 115, 54},
+    {11, 5, 115, 55},
+    {11, 5, 115, 55},
+    {11, 5, 115, 56},
+    {11, 5, 115, 56},
+    {11, 5, 115, 57},
+    {11, 5, 115, 57},
+    {11, 5, 115, 61},
+    {11, 5, 115, 61},
+    {11, 5, 115, 65},
+    {11, 5, 115, 65},
+    {11, 5, 115, 95},
+    {11, 5, 115, 95},
+    {11, 5, 115, 98},
+    {11, 5, 115, 98},
+    {11, 5, 115, 100},
+    {11, 5, 115, 100},
+    {11, 5, 115, 102},
+    {11, 5, 115, 102},
+    {11, 5, 115, 103},
+    {11, 5, 115, 103},
+    {11, 5, 115, 104},
+    {11, 5, 115, 104},
+    {11, 5, 115, 108},
+    {11, 5, 115, 108},
+    {11, 5, 115, 109},
+    {11, 5, 115, 109},
+    {11, 5, 115, 110},
+    {11, 5, 115, 110},
+    {11, 5, 115, 112},
+    {11, 5, 115, 112},
+    {11, 5, 115, 114},
+    {11, 5, 115, 114},
+    {11, 5, 115, 117},
+    {11, 5, 115, 117},
+    {12, 5, 115, 58},
+    {12, 5, 115, 66},
+    {12, 5, 115, 67},
+    {12, 5, 115, 68},
+    {12, 5, 115, 69},
+    {12, 5, 115, 70},
+    {12, 5, 115, 71},
+    {12, 5, 115, 72},
+    {12, 5, 115, 73},
+    {12, 5, 115, 74},
+    {12, 5, 115, 75},
+    {12, 5, 115, 76},
+    {12, 5, 115, 77},
+    {12, 5, 115, 78},
+    {12, 5, 115, 79},
+    {12, 5, 115, 80},
+    {12, 5, 115, 81},
+    {12, 5, 115, 82},
+    {12, 5, 115, 83},
+    {12, 5, 115, 84},
+    {12, 5, 115, 85},
+    {12, 5, 115, 86},
+    {12, 5, 115, 87},
+    {12, 5, 115, 89},
+    {12, 5, 115, 106},
+    {12, 5, 115, 107},
+    {12, 5, 115, 113},
+    {12, 5, 115, 118},
+    {12, 5, 115, 119},
+    {12, 5, 115, 120},
+    {12, 5, 115, 121},
+    {12, 5, 115, 122},
+    {5, 5, 115, 0},
+    {5, 5, 115, 0},
+    {5, 5, 115, 0},
+    {5, 5, 115, 0},
+    {10, 5, 116, 48},
+    {10, 5, 116, 48},
+    {10, 5, 116, 48},
+    {10, 5, 116, 48},
+    {10, 5, 116, 49},
+    {10, 5, 116, 49},
+    {10, 5, 116, 49},
+    {10, 5, 116, 49},
+    {10, 5, 116, 50},
+    {10, 5, 116, 50},
+    {10, 5, 116, 50},
+    {10, 5, 116, 50},
+    {10, 5, 116, 97},
+    {10, 5, 116, 97},
+    {10, 5, 116, 97},
+    {10, 5, 116, 97},
+    {10, 5, 116, 99},
+    {10, 5, 116, 99},
+    {10, 5, 116, 99},
+    {10, 5, 116, 99},
+    {10, 5, 116, 101},
+    {10, 5, 116, 101},
+    {10, 5, 116, 101},
+    {10, 5, 116, 101},
+    {10, 5, 116, 105},
+    {10, 5, 116, 105},
+    {10, 5, 116, 105},
+    {10, 5, 116, 105},
+    {10, 5, 116, 111},
+    {10, 5, 116, 111},
+    {10, 5, 116, 111},
+    {10, 5, 116, 111},
+    {10, 5, 116, 115},
+    {10, 5, 116, 115},
+    {10, 5, 116, 115},
+    {10, 5, 116, 115},
+    {10, 5, 116, 116},
+    {10, 5, 116, 116},
+    {10, 5, 116, 116},
+    {10, 5, 116, 116},
+    {11, 5, 116, 32},
+    {11, 5, 116, 32},
+    {11, 5, 116, 37},
+    {11, 5, 116, 37},
+    {11, 5, 116, 45},
+    {11, 5, 116, 45},
+    {11, 5, 116, 46},
+    {11, 5, 116, 46},
+    {11, 5, 116, 47},
+    {11, 5, 116, 47},
+    {11, 5, 116, 51},
+    {11, 5, 116, 51},
+    {11, 5, 116, 52},
+    {11, 5, 116, 52},
+    {11, 5, 116, 53},
+    {11, 5, 116, 53},
+    {11, 5, 116, 54},
+    {11, 5, 116, 54},
+    {11, 5, 116, 55},
+    {11, 5, 116, 55},
+    {11, 5, 116, 56},
+    {11, 5, 116, 56},
+    {11, 5, 116, 57},
+    {11, 5, 116, 57},
+    {11, 5, 116, 61},
+    {11, 5, 116, 61},
+    {11, 5, 116, 65},
+    {11, 5, 116, 65},
+    {11, 5, 116, 95},
+    {11, 5, 116, 95},
+    {11, 5, 116, 98},
+    {11, 5, 116, 98},
+    {11, 5, 116, 100},
+    {11, 5, 116, 100},
+    {11, 5, 116, 102},
+    {11, 5, 116, 102},
+    {11, 5, 116, 103},
+    {11, 5, 116, 103},
+    {11, 5, 116, 104},
+    {11, 5, 116, 104},
+    {11, 5, 116, 108},
+    {11, 5, 116, 108},
+    {11, 5, 116, 109},
+    {11, 5, 116, 109},
+    {11, 5, 116, 110},
+    {11, 5, 116, 110},
+    {11, 5, 116, 112},
+    {11, 5, 116, 112},
+    {11, 5, 116, 114},
+    {11, 5, 116, 114},
+    {11, 5, 116, 117},
+    {11, 5, 116, 117},
+    {12, 5, 116, 58},
+    {12, 5, 116, 66},
+    {12, 5, 116, 67},
+    {12, 5, 116, 68},
+    {12, 5, 116, 69},
+    {12, 5, 116, 70},
+    {12, 5, 116, 71},
+    {12, 5, 116, 72},
+    {12, 5, 116, 73},
+    {12, 5, 116, 74},
+    {12, 5, 116, 75},
+    {12, 5, 116, 76},
+    {12, 5, 116, 77},
+    {12, 5, 116, 78},
+    {12, 5, 116, 79},
+    {12, 5, 116, 80},
+    {12, 5, 116, 81},
+    {12, 5, 116, 82},
+    {12, 5, 116, 83},
+    {12, 5, 116, 84},
+    {12, 5, 116, 85},
+    {12, 5, 116, 86},
+    {12, 5, 116, 87},
+    {12, 5, 116, 89},
+    {12, 5, 116, 106},
+    {12, 5, 116, 107},
+    {12, 5, 116, 113},
+    {12, 5, 116, 118},
+    {12, 5, 116, 119},
+    {12, 5, 116, 120},
+    {12, 5, 116, 121},
+    {12, 5, 116, 122},
+    {5, 5, 116, 0},
+    {5, 5, 116, 0},
+    {5, 5, 116, 0},
+    {5, 5, 116, 0},
+    {11, 6, 32, 48},
+    {11, 6, 32, 48},
+    {11, 6, 32, 49},
+    {11, 6, 32, 49},
+    {11, 6, 32, 50},
+    {11, 6, 32, 50},
+    {11, 6, 32, 97},
+    {11, 6, 32, 97},
+    {11, 6, 32, 99},
+    {11, 6, 32, 99},
+    {11, 6, 32, 101},
+    {11, 6, 32, 101},
+    {11, 6, 32, 105},
+    {11, 6, 32, 105},
+    {11, 6, 32, 111},
+    {11, 6, 32, 111},
+    {11, 6, 32, 115},
+    {11, 6, 32, 115},
+    {11, 6, 32, 116},
+    {11, 6, 32, 116},
+    {12, 6, 32, 32},
+    {12, 6, 32, 37},
+    {12, 6, 32, 45},
+    {12, 6, 32, 46},
+    {12, 6, 32, 47},
+    {12, 6, 32, 51},
+    {12, 6, 32, 52},
+    {12, 6, 32, 53},
+    {12, 6, 32, 54},
+    {12, 6, 32, 55},
+    {12, 6, 32, 56},
+    {12, 6, 32, 57},
+    {12, 6, 32, 61},
+    {12, 6, 32, 65},
+    {12, 6, 32, 95},
+    {12, 6, 32, 98},
+    {12, 6, 32, 100},
+    {12, 6, 32, 102},
+    {12, 6, 32, 103},
+    {12, 6, 32, 104},
+    {12, 6, 32, 108},
+    {12, 6, 32, 109},
+    {12, 6, 32, 110},
+    {12, 6, 32, 112},
+    {12, 6, 32, 114},
+    {12, 6, 32, 117},
+    {6, 6, 32, 0},
+    {6, 6, 32, 0},
+    {6, 6, 32, 0},
+    {6, 6, 32, 0},
+    {6, 6, 32, 0},
+    {6, 6, 32, 0},
+    {6, 6, 32, 0},
+    {6, 6, 32, 0},
+    {6, 6, 32, 0},
+    {6, 6, 32, 0},
+    {6, 6, 32, 0},
+    {6, 6, 32, 0},
+    {6, 6, 32, 0},
+    {6, 6, 32, 0},
+    {6, 6, 32, 0},
+    {6, 6, 32, 0},
+    {6, 6, 32, 0},
+    {6, 6, 32, 0},
+    {11, 6, 37, 48},
+    {11, 6, 37, 48},
+    {11, 6, 37, 49},
+    {11, 6, 37, 49},
+    {11, 6, 37, 50},
+    {11, 6, 37, 50},
+    {11, 6, 37, 97},
+    {11, 6, 37, 97},
+    {11, 6, 37, 99},
+    {11, 6, 37, 99},
+    {11, 6, 37, 101},
+    {11, 6, 37, 101},
+    {11, 6, 37, 105},
+    {11, 6, 37, 105},
+    {11, 6, 37, 111},
+    {11, 6, 37, 111},
+    {11, 6, 37, 115},
+    {11, 6, 37, 115},
+    {11, 6, 37, 116},
+    {11, 6, 37, 116},
+    {12, 6, 37, 32},
+    {12, 6, 37, 37},
+    {12, 6, 37, 45},
+    {12, 6, 37, 46},
+    {12, 6, 37, 47},
+    {12, 6, 37, 51},
+    {12, 6, 37, 52},
+    {12, 6, 37, 53},
+    {12, 6, 37, 54},
+    {12, 6, 37, 55},
+    {12, 6, 37, 56},
+    {12, 6, 37, 57},
+    {12, 6, 37, 61},
+    {12, 6, 37, 65},
+    {12, 6, 37, 95},
+    {12, 6, 37, 98},
+    {12, 6, 37, 100},
+    {12, 6, 37, 102},
+    {12, 6, 37, 103},
+    {12, 6, 37, 104},
+    {12, 6, 37, 108},
+    {12, 6, 37, 109},
+    {12, 6, 37, 110},
+    {12, 6, 37, 112},
+    {12, 6, 37, 114},
+    {12, 6, 37, 117},
+    {6, 6, 37, 0},
+    {6, 6, 37, 0},
+    {6, 6, 37, 0},
+    {6, 6, 37, 0},
+    {6, 6, 37, 0},
+    {6, 6, 37, 0},
+    {6, 6, 37, 0},
+    {6, 6, 37, 0},
+    {6, 6, 37, 0},
+    {6, 6, 37, 0},
+    {6, 6, 37, 0},
+    {6, 6, 37, 0},
+    {6, 6, 37, 0},
+    {6, 6, 37, 0},
+    {6, 6, 37, 0},
+    {6, 6, 37, 0},
+    {6, 6, 37, 0},
+    {6, 6, 37, 0},
+    {11, 6, 45, 48},
+    {11, 6, 45, 48},
+    {11, 6, 45, 49},
+    {11, 6, 45, 49},
+    {11, 6, 45, 50},
+    {11, 6, 45, 50},
+    {11, 6, 45, 97},
+    {11, 6, 45, 97},
+    {11, 6, 45, 99},
+    {11, 6, 45, 99},
+    {11, 6, 45, 101},
+    {11, 6, 45, 101},
+    {11, 6, 45, 105},
+    {11, 6, 45, 105},
+    {11, 6, 45, 111},
+    {11, 6, 45, 111},
+    {11, 6, 45, 115},
+    {11, 6, 45, 115},
+    {11, 6, 45, 116},
+    {11, 6, 45, 116},
+    {12, 6, 45, 32},
+    {12, 6, 45, 37},
+    {12, 6, 45, 45},
+    {12, 6, 45, 46},
+    {12, 6, 45, 47},
+    {12, 6, 45, 51},
+    {12, 6, 45, 52},
+    {12, 6, 45, 53},
+    {12, 6, 45, 54},
+    {12, 6, 45, 55},
+    {12, 6, 45, 56},
+    {12, 6, 45, 57},
+    {12, 6, 45, 61},
+    {12, 6, 45, 65},
+    {12, 6, 45, 95},
+    {12, 6, 45, 98},
+    {12, 6, 45, 100},
+    {12, 6, 45, 102},
+    {12, 6, 45, 103},
+    {12, 6, 45, 104},
+    {12, 6, 45, 108},
+    {12, 6, 45, 109},
+    {12, 6, 45, 110},
+    {12, 6, 45, 112},
+    {12, 6, 45, 114},
+    {12, 6, 45, 117},
+    {6, 6, 45, 0},
+    {6, 6, 45, 0},
+    {6, 6, 45, 0},
+    {6, 6, 45, 0},
+    {6, 6, 45, 0},
+    {6, 6, 45, 0},
+    {6, 6, 45, 0},
+    {6, 6, 45, 0},
+    {6, 6, 45, 0},
+    {6, 6, 45, 0},
+    {6, 6, 45, 0},
+    {6, 6, 45, 0},
+    {6, 6, 45, 0},
+    {6, 6, 45, 0},
+    {6, 6, 45, 0},
+    {6, 6, 45, 0},
+    {6, 6, 45, 0},
+    {6, 6, 45, 0},
+    {11, 6, 46, 48},
+    {11, 6, 46, 48},
+    {11, 6, 46, 49},
+    {11, 6, 46, 49},
+    {11, 6, 46, 50},
+    {11, 6, 46, 50},
+    {11, 6, 46, 97},
+    {11, 6, 46, 97},
+    {11, 6, 46, 99},
+    {11, 6, 46, 99},
+    {11, 6, 46, 101},
+    {11, 6, 46, 101},
+    {11, 6, 46, 105},
+    {11, 6, 46, 105},
+    {11, 6, 46, 111},
+    {11, 6, 46, 111},
+    {11, 6, 46, 115},
+    {11, 6, 46, 115},
+    {11, 6, 46, 116},
+    {11, 6, 46, 116},
+    {12, 6, 46, 32},
+    {12, 6, 46, 37},
+    {12, 6, 46, 45},
+    {12, 6, 46, 46},
+    {12, 6, 46, 47},
+    {12, 6, 46, 51},
+    {12, 6, 46, 52},
+    {12, 6, 46, 53},
+    {12, 6, 46, 54},
+    {12, 6, 46, 55},
+    {12, 6, 46, 56},
+    {12, 6, 46, 57},
+    {12, 6, 46, 61},
+    {12, 6, 46, 65},
+    {12, 6, 46, 95},
+    {12, 6, 46, 98},
+    {12, 6, 46, 100},
+    {12, 6, 46, 102},
+    {12, 6, 46, 103},
+    {12, 6, 46, 104},
+    {12, 6, 46, 108},
+    {12, 6, 46, 109},
+    {12, 6, 46, 110},
+    {12, 6, 46, 112},
+    {12, 6, 46, 114},
+    {12, 6, 46, 117},
+    {6, 6, 46, 0},
+    {6, 6, 46, 0},
+    {6, 6, 46, 0},
+    {6, 6, 46, 0},
+    {6, 6, 46, 0},
+    {6, 6, 46, 0},
+    {6, 6, 46, 0},
+    {6, 6, 46, 0},
+    {6, 6, 46, 0},
+    {6, 6, 46, 0},
+    {6, 6, 46, 0},
+    {6, 6, 46, 0},
+    {6, 6, 46, 0},
+    {6, 6, 46, 0},
+    {6, 6, 46, 0},
+    {6, 6, 46, 0},
+    {6, 6, 46, 0},
+    {6, 6, 46, 0},
+    {11, 6, 47, 48},
+    {11, 6, 47, 48},
+    {11, 6, 47, 49},
+    {11, 6, 47, 49},
+    {11, 6, 47, 50},
+    {11, 6, 47, 50},
+    {11, 6, 47, 97},
+    {11, 6, 47, 97},
+    {11, 6, 47, 99},
+    {11, 6, 47, 99},
+    {11, 6, 47, 101},
+    {11, 6, 47, 101},
+    {11, 6, 47, 105},
+    {11, 6, 47, 105},
+    {11, 6, 47, 111},
+    {11, 6, 47, 111},
+    {11, 6, 47, 115},
+    {11, 6, 47, 115},
+    {11, 6, 47, 116},
+    {11, 6, 47, 116},
+    {12, 6, 47, 32},
+    {12, 6, 47, 37},
+    {12, 6, 47, 45},
+    {12, 6, 47, 46},
+    {12, 6, 47, 47},
+    {12, 6, 47, 51},
+    {12, 6, 47, 52},
+    {12, 6, 47, 53},
+    {12, 6, 47, 54},
+    {12, 6, 47, 55},
+    {12, 6, 47, 56},
+    {12, 6, 47, 57},
+    {12, 6, 47, 61},
+    {12, 6, 47, 65},
+    {12, 6, 47, 95},
+    {12, 6, 47, 98},
+    {12, 6, 47, 100},
+    {12, 6, 47, 102},
+    {12, 6, 47, 103},
+    {12, 6, 47, 104},
+    {12, 6, 47, 108},
+    {12, 6, 47, 109},
+    {12, 6, 47, 110},
+    {12, 6, 47, 112},
+    {12, 6, 47, 114},
+    {12, 6, 47, 117},
+    {6, 6, 47, 0},
+    {6, 6, 47, 0},
+    {6, 6, 47, 0},
+    {6, 6, 47, 0},
+    {6, 6, 47, 0},
+    {6, 6, 47, 0},
+    {6, 6, 47, 0},
+    {6, 6, 47, 0},
+    {6, 6, 47, 0},
+    {6, 6, 47, 0},
+    {6, 6, 47, 0},
+    {6, 6, 47, 0},
+    {6, 6, 47, 0},
+    {6, 6, 47, 0},
+    {6, 6, 47, 0},
+    {6, 6, 47, 0},
+    {6, 6, 47, 0},
+    {6, 6, 47, 0},
+    {11, 6, 51, 48},
+    {11, 6, 51, 48},
+    {11, 6, 51, 49},
+    {11, 6, 51, 49},
+    {11, 6, 51, 50},
+    {11, 6, 51, 50},
+    {11, 6, 51, 97},
+    {11, 6, 51, 97},
+    {11, 6, 51, 99},
+    {11, 6, 51, 99},
+    {11, 6, 51, 101},
+    {11, 6, 51, 101},
+    {11, 6, 51, 105},
+    {11, 6, 51, 105},
+    {11, 6, 51, 111},
+    {11, 6, 51, 111},
+    {11, 6, 51, 115},
+    {11, 6, 51, 115},
+    {11, 6, 51, 116},
+    {11, 6, 51, 116},
+    {12, 6, 51, 32},
+    {12, 6, 51, 37},
+    {12, 6, 51, 45},
+    {12, 6, 51, 46},
+    {12, 6, 51, 47},
+    {12, 6, 51, 51},
+    {12, 6, 51, 52},
+    {12, 6, 51, 53},
+    {12, 6, 51, 54},
+    {12, 6, 51, 55},
+    {12, 6, 51, 56},
+    {12, 6, 51, 57},
+    {12, 6, 51, 61},
+    {12, 6, 51, 65},
+    {12, 6, 51, 95},
+    {12, 6, 51, 98},
+    {12, 6, 51, 100},
+    {12, 6, 51, 102},
+    {12, 6, 51, 103},
+    {12, 6, 51, 104},
+    {12, 6, 51, 108},
+    {12, 6, 51, 109},
+    {12, 6, 51, 110},
+    {12, 6, 51, 112},
+    {12, 6, 51, 114},
+    {12, 6, 51, 117},
+    {6, 6, 51, 0},
+    {6, 6, 51, 0},
+    {6, 6, 51, 0},
+    {6, 6, 51, 0},
+    {6, 6, 51, 0},
+    {6, 6, 51, 0},
+    {6, 6, 51, 0},
+    {6, 6, 51, 0},
+    {6, 6, 51, 0},
+    {6, 6, 51, 0},
+    {6, 6, 51, 0},
+    {6, 6, 51, 0},
+    {6, 6, 51, 0},
+    {6, 6, 51, 0},
+    {6, 6, 51, 0},
+    {6, 6, 51, 0},
+    {6, 6, 51, 0},
+    {6, 6, 51, 0},
+    {11, 6, 52, 48},
+    {11, 6, 52, 48},
+    {11, 6, 52, 49},
+    {11, 6, 52, 49},
+    {11, 6, 52, 50},
+    {11, 6, 52, 50},
+    {11, 6, 52, 97},
+    {11, 6, 52, 97},
+    {11, 6, 52, 99},
+    {11, 6, 52, 99},
+    {11, 6, 52, 101},
+    {11, 6, 52, 101},
+    {11, 6, 52, 105},
+    {11, 6, 52, 105},
+    {11, 6, 52, 111},
+    {11, 6, 52, 111},
+    {11, 6, 52, 115},
+    {11, 6, 52, 115},
+    {11, 6, 52, 116},
+    {11, 6, 52, 116},
+    {12, 6, 52, 32},
+    {12, 6, 52, 37},
+    {12, 6, 52, 45},
+    {12, 6, 52, 46},
+    {12, 6, 52, 47},
+    {12, 6, 52, 51},
+    {12, 6, 52, 52},
+    {12, 6, 52, 53},
+    {12, 6, 52, 54},
+    {12, 6, 52, 55},
+    {12, 6, 52, 56},
+    {12, 6, 52, 57},
+    {12, 6, 52, 61},
+    {12, 6, 52, 65},
+    {12, 6, 52, 95},
+    {12, 6, 52, 98},
+    {12, 6, 52, 100},
+    {12, 6, 52, 102},
+    {12, 6, 52, 103},
+    {12, 6, 52, 104},
+    {12, 6, 52, 108},
+    {12, 6, 52, 109},
+    {12, 6, 52, 110},
+    {12, 6, 52, 112},
+    {12, 6, 52, 114},
+    {12, 6, 52, 117},
+    {6, 6, 52, 0},
+    {6, 6, 52, 0},
+    {6, 6, 52, 0},
+    {6, 6, 52, 0},
+    {6, 6, 52, 0},
+    {6, 6, 52, 0},
+    {6, 6, 52, 0},
+    {6, 6, 52, 0},
+    {6, 6, 52, 0},
+    {6, 6, 52, 0},
+    {6, 6, 52, 0},
+    {6, 6, 52, 0},
+    {6, 6, 52, 0},
+    {6, 6, 52, 0},
+    {6, 6, 52, 0},
+    {6, 6, 52, 0},
+    {6, 6, 52, 0},
+    {6, 6, 52, 0},
+    {11, 6, 53, 48},
+    {11, 6, 53, 48},
+    {11, 6, 53, 49},
+    {11, 6, 53, 49},
+    {11, 6, 53, 50},
+    {11, 6, 53, 50},
+    {11, 6, 53, 97},
+    {11, 6, 53, 97},
+    {11, 6, 53, 99},
+    {11, 6, 53, 99},
+    {11, 6, 53, 101},
+    {11, 6, 53, 101},
+    {11, 6, 53, 105},
+    {11, 6, 53, 105},
+    {11, 6, 53, 111},
+    {11, 6, 53, 111},
+    {11, 6, 53, 115},
+    {11, 6, 53, 115},
+    {11, 6, 53, 116},
+    {11, 6, 53, 116},
+    {12, 6, 53, 32},
+    {12, 6, 53, 37},
+    {12, 6, 53, 45},
+    {12, 6, 53, 46},
+    {12, 6, 53, 47},
+    {12, 6, 53, 51},
+    {12, 6, 53, 52},
+    {12, 6, 53, 53},
+    {12, 6, 53, 54},
+    {12, 6, 53, 55},
+    {12, 6, 53, 56},
+    {12, 6, 53, 57},
+    {12, 6, 53, 61},
+    {12, 6, 53, 65},
+    {12, 6, 53, 95},
+    {12, 6, 53, 98},
+    {12, 6, 53, 100},
+    {12, 6, 53, 102},
+    {12, 6, 53, 103},
+    {12, 6, 53, 104},
+    {12, 6, 53, 108},
+    {12, 6, 53, 109},
+    {12, 6, 53, 110},
+    {12, 6, 53, 112},
+    {12, 6, 53, 114},
+    {12, 6, 53, 117},
+    {6, 6, 53, 0},
+    {6, 6, 53, 0},
+    {6, 6, 53, 0},
+    {6, 6, 53, 0},
+    {6, 6, 53, 0},
+    {6, 6, 53, 0},
+    {6, 6, 53, 0},
+    {6, 6, 53, 0},
+    {6, 6, 53, 0},
+    {6, 6, 53, 0},
+    {6, 6, 53, 0},
+    {6, 6, 53, 0},
+    {6, 6, 53, 0},
+    {6, 6, 53, 0},
+    {6, 6, 53, 0},
+    {6, 6, 53, 0},
+    {6, 6, 53, 0},
+    {6, 6, 53, 0},
+    {11, 6, 54, 48},
+    {11, 6, 54, 48},
+    {11, 6, 54, 49},
+    {11, 6, 54, 49},
+    {11, 6, 54, 50},
+    {11, 6, 54, 50},
+    {11, 6, 54, 97},
+    {11, 6, 54, 97},
+    {11, 6, 54, 99},
+    {11, 6, 54, 99},
+    {11, 6, 54, 101},
+    {11, 6, 54, 101},
+    {11, 6, 54, 105},
+    {11, 6, 54, 105},
+    {11, 6, 54, 111},
+    {11, 6, 54, 111},
+    {11, 6, 54, 115},
+    {11, 6, 54, 115},
+    {11, 6, 54, 116},
+    {11, 6, 54, 116},
+    {12, 6, 54, 32},
+    {12, 6, 54, 37},
+    {12, 6, 54, 45},
+    {12, 6, 54, 46},
+    {12, 6, 54, 47},
+    {12, 6, 54, 51},
+    {12, 6, 54, 52},
+    {12, 6, 54, 53},
+    {12, 6, 54, 54},
+    {12, 6, 54, 55},
+    {12, 6, 54, 56},
+    {12, 6, 54, 57},
+    {12, 6, 54, 61},
+    {12, 6, 54, 65},
+    {12, 6, 54, 95},
+    {12, 6, 54, 98},
+    {12, 6, 54, 100},
+    {12, 6, 54, 102},
+    {12, 6, 54, 103},
+    {12, 6, 54, 104},
+    {12, 6, 54, 108},
+    {12, 6, 54, 109},
+    {12, 6, 54, 110},
+    {12, 6, 54, 112},
+    {12, 6, 54, 114},
+    {12, 6, 54, 117},
+    {6, 6, 54, 0},
+    {6, 6, 54, 0},
+    {6, 6, 54, 0},
+    {6, 6, 54, 0},
+    {6, 6, 54, 0},
+    {6, 6, 54, 0},
+    {6, 6, 54, 0},
+    {6, 6, 54, 0},
+    {6, 6, 54, 0},
+    {6, 6, 54, 0},
+    {6, 6, 54, 0},
+    {6, 6, 54, 0},
+    {6, 6, 54, 0},
+    {6, 6, 54, 0},
+    {6, 6, 54, 0},
+    {6, 6, 54, 0},
+    {6, 6, 54, 0},
+    {6, 6, 54, 0},
+    {11, 6, 55, 48},
+    {11, 6, 55, 48},
+    {11, 6, 55, 49},
+    {11, 6, 55, 49},
+    {11, 6, 55, 50},
+    {11, 6, 55, 50},
+    {11, 6, 55, 97},
+    {11, 6, 55, 97},
+    {11, 6, 55, 99},
+    {11, 6, 55, 99},
+    {11, 6, 55, 101},
+    {11, 6, 55, 101},
+    {11, 6, 55, 105},
+    {11, 6, 55, 105},
+    {11, 6, 55, 111},
+    {11, 6, 55, 111},
+    {11, 6, 55, 115},
+    {11, 6, 55, 115},
+    {11, 6, 55, 116},
+    {11, 6, 55, 116},
+    {12, 6, 55, 32},
+    {12, 6, 55, 37},
+    {12, 6, 55, 45},
+    {12, 6, 55, 46},
+    {12, 6, 55, 47},
+    {12, 6, 55, 51},
+    {12, 6, 55, 52},
+    {12, 6, 55, 53},
+    {12, 6, 55, 54},
+    {12, 6, 55, 55},
+    {12, 6, 55, 56},
+    {12, 6, 55, 57},
+    {12, 6, 55, 61},
+    {12, 6, 55, 65},
+    {12, 6, 55, 95},
+    {12, 6, 55, 98},
+    {12, 6, 55, 100},
+    {12, 6, 55, 102},
+    {12, 6, 55, 103},
+    {12, 6, 55, 104},
+    {12, 6, 55, 108},
+    {12, 6, 55, 109},
+    {12, 6, 55, 110},
+    {12, 6, 55, 112},
+    {12, 6, 55, 114},
+    {12, 6, 55, 117},
+    {6, 6, 55, 0},
+    {6, 6, 55, 0},
+    {6, 6, 55, 0},
+    {6, 6, 55, 0},
+    {6, 6, 55, 0},
+    {6, 6, 55, 0},
+    {6, 6, 55, 0},
+    {6, 6, 55, 0},
+    {6, 6, 55, 0},
+    {6, 6, 55, 0},
+    {6, 6, 55, 0},
+    {6, 6, 55, 0},
+    {6, 6, 55, 0},
+    {6, 6, 55, 0},
+    {6, 6, 55, 0},
+    {6, 6, 55, 0},
+    {6, 6, 55, 0},
+    {6, 6, 55, 0},
+    {11, 6, 56, 48},
+    {11, 6, 56, 48},
+    {11, 6, 56, 49},
+    {11, 6, 56, 49},
+    {11, 6, 56, 50},
+    {11, 6, 56, 50},
+    {11, 6, 56, 97},
+    {11, 6, 56, 97},
+    {11, 6, 56, 99},
+    {11, 6, 56, 99},
+    {11, 6, 56, 101},
+    {11, 6, 56, 101},
+    {11, 6, 56, 105},
+    {11, 6, 56, 105},
+    {11, 6, 56, 111},
+    {11, 6, 56, 111},
+    {11, 6, 56, 115},
+    {11, 6, 56, 115},
+    {11, 6, 56, 116},
+    {11, 6, 56, 116},
+    {12, 6, 56, 32},
+    {12, 6, 56, 37},
+    {12, 6, 56, 45},
+    {12, 6, 56, 46},
+    {12, 6, 56, 47},
+    {12, 6, 56, 51},
+    {12, 6, 56, 52},
+    {12, 6, 56, 53},
+    {12, 6, 56, 54},
+    {12, 6, 56, 55},
+    {12, 6, 56, 56},
+    {12, 6, 56, 57},
+    {12, 6, 56, 61},
+    {12, 6, 56, 65},
+    {12, 6, 56, 95},
+    {12, 6, 56, 98},
+    {12, 6, 56, 100},
+    {12, 6, 56, 102},
+    {12, 6, 56, 103},
+    {12, 6, 56, 104},
+    {12, 6, 56, 108},
+    {12, 6, 56, 109},
+    {12, 6, 56, 110},
+    {12, 6, 56, 112},
+    {12, 6, 56, 114},
+    {12, 6, 56, 117},
+    {6, 6, 56, 0},
+    {6, 6, 56, 0},
+    {6, 6, 56, 0},
+    {6, 6, 56, 0},
+    {6, 6, 56, 0},
+    {6, 6, 56, 0},
+    {6, 6, 56, 0},
+    {6, 6, 56, 0},
+    {6, 6, 56, 0},
+    {6, 6, 56, 0},
+    {6, 6, 56, 0},
+    {6, 6, 56, 0},
+    {6, 6, 56, 0},
+    {6, 6, 56, 0},
+    {6, 6, 56, 0},
+    {6, 6, 56, 0},
+    {6, 6, 56, 0},
+    {6, 6, 56, 0},
+    {11, 6, 57, 48},
+    {11, 6, 57, 48},
+    {11, 6, 57, 49},
+    {11, 6, 57, 49},
+    {11, 6, 57, 50},
+    {11, 6, 57, 50},
+    {11, 6, 57, 97},
+    {11, 6, 57, 97},
+    {11, 6, 57, 99},
+    {11, 6, 57, 99},
+    {11, 6, 57, 101},
+    {11, 6, 57, 101},
+    {11, 6, 57, 105},
+    {11, 6, 57, 105},
+    {11, 6, 57, 111},
+    {11, 6, 57, 111},
+    {11, 6, 57, 115},
+    {11, 6, 57, 115},
+    {11, 6, 57, 116},
+    {11, 6, 57, 116},
+    {12, 6, 57, 32},
+    {12, 6, 57, 37},
+    {12, 6, 57, 45},
+    {12, 6, 57, 46},
+    {12, 6, 57, 47},
+    {12, 6, 57, 51},
+    {12, 6, 57, 52},
+    {12, 6, 57, 53},
+    {12, 6, 57, 54},
+    {12, 6, 57, 55},
+    {12, 6, 57, 56},
+    {12, 6, 57, 57},
+    {12, 6, 57, 61},
+    {12, 6, 57, 65},
+    {12, 6, 57, 95},
+    {12, 6, 57, 98},
+    {12, 6, 57, 100},
+    {12, 6, 57, 102},
+    {12, 6, 57, 103},
+    {12, 6, 57, 104},
+    {12, 6, 57, 108},
+    {12, 6, 57, 109},
+    {12, 6, 57, 110},
+    {12, 6, 57, 112},
+    {12, 6, 57, 114},
+    {12, 6, 57, 117},
+    {6, 6, 57, 0},
+    {6, 6, 57, 0},
+    {6, 6, 57, 0},
+    {6, 6, 57, 0},
+    {6, 6, 57, 0},
+    {6, 6, 57, 0},
+    {6, 6, 57, 0},
+    {6, 6, 57, 0},
+    {6, 6, 57, 0},
+    {6, 6, 57, 0},
+    {6, 6, 57, 0},
+    {6, 6, 57, 0},
+    {6, 6, 57, 0},
+    {6, 6, 57, 0},
+    {6, 6, 57, 0},
+    {6, 6, 57, 0},
+    {6, 6, 57, 0},
+    {6, 6, 57, 0},
+    {11, 6, 61, 48},
+    {11, 6, 61, 48},
+    {11, 6, 61, 49},
+    {11, 6, 61, 49},
+    {11, 6, 61, 50},
+    {11, 6, 61, 50},
+    {11, 6, 61, 97},
+    {11, 6, 61, 97},
+    {11, 6, 61, 99},
+    {11, 6, 61, 99},
+    {11, 6, 61, 101},
+    {11, 6, 61, 101},
+    {11, 6, 61, 105},
+    {11, 6, 61, 105},
+    {11, 6, 61, 111},
+    {11, 6, 61, 111},
+    {11, 6, 61, 115},
+    {11, 6, 61, 115},
+    {11, 6, 61, 116},
+    {11, 6, 61, 116},
+    {12, 6, 61, 32},
+    {12, 6, 61, 37},
+    {12, 6, 61, 45},
+    {12, 6, 61, 46},
+    {12, 6, 61, 47},
+    {12, 6, 61, 51},
+    {12, 6, 61, 52},
+    {12, 6, 61, 53},
+    {12, 6, 61, 54},
+    {12, 6, 61, 55},
+    {12, 6, 61, 56},
+    {12, 6, 61, 57},
+    {12, 6, 61, 61},
+    {12, 6, 61, 65},
+    {12, 6, 61, 95},
+    {12, 6, 61, 98},
+    {12, 6, 61, 100},
+    {12, 6, 61, 102},
+    {12, 6, 61, 103},
+    {12, 6, 61, 104},
+    {12, 6, 61, 108},
+    {12, 6, 61, 109},
+    {12, 6, 61, 110},
+    {12, 6, 61, 112},
+    {12, 6, 61, 114},
+    {12, 6, 61, 117},
+    {6, 6, 61, 0},
+    {6, 6, 61, 0},
+    {6, 6, 61, 0},
+    {6, 6, 61, 0},
+    {6, 6, 61, 0},
+    {6, 6, 61, 0},
+    {6, 6, 61, 0},
+    {6, 6, 61, 0},
+    {6, 6, 61, 0},
+    {6, 6, 61, 0},
+    {6, 6, 61, 0},
+    {6, 6, 61, 0},
+    {6, 6, 61, 0},
+    {6, 6, 61, 0},
+    {6, 6, 61, 0},
+    {6, 6, 61, 0},
+    {6, 6, 61, 0},
+    {6, 6, 61, 0},
+    {11, 6, 65, 48},
+    {11, 6, 65, 48},
+    {11, 6, 65, 49},
+    {11, 6, 65, 49},
+    {11, 6, 65, 50},
+    {11, 6, 65, 50},
+    {11, 6, 65, 97},
+    {11, 6, 65, 97},
+    {11, 6, 65, 99},
+    {11, 6, 65, 99},
+    {11, 6, 65, 101},
+    {11, 6, 65, 101},
+    {11, 6, 65, 105},
+    {11, 6, 65, 105},
+    {11, 6, 65, 111},
+    {11, 6, 65, 111},
+    {11, 6, 65, 115},
+    {11, 6, 65, 115},
+    {11, 6, 65, 116},
+    {11, 6, 65, 116},
+    {12, 6, 65, 32},
+    {12, 6, 65, 37},
+    {12, 6, 65, 45},
+    {12, 6, 65, 46},
+    {12, 6, 65, 47},
+    {12, 6, 65, 51},
+    {12, 6, 65, 52},
+    {12, 6, 65, 53},
+    {12, 6, 65, 54},
+    {12, 6, 65, 55},
+    {12, 6, 65, 56},
+    {12, 6, 65, 57},
+    {12, 6, 65, 61},
+    {12, 6, 65, 65},
+    {12, 6, 65, 95},
+    {12, 6, 65, 98},
+    {12, 6, 65, 100},
+    {12, 6, 65, 102},
+    {12, 6, 65, 103},
+    {12, 6, 65, 104},
+    {12, 6, 65, 108},
+    {12, 6, 65, 109},
+    {12, 6, 65, 110},
+    {12, 6, 65, 112},
+    {12, 6, 65, 114},
+    {12, 6, 65, 117},
+    {6, 6, 65, 0},
+    {6, 6, 65, 0},
+    {6, 6, 65, 0},
+    {6, 6, 65, 0},
+    {6, 6, 65, 0},
+    {6, 6, 65, 0},
+    {6, 6, 65, 0},
+    {6, 6, 65, 0},
+    {6, 6, 65, 0},
+    {6, 6, 65, 0},
+    {6, 6, 65, 0},
+    {6, 6, 65, 0},
+    {6, 6, 65, 0},
+    {6, 6, 65, 0},
+    {6, 6, 65, 0},
+    {6, 6, 65, 0},
+    {6, 6, 65, 0},
+    {6, 6, 65, 0},
+    {11, 6, 95, 48},
+    {11, 6, 95, 48},
+    {11, 6, 95, 49},
+    {11, 6, 95, 49},
+    {11, 6, 95, 50},
+    {11, 6, 95, 50},
+    {11, 6, 95, 97},
+    {11, 6, 95, 97},
+    {11, 6, 95, 99},
+    {11, 6, 95, 99},
+    {11, 6, 95, 101},
+    {11, 6, 95, 101},
+    {11, 6, 95, 105},
+    {11, 6, 95, 105},
+    {11, 6, 95, 111},
+    {11, 6, 95, 111},
+    {11, 6, 95, 115},
+    {11, 6, 95, 115},
+    {11, 6, 95, 116},
+    {11, 6, 95, 116},
+    {12, 6, 95, 32},
+    {12, 6, 95, 37},
+    {12, 6, 95, 45},
+    {12, 6, 95, 46},
+    {12, 6, 95, 47},
+    {12, 6, 95, 51},
+    {12, 6, 95, 52},
+    {12, 6, 95, 53},
+    {12, 6, 95, 54},
+    {12, 6, 95, 55},
+    {12, 6, 95, 56},
+    {12, 6, 95, 57},
+    {12, 6, 95, 61},
+    {12, 6, 95, 65},
+    {12, 6, 95, 95},
+    {12, 6, 95, 98},
+    {12, 6, 95, 100},
+    {12, 6, 95, 102},
+    {12, 6, 95, 103},
+    {12, 6, 95, 104},
+    {12, 6, 95, 108},
+    {12, 6, 95, 109},
+    {12, 6, 95, 110},
+    {12, 6, 95, 112},
+    {12, 6, 95, 114},
+    {12, 6, 95, 117},
+    {6, 6, 95, 0},
+    {6, 6, 95, 0},
+    {6, 6, 95, 0},
+    {6, 6, 95, 0},
+    {6, 6, 95, 0},
+    {6, 6, 95, 0},
+    {6, 6, 95, 0},
+    {6, 6, 95, 0},
+    {6, 6, 95, 0},
+    {6, 6, 95, 0},
+    {6, 6, 95, 0},
+    {6, 6, 95, 0},
+    {6, 6, 95, 0},
+    {6, 6, 95, 0},
+    {6, 6, 95, 0},
+    {6, 6, 95, 0},
+    {6, 6, 95, 0},
+    {6, 6, 95, 0},
+    {11, 6, 98, 48},
+    {11, 6, 98, 48},
+    {11, 6, 98, 49},
+    {11, 6, 98, 49},
+    {11, 6, 98, 50},
+    {11, 6, 98, 50},
+    {11, 6, 98, 97},
+    {11, 6, 98, 97},
+    {11, 6, 98, 99},
+    {11, 6, 98, 99},
+    {11, 6, 98, 101},
+    {11, 6, 98, 101},
+    {11, 6, 98, 105},
+    {11, 6, 98, 105},
+    {11, 6, 98, 111},
+    {11, 6, 98, 111},
+    {11, 6, 98, 115},
+    {11, 6, 98, 115},
+    {11, 6, 98, 116},
+    {11, 6, 98, 116},
+    {12, 6, 98, 32},
+    {12, 6, 98, 37},
+    {12, 6, 98, 45},
+    {12, 6, 98, 46},
+    {12, 6, 98, 47},
+    {12, 6, 98, 51},
+    {12, 6, 98, 52},
+    {12, 6, 98, 53},
+    {12, 6, 98, 54},
+    {12, 6, 98, 55},
+    {12, 6, 98, 56},
+    {12, 6, 98, 57},
+    {12, 6, 98, 61},
+    {12, 6, 98, 65},
+    {12, 6, 98, 95},
+    {12, 6, 98, 98},
+    {12, 6, 98, 100},
+    {12, 6, 98, 102},
+    {12, 6, 98, 103},
+    {12, 6, 98, 104},
+    {12, 6, 98, 108},
+    {12, 6, 98, 109},
+    {12, 6, 98, 110},
+    {12, 6, 98, 112},
+    {12, 6, 98, 114},
+    {12, 6, 98, 117},
+    {6, 6, 98, 0},
+    {6, 6, 98, 0},
+    {6, 6, 98, 0},
+    {6, 6, 98, 0},
+    {6, 6, 98, 0},
+    {6, 6, 98, 0},
+    {6, 6, 98, 0},
+    {6, 6, 98, 0},
+    {6, 6, 98, 0},
+    {6, 6, 98, 0},
+    {6, 6, 98, 0},
+    {6, 6, 98, 0},
+    {6, 6, 98, 0},
+    {6, 6, 98, 0},
+    {6, 6, 98, 0},
+    {6, 6, 98, 0},
+    {6, 6, 98, 0},
+    {6, 6, 98, 0},
+    {11, 6, 100, 48},
+    {11, 6, 100, 48},
+    {11, 6, 100, 49},
+    {11, 6, 100, 49},
+    {11, 6, 100, 50},
+    {11, 6, 100, 50},
+    {11, 6, 100, 97},
+    {11, 6, 100, 97},
+    {11, 6, 100, 99},
+    {11, 6, 100, 99},
+    {11, 6, 100, 101},
+    {11, 6, 100, 101},
+    {11, 6, 100, 105},
+    {11, 6, 100, 105},
+    {11, 6, 100, 111},
+    {11, 6, 100, 111},
+    {11, 6, 100, 115},
+    {11, 6, 100, 115},
+    {11, 6, 100, 116},
+    {11, 6, 100, 116},
+    {12, 6, 100, 32},
+    {12, 6, 100, 37},
+    {12, 6, 100, 45},
+    {12, 6, 100, 46},
+    {12, 6, 100, 47},
+    {12, 6, 100, 51},
+    {12, 6, 100, 52},
+    {12, 6, 100, 53},
+    {12, 6, 100, 54},
+    {12, 6, 100, 55},
+    {12, 6, 100, 56},
+    {12, 6, 100, 57},
+    {12, 6, 100, 61},
+    {12, 6, 100, 65},
+    {12, 6, 100, 95},
+    {12, 6, 100, 98},
+    {12, 6, 100, 100},
+    {12, 6, 100, 102},
+    {12, 6, 100, 103},
+    {12, 6, 100, 104},
+    {12, 6, 100, 108},
+    {12, 6, 100, 109},
+    {12, 6, 100, 110},
+    {12, 6, 100, 112},
+    {12, 6, 100, 114},
+    {12, 6, 100, 117},
+    {6, 6, 100, 0},
+    {6, 6, 100, 0},
+    {6, 6, 100, 0},
+    {6, 6, 100, 0},
+    {6, 6, 100, 0},
+    {6, 6, 100, 0},
+    {6, 6, 100, 0},
+    {6, 6, 100, 0},
+    {6, 6, 100, 0},
+    {6, 6, 100, 0},
+    {6, 6, 100, 0},
+    {6, 6, 100, 0},
+    {6, 6, 100, 0},
+    {6, 6, 100, 0},
+    {6, 6, 100, 0},
+    {6, 6, 100, 0},
+    {6, 6, 100, 0},
+    {6, 6, 100, 0},
+    {11, 6, 102, 48},
+    {11, 6, 102, 48},
+    {11, 6, 102, 49},
+    {11, 6, 102, 49},
+    {11, 6, 102, 50},
+    {11, 6, 102, 50},
+    {11, 6, 102, 97},
+    {11, 6, 102, 97},
+    {11, 6, 102, 99},
+    {11, 6, 102, 99},
+    {11, 6, 102, 101},
+    {11, 6, 102, 101},
+    {11, 6, 102, 105},
+    {11, 6, 102, 105},
+    {11, 6, 102, 111},
+    {11, 6, 102, 111},
+    {11, 6, 102, 115},
+    {11, 6, 102, 115},
+    {11, 6, 102, 116},
+    {11, 6, 102, 116},
+    {12, 6, 102, 32},
+    {12, 6, 102, 37},
+    {12, 6, 102, 45},
+    {12, 6, 102, 46},
+    {12, 6, 102, 47},
+    {12, 6, 102, 51},
+    {12, 6, 102, 52},
+    {12, 6, 102, 53},
+    {12, 6, 102, 54},
+    {12, 6, 102, 55},
+    {12, 6, 102, 56},
+    {12, 6, 102, 57},
+    {12, 6, 102, 61},
+    {12, 6, 102, 65},
+    {12, 6, 102, 95},
+    {12, 6, 102, 98},
+    {12, 6, 102, 100},
+    {12, 6, 102, 102},
+    {12, 6, 102, 103},
+    {12, 6, 102, 104},
+    {12, 6, 102, 108},
+    {12, 6, 102, 109},
+    {12, 6, 102, 110},
+    {12, 6, 102, 112},
+    {12, 6, 102, 114},
+    {12, 6, 102, 117},
+    {6, 6, 102, 0},
+    {6, 6, 102, 0},
+    {6, 6, 102, 0},
+    {6, 6, 102, 0},
+    {6, 6, 102, 0},
+    {6, 6, 102, 0},
+    {6, 6, 102, 0},
+    {6, 6, 102, 0},
+    {6, 6, 102, 0},
+    {6, 6, 102, 0},
+    {6, 6, 102, 0},
+    {6, 6, 102, 0},
+    {6, 6, 102, 0},
+    {6, 6, 102, 0},
+    {6, 6, 102, 0},
+    {6, 6, 102, 0},
+    {6, 6, 102, 0},
+    {6, 6, 102, 0},
+    {11, 6, 103, 48},
+    {11, 6, 103, 48},
+    {11, 6, 103, 49},
+    {11, 6, 103, 49},
+    {11, 6, 103, 50},
+    {11, 6, 103, 50},
+    {11, 6, 103, 97},
+    {11, 6, 103, 97},
+    {11, 6, 103, 99},
+    {11, 6, 103, 99},
+    {11, 6, 103, 101},
+    {11, 6, 103, 101},
+    {11, 6, 103, 105},
+    {11, 6, 103, 105},
+    {11, 6, 103, 111},
+    {11, 6, 103, 111},
+    {11, 6, 103, 115},
+    {11, 6, 103, 115},
+    {11, 6, 103, 116},
+    {11, 6, 103, 116},
+    {12, 6, 103, 32},
+    {12, 6, 103, 37},
+    {12, 6, 103, 45},
+    {12, 6, 103, 46},
+    {12, 6, 103, 47},
+    {12, 6, 103, 51},
+    {12, 6, 103, 52},
+    {12, 6, 103, 53},
+    {12, 6, 103, 54},
+    {12, 6, 103, 55},
+    {12, 6, 103, 56},
+    {12, 6, 103, 57},
+    {12, 6, 103, 61},
+    {12, 6, 103, 65},
+    {12, 6, 103, 95},
+    {12, 6, 103, 98},
+    {12, 6, 103, 100},
+    {12, 6, 103, 102},
+    {12, 6, 103, 103},
+    {12, 6, 103, 104},
+    {12, 6, 103, 108},
+    {12, 6, 103, 109},
+    {12, 6, 103, 110},
+    {12, 6, 103, 112},
+    {12, 6, 103, 114},
+    {12, 6, 103, 117},
+    {6, 6, 103, 0},
+    {6, 6, 103, 0},
+    {6, 6, 103, 0},
+    {6, 6, 103, 0},
+    {6, 6, 103, 0},
+    {6, 6, 103, 0},
+    {6, 6, 103, 0},
+    {6, 6, 103, 0},
+    {6, 6, 103, 0},
+    {6, 6, 103, 0},
+    {6, 6, 103, 0},
+    {6, 6, 103, 0},
+    {6, 6, 103, 0},
+    {6, 6, 103, 0},
+    {6, 6, 103, 0},
+    {6, 6, 103, 0},
+    {6, 6, 103, 0},
+    {6, 6, 103, 0},
+    {11, 6, 104, 48},
+    {11, 6, 104, 48},
+    {11, 6, 104, 49},
+    {11, 6, 104, 49},
+    {11, 6, 104, 50},
+    {11, 6, 104, 50},
+    {11, 6, 104, 97},
+    {11, 6, 104, 97},
+    {11, 6, 104, 99},
+    {11, 6, 104, 99},
+    {11, 6, 104, 101},
+    {11, 6, 104, 101},
+    {11, 6, 104, 105},
+    {11, 6, 104, 105},
+    {11, 6, 104, 111},
+    {11, 6, 104, 111},
+    {11, 6, 104, 115},
+    {11, 6, 104, 115},
+    {11, 6, 104, 116},
+    {11, 6, 104, 116},
+    {12, 6, 104, 32},
+    {12, 6, 104, 37},
+    {12, 6, 104, 45},
+    {12, 6, 104, 46},
+    {12, 6, 104, 47},
+    {12, 6, 104, 51},
+    {12, 6, 104, 52},
+    {12, 6, 104, 53},
+    {12, 6, 104, 54},
+    {12, 6, 104, 55},
+    {12, 6, 104, 56},
+    {12, 6, 104, 57},
+    {12, 6, 104, 61},
+    {12, 6, 104, 65},
+    {12, 6, 104, 95},
+    {12, 6, 104, 98},
+    {12, 6, 104, 100},
+    {12, 6, 104, 102},
+    {12, 6, 104, 103},
+    {12, 6, 104, 104},
+    {12, 6, 104, 108},
+    {12, 6, 104, 109},
+    {12, 6, 104, 110},
+    {12, 6, 104, 112},
+    {12, 6, 104, 114},
+    {12, 6, 104, 117},
+    {6, 6, 104, 0},
+    {6, 6, 104, 0},
+    {6, 6, 104, 0},
+    {6, 6, 104, 0},
+    {6, 6, 104, 0},
+    {6, 6, 104, 0},
+    {6, 6, 104, 0},
+    {6, 6, 104, 0},
+    {6, 6, 104, 0},
+    {6, 6, 104, 0},
+    {6, 6, 104, 0},
+    {6, 6, 104, 0},
+    {6, 6, 104, 0},
+    {6, 6, 104, 0},
+    {6, 6, 104, 0},
+    {6, 6, 104, 0},
+    {6, 6, 104, 0},
+    {6, 6, 104, 0},
+    {11, 6, 108, 48},
+    {11, 6, 108, 48},
+    {11, 6, 108, 49},
+    {11, 6, 108, 49},
+    {11, 6, 108, 50},
+    {11, 6, 108, 50},
+    {11, 6, 108, 97},
+    {11, 6, 108, 97},
+    {11, 6, 108, 99},
+    {11, 6, 108, 99},
+    {11, 6, 108, 101},
+    {11, 6, 108, 101},
+    {11, 6, 108, 105},
+    {11, 6, 108, 105},
+    {11, 6, 108, 111},
+    {11, 6, 108, 111},
+    {11, 6, 108, 115},
+    {11, 6, 108, 115},
+    {11, 6, 108, 116},
+    {11, 6, 108, 116},
+    {12, 6, 108, 32},
+    {12, 6, 108, 37},
+    {12, 6, 108, 45},
+    {12, 6, 108, 46},
+    {12, 6, 108, 47},
+    {12, 6, 108, 51},
+    {12, 6, 108, 52},
+    {12, 6, 108, 53},
+    {12, 6, 108, 54},
+    {12, 6, 108, 55},
+    {12, 6, 108, 56},
+    {12, 6, 108, 57},
+    {12, 6, 108, 61},
+    {12, 6, 108, 65},
+    {12, 6, 108, 95},
+    {12, 6, 108, 98},
+    {12, 6, 108, 100},
+    {12, 6, 108, 102},
+    {12, 6, 108, 103},
+    {12, 6, 108, 104},
+    {12, 6, 108, 108},
+    {12, 6, 108, 109},
+    {12, 6, 108, 110},
+    {12, 6, 108, 112},
+    {12, 6, 108, 114},
+    {12, 6, 108, 117},
+    {6, 6, 108, 0},
+    {6, 6, 108, 0},
+    {6, 6, 108, 0},
+    {6, 6, 108, 0},
+    {6, 6, 108, 0},
+    {6, 6, 108, 0},
+    {6, 6, 108, 0},
+    {6, 6, 108, 0},
+    {6, 6, 108, 0},
+    {6, 6, 108, 0},
+    {6, 6, 108, 0},
+    {6, 6, 108, 0},
+    {6, 6, 108, 0},
+    {6, 6, 108, 0},
+    {6, 6, 108, 0},
+    {6, 6, 108, 0},
+    {6, 6, 108, 0},
+    {6, 6, 108, 0},
+    {11, 6, 109, 48},
+    {11, 6, 109, 48},
+    {11, 6, 109, 49},
+    {11, 6, 109, 49},
+    {11, 6, 109, 50},
+    {11, 6, 109, 50},
+    {11, 6, 109, 97},
+    {11, 6, 109, 97},
+    {11, 6, 109, 99},
+    {11, 6, 109, 99},
+    {11, 6, 109, 101},
+    {11, 6, 109, 101},
+    {11, 6, 109, 105},
+    {11, 6, 109, 105},
+    {11, 6, 109, 111},
+    {11, 6, 109, 111},
+    {11, 6, 109, 115},
+    {11, 6, 109, 115},
+    {11, 6, 109, 116},
+    {11, 6, 109, 116},
+    {12, 6, 109, 32},
+    {12, 6, 109, 37},
+    {12, 6, 109, 45},
+    {12, 6, 109, 46},
+    {12, 6, 109, 47},
+    {12, 6, 109, 51},
+    {12, 6, 109, 52},
+    {12, 6, 109, 53},
+    {12, 6, 109, 54},
+    {12, 6, 109, 55},
+    {12, 6, 109, 56},
+    {12, 6, 109, 57},
+    {12, 6, 109, 61},
+    {12, 6, 109, 65},
+    {12, 6, 109, 95},
+    {12, 6, 109, 98},
+    {12, 6, 109, 100},
+    {12, 6, 109, 102},
+    {12, 6, 109, 103},
+    {12, 6, 109, 104},
+    {12, 6, 109, 108},
+    {12, 6, 109, 109},
+    {12, 6, 109, 110},
+    {12, 6, 109, 112},
+    {12, 6, 109, 114},
+    {12, 6, 109, 117},
+    {6, 6, 109, 0},
+    {6, 6, 109, 0},
+    {6, 6, 109, 0},
+    {6, 6, 109, 0},
+    {6, 6, 109, 0},
+    {6, 6, 109, 0},
+    {6, 6, 109, 0},
+    {6, 6, 109, 0},
+    {6, 6, 109, 0},
+    {6, 6, 109, 0},
+    {6, 6, 109, 0},
+    {6, 6, 109, 0},
+    {6, 6, 109, 0},
+    {6, 6, 109, 0},
+    {6, 6, 109, 0},
+    {6, 6, 109, 0},
+    {6, 6, 109, 0},
+    {6, 6, 109, 0},
+    {11, 6, 110, 48},
+    {11, 6, 110, 48},
+    {11, 6, 110, 49},
+    {11, 6, 110, 49},
+    {11, 6, 110, 50},
+    {11, 6, 110, 50},
+    {11, 6, 110, 97},
+    {11, 6, 110, 97},
+    {11, 6, 110, 99},
+    {11, 6, 110, 99},
+    {11, 6, 110, 101},
+    {11, 6, 110, 101},
+    {11, 6, 110, 105},
+    {11, 6, 110, 105},
+    {11, 6, 110, 111},
+    {11, 6, 110, 111},
+    {11, 6, 110, 115},
+    {11, 6, 110, 115},
+    {11, 6, 110, 116},
+    {11, 6, 110, 116},
+    {12, 6, 110, 32},
+    {12, 6, 110, 37},
+    {12, 6, 110, 45},
+    {12, 6, 110, 46},
+    {12, 6, 110, 47},
+    {12, 6, 110, 51},
+    {12, 6, 110, 52},
+    {12, 6, 110, 53},
+    {12, 6, 110, 54},
+    {12, 6, 110, 55},
+    {12, 6, 110, 56},
+    {12, 6, 110, 57},
+    {12, 6, 110, 61},
+    {12, 6, 110, 65},
+    {12, 6, 110, 95},
+    {12, 6, 110, 98},
+    {12, 6, 110, 100},
+    {12, 6, 110, 102},
+    {12, 6, 110, 103},
+    {12, 6, 110, 104},
+    {12, 6, 110, 108},
+    {12, 6, 110, 109},
+    {12, 6, 110, 110},
+    {12, 6, 110, 112},
+    {12, 6, 110, 114},
+    {12, 6, 110, 117},
+    {6, 6, 110, 0},
+    {6, 6, 110, 0},
+    {6, 6, 110, 0},
+    {6, 6, 110, 0},
+    {6, 6, 110, 0},
+    {6, 6, 110, 0},
+    {6, 6, 110, 0},
+    {6, 6, 110, 0},
+    {6, 6, 110, 0},
+    {6, 6, 110, 0},
+    {6, 6, 110, 0},
+    {6, 6, 110, 0},
+    {6, 6, 110, 0},
+    {6, 6, 110, 0},
+    {6, 6, 110, 0},
+    {6, 6, 110, 0},
+    {6, 6, 110, 0},
+    {6, 6, 110, 0},
+    {11, 6, 112, 48},
+    {11, 6, 112, 48},
+    {11, 6, 112, 49},
+    {11, 6, 112, 49},
+    {11, 6, 112, 50},
+    {11, 6, 112, 50},
+    {11, 6, 112, 97},
+    {11, 6, 112, 97},
+    {11, 6, 112, 99},
+    {11, 6, 112, 99},
+    {11, 6, 112, 101},
+    {11, 6, 112, 101},
+    {11, 6, 112, 105},
+    {11, 6, 112, 105},
+    {11, 6, 112, 111},
+    {11, 6, 112, 111},
+    {11, 6, 112, 115},
+    {11, 6, 112, 115},
+    {11, 6, 112, 116},
+    {11, 6, 112, 116},
+    {12, 6, 112, 32},
+    {12, 6, 112, 37},
+    {12, 6, 112, 45},
+    {12, 6, 112, 46},
+    {12, 6, 112, 47},
+    {12, 6, 112, 51},
+    {12, 6, 112, 52},
+    {12, 6, 112, 53},
+    {12, 6, 112, 54},
+    {12, 6, 112, 55},
+    {12, 6, 112, 56},
+    {12, 6, 112, 57},
+    {12, 6, 112, 61},
+    {12, 6, 112, 65},
+    {12, 6, 112, 95},
+    {12, 6, 112, 98},
+    {12, 6, 112, 100},
+    {12, 6, 112, 102},
+    {12, 6, 112, 103},
+    {12, 6, 112, 104},
+    {12, 6, 112, 108},
+    {12, 6, 112, 109},
+    {12, 6, 112, 110},
+    {12, 6, 112, 112},
+    {12, 6, 112, 114},
+    {12, 6, 112, 117},
+    {6, 6, 112, 0},
+    {6, 6, 112, 0},
+    {6, 6, 112, 0},
+    {6, 6, 112, 0},
+    {6, 6, 112, 0},
+    {6, 6, 112, 0},
+    {6, 6, 112, 0},
+    {6, 6, 112, 0},
+    {6, 6, 112, 0},
+    {6, 6, 112, 0},
+    {6, 6, 112, 0},
+    {6, 6, 112, 0},
+    {6, 6, 112, 0},
+    {6, 6, 112, 0},
+    {6, 6, 112, 0},
+    {6, 6, 112, 0},
+    {6, 6, 112, 0},
+    {6, 6, 112, 0},
+    {11, 6, 114, 48},
+    {11, 6, 114, 48},
+    {11, 6, 114, 49},
+    {11, 6, 114, 49},
+    {11, 6, 114, 50},
+    {11, 6, 114, 50},
+    {11, 6, 114, 97},
+    {11, 6, 114, 97},
+    {11, 6, 114, 99},
+    {11, 6, 114, 99},
+    {11, 6, 114, 101},
+    {11, 6, 114, 101},
+    {11, 6, 114, 105},
+    {11, 6, 114, 105},
+    {11, 6, 114, 111},
+    {11, 6, 114, 111},
+    {11, 6, 114, 115},
+    {11, 6, 114, 115},
+    {11, 6, 114, 116},
+    {11, 6, 114, 116},
+    {12, 6, 114, 32},
+    {12, 6, 114, 37},
+    {12, 6, 114, 45},
+    {12, 6, 114, 46},
+    {12, 6, 114, 47},
+    {12, 6, 114, 51},
+    {12, 6, 114, 52},
+    {12, 6, 114, 53},
+    {12, 6, 114, 54},
+    {12, 6, 114, 55},
+    {12, 6, 114, 56},
+    {12, 6, 114, 57},
+    {12, 6, 114, 61},
+    {12, 6, 114, 65},
+    {12, 6, 114, 95},
+    {12, 6, 114, 98},
+    {12, 6, 114, 100},
+    {12, 6, 114, 102},
+    {12, 6, 114, 103},
+    {12, 6, 114, 104},
+    {12, 6, 114, 108},
+    {12, 6, 114, 109},
+    {12, 6, 114, 110},
+    {12, 6, 114, 112},
+    {12, 6, 114, 114},
+    {12, 6, 114, 117},
+    {6, 6, 114, 0},
+    {6, 6, 114, 0},
+    {6, 6, 114, 0},
+    {6, 6, 114, 0},
+    {6, 6, 114, 0},
+    {6, 6, 114, 0},
+    {6, 6, 114, 0},
+    {6, 6, 114, 0},
+    {6, 6, 114, 0},
+    {6, 6, 114, 0},
+    {6, 6, 114, 0},
+    {6, 6, 114, 0},
+    {6, 6, 114, 0},
+    {6, 6, 114, 0},
+    {6, 6, 114, 0},
+    {6, 6, 114, 0},
+    {6, 6, 114, 0},
+    {6, 6, 114, 0},
+    {11, 6, 117, 48},
+    {11, 6, 117, 48},
+    {11, 6, 117, 49},
+    {11, 6, 117, 49},
+    {11, 6, 117, 50},
+    {11, 6, 117, 50},
+    {11, 6, 117, 97},
+    {11, 6, 117, 97},
+    {11, 6, 117, 99},
+    {11, 6, 117, 99},
+    {11, 6, 117, 101},
+    {11, 6, 117, 101},
+    {11, 6, 117, 105},
+    {11, 6, 117, 105},
+    {11, 6, 117, 111},
+    {11, 6, 117, 111},
+    {11, 6, 117, 115},
+    {11, 6, 117, 115},
+    {11, 6, 117, 116},
+    {11, 6, 117, 116},
+    {12, 6, 117, 32},
+    {12, 6, 117, 37},
+    {12, 6, 117, 45},
+    {12, 6, 117, 46},
+    {12, 6, 117, 47},
+    {12, 6, 117, 51},
+    {12, 6, 117, 52},
+    {12, 6, 117, 53},
+    {12, 6, 117, 54},
+    {12, 6, 117, 55},
+    {12, 6, 117, 56},
+    {12, 6, 117, 57},
+    {12, 6, 117, 61},
+    {12, 6, 117, 65},
+    {12, 6, 117, 95},
+    {12, 6, 117, 98},
+    {12, 6, 117, 100},
+    {12, 6, 117, 102},
+    {12, 6, 117, 103},
+    {12, 6, 117, 104},
+    {12, 6, 117, 108},
+    {12, 6, 117, 109},
+    {12, 6, 117, 110},
+    {12, 6, 117, 112},
+    {12, 6, 117, 114},
+    {12, 6, 117, 117},
+    {6, 6, 117, 0},
+    {6, 6, 117, 0},
+    {6, 6, 117, 0},
+    {6, 6, 117, 0},
+    {6, 6, 117, 0},
+    {6, 6, 117, 0},
+    {6, 6, 117, 0},
+    {6, 6, 117, 0},
+    {6, 6, 117, 0},
+    {6, 6, 117, 0},
+    {6, 6, 117, 0},
+    {6, 6, 117, 0},
+    {6, 6, 117, 0},
+    {6, 6, 117, 0},
+    {6, 6, 117, 0},
+    {6, 6, 117, 0},
+    {6, 6, 117, 0},
+    {6, 6, 117, 0},
+    {12, 7, 58, 48},
+    {12, 7, 58, 49},
+    {12, 7, 58, 50},
+    {12, 7, 58, 97},
+    {12, 7, 58, 99},
+    {12, 7, 58, 101},
+    {12, 7, 58, 105},
+    {12, 7, 58, 111},
+    {12, 7, 58, 115},
+    {12, 7, 58, 116},
+    {7, 7, 58, 0},
+    {7, 7, 58, 0},
+    {7, 7, 58, 0},
+    {7, 7, 58, 0},
+    {7, 7, 58, 0},
+    {7, 7, 58, 0},
+    {7, 7, 58, 0},
+    {7, 7, 58, 0},
+    {7, 7, 58, 0},
+    {7, 7, 58, 0},
+    {7, 7, 58, 0},
+    {7, 7, 58, 0},
+    {7, 7, 58, 0},
+    {7, 7, 58, 0},
+    {7, 7, 58, 0},
+    {7, 7, 58, 0},
+    {7, 7, 58, 0},
+    {7, 7, 58, 0},
+    {7, 7, 58, 0},
+    {7, 7, 58, 0},
+    {7, 7, 58, 0},
+    {7, 7, 58, 0},
+    {12, 7, 66, 48},
+    {12, 7, 66, 49},
+    {12, 7, 66, 50},
+    {12, 7, 66, 97},
+    {12, 7, 66, 99},
+    {12, 7, 66, 101},
+    {12, 7, 66, 105},
+    {12, 7, 66, 111},
+    {12, 7, 66, 115},
+    {12, 7, 66, 116},
+    {7, 7, 66, 0},
+    {7, 7, 66, 0},
+    {7, 7, 66, 0},
+    {7, 7, 66, 0},
+    {7, 7, 66, 0},
+    {7, 7, 66, 0},
+    {7, 7, 66, 0},
+    {7, 7, 66, 0},
+    {7, 7, 66, 0},
+    {7, 7, 66, 0},
+    {7, 7, 66, 0},
+    {7, 7, 66, 0},
+    {7, 7, 66, 0},
+    {7, 7, 66, 0},
+    {7, 7, 66, 0},
+    {7, 7, 66, 0},
+    {7, 7, 66, 0},
+    {7, 7, 66, 0},
+    {7, 7, 66, 0},
+    {7, 7, 66, 0},
+    {7, 7, 66, 0},
+    {7, 7, 66, 0},
+    {12, 7, 67, 48},
+    {12, 7, 67, 49},
+    {12, 7, 67, 50},
+    {12, 7, 67, 97},
+    {12, 7, 67, 99},
+    {12, 7, 67, 101},
+    {12, 7, 67, 105},
+    {12, 7, 67, 111},
+    {12, 7, 67, 115},
+    {12, 7, 67, 116},
+    {7, 7, 67, 0},
+    {7, 7, 67, 0},
+    {7, 7, 67, 0},
+    {7, 7, 67, 0},
+    {7, 7, 67, 0},
+    {7, 7, 67, 0},
+    {7, 7, 67, 0},
+    {7, 7, 67, 0},
+    {7, 7, 67, 0},
+    {7, 7, 67, 0},
+    {7, 7, 67, 0},
+    {7, 7, 67, 0},
+    {7, 7, 67, 0},
+    {7, 7, 67, 0},
+    {7, 7, 67, 0},
+    {7, 7, 67, 0},
+    {7, 7, 67, 0},
+    {7, 7, 67, 0},
+    {7, 7, 67, 0},
+    {7, 7, 67, 0},
+    {7, 7, 67, 0},
+    {7, 7, 67, 0},
+    {12, 7, 68, 48},
+    {12, 7, 68, 49},
+    {12, 7, 68, 50},
+    {12, 7, 68, 97},
+    {12, 7, 68, 99},
+    {12, 7, 68, 101},
+    {12, 7, 68, 105},
+    {12, 7, 68, 111},
+    {12, 7, 68, 115},
+    {12, 7, 68, 116},
+    {7, 7, 68, 0},
+    {7, 7, 68, 0},
+    {7, 7, 68, 0},
+    {7, 7, 68, 0},
+    {7, 7, 68, 0},
+    {7, 7, 68, 0},
+    {7, 7, 68, 0},
+    {7, 7, 68, 0},
+    {7, 7, 68, 0},
+    {7, 7, 68, 0},
+    {7, 7, 68, 0},
+    {7, 7, 68, 0},
+    {7, 7, 68, 0},
+    {7, 7, 68, 0},
+    {7, 7, 68, 0},
+    {7, 7, 68, 0},
+    {7, 7, 68, 0},
+    {7, 7, 68, 0},
+    {7, 7, 68, 0},
+    {7, 7, 68, 0},
+    {7, 7, 68, 0},
+    {7, 7, 68, 0},
+    {12, 7, 69, 48},
+    {12, 7, 69, 49},
+    {12, 7, 69, 50},
+    {12, 7, 69, 97},
+    {12, 7, 69, 99},
+    {12, 7, 69, 101},
+    {12, 7, 69, 105},
+    {12, 7, 69, 111},
+    {12, 7, 69, 115},
+    {12, 7, 69, 116},
+    {7, 7, 69, 0},
+    {7, 7, 69, 0},
+    {7, 7, 69, 0},
+    {7, 7, 69, 0},
+    {7, 7, 69, 0},
+    {7, 7, 69, 0},
+    {7, 7, 69, 0},
+    {7, 7, 69, 0},
+    {7, 7, 69, 0},
+    {7, 7, 69, 0},
+    {7, 7, 69, 0},
+    {7, 7, 69, 0},
+    {7, 7, 69, 0},
+    {7, 7, 69, 0},
+    {7, 7, 69, 0},
+    {7, 7, 69, 0},
+    {7, 7, 69, 0},
+    {7, 7, 69, 0},
+    {7, 7, 69, 0},
+    {7, 7, 69, 0},
+    {7, 7, 69, 0},
+    {7, 7, 69, 0},
+    {12, 7, 70, 48},
+    {12, 7, 70, 49},
+    {12, 7, 70, 50},
+    {12, 7, 70, 97},
+    {12, 7, 70, 99},
+    {12, 7, 70, 101},
+    {12, 7, 70, 105},
+    {12, 7, 70, 111},
+    {12, 7, 70, 115},
+    {12, 7, 70, 116},
+    {7, 7, 70, 0},
+    {7, 7, 70, 0},
+    {7, 7, 70, 0},
+    {7, 7, 70, 0},
+    {7, 7, 70, 0},
+    {7, 7, 70, 0},
+    {7, 7, 70, 0},
+    {7, 7, 70, 0},
+    {7, 7, 70, 0},
+    {7, 7, 70, 0},
+    {7, 7, 70, 0},
+    {7, 7, 70, 0},
+    {7, 7, 70, 0},
+    {7, 7, 70, 0},
+    {7, 7, 70, 0},
+    {7, 7, 70, 0},
+    {7, 7, 70, 0},
+    {7, 7, 70, 0},
+    {7, 7, 70, 0},
+    {7, 7, 70, 0},
+    {7, 7, 70, 0},
+    {7, 7, 70, 0},
+    {12, 7, 71, 48},
+    {12, 7, 71, 49},
+    {12, 7, 71, 50},
+    {12, 7, 71, 97},
+    {12, 7, 71, 99},
+    {12, 7, 71, 101},
+    {12, 7, 71, 105},
+    {12, 7, 71, 111},
+    {12, 7, 71, 115},
+    {12, 7, 71, 116},
+    {7, 7, 71, 0},
+    {7, 7, 71, 0},
+    {7, 7, 71, 0},
+    {7, 7, 71, 0},
+    {7, 7, 71, 0},
+    {7, 7, 71, 0},
+    {7, 7, 71, 0},
+    {7, 7, 71, 0},
+    {7, 7, 71, 0},
+    {7, 7, 71, 0},
+    {7, 7, 71, 0},
+    {7, 7, 71, 0},
+    {7, 7, 71, 0},
+    {7, 7, 71, 0},
+    {7, 7, 71, 0},
+    {7, 7, 71, 0},
+    {7, 7, 71, 0},
+    {7, 7, 71, 0},
+    {7, 7, 71, 0},
+    {7, 7, 71, 0},
+    {7, 7, 71, 0},
+    {7, 7, 71, 0},
+    {12, 7, 72, 48},
+    {12, 7, 72, 49},
+    {12, 7, 72, 50},
+    {12, 7, 72, 97},
+    {12, 7, 72, 99},
+    {12, 7, 72, 101},
+    {12, 7, 72, 105},
+    {12, 7, 72, 111},
+    {12, 7, 72, 115},
+    {12, 7, 72, 116},
+    {7, 7, 72, 0},
+    {7, 7, 72, 0},
+    {7, 7, 72, 0},
+    {7, 7, 72, 0},
+    {7, 7, 72, 0},
+    {7, 7, 72, 0},
+    {7, 7, 72, 0},
+    {7, 7, 72, 0},
+    {7, 7, 72, 0},
+    {7, 7, 72, 0},
+    {7, 7, 72, 0},
+    {7, 7, 72, 0},
+    {7, 7, 72, 0},
+    {7, 7, 72, 0},
+    {7, 7, 72, 0},
+    {7, 7, 72, 0},
+    {7, 7, 72, 0},
+    {7, 7, 72, 0},
+    {7, 7, 72, 0},
+    {7, 7, 72, 0},
+    {7, 7, 72, 0},
+    {7, 7, 72, 0},
+    {12, 7, 73, 48},
+    {12, 7, 73, 49},
+    {12, 7, 73, 50},
+    {12, 7, 73, 97},
+    {12, 7, 73, 99},
+    {12, 7, 73, 101},
+    {12, 7, 73, 105},
+    {12, 7, 73, 111},
+    {12, 7, 73, 115},
+    {12, 7, 73, 116},
+    {7, 7, 73, 0},
+    {7, 7, 73, 0},
+    {7, 7, 73, 0},
+    {7, 7, 73, 0},
+    {7, 7, 73, 0},
+    {7, 7, 73, 0},
+    {7, 7, 73, 0},
+    {7, 7, 73, 0},
+    {7, 7, 73, 0},
+    {7, 7, 73, 0},
+    {7, 7, 73, 0},
+    {7, 7, 73, 0},
+    {7, 7, 73, 0},
+    {7, 7, 73, 0},
+    {7, 7, 73, 0},
+    {7, 7, 73, 0},
+    {7, 7, 73, 0},
+    {7, 7, 73, 0},
+    {7, 7, 73, 0},
+    {7, 7, 73, 0},
+    {7, 7, 73, 0},
+    {7, 7, 73, 0},
+    {12, 7, 74, 48},
+    {12, 7, 74, 49},
+    {12, 7, 74, 50},
+    {12, 7, 74, 97},
+    {12, 7, 74, 99},
+    {12, 7, 74, 101},
+    {12, 7, 74, 105},
+    {12, 7, 74, 111},
+    {12, 7, 74, 115},
+    {12, 7, 74, 116},
+    {7, 7, 74, 0},
+    {7, 7, 74, 0},
+    {7, 7, 74, 0},
+    {7, 7, 74, 0},
+    {7, 7, 74, 0},
+    {7, 7, 74, 0},
+    {7, 7, 74, 0},
+    {7, 7, 74, 0},
+    {7, 7, 74, 0},
+    {7, 7, 74, 0},
+    {7, 7, 74, 0},
+    {7, 7, 74, 0},
+    {7, 7, 74, 0},
+    {7, 7, 74, 0},
+    {7, 7, 74, 0},
+    {7, 7, 74, 0},
+    {7, 7, 74, 0},
+    {7, 7, 74, 0},
+    {7, 7, 74, 0},
+    {7, 7, 74, 0},
+    {7, 7, 74, 0},
+    {7, 7, 74, 0},
+    {12, 7, 75, 48},
+    {12, 7, 75, 49},
+    {12, 7, 75, 50},
+    {12, 7, 75, 97},
+    {12, 7, 75, 99},
+    {12, 7, 75, 101},
+    {12, 7, 75, 105},
+    {12, 7, 75, 111},
+    {12, 7, 75, 115},
+    {12, 7, 75, 116},
+    {7, 7, 75, 0},
+    {7, 7, 75, 0},
+    {7, 7, 75, 0},
+    {7, 7, 75, 0},
+    {7, 7, 75, 0},
+    {7, 7, 75, 0},
+    {7, 7, 75, 0},
+    {7, 7, 75, 0},
+    {7, 7, 75, 0},
+    {7, 7, 75, 0},
+    {7, 7, 75, 0},
+    {7, 7, 75, 0},
+    {7, 7, 75, 0},
+    {7, 7, 75, 0},
+    {7, 7, 75, 0},
+    {7, 7, 75, 0},
+    {7, 7, 75, 0},
+    {7, 7, 75, 0},
+    {7, 7, 75, 0},
+    {7, 7, 75, 0},
+    {7, 7, 75, 0},
+    {7, 7, 75, 0},
+    {12, 7, 76, 48},
+    {12, 7, 76, 49},
+    {12, 7, 76, 50},
+    {12, 7, 76, 97},
+    {12, 7, 76, 99},
+    {12, 7, 76, 101},
+    {12, 7, 76, 105},
+    {12, 7, 76, 111},
+    {12, 7, 76, 115},
+    {12, 7, 76, 116},
+    {7, 7, 76, 0},
+    {7, 7, 76, 0},
+    {7, 7, 76, 0},
+    {7, 7, 76, 0},
+    {7, 7, 76, 0},
+    {7, 7, 76, 0},
+    {7, 7, 76, 0},
+    {7, 7, 76, 0},
+    {7, 7, 76, 0},
+    {7, 7, 76, 0},
+    {7, 7, 76, 0},
+    {7, 7, 76, 0},
+    {7, 7, 76, 0},
+    {7, 7, 76, 0},
+    {7, 7, 76, 0},
+    {7, 7, 76, 0},
+    {7, 7, 76, 0},
+    {7, 7, 76, 0},
+    {7, 7, 76, 0},
+    {7, 7, 76, 0},
+    {7, 7, 76, 0},
+    {7, 7, 76, 0},
+    {12, 7, 77, 48},
+    {12, 7, 77, 49},
+    {12, 7, 77, 50},
+    {12, 7, 77, 97},
+    {12, 7, 77, 99},
+    {12, 7, 77, 101},
+    {12, 7, 77, 105},
+    {12, 7, 77, 111},
+    {12, 7, 77, 115},
+    {12, 7, 77, 116},
+    {7, 7, 77, 0},
+    {7, 7, 77, 0},
+    {7, 7, 77, 0},
+    {7, 7, 77, 0},
+    {7, 7, 77, 0},
+    {7, 7, 77, 0},
+    {7, 7, 77, 0},
+    {7, 7, 77, 0},
+    {7, 7, 77, 0},
+    {7, 7, 77, 0},
+    {7, 7, 77, 0},
+    {7, 7, 77, 0},
+    {7, 7, 77, 0},
+    {7, 7, 77, 0},
+    {7, 7, 77, 0},
+    {7, 7, 77, 0},
+    {7, 7, 77, 0},
+    {7, 7, 77, 0},
+    {7, 7, 77, 0},
+    {7, 7, 77, 0},
+    {7, 7, 77, 0},
+    {7, 7, 77, 0},
+    {12, 7, 78, 48},
+    {12, 7, 78, 49},
+    {12, 7, 78, 50},
+    {12, 7, 78, 97},
+    {12, 7, 78, 99},
+    {12, 7, 78, 101},
+    {12, 7, 78, 105},
+    {12, 7, 78, 111},
+    {12, 7, 78, 115},
+    {12, 7, 78, 116},
+    {7, 7, 78, 0},
+    {7, 7, 78, 0},
+    {7, 7, 78, 0},
+    {7, 7, 78, 0},
+    {7, 7, 78, 0},
+    {7, 7, 78, 0},
+    {7, 7, 78, 0},
+    {7, 7, 78, 0},
+    {7, 7, 78, 0},
+    {7, 7, 78, 0},
+    {7, 7, 78, 0},
+    {7, 7, 78, 0},
+    {7, 7, 78, 0},
+    {7, 7, 78, 0},
+    {7, 7, 78, 0},
+    {7, 7, 78, 0},
+    {7, 7, 78, 0},
+    {7, 7, 78, 0},
+    {7, 7, 78, 0},
+    {7, 7, 78, 0},
+    {7, 7, 78, 0},
+    {7, 7, 78, 0},
+    {12, 7, 79, 48},
+    {12, 7, 79, 49},
+    {12, 7, 79, 50},
+    {12, 7, 79, 97},
+    {12, 7, 79, 99},
+    {12, 7, 79, 101},
+    {12, 7, 79, 105},
+    {12, 7, 79, 111},
+    {12, 7, 79, 115},
+    {12, 7, 79, 116},
+    {7, 7, 79, 0},
+    {7, 7, 79, 0},
+    {7, 7, 79, 0},
+    {7, 7, 79, 0},
+    {7, 7, 79, 0},
+    {7, 7, 79, 0},
+    {7, 7, 79, 0},
+    {7, 7, 79, 0},
+    {7, 7, 79, 0},
+    {7, 7, 79, 0},
+    {7, 7, 79, 0},
+    {7, 7, 79, 0},
+    {7, 7, 79, 0},
+    {7, 7, 79, 0},
+    {7, 7, 79, 0},
+    {7, 7, 79, 0},
+    {7, 7, 79, 0},
+    {7, 7, 79, 0},
+    {7, 7, 79, 0},
+    {7, 7, 79, 0},
+    {7, 7, 79, 0},
+    {7, 7, 79, 0},
+    {12, 7, 80, 48},
+    {12, 7, 80, 49},
+    {12, 7, 80, 50},
+    {12, 7, 80, 97},
+    {12, 7, 80, 99},
+    {12, 7, 80, 101},
+    {12, 7, 80, 105},
+    {12, 7, 80, 111},
+    {12, 7, 80, 115},
+    {12, 7, 80, 116},
+    {7, 7, 80, 0},
+    {7, 7, 80, 0},
+    {7, 7, 80, 0},
+    {7, 7, 80, 0},
+    {7, 7, 80, 0},
+    {7, 7, 80, 0},
+    {7, 7, 80, 0},
+    {7, 7, 80, 0},
+    {7, 7, 80, 0},
+    {7, 7, 80, 0},
+    {7, 7, 80, 0},
+    {7, 7, 80, 0},
+    {7, 7, 80, 0},
+    {7, 7, 80, 0},
+    {7, 7, 80, 0},
+    {7, 7, 80, 0},
+    {7, 7, 80, 0},
+    {7, 7, 80, 0},
+    {7, 7, 80, 0},
+    {7, 7, 80, 0},
+    {7, 7, 80, 0},
+    {7, 7, 80, 0},
+    {12, 7, 81, 48},
+    {12, 7, 81, 49},
+    {12, 7, 81, 50},
+    {12, 7, 81, 97},
+    {12, 7, 81, 99},
+    {12, 7, 81, 101},
+    {12, 7, 81, 105},
+    {12, 7, 81, 111},
+    {12, 7, 81, 115},
+    {12, 7, 81, 116},
+    {7, 7, 81, 0},
+    {7, 7, 81, 0},
+    {7, 7, 81, 0},
+    {7, 7, 81, 0},
+    {7, 7, 81, 0},
+    {7, 7, 81, 0},
+    {7, 7, 81, 0},
+    {7, 7, 81, 0},
+    {7, 7, 81, 0},
+    {7, 7, 81, 0},
+    {7, 7, 81, 0},
+    {7, 7, 81, 0},
+    {7, 7, 81, 0},
+    {7, 7, 81, 0},
+    {7, 7, 81, 0},
+    {7, 7, 81, 0},
+    {7, 7, 81, 0},
+    {7, 7, 81, 0},
+    {7, 7, 81, 0},
+    {7, 7, 81, 0},
+    {7, 7, 81, 0},
+    {7, 7, 81, 0},
+    {12, 7, 82, 48},
+    {12, 7, 82, 49},
+    {12, 7, 82, 50},
+    {12, 7, 82, 97},
+    {12, 7, 82, 99},
+    {12, 7, 82, 101},
+    {12, 7, 82, 105},
+    {12, 7, 82, 111},
+    {12, 7, 82, 115},
+    {12, 7, 82, 116},
+    {7, 7, 82, 0},
+    {7, 7, 82, 0},
+    {7, 7, 82, 0},
+    {7, 7, 82, 0},
+    {7, 7, 82, 0},
+    {7, 7, 82, 0},
+    {7, 7, 82, 0},
+    {7, 7, 82, 0},
+    {7, 7, 82, 0},
+    {7, 7, 82, 0},
+    {7, 7, 82, 0},
+    {7, 7, 82, 0},
+    {7, 7, 82, 0},
+    {7, 7, 82, 0},
+    {7, 7, 82, 0},
+    {7, 7, 82, 0},
+    {7, 7, 82, 0},
+    {7, 7, 82, 0},
+    {7, 7, 82, 0},
+    {7, 7, 82, 0},
+    {7, 7, 82, 0},
+    {7, 7, 82, 0},
+    {12, 7, 83, 48},
+    {12, 7, 83, 49},
+    {12, 7, 83, 50},
+    {12, 7, 83, 97},
+    {12, 7, 83, 99},
+    {12, 7, 83, 101},
+    {12, 7, 83, 105},
+    {12, 7, 83, 111},
+    {12, 7, 83, 115},
+    {12, 7, 83, 116},
+    {7, 7, 83, 0},
+    {7, 7, 83, 0},
+    {7, 7, 83, 0},
+    {7, 7, 83, 0},
+    {7, 7, 83, 0},
+    {7, 7, 83, 0},
+    {7, 7, 83, 0},
+    {7, 7, 83, 0},
+    {7, 7, 83, 0},
+    {7, 7, 83, 0},
+    {7, 7, 83, 0},
+    {7, 7, 83, 0},
+    {7, 7, 83, 0},
+    {7, 7, 83, 0},
+    {7, 7, 83, 0},
+    {7, 7, 83, 0},
+    {7, 7, 83, 0},
+    {7, 7, 83, 0},
+    {7, 7, 83, 0},
+    {7, 7, 83, 0},
+    {7, 7, 83, 0},
+    {7, 7, 83, 0},
+    {12, 7, 84, 48},
+    {12, 7, 84, 49},
+    {12, 7, 84, 50},
+    {12, 7, 84, 97},
+    {12, 7, 84, 99},
+    {12, 7, 84, 101},
+    {12, 7, 84, 105},
+    {12, 7, 84, 111},
+    {12, 7, 84, 115},
+    {12, 7, 84, 116},
+    {7, 7, 84, 0},
+    {7, 7, 84, 0},
+    {7, 7, 84, 0},
+    {7, 7, 84, 0},
+    {7, 7, 84, 0},
+    {7, 7, 84, 0},
+    {7, 7, 84, 0},
+    {7, 7, 84, 0},
+    {7, 7, 84, 0},
+    {7, 7, 84, 0},
+    {7, 7, 84, 0},
+    {7, 7, 84, 0},
+    {7, 7, 84, 0},
+    {7, 7, 84, 0},
+    {7, 7, 84, 0},
+    {7, 7, 84, 0},
+    {7, 7, 84, 0},
+    {7, 7, 84, 0},
+    {7, 7, 84, 0},
+    {7, 7, 84, 0},
+    {7, 7, 84, 0},
+    {7, 7, 84, 0},
+    {12, 7, 85, 48},
+    {12, 7, 85, 49},
+    {12, 7, 85, 50},
+    {12, 7, 85, 97},
+    {12, 7, 85, 99},
+    {12, 7, 85, 101},
+    {12, 7, 85, 105},
+    {12, 7, 85, 111},
+    {12, 7, 85, 115},
+    {12, 7, 85, 116},
+    {7, 7, 85, 0},
+    {7, 7, 85, 0},
+    {7, 7, 85, 0},
+    {7, 7, 85, 0},
+    {7, 7, 85, 0},
+    {7, 7, 85, 0},
+    {7, 7, 85, 0},
+    {7, 7, 85, 0},
+    {7, 7, 85, 0},
+    {7, 7, 85, 0},
+    {7, 7, 85, 0},
+    {7, 7, 85, 0},
+    {7, 7, 85, 0},
+    {7, 7, 85, 0},
+    {7, 7, 85, 0},
+    {7, 7, 85, 0},
+    {7, 7, 85, 0},
+    {7, 7, 85, 0},
+    {7, 7, 85, 0},
+    {7, 7, 85, 0},
+    {7, 7, 85, 0},
+    {7, 7, 85, 0},
+    {12, 7, 86, 48},
+    {12, 7, 86, 49},
+    {12, 7, 86, 50},
+    {12, 7, 86, 97},
+    {12, 7, 86, 99},
+    {12, 7, 86, 101},
+    {12, 7, 86, 105},
+    {12, 7, 86, 111},
+    {12, 7, 86, 115},
+    {12, 7, 86, 116},
+    {7, 7, 86, 0},
+    {7, 7, 86, 0},
+    {7, 7, 86, 0},
+    {7, 7, 86, 0},
+    {7, 7, 86, 0},
+    {7, 7, 86, 0},
+    {7, 7, 86, 0},
+    {7, 7, 86, 0},
+    {7, 7, 86, 0},
+    {7, 7, 86, 0},
+    {7, 7, 86, 0},
+    {7, 7, 86, 0},
+    {7, 7, 86, 0},
+    {7, 7, 86, 0},
+    {7, 7, 86, 0},
+    {7, 7, 86, 0},
+    {7, 7, 86, 0},
+    {7, 7, 86, 0},
+    {7, 7, 86, 0},
+    {7, 7, 86, 0},
+    {7, 7, 86, 0},
+    {7, 7, 86, 0},
+    {12, 7, 87, 48},
+    {12, 7, 87, 49},
+    {12, 7, 87, 50},
+    {12, 7, 87, 97},
+    {12, 7, 87, 99},
+    {12, 7, 87, 101},
+    {12, 7, 87, 105},
+    {12, 7, 87, 111},
+    {12, 7, 87, 115},
+    {12, 7, 87, 116},
+    {7, 7, 87, 0},
+    {7, 7, 87, 0},
+    {7, 7, 87, 0},
+    {7, 7, 87, 0},
+    {7, 7, 87, 0},
+    {7, 7, 87, 0},
+    {7, 7, 87, 0},
+    {7, 7, 87, 0},
+    {7, 7, 87, 0},
+    {7, 7, 87, 0},
+    {7, 7, 87, 0},
+    {7, 7, 87, 0},
+    {7, 7, 87, 0},
+    {7, 7, 87, 0},
+    {7, 7, 87, 0},
+    {7, 7, 87, 0},
+    {7, 7, 87, 0},
+    {7, 7, 87, 0},
+    {7, 7, 87, 0},
+    {7, 7, 87, 0},
+    {7, 7, 87, 0},
+    {7, 7, 87, 0},
+    {12, 7, 89, 48},
+    {12, 7, 89, 49},
+    {12, 7, 89, 50},
+    {12, 7, 89, 97},
+    {12, 7, 89, 99},
+    {12, 7, 89, 101},
+    {12, 7, 89, 105},
+    {12, 7, 89, 111},
+    {12, 7, 89, 115},
+    {12, 7, 89, 116},
+    {7, 7, 89, 0},
+    {7, 7, 89, 0},
+    {7, 7, 89, 0},
+    {7, 7, 89, 0},
+    {7, 7, 89, 0},
+    {7, 7, 89, 0},
+    {7, 7, 89, 0},
+    {7, 7, 89, 0},
+    {7, 7, 89, 0},
+    {7, 7, 89, 0},
+    {7, 7, 89, 0},
+    {7, 7, 89, 0},
+    {7, 7, 89, 0},
+    {7, 7, 89, 0},
+    {7, 7, 89, 0},
+    {7, 7, 89, 0},
+    {7, 7, 89, 0},
+    {7, 7, 89, 0},
+    {7, 7, 89, 0},
+    {7, 7, 89, 0},
+    {7, 7, 89, 0},
+    {7, 7, 89, 0},
+    {12, 7, 106, 48},
+    {12, 7, 106, 49},
+    {12, 7, 106, 50},
+    {12, 7, 106, 97},
+    {12, 7, 106, 99},
+    {12, 7, 106, 101},
+    {12, 7, 106, 105},
+    {12, 7, 106, 111},
+    {12, 7, 106, 115},
+    {12, 7, 106, 116},
+    {7, 7, 106, 0},
+    {7, 7, 106, 0},
+    {7, 7, 106, 0},
+    {7, 7, 106, 0},
+    {7, 7, 106, 0},
+    {7, 7, 106, 0},
+    {7, 7, 106, 0},
+    {7, 7, 106, 0},
+    {7, 7, 106, 0},
+    {7, 7, 106, 0},
+    {7, 7, 106, 0},
+    {7, 7, 106, 0},
+    {7, 7, 106, 0},
+    {7, 7, 106, 0},
+    {7, 7, 106, 0},
+    {7, 7, 106, 0},
+    {7, 7, 106, 0},
+    {7, 7, 106, 0},
+    {7, 7, 106, 0},
+    {7, 7, 106, 0},
+    {7, 7, 106, 0},
+    {7, 7, 106, 0},
+    {12, 7, 107, 48},
+    {12, 7, 107, 49},
+    {12, 7, 107, 50},
+    {12, 7, 107, 97},
+    {12, 7, 107, 99},
+    {12, 7, 107, 101},
+    {12, 7, 107, 105},
+    {12, 7, 107, 111},
+    {12, 7, 107, 115},
+    {12, 7, 107, 116},
+    {7, 7, 107, 0},
+    {7, 7, 107, 0},
+    {7, 7, 107, 0},
+    {7, 7, 107, 0},
+    {7, 7, 107, 0},
+    {7, 7, 107, 0},
+    {7, 7, 107, 0},
+    {7, 7, 107, 0},
+    {7, 7, 107, 0},
+    {7, 7, 107, 0},
+    {7, 7, 107, 0},
+    {7, 7, 107, 0},
+    {7, 7, 107, 0},
+    {7, 7, 107, 0},
+    {7, 7, 107, 0},
+    {7, 7, 107, 0},
+    {7, 7, 107, 0},
+    {7, 7, 107, 0},
+    {7, 7, 107, 0},
+    {7, 7, 107, 0},
+    {7, 7, 107, 0},
+    {7, 7, 107, 0},
+    {12, 7, 113, 48},
+    {12, 7, 113, 49},
+    {12, 7, 113, 50},
+    {12, 7, 113, 97},
+    {12, 7, 113, 99},
+    {12, 7, 113, 101},
+    {12, 7, 113, 105},
+    {12, 7, 113, 111},
+    {12, 7, 113, 115},
+    {12, 7, 113, 116},
+    {7, 7, 113, 0},
+    {7, 7, 113, 0},
+    {7, 7, 113, 0},
+    {7, 7, 113, 0},
+    {7, 7, 113, 0},
+    {7, 7, 113, 0},
+    {7, 7, 113, 0},
+    {7, 7, 113, 0},
+    {7, 7, 113, 0},
+    {7, 7, 113, 0},
+    {7, 7, 113, 0},
+    {7, 7, 113, 0},
+    {7, 7, 113, 0},
+    {7, 7, 113, 0},
+    {7, 7, 113, 0},
+    {7, 7, 113, 0},
+    {7, 7, 113, 0},
+    {7, 7, 113, 0},
+    {7, 7, 113, 0},
+    {7, 7, 113, 0},
+    {7, 7, 113, 0},
+    {7, 7, 113, 0},
+    {12, 7, 118, 48},
+    {12, 7, 118, 49},
+    {12, 7, 118, 50},
+    {12, 7, 118, 97},
+    {12, 7, 118, 99},
+    {12, 7, 118, 101},
+    {12, 7, 118, 105},
+    {12, 7, 118, 111},
+    {12, 7, 118, 115},
+    {12, 7, 118, 116},
+    {7, 7, 118, 0},
+    {7, 7, 118, 0},
+    {7, 7, 118, 0},
+    {7, 7, 118, 0},
+    {7, 7, 118, 0},
+    {7, 7, 118, 0},
+    {7, 7, 118, 0},
+    {7, 7, 118, 0},
+    {7, 7, 118, 0},
+    {7, 7, 118, 0},
+    {7, 7, 118, 0},
+    {7, 7, 118, 0},
+    {7, 7, 118, 0},
+    {7, 7, 118, 0},
+    {7, 7, 118, 0},
+    {7, 7, 118, 0},
+    {7, 7, 118, 0},
+    {7, 7, 118, 0},
+    {7, 7, 118, 0},
+    {7, 7, 118, 0},
+    {7, 7, 118, 0},
+    {7, 7, 118, 0},
+    {12, 7, 119, 48},
+    {12, 7, 119, 49},
+    {12, 7, 119, 50},
+    {12, 7, 119, 97},
+    {12, 7, 119, 99},
+    {12, 7, 119, 101},
+    {12, 7, 119, 105},
+    {12, 7, 119, 111},
+    {12, 7, 119, 115},
+    {12, 7, 119, 116},
+    {7, 7, 119, 0},
+    {7, 7, 119, 0},
+    {7, 7, 119, 0},
+    {7, 7, 119, 0},
+    {7, 7, 119, 0},
+    {7, 7, 119, 0},
+    {7, 7, 119, 0},
+    {7, 7, 119, 0},
+    {7, 7, 119, 0},
+    {7, 7, 119, 0},
+    {7, 7, 119, 0},
+    {7, 7, 119, 0},
+    {7, 7, 119, 0},
+    {7, 7, 119, 0},
+    {7, 7, 119, 0},
+    {7, 7, 119, 0},
+    {7, 7, 119, 0},
+    {7, 7, 119, 0},
+    {7, 7, 119, 0},
+    {7, 7, 119, 0},
+    {7, 7, 119, 0},
+    {7, 7, 119, 0},
+    {12, 7, 120, 48},
+    {12, 7, 120, 49},
+    {12, 7, 120, 50},
+    {12, 7, 120, 97},
+    {12, 7, 120, 99},
+    {12, 7, 120, 101},
+    {12, 7, 120, 105},
+    {12, 7, 120, 111},
+    {12, 7, 120, 115},
+    {12, 7, 120, 116},
+    {7, 7, 120, 0},
+    {7, 7, 120, 0},
+    {7, 7, 120, 0},
+    {7, 7, 120, 0},
+    {7, 7, 120, 0},
+    {7, 7, 120, 0},
+    {7, 7, 120, 0},
+    {7, 7, 120, 0},
+    {7, 7, 120, 0},
+    {7, 7, 120, 0},
+    {7, 7, 120, 0},
+    {7, 7, 120, 0},
+    {7, 7, 120, 0},
+    {7, 7, 120, 0},
+    {7, 7, 120, 0},
+    {7, 7, 120, 0},
+    {7, 7, 120, 0},
+    {7, 7, 120, 0},
+    {7, 7, 120, 0},
+    {7, 7, 120, 0},
+    {7, 7, 120, 0},
+    {7, 7, 120, 0},
+    {12, 7, 121, 48},
+    {12, 7, 121, 49},
+    {12, 7, 121, 50},
+    {12, 7, 121, 97},
+    {12, 7, 121, 99},
+    {12, 7, 121, 101},
+    {12, 7, 121, 105},
+    {12, 7, 121, 111},
+    {12, 7, 121, 115},
+    {12, 7, 121, 116},
+    {7, 7, 121, 0},
+    {7, 7, 121, 0},
+    {7, 7, 121, 0},
+    {7, 7, 121, 0},
+    {7, 7, 121, 0},
+    {7, 7, 121, 0},
+    {7, 7, 121, 0},
+    {7, 7, 121, 0},
+    {7, 7, 121, 0},
+    {7, 7, 121, 0},
+    {7, 7, 121, 0},
+    {7, 7, 121, 0},
+    {7, 7, 121, 0},
+    {7, 7, 121, 0},
+    {7, 7, 121, 0},
+    {7, 7, 121, 0},
+    {7, 7, 121, 0},
+    {7, 7, 121, 0},
+    {7, 7, 121, 0},
+    {7, 7, 121, 0},
+    {7, 7, 121, 0},
+    {7, 7, 121, 0},
+    {12, 7, 122, 48},
+    {12, 7, 122, 49},
+    {12, 7, 122, 50},
+    {12, 7, 122, 97},
+    {12, 7, 122, 99},
+    {12, 7, 122, 101},
+    {12, 7, 122, 105},
+    {12, 7, 122, 111},
+    {12, 7, 122, 115},
+    {12, 7, 122, 116},
+    {7, 7, 122, 0},
+    {7, 7, 122, 0},
+    {7, 7, 122, 0},
+    {7, 7, 122, 0},
+    {7, 7, 122, 0},
+    {7, 7, 122, 0},
+    {7, 7, 122, 0},
+    {7, 7, 122, 0},
+    {7, 7, 122, 0},
+    {7, 7, 122, 0},
+    {7, 7, 122, 0},
+    {7, 7, 122, 0},
+    {7, 7, 122, 0},
+    {7, 7, 122, 0},
+    {7, 7, 122, 0},
+    {7, 7, 122, 0},
+    {7, 7, 122, 0},
+    {7, 7, 122, 0},
+    {7, 7, 122, 0},
+    {7, 7, 122, 0},
+    {7, 7, 122, 0},
+    {7, 7, 122, 0},
+    {8, 8, 38, 0},
+    {8, 8, 38, 0},
+    {8, 8, 38, 0},
+    {8, 8, 38, 0},
+    {8, 8, 38, 0},
+    {8, 8, 38, 0},
+    {8, 8, 38, 0},
+    {8, 8, 38, 0},
+    {8, 8, 38, 0},
+    {8, 8, 38, 0},
+    {8, 8, 38, 0},
+    {8, 8, 38, 0},
+    {8, 8, 38, 0},
+    {8, 8, 38, 0},
+    {8, 8, 38, 0},
+    {8, 8, 38, 0},
+    {8, 8, 42, 0},
+    {8, 8, 42, 0},
+    {8, 8, 42, 0},
+    {8, 8, 42, 0},
+    {8, 8, 42, 0},
+    {8, 8, 42, 0},
+    {8, 8, 42, 0},
+    {8, 8, 42, 0},
+    {8, 8, 42, 0},
+    {8, 8, 42, 0},
+    {8, 8, 42, 0},
+    {8, 8, 42, 0},
+    {8, 8, 42, 0},
+    {8, 8, 42, 0},
+    {8, 8, 42, 0},
+    {8, 8, 42, 0},
+    {8, 8, 44, 0},
+    {8, 8, 44, 0},
+    {8, 8, 44, 0},
+    {8, 8, 44, 0},
+    {8, 8, 44, 0},
+    {8, 8, 44, 0},
+    {8, 8, 44, 0},
+    {8, 8, 44, 0},
+    {8, 8, 44, 0},
+    {8, 8, 44, 0},
+    {8, 8, 44, 0},
+    {8, 8, 44, 0},
+    {8, 8, 44, 0},
+    {8, 8, 44, 0},
+    {8, 8, 44, 0},
+    {8, 8, 44, 0},
+    {8, 8, 59, 0},
+    {8, 8, 59, 0},
+    {8, 8, 59, 0},
+    {8, 8, 59, 0},
+    {8, 8, 59, 0},
+    {8, 8, 59, 0},
+    {8, 8, 59, 0},
+    {8, 8, 59, 0},
+    {8, 8, 59, 0},
+    {8, 8, 59, 0},
+    {8, 8, 59, 0},
+    {8, 8, 59, 0},
+    {8, 8, 59, 0},
+    {8, 8, 59, 0},
+    {8, 8, 59, 0},
+    {8, 8, 59, 0},
+    {8, 8, 88, 0},
+    {8, 8, 88, 0},
+    {8, 8, 88, 0},
+    {8, 8, 88, 0},
+    {8, 8, 88, 0},
+    {8, 8, 88, 0},
+    {8, 8, 88, 0},
+    {8, 8, 88, 0},
+    {8, 8, 88, 0},
+    {8, 8, 88, 0},
+    {8, 8, 88, 0},
+    {8, 8, 88, 0},
+    {8, 8, 88, 0},
+    {8, 8, 88, 0},
+    {8, 8, 88, 0},
+    {8, 8, 88, 0},
+    {8, 8, 90, 0},
+    {8, 8, 90, 0},
+    {8, 8, 90, 0},
+    {8, 8, 90, 0},
+    {8, 8, 90, 0},
+    {8, 8, 90, 0},
+    {8, 8, 90, 0},
+    {8, 8, 90, 0},
+    {8, 8, 90, 0},
+    {8, 8, 90, 0},
+    {8, 8, 90, 0},
+    {8, 8, 90, 0},
+    {8, 8, 90, 0},
+    {8, 8, 90, 0},
+    {8, 8, 90, 0},
+    {8, 8, 90, 0},
+    {10, 10, 33, 0},
+    {10, 10, 33, 0},
+    {10, 10, 33, 0},
+    {10, 10, 33, 0},
+    {10, 10, 34, 0},
+    {10, 10, 34, 0},
+    {10, 10, 34, 0},
+    {10, 10, 34, 0},
+    {10, 10, 40, 0},
+    {10, 10, 40, 0},
+    {10, 10, 40, 0},
+    {10, 10, 40, 0},
+    {10, 10, 41, 0},
+    {10, 10, 41, 0},
+    {10, 10, 41, 0},
+    {10, 10, 41, 0},
+    {10, 10, 63, 0},
+    {10, 10, 63, 0},
+    {10, 10, 63, 0},
+    {10, 10, 63, 0},
+    {11, 11, 39, 0},
+    {11, 11, 39, 0},
+    {11, 11, 43, 0},
+    {11, 11, 43, 0},
+    {11, 11, 124, 0},
+    {11, 11, 124, 0},
+    {12, 12, 35, 0},
+    {12, 12, 62, 0},
+    {0, 0, 0, 0},
+    {0, 0, 0, 0},
+    {0, 0, 0, 0},
+    {0, 0, 0, 0},
+};
+
+const nghttp2_huff_decode_long huff_decode_long_table[] = {
+    {0x0u, 0, 0},
+    {0x0u, 0, 0},
+    {0x0u, 0, 0},
+    {0x0u, 0, 0},
+    {0x0u, 0, 0},
+    {0x0u, 10, 0},
+    {0x14u, 26, 10},
+    {0x5cu, 32, 36},
+    {0xf8u, 6, 68},
+    {0x0u, 0, 0},
+    {0x3f8u, 5, 74},
+    {0x7fau, 3, 79},
+    {0xffau, 2, 82},
+    {0x1ff8u, 6, 84},
+    {0x3ffcu, 2, 90},
+    {0x7ffcu, 3, 92},
+    {0x0u, 0, 0},
+    {0x0u, 0, 0},
+    {0x0u, 0, 0},
+    {0x7fff0u, 3, 95},
+    {0xfffe6u, 8, 98},
+    {0x1fffdcu, 13, 106},
+    {0x3fffd2u, 26, 119},
+    {0x7fffd8u, 29, 145},
+    {0xffffeau, 12, 174},
+    {0x1ffffecu, 4, 186},
+    {0x3ffffe0u, 15, 190},
+    {0x7ffffdeu, 19, 205},
+    {0xfffffe2u, 29, 224},
+    {0x0u, 0, 0},
+    {0x3ffffffcu, 4, 253},
+};
+
+const uint16_t huff_decode_long_sym_table[] = {
+    48, 49, 50, 97, 99, 101, 105, 111, 115, 116, 32, 37,
+    45, 46, 47, 51, 52, 53, 54, 55, 56, 57, 61, 65,
+    95, 98, 100, 102, 103, 104, 108, 109, 110, 112, 114, 117,
+    58, 66, 67, 68, 69, 70, 71, 72, 73, 74, 75, 76,
+    77, 78, 79, 80, 81, 82, 83, 84, 85, 86, 87, 89,
+    106, 107, 113, 118, 119, 120, 121, 122, 38, 42, 44, 59,
+    88, 90, 33, 34, 40, 41, 63, 39, 43, 124, 35, 62,
+    0, 36, 64, 91, 93, 126, 94, 125, 60, 96, 123, 92,
+    195, 208, 128, 130, 131, 162, 184, 194, 224, 226, 153, 161,
+    167, 172, 176, 177, 179, 209, 216, 217, 227, 229, 230, 129,
+    132, 133, 134, 136, 146, 154, 156, 160, 163, 164, 169, 170,
+    173, 178, 181, 185, 186, 187, 189, 190, 196, 198, 228, 232,
+    233, 1, 135, 137, 138, 139, 140, 141, 143, 147, 149, 150,
+    151, 152, 155, 157, 158, 165, 166, 168, 174, 175, 180, 182,
+    183, 188, 191, 197, 231, 239, 9, 142, 144, 145, 148, 159,
+    171, 206, 215, 225, 236, 237, 199, 207, 234, 235, 192, 193,
+    200, 201, 202, 205, 210, 213, 218, 219, 238, 240, 242, 243,
+    255, 203, 204, 211, 212, 214, 221, 222, 223, 241, 244, 245,
+    246, 247, 248, 250, 251, 252, 253, 254, 2, 3, 4, 5,
+    6, 7, 8, 11, 12, 14, 15, 16, 17, 18, 19, 20,
+    21, 23, 24, 25, 26, 27, 28, 29, 30, 31, 127, 220,
+    249, 10, 13, 22, 256,
+};
@@ -28,6 +28,7 @@
 #include <string.h>
 
 #include "nghttp2_net.h"
+#include "nghttp2_simd.h"
 
 void nghttp2_put_uint16be(uint8_t *buf, uint16_t n) {
   uint16_t x = htons(n);
@@ -228,6 +229,26 @@ int nghttp2_adjust_local_window_size(int32_t *local_window_size_ptr,
   return 0;
 }
 
+int nghttp2_increase_local_window_size(int32_t *local_window_size_ptr,
+                                       int32_t *recv_window_size_ptr,
+                                       int32_t *recv_reduction_ptr,
+                                       int32_t *delta_ptr) {
+  int32_t recv_reduction_delta;
+
+  if (*local_window_size_ptr > NGHTTP2_MAX_WINDOW_SIZE - *delta_ptr) {
+    return NGHTTP2_ERR_FLOW_CONTROL;
+  }
+
+  *local_window_size_ptr += *delta_ptr;
+
+  recv_reduction_delta = nghttp2_min(*recv_reduction_ptr, *delta_ptr);
+  *recv_reduction_ptr -= recv_reduction_delta;
+  *recv_window_size_ptr += recv_reduction_delta;
+  *delta_ptr -= recv_reduction_delta;
+
+  return 0;
+}
+
 int nghttp2_should_send_window_update(int32_t local_window_size,
                                       int32_t recv_window_size) {
   return recv_window_size >= local_window_size / 2;
@@ -370,8 +391,83 @@ static int VALID_HD_NAME_CHARS[] = {
     0 /* 0xff */
 };
 
-int nghttp2_check_header_name(const uint8_t *name, size_t len) {
+static int check_header_name_scalar(const uint8_t *name, size_t len) {
   const uint8_t *last;
+  for (last = name + len; name != last; ++name) {
+    if (!VALID_HD_NAME_CHARS[*name]) {
+      return 0;
+    }
+  }
+  return 1;
+}
+
+/*
+ * The vector kernels for header field name only recognize the
+ * characters which dominate real header field names: lowercase
+ * alphabets, digits and '-'.  A block which contains anything else
+ * is rechecked by the lookup table, which accepts the remaining token
+ * characters and rejects the rest.
+ */
+#ifdef NGHTTP2_HAVE_SSE2
+static int check_header_name_sse2(const uint8_t *name, size_t len) {
+  const uint8_t *last = name + len;
+  const __m128i lower_lo = _mm_set1_epi8('a' - 1);
+  const __m128i lower_hi = _mm_set1_epi8('z' + 1);
+  const __m128i digit_lo = _mm_set1_epi8('0' - 1);
+  const __m128i digit_hi = _mm_set1_epi8('9' + 1);
+  const __m128i hyphen = _mm_set1_epi8('-');
+  __m128i x, ok;
+
+  for (; last - name >= 16; name += 16) {
+    x = _mm_loadu_si128((const __m128i *)(const void *)name);
+    /* Bytes >= 0x80 are negative in signed comparison, and fall out
+       of all ranges. */
+    ok = _mm_or_si128(
+        _mm_and_si128(_mm_cmpgt_epi8(x, lower_lo), _mm_cmplt_epi8(x, lower_hi)),
+        _mm_and_si128(_mm_cmpgt_epi8(x, digit_lo),
+                      _mm_cmplt_epi8(x, digit_hi)));
+    ok = _mm_or_si128(ok, _mm_cmpeq_epi8(x, hyphen));
+
+    if (_mm_movemask_epi8(ok) != 0xffff &&
+        !check_header_name_scalar(name, 16)) {
+      return 0;
+    }
+  }
+
+  return check_header_name_scalar(name, (size_t)(last - name));
+}
+#endif /* NGHTTP2_HAVE_SSE2 */
+
+#ifdef NGHTTP2_HAVE_AVX2_DISPATCH
+__attribute__((target("avx2"))) static int
+check_header_name_avx2(const uint8_t *name, size_t len) {
+  const uint8_t *last = name + len;
+  const __m256i lower_lo = _mm256_set1_epi8('a' - 1);
+  const __m256i lower_hi = _mm256_set1_epi8('z' + 1);
+  const __m256i digit_lo = _mm256_set1_epi8('0' - 1);
+  const __m256i digit_hi = _mm256_set1_epi8('9' + 1);
+  const __m256i hyphen = _mm256_set1_epi8('-');
+  __m256i x, ok;
+
+  for (; last - name >= 32; name += 32) {
+    x = _mm256_loadu_si256((const __m256i *)(const void *)name);
+    ok = _mm256_or_si256(_mm256_and_si256(_mm256_cmpgt_epi8(x, lower_lo),
+                                          _mm256_cmpgt_epi8(lower_hi, x)),
+                         _mm256_and_si256(_mm256_cmpgt_epi8(x, digit_lo),
+                                          _mm256_cmpgt_epi8(digit_hi, x)));
+    ok = _mm256_or_si256(ok, _mm256_cmpeq_epi8(x, hyphen));
+
+    if (_mm256_movemask_epi8(ok) != -1 &&
+        !check_header_name_scalar(name, 32)) {
+      return 0;
+    }
+  }
+
+  return check_header_name_scalar(name, (size_t)(last - name));
+}
+#endif /* NGHTTP2_HAVE_AVX2_DISPATCH */
+
+int nghttp2_check_header_name(const uint8_t *name, size_t len) {
   if (len == 0) {
     return 0;
   }
@@ -382,12 +478,17 @@ int nghttp2_check_header_name(const uint8_t *name, size_t len) {
     ++name;
     --len;
   }
-  for (last = name + len; name != last; ++name) {
-    if (!VALID_HD_NAME_CHARS[*name]) {
-      return 0;
-    }
+#ifdef NGHTTP2_HAVE_AVX2_DISPATCH
+  if (len >= 32 && __builtin_cpu_supports("avx2")) {
+    return check_header_name_avx2(name, len);
   }
-  return 1;
+#endif /* NGHTTP2_HAVE_AVX2_DISPATCH */
+#ifdef NGHTTP2_HAVE_SSE2
+  if (len >= 16) {
+    return check_header_name_sse2(name, len);
+  }
+#endif /* NGHTTP2_HAVE_SSE2 */
+  return check_header_name_scalar(name, len);
 }
 
 /* Generated by genvchartbl.py */
@@ -446,7 +547,7 @@ static int VALID_HD_VALUE_CHARS[] = {
     1 /* 0xff */
 };
 
-int nghttp2_check_header_value(const uint8_t *value, size_t len) {
+static int check_header_value_scalar(const uint8_t *value, size_t len) {
   const uint8_t *last;
   for (last = value + len; value != last; ++value) {
     if (!VALID_HD_VALUE_CHARS[*value]) {
@@ -456,6 +557,75 @@ int nghttp2_check_header_value(const uint8_t *value, size_t len) {
   return 1;
 }
 
+/*
+ * The vector kernels for header field value flag control characters
+ * other than HT, and DEL.  Bytes >= 0x80 are negative in signed
+ * comparison, so "x > -1 && x < 0x20" selects exactly 0x00-0x1f.
+ */
+#ifdef NGHTTP2_HAVE_SSE2
+static int check_header_value_sse2(const uint8_t *value, size_t len) {
+  const uint8_t *last = value + len;
+  const __m128i minus_one = _mm_set1_epi8(-1);
+  const __m128i space = _mm_set1_epi8(' ');
+  const __m128i ht = _mm_set1_epi8('\t');
+  const __m128i del = _mm_set1_epi8(0x7f);
+  __m128i x, bad;
+
+  for (; last - value >= 16; value += 16) {
+    x = _mm_loadu_si128((const __m128i *)(const void *)value);
+    bad = _mm_and_si128(_mm_cmpgt_epi8(x, minus_one), _mm_cmplt_epi8(x, space));
+    bad = _mm_or_si128(_mm_andnot_si128(_mm_cmpeq_epi8(x, ht), bad),
+                       _mm_cmpeq_epi8(x, del));
+
+    if (_mm_movemask_epi8(bad)) {
+      return 0;
+    }
+  }
+
+  return check_header_value_scalar(value, (size_t)(last - value));
+}
+#endif /* NGHTTP2_HAVE_SSE2 */
+
+#ifdef NGHTTP2_HAVE_AVX2_DISPATCH
+__attribute__((target("avx2"))) static int
+check_header_value_avx2(const uint8_t *value, size_t len) {
+  const uint8_t *last = value + len;
+  const __m256i minus_one = _mm256_set1_epi8(-1);
+  const __m256i space = _mm256_set1_epi8(' ');
+  const __m256i ht = _mm256_set1_epi8('\t');
+  const __m256i del = _mm256_set1_epi8(0x7f);
+  __m256i x, bad;
+
+  for (; last - value >= 32; value += 32) {
+    x = _mm256_loadu_si256((const __m256i *)(const void *)value);
+    bad = _mm256_and_si256(_mm256_cmpgt_epi8(x, minus_one),
+                           _mm256_cmpgt_epi8(space, x));
+    bad = _mm256_or_si256(_mm256_andnot_si256(_mm256_cmpeq_epi8(x, ht), bad),
+                          _mm256_cmpeq_epi8(x, del));
+
+    if (_mm256_movemask_epi8(bad)) {
+      return 0;
+    }
+  }
+
+  return check_header_value_scalar(value, (size_t)(last - value));
+}
+#endif /* NGHTTP2_HAVE_AVX2_DISPATCH */
+
+int nghttp2_check_header_value(const uint8_t *value, size_t len) {
+#ifdef NGHTTP2_HAVE_AVX2_DISPATCH
+  if (len >= 32 && __builtin_cpu_supports("avx2")) {
+    return check_header_value_avx2(value, len);
+  }
+#endif /* NGHTTP2_HAVE_AVX2_DISPATCH */
+#ifdef NGHTTP2_HAVE_SSE2
+  if (len >= 16) {
+    return check_header_value_sse2(value, len);
+  }
+#endif /* NGHTTP2_HAVE_SSE2 */
+  return check_header_value_scalar(value, len);
+}
+
 uint8_t *nghttp2_cpymem(uint8_t *dest, const void *src, size_t len) {
   memcpy(dest, src, len);
 
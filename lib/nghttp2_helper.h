@@ -30,6 +30,7 @@
 #endif /* HAVE_CONFIG_H */
 
 #include <string.h>
+#include <stddef.h>
 
 #include <nghttp2/nghttp2.h>
 #include "nghttp2_mem.h"
@@ -37,6 +38,11 @@
 #define nghttp2_min(A, B) ((A) < (B) ? (A) : (B))
 #define nghttp2_max(A, B) ((A) > (B) ? (A) : (B))
 
+/* Returns the pointer to the object of |TYPE| whose member |MEMBER|
+   is pointed by |PTR|. */
+#define nghttp2_struct_of(PTR, TYPE, MEMBER)                                   \
+  ((TYPE *)(void *)((char *)(PTR)-offsetof(TYPE, MEMBER)))
+
 #define lstreq(A, B, N) ((sizeof((A)) - 1) == (N) && memcmp((A), (B), (N)) == 0)
 
 /*
@@ -97,6 +103,27 @@ int nghttp2_adjust_local_window_size(int32_t *local_window_size_ptr,
                                      int32_t *recv_reduction_ptr,
                                      int32_t *delta_ptr);
 
+/*
+ * Increases |*local_window_size_ptr| by |*delta_ptr|, which must be
+ * positive.  Unlike nghttp2_adjust_local_window_size(), received
+ * bytes in |*recv_window_size_ptr| are left untouched, so the window
+ * is enlarged by exactly |*delta_ptr|.  If there is
+ * |*recv_reduction_ptr| due to earlier window size reduction, it is
+ * restored first, and |*delta_ptr| is decreased by that amount.  The
+ * caller should send WINDOW_UPDATE with the resulting |*delta_ptr|
+ * if it is positive.
+ *
+ * This function returns 0 if it succeeds, or one of the following
+ * negative error codes:
+ *
+ * NGHTTP2_ERR_FLOW_CONTROL
+ *     local_window_size overflow.
+ */
+int nghttp2_increase_local_window_size(int32_t *local_window_size_ptr,
+                                       int32_t *recv_window_size_ptr,
+                                       int32_t *recv_reduction_ptr,
+                                       int32_t *delta_ptr);
+
 /*
  * Returns non-zero if the function decided that WINDOW_UPDATE should
  * be sent.
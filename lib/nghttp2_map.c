@@ -25,14 +25,17 @@
 #include "nghttp2_map.h"
 
 #include <string.h>
+#include <assert.h>
 
-#define INITIAL_TABLE_LENGTH 256
+#define INITIAL_TABLE_LENGTH_BITS 8
+#define INITIAL_TABLE_LENGTH (1 << INITIAL_TABLE_LENGTH_BITS)
 
 int nghttp2_map_init(nghttp2_map *map, nghttp2_mem *mem) {
   map->mem = mem;
   map->tablelen = INITIAL_TABLE_LENGTH;
+  map->tablelenbits = INITIAL_TABLE_LENGTH_BITS;
   map->table =
-      nghttp2_mem_calloc(mem, map->tablelen, sizeof(nghttp2_map_entry *));
+      nghttp2_mem_calloc(mem, map->tablelen, sizeof(nghttp2_map_bucket));
   if (map->table == NULL) {
     return NGHTTP2_ERR_NOMEM;
   }
@@ -50,15 +53,20 @@ void nghttp2_map_each_free(nghttp2_map *map,
                            int (*func)(nghttp2_map_entry *entry, void *ptr),
                            void *ptr) {
   size_t i;
+  nghttp2_map_bucket *bkt;
+
   for (i = 0; i < map->tablelen; ++i) {
-    nghttp2_map_entry *entry;
-    for (entry = map->table[i]; entry;) {
-      nghttp2_map_entry *next = entry->next;
-      func(entry, ptr);
-      entry = next;
+    bkt = &map->table[i];
+
+    if (bkt->data == NULL) {
+      continue;
     }
-    map->table[i] = NULL;
+
+    func(bkt->data, ptr);
+    bkt->data = NULL;
   }
+
+  map->size = 0;
 }
 
 int nghttp2_map_each(nghttp2_map *map,
@@ -66,73 +74,130 @@ int nghttp2_map_each(nghttp2_map *map,
                      void *ptr) {
   int rv;
   size_t i;
+  nghttp2_map_bucket *bkt;
+
+  if (map->size == 0) {
+    return 0;
+  }
+
   for (i = 0; i < map->tablelen; ++i) {
-    nghttp2_map_entry *entry;
-    for (entry = map->table[i]; entry; entry = entry->next) {
-      rv = func(entry, ptr);
-      if (rv != 0) {
-        return rv;
-      }
+    bkt = &map->table[i];
+
+    if (bkt->data == NULL) {
+      continue;
+    }
+
+    rv = func(bkt->data, ptr);
+    if (rv != 0) {
+      return rv;
     }
   }
+
   return 0;
 }
 
 void nghttp2_map_entry_init(nghttp2_map_entry *entry, key_type key) {
   entry->key = key;
-  entry->next = NULL;
 }
 
-/* Same hash function in android HashMap source code. */
-/* The |mod| must be power of 2 */
-static int32_t hash(int32_t h, size_t mod) {
-  h ^= (h >> 20) ^ (h >> 12);
-  h ^= (h >> 7) ^ (h >> 4);
-  return h & (mod - 1);
+/* Stream IDs initiated by the same endpoint share the same parity,
+   and they are allocated sequentially.  Dropping the lowest bit and
+   folding the upper bits into the index keeps a window of
+   consecutive stream IDs in distinct buckets, while stream IDs which
+   are apart by multiple of table length still spread.  |bits| is
+   log2 of table length. */
+static size_t hash(key_type key, uint32_t bits) {
+  uint32_t k = key >> 1;
+  return (k ^ (k >> bits)) & ((1u << bits) - 1);
 }
 
-static int insert(nghttp2_map_entry **table, size_t tablelen,
-                  nghttp2_map_entry *entry) {
-  int32_t h = hash(entry->key, tablelen);
-  if (table[h] == NULL) {
-    table[h] = entry;
-  } else {
-    nghttp2_map_entry *p;
-    /* We won't allow duplicated key, so check it out. */
-    for (p = table[h]; p; p = p->next) {
-      if (p->key == entry->key) {
-        return NGHTTP2_ERR_INVALID_ARGUMENT;
-      }
+static void map_bucket_swap(nghttp2_map_bucket *bkt, uint32_t *ppsl,
+                            key_type *pkey, nghttp2_map_entry **pdata) {
+  uint32_t psl = bkt->psl;
+  key_type key = bkt->key;
+  nghttp2_map_entry *data = bkt->data;
+
+  bkt->psl = *ppsl;
+  bkt->key = *pkey;
+  bkt->data = *pdata;
+
+  *ppsl = psl;
+  *pkey = key;
+  *pdata = data;
+}
+
+/* Inserts |data| to |table| of length 1 << |tablelenbits|.  The table
+   must have at least one empty bucket.  This function returns
+   NGHTTP2_ERR_INVALID_ARGUMENT if the key of |data| already exists
+   in |table|. */
+static int insert(nghttp2_map_bucket *table, size_t tablelen,
+                  uint32_t tablelenbits, nghttp2_map_entry *data) {
+  size_t idx;
+  uint32_t psl = 0;
+  key_type key = data->key;
+  nghttp2_map_bucket *bkt;
+  int swapped = 0;
+
+  idx = hash(key, tablelenbits);
+
+  for (;;) {
+    bkt = &table[idx];
+
+    if (bkt->data == NULL) {
+      bkt->psl = psl;
+      bkt->key = key;
+      bkt->data = data;
+      return 0;
     }
-    entry->next = table[h];
-    table[h] = entry;
+
+    /* We won't allow duplicated key.  Once the new entry is placed,
+       the entry we are carrying is already in the table. */
+    if (!swapped && bkt->key == key) {
+      return NGHTTP2_ERR_INVALID_ARGUMENT;
+    }
+
+    if (psl > bkt->psl) {
+      /* Lookup of key stops here, so it cannot appear further in the
+         probe sequence. */
+      swapped = 1;
+      map_bucket_swap(bkt, &psl, &key, &data);
+    }
+
+    ++psl;
+    idx = (idx + 1) & (tablelen - 1);
   }
-  return 0;
 }
 
-/* new_tablelen must be power of 2 */
-static int resize(nghttp2_map *map, size_t new_tablelen) {
+/* new_tablelen must be power of 2 and new_tablelen == (1 <<
+   new_tablelenbits) must hold. */
+static int resize(nghttp2_map *map, size_t new_tablelen,
+                  uint32_t new_tablelenbits) {
   size_t i;
-  nghttp2_map_entry **new_table;
+  nghttp2_map_bucket *new_table;
+  nghttp2_map_bucket *bkt;
+  int rv;
 
   new_table =
-      nghttp2_mem_calloc(map->mem, new_tablelen, sizeof(nghttp2_map_entry *));
+      nghttp2_mem_calloc(map->mem, new_tablelen, sizeof(nghttp2_map_bucket));
   if (new_table == NULL) {
     return NGHTTP2_ERR_NOMEM;
   }
 
   for (i = 0; i < map->tablelen; ++i) {
-    nghttp2_map_entry *entry;
-    for (entry = map->table[i]; entry;) {
-      nghttp2_map_entry *next = entry->next;
-      entry->next = NULL;
-      /* This function must succeed */
-      insert(new_table, new_tablelen, entry);
-      entry = next;
+    bkt = &map->table[i];
+    if (bkt->data == NULL) {
+      continue;
     }
+    rv = insert(new_table, new_tablelen, new_tablelenbits, bkt->data);
+
+    /* This function must succeed */
+    assert(0 == rv);
+    (void)rv;
   }
+
   nghttp2_mem_free(map->mem, map->table);
   map->tablelen = new_tablelen;
+  map->tablelenbits = new_tablelenbits;
   map->table = new_table;
 
   return 0;
@@ -140,51 +205,91 @@ static int resize(nghttp2_map *map, size_t new_tablelen) {
 
 int nghttp2_map_insert(nghttp2_map *map, nghttp2_map_entry *new_entry) {
   int rv;
+
   /* Load factor is 0.75 */
   if ((map->size + 1) * 4 > map->tablelen * 3) {
-    rv = resize(map, map->tablelen * 2);
+    rv = resize(map, map->tablelen * 2, map->tablelenbits + 1);
     if (rv != 0) {
       return rv;
     }
   }
-  rv = insert(map->table, map->tablelen, new_entry);
+
+  rv = insert(map->table, map->tablelen, map->tablelenbits, new_entry);
   if (rv != 0) {
     return rv;
   }
+
   ++map->size;
+
   return 0;
 }
 
-nghttp2_map_entry *nghttp2_map_find(nghttp2_map *map, key_type key) {
-  int32_t h;
-  nghttp2_map_entry *entry;
-  h = hash(key, map->tablelen);
-  for (entry = map->table[h]; entry; entry = entry->next) {
-    if (entry->key == key) {
-      return entry;
+/* Returns the index of bucket which contains |key|, or -1 if it is
+   not found. */
+static ssize_t map_find_index(nghttp2_map *map, key_type key) {
+  size_t idx;
+  uint32_t psl = 0;
+  nghttp2_map_bucket *bkt;
+
+  idx = hash(key, map->tablelenbits);
+
+  for (;;) {
+    bkt = &map->table[idx];
+
+    if (bkt->data == NULL || psl > bkt->psl) {
+      return -1;
     }
+
+    if (bkt->key == key) {
+      return (ssize_t)idx;
+    }
+
+    ++psl;
+    idx = (idx + 1) & (map->tablelen - 1);
+  }
+}
+
+nghttp2_map_entry *nghttp2_map_find(nghttp2_map *map, key_type key) {
+  ssize_t idx;
+
+  idx = map_find_index(map, key);
+  if (idx == -1) {
+    return NULL;
   }
-  return NULL;
+
+  return map->table[idx].data;
 }
 
 int nghttp2_map_remove(nghttp2_map *map, key_type key) {
-  int32_t h;
-  nghttp2_map_entry *entry, *prev;
-  h = hash(key, map->tablelen);
-  prev = NULL;
-  for (entry = map->table[h]; entry; entry = entry->next) {
-    if (entry->key == key) {
-      if (prev == NULL) {
-        map->table[h] = entry->next;
-      } else {
-        prev->next = entry->next;
-      }
-      --map->size;
-      return 0;
+  ssize_t idx;
+  size_t i, next;
+  nghttp2_map_bucket *bkt;
+
+  idx = map_find_index(map, key);
+  if (idx == -1) {
+    return NGHTTP2_ERR_INVALID_ARGUMENT;
+  }
+
+  /* Backward shift deletion: move the following entries which are
+     not in their home bucket one bucket back, so that no tombstone
+     is required. */
+  for (i = (size_t)idx;; i = next) {
+    next = (i + 1) & (map->tablelen - 1);
+    bkt = &map->table[next];
+
+    if (bkt->data == NULL || bkt->psl == 0) {
+      map->table[i].data = NULL;
+      break;
     }
-    prev = entry;
+
+    map->table[i].data = bkt->data;
+    map->table[i].key = bkt->key;
+    map->table[i].psl = bkt->psl - 1;
   }
-  return NGHTTP2_ERR_INVALID_ARGUMENT;
+
+  --map->size;
+
+  return 0;
 }
 
 size_t nghttp2_map_size(nghttp2_map *map) { return map->size; }
@@ -33,12 +33,15 @@
 #include "nghttp2_int.h"
 #include "nghttp2_mem.h"
 
-/* Implementation of unordered map */
+/* Implementation of unordered map.  This is a hash table with open
+   addressing, which uses Robin Hood hashing and backward shift
+   deletion.  The key is stored in the table along with the pointer
+   to the entry, so that lookup does not touch the entries which do
+   not match the key. */
 
 typedef uint32_t key_type;
 
 typedef struct nghttp2_map_entry {
-  struct nghttp2_map_entry *next;
   key_type key;
 #if SIZEOF_INT_P == 4
   /* we requires 8 bytes aligment */
@@ -47,9 +50,20 @@ typedef struct nghttp2_map_entry {
 } nghttp2_map_entry;
 
 typedef struct {
-  nghttp2_map_entry **table;
+  /* The entry stored in this bucket.  NULL if the bucket is empty. */
+  nghttp2_map_entry *data;
+  /* The key of data */
+  key_type key;
+  /* The distance from the bucket the key is hashed to. */
+  uint32_t psl;
+} nghttp2_map_bucket;
+
+typedef struct {
+  nghttp2_map_bucket *table;
   nghttp2_mem *mem;
   size_t tablelen;
+  /* log2(tablelen) */
+  uint32_t tablelenbits;
   size_t size;
 } nghttp2_map;
 
@@ -134,6 +148,8 @@ size_t nghttp2_map_size(nghttp2_map *map);
  * invocations of the |func| return 0, or nonzero value which the last
  * invocation of |func| returns.
  *
+ * The |func| must not insert or remove entries to or from |map|.
+ *
  * Don't use this function to free each entry. Use
  * nghttp2_map_each_free() instead.
  */
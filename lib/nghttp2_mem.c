@@ -59,3 +59,111 @@ void *nghttp2_mem_calloc(nghttp2_mem *mem, size_t nmemb, size_t size) {
 void *nghttp2_mem_realloc(nghttp2_mem *mem, void *ptr, size_t size) {
   return mem->realloc(ptr, size, mem->mem_user_data);
 }
+
+/* The size prefix of the block allocated by nghttp2_mem_tracker.  The
+   union keeps the returned pointer suitably aligned for any type. */
+typedef union {
+  size_t size;
+  void *ptr;
+  double d;
+  long double ld;
+  uint64_t u64;
+} mem_tracker_prefix;
+
+static void *mem_tracker_malloc(size_t size, void *mem_user_data) {
+  nghttp2_mem_tracker *tracker = mem_user_data;
+  mem_tracker_prefix *p;
+
+  if (size > SIZE_MAX - sizeof(mem_tracker_prefix)) {
+    return NULL;
+  }
+
+  size += sizeof(mem_tracker_prefix);
+
+  p = nghttp2_mem_malloc(&tracker->base, size);
+  if (p == NULL) {
+    return NULL;
+  }
+
+  p->size = size;
+  tracker->used += size;
+
+  return p + 1;
+}
+
+static void mem_tracker_free(void *ptr, void *mem_user_data) {
+  nghttp2_mem_tracker *tracker = mem_user_data;
+  mem_tracker_prefix *p;
+
+  if (ptr == NULL) {
+    return;
+  }
+
+  p = (mem_tracker_prefix *)ptr - 1;
+  tracker->used -= p->size;
+
+  nghttp2_mem_free(&tracker->base, p);
+}
+
+static void *mem_tracker_calloc(size_t nmemb, size_t size,
+                                void *mem_user_data) {
+  nghttp2_mem_tracker *tracker = mem_user_data;
+  mem_tracker_prefix *p;
+
+  if (size != 0 && nmemb > (SIZE_MAX - sizeof(mem_tracker_prefix)) / size) {
+    return NULL;
+  }
+
+  size = nmemb * size + sizeof(mem_tracker_prefix);
+
+  p = nghttp2_mem_calloc(&tracker->base, 1, size);
+  if (p == NULL) {
+    return NULL;
+  }
+
+  p->size = size;
+  tracker->used += size;
+
+  return p + 1;
+}
+
+static void *mem_tracker_realloc(void *ptr, size_t size, void *mem_user_data) {
+  nghttp2_mem_tracker *tracker = mem_user_data;
+  mem_tracker_prefix *p;
+  size_t oldsize;
+
+  if (ptr == NULL) {
+    return mem_tracker_malloc(size, mem_user_data);
+  }
+
+  if (size > SIZE_MAX - sizeof(mem_tracker_prefix)) {
+    return NULL;
+  }
+
+  size += sizeof(mem_tracker_prefix);
+
+  p = (mem_tracker_prefix *)ptr - 1;
+  oldsize = p->size;
+
+  p = nghttp2_mem_realloc(&tracker->base, p, size);
+  if (p == NULL) {
+    return NULL;
+  }
+
+  p->size = size;
+  tracker->used = tracker->used - oldsize + size;
+
+  return p + 1;
+}
+
+void nghttp2_mem_tracker_init(nghttp2_mem_tracker *tracker, nghttp2_mem *mem,
+                              const nghttp2_mem *base) {
+  tracker->base = *base;
+  tracker->used = 0;
+
+  mem->mem_user_data = tracker;
+  mem->malloc = mem_tracker_malloc;
+  mem->free = mem_tracker_free;
+  mem->calloc = mem_tracker_calloc;
+  mem->realloc = mem_tracker_realloc;
+}
@@ -41,4 +41,25 @@ void nghttp2_mem_free(nghttp2_mem *mem, void *ptr);
 void *nghttp2_mem_calloc(nghttp2_mem *mem, size_t nmemb, size_t size);
 void *nghttp2_mem_realloc(nghttp2_mem *mem, void *ptr, size_t size);
 
+/*
+ * The allocator which counts the number of bytes allocated through
+ * it and forwards the requests to the underlying allocator.  Each
+ * block is prefixed with its size, so that free and realloc can
+ * account for it.
+ */
+typedef struct {
+  /* The underlying allocator */
+  nghttp2_mem base;
+  /* The number of bytes currently allocated from |base|, including
+     the size prefixes */
+  size_t used;
+} nghttp2_mem_tracker;
+
+/*
+ * Initializes |tracker| so that it forwards allocations to |base|,
+ * and stores the allocator which goes through |tracker| in |*mem|.
+ */
+void nghttp2_mem_tracker_init(nghttp2_mem_tracker *tracker, nghttp2_mem *mem,
+                              const nghttp2_mem *base);
+
 #endif /* NGHTTP2_MEM_H */
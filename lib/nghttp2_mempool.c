@@ -0,0 +1,143 @@
+/*
+ * nghttp2 - HTTP/2 C Library
+ *
+ * Copyright (c) 2015 Tatsuhiro Tsujikawa
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "nghttp2_mempool.h"
+
+#include <assert.h>
+
+/* Objects and slab header are aligned to this boundary */
+#define NGHTTP2_MEMPOOL_ALIGN 16
+
+#define NGHTTP2_MEMPOOL_ALIGN_UP(N)                                            \
+  (((N) + NGHTTP2_MEMPOOL_ALIGN - 1) & ~(size_t)(NGHTTP2_MEMPOOL_ALIGN - 1))
+
+void nghttp2_mempool_init(nghttp2_mempool *pool, size_t objsize,
+                          size_t slabobjs, nghttp2_mem *mem) {
+  pool->slabs = NULL;
+  pool->freelist = NULL;
+  pool->mem = mem;
+  pool->objsize = NGHTTP2_MEMPOOL_ALIGN_UP(objsize);
+  pool->slabobjs = slabobjs;
+  pool->nslabs = 0;
+  pool->nused = 0;
+}
+
+void nghttp2_mempool_free(nghttp2_mempool *pool) {
+  nghttp2_mempool_slab *slab, *next;
+
+  for (slab = pool->slabs; slab;) {
+    next = slab->next;
+    nghttp2_mem_free(pool->mem, slab);
+    slab = next;
+  }
+
+  pool->slabs = NULL;
+  pool->freelist = NULL;
+  pool->nslabs = 0;
+}
+
+/*
+ * Allocates new slab and pushes all objects in it to the free list.
+ *
+ * This function returns 0 if it succeeds, or one of the following
+ * negative error codes:
+ *
+ * NGHTTP2_ERR_NOMEM
+ *     Out of memory.
+ */
+static int mempool_add_slab(nghttp2_mempool *pool) {
+  nghttp2_mempool_slab *slab;
+  nghttp2_mempool_obj *obj;
+  uint8_t *p;
+  size_t i;
+
+  slab = nghttp2_mem_malloc(
+      pool->mem, NGHTTP2_MEMPOOL_ALIGN_UP(sizeof(nghttp2_mempool_slab)) +
+                     pool->objsize * pool->slabobjs);
+  if (slab == NULL) {
+    return NGHTTP2_ERR_NOMEM;
+  }
+
+  slab->next = pool->slabs;
+  pool->slabs = slab;
+  ++pool->nslabs;
+
+  p = (uint8_t *)slab + NGHTTP2_MEMPOOL_ALIGN_UP(sizeof(nghttp2_mempool_slab));
+
+  /* Push in reverse order, so that objects are handed out in address
+     order. */
+  for (i = pool->slabobjs; i > 0; --i) {
+    obj = (nghttp2_mempool_obj *)(void *)(p + pool->objsize * (i - 1));
+    obj->next = pool->freelist;
+    pool->freelist = obj;
+  }
+
+  return 0;
+}
+
+void *nghttp2_mempool_alloc(nghttp2_mempool *pool) {
+  nghttp2_mempool_obj *obj;
+
+  if (pool->slabobjs == 0) {
+    return nghttp2_mem_malloc(pool->mem, pool->objsize);
+  }
+
+  if (pool->freelist == NULL && mempool_add_slab(pool) != 0) {
+    return NULL;
+  }
+
+  obj = pool->freelist;
+  pool->freelist = obj->next;
+
+  ++pool->nused;
+
+  return obj;
+}
+
+void nghttp2_mempool_release(nghttp2_mempool *pool, void *ptr) {
+  nghttp2_mempool_obj *obj;
+
+  if (pool->slabobjs == 0) {
+    nghttp2_mem_free(pool->mem, ptr);
+    return;
+  }
+
+  if (ptr == NULL) {
+    return;
+  }
+
+  assert(pool->nused > 0);
+
+  --pool->nused;
+
+  obj = ptr;
+  obj->next = pool->freelist;
+  pool->freelist = obj;
+}
+
+void nghttp2_mempool_get_stat(nghttp2_mempool *pool, nghttp2_slab_stat *stat) {
+  stat->nslabs = pool->nslabs;
+  stat->capacity = pool->nslabs * pool->slabobjs;
+  stat->used = pool->nused;
+}
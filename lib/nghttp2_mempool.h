@@ -0,0 +1,110 @@
+/*
+ * nghttp2 - HTTP/2 C Library
+ *
+ * Copyright (c) 2015 Tatsuhiro Tsujikawa
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef NGHTTP2_MEMPOOL_H
+#define NGHTTP2_MEMPOOL_H
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif /* HAVE_CONFIG_H */
+
+#include <nghttp2/nghttp2.h>
+
+#include "nghttp2_mem.h"
+
+typedef struct nghttp2_mempool_slab nghttp2_mempool_slab;
+
+/* Header of a memory block which holds fixed number of objects.  The
+   objects follow this header. */
+struct nghttp2_mempool_slab {
+  nghttp2_mempool_slab *next;
+};
+
+typedef struct nghttp2_mempool_obj nghttp2_mempool_obj;
+
+/* Unused object in a slab.  It is linked in free list. */
+struct nghttp2_mempool_obj {
+  nghttp2_mempool_obj *next;
+};
+
+/*
+ * Free list allocator for fixed size objects.  Objects are carved out
+ * of slabs, each of which holds |slabobjs| objects, and the released
+ * objects are kept in free list for reuse.  Slabs are not returned to
+ * the underlying allocator until nghttp2_mempool_free() is called.
+ *
+ * If |slabobjs| is 0, the pool is disabled, and each object is
+ * allocated and freed with |mem| individually.  In this case, no
+ * statistics are collected.
+ */
+typedef struct {
+  /* The list of allocated slabs */
+  nghttp2_mempool_slab *slabs;
+  /* The list of unused objects */
+  nghttp2_mempool_obj *freelist;
+  nghttp2_mem *mem;
+  /* The size of each object, rounded up to the alignment */
+  size_t objsize;
+  /* The number of objects in a slab */
+  size_t slabobjs;
+  /* The number of allocated slabs */
+  size_t nslabs;
+  /* The number of objects currently in use.  This is not counted if
+     the pool is disabled. */
+  size_t nused;
+} nghttp2_mempool;
+
+/*
+ * Initializes |pool| for objects of |objsize| bytes.  Each slab holds
+ * |slabobjs| objects.  If |slabobjs| is 0, pooling is disabled.  This
+ * function does not allocate memory, and always succeeds.
+ */
+void nghttp2_mempool_init(nghttp2_mempool *pool, size_t objsize,
+                          size_t slabobjs, nghttp2_mem *mem);
+
+/*
+ * Deallocates all slabs held by |pool|.  All objects allocated from
+ * |pool| become invalid.
+ */
+void nghttp2_mempool_free(nghttp2_mempool *pool);
+
+/*
+ * Allocates an object from |pool|.  The content of returned object is
+ * undefined.  This function returns NULL if it fails to allocate new
+ * slab.
+ */
+void *nghttp2_mempool_alloc(nghttp2_mempool *pool);
+
+/*
+ * Returns |ptr| allocated by nghttp2_mempool_alloc() to |pool|.  If
+ * |ptr| is NULL, this function does nothing.
+ */
+void nghttp2_mempool_release(nghttp2_mempool *pool, void *ptr);
+
+/*
+ * Fills |stat| with the current occupancy of |pool|.
+ */
+void nghttp2_mempool_get_stat(nghttp2_mempool *pool, nghttp2_slab_stat *stat);
+
+#endif /* NGHTTP2_MEMPOOL_H */
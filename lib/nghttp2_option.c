@@ -56,3 +56,32 @@ void nghttp2_option_set_no_http_messaging(nghttp2_option *option, int val) {
   option->opt_set_mask |= NGHTTP2_OPT_NO_HTTP_MESSAGING;
   option->no_http_messaging = val;
 }
+
+void nghttp2_option_set_slab_size(nghttp2_option *option, size_t val) {
+  option->opt_set_mask |= NGHTTP2_OPT_SLAB_SIZE;
+  option->slab_size = val;
+}
+
+void nghttp2_option_set_window_auto_tuning(nghttp2_option *option,
+                                           uint32_t val) {
+  option->opt_set_mask |= NGHTTP2_OPT_WINDOW_AUTO_TUNING;
+  option->max_auto_window_size = val;
+}
+
+void nghttp2_option_set_hd_string_cache(nghttp2_option *option,
+                                        const nghttp2_hd_string_cache *cache) {
+  option->opt_set_mask |= NGHTTP2_OPT_HD_STRING_CACHE;
+  option->hd_string_cache = cache;
+}
+
+void nghttp2_option_set_max_session_memory(nghttp2_option *option,
+                                           size_t val) {
+  option->opt_set_mask |= NGHTTP2_OPT_MAX_SESSION_MEMORY;
+  option->max_session_memory = val;
+}
+
+void nghttp2_option_set_connection_window_update_threshold(
+    nghttp2_option *option, uint32_t val) {
+  option->opt_set_mask |= NGHTTP2_OPT_CONNECTION_WINDOW_UPDATE_THRESHOLD;
+  option->connection_window_update_threshold = val;
+}
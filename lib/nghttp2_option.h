@@ -58,7 +58,12 @@ typedef enum {
    */
   NGHTTP2_OPT_PEER_MAX_CONCURRENT_STREAMS = 1 << 1,
   NGHTTP2_OPT_NO_RECV_CLIENT_MAGIC = 1 << 2,
-  NGHTTP2_OPT_NO_HTTP_MESSAGING = 1 << 3
+  NGHTTP2_OPT_NO_HTTP_MESSAGING = 1 << 3,
+  NGHTTP2_OPT_SLAB_SIZE = 1 << 4,
+  NGHTTP2_OPT_WINDOW_AUTO_TUNING = 1 << 5,
+  NGHTTP2_OPT_HD_STRING_CACHE = 1 << 6,
+  NGHTTP2_OPT_MAX_SESSION_MEMORY = 1 << 7,
+  NGHTTP2_OPT_CONNECTION_WINDOW_UPDATE_THRESHOLD = 1 << 8
 } nghttp2_option_flag;
 
 /**
@@ -74,6 +79,26 @@ struct nghttp2_option {
    * NGHTTP2_OPT_PEER_MAX_CONCURRENT_STREAMS
    */
   uint32_t peer_max_concurrent_streams;
+  /**
+   * NGHTTP2_OPT_SLAB_SIZE
+   */
+  size_t slab_size;
+  /**
+   * NGHTTP2_OPT_WINDOW_AUTO_TUNING
+   */
+  uint32_t max_auto_window_size;
+  /**
+   * NGHTTP2_OPT_HD_STRING_CACHE
+   */
+  const nghttp2_hd_string_cache *hd_string_cache;
+  /**
+   * NGHTTP2_OPT_MAX_SESSION_MEMORY
+   */
+  size_t max_session_memory;
+  /**
+   * NGHTTP2_OPT_CONNECTION_WINDOW_UPDATE_THRESHOLD
+   */
+  uint32_t connection_window_update_threshold;
   /**
    * NGHTTP2_OPT_NO_AUTO_WINDOW_UPDATE
    */
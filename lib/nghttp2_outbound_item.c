@@ -28,7 +28,6 @@
 #include <string.h>
 
 void nghttp2_outbound_item_init(nghttp2_outbound_item *item) {
-  item->cycle = 0;
   item->qnext = NULL;
   item->queued = 0;
 
@@ -43,9 +43,6 @@ typedef struct {
   /* nonzero if request HEADERS is canceled.  The error code is stored
      in |error_code|. */
   uint8_t canceled;
-  /* nonzero if this item should be attached to stream object to make
-     it under priority control */
-  uint8_t attach_stream;
 } nghttp2_headers_aux_data;
 
 /* struct used for DATA frame */
@@ -103,14 +100,6 @@ typedef struct nghttp2_outbound_item nghttp2_outbound_item;
 struct nghttp2_outbound_item {
   nghttp2_frame frame;
   nghttp2_aux_data aux_data;
-  /* The priority used in priority comparion.  Smaller is served
-     ealier.  For PING, SETTINGS and non-DATA frames (excluding
-     response HEADERS frame) have dedicated cycle value defined above.
-     For DATA frame, cycle is computed by taking into account of
-     effective weight and frame payload length previously sent, so
-     that the amount of transmission is distributed across streams
-     proportional to effective weight (inside a tree). */
-  uint64_t cycle;
   nghttp2_outbound_item *qnext;
   /* nonzero if this object is queued. */
   uint8_t queued;
@@ -24,16 +24,16 @@
  */
 #include "nghttp2_pq.h"
 
-int nghttp2_pq_init(nghttp2_pq *pq, nghttp2_less less, nghttp2_mem *mem) {
+#include <assert.h>
+
+#include "nghttp2_helper.h"
+
+void nghttp2_pq_init(nghttp2_pq *pq, nghttp2_less less, nghttp2_mem *mem) {
   pq->mem = mem;
-  pq->capacity = 128;
-  pq->q = nghttp2_mem_malloc(mem, pq->capacity * sizeof(void *));
-  if (pq->q == NULL) {
-    return NGHTTP2_ERR_NOMEM;
-  }
+  pq->capacity = 0;
+  pq->q = NULL;
   pq->length = 0;
   pq->less = less;
-  return 0;
 }
 
 void nghttp2_pq_free(nghttp2_pq *pq) {
@@ -42,41 +42,51 @@ void nghttp2_pq_free(nghttp2_pq *pq) {
 }
 
 static void swap(nghttp2_pq *pq, size_t i, size_t j) {
-  void *t = pq->q[i];
-  pq->q[i] = pq->q[j];
-  pq->q[j] = t;
+  nghttp2_pq_entry *a = pq->q[i];
+  nghttp2_pq_entry *b = pq->q[j];
+
+  pq->q[i] = b;
+  b->index = i;
+  pq->q[j] = a;
+  a->index = j;
 }
 
 static void bubble_up(nghttp2_pq *pq, size_t index) {
-  if (index == 0) {
-    return;
-  } else {
-    size_t parent = (index - 1) / 2;
-    if (pq->less(pq->q[index], pq->q[parent])) {
-      swap(pq, parent, index);
-      bubble_up(pq, parent);
+  size_t parent;
+
+  while (index != 0) {
+    parent = (index - 1) / 2;
+    if (!pq->less(pq->q[index], pq->q[parent])) {
+      return;
     }
+    swap(pq, parent, index);
+    index = parent;
   }
 }
 
-int nghttp2_pq_push(nghttp2_pq *pq, void *item) {
+int nghttp2_pq_push(nghttp2_pq *pq, nghttp2_pq_entry *item) {
   if (pq->capacity <= pq->length) {
     void *nq;
+    size_t ncapacity;
+
+    ncapacity = nghttp2_max(4, (pq->capacity * 2));
+
     nq = nghttp2_mem_realloc(pq->mem, pq->q,
-                             (pq->capacity * 2) * sizeof(void *));
+                             ncapacity * sizeof(nghttp2_pq_entry *));
     if (nq == NULL) {
       return NGHTTP2_ERR_NOMEM;
     }
-    pq->capacity *= 2;
+    pq->capacity = ncapacity;
     pq->q = nq;
   }
   pq->q[pq->length] = item;
+  item->index = pq->length;
   ++pq->length;
   bubble_up(pq, pq->length - 1);
   return 0;
 }
 
-void *nghttp2_pq_top(nghttp2_pq *pq) {
+nghttp2_pq_entry *nghttp2_pq_top(nghttp2_pq *pq) {
   if (pq->length == 0) {
     return NULL;
   } else {
@@ -85,32 +95,60 @@ void *nghttp2_pq_top(nghttp2_pq *pq) {
 }
 
 static void bubble_down(nghttp2_pq *pq, size_t index) {
-  size_t lchild = index * 2 + 1;
-  size_t minindex = index;
-  size_t i, j;
-  for (i = 0; i < 2; ++i) {
-    j = lchild + i;
-    if (j >= pq->length) {
-      break;
+  size_t i, j, minindex;
+
+  for (;;) {
+    j = index * 2 + 1;
+    minindex = index;
+    for (i = 0; i < 2; ++i, ++j) {
+      if (j >= pq->length) {
+        break;
+      }
+      if (pq->less(pq->q[j], pq->q[minindex])) {
+        minindex = j;
+      }
     }
-    if (pq->less(pq->q[j], pq->q[minindex])) {
-      minindex = j;
+    if (minindex == index) {
+      return;
     }
-  }
-  if (minindex != index) {
     swap(pq, index, minindex);
-    bubble_down(pq, minindex);
+    index = minindex;
   }
 }
 
 void nghttp2_pq_pop(nghttp2_pq *pq) {
   if (pq->length > 0) {
     pq->q[0] = pq->q[pq->length - 1];
+    pq->q[0]->index = 0;
     --pq->length;
     bubble_down(pq, 0);
   }
 }
 
+void nghttp2_pq_remove(nghttp2_pq *pq, nghttp2_pq_entry *item) {
+  assert(pq->q[item->index] == item);
+
+  if (item->index == 0) {
+    nghttp2_pq_pop(pq);
+    return;
+  }
+
+  if (item->index == pq->length - 1) {
+    --pq->length;
+    return;
+  }
+
+  pq->q[item->index] = pq->q[pq->length - 1];
+  pq->q[item->index]->index = item->index;
+  --pq->length;
+
+  if (pq->less(item, pq->q[item->index])) {
+    bubble_down(pq, item->index);
+  } else {
+    bubble_up(pq, item->index);
+  }
+}
+
 int nghttp2_pq_empty(nghttp2_pq *pq) { return pq->length == 0; }
 
 size_t nghttp2_pq_size(nghttp2_pq *pq) { return pq->length; }
@@ -35,9 +35,13 @@
 
 /* Implementation of priority queue */
 
+/* The entry embedded in the object stored in nghttp2_pq.  Use
+   nghttp2_struct_of() to get the object from the entry. */
+typedef struct { size_t index; } nghttp2_pq_entry;
+
 typedef struct {
   /* The pointer to the pointer to the item stored */
-  void **q;
+  nghttp2_pq_entry **q;
   /* Memory allocator */
   nghttp2_mem *mem;
   /* The number of items sotred */
@@ -50,15 +54,11 @@ typedef struct {
 } nghttp2_pq;
 
 /*
- * Initializes priority queue |pq| with compare function |cmp|.
- *
- * This function returns 0 if it succeeds, or one of the following
- * negative error codes:
- *
- * NGHTTP2_ERR_NOMEM
- *     Out of memory.
+ * Initializes priority queue |pq| with compare function |cmp|.  The
+ * |less| function receives the pointers to nghttp2_pq_entry.  No
+ * memory is allocated until the first item is pushed.
  */
-int nghttp2_pq_init(nghttp2_pq *pq, nghttp2_less less, nghttp2_mem *mem);
+void nghttp2_pq_init(nghttp2_pq *pq, nghttp2_less less, nghttp2_mem *mem);
 
 /*
  * Deallocates any resources allocated for |pq|.  The stored items are
@@ -75,13 +75,13 @@ void nghttp2_pq_free(nghttp2_pq *pq);
  * NGHTTP2_ERR_NOMEM
  *     Out of memory.
  */
-int nghttp2_pq_push(nghttp2_pq *pq, void *item);
+int nghttp2_pq_push(nghttp2_pq *pq, nghttp2_pq_entry *item);
 
 /*
  * Returns item at the top of the queue |pq|. If the queue is empty,
  * this function returns NULL.
  */
-void *nghttp2_pq_top(nghttp2_pq *pq);
+nghttp2_pq_entry *nghttp2_pq_top(nghttp2_pq *pq);
 
 /*
  * Pops item at the top of the queue |pq|. The popped item is not
@@ -99,7 +99,7 @@ int nghttp2_pq_empty(nghttp2_pq *pq);
  */
 size_t nghttp2_pq_size(nghttp2_pq *pq);
 
-typedef int (*nghttp2_pq_item_cb)(void *item, void *arg);
+typedef int (*nghttp2_pq_item_cb)(nghttp2_pq_entry *item, void *arg);
 
 /*
  * Updates each item in |pq| using function |fun| and re-construct
@@ -118,4 +118,10 @@ void nghttp2_pq_update(nghttp2_pq *pq, nghttp2_pq_item_cb fun, void *arg);
  */
 int nghttp2_pq_each(nghttp2_pq *pq, nghttp2_pq_item_cb fun, void *arg);
 
+/*
+ * Removes |item| from priority queue.  The |item| must be stored in
+ * |pq|.
+ */
+void nghttp2_pq_remove(nghttp2_pq *pq, nghttp2_pq_entry *item);
+
 #endif /* NGHTTP2_PQ_H */
@@ -34,6 +34,7 @@
 #include "nghttp2_priority_spec.h"
 #include "nghttp2_option.h"
 #include "nghttp2_http.h"
+#include "nghttp2_time.h"
 
 /*
  * Returns non-zero if the number of outgoing opened streams is larger
@@ -223,15 +224,6 @@ nghttp2_stream *nghttp2_session_get_stream_raw(nghttp2_session *session,
   return (nghttp2_stream *)nghttp2_map_find(&session->streams, stream_id);
 }
 
-static int outbound_item_less(const void *lhsx, const void *rhsx) {
-  const nghttp2_outbound_item *lhs, *rhs;
-
-  lhs = (const nghttp2_outbound_item *)lhsx;
-  rhs = (const nghttp2_outbound_item *)rhsx;
-
-  return (lhs->cycle < rhs->cycle) ? 1 : 0;
-}
-
 static void session_inbound_frame_reset(nghttp2_session *session) {
   nghttp2_inbound_frame *iframe = &session->iframe;
   nghttp2_mem *mem = &session->mem;
@@ -295,11 +287,12 @@ static void init_settings(nghttp2_settings_storage *settings) {
 }
 
 static void active_outbound_item_reset(nghttp2_active_outbound_item *aob,
+                                       nghttp2_mempool *item_pool,
                                        nghttp2_mem *mem) {
   DEBUGF(fprintf(stderr, "send: reset nghttp2_active_outbound_item\n"));
   DEBUGF(fprintf(stderr, "send: aob->item = %p\n", aob->item));
   nghttp2_outbound_item_free(aob->item, mem);
-  nghttp2_mem_free(mem, aob->item);
+  nghttp2_mempool_release(item_pool, aob->item);
   aob->item = NULL;
   nghttp2_bufs_reset(&aob->framebufs);
   aob->state = NGHTTP2_OB_POP_ITEM;
@@ -310,11 +303,73 @@ static void active_outbound_item_reset(nghttp2_active_outbound_item *aob,
 /* Specify NGHTTP2_EXTERN, so that we can test using Win build dll. */
 NGHTTP2_EXTERN int nghttp2_enable_strict_preface = 1;
 
+/*
+ * Returns the allocator which allocated |session| itself.
+ */
+static nghttp2_mem *session_get_base_mem(nghttp2_session *session) {
+  if (session->max_memory) {
+    return &session->mem_tracker.base;
+  }
+  return &session->mem;
+}
+
+/*
+ * Initializes the connection level state of |session| which does not
+ * depend on allocation: flow control windows, settings, stream IDs
+ * and the connection preface handling.  |session->iframe| and
+ * |session->aob| must be reset before this call.
+ */
+static void session_init_state(nghttp2_session *session) {
+  nghttp2_inbound_frame *iframe = &session->iframe;
+
+  session->remote_window_size = NGHTTP2_INITIAL_CONNECTION_WINDOW_SIZE;
+  session->recv_window_size = 0;
+  session->consumed_size = 0;
+  session->recv_reduction = 0;
+  session->local_window_size = NGHTTP2_INITIAL_CONNECTION_WINDOW_SIZE;
+
+  session->goaway_flags = NGHTTP2_GOAWAY_NONE;
+  session->local_last_stream_id = (1u << 31) - 1;
+  session->remote_last_stream_id = (1u << 31) - 1;
+
+  session->inflight_niv = -1;
+
+  session->pending_local_max_concurrent_stream =
+      NGHTTP2_INITIAL_MAX_CONCURRENT_STREAMS;
+  session->pending_enable_push = 1;
+
+  init_settings(&session->remote_settings);
+  init_settings(&session->local_settings);
+
+  session->remote_settings.max_concurrent_streams =
+      session->peer_max_concurrent_streams;
+
+  /* IDs for use in client are odd, and server even */
+  session->next_stream_id = session->server ? 2 : 1;
+
+  if (nghttp2_enable_strict_preface) {
+    if (session->server &&
+        (session->opt_flags & NGHTTP2_OPTMASK_NO_RECV_CLIENT_MAGIC) == 0) {
+      iframe->state = NGHTTP2_IB_READ_CLIENT_MAGIC;
+      iframe->payloadleft = NGHTTP2_CLIENT_MAGIC_LEN;
+    } else {
+      iframe->state = NGHTTP2_IB_READ_FIRST_SETTINGS;
+    }
+
+    if (!session->server) {
+      session->aob.state = NGHTTP2_OB_SEND_CLIENT_MAGIC;
+      nghttp2_bufs_add(&session->aob.framebufs, NGHTTP2_CLIENT_MAGIC,
+                       NGHTTP2_CLIENT_MAGIC_LEN);
+    }
+  }
+}
+
 static int session_new(nghttp2_session **session_ptr,
                        const nghttp2_session_callbacks *callbacks,
                        void *user_data, int server,
                        const nghttp2_option *option, nghttp2_mem *mem) {
   int rv;
+  size_t slab_size = 0;
 
   if (mem == NULL) {
     mem = nghttp2_mem_default();
@@ -326,17 +381,27 @@ static int session_new(nghttp2_session **session_ptr,
     goto fail_session;
   }
 
-  (*session_ptr)->mem = *mem;
+  if (option && (option->opt_set_mask & NGHTTP2_OPT_MAX_SESSION_MEMORY) &&
+      option->max_session_memory) {
+    (*session_ptr)->max_memory = option->max_session_memory;
+    nghttp2_mem_tracker_init(&(*session_ptr)->mem_tracker,
+                             &(*session_ptr)->mem, mem);
+  } else {
+    (*session_ptr)->mem = *mem;
+  }
   mem = &(*session_ptr)->mem;
 
-  /* next_stream_id is initialized in either
-     nghttp2_session_client_new2 or nghttp2_session_server_new2 */
-
-  rv = nghttp2_pq_init(&(*session_ptr)->ob_da_pq, outbound_item_less, mem);
-  if (rv != 0) {
-    goto fail_ob_da_pq;
+  if (option && (option->opt_set_mask & NGHTTP2_OPT_SLAB_SIZE)) {
+    slab_size = option->slab_size;
   }
 
+  nghttp2_mempool_init(&(*session_ptr)->stream_pool, sizeof(nghttp2_stream),
+                       slab_size, mem);
+  nghttp2_mempool_init(&(*session_ptr)->item_pool,
+                       sizeof(nghttp2_outbound_item), slab_size, mem);
+  nghttp2_mempool_init(&(*session_ptr)->tombstone_pool,
+                       sizeof(nghttp2_stream_tombstone), slab_size, mem);
+
   rv = nghttp2_hd_deflate_init(&(*session_ptr)->hd_deflater, mem);
   if (rv != 0) {
     goto fail_hd_deflater;
@@ -350,23 +415,11 @@ static int session_new(nghttp2_session **session_ptr,
     goto fail_map;
   }
 
-  nghttp2_stream_roots_init(&(*session_ptr)->roots);
-
-  (*session_ptr)->remote_window_size = NGHTTP2_INITIAL_CONNECTION_WINDOW_SIZE;
-  (*session_ptr)->recv_window_size = 0;
-  (*session_ptr)->consumed_size = 0;
-  (*session_ptr)->recv_reduction = 0;
-  (*session_ptr)->local_window_size = NGHTTP2_INITIAL_CONNECTION_WINDOW_SIZE;
-
-  (*session_ptr)->goaway_flags = NGHTTP2_GOAWAY_NONE;
-  (*session_ptr)->local_last_stream_id = (1u << 31) - 1;
-  (*session_ptr)->remote_last_stream_id = (1u << 31) - 1;
-
-  (*session_ptr)->inflight_niv = -1;
+  nghttp2_stream_roots_init(&(*session_ptr)->roots, mem);
 
-  (*session_ptr)->pending_local_max_concurrent_stream =
+  (*session_ptr)->peer_max_concurrent_streams =
       NGHTTP2_INITIAL_MAX_CONCURRENT_STREAMS;
-  (*session_ptr)->pending_enable_push = 1;
+  (*session_ptr)->connection_window_update_threshold = 50;
 
   if (server) {
     (*session_ptr)->server = 1;
@@ -380,10 +433,8 @@ static int session_new(nghttp2_session **session_ptr,
     goto fail_aob_framebuf;
   }
 
-  active_outbound_item_reset(&(*session_ptr)->aob, mem);
-
-  init_settings(&(*session_ptr)->remote_settings);
-  init_settings(&(*session_ptr)->local_settings);
+  active_outbound_item_reset(&(*session_ptr)->aob, &(*session_ptr)->item_pool,
+                             mem);
 
   if (option) {
     if ((option->opt_set_mask & NGHTTP2_OPT_NO_AUTO_WINDOW_UPDATE) &&
@@ -394,7 +445,7 @@ static int session_new(nghttp2_session **session_ptr,
 
     if (option->opt_set_mask & NGHTTP2_OPT_PEER_MAX_CONCURRENT_STREAMS) {
 
-      (*session_ptr)->remote_settings.max_concurrent_streams =
+      (*session_ptr)->peer_max_concurrent_streams =
           option->peer_max_concurrent_streams;
     }
 
@@ -409,32 +460,33 @@ static int session_new(nghttp2_session **session_ptr,
 
       (*session_ptr)->opt_flags |= NGHTTP2_OPTMASK_NO_HTTP_MESSAGING;
     }
-  }
 
-  (*session_ptr)->callbacks = *callbacks;
-  (*session_ptr)->user_data = user_data;
+    if (option->opt_set_mask & NGHTTP2_OPT_WINDOW_AUTO_TUNING) {
 
-  session_inbound_frame_reset(*session_ptr);
+      (*session_ptr)->window_tuner.max_window_size = (int32_t)nghttp2_min(
+          option->max_auto_window_size, NGHTTP2_MAX_WINDOW_SIZE);
+    }
 
-  if (nghttp2_enable_strict_preface) {
-    nghttp2_inbound_frame *iframe = &(*session_ptr)->iframe;
+    if (option->opt_set_mask &
+        NGHTTP2_OPT_CONNECTION_WINDOW_UPDATE_THRESHOLD) {
 
-    if (server &&
-        ((*session_ptr)->opt_flags & NGHTTP2_OPTMASK_NO_RECV_CLIENT_MAGIC) ==
-            0) {
-      iframe->state = NGHTTP2_IB_READ_CLIENT_MAGIC;
-      iframe->payloadleft = NGHTTP2_CLIENT_MAGIC_LEN;
-    } else {
-      iframe->state = NGHTTP2_IB_READ_FIRST_SETTINGS;
+      (*session_ptr)->connection_window_update_threshold = nghttp2_min(
+          nghttp2_max(option->connection_window_update_threshold, 1), 100);
     }
 
-    if (!server) {
-      (*session_ptr)->aob.state = NGHTTP2_OB_SEND_CLIENT_MAGIC;
-      nghttp2_bufs_add(&(*session_ptr)->aob.framebufs, NGHTTP2_CLIENT_MAGIC,
-                       NGHTTP2_CLIENT_MAGIC_LEN);
+    if (option->opt_set_mask & NGHTTP2_OPT_HD_STRING_CACHE) {
+      nghttp2_hd_deflate_set_string_cache(&(*session_ptr)->hd_deflater,
+                                          option->hd_string_cache);
     }
   }
 
+  (*session_ptr)->callbacks = *callbacks;
+  (*session_ptr)->user_data = user_data;
+
+  session_inbound_frame_reset(*session_ptr);
+
+  session_init_state(*session_ptr);
+
   return 0;
 
 fail_aob_framebuf:
@@ -444,9 +496,7 @@ fail_map:
 fail_hd_inflater:
   nghttp2_hd_deflate_free(&(*session_ptr)->hd_deflater);
 fail_hd_deflater:
-  nghttp2_pq_free(&(*session_ptr)->ob_da_pq);
-fail_ob_da_pq:
-  nghttp2_mem_free(mem, *session_ptr);
+  nghttp2_mem_free(session_get_base_mem(*session_ptr), *session_ptr);
 fail_session:
   return rv;
 }
@@ -477,9 +527,6 @@ int nghttp2_session_client_new3(nghttp2_session **session_ptr,
   if (rv != 0) {
     return rv;
   }
-  /* IDs for use in client */
-  session->next_stream_id = 1;
-
   *session_ptr = session;
 
   return 0;
@@ -511,9 +558,6 @@ int nghttp2_session_server_new3(nghttp2_session **session_ptr,
   if (rv != 0) {
     return rv;
   }
-  /* IDs for use in client */
-  session->next_stream_id = 2;
-
   *session_ptr = session;
 
   return 0;
@@ -532,37 +576,39 @@ static int free_streams(nghttp2_map_entry *entry, void *ptr) {
 
   if (item && !item->queued && item != session->aob.item) {
     nghttp2_outbound_item_free(item, mem);
-    nghttp2_mem_free(mem, item);
+    nghttp2_mempool_release(&session->item_pool, item);
   }
 
   nghttp2_stream_free(stream);
-  nghttp2_mem_free(mem, stream);
+  nghttp2_mempool_release(&session->stream_pool, stream);
 
   return 0;
 }
 
-static void ob_pq_free(nghttp2_pq *pq, nghttp2_mem *mem) {
-  while (!nghttp2_pq_empty(pq)) {
-    nghttp2_outbound_item *item = (nghttp2_outbound_item *)nghttp2_pq_top(pq);
-    nghttp2_outbound_item_free(item, mem);
-    nghttp2_mem_free(mem, item);
-    nghttp2_pq_pop(pq);
-  }
-  nghttp2_pq_free(pq);
+static int free_tombstones(nghttp2_map_entry *entry, void *ptr) {
+  nghttp2_session *session;
+
+  session = (nghttp2_session *)ptr;
+
+  nghttp2_mempool_release(&session->tombstone_pool, entry);
+
+  return 0;
 }
 
-static void ob_q_free(nghttp2_outbound_queue *q, nghttp2_mem *mem) {
+static void ob_q_free(nghttp2_outbound_queue *q, nghttp2_mempool *item_pool,
+                      nghttp2_mem *mem) {
   nghttp2_outbound_item *item, *next;
   for (item = q->head; item;) {
     next = item->qnext;
     nghttp2_outbound_item_free(item, mem);
-    nghttp2_mem_free(mem, item);
+    nghttp2_mempool_release(item_pool, item);
     item = next;
   }
 }
 
 void nghttp2_session_del(nghttp2_session *session) {
   nghttp2_mem *mem;
+  size_t i;
 
   if (session == NULL) {
     return;
@@ -579,16 +625,406 @@ void nghttp2_session_del(nghttp2_session *session) {
   nghttp2_map_each_free(&session->streams, free_streams, session);
   nghttp2_map_free(&session->streams);
 
-  ob_q_free(&session->ob_urgent, mem);
-  ob_q_free(&session->ob_reg, mem);
-  ob_q_free(&session->ob_syn, mem);
-  ob_pq_free(&session->ob_da_pq, mem);
-  active_outbound_item_reset(&session->aob, mem);
+  if (session->tombstones.table) {
+    nghttp2_map_each_free(&session->tombstones, free_tombstones, session);
+    nghttp2_map_free(&session->tombstones);
+  }
+
+  ob_q_free(&session->ob_urgent, &session->item_pool, mem);
+  ob_q_free(&session->ob_reg, &session->item_pool, mem);
+  ob_q_free(&session->ob_syn, &session->item_pool, mem);
+  active_outbound_item_reset(&session->aob, &session->item_pool, mem);
   session_inbound_frame_reset(session);
   nghttp2_hd_deflate_free(&session->hd_deflater);
   nghttp2_hd_inflate_free(&session->hd_inflater);
   nghttp2_bufs_free(&session->aob.framebufs);
-  nghttp2_mem_free(mem, session);
+  for (i = 0; i < session->aob.sendv_nbufs; ++i) {
+    nghttp2_bufs_free(&session->aob.sendv_bufs[i]);
+  }
+  nghttp2_mem_free(mem, session->aob.sendv_bufs);
+  nghttp2_mempool_free(&session->item_pool);
+  nghttp2_mempool_free(&session->stream_pool);
+  nghttp2_mempool_free(&session->tombstone_pool);
+  nghttp2_mem_free(session_get_base_mem(session), session);
+}
+
+void nghttp2_session_reset(nghttp2_session *session,
+                           const nghttp2_session_callbacks *callbacks,
+                           void *user_data) {
+  nghttp2_mem *mem;
+
+  mem = &session->mem;
+
+  nghttp2_mem_free(mem, session->inflight_iv);
+  session->inflight_iv = NULL;
+
+  nghttp2_stream_roots_free(&session->roots);
+
+  /* Have to free streams first, so that we can check
+     stream->item->queued.  The hash table is kept for the next
+     connection. */
+  nghttp2_map_each_free(&session->streams, free_streams, session);
+  nghttp2_map_each_free(&session->tombstones, free_tombstones, session);
+
+  ob_q_free(&session->ob_urgent, &session->item_pool, mem);
+  ob_q_free(&session->ob_reg, &session->item_pool, mem);
+  ob_q_free(&session->ob_syn, &session->item_pool, mem);
+  nghttp2_outbound_queue_init(&session->ob_urgent);
+  nghttp2_outbound_queue_init(&session->ob_reg);
+  nghttp2_outbound_queue_init(&session->ob_syn);
+
+  active_outbound_item_reset(&session->aob, &session->item_pool, mem);
+
+  session_inbound_frame_reset(session);
+
+  nghttp2_stream_roots_init(&session->roots, mem);
+
+  nghttp2_hd_deflate_reset(&session->hd_deflater);
+  nghttp2_hd_inflate_reset(&session->hd_inflater);
+
+  session->closed_stream_head = NULL;
+  session->closed_stream_tail = NULL;
+  session->idle_stream_head = NULL;
+  session->idle_stream_tail = NULL;
+  session->tombstone_head = NULL;
+  session->tombstone_tail = NULL;
+
+  session->num_outgoing_streams = 0;
+  session->num_incoming_streams = 0;
+  session->num_closed_streams = 0;
+  session->num_idle_streams = 0;
+  session->num_tombstones = 0;
+  session->nvbuflen = 0;
+
+  session->last_recv_stream_id = 0;
+  session->last_proc_stream_id = 0;
+  session->next_unique_id = 0;
+
+  session->window_tuner.ping_sent_time = 0;
+  session->window_tuner.ping_ack_time = 0;
+  session->window_tuner.rtt = 0;
+  session->window_tuner.last_update_time = 0;
+  session->window_tuner.window_size = 0;
+  session->window_tuner.ping_pending = 0;
+
+  memset(&session->stats, 0, sizeof(session->stats));
+
+  session->window_update_item = NULL;
+  session->submission_queue = NULL;
+
+  if (callbacks) {
+    session->callbacks = *callbacks;
+  }
+  session->user_data = user_data;
+
+  session_init_state(session);
+}
+
+/*
+ * Returns the number of bytes allocated by |session| which counts
+ * against the memory budget.  The unused objects in slabs are
+ * excluded because they are reused for new streams and frames.
+ */
+static size_t session_get_mem_used(nghttp2_session *session) {
+  nghttp2_slab_stat stream_stat, item_stat, tombstone_stat;
+
+  if (session->max_memory == 0) {
+    return 0;
+  }
+
+  nghttp2_mempool_get_stat(&session->stream_pool, &stream_stat);
+  nghttp2_mempool_get_stat(&session->item_pool, &item_stat);
+  nghttp2_mempool_get_stat(&session->tombstone_pool, &tombstone_stat);
+
+  return session->mem_tracker.used -
+         (stream_stat.capacity - stream_stat.used) *
+             session->stream_pool.objsize -
+         (item_stat.capacity - item_stat.used) * session->item_pool.objsize -
+         (tombstone_stat.capacity - tombstone_stat.used) *
+             session->tombstone_pool.objsize;
+}
+
+/*
+ * Removes |tomb| from the tombstones of |session|.  This function
+ * does not free |tomb|.
+ */
+static void session_detach_tombstone(nghttp2_session *session,
+                                     nghttp2_stream_tombstone *tomb) {
+  if (tomb->prev) {
+    tomb->prev->next = tomb->next;
+  } else {
+    session->tombstone_head = tomb->next;
+  }
+
+  if (tomb->next) {
+    tomb->next->prev = tomb->prev;
+  } else {
+    session->tombstone_tail = tomb->prev;
+  }
+
+  tomb->prev = NULL;
+  tomb->next = NULL;
+
+  nghttp2_map_remove(&session->tombstones, tomb->map_entry.key);
+
+  --session->num_tombstones;
+}
+
+/*
+ * Deletes |stream| from memory, and keeps its tombstone instead.
+ * |stream| must not have descendant in the dependency tree.
+ *
+ * This function returns 0 if it succeeds, or one of the following
+ * negative error codes:
+ *
+ * NGHTTP2_ERR_NOMEM
+ *     Out of memory
+ */
+static int session_keep_tombstone(nghttp2_session *session,
+                                  nghttp2_stream *stream) {
+  nghttp2_stream_tombstone *tomb;
+  nghttp2_stream *dep_stream;
+  int rv;
+
+  if (session->tombstones.table == NULL) {
+    rv = nghttp2_map_init(&session->tombstones, &session->mem);
+    if (rv != 0) {
+      return rv;
+    }
+  }
+
+  tomb = nghttp2_mempool_alloc(&session->tombstone_pool);
+  if (tomb == NULL) {
+    return NGHTTP2_ERR_NOMEM;
+  }
+
+  nghttp2_map_entry_init(&tomb->map_entry, stream->stream_id);
+
+  dep_stream = nghttp2_stream_get_dep_parent(stream);
+
+  tomb->dep_stream_id = dep_stream ? dep_stream->stream_id : 0;
+  tomb->weight = stream->weight;
+  tomb->prev = session->tombstone_tail;
+  tomb->next = NULL;
+
+  rv = nghttp2_map_insert(&session->tombstones, &tomb->map_entry);
+  if (rv != 0) {
+    nghttp2_mempool_release(&session->tombstone_pool, tomb);
+    return rv;
+  }
+
+  if (session->tombstone_tail) {
+    session->tombstone_tail->next = tomb;
+  } else {
+    session->tombstone_head = tomb;
+  }
+  session->tombstone_tail = tomb;
+
+  ++session->num_tombstones;
+
+  DEBUGF(fprintf(stderr, "stream: keep tombstone of stream(%p)=%d, "
+                         "dep_stream_id=%d, weight=%d\n",
+                 stream, stream->stream_id, tomb->dep_stream_id,
+                 tomb->weight));
+
+  return nghttp2_session_destroy_stream(session, stream);
+}
+
+/*
+ * Turns the tombstone of |stream_id| back to the closed stream, and
+ * puts it in the dependency tree as it was.  If the stream it
+ * depended on has gone, it gets the default priority.  If there is
+ * such tombstone, the stream is assigned to |*stream_ptr|, otherwise
+ * NULL is assigned.
+ *
+ * This function returns 0 if it succeeds, or one of the following
+ * negative error codes:
+ *
+ * NGHTTP2_ERR_NOMEM
+ *     Out of memory
+ */
+static int session_promote_tombstone(nghttp2_session *session,
+                                     nghttp2_stream **stream_ptr,
+                                     int32_t stream_id) {
+  nghttp2_stream_tombstone *tomb;
+  nghttp2_stream *stream, *dep_stream = NULL;
+  int32_t weight;
+  int rv;
+
+  *stream_ptr = NULL;
+
+  if (session->num_tombstones == 0) {
+    return 0;
+  }
+
+  tomb = (nghttp2_stream_tombstone *)nghttp2_map_find(&session->tombstones,
+                                                      stream_id);
+  if (tomb == NULL) {
+    return 0;
+  }
+
+  weight = tomb->weight;
+
+  if (tomb->dep_stream_id != 0) {
+    dep_stream = nghttp2_session_get_stream_raw(session, tomb->dep_stream_id);
+
+    if (!dep_stream || !nghttp2_stream_in_dep_tree(dep_stream) ||
+        nghttp2_stream_get_dep_root(dep_stream)->num_substreams >=
+            NGHTTP2_MAX_DEP_TREE_LENGTH) {
+      dep_stream = NULL;
+      weight = NGHTTP2_DEFAULT_WEIGHT;
+    }
+  }
+
+  stream = nghttp2_mempool_alloc(&session->stream_pool);
+  if (stream == NULL) {
+    return NGHTTP2_ERR_NOMEM;
+  }
+
+  nghttp2_stream_init(stream, stream_id, NGHTTP2_STREAM_FLAG_CLOSED,
+                      NGHTTP2_STREAM_CLOSING, weight, &session->roots,
+                      session->remote_settings.initial_window_size,
+                      session->local_settings.initial_window_size, NULL,
+                      &session->mem);
+
+  rv = nghttp2_map_insert(&session->streams, &stream->map_entry);
+  if (rv != 0) {
+    nghttp2_stream_free(stream);
+    nghttp2_mempool_release(&session->stream_pool, stream);
+    return rv;
+  }
+
+  DEBUGF(fprintf(stderr, "stream: promote tombstone of stream(%p)=%d\n",
+                 stream, stream_id));
+
+  session_detach_tombstone(session, tomb);
+  nghttp2_mempool_release(&session->tombstone_pool, tomb);
+
+  if (dep_stream) {
+    nghttp2_stream_dep_add(dep_stream, stream);
+  } else {
+    ++session->roots.num_streams;
+    nghttp2_stream_roots_add(&session->roots, stream);
+  }
+
+  /* The tombstone counted toward the limit of closed streams, so we
+     do not have to adjust them here. */
+  if (session->closed_stream_tail) {
+    session->closed_stream_tail->closed_next = stream;
+    stream->closed_prev = session->closed_stream_tail;
+  } else {
+    session->closed_stream_head = stream;
+  }
+  session->closed_stream_tail = stream;
+
+  ++session->num_closed_streams;
+
+  *stream_ptr = stream;
+
+  return 0;
+}
+
+/*
+ * Deletes the oldest tombstone, or the oldest closed stream if there
+ * is no tombstone.  |session| must have at least one of them.
+ *
+ * This function returns 0 if it succeeds, or one of the following
+ * negative error codes:
+ *
+ * NGHTTP2_ERR_NOMEM
+ *     Out of memory
+ */
+static int session_drop_closed_stream(nghttp2_session *session) {
+  nghttp2_stream_tombstone *tomb;
+  nghttp2_stream *head_stream;
+  int rv;
+
+  tomb = session->tombstone_head;
+
+  if (tomb) {
+    session_detach_tombstone(session, tomb);
+    nghttp2_mempool_release(&session->tombstone_pool, tomb);
+
+    return 0;
+  }
+
+  head_stream = session->closed_stream_head;
+
+  assert(head_stream);
+
+  session->closed_stream_head = head_stream->closed_next;
+
+  if (session->closed_stream_head) {
+    session->closed_stream_head->closed_prev = NULL;
+  } else {
+    session->closed_stream_tail = NULL;
+  }
+
+  rv = nghttp2_session_destroy_stream(session, head_stream);
+  if (rv != 0) {
+    return rv;
+  }
+  /* head_stream is now freed */
+  --session->num_closed_streams;
+
+  return 0;
+}
+
+/*
+ * Deletes tombstones and closed streams while the memory usage of
+ * |session| is over the half of the budget.  The number of them kept
+ * is the limit nghttp2_session_adjust_closed_stream() uses, or
+ * NGHTTP2_MEM_CLOSED_STREAM_MAX if it is unlimited, scaled linearly
+ * by the remaining budget, so that nothing is kept when the budget is
+ * exhausted.
+ *
+ * This function returns 0 if it succeeds, or one of the following
+ * negative error codes:
+ *
+ * NGHTTP2_ERR_NOMEM
+ *     Out of memory
+ */
+static int session_adapt_closed_stream(nghttp2_session *session) {
+  size_t used, half, headroom, num_stream_max, num_kept_max;
+  int rv;
+
+  if (session->max_memory == 0) {
+    return 0;
+  }
+
+  used = session_get_mem_used(session);
+  half = session->max_memory / 2;
+
+  if (used <= half) {
+    return 0;
+  }
+
+  headroom = used < session->max_memory ? session->max_memory - used : 0;
+
+  num_stream_max = nghttp2_min(session->local_settings.max_concurrent_streams,
+                               session->pending_local_max_concurrent_stream);
+
+  if (num_stream_max >= NGHTTP2_INITIAL_MAX_CONCURRENT_STREAMS) {
+    num_stream_max = NGHTTP2_MEM_CLOSED_STREAM_MAX;
+  }
+
+  /* In 1/16 steps, so that the multiplication does not overflow */
+  num_kept_max = (size_t)((uint64_t)num_stream_max *
+                          (headroom / (half / 16 + 1)) / 16);
+
+  DEBUGF(fprintf(stderr, "stream: memory used=%zu, max=%zu, "
+                         "keeping at most %zu closed streams\n",
+                 used, session->max_memory, num_kept_max));
+
+  while (session->num_closed_streams + session->num_tombstones >
+         num_kept_max) {
+    rv = session_drop_closed_stream(session);
+    if (rv != 0) {
+      return rv;
+    }
+  }
+
+  return 0;
 }
 
 int
@@ -610,6 +1046,13 @@ nghttp2_session_reprioritize_stream(nghttp2_session *session,
   if (pri_spec->stream_id != 0) {
     dep_stream = nghttp2_session_get_stream_raw(session, pri_spec->stream_id);
 
+    if (session->server && !dep_stream) {
+      rv = session_promote_tombstone(session, &dep_stream, pri_spec->stream_id);
+      if (rv != 0) {
+        return rv;
+      }
+    }
+
     if (session->server && !dep_stream &&
         session_detect_idle_stream(session, pri_spec->stream_id)) {
 
@@ -705,23 +1148,13 @@ int nghttp2_session_add_item(nghttp2_session *session,
       /* TODO If 2 HEADERS are submitted for reserved stream, then
          both of them are queued into ob_syn, which is not
          desirable. */
-      if (frame->headers.cat == NGHTTP2_HCAT_REQUEST) {
+      if (frame->headers.cat == NGHTTP2_HCAT_REQUEST ||
+          (stream && stream->state == NGHTTP2_STREAM_RESERVED)) {
         nghttp2_outbound_queue_push(&session->ob_syn, item);
         item->queued = 1;
         break;
       }
 
-      if (stream && (stream->state == NGHTTP2_STREAM_RESERVED ||
-                     item->aux_data.headers.attach_stream)) {
-        rv = nghttp2_stream_attach_item(stream, item, session);
-
-        if (rv != 0) {
-          return rv;
-        }
-
-        break;
-      }
-
       nghttp2_outbound_queue_push(&session->ob_reg, item);
       item->queued = 1;
       break;
@@ -766,9 +1199,7 @@ int nghttp2_session_add_rst_stream(nghttp2_session *session, int32_t stream_id,
   nghttp2_outbound_item *item;
   nghttp2_frame *frame;
   nghttp2_stream *stream;
-  nghttp2_mem *mem;
 
-  mem = &session->mem;
   stream = nghttp2_session_get_stream(session, stream_id);
   if (stream && stream->state == NGHTTP2_STREAM_CLOSING) {
     return 0;
@@ -808,7 +1239,7 @@ int nghttp2_session_add_rst_stream(nghttp2_session *session, int32_t stream_id,
     }
   }
 
-  item = nghttp2_mem_malloc(mem, sizeof(nghttp2_outbound_item));
+  item = nghttp2_mempool_alloc(&session->item_pool);
   if (item == NULL) {
     return NGHTTP2_ERR_NOMEM;
   }
@@ -821,7 +1252,7 @@ int nghttp2_session_add_rst_stream(nghttp2_session *session, int32_t stream_id,
   rv = nghttp2_session_add_item(session, item);
   if (rv != 0) {
     nghttp2_frame_rst_stream_free(&frame->rst_stream);
-    nghttp2_mem_free(mem, item);
+    nghttp2_mempool_release(&session->item_pool, item);
     return rv;
   }
   return 0;
@@ -848,15 +1279,23 @@ nghttp2_stream *nghttp2_session_open_stream(nghttp2_session *session,
     assert(stream->state == NGHTTP2_STREAM_IDLE);
     assert(nghttp2_stream_in_dep_tree(stream));
     nghttp2_session_detach_idle_stream(session, stream);
-    nghttp2_stream_dep_remove(stream);
+    rv = nghttp2_stream_dep_remove(stream);
+    if (rv != 0) {
+      return NULL;
+    }
+    /* stream is initialized again below */
+    nghttp2_stream_free(stream);
   } else {
     if (session->server && initial_state != NGHTTP2_STREAM_IDLE &&
         !nghttp2_session_is_my_stream_id(session, stream_id)) {
 
-      nghttp2_session_adjust_closed_stream(session, 1);
+      rv = nghttp2_session_adjust_closed_stream(session, 1);
+      if (rv != 0) {
+        return NULL;
+      }
     }
 
-    stream = nghttp2_mem_malloc(mem, sizeof(nghttp2_stream));
+    stream = nghttp2_mempool_alloc(&session->stream_pool);
     if (stream == NULL) {
       return NULL;
     }
@@ -867,6 +1306,17 @@ nghttp2_stream *nghttp2_session_open_stream(nghttp2_session *session,
   if (pri_spec->stream_id != 0) {
     dep_stream = nghttp2_session_get_stream_raw(session, pri_spec->stream_id);
 
+    if (session->server && !dep_stream) {
+      rv = session_promote_tombstone(session, &dep_stream, pri_spec->stream_id);
+      if (rv != 0) {
+        if (stream_alloc) {
+          nghttp2_mempool_release(&session->stream_pool, stream);
+        }
+
+        return NULL;
+      }
+    }
+
     if (session->server && !dep_stream &&
         session_detect_idle_stream(session, pri_spec->stream_id)) {
       /* Depends on idle stream, which does not exist in memory.
@@ -879,7 +1329,7 @@ nghttp2_stream *nghttp2_session_open_stream(nghttp2_session *session,
 
       if (dep_stream == NULL) {
         if (stream_alloc) {
-          nghttp2_mem_free(mem, stream);
+          nghttp2_mempool_release(&session->stream_pool, stream);
         }
 
         return NULL;
@@ -899,12 +1349,12 @@ nghttp2_stream *nghttp2_session_open_stream(nghttp2_session *session,
   nghttp2_stream_init(
       stream, stream_id, flags, initial_state, pri_spec->weight,
       &session->roots, session->remote_settings.initial_window_size,
-      session->local_settings.initial_window_size, stream_user_data);
+      session->local_settings.initial_window_size, stream_user_data, mem);
 
   if (stream_alloc) {
     rv = nghttp2_map_insert(&session->streams, &stream->map_entry);
     if (rv != 0) {
-      nghttp2_mem_free(mem, stream);
+      nghttp2_mempool_release(&session->stream_pool, stream);
       return NULL;
     }
   }
@@ -925,7 +1375,10 @@ nghttp2_stream *nghttp2_session_open_stream(nghttp2_session *session,
     /* Idle stream does not count toward the concurrent streams limit.
        This is used as anchor node in dependency tree. */
     assert(session->server);
-    nghttp2_session_keep_idle_stream(session, stream);
+    rv = nghttp2_session_keep_idle_stream(session, stream);
+    if (rv != 0) {
+      return NULL;
+    }
     break;
   default:
     if (nghttp2_session_is_my_stream_id(session, stream_id)) {
@@ -947,10 +1400,9 @@ nghttp2_stream *nghttp2_session_open_stream(nghttp2_session *session,
     if (pri_spec->exclusive &&
         session->roots.num_streams <= NGHTTP2_MAX_DEP_TREE_LENGTH) {
       rv = nghttp2_stream_dep_all_your_stream_are_belong_to_us(stream, session);
-
-      /* Since no dpri is changed in dependency tree, the above
-         function call never fail. */
-      assert(rv == 0);
+      if (rv != 0) {
+        return NULL;
+      }
     } else {
       nghttp2_stream_roots_add(&session->roots, stream);
     }
@@ -968,7 +1420,10 @@ nghttp2_stream *nghttp2_session_open_stream(nghttp2_session *session,
 
   if (root_stream->num_substreams < NGHTTP2_MAX_DEP_TREE_LENGTH) {
     if (pri_spec->exclusive) {
-      nghttp2_stream_dep_insert(dep_stream, stream);
+      rv = nghttp2_stream_dep_insert(dep_stream, stream);
+      if (rv != 0) {
+        return NULL;
+      }
     } else {
       nghttp2_stream_dep_add(dep_stream, stream);
     }
@@ -1014,7 +1469,7 @@ int nghttp2_session_close_stream(nghttp2_session *session, int32_t stream_id,
        free the item. */
     if (!item->queued && item != session->aob.item) {
       nghttp2_outbound_item_free(item, mem);
-      nghttp2_mem_free(mem, item);
+      nghttp2_mempool_release(&session->item_pool, item);
     }
   }
 
@@ -1050,50 +1505,66 @@ int nghttp2_session_close_stream(nghttp2_session *session, int32_t stream_id,
     /* On server side, retain stream at most MAX_CONCURRENT_STREAMS
        combined with the current active incoming streams to make
        dependency tree work better. */
-    nghttp2_session_keep_closed_stream(session, stream);
-  } else {
-    nghttp2_session_destroy_stream(session, stream);
+    return nghttp2_session_keep_closed_stream(session, stream);
   }
 
-  return 0;
+  return nghttp2_session_destroy_stream(session, stream);
 }
 
-void nghttp2_session_destroy_stream(nghttp2_session *session,
-                                    nghttp2_stream *stream) {
-  nghttp2_mem *mem;
+int nghttp2_session_destroy_stream(nghttp2_session *session,
+                                   nghttp2_stream *stream) {
+  int rv;
 
   DEBUGF(fprintf(stderr, "stream: destroy closed stream(%p)=%d\n", stream,
                  stream->stream_id));
 
-  mem = &session->mem;
-
-  nghttp2_stream_dep_remove(stream);
+  rv = nghttp2_stream_dep_remove(stream);
+  if (rv != 0) {
+    return rv;
+  }
 
   nghttp2_map_remove(&session->streams, stream->stream_id);
   nghttp2_stream_free(stream);
-  nghttp2_mem_free(mem, stream);
+  nghttp2_mempool_release(&session->stream_pool, stream);
+
+  return 0;
 }
 
-void nghttp2_session_keep_closed_stream(nghttp2_session *session,
-                                        nghttp2_stream *stream) {
+int nghttp2_session_keep_closed_stream(nghttp2_session *session,
+                                       nghttp2_stream *stream) {
+  int rv;
+
   DEBUGF(fprintf(stderr, "stream: keep closed stream(%p)=%d, state=%d\n",
                  stream, stream->stream_id, stream->state));
 
-  if (session->closed_stream_tail) {
-    session->closed_stream_tail->closed_next = stream;
-    stream->closed_prev = session->closed_stream_tail;
+  if (stream->dep_next == NULL && !stream->queued) {
+    /* Nothing depends on stream yet.  The tombstone is enough. */
+    rv = session_keep_tombstone(session, stream);
+    if (rv != 0) {
+      return rv;
+    }
   } else {
-    session->closed_stream_head = stream;
+    if (session->closed_stream_tail) {
+      session->closed_stream_tail->closed_next = stream;
+      stream->closed_prev = session->closed_stream_tail;
+    } else {
+      session->closed_stream_head = stream;
+    }
+    session->closed_stream_tail = stream;
+
+    ++session->num_closed_streams;
   }
-  session->closed_stream_tail = stream;
 
-  ++session->num_closed_streams;
+  rv = nghttp2_session_adjust_closed_stream(session, 0);
+  if (rv != 0) {
+    return rv;
+  }
 
-  nghttp2_session_adjust_closed_stream(session, 0);
+  return session_adapt_closed_stream(session);
 }
 
-void nghttp2_session_keep_idle_stream(nghttp2_session *session,
-                                      nghttp2_stream *stream) {
+int nghttp2_session_keep_idle_stream(nghttp2_session *session,
+                                     nghttp2_stream *stream) {
   DEBUGF(fprintf(stderr, "stream: keep idle stream(%p)=%d, state=%d\n", stream,
                  stream->stream_id, stream->state));
 
@@ -1107,7 +1578,7 @@ void nghttp2_session_keep_idle_stream(nghttp2_session *session,
 
   ++session->num_idle_streams;
 
-  nghttp2_session_adjust_idle_stream(session);
+  return nghttp2_session_adjust_idle_stream(session);
 }
 
 void nghttp2_session_detach_idle_stream(nghttp2_session *session,
@@ -1138,44 +1609,37 @@ void nghttp2_session_detach_idle_stream(nghttp2_session *session,
   --session->num_idle_streams;
 }
 
-void nghttp2_session_adjust_closed_stream(nghttp2_session *session,
-                                          ssize_t offset) {
+int nghttp2_session_adjust_closed_stream(nghttp2_session *session,
+                                         ssize_t offset) {
   size_t num_stream_max;
+  int rv;
 
   num_stream_max = nghttp2_min(session->local_settings.max_concurrent_streams,
                                session->pending_local_max_concurrent_stream);
 
   DEBUGF(fprintf(stderr, "stream: adjusting kept closed streams "
-                         "num_closed_streams=%zu, num_incoming_streams=%zu, "
+                         "num_closed_streams=%zu, num_tombstones=%zu, "
+                         "num_incoming_streams=%zu, "
                          "max_concurrent_streams=%zu\n",
-                 session->num_closed_streams, session->num_incoming_streams,
-                 num_stream_max));
+                 session->num_closed_streams, session->num_tombstones,
+                 session->num_incoming_streams, num_stream_max));
 
-  while (session->num_closed_streams > 0 &&
-         session->num_closed_streams + session->num_incoming_streams + offset >
+  while (session->num_closed_streams + session->num_tombstones > 0 &&
+         session->num_closed_streams + session->num_tombstones +
+                 session->num_incoming_streams + offset >
              num_stream_max) {
-    nghttp2_stream *head_stream;
-
-    head_stream = session->closed_stream_head;
-
-    assert(head_stream);
-
-    session->closed_stream_head = head_stream->closed_next;
-
-    if (session->closed_stream_head) {
-      session->closed_stream_head->closed_prev = NULL;
-    } else {
-      session->closed_stream_tail = NULL;
+    rv = session_drop_closed_stream(session);
+    if (rv != 0) {
+      return rv;
     }
-
-    nghttp2_session_destroy_stream(session, head_stream);
-    /* head_stream is now freed */
-    --session->num_closed_streams;
   }
+
+  return 0;
 }
 
-void nghttp2_session_adjust_idle_stream(nghttp2_session *session) {
+int nghttp2_session_adjust_idle_stream(nghttp2_session *session) {
   size_t max;
+  int rv;
 
   /* Make minimum number of idle streams 2 so that allocating 2
      streams at once is easy.  This happens when PRIORITY frame to
@@ -1203,10 +1667,64 @@ void nghttp2_session_adjust_idle_stream(nghttp2_session *session) {
       session->idle_stream_tail = NULL;
     }
 
-    nghttp2_session_destroy_stream(session, head);
+    rv = nghttp2_session_destroy_stream(session, head);
+    if (rv != 0) {
+      return rv;
+    }
     /* head is now destroyed */
     --session->num_idle_streams;
   }
+
+  return 0;
+}
+
+/*
+ * Drops tombstones and retained closed streams, and then idle streams,
+ * oldest first while the memory usage of |session| is over the budget.
+ *
+ * This function returns 0 if the usage is within the budget, or one
+ * of the following negative error codes:
+ *
+ * NGHTTP2_ERR_REFUSED_STREAM
+ *   The usage is still over the budget.
+ * NGHTTP2_ERR_NOMEM
+ *   Out of memory.
+ */
+static int session_enforce_memory_budget(nghttp2_session *session) {
+  nghttp2_stream *head;
+  int rv;
+
+  if (session->max_memory == 0) {
+    return 0;
+  }
+
+  while (session_get_mem_used(session) >= session->max_memory) {
+    if (session->num_tombstones || session->closed_stream_head) {
+      rv = session_drop_closed_stream(session);
+    } else if (session->idle_stream_head) {
+      head = session->idle_stream_head;
+
+      nghttp2_session_detach_idle_stream(session, head);
+
+      rv = nghttp2_session_destroy_stream(session, head);
+    } else {
+      DEBUGF(fprintf(stderr, "stream: memory budget exhausted, used=%zu, "
+                             "max=%zu\n",
+                     session_get_mem_used(session), session->max_memory));
+
+      ++session->stats.mem_refused_streams;
+
+      return NGHTTP2_ERR_REFUSED_STREAM;
+    }
+
+    if (rv != 0) {
+      return rv;
+    }
+
+    ++session->stats.mem_trimmed_streams;
+  }
+
+  return 0;
 }
 
 /*
@@ -1667,6 +2185,18 @@ static size_t session_estimate_headers_payload(nghttp2_session *session,
          additional;
 }
 
+static void session_stats_add_deflate(nghttp2_session *session,
+                                      const nghttp2_nv *nva, size_t nvlen,
+                                      size_t blocklen) {
+  size_t i;
+
+  for (i = 0; i < nvlen; ++i) {
+    session->stats.deflate_nv_bytes += nva[i].namelen + nva[i].valuelen;
+  }
+
+  session->stats.deflate_hd_bytes += blocklen;
+}
+
 /*
  * This function serializes frame for transmission.
  *
@@ -1740,16 +2270,6 @@ static int session_prep_frame(nghttp2_session *session,
           rv = session_predicate_headers_send(session, stream);
 
           if (rv != 0) {
-            if (stream && stream->item == item) {
-              int rv2;
-
-              rv2 = nghttp2_stream_detach_item(stream, session);
-
-              if (nghttp2_is_fatal(rv2)) {
-                return rv2;
-              }
-            }
-
             return rv;
           }
         }
@@ -1762,6 +2282,11 @@ static int session_prep_frame(nghttp2_session *session,
         return rv;
       }
 
+      session_stats_add_deflate(
+          session, frame->headers.nva, frame->headers.nvlen,
+          frame->hd.length -
+              nghttp2_frame_headers_payload_nv_offset(&frame->headers));
+
       DEBUGF(fprintf(stderr,
                      "send: before padding, HEADERS serialized in %zd bytes\n",
                      nghttp2_bufs_len(&session->aob.framebufs)));
@@ -1852,6 +2377,11 @@ static int session_prep_frame(nghttp2_session *session,
       if (rv != 0) {
         return rv;
       }
+
+      /* 4 for Promised Stream ID */
+      session_stats_add_deflate(session, frame->push_promise.nva,
+                                frame->push_promise.nvlen,
+                                frame->hd.length - 4);
       rv = session_headers_add_pad(session, frame);
       if (rv != 0) {
         return rv;
@@ -1927,8 +2457,10 @@ static int session_prep_frame(nghttp2_session *session,
         return rv;
       }
 
+      ++session->stats.data_blocked;
+
       session->aob.item = NULL;
-      active_outbound_item_reset(&session->aob, mem);
+      active_outbound_item_reset(&session->aob, &session->item_pool, mem);
       return NGHTTP2_ERR_DEFERRED;
     }
 
@@ -1944,7 +2476,7 @@ static int session_prep_frame(nghttp2_session *session,
       }
 
       session->aob.item = NULL;
-      active_outbound_item_reset(&session->aob, mem);
+      active_outbound_item_reset(&session->aob, &session->item_pool, mem);
       return NGHTTP2_ERR_DEFERRED;
     }
     if (rv == NGHTTP2_ERR_TEMPORAL_CALLBACK_FAILURE) {
@@ -1992,14 +2524,34 @@ nghttp2_session_get_next_ob_item(nghttp2_session *session) {
     }
   }
 
-  if (session->remote_window_size > 0 &&
-      !nghttp2_pq_empty(&session->ob_da_pq)) {
-    return nghttp2_pq_top(&session->ob_da_pq);
+  if (session->remote_window_size > 0) {
+    return nghttp2_stream_roots_next_outbound_item(&session->roots);
   }
 
   return NULL;
 }
 
+/*
+ * Forgets WINDOW_UPDATE |item| if increments are merged into it, so
+ * that it is not modified after it is serialized.
+ */
+static void session_detach_window_update(nghttp2_session *session,
+                                         nghttp2_outbound_item *item) {
+  nghttp2_stream *stream;
+
+  if (item->frame.hd.stream_id == 0) {
+    if (session->window_update_item == item) {
+      session->window_update_item = NULL;
+    }
+    return;
+  }
+
+  stream = nghttp2_session_get_stream_raw(session, item->frame.hd.stream_id);
+  if (stream && stream->window_update_item == item) {
+    stream->window_update_item = NULL;
+  }
+}
+
 nghttp2_outbound_item *
 nghttp2_session_pop_next_ob_item(nghttp2_session *session) {
   nghttp2_outbound_item *item;
@@ -2015,6 +2567,11 @@ nghttp2_session_pop_next_ob_item(nghttp2_session *session) {
   if (item) {
     nghttp2_outbound_queue_pop(&session->ob_reg);
     item->queued = 0;
+
+    if (item->frame.hd.type == NGHTTP2_WINDOW_UPDATE) {
+      session_detach_window_update(session, item);
+    }
+
     return item;
   }
 
@@ -2027,12 +2584,8 @@ nghttp2_session_pop_next_ob_item(nghttp2_session *session) {
     }
   }
 
-  if (session->remote_window_size > 0 &&
-      !nghttp2_pq_empty(&session->ob_da_pq)) {
-    item = nghttp2_pq_top(&session->ob_da_pq);
-    nghttp2_pq_pop(&session->ob_da_pq);
-    item->queued = 0;
-    return item;
+  if (session->remote_window_size > 0) {
+    return nghttp2_stream_roots_next_outbound_item(&session->roots);
   }
 
   return NULL;
@@ -2138,21 +2691,27 @@ static int session_close_stream_on_goaway(nghttp2_session *session,
   return 0;
 }
 
-static void session_outbound_item_schedule(nghttp2_session *session,
-                                           nghttp2_outbound_item *item,
-                                           int32_t weight) {
-  /* Schedule next write.  Offset proportional to the write size.
-     Stream with heavier weight is scheduled earlier. */
-  size_t delta = item->frame.hd.length * NGHTTP2_MAX_WEIGHT / weight;
+/* Opaque data of PING which window auto-tuning uses to measure
+   round trip time */
+static const uint8_t window_tuner_ping_data[8] = {
+    'n', 'g', 'h', 't', 't', 'p', '2', 'w'};
+
+/*
+ * Starts round trip time measurement of window auto-tuning if PING
+ * |frame| is the one queued for it.
+ */
+static void session_window_tuner_on_ping_sent(nghttp2_session *session,
+                                              nghttp2_frame *frame) {
+  nghttp2_window_tuner *tuner = &session->window_tuner;
 
-  if (session->last_cycle < item->cycle) {
-    session->last_cycle = item->cycle;
+  if (!tuner->ping_pending || tuner->ping_sent_time ||
+      (frame->hd.flags & NGHTTP2_FLAG_ACK) ||
+      memcmp(frame->ping.opaque_data, window_tuner_ping_data,
+             sizeof(window_tuner_ping_data)) != 0) {
+    return;
   }
 
-  /* We pretend to ignore overflow given that the value range of
-     item->cycle, which is uint64_t.  nghttp2 won't explode even when
-     overflow occurs, there might be some disturbance of priority. */
-  item->cycle = session->last_cycle + delta;
+  tuner->ping_sent_time = nghttp2_time_now_usec();
 }
 
 /*
@@ -2202,14 +2761,6 @@ static int session_after_frame_sent1(nghttp2_session *session) {
         break;
       }
 
-      if (stream->item == item) {
-        rv = nghttp2_stream_detach_item(stream, session);
-
-        if (nghttp2_is_fatal(rv)) {
-          return rv;
-        }
-      }
-
       switch (frame->headers.cat) {
       case NGHTTP2_HCAT_REQUEST: {
         stream->state = NGHTTP2_STREAM_OPENING;
@@ -2264,6 +2815,9 @@ static int session_after_frame_sent1(nghttp2_session *session) {
       }
       break;
     }
+    case NGHTTP2_PING:
+      session_window_tuner_on_ping_sent(session, frame);
+      break;
     case NGHTTP2_PRIORITY: {
       nghttp2_stream *stream;
 
@@ -2427,7 +2981,7 @@ static int session_after_frame_sent2(nghttp2_session *session) {
       }
     }
 
-    active_outbound_item_reset(&session->aob, mem);
+    active_outbound_item_reset(&session->aob, &session->item_pool, mem);
 
     return 0;
   } else {
@@ -2442,7 +2996,7 @@ static int session_after_frame_sent2(nghttp2_session *session) {
        on_frame_send_callback (call from session_after_frame_sent1),
        which attach data to stream.  We don't want to detach it. */
     if (aux_data->eof) {
-      active_outbound_item_reset(aob, mem);
+      active_outbound_item_reset(aob, &session->item_pool, mem);
 
       return 0;
     }
@@ -2463,7 +3017,7 @@ static int session_after_frame_sent2(nghttp2_session *session) {
         }
       }
 
-      active_outbound_item_reset(aob, mem);
+      active_outbound_item_reset(aob, &session->item_pool, mem);
 
       return 0;
     }
@@ -2472,12 +3026,10 @@ static int session_after_frame_sent2(nghttp2_session *session) {
     assert(stream);
     next_item = nghttp2_session_get_next_ob_item(session);
 
-    /* If priority of this stream is higher or equal to other stream
-       waiting at the top of the queue, we continue to send this
-       data. */
-    if (stream->dpri == NGHTTP2_STREAM_DPRI_TOP &&
-        (next_item == NULL || (next_item->frame.hd.type == NGHTTP2_DATA &&
-                               outbound_item_less(item, next_item)))) {
+    /* If this stream is still the one to be served next, we continue
+       to send this data.  next_item is NULL if connection level
+       window is exhausted, which is handled below. */
+    if (next_item == NULL || next_item == item) {
       size_t next_readmax;
 
       next_readmax = nghttp2_session_next_data_read(session, stream);
@@ -2488,15 +3040,9 @@ static int session_after_frame_sent2(nghttp2_session *session) {
             stream->remote_window_size > 0) {
 
           /* If DATA cannot be sent solely due to connection level
-             window size, just push item to queue again.  We never pop
-             DATA item while connection level window size is 0. */
-          rv = nghttp2_pq_push(&session->ob_da_pq, aob->item);
-
-          if (nghttp2_is_fatal(rv)) {
-            return rv;
-          }
-
-          aob->item->queued = 1;
+             window size, just leave item attached to stream.  We
+             never pick DATA item while connection level window size
+             is 0. */
         } else {
           rv = nghttp2_stream_defer_item(
               stream, NGHTTP2_STREAM_FLAG_DEFERRED_FLOW_CONTROL, session);
@@ -2504,10 +3050,12 @@ static int session_after_frame_sent2(nghttp2_session *session) {
           if (nghttp2_is_fatal(rv)) {
             return rv;
           }
+
+          ++session->stats.data_blocked;
         }
 
         aob->item = NULL;
-        active_outbound_item_reset(aob, mem);
+        active_outbound_item_reset(aob, &session->item_pool, mem);
 
         return 0;
       }
@@ -2528,7 +3076,7 @@ static int session_after_frame_sent2(nghttp2_session *session) {
         }
 
         aob->item = NULL;
-        active_outbound_item_reset(aob, mem);
+        active_outbound_item_reset(aob, &session->item_pool, mem);
 
         return 0;
       }
@@ -2550,7 +3098,7 @@ static int session_after_frame_sent2(nghttp2_session *session) {
           return rv;
         }
 
-        active_outbound_item_reset(aob, mem);
+        active_outbound_item_reset(aob, &session->item_pool, mem);
 
         return 0;
       }
@@ -2565,18 +3113,10 @@ static int session_after_frame_sent2(nghttp2_session *session) {
       return 0;
     }
 
-    if (stream->dpri == NGHTTP2_STREAM_DPRI_TOP) {
-      rv = nghttp2_pq_push(&session->ob_da_pq, aob->item);
-
-      if (nghttp2_is_fatal(rv)) {
-        return rv;
-      }
-
-      aob->item->queued = 1;
-    }
-
+    /* The item is still attached to stream, and will be picked up
+       when its turn comes. */
     aob->item = NULL;
-    active_outbound_item_reset(&session->aob, mem);
+    active_outbound_item_reset(&session->aob, &session->item_pool, mem);
     return 0;
   }
   /* Unreachable */
@@ -2598,6 +3138,10 @@ static int session_call_send_data(nghttp2_session *session,
   length = frame->hd.length - frame->data.padlen;
   aux_data = &item->aux_data.data;
 
+  if (session->callbacks.send_data_callback == NULL) {
+    return NGHTTP2_ERR_CALLBACK_FAILURE;
+  }
+
   rv = session->callbacks.send_data_callback(session, frame, buf->pos, length,
                                              &aux_data->data_prd.source,
                                              session->user_data);
@@ -2610,9 +3154,118 @@ static int session_call_send_data(nghttp2_session *session,
   return NGHTTP2_ERR_CALLBACK_FAILURE;
 }
 
+/*
+ * Returns the type of the frame in session->aob.framebufs->cur.  The
+ * second and later buffers of HEADERS and PUSH_PROMISE hold
+ * CONTINUATION frames.
+ */
+static uint8_t session_aob_frame_type(nghttp2_session *session) {
+  nghttp2_active_outbound_item *aob = &session->aob;
+
+  if (aob->framebufs.cur != aob->framebufs.head) {
+    return NGHTTP2_CONTINUATION;
+  }
+
+  return aob->item->frame.hd.type;
+}
+
+static void session_stats_add_sent(nghttp2_session *session, uint8_t type,
+                                   size_t nframes, size_t nbytes) {
+  if (type >= NGHTTP2_STATS_NUM_FRAME_TYPES) {
+    return;
+  }
+
+  session->stats.frames_sent[type] += nframes;
+  session->stats.bytes_sent[type] += nbytes;
+}
+
+/*
+ * Takes back |nbytes| counted as sent, which send_callback did not
+ * send actually.
+ */
+static void session_stats_unsent(nghttp2_session *session, size_t nbytes) {
+  uint8_t type;
+
+  if (session->aob.item == NULL) {
+    return;
+  }
+
+  type = session_aob_frame_type(session);
+
+  if (type >= NGHTTP2_STATS_NUM_FRAME_TYPES) {
+    return;
+  }
+
+  session->stats.bytes_sent[type] -= nbytes;
+}
+
+/*
+ * Applies the requests queued in the submission queue of |session|.
+ * The requests which fail with non-fatal error are discarded.
+ *
+ * This function returns 0 if it succeeds, or one of the following
+ * negative error codes:
+ *
+ * NGHTTP2_ERR_NOMEM
+ *   Out of memory.
+ */
+static int session_drain_submission_queue(nghttp2_session *session) {
+  nghttp2_submission_queue *q = session->submission_queue;
+  nghttp2_submission *sub;
+  int rv;
+
+  nghttp2_submission_queue_clear_wakeup(q);
+
+  for (;;) {
+    sub = nghttp2_submission_queue_pop(q);
+    if (sub == NULL) {
+      return 0;
+    }
+
+    switch (sub->type) {
+    case NGHTTP2_SUBMISSION_HEADERS:
+      rv = nghttp2_submit_headers(session, sub->flags, sub->stream_id, NULL,
+                                  sub->nva, sub->nvlen, NULL);
+      break;
+    case NGHTTP2_SUBMISSION_RESPONSE:
+      rv = nghttp2_submit_response(session, sub->stream_id, sub->nva,
+                                   sub->nvlen,
+                                   sub->has_data_prd ? &sub->data_prd : NULL);
+      break;
+    case NGHTTP2_SUBMISSION_RESUME_DATA:
+      rv = nghttp2_session_resume_data(session, sub->stream_id);
+      break;
+    case NGHTTP2_SUBMISSION_RST_STREAM:
+      rv = nghttp2_submit_rst_stream(session, NGHTTP2_FLAG_NONE,
+                                     sub->stream_id, sub->error_code);
+      break;
+    default:
+      rv = 0;
+      break;
+    }
+
+    DEBUGF(fprintf(stderr, "send: submission type=%u, stream_id=%d, rv=%d\n",
+                   sub->type, sub->stream_id, rv));
+
+    nghttp2_submission_del(q, sub);
+
+    if (nghttp2_is_fatal(rv)) {
+      return rv;
+    }
+  }
+}
+
+/*
+ * Returns the serialized data to send in |*data_ptr| and its length.
+ * If |fast_cb| is nonzero, session_after_frame_sent1() is left to the
+ * caller.  If |sendv| is nonzero, this function returns 0 without
+ * sending anything when no copy DATA is ready to be sent, leaving
+ * aob->state NGHTTP2_OB_SEND_NO_COPY, so that the caller can send it
+ * by itself.
+ */
 static ssize_t nghttp2_session_mem_send_internal(nghttp2_session *session,
                                                  const uint8_t **data_ptr,
-                                                 int fast_cb) {
+                                                 int fast_cb, int sendv) {
   int rv;
   nghttp2_active_outbound_item *aob;
   nghttp2_bufs *framebufs;
@@ -2623,6 +3276,14 @@ static ssize_t nghttp2_session_mem_send_internal(nghttp2_session *session,
   framebufs = &aob->framebufs;
 
   *data_ptr = NULL;
+
+  if (session->submission_queue) {
+    rv = session_drain_submission_queue(session);
+    if (rv != 0) {
+      return rv;
+    }
+  }
+
   for (;;) {
     switch (aob->state) {
     case NGHTTP2_OB_POP_ITEM: {
@@ -2633,22 +3294,6 @@ static ssize_t nghttp2_session_mem_send_internal(nghttp2_session *session,
         return 0;
       }
 
-      if (item->frame.hd.type == NGHTTP2_DATA ||
-          item->frame.hd.type == NGHTTP2_HEADERS) {
-        nghttp2_frame *frame;
-        nghttp2_stream *stream;
-
-        frame = &item->frame;
-        stream = nghttp2_session_get_stream(session, frame->hd.stream_id);
-
-        if (stream && item == stream->item &&
-            stream->dpri != NGHTTP2_STREAM_DPRI_TOP) {
-          /* We have DATA with higher priority in queue within the
-             same dependency tree. */
-          break;
-        }
-      }
-
       rv = session_prep_frame(session, item);
       if (rv == NGHTTP2_ERR_DEFERRED) {
         DEBUGF(fprintf(stderr, "send: frame transmission deferred\n"));
@@ -2673,7 +3318,7 @@ static ssize_t nghttp2_session_mem_send_internal(nghttp2_session *session,
                   session, frame, rv, session->user_data) != 0) {
 
             nghttp2_outbound_item_free(item, mem);
-            nghttp2_mem_free(mem, item);
+            nghttp2_mempool_release(&session->item_pool, item);
 
             return NGHTTP2_ERR_CALLBACK_FAILURE;
           }
@@ -2705,8 +3350,8 @@ static ssize_t nghttp2_session_mem_send_internal(nghttp2_session *session,
         }
 
         nghttp2_outbound_item_free(item, mem);
-        nghttp2_mem_free(mem, item);
-        active_outbound_item_reset(aob, mem);
+        nghttp2_mempool_release(&session->item_pool, item);
+        active_outbound_item_reset(aob, &session->item_pool, mem);
 
         if (rv == NGHTTP2_ERR_HEADER_COMP) {
           /* If header compression error occurred, should terminiate
@@ -2765,6 +3410,8 @@ static ssize_t nghttp2_session_mem_send_internal(nghttp2_session *session,
       if (buf->pos == buf->last) {
         DEBUGF(fprintf(stderr, "send: end transmission of a frame\n"));
 
+        session_stats_add_sent(session, session_aob_frame_type(session), 1, 0);
+
         /* Frame has completely sent */
         if (fast_cb) {
           rv = session_after_frame_sent2(session);
@@ -2793,6 +3440,9 @@ static ssize_t nghttp2_session_mem_send_internal(nghttp2_session *session,
          everything, we will adjust it. */
       buf->pos += datalen;
 
+      session_stats_add_sent(session, session_aob_frame_type(session), 0,
+                             datalen);
+
       return datalen;
     }
     case NGHTTP2_OB_SEND_NO_COPY: {
@@ -2809,11 +3459,15 @@ static ssize_t nghttp2_session_mem_send_internal(nghttp2_session *session,
             stderr,
             "send: no copy DATA cancelled because stream was closed\n"));
 
-        active_outbound_item_reset(aob, mem);
+        active_outbound_item_reset(aob, &session->item_pool, mem);
 
         break;
       }
 
+      if (sendv) {
+        return 0;
+      }
+
       rv = session_call_send_data(session, aob->item, framebufs);
       if (nghttp2_is_fatal(rv)) {
         return rv;
@@ -2832,7 +3486,7 @@ static ssize_t nghttp2_session_mem_send_internal(nghttp2_session *session,
           return rv;
         }
 
-        active_outbound_item_reset(aob, mem);
+        active_outbound_item_reset(aob, &session->item_pool, mem);
 
         break;
       }
@@ -2843,6 +3497,9 @@ static ssize_t nghttp2_session_mem_send_internal(nghttp2_session *session,
 
       assert(rv == 0);
 
+      session_stats_add_sent(session, NGHTTP2_DATA, 1,
+                             NGHTTP2_FRAME_HDLEN + frame->hd.length);
+
       rv = session_after_frame_sent1(session);
       if (rv < 0) {
         assert(nghttp2_is_fatal(rv));
@@ -2866,7 +3523,7 @@ static ssize_t nghttp2_session_mem_send_internal(nghttp2_session *session,
 
       if (buf->pos == buf->last) {
         DEBUGF(fprintf(stderr, "send: end transmission of client magic\n"));
-        active_outbound_item_reset(aob, mem);
+        active_outbound_item_reset(aob, &session->item_pool, mem);
         break;
       }
 
@@ -2886,7 +3543,7 @@ ssize_t nghttp2_session_mem_send(nghttp2_session *session,
   int rv;
   ssize_t len;
 
-  len = nghttp2_session_mem_send_internal(session, data_ptr, 1);
+  len = nghttp2_session_mem_send_internal(session, data_ptr, 1, 0);
   if (len <= 0) {
     return len;
   }
@@ -2906,6 +3563,300 @@ ssize_t nghttp2_session_mem_send(nghttp2_session *session,
   return len;
 }
 
+/* Trailing padding of no copy DATA sent by
+   nghttp2_session_mem_sendv() */
+static const uint8_t sendv_zero_pad[NGHTTP2_MAX_PADLEN];
+
+/*
+ * Swaps session->aob.framebufs with the buffers in
+ * session->aob.sendv_bufs which have not been handed out in the
+ * current invocation of nghttp2_session_mem_sendv(), so that the next
+ * frame does not overwrite the frame already handed out.  The
+ * |*pnbufs| is the number of buffers handed out so far, and this
+ * function increments it by 1.
+ *
+ * This function returns 0 if it succeeds, or one of the following
+ * negative error codes:
+ *
+ * NGHTTP2_ERR_WOULDBLOCK
+ *     All buffers have been handed out.
+ * NGHTTP2_ERR_NOMEM
+ *     Out of memory.
+ */
+static int session_sendv_swap_framebufs(nghttp2_session *session,
+                                        size_t *pnbufs) {
+  int rv;
+  nghttp2_active_outbound_item *aob;
+  nghttp2_bufs *bufs;
+  nghttp2_bufs tmp;
+  nghttp2_mem *mem;
+
+  mem = &session->mem;
+  aob = &session->aob;
+
+  if (*pnbufs == NGHTTP2_SENDV_MAX_FRAMEBUFS) {
+    return NGHTTP2_ERR_WOULDBLOCK;
+  }
+
+  if (aob->sendv_bufs == NULL) {
+    aob->sendv_bufs = nghttp2_mem_malloc(
+        mem, sizeof(nghttp2_bufs) * NGHTTP2_SENDV_MAX_FRAMEBUFS);
+    if (aob->sendv_bufs == NULL) {
+      return NGHTTP2_ERR_NOMEM;
+    }
+  }
+
+  bufs = &aob->sendv_bufs[*pnbufs];
+
+  if (*pnbufs == aob->sendv_nbufs) {
+    /* 1 for Pad Field. */
+    rv = nghttp2_bufs_init3(bufs, NGHTTP2_FRAMEBUF_CHUNKLEN,
+                            NGHTTP2_FRAMEBUF_MAX_NUM, 1,
+                            NGHTTP2_FRAME_HDLEN + 1, mem);
+    if (rv != 0) {
+      return rv;
+    }
+    ++aob->sendv_nbufs;
+  } else {
+    nghttp2_bufs_reset(bufs);
+  }
+
+  tmp = aob->framebufs;
+  aob->framebufs = *bufs;
+  *bufs = tmp;
+
+  ++*pnbufs;
+
+  return 0;
+}
+
+/*
+ * Stores no copy DATA frame in session->aob into |vec| starting at
+ * |*pnvec|, and increments |*pnvec| by the number of elements used.
+ * The frame header and padding are taken from the library memory,
+ * and the application data is obtained by get_data_vec_callback.
+ *
+ * This function returns 0 if it succeeds, or one of the following
+ * negative error codes:
+ *
+ * NGHTTP2_ERR_WOULDBLOCK
+ *     |vec| or frame buffers are exhausted, or the application data
+ *     is not available yet.
+ * NGHTTP2_ERR_NOMEM
+ *     Out of memory.
+ * NGHTTP2_ERR_CALLBACK_FAILURE
+ *     The callback function failed.
+ */
+static int session_sendv_no_copy(nghttp2_session *session, nghttp2_vec *vec,
+                                 size_t veclen, size_t *pnvec,
+                                 size_t *pnbufs) {
+  int rv;
+  ssize_t n;
+  size_t i, nvec, length, padlen, hdlen, sum;
+  nghttp2_active_outbound_item *aob;
+  nghttp2_outbound_item *item;
+  nghttp2_frame *frame;
+  nghttp2_buf *buf;
+  nghttp2_stream *stream;
+
+  aob = &session->aob;
+  item = aob->item;
+  frame = &item->frame;
+  buf = &aob->framebufs.cur->buf;
+
+  if (session->callbacks.get_data_vec_callback == NULL) {
+    return NGHTTP2_ERR_CALLBACK_FAILURE;
+  }
+
+  padlen = frame->data.padlen;
+  length = frame->hd.length - padlen;
+
+  /* frame header, application data and trailing padding */
+  nvec = 1 + (length > 0) + (padlen > 1);
+
+  if (veclen - *pnvec < nvec || *pnbufs == NGHTTP2_SENDV_MAX_FRAMEBUFS) {
+    return NGHTTP2_ERR_WOULDBLOCK;
+  }
+
+  vec += *pnvec;
+
+  n = 0;
+
+  if (length > 0) {
+    n = session->callbacks.get_data_vec_callback(
+        session, frame, vec + 1, veclen - *pnvec - nvec + 1, length,
+        &item->aux_data.data.data_prd.source, session->user_data);
+
+    if (n == NGHTTP2_ERR_WOULDBLOCK) {
+      return NGHTTP2_ERR_WOULDBLOCK;
+    }
+
+    if (n == NGHTTP2_ERR_TEMPORAL_CALLBACK_FAILURE) {
+      stream = nghttp2_session_get_stream(session, frame->hd.stream_id);
+
+      assert(stream);
+
+      rv = nghttp2_stream_detach_item(stream, session);
+      if (nghttp2_is_fatal(rv)) {
+        return rv;
+      }
+
+      rv = nghttp2_session_add_rst_stream(session, frame->hd.stream_id,
+                                          NGHTTP2_INTERNAL_ERROR);
+      if (nghttp2_is_fatal(rv)) {
+        return rv;
+      }
+
+      active_outbound_item_reset(aob, &session->item_pool, &session->mem);
+
+      return 0;
+    }
+
+    if (n <= 0 || (size_t)n > veclen - *pnvec - nvec + 1) {
+      return NGHTTP2_ERR_CALLBACK_FAILURE;
+    }
+
+    sum = 0;
+    for (i = 0; i < (size_t)n; ++i) {
+      sum += vec[1 + i].len;
+    }
+
+    if (sum != length) {
+      return NGHTTP2_ERR_CALLBACK_FAILURE;
+    }
+  }
+
+  hdlen = NGHTTP2_FRAME_HDLEN;
+
+  if (padlen > 0) {
+    /* Pad Length field follows frame header */
+    buf->pos[NGHTTP2_FRAME_HDLEN] = (uint8_t)(padlen - 1);
+    ++hdlen;
+  }
+
+  vec[0].base = buf->pos;
+  vec[0].len = hdlen;
+
+  if (padlen > 1) {
+    vec[1 + n].base = sendv_zero_pad;
+    vec[1 + n].len = padlen - 1;
+  }
+
+  *pnvec += 1 + (size_t)n + (padlen > 1);
+
+  session_stats_add_sent(session, NGHTTP2_DATA, 1,
+                         NGHTTP2_FRAME_HDLEN + frame->hd.length);
+
+  rv = session_after_frame_sent1(session);
+  if (rv < 0) {
+    assert(nghttp2_is_fatal(rv));
+    return rv;
+  }
+
+  /* session_after_frame_sent2() may serialize next DATA to framebufs
+     immediately. */
+  rv = session_sendv_swap_framebufs(session, pnbufs);
+  if (rv != 0) {
+    return rv;
+  }
+
+  rv = session_after_frame_sent2(session);
+  if (rv < 0) {
+    assert(nghttp2_is_fatal(rv));
+    return rv;
+  }
+
+  return 0;
+}
+
+ssize_t nghttp2_session_mem_sendv(nghttp2_session *session, nghttp2_vec *vec,
+                                  size_t veclen) {
+  int rv;
+  ssize_t len;
+  const uint8_t *data;
+  size_t nvec, nbufs;
+  uint8_t type;
+  nghttp2_active_outbound_item *aob;
+
+  aob = &session->aob;
+  nvec = 0;
+  nbufs = 0;
+
+  while (nvec < veclen) {
+    len = nghttp2_session_mem_send_internal(session, &data, 1, 1);
+    if (len < 0) {
+      return len;
+    }
+
+    if (len == 0) {
+      if (aob->state != NGHTTP2_OB_SEND_NO_COPY) {
+        break;
+      }
+
+      rv = session_sendv_no_copy(session, vec, veclen, &nvec, &nbufs);
+      if (rv == NGHTTP2_ERR_WOULDBLOCK) {
+        break;
+      }
+      if (rv != 0) {
+        return rv;
+      }
+
+      continue;
+    }
+
+    vec[nvec].base = data;
+    vec[nvec].len = (size_t)len;
+    ++nvec;
+
+    if (nghttp2_bufs_next_present(&aob->framebufs)) {
+      /* CONTINUATION frames follow in the same buffers */
+      continue;
+    }
+
+    if (aob->item == NULL) {
+      /* Client magic */
+      rv = session_sendv_swap_framebufs(session, &nbufs);
+      if (rv == NGHTTP2_ERR_WOULDBLOCK) {
+        break;
+      }
+      if (rv != 0) {
+        return rv;
+      }
+
+      continue;
+    }
+
+    /* See nghttp2_session_mem_send() */
+    rv = session_after_frame_sent1(session);
+    if (rv < 0) {
+      assert(nghttp2_is_fatal(rv));
+      return (ssize_t)rv;
+    }
+
+    type = session_aob_frame_type(session);
+
+    /* If we cannot swap buffers, the frame is finished in the next
+       call, just like nghttp2_session_mem_send(). */
+    rv = session_sendv_swap_framebufs(session, &nbufs);
+    if (rv == NGHTTP2_ERR_WOULDBLOCK) {
+      break;
+    }
+    if (rv != 0) {
+      return rv;
+    }
+
+    session_stats_add_sent(session, type, 1, 0);
+
+    rv = session_after_frame_sent2(session);
+    if (rv < 0) {
+      assert(nghttp2_is_fatal(rv));
+      return (ssize_t)rv;
+    }
+  }
+
+  return (ssize_t)nvec;
+}
+
 int nghttp2_session_send(nghttp2_session *session) {
   const uint8_t *data;
   ssize_t datalen;
@@ -2915,7 +3866,7 @@ int nghttp2_session_send(nghttp2_session *session) {
   framebufs = &session->aob.framebufs;
 
   for (;;) {
-    datalen = nghttp2_session_mem_send_internal(session, &data, 0);
+    datalen = nghttp2_session_mem_send_internal(session, &data, 0, 0);
     if (datalen <= 0) {
       return (int)datalen;
     }
@@ -2925,6 +3876,7 @@ int nghttp2_session_send(nghttp2_session *session) {
       if (sentlen == NGHTTP2_ERR_WOULDBLOCK) {
         /* Transmission canceled. Rewind the offset */
         framebufs->cur->buf.pos -= datalen;
+        session_stats_unsent(session, (size_t)datalen);
 
         return 0;
       }
@@ -2932,6 +3884,7 @@ int nghttp2_session_send(nghttp2_session *session) {
     }
     /* Rewind the offset to the amount of unsent bytes */
     framebufs->cur->buf.pos -= datalen - sentlen;
+    session_stats_unsent(session, (size_t)(datalen - sentlen));
   }
 }
 
@@ -3000,9 +3953,21 @@ static int session_call_on_begin_headers(nghttp2_session *session,
 
 static int session_call_on_header(nghttp2_session *session,
                                   const nghttp2_frame *frame,
-                                  const nghttp2_nv *nv) {
+                                  const nghttp2_nv *nv, nghttp2_hd_entry *ent) {
   int rv;
-  if (session->callbacks.on_header_callback) {
+  if (ent) {
+    /* ent is non-NULL only if on_header_callback2 is set */
+    rv = session->callbacks.on_header_callback2(
+        session, frame, (nghttp2_rcnv *)(void *)ent, nv->flags,
+        session->user_data);
+    if (rv == NGHTTP2_ERR_PAUSE ||
+        rv == NGHTTP2_ERR_TEMPORAL_CALLBACK_FAILURE) {
+      return rv;
+    }
+    if (rv != 0) {
+      return NGHTTP2_ERR_CALLBACK_FAILURE;
+    }
+  } else if (session->callbacks.on_header_callback) {
     rv = session->callbacks.on_header_callback(
         session, frame, nv->name, nv->namelen, nv->value, nv->valuelen,
         nv->flags, session->user_data);
@@ -3159,6 +4124,8 @@ static int inflate_header_block(nghttp2_session *session, nghttp2_frame *frame,
   nghttp2_stream *subject_stream;
   int trailer = 0;
   int token;
+  nghttp2_hd_entry *ent;
+  nghttp2_hd_entry **ent_ptr;
 
   *readlen_ptr = 0;
   stream = nghttp2_session_get_stream(session, frame->hd.stream_id);
@@ -3171,11 +4138,21 @@ static int inflate_header_block(nghttp2_session *session, nghttp2_frame *frame,
     trailer = session_trailer_headers(session, stream, frame);
   }
 
+  /* Ask inflater for the refcounted header field only when
+     application takes it, so that we don't allocate it otherwise. */
+  if (call_header_cb && session->callbacks.on_header_callback2) {
+    ent_ptr = &ent;
+  } else {
+    ent_ptr = NULL;
+  }
+
   DEBUGF(fprintf(stderr, "recv: decoding header block %zu bytes\n", inlen));
   for (;;) {
     inflate_flags = 0;
-    proclen = nghttp2_hd_inflate_hd2(&session->hd_inflater, &nv, &inflate_flags,
-                                     &token, in, inlen, final);
+    ent = NULL;
+    proclen =
+        nghttp2_hd_inflate_hd_ref(&session->hd_inflater, &nv, &inflate_flags,
+                                  &token, ent_ptr, in, inlen, final);
     if (nghttp2_is_fatal((int)proclen)) {
       return (int)proclen;
     }
@@ -3207,6 +4184,12 @@ static int inflate_header_block(nghttp2_session *session, nghttp2_frame *frame,
 
     DEBUGF(fprintf(stderr, "recv: proclen=%zd\n", proclen));
 
+    session->stats.inflate_hd_bytes += (size_t)proclen;
+
+    if (inflate_flags & NGHTTP2_HD_INFLATE_EMIT) {
+      session->stats.inflate_nv_bytes += nv.namelen + nv.valuelen;
+    }
+
     if (call_header_cb && (inflate_flags & NGHTTP2_HD_INFLATE_EMIT)) {
       rv = 0;
       if (subject_stream && session_enforce_http_messaging(session)) {
@@ -3218,6 +4201,8 @@ static int inflate_header_block(nghttp2_session *session, nghttp2_frame *frame,
               frame->hd.type, subject_stream->stream_id, (int)nv.namelen,
               nv.name, (int)nv.valuelen, nv.value));
 
+          nghttp2_hd_entry_decref(ent);
+
           rv =
               session_handle_invalid_stream2(session, subject_stream->stream_id,
                                              frame, NGHTTP2_ERR_HTTP_HEADER);
@@ -3236,12 +4221,15 @@ static int inflate_header_block(nghttp2_session *session, nghttp2_frame *frame,
         }
       }
       if (rv == 0) {
-        rv = session_call_on_header(session, frame, &nv);
+        rv = session_call_on_header(session, frame, &nv, ent);
+        nghttp2_hd_entry_decref(ent);
         /* This handles NGHTTP2_ERR_PAUSE and
            NGHTTP2_ERR_TEMPORAL_CALLBACK_FAILURE as well */
         if (rv != 0) {
           return rv;
         }
+      } else {
+        nghttp2_hd_entry_decref(ent);
       }
     }
     if (inflate_flags & NGHTTP2_HD_INFLATE_FINAL) {
@@ -3489,6 +4477,14 @@ int nghttp2_session_on_request_headers_received(nghttp2_session *session,
                                                  NGHTTP2_ERR_REFUSED_STREAM);
   }
 
+  rv = session_enforce_memory_budget(session);
+  if (rv != 0) {
+    if (nghttp2_is_fatal(rv)) {
+      return rv;
+    }
+    return session_inflate_handle_invalid_stream(session, frame, rv);
+  }
+
   stream = nghttp2_session_open_stream(
       session, frame->hd.stream_id, NGHTTP2_STREAM_FLAG_NONE,
       &frame->headers.pri_spec, NGHTTP2_STREAM_OPENING, NULL);
@@ -3683,6 +4679,13 @@ int nghttp2_session_on_priority_received(nghttp2_session *session,
 
   stream = nghttp2_session_get_stream_raw(session, frame->hd.stream_id);
 
+  if (!stream) {
+    rv = session_promote_tombstone(session, &stream, frame->hd.stream_id);
+    if (rv != 0) {
+      return rv;
+    }
+  }
+
   if (!stream) {
     /* PRIORITY against idle stream can create anchor node in
        dependency tree. */
@@ -3709,12 +4712,13 @@ int nghttp2_session_on_priority_received(nghttp2_session *session,
   return session_call_on_frame_received(session, frame);
 }
 
-static int session_process_priority_frame(nghttp2_session *session) {
+static int session_process_priority_frame(nghttp2_session *session,
+                                          const uint8_t *payload) {
   nghttp2_inbound_frame *iframe = &session->iframe;
   nghttp2_frame *frame = &iframe->frame;
 
-  nghttp2_frame_unpack_priority_payload(&frame->priority, iframe->sbuf.pos,
-                                        nghttp2_buf_len(&iframe->sbuf));
+  nghttp2_frame_unpack_priority_payload(&frame->priority, payload,
+                                        NGHTTP2_PRIORITY_SPECLEN);
 
   return nghttp2_session_on_priority_received(session, frame);
 }
@@ -3747,12 +4751,12 @@ int nghttp2_session_on_rst_stream_received(nghttp2_session *session,
   return 0;
 }
 
-static int session_process_rst_stream_frame(nghttp2_session *session) {
+static int session_process_rst_stream_frame(nghttp2_session *session,
+                                            const uint8_t *payload) {
   nghttp2_inbound_frame *iframe = &session->iframe;
   nghttp2_frame *frame = &iframe->frame;
 
-  nghttp2_frame_unpack_rst_stream_payload(&frame->rst_stream, iframe->sbuf.pos,
-                                          nghttp2_buf_len(&iframe->sbuf));
+  nghttp2_frame_unpack_rst_stream_payload(&frame->rst_stream, payload, 4);
 
   return nghttp2_session_on_rst_stream_received(session, frame);
 }
@@ -3773,24 +4777,84 @@ static int update_remote_initial_window_size_func(nghttp2_map_entry *entry,
                                              NGHTTP2_FLOW_CONTROL_ERROR);
   }
 
-  /* If window size gets positive, push deferred DATA frame to
-     outbound queue. */
-  if (stream->remote_window_size > 0 &&
-      nghttp2_stream_check_deferred_by_flow_control(stream)) {
+  /* If window size gets positive, push deferred DATA frame to
+     outbound queue. */
+  if (stream->remote_window_size > 0 &&
+      nghttp2_stream_check_deferred_by_flow_control(stream)) {
+
+    rv = nghttp2_stream_resume_deferred_item(
+        stream, NGHTTP2_STREAM_FLAG_DEFERRED_FLOW_CONTROL, arg->session);
+
+    if (nghttp2_is_fatal(rv)) {
+      return rv;
+    }
+  }
+  return 0;
+}
+
+/*
+ * Updates the remote initial window size of all active streams.  If
+ * error occurs, all streams may not be updated.
+ *
+ * This function returns 0 if it succeeds, or one of the following
+ * negative error codes:
+ *
+ * NGHTTP2_ERR_NOMEM
+ *     Out of memory.
+ */
+static int
+session_update_remote_initial_window_size(nghttp2_session *session,
+                                          int32_t new_initial_window_size) {
+  nghttp2_update_window_size_arg arg;
+
+  arg.session = session;
+  arg.new_window_size = new_initial_window_size;
+  arg.old_window_size = session->remote_settings.initial_window_size;
+
+  return nghttp2_map_each(&session->streams,
+                          update_remote_initial_window_size_func, &arg);
+}
+
+static int session_add_window_update_item(nghttp2_session *session,
+                                          nghttp2_outbound_item **item_ptr,
+                                          uint8_t flags, int32_t stream_id,
+                                          int32_t window_size_increment) {
+  int rv;
+  nghttp2_outbound_item *item;
+  nghttp2_frame *frame;
+
+  item = nghttp2_mempool_alloc(&session->item_pool);
+  if (item == NULL) {
+    return NGHTTP2_ERR_NOMEM;
+  }
+
+  nghttp2_outbound_item_init(item);
+
+  frame = &item->frame;
+
+  nghttp2_frame_window_update_init(&frame->window_update, flags, stream_id,
+                                   window_size_increment);
+
+  rv = nghttp2_session_add_item(session, item);
 
-    rv = nghttp2_stream_resume_deferred_item(
-        stream, NGHTTP2_STREAM_FLAG_DEFERRED_FLOW_CONTROL, arg->session);
+  if (rv != 0) {
+    nghttp2_frame_window_update_free(&frame->window_update);
+    nghttp2_mempool_release(&session->item_pool, item);
+    return rv;
+  }
 
-    if (nghttp2_is_fatal(rv)) {
-      return rv;
-    }
+  if (item_ptr) {
+    *item_ptr = item;
   }
+
   return 0;
 }
 
 /*
- * Updates the remote initial window size of all active streams.  If
- * error occurs, all streams may not be updated.
+ * Queues WINDOW_UPDATE with |window_size_increment| for |stream|, or
+ * for the connection if |stream| is NULL.  If WINDOW_UPDATE queued by
+ * this function before is still waiting in the queue, the increment
+ * is merged into it instead of queuing another frame.
  *
  * This function returns 0 if it succeeds, or one of the following
  * negative error codes:
@@ -3798,17 +4862,46 @@ static int update_remote_initial_window_size_func(nghttp2_map_entry *entry,
  * NGHTTP2_ERR_NOMEM
  *     Out of memory.
  */
-static int
-session_update_remote_initial_window_size(nghttp2_session *session,
-                                          int32_t new_initial_window_size) {
-  nghttp2_update_window_size_arg arg;
+static int session_add_coalesced_window_update(nghttp2_session *session,
+                                               nghttp2_stream *stream,
+                                               int32_t window_size_increment) {
+  nghttp2_outbound_item **item_ptr;
+  nghttp2_window_update *frame;
 
-  arg.session = session;
-  arg.new_window_size = new_initial_window_size;
-  arg.old_window_size = session->remote_settings.initial_window_size;
+  item_ptr =
+      stream ? &stream->window_update_item : &session->window_update_item;
 
-  return nghttp2_map_each(&session->streams,
-                          update_remote_initial_window_size_func, &arg);
+  if (*item_ptr) {
+    frame = &(*item_ptr)->frame.window_update;
+
+    if (frame->window_size_increment <=
+        NGHTTP2_MAX_WINDOW_SIZE - window_size_increment) {
+      DEBUGF(fprintf(stderr, "send: merge WINDOW_UPDATE stream_id=%d, "
+                             "window_size_increment=%d+%d\n",
+                     frame->hd.stream_id, frame->window_size_increment,
+                     window_size_increment));
+
+      frame->window_size_increment += window_size_increment;
+
+      return 0;
+    }
+  }
+
+  return session_add_window_update_item(session, item_ptr, NGHTTP2_FLAG_NONE,
+                                        stream ? stream->stream_id : 0,
+                                        window_size_increment);
+}
+
+/*
+ * Returns nonzero if WINDOW_UPDATE for the connection should be sent
+ * for |recv_window_size| bytes received or consumed.
+ */
+static int
+session_should_send_connection_window_update(nghttp2_session *session,
+                                             int32_t recv_window_size) {
+  return recv_window_size >=
+         (int32_t)((int64_t)session->local_window_size *
+                   session->connection_window_update_threshold / 100);
 }
 
 static int update_local_initial_window_size_func(nghttp2_map_entry *entry,
@@ -3829,9 +4922,8 @@ static int update_local_initial_window_size_func(nghttp2_map_entry *entry,
     if (nghttp2_should_send_window_update(stream->local_window_size,
                                           stream->recv_window_size)) {
 
-      rv = nghttp2_session_add_window_update(arg->session, NGHTTP2_FLAG_NONE,
-                                             stream->stream_id,
-                                             stream->recv_window_size);
+      rv = session_add_coalesced_window_update(arg->session, stream,
+                                               stream->recv_window_size);
       if (rv != 0) {
         return rv;
       }
@@ -4193,6 +5285,20 @@ int nghttp2_session_on_push_promise_received(nghttp2_session *session,
     return NGHTTP2_ERR_IGN_HEADER_BLOCK;
   }
 
+  rv = session_enforce_memory_budget(session);
+  if (rv != 0) {
+    if (nghttp2_is_fatal(rv)) {
+      return rv;
+    }
+    rv = nghttp2_session_add_rst_stream(session,
+                                        frame->push_promise.promised_stream_id,
+                                        NGHTTP2_REFUSED_STREAM);
+    if (rv != 0) {
+      return rv;
+    }
+    return NGHTTP2_ERR_IGN_HEADER_BLOCK;
+  }
+
   /* TODO It is unclear reserved stream dpeneds on associated
      stream with or without exclusive flag set */
   nghttp2_priority_spec_init(&pri_spec, stream->stream_id,
@@ -4230,6 +5336,213 @@ static int session_process_push_promise_frame(nghttp2_session *session) {
   return nghttp2_session_on_push_promise_received(session, frame);
 }
 
+/*
+ * Sets local window size of |stream| to |window_size|.  If |stream|
+ * is NULL, connection-level window is set instead.  If window gets
+ * larger, WINDOW_UPDATE is queued for the difference.  Shrinking
+ * window is done without telling the remote peer; we just withhold
+ * WINDOW_UPDATE for the difference as nghttp2_submit_window_update()
+ * with negative delta does.
+ *
+ * This function returns 0 if it succeeds, or one of the following
+ * negative error codes:
+ *
+ * NGHTTP2_ERR_NOMEM
+ *     Out of memory.
+ */
+static int session_set_local_window_size(nghttp2_session *session,
+                                         nghttp2_stream *stream,
+                                         int32_t window_size) {
+  int rv;
+  int32_t stream_id;
+  int32_t delta;
+  int32_t *local_window_size_ptr;
+  int32_t *recv_window_size_ptr;
+  int32_t *recv_reduction_ptr;
+
+  if (stream) {
+    stream_id = stream->stream_id;
+    local_window_size_ptr = &stream->local_window_size;
+    recv_window_size_ptr = &stream->recv_window_size;
+    recv_reduction_ptr = &stream->recv_reduction;
+  } else {
+    stream_id = 0;
+    local_window_size_ptr = &session->local_window_size;
+    recv_window_size_ptr = &session->recv_window_size;
+    recv_reduction_ptr = &session->recv_reduction;
+  }
+
+  delta = window_size - *local_window_size_ptr;
+
+  if (delta == 0) {
+    return 0;
+  }
+
+  if (delta < 0) {
+    /* This fails only if counters overflow.  Keep current window in
+       that case. */
+    nghttp2_adjust_local_window_size(local_window_size_ptr,
+                                     recv_window_size_ptr, recv_reduction_ptr,
+                                     &delta);
+    return 0;
+  }
+
+  rv = nghttp2_increase_local_window_size(
+      local_window_size_ptr, recv_window_size_ptr, recv_reduction_ptr, &delta);
+  if (rv != 0 || delta == 0) {
+    return 0;
+  }
+
+  return nghttp2_session_add_window_update(session, NGHTTP2_FLAG_NONE,
+                                           stream_id, delta);
+}
+
+/*
+ * Queues PING to measure round trip time for window auto-tuning when
+ * DATA is received, unless one is in flight or the last measurement
+ * is recent enough.
+ *
+ * This function returns 0 if it succeeds, or one of the following
+ * negative error codes:
+ *
+ * NGHTTP2_ERR_NOMEM
+ *     Out of memory.
+ */
+static int session_window_tuner_on_data(nghttp2_session *session) {
+  nghttp2_window_tuner *tuner = &session->window_tuner;
+  uint64_t now;
+  int rv;
+
+  if (tuner->max_window_size == 0 || tuner->ping_pending ||
+      session_is_closing(session)) {
+    return 0;
+  }
+
+  now = nghttp2_time_now_usec();
+  if (now == 0) {
+    /* No clock available */
+    return 0;
+  }
+
+  if (tuner->rtt &&
+      now - tuner->ping_ack_time < NGHTTP2_WINDOW_TUNER_PING_INTERVAL) {
+    return 0;
+  }
+
+  rv = nghttp2_session_add_ping(session, NGHTTP2_FLAG_NONE,
+                                window_tuner_ping_data);
+  if (rv != 0) {
+    return rv;
+  }
+
+  tuner->ping_pending = 1;
+  tuner->ping_sent_time = 0;
+
+  return 0;
+}
+
+/*
+ * Updates the round trip time of window auto-tuning when PING ACK
+ * |frame| is received.  The time is smoothed like SRTT of TCP.
+ */
+static void session_window_tuner_on_ping_ack(nghttp2_session *session,
+                                             nghttp2_frame *frame) {
+  nghttp2_window_tuner *tuner = &session->window_tuner;
+  uint64_t now, rtt;
+
+  if (tuner->ping_sent_time == 0 ||
+      memcmp(frame->ping.opaque_data, window_tuner_ping_data,
+             sizeof(window_tuner_ping_data)) != 0) {
+    return;
+  }
+
+  now = nghttp2_time_now_usec();
+  rtt = nghttp2_max(now - tuner->ping_sent_time, 1);
+
+  if (tuner->rtt == 0) {
+    tuner->rtt = rtt;
+  } else {
+    tuner->rtt = (tuner->rtt * 7 + rtt) / 8;
+  }
+
+  tuner->ping_pending = 0;
+  tuner->ping_sent_time = 0;
+  tuner->ping_ack_time = now;
+}
+
+/*
+ * Resizes the connection window when WINDOW_UPDATE for |nbytes|
+ * consumed bytes is queued for the connection.  Dividing |nbytes| by
+ * the time since the previous WINDOW_UPDATE gives the rate the
+ * application consumes DATA.  The remote endpoint needs window for 2
+ * round trips of consumption not to stall, because WINDOW_UPDATE is
+ * only sent after a part of window is consumed, and takes a round
+ * trip to take effect.  If the window is smaller than that, it is
+ * doubled up to the configured maximum.  If it is more than 4 times
+ * larger, it is halved, but it never goes below the initial window
+ * size.  Streams follow the connection window as they receive DATA.
+ *
+ * This function returns 0 if it succeeds, or one of the following
+ * negative error codes:
+ *
+ * NGHTTP2_ERR_NOMEM
+ *     Out of memory.
+ */
+static int session_window_tuner_on_window_update(nghttp2_session *session,
+                                                 int32_t nbytes) {
+  nghttp2_window_tuner *tuner = &session->window_tuner;
+  uint64_t now, last_update_time, interval, need;
+  int32_t window_size;
+  int32_t min_window_size;
+
+  if (tuner->max_window_size == 0) {
+    return 0;
+  }
+
+  now = nghttp2_time_now_usec();
+  if (now == 0) {
+    return 0;
+  }
+
+  last_update_time = tuner->last_update_time;
+  tuner->last_update_time = now;
+
+  if (tuner->rtt == 0 || last_update_time == 0) {
+    return 0;
+  }
+
+  interval = nghttp2_max(now - last_update_time, 1);
+  /* Bytes consumed in 2 round trips */
+  need = (uint64_t)nbytes * tuner->rtt * 2 / interval;
+
+  window_size = session->local_window_size;
+
+  if (need >= (uint64_t)window_size) {
+    if (window_size >= tuner->max_window_size) {
+      return 0;
+    }
+    window_size = (int32_t)nghttp2_min((uint64_t)window_size * 2,
+                                       (uint64_t)tuner->max_window_size);
+  } else if (need * 4 < (uint64_t)window_size) {
+    min_window_size =
+        (int32_t)nghttp2_max(session->local_settings.initial_window_size,
+                             NGHTTP2_INITIAL_CONNECTION_WINDOW_SIZE);
+    min_window_size = nghttp2_min(min_window_size, tuner->max_window_size);
+
+    if (window_size <= min_window_size) {
+      return 0;
+    }
+    window_size = nghttp2_max(window_size / 2, (int32_t)need * 2);
+    window_size = nghttp2_max(window_size, min_window_size);
+  } else {
+    return 0;
+  }
+
+  tuner->window_size = window_size;
+
+  return session_set_local_window_size(session, NULL, window_size);
+}
+
 int nghttp2_session_on_ping_received(nghttp2_session *session,
                                      nghttp2_frame *frame) {
   int rv = 0;
@@ -4246,15 +5559,19 @@ int nghttp2_session_on_ping_received(nghttp2_session *session,
       return rv;
     }
   }
+  if ((frame->hd.flags & NGHTTP2_FLAG_ACK) &&
+      session->window_tuner.max_window_size) {
+    session_window_tuner_on_ping_ack(session, frame);
+  }
   return session_call_on_frame_received(session, frame);
 }
 
-static int session_process_ping_frame(nghttp2_session *session) {
+static int session_process_ping_frame(nghttp2_session *session,
+                                      const uint8_t *payload) {
   nghttp2_inbound_frame *iframe = &session->iframe;
   nghttp2_frame *frame = &iframe->frame;
 
-  nghttp2_frame_unpack_ping_payload(&frame->ping, iframe->sbuf.pos,
-                                    nghttp2_buf_len(&iframe->sbuf));
+  nghttp2_frame_unpack_ping_payload(&frame->ping, payload, 8);
 
   return nghttp2_session_on_ping_received(session, frame);
 }
@@ -4371,12 +5688,13 @@ int nghttp2_session_on_window_update_received(nghttp2_session *session,
   }
 }
 
-static int session_process_window_update_frame(nghttp2_session *session) {
+static int session_process_window_update_frame(nghttp2_session *session,
+                                               const uint8_t *payload) {
   nghttp2_inbound_frame *iframe = &session->iframe;
   nghttp2_frame *frame = &iframe->frame;
 
-  nghttp2_frame_unpack_window_update_payload(
-      &frame->window_update, iframe->sbuf.pos, nghttp2_buf_len(&iframe->sbuf));
+  nghttp2_frame_unpack_window_update_payload(&frame->window_update, payload,
+                                             4);
 
   return nghttp2_session_on_window_update_received(session, frame);
 }
@@ -4480,6 +5798,16 @@ static int session_update_recv_stream_window_size(nghttp2_session *session,
     return nghttp2_session_add_rst_stream(session, stream->stream_id,
                                           NGHTTP2_FLOW_CONTROL_ERROR);
   }
+  /* Let stream window follow the connection window chosen by
+     auto-tuning */
+  if (send_window_update && session->window_tuner.window_size &&
+      stream->local_window_size != session->window_tuner.window_size) {
+    rv = session_set_local_window_size(session, stream,
+                                       session->window_tuner.window_size);
+    if (rv != 0) {
+      return rv;
+    }
+  }
   /* We don't have to send WINDOW_UPDATE if the data received is the
      last chunk in the incoming stream. */
   if (send_window_update &&
@@ -4488,9 +5816,8 @@ static int session_update_recv_stream_window_size(nghttp2_session *session,
        the remote endpoint should honor. */
     if (nghttp2_should_send_window_update(stream->local_window_size,
                                           stream->recv_window_size)) {
-      rv = nghttp2_session_add_window_update(session, NGHTTP2_FLAG_NONE,
-                                             stream->stream_id,
-                                             stream->recv_window_size);
+      rv = session_add_coalesced_window_update(session, stream,
+                                               stream->recv_window_size);
       if (rv == 0) {
         stream->recv_window_size = 0;
       } else {
@@ -4516,35 +5843,48 @@ static int session_update_recv_stream_window_size(nghttp2_session *session,
 static int session_update_recv_connection_window_size(nghttp2_session *session,
                                                       size_t delta_size) {
   int rv;
+  int32_t recv_size;
   rv = adjust_recv_window_size(&session->recv_window_size, delta_size,
                                session->local_window_size);
   if (rv != 0) {
     return nghttp2_session_terminate_session(session,
                                              NGHTTP2_FLOW_CONTROL_ERROR);
   }
+  rv = session_window_tuner_on_data(session);
+  if (rv != 0) {
+    return rv;
+  }
   if (!(session->opt_flags & NGHTTP2_OPTMASK_NO_AUTO_WINDOW_UPDATE)) {
 
-    if (nghttp2_should_send_window_update(session->local_window_size,
-                                          session->recv_window_size)) {
-      /* Use stream ID 0 to update connection-level flow control
-         window */
-      rv = nghttp2_session_add_window_update(session, NGHTTP2_FLAG_NONE, 0,
-                                             session->recv_window_size);
+    if (session_should_send_connection_window_update(
+            session, session->recv_window_size)) {
+      recv_size = session->recv_window_size;
+
+      rv = session_add_coalesced_window_update(session, NULL, recv_size);
       if (rv != 0) {
         return rv;
       }
 
       session->recv_window_size = 0;
+
+      return session_window_tuner_on_window_update(session, recv_size);
     }
   }
   return 0;
 }
 
+/*
+ * Accumulates |delta_size| bytes consumed by the application for
+ * |stream|, or the connection if |stream| is NULL, and queues
+ * WINDOW_UPDATE if enough bytes are consumed.
+ */
 static int session_update_consumed_size(nghttp2_session *session,
                                         int32_t *consumed_size_ptr,
                                         int32_t *recv_window_size_ptr,
-                                        int32_t stream_id, size_t delta_size,
+                                        nghttp2_stream *stream,
+                                        size_t delta_size,
                                         int32_t local_window_size) {
+  int send_window_update;
   int32_t recv_size;
   int rv;
 
@@ -4560,9 +5900,16 @@ static int session_update_consumed_size(nghttp2_session *session,
      nghttp2_submit_window_update(). */
   recv_size = nghttp2_min(*consumed_size_ptr, *recv_window_size_ptr);
 
-  if (nghttp2_should_send_window_update(local_window_size, recv_size)) {
-    rv = nghttp2_session_add_window_update(session, NGHTTP2_FLAG_NONE,
-                                           stream_id, recv_size);
+  if (stream) {
+    send_window_update =
+        nghttp2_should_send_window_update(local_window_size, recv_size);
+  } else {
+    send_window_update =
+        session_should_send_connection_window_update(session, recv_size);
+  }
+
+  if (send_window_update) {
+    rv = session_add_coalesced_window_update(session, stream, recv_size);
 
     if (rv != 0) {
       return rv;
@@ -4570,6 +5917,10 @@ static int session_update_consumed_size(nghttp2_session *session,
 
     *recv_window_size_ptr -= recv_size;
     *consumed_size_ptr -= recv_size;
+
+    if (!stream) {
+      return session_window_tuner_on_window_update(session, recv_size);
+    }
   }
 
   return 0;
@@ -4578,16 +5929,16 @@ static int session_update_consumed_size(nghttp2_session *session,
 static int session_update_stream_consumed_size(nghttp2_session *session,
                                                nghttp2_stream *stream,
                                                size_t delta_size) {
-  return session_update_consumed_size(
-      session, &stream->consumed_size, &stream->recv_window_size,
-      stream->stream_id, delta_size, stream->local_window_size);
+  return session_update_consumed_size(session, &stream->consumed_size,
+                                      &stream->recv_window_size, stream,
+                                      delta_size, stream->local_window_size);
 }
 
 static int session_update_connection_consumed_size(nghttp2_session *session,
                                                    size_t delta_size) {
   return session_update_consumed_size(session, &session->consumed_size,
-                                      &session->recv_window_size, 0, delta_size,
-                                      session->local_window_size);
+                                      &session->recv_window_size, NULL,
+                                      delta_size, session->local_window_size);
 }
 
 /*
@@ -4751,6 +6102,19 @@ static int inbound_frame_handle_pad(nghttp2_inbound_frame *iframe,
   return 0;
 }
 
+/*
+ * Counts the received frame whose header is |hd| in session->stats.
+ */
+static void session_stats_add_recv(nghttp2_session *session,
+                                   const nghttp2_frame_hd *hd) {
+  if (hd->type >= NGHTTP2_STATS_NUM_FRAME_TYPES) {
+    return;
+  }
+
+  ++session->stats.frames_recv[hd->type];
+  session->stats.bytes_recv[hd->type] += NGHTTP2_FRAME_HDLEN + hd->length;
+}
+
 /*
  * Computes number of padding based on flags. This function returns
  * the calculated length if it succeeds, or -1.
@@ -4797,6 +6161,28 @@ static ssize_t inbound_frame_effective_readlen(nghttp2_inbound_frame *iframe,
   return readlen;
 }
 
+/*
+ * Processes PRIORITY, RST_STREAM, PING or WINDOW_UPDATE frame whose
+ * frame header is in iframe->frame.hd, and whose payload is
+ * |payload|.  The length of payload must have been validated.
+ */
+static int session_process_fixed_length_frame(nghttp2_session *session,
+                                              const uint8_t *payload) {
+  switch (session->iframe.frame.hd.type) {
+  case NGHTTP2_PRIORITY:
+    return session_process_priority_frame(session, payload);
+  case NGHTTP2_RST_STREAM:
+    return session_process_rst_stream_frame(session, payload);
+  case NGHTTP2_PING:
+    return session_process_ping_frame(session, payload);
+  case NGHTTP2_WINDOW_UPDATE:
+    return session_process_window_update_frame(session, payload);
+  default:
+    assert(0);
+    return 0;
+  }
+}
+
 ssize_t nghttp2_session_mem_recv(nghttp2_session *session, const uint8_t *in,
                                  size_t inlen) {
   const uint8_t *first = in, *last = in + inlen;
@@ -4869,16 +6255,28 @@ ssize_t nghttp2_session_mem_recv(nghttp2_session *session, const uint8_t *in,
 
       DEBUGF(fprintf(stderr, "recv: [IB_READ_HEAD]\n"));
 
-      readlen = inbound_frame_buf_read(iframe, in, last);
-      in += readlen;
+      if (nghttp2_buf_len(&iframe->sbuf) == 0 &&
+          (size_t)(last - in) >= NGHTTP2_FRAME_HDLEN) {
+        /* Whole frame header is available in |in|.  Unpack it in
+           place rather than copying it into iframe->sbuf.  The
+           following states do not read frame header from
+           iframe->sbuf. */
+        nghttp2_frame_unpack_frame_hd(&iframe->frame.hd, in);
+        in += NGHTTP2_FRAME_HDLEN;
+      } else {
+        readlen = inbound_frame_buf_read(iframe, in, last);
+        in += readlen;
 
-      if (nghttp2_buf_mark_avail(&iframe->sbuf)) {
-        return in - first;
-      }
+        if (nghttp2_buf_mark_avail(&iframe->sbuf)) {
+          return in - first;
+        }
 
-      nghttp2_frame_unpack_frame_hd(&iframe->frame.hd, iframe->sbuf.pos);
+        nghttp2_frame_unpack_frame_hd(&iframe->frame.hd, iframe->sbuf.pos);
+      }
       iframe->payloadleft = iframe->frame.hd.length;
 
+      session_stats_add_recv(session, &iframe->frame.hd);
+
       DEBUGF(fprintf(stderr, "recv: payloadlen=%zu, type=%u, flags=0x%02x, "
                              "stream_id=%d\n",
                      iframe->frame.hd.length, iframe->frame.hd.type,
@@ -5204,6 +6602,32 @@ ssize_t nghttp2_session_mem_recv(nghttp2_session *session, const uint8_t *in,
         }
       }
 
+      /* If the whole payload of small control frame is available in
+         |in|, process it here without copying it into iframe->sbuf
+         in NGHTTP2_IB_READ_NBYTE state.  This lets a burst of such
+         frames be processed one frame per iteration. */
+      if (iframe->state == NGHTTP2_IB_READ_NBYTE &&
+          (size_t)(last - in) >= iframe->payloadleft) {
+        switch (iframe->frame.hd.type) {
+        case NGHTTP2_PRIORITY:
+        case NGHTTP2_RST_STREAM:
+        case NGHTTP2_PING:
+        case NGHTTP2_WINDOW_UPDATE:
+          readlen = iframe->payloadleft;
+
+          rv = session_process_fixed_length_frame(session, in);
+          if (nghttp2_is_fatal(rv)) {
+            return rv;
+          }
+
+          in += readlen;
+
+          session_inbound_frame_reset(session);
+
+          break;
+        }
+      }
+
       break;
     }
     case NGHTTP2_IB_READ_NBYTE:
@@ -5281,7 +6705,7 @@ ssize_t nghttp2_session_mem_recv(nghttp2_session *session, const uint8_t *in,
 
         break;
       case NGHTTP2_PRIORITY:
-        rv = session_process_priority_frame(session);
+        rv = session_process_priority_frame(session, iframe->sbuf.pos);
         if (nghttp2_is_fatal(rv)) {
           return rv;
         }
@@ -5290,7 +6714,7 @@ ssize_t nghttp2_session_mem_recv(nghttp2_session *session, const uint8_t *in,
 
         break;
       case NGHTTP2_RST_STREAM:
-        rv = session_process_rst_stream_frame(session);
+        rv = session_process_rst_stream_frame(session, iframe->sbuf.pos);
         if (nghttp2_is_fatal(rv)) {
           return rv;
         }
@@ -5356,7 +6780,7 @@ ssize_t nghttp2_session_mem_recv(nghttp2_session *session, const uint8_t *in,
 
         break;
       case NGHTTP2_PING:
-        rv = session_process_ping_frame(session);
+        rv = session_process_ping_frame(session, iframe->sbuf.pos);
         if (nghttp2_is_fatal(rv)) {
           return rv;
         }
@@ -5387,7 +6811,7 @@ ssize_t nghttp2_session_mem_recv(nghttp2_session *session, const uint8_t *in,
         break;
       }
       case NGHTTP2_WINDOW_UPDATE:
-        rv = session_process_window_update_frame(session);
+        rv = session_process_window_update_frame(session, iframe->sbuf.pos);
         if (nghttp2_is_fatal(rv)) {
           return rv;
         }
@@ -5631,6 +7055,8 @@ ssize_t nghttp2_session_mem_recv(nghttp2_session *session, const uint8_t *in,
       nghttp2_frame_unpack_frame_hd(&cont_hd, iframe->sbuf.pos);
       iframe->payloadleft = cont_hd.length;
 
+      session_stats_add_recv(session, &cont_hd);
+
       DEBUGF(fprintf(stderr, "recv: payloadlen=%zu, type=%u, flags=0x%02x, "
                              "stream_id=%d\n",
                      cont_hd.length, cont_hd.type, cont_hd.flags,
@@ -5951,9 +7377,11 @@ int nghttp2_session_want_write(nghttp2_session *session) {
    */
 
   if (session->aob.item == NULL &&
+      (session->submission_queue == NULL ||
+       nghttp2_submission_queue_empty(session->submission_queue)) &&
       nghttp2_outbound_queue_top(&session->ob_urgent) == NULL &&
       nghttp2_outbound_queue_top(&session->ob_reg) == NULL &&
-      (nghttp2_pq_empty(&session->ob_da_pq) ||
+      (nghttp2_pq_empty(&session->roots.obq) ||
        session->remote_window_size == 0) &&
       (nghttp2_outbound_queue_top(&session->ob_syn) == NULL ||
        session_is_outgoing_concurrent_streams_max(session))) {
@@ -5971,10 +7399,8 @@ int nghttp2_session_add_ping(nghttp2_session *session, uint8_t flags,
   int rv;
   nghttp2_outbound_item *item;
   nghttp2_frame *frame;
-  nghttp2_mem *mem;
 
-  mem = &session->mem;
-  item = nghttp2_mem_malloc(mem, sizeof(nghttp2_outbound_item));
+  item = nghttp2_mempool_alloc(&session->item_pool);
   if (item == NULL) {
     return NGHTTP2_ERR_NOMEM;
   }
@@ -5989,7 +7415,7 @@ int nghttp2_session_add_ping(nghttp2_session *session, uint8_t flags,
 
   if (rv != 0) {
     nghttp2_frame_ping_free(&frame->ping);
-    nghttp2_mem_free(mem, item);
+    nghttp2_mempool_release(&session->item_pool, item);
     return rv;
   }
   return 0;
@@ -6022,7 +7448,7 @@ int nghttp2_session_add_goaway(nghttp2_session *session, int32_t last_stream_id,
     memcpy(opaque_data_copy, opaque_data, opaque_data_len);
   }
 
-  item = nghttp2_mem_malloc(mem, sizeof(nghttp2_outbound_item));
+  item = nghttp2_mempool_alloc(&session->item_pool);
   if (item == NULL) {
     nghttp2_mem_free(mem, opaque_data_copy);
     return NGHTTP2_ERR_NOMEM;
@@ -6045,7 +7471,7 @@ int nghttp2_session_add_goaway(nghttp2_session *session, int32_t last_stream_id,
   rv = nghttp2_session_add_item(session, item);
   if (rv != 0) {
     nghttp2_frame_goaway_free(&frame->goaway, mem);
-    nghttp2_mem_free(mem, item);
+    nghttp2_mempool_release(&session->item_pool, item);
     return rv;
   }
   return 0;
@@ -6054,32 +7480,8 @@ int nghttp2_session_add_goaway(nghttp2_session *session, int32_t last_stream_id,
 int nghttp2_session_add_window_update(nghttp2_session *session, uint8_t flags,
                                       int32_t stream_id,
                                       int32_t window_size_increment) {
-  int rv;
-  nghttp2_outbound_item *item;
-  nghttp2_frame *frame;
-  nghttp2_mem *mem;
-
-  mem = &session->mem;
-  item = nghttp2_mem_malloc(mem, sizeof(nghttp2_outbound_item));
-  if (item == NULL) {
-    return NGHTTP2_ERR_NOMEM;
-  }
-
-  nghttp2_outbound_item_init(item);
-
-  frame = &item->frame;
-
-  nghttp2_frame_window_update_init(&frame->window_update, flags, stream_id,
-                                   window_size_increment);
-
-  rv = nghttp2_session_add_item(session, item);
-
-  if (rv != 0) {
-    nghttp2_frame_window_update_free(&frame->window_update);
-    nghttp2_mem_free(mem, item);
-    return rv;
-  }
-  return 0;
+  return session_add_window_update_item(session, NULL, flags, stream_id,
+                                        window_size_increment);
 }
 
 int nghttp2_session_add_settings(nghttp2_session *session, uint8_t flags,
@@ -6105,7 +7507,7 @@ int nghttp2_session_add_settings(nghttp2_session *session, uint8_t flags,
     return NGHTTP2_ERR_INVALID_ARGUMENT;
   }
 
-  item = nghttp2_mem_malloc(mem, sizeof(nghttp2_outbound_item));
+  item = nghttp2_mempool_alloc(&session->item_pool);
   if (item == NULL) {
     return NGHTTP2_ERR_NOMEM;
   }
@@ -6113,7 +7515,7 @@ int nghttp2_session_add_settings(nghttp2_session *session, uint8_t flags,
   if (niv > 0) {
     iv_copy = nghttp2_frame_iv_copy(iv, niv, mem);
     if (iv_copy == NULL) {
-      nghttp2_mem_free(mem, item);
+      nghttp2_mempool_release(&session->item_pool, item);
       return NGHTTP2_ERR_NOMEM;
     }
   } else {
@@ -6126,7 +7528,7 @@ int nghttp2_session_add_settings(nghttp2_session *session, uint8_t flags,
 
       if (session->inflight_iv == NULL) {
         nghttp2_mem_free(mem, iv_copy);
-        nghttp2_mem_free(mem, item);
+        nghttp2_mempool_release(&session->item_pool, item);
         return NGHTTP2_ERR_NOMEM;
       }
     } else {
@@ -6153,7 +7555,7 @@ int nghttp2_session_add_settings(nghttp2_session *session, uint8_t flags,
     }
 
     nghttp2_frame_settings_free(&frame->settings, mem);
-    nghttp2_mem_free(mem, item);
+    nghttp2_mempool_release(&session->item_pool, item);
 
     return rv;
   }
@@ -6276,10 +7678,11 @@ int nghttp2_session_pack_data(nghttp2_session *session, nghttp2_bufs *bufs,
   }
 
   if (data_flags & NGHTTP2_DATA_FLAG_NO_COPY) {
-    if (session->callbacks.send_data_callback == NULL) {
-      DEBUGF(fprintf(
-          stderr,
-          "NGHTTP2_DATA_FLAG_NO_COPY requires send_data_callback set\n"));
+    if (session->callbacks.send_data_callback == NULL &&
+        session->callbacks.get_data_vec_callback == NULL) {
+      DEBUGF(fprintf(stderr, "NGHTTP2_DATA_FLAG_NO_COPY requires "
+                             "send_data_callback or get_data_vec_callback "
+                             "set\n"));
 
       return NGHTTP2_ERR_CALLBACK_FAILURE;
     }
@@ -6308,8 +7711,8 @@ int nghttp2_session_pack_data(nghttp2_session *session, nghttp2_bufs *bufs,
     return rv;
   }
 
-  session_outbound_item_schedule(
-      session, stream->item, nghttp2_stream_compute_effective_weight(stream));
+  stream->last_writelen = frame->hd.length;
+  nghttp2_stream_reschedule(stream);
 
   return 0;
 }
@@ -6359,7 +7762,7 @@ size_t nghttp2_session_get_outbound_queue_size(nghttp2_session *session) {
   return nghttp2_outbound_queue_size(&session->ob_urgent) +
          nghttp2_outbound_queue_size(&session->ob_reg) +
          nghttp2_outbound_queue_size(&session->ob_syn) +
-         nghttp2_pq_size(&session->ob_da_pq);
+         nghttp2_stream_roots_num_outbound_item(&session->roots);
 }
 
 int32_t
@@ -6518,6 +7921,40 @@ int nghttp2_session_get_stream_remote_close(nghttp2_session *session,
   return (stream->shut_flags & NGHTTP2_SHUT_RD) != 0;
 }
 
+void nghttp2_session_get_stats(nghttp2_session *session,
+                               nghttp2_session_stats *stats) {
+  *stats = session->stats;
+
+  stats->ob_urgent_len = nghttp2_outbound_queue_size(&session->ob_urgent);
+  stats->ob_reg_len = nghttp2_outbound_queue_size(&session->ob_reg);
+  stats->ob_syn_len = nghttp2_outbound_queue_size(&session->ob_syn);
+  stats->ob_data_len = nghttp2_stream_roots_num_outbound_item(&session->roots);
+  stats->mem_used = session_get_mem_used(session);
+}
+
+void nghttp2_session_set_submission_queue(nghttp2_session *session,
+                                          nghttp2_submission_queue *q) {
+  session->submission_queue = q;
+}
+
+int nghttp2_session_get_slab_stat(nghttp2_session *session,
+                                  nghttp2_slab_type type,
+                                  nghttp2_slab_stat *stat) {
+  switch (type) {
+  case NGHTTP2_SLAB_STREAM:
+    nghttp2_mempool_get_stat(&session->stream_pool, stat);
+    return 0;
+  case NGHTTP2_SLAB_OUTBOUND_ITEM:
+    nghttp2_mempool_get_stat(&session->item_pool, stat);
+    return 0;
+  case NGHTTP2_SLAB_STREAM_TOMBSTONE:
+    nghttp2_mempool_get_stat(&session->tombstone_pool, stat);
+    return 0;
+  default:
+    return NGHTTP2_ERR_INVALID_ARGUMENT;
+  }
+}
+
 int nghttp2_session_consume(nghttp2_session *session, int32_t stream_id,
                             size_t size) {
   int rv;
@@ -37,9 +37,11 @@
 #include "nghttp2_stream.h"
 #include "nghttp2_outbound_item.h"
 #include "nghttp2_int.h"
+#include "nghttp2_submission_queue.h"
 #include "nghttp2_buf.h"
 #include "nghttp2_callbacks.h"
 #include "nghttp2_mem.h"
+#include "nghttp2_mempool.h"
 
 /*
  * Option flags.
@@ -57,9 +59,21 @@ typedef enum {
   NGHTTP2_OB_SEND_CLIENT_MAGIC
 } nghttp2_outbound_state;
 
+/* The maximum number of frame buffers nghttp2_session_mem_sendv()
+   hands out in one invocation */
+#define NGHTTP2_SENDV_MAX_FRAMEBUFS 16
+
 typedef struct {
   nghttp2_outbound_item *item;
   nghttp2_bufs framebufs;
+  /* Frame buffers swapped with |framebufs| by
+     nghttp2_session_mem_sendv(), so that serialized frames it handed
+     out are not overwritten by the next frame.  This array has
+     NGHTTP2_SENDV_MAX_FRAMEBUFS elements and is allocated on first
+     use. */
+  nghttp2_bufs *sendv_bufs;
+  /* The number of initialized elements in |sendv_bufs| */
+  size_t sendv_nbufs;
   nghttp2_outbound_state state;
 } nghttp2_active_outbound_item;
 
@@ -67,6 +81,41 @@ typedef struct {
    nghttp2_session_recv(). */
 #define NGHTTP2_INBOUND_BUFFER_LENGTH 16384
 
+/* The number of closed streams and tombstones kept when the memory
+   usage is just over the half of the budget, and the local
+   SETTINGS_MAX_CONCURRENT_STREAMS is unlimited */
+#define NGHTTP2_MEM_CLOSED_STREAM_MAX 100
+
+/* The minimum interval between PINGs to measure round trip time for
+   window auto-tuning, in microseconds */
+#define NGHTTP2_WINDOW_TUNER_PING_INTERVAL 1000000
+
+/* State of automatic tuning of local flow control window.  See
+   nghttp2_option_set_window_auto_tuning(). */
+typedef struct {
+  /* The time when the PING to measure round trip time was sent, in
+     microseconds.  0 if it has not been sent yet. */
+  uint64_t ping_sent_time;
+  /* The time when the last PING ACK was received, in
+     microseconds */
+  uint64_t ping_ack_time;
+  /* Smoothed round trip time in microseconds.  0 if it has not been
+     measured yet. */
+  uint64_t rtt;
+  /* The time when the last connection-level WINDOW_UPDATE was
+     queued, in microseconds.  0 if there is no such WINDOW_UPDATE
+     yet. */
+  uint64_t last_update_time;
+  /* The maximum window size.  0 if auto-tuning is disabled. */
+  int32_t max_window_size;
+  /* The window size streams are tuned to.  0 if no tuning has
+     happened yet. */
+  int32_t window_size;
+  /* nonzero if the PING to measure round trip time is queued or in
+     flight */
+  uint8_t ping_pending;
+} nghttp2_window_tuner;
+
 /* Internal state when receiving incoming frame */
 typedef enum {
   /* Receiving frame header */
@@ -142,6 +191,11 @@ typedef enum {
 
 struct nghttp2_session {
   nghttp2_map /* <nghttp2_stream*> */ streams;
+  /* Tombstones of closed streams.  The hash table is allocated when
+     the first tombstone is made. */
+  nghttp2_map /* <nghttp2_stream_tombstone*> */ tombstones;
+  /* Dependency tree roots.  Streams with DATA to send are scheduled
+     in the queues rooted at roots.obq. */
   nghttp2_stream_roots roots;
   /* Queue for outbound urgent frames (PING and SETTINGS) */
   nghttp2_outbound_queue ob_urgent;
@@ -151,19 +205,36 @@ struct nghttp2_session {
      response) frame, which are subject to
      SETTINGS_MAX_CONCURRENT_STREAMS limit. */
   nghttp2_outbound_queue ob_syn;
-  /* Queue for DATA frame */
-  nghttp2_pq /* <nghttp2_outbound_item*> */ ob_da_pq;
   nghttp2_active_outbound_item aob;
   nghttp2_inbound_frame iframe;
   nghttp2_hd_deflater hd_deflater;
   nghttp2_hd_inflater hd_inflater;
   nghttp2_session_callbacks callbacks;
-  /* Memory allocator */
+  /* Memory allocator.  If the memory budget is set, this goes
+     through |mem_tracker|. */
   nghttp2_mem mem;
-  /* Base value when we schedule next DATA frame write.  This is
-     updated when one frame was written. */
-  uint64_t last_cycle;
+  /* Counts the memory allocated through |mem| if |max_memory| is
+     nonzero.  Its base allocator then allocated the session
+     object. */
+  nghttp2_mem_tracker mem_tracker;
+  /* Allocator for nghttp2_stream */
+  nghttp2_mempool stream_pool;
+  /* Allocator for nghttp2_outbound_item */
+  nghttp2_mempool item_pool;
+  /* Allocator for nghttp2_stream_tombstone */
+  nghttp2_mempool tombstone_pool;
+  /* State of receive window auto-tuning */
+  nghttp2_window_tuner window_tuner;
+  /* Counters returned by nghttp2_session_get_stats().  Queue lengths
+     are computed on demand and not stored here. */
+  nghttp2_session_stats stats;
   void *user_data;
+  /* WINDOW_UPDATE for the connection queued automatically, which is
+     not sent yet.  Further increments are merged into it. */
+  nghttp2_outbound_item *window_update_item;
+  /* The queue of requests made by other threads.  NULL if it is not
+     attached. */
+  nghttp2_submission_queue *submission_queue;
   /* Points to the latest closed stream.  NULL if there is no closed
      stream.  Only used when session is initialized as server. */
   nghttp2_stream *closed_stream_head;
@@ -176,6 +247,12 @@ struct nghttp2_session {
   /* Points to the oldest idle stream.  NULL if there is no idle
      stream.  Only used when session is initialized as erver. */
   nghttp2_stream *idle_stream_tail;
+  /* Points to the oldest tombstone.  NULL if there is no tombstone.
+     Only used when session is initialized as server. */
+  nghttp2_stream_tombstone *tombstone_head;
+  /* Points to the latest tombstone.  NULL if there is no
+     tombstone. */
+  nghttp2_stream_tombstone *tombstone_tail;
   /* In-flight SETTINGS values. NULL does not necessarily mean there
      is no in-flight SETTINGS. */
   nghttp2_settings_entry *inflight_iv;
@@ -198,8 +275,14 @@ struct nghttp2_session {
      |idle_stream_head|.  The current implementation only keeps idle
      streams if session is initialized as server. */
   size_t num_idle_streams;
+  /* The number of tombstones in |tombstones|.  They count toward the
+     limit of closed streams together with |num_closed_streams|. */
+  size_t num_tombstones;
   /* The number of bytes allocated for nvbuf */
   size_t nvbuflen;
+  /* The memory budget set by nghttp2_option_set_max_session_memory().
+     0 if there is no budget. */
+  size_t max_memory;
   /* Next Stream ID. Made unsigned int to detect >= (1 << 31). */
   uint32_t next_stream_id;
   /* The largest stream ID received so far */
@@ -241,6 +324,13 @@ struct nghttp2_session {
   nghttp2_settings_storage local_settings;
   /* Option flags. This is bitwise-OR of 0 or more of nghttp2_optmask. */
   uint32_t opt_flags;
+  /* SETTINGS_MAX_CONCURRENT_STREAMS of the remote endpoint assumed
+     until its SETTINGS is received.  See
+     nghttp2_option_set_peer_max_concurrent_streams(). */
+  uint32_t peer_max_concurrent_streams;
+  /* The percentage of connection-level window which must be
+     consumed before WINDOW_UPDATE is sent for the connection */
+  uint32_t connection_window_update_threshold;
   /* Unacked local SETTINGS_MAX_CONCURRENT_STREAMS value. We use this
      to refuse the incoming stream if it exceeds this value. */
   uint32_t pending_local_max_concurrent_stream;
@@ -427,26 +517,45 @@ int nghttp2_session_close_stream(nghttp2_session *session, int32_t stream_id,
  * Deletes |stream| from memory.  After this function returns, stream
  * cannot be accessed.
  *
+ * This function returns 0 if it succeeds, or one of the following
+ * negative error codes:
+ *
+ * NGHTTP2_ERR_NOMEM
+ *     Out of memory
  */
-void nghttp2_session_destroy_stream(nghttp2_session *session,
-                                    nghttp2_stream *stream);
+int nghttp2_session_destroy_stream(nghttp2_session *session,
+                                   nghttp2_stream *stream);
 
 /*
  * Tries to keep incoming closed stream |stream|.  Due to the
  * limitation of maximum number of streams in memory, |stream| is not
  * closed and just deleted from memory (see
- * nghttp2_session_destroy_stream).
+ * nghttp2_session_destroy_stream).  If |stream| has no descendant in
+ * the dependency tree, it is deleted from memory, and its tombstone
+ * is kept instead.
+ *
+ * This function returns 0 if it succeeds, or one of the following
+ * negative error codes:
+ *
+ * NGHTTP2_ERR_NOMEM
+ *     Out of memory
  */
-void nghttp2_session_keep_closed_stream(nghttp2_session *session,
-                                        nghttp2_stream *stream);
+int nghttp2_session_keep_closed_stream(nghttp2_session *session,
+                                       nghttp2_stream *stream);
 
 /*
  * Appends |stream| to linked list |session->idle_stream_head|.  We
  * apply fixed limit for list size.  To fit into that limit, one or
  * more oldest streams are removed from list as necessary.
+ *
+ * This function returns 0 if it succeeds, or one of the following
+ * negative error codes:
+ *
+ * NGHTTP2_ERR_NOMEM
+ *     Out of memory
  */
-void nghttp2_session_keep_idle_stream(nghttp2_session *session,
-                                      nghttp2_stream *stream);
+int nghttp2_session_keep_idle_stream(nghttp2_session *session,
+                                     nghttp2_stream *stream);
 
 /*
  * Detaches |stream| from idle streams linked list.
@@ -459,16 +568,29 @@ void nghttp2_session_detach_idle_stream(nghttp2_session *session,
  * including active and closed is in the maximum number of allowed
  * stream.  If |offset| is nonzero, it is decreased from the maximum
  * number of allowed stream when comparing number of active and closed
- * stream and the maximum number.
+ * stream and the maximum number.  Tombstones are deleted before
+ * closed streams.
+ *
+ * This function returns 0 if it succeeds, or one of the following
+ * negative error codes:
+ *
+ * NGHTTP2_ERR_NOMEM
+ *     Out of memory
  */
-void nghttp2_session_adjust_closed_stream(nghttp2_session *session,
-                                          ssize_t offset);
+int nghttp2_session_adjust_closed_stream(nghttp2_session *session,
+                                         ssize_t offset);
 
 /*
  * Deletes idle stream to ensure that number of idle streams is in
  * certain limit.
+ *
+ * This function returns 0 if it succeeds, or one of the following
+ * negative error codes:
+ *
+ * NGHTTP2_ERR_NOMEM
+ *     Out of memory
  */
-void nghttp2_session_adjust_idle_stream(nghttp2_session *session);
+int nghttp2_session_adjust_idle_stream(nghttp2_session *session);
 
 /*
  * If further receptions and transmissions over the stream |stream_id|
@@ -694,7 +816,8 @@ int nghttp2_session_pack_data(nghttp2_session *session, nghttp2_bufs *bufs,
  * returns NULL.  This function takes into account max concurrent
  * streams. That means if session->ob_pq is empty but
  * session->ob_ss_pq has item and max concurrent streams is reached,
- * then this function returns NULL.
+ * then this function returns NULL.  DATA item is not popped from its
+ * stream; it stays attached until it is detached or deferred.
  */
 nghttp2_outbound_item *
 nghttp2_session_pop_next_ob_item(nghttp2_session *session);
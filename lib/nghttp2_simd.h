@@ -0,0 +1,48 @@
+/*
+ * nghttp2 - HTTP/2 C Library
+ *
+ * Copyright (c) 2015 Tatsuhiro Tsujikawa
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef NGHTTP2_SIMD_H
+#define NGHTTP2_SIMD_H
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif /* HAVE_CONFIG_H */
+
+/* SSE2 is part of the x86-64 baseline, so the 16 byte kernels need
+   no runtime check.  The 32 byte AVX2 kernels are compiled with the
+   target attribute, and must only be used if
+   __builtin_cpu_supports("avx2") returns nonzero. */
+#if defined(__SSE2__) || defined(_M_X64) ||                                    \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define NGHTTP2_HAVE_SSE2 1
+#include <emmintrin.h>
+#endif /* __SSE2__ || _M_X64 || (_M_IX86_FP && _M_IX86_FP >= 2) */
+
+#if defined(NGHTTP2_HAVE_SSE2) && defined(__GNUC__) &&                         \
+    (defined(__clang__) || __GNUC__ >= 5)
+#define NGHTTP2_HAVE_AVX2_DISPATCH 1
+#include <immintrin.h>
+#endif /* NGHTTP2_HAVE_SSE2 && __GNUC__ && (__clang__ || __GNUC__ >= 5) */
+
+#endif /* NGHTTP2_SIMD_H */
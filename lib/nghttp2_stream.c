@@ -30,19 +30,34 @@
 #include "nghttp2_session.h"
 #include "nghttp2_helper.h"
 
+static int stream_less(const void *lhsx, const void *rhsx) {
+  const nghttp2_stream *lhs, *rhs;
+
+  lhs = nghttp2_struct_of(lhsx, nghttp2_stream, pq_entry);
+  rhs = nghttp2_struct_of(rhsx, nghttp2_stream, pq_entry);
+
+  if (lhs->cycle == rhs->cycle) {
+    return lhs->seq < rhs->seq;
+  }
+
+  return lhs->cycle < rhs->cycle;
+}
+
 void nghttp2_stream_init(nghttp2_stream *stream, int32_t stream_id,
                          uint8_t flags, nghttp2_stream_state initial_state,
                          int32_t weight, nghttp2_stream_roots *roots,
                          int32_t remote_initial_window_size,
                          int32_t local_initial_window_size,
-                         void *stream_user_data) {
+                         void *stream_user_data, nghttp2_mem *mem) {
   nghttp2_map_entry_init(&stream->map_entry, stream_id);
+  nghttp2_pq_init(&stream->obq, stream_less, mem);
   stream->stream_id = stream_id;
   stream->flags = flags;
   stream->state = initial_state;
   stream->shut_flags = NGHTTP2_SHUT_NONE;
   stream->stream_user_data = stream_user_data;
   stream->item = NULL;
+  stream->window_update_item = NULL;
   stream->remote_window_size = remote_initial_window_size;
   stream->local_window_size = local_initial_window_size;
   stream->recv_window_size = 0;
@@ -57,11 +72,17 @@ void nghttp2_stream_init(nghttp2_stream *stream, int32_t stream_id,
   stream->closed_prev = NULL;
   stream->closed_next = NULL;
 
-  stream->dpri = NGHTTP2_STREAM_DPRI_NO_ITEM;
   stream->num_substreams = 1;
   stream->weight = weight;
   stream->sum_dep_weight = 0;
-  stream->sum_norest_weight = 0;
+
+  stream->queued = 0;
+  stream->cycle = 0;
+  stream->descendant_last_cycle = 0;
+  stream->seq = 0;
+  stream->descendant_next_seq = 0;
+  stream->last_writelen = 0;
+  stream->pending_penalty = 0;
 
   stream->roots = roots;
   stream->root_prev = NULL;
@@ -73,65 +94,17 @@ void nghttp2_stream_init(nghttp2_stream *stream, int32_t stream_id,
   stream->status_code = -1;
 }
 
-void nghttp2_stream_free(nghttp2_stream *stream _U_) {
+void nghttp2_stream_free(nghttp2_stream *stream) {
   /* We don't free stream->item.  If it is assigned to aob, then
-     active_outbound_item_reset() will delete it.  If it is queued,
-     then it is deleted when pq is deleted in nghttp2_session_del().
-     Otherwise, nghttp2_session_del() will delete it. */
+     active_outbound_item_reset() will delete it.  Otherwise,
+     nghttp2_session_del() will delete it. */
+  nghttp2_pq_free(&stream->obq);
 }
 
 void nghttp2_stream_shutdown(nghttp2_stream *stream, nghttp2_shut_flag flag) {
   stream->shut_flags |= flag;
 }
 
-static int stream_push_item(nghttp2_stream *stream, nghttp2_session *session) {
-  /* This is required for Android NDK r10d */
-  int rv = 0;
-  nghttp2_outbound_item *item;
-
-  assert(stream->item);
-  assert(stream->item->queued == 0);
-
-  item = stream->item;
-
-  /* If item is now sent, don't push it to the queue.  Otherwise, we
-     may push same item twice. */
-  if (session->aob.item == item) {
-    return 0;
-  }
-
-  switch (item->frame.hd.type) {
-  case NGHTTP2_DATA:
-    /* Penalize item by delaying scheduling according to effective
-       weight.  This will delay low priority stream, which is good.
-       OTOH, this may incur delay for high priority item.  Will
-       see. */
-    item->cycle = session->last_cycle +
-                  NGHTTP2_DATA_PAYLOADLEN * NGHTTP2_MAX_WEIGHT /
-                      nghttp2_stream_compute_effective_weight(stream);
-
-    rv = nghttp2_pq_push(&session->ob_da_pq, item);
-    if (rv != 0) {
-      return rv;
-    }
-    break;
-  case NGHTTP2_HEADERS:
-    if (stream->state == NGHTTP2_STREAM_RESERVED) {
-      nghttp2_outbound_queue_push(&session->ob_syn, item);
-    } else {
-      nghttp2_outbound_queue_push(&session->ob_reg, item);
-    }
-    break;
-  default:
-    /* should not reach here */
-    assert(0);
-  }
-
-  item->queued = 1;
-
-  return 0;
-}
-
 static nghttp2_stream *stream_last_sib(nghttp2_stream *stream) {
   for (; stream->sib_next; stream = stream->sib_next)
     ;
@@ -154,71 +127,122 @@ int32_t nghttp2_stream_dep_distributed_weight(nghttp2_stream *stream,
   return nghttp2_max(1, weight);
 }
 
-static void stream_update_dep_set_rest(nghttp2_stream *stream) {
-  if (stream == NULL) {
-    return;
-  }
+/*
+ * Returns nonzero if |stream| itself has an item ready to send.
+ */
+static int stream_active(nghttp2_stream *stream) {
+  return stream->item &&
+         (stream->flags & NGHTTP2_STREAM_FLAG_DEFERRED_ALL) == 0;
+}
+
+/*
+ * Returns nonzero if |stream| or one of its descendants has an item
+ * ready to send.
+ */
+static int stream_subtree_active(nghttp2_stream *stream) {
+  return stream_active(stream) || !nghttp2_pq_empty(&stream->obq);
+}
 
-  DEBUGF(fprintf(stderr, "stream: stream=%d is rest\n", stream->stream_id));
+/*
+ * The queue, last scheduled cycle and next sequence number of the
+ * parent of |stream|.  The parent of a root stream is stream->roots.
+ */
+static nghttp2_pq *stream_parent_obq(nghttp2_stream *stream) {
+  return stream->dep_prev ? &stream->dep_prev->obq : &stream->roots->obq;
+}
 
-  if (stream->dpri == NGHTTP2_STREAM_DPRI_REST) {
-    return;
-  }
+static uint64_t stream_parent_last_cycle(nghttp2_stream *stream) {
+  return stream->dep_prev ? stream->dep_prev->descendant_last_cycle
+                          : stream->roots->descendant_last_cycle;
+}
 
-  if (stream->dpri == NGHTTP2_STREAM_DPRI_TOP) {
-    stream->dpri = NGHTTP2_STREAM_DPRI_REST;
+static uint64_t stream_parent_next_seq(nghttp2_stream *stream) {
+  return stream->dep_prev ? stream->dep_prev->descendant_next_seq++
+                          : stream->roots->descendant_next_seq++;
+}
 
-    stream_update_dep_set_rest(stream->sib_next);
+/*
+ * Computes the cycle of |stream| which is going to be queued after
+ * |last_cycle|.  The length of DATA frame sent last is charged in
+ * inverse proportion to the weight.  The remainder of the division is
+ * carried over to the next computation, so that small weights are
+ * not rounded in favour of the stream.
+ */
+static void stream_next_cycle(nghttp2_stream *stream, uint64_t last_cycle) {
+  uint64_t penalty;
 
-    return;
-  }
+  penalty = (uint64_t)stream->last_writelen * NGHTTP2_MAX_WEIGHT +
+            stream->pending_penalty;
 
-  stream_update_dep_set_rest(stream->sib_next);
-  stream_update_dep_set_rest(stream->dep_next);
+  stream->cycle = last_cycle + penalty / (uint32_t)stream->weight;
+  stream->pending_penalty = (uint32_t)(penalty % (uint32_t)stream->weight);
 }
 
 /*
- * Performs dfs starting |stream|, search stream which can become
- * NGHTTP2_STREAM_DPRI_TOP and set its dpri.  This function also
- * updates sum_norest_weight if stream->dpri ==
- * NGHTTP2_STREAM_DPRI_NO_ITEM.  This function returns nonzero if
- * stream's subtree contains at least one NGHTTP2_STRAEM_DPRI_TOP
- * stream.
+ * Schedules |stream| in the queue of its parent.  Ancestors are
+ * scheduled as well until the one already scheduled is found.
+ *
+ * This function returns 0 if it succeeds, or one of the following
+ * negative error codes:
+ *
+ * NGHTTP2_ERR_NOMEM
+ *     Out of memory.
  */
-static int stream_update_dep_set_top(nghttp2_stream *stream) {
-  nghttp2_stream *si;
+static int stream_obq_push(nghttp2_stream *stream) {
+  int rv;
 
-  if (!stream) {
-    return 0;
+  for (; stream && !stream->queued; stream = stream->dep_prev) {
+    DEBUGF(fprintf(stderr, "stream: stream=%d enqueue\n", stream->stream_id));
+
+    stream_next_cycle(stream, stream_parent_last_cycle(stream));
+    stream->seq = stream_parent_next_seq(stream);
+
+    rv = nghttp2_pq_push(stream_parent_obq(stream), &stream->pq_entry);
+    if (rv != 0) {
+      return rv;
+    }
+
+    stream->queued = 1;
   }
 
-  if (stream->dpri == NGHTTP2_STREAM_DPRI_TOP) {
-    return 1;
+  return 0;
+}
+
+/*
+ * Removes |stream| from the queue of its parent.  If the parent has
+ * nothing to send anymore, it is removed as well, and so on.
+ */
+static void stream_obq_remove(nghttp2_stream *stream) {
+  nghttp2_stream *dep_prev;
+
+  if (!stream->queued) {
+    return;
   }
 
-  stream->sum_norest_weight = 0;
+  for (;;) {
+    DEBUGF(fprintf(stderr, "stream: stream=%d dequeue\n", stream->stream_id));
 
-  if (stream->dpri == NGHTTP2_STREAM_DPRI_REST) {
-    DEBUGF(
-        fprintf(stderr, "stream: stream=%d item is top\n", stream->stream_id));
+    dep_prev = stream->dep_prev;
 
-    stream->dpri = NGHTTP2_STREAM_DPRI_TOP;
+    nghttp2_pq_remove(stream_parent_obq(stream), &stream->pq_entry);
 
-    return 1;
-  }
+    stream->queued = 0;
+    stream->cycle = 0;
+    stream->pending_penalty = 0;
+    stream->last_writelen = 0;
 
-  for (si = stream->dep_next; si; si = si->sib_next) {
-    if (stream_update_dep_set_top(si)) {
-      stream->sum_norest_weight += si->weight;
+    if (!dep_prev || stream_subtree_active(dep_prev)) {
+      return;
     }
-  }
 
-  return stream->sum_norest_weight > 0;
+    stream = dep_prev;
+  }
 }
 
 /*
- * Performs dfs starting |stream|, and dueue stream whose dpri is
- * NGHTTP2_STREAM_DPRI_TOP and has not been queued yet.
+ * Moves all streams queued in |src| into |dest|.  The streams are
+ * rescheduled after |last_cycle| in their original order, and take
+ * sequence numbers from |*pnext_seq|.
  *
  * This function returns 0 if it succeeds, or one of the following
  * negative error codes:
@@ -226,36 +250,21 @@ static int stream_update_dep_set_top(nghttp2_stream *stream) {
  * NGHTTP2_ERR_NOMEM
  *     Out of memory.
  */
-static int stream_update_dep_queue_top(nghttp2_stream *stream,
-                                       nghttp2_session *session) {
+static int stream_obq_move(nghttp2_pq *dest, uint64_t last_cycle,
+                           uint64_t *pnext_seq, nghttp2_pq *src) {
   int rv;
   nghttp2_stream *si;
 
-  if (stream->dpri == NGHTTP2_STREAM_DPRI_REST) {
-    return 0;
-  }
+  while (!nghttp2_pq_empty(src)) {
+    si = nghttp2_struct_of(nghttp2_pq_top(src), nghttp2_stream, pq_entry);
+    nghttp2_pq_pop(src);
 
-  if (stream->dpri == NGHTTP2_STREAM_DPRI_TOP) {
-    if (!stream->item->queued) {
-      DEBUGF(fprintf(stderr, "stream: stream=%d enqueue\n", stream->stream_id));
-      rv = stream_push_item(stream, session);
-
-      if (rv != 0) {
-        return rv;
-      }
-    }
-
-    return 0;
-  }
-
-  if (stream->sum_norest_weight == 0) {
-    return 0;
-  }
-
-  for (si = stream->dep_next; si; si = si->sib_next) {
-    rv = stream_update_dep_queue_top(si, session);
+    stream_next_cycle(si, last_cycle);
+    si->seq = (*pnext_seq)++;
 
+    rv = nghttp2_pq_push(dest, &si->pq_entry);
     if (rv != 0) {
+      si->queued = 0;
       return rv;
     }
   }
@@ -263,119 +272,94 @@ static int stream_update_dep_queue_top(nghttp2_stream *stream,
   return 0;
 }
 
-/*
- * Updates stream->sum_norest_weight recursively towards root.
- * |delta| must not be 0.  We have to gather effective sum of weight
- * of descendants.  |delta| is added to stream->sum_norest_weight.  If
- * stream->sum_norest_weight becomes 0, we have to update parent
- * stream, decreasing its sum_norest_weight by stream->weight.  If
- * stream->sum_norest_weight becomes from 0 to positive, then we have
- * to update parent stream, increasing its sum_norest_weight by
- * stream->weight.  Otherwise, we stop recursive call.
- */
-static void stream_update_dep_sum_norest_weight(nghttp2_stream *stream,
-                                                int32_t delta) {
-  int32_t old;
+nghttp2_outbound_item *
+nghttp2_stream_roots_next_outbound_item(nghttp2_stream_roots *roots) {
+  nghttp2_pq_entry *ent;
+  nghttp2_stream *stream, *si;
 
-  if (!stream) {
-    return;
+  ent = nghttp2_pq_top(&roots->obq);
+  if (!ent) {
+    return NULL;
   }
 
-  assert(delta != 0);
-  assert(stream->sum_norest_weight + delta >= 0);
+  for (;;) {
+    stream = nghttp2_struct_of(ent, nghttp2_stream, pq_entry);
 
-  old = stream->sum_norest_weight;
-  stream->sum_norest_weight += delta;
+    if (stream_active(stream)) {
+      /* Record the virtual time along the path, so that streams
+         scheduled from now on do not jump ahead of the streams which
+         have been waiting. */
+      for (si = stream; si->dep_prev; si = si->dep_prev) {
+        si->dep_prev->descendant_last_cycle = si->cycle;
+      }
+      roots->descendant_last_cycle = si->cycle;
 
-  if (old == 0) {
-    assert(delta > 0);
-    stream_update_dep_sum_norest_weight(stream->dep_prev, stream->weight);
-    return;
-  }
+      return stream->item;
+    }
 
-  assert(old > 0);
+    ent = nghttp2_pq_top(&stream->obq);
 
-  if (stream->sum_norest_weight == 0) {
-    stream_update_dep_sum_norest_weight(stream->dep_prev, -stream->weight);
+    assert(ent);
   }
 }
 
-/*
- * Returns stream whose dpri is NGHTTP2_STREAM_DPRI_NO_ITEM along the
- * path following stream->dep_prev (stream's ancestors, including
- * itself).  In other words, find stream which blocks the descendant
- * streams.  If there is no such stream, returns NULL.
- */
-static nghttp2_stream *stream_get_dep_blocking(nghttp2_stream *stream) {
-  for (; stream; stream = stream->dep_prev) {
-    if (stream->dpri != NGHTTP2_STREAM_DPRI_NO_ITEM) {
-      return stream;
-    }
+static int stream_count_active(nghttp2_pq_entry *ent, void *arg) {
+  nghttp2_stream *stream;
+
+  stream = nghttp2_struct_of(ent, nghttp2_stream, pq_entry);
+
+  if (stream_active(stream)) {
+    ++*(size_t *)arg;
   }
-  return NULL;
+
+  nghttp2_pq_each(&stream->obq, stream_count_active, arg);
+
+  return 0;
 }
 
-static int stream_update_dep_on_attach_item(nghttp2_stream *stream,
-                                            nghttp2_session *session) {
-  nghttp2_stream *blocking_stream;
-  int rv;
+size_t nghttp2_stream_roots_num_outbound_item(nghttp2_stream_roots *roots) {
+  size_t n = 0;
 
-  stream->dpri = NGHTTP2_STREAM_DPRI_REST;
+  nghttp2_pq_each(&roots->obq, stream_count_active, &n);
 
-  blocking_stream = stream_get_dep_blocking(stream->dep_prev);
+  return n;
+}
 
-  /* If we found REST or TOP in ascendants, we don't have to update
-     any metadata. */
-  if (blocking_stream) {
-    return 0;
-  }
+void nghttp2_stream_reschedule(nghttp2_stream *stream) {
+  nghttp2_stream *dep_prev;
+  nghttp2_pq *obq;
+  int rv _U_;
 
-  stream->dpri = NGHTTP2_STREAM_DPRI_TOP;
-  if (stream->sum_norest_weight == 0) {
-    stream_update_dep_sum_norest_weight(stream->dep_prev, stream->weight);
-  } else {
-    stream_update_dep_set_rest(stream->dep_next);
-  }
+  assert(stream->queued);
 
-  if (!stream->item->queued) {
-    DEBUGF(fprintf(stderr, "stream: stream=%d enqueue\n", stream->stream_id));
-    rv = stream_push_item(stream, session);
+  for (;;) {
+    obq = stream_parent_obq(stream);
 
-    if (rv != 0) {
-      return rv;
-    }
-  }
+    nghttp2_pq_remove(obq, &stream->pq_entry);
 
-  return 0;
-}
+    stream_next_cycle(stream, stream_parent_last_cycle(stream));
+    stream->seq = stream_parent_next_seq(stream);
 
-static int stream_update_dep_on_detach_item(nghttp2_stream *stream,
-                                            nghttp2_session *session) {
-  if (stream->dpri == NGHTTP2_STREAM_DPRI_REST) {
-    stream->dpri = NGHTTP2_STREAM_DPRI_NO_ITEM;
-    return 0;
-  }
+    /* This never fails since we have just removed an entry. */
+    rv = nghttp2_pq_push(obq, &stream->pq_entry);
+    assert(rv == 0);
 
-  if (stream->dpri == NGHTTP2_STREAM_DPRI_NO_ITEM) {
-    /* nghttp2_stream_defer_item() does not clear stream->item, but
-       set dpri = NGHTTP2_STREAM_DPRI_NO_ITEM.  Catch this case
-       here. */
-    return 0;
-  }
+    dep_prev = stream->dep_prev;
+    if (!dep_prev) {
+      return;
+    }
 
-  stream->dpri = NGHTTP2_STREAM_DPRI_NO_ITEM;
+    dep_prev->last_writelen = stream->last_writelen;
 
-  if (stream_update_dep_set_top(stream) == 0) {
-    stream_update_dep_sum_norest_weight(stream->dep_prev, -stream->weight);
-    return 0;
+    stream = dep_prev;
   }
-
-  return stream_update_dep_queue_top(stream, session);
 }
 
 int nghttp2_stream_attach_item(nghttp2_stream *stream,
                                nghttp2_outbound_item *item,
-                               nghttp2_session *session) {
+                               nghttp2_session *session _U_) {
+  int rv;
+
   assert((stream->flags & NGHTTP2_STREAM_FLAG_DEFERRED_ALL) == 0);
   assert(stream->item == NULL);
 
@@ -384,22 +368,33 @@ int nghttp2_stream_attach_item(nghttp2_stream *stream,
 
   stream->item = item;
 
-  return stream_update_dep_on_attach_item(stream, session);
+  rv = stream_obq_push(stream);
+  if (rv != 0) {
+    /* The caller frees item on error */
+    stream->item = NULL;
+    return rv;
+  }
+
+  return 0;
 }
 
 int nghttp2_stream_detach_item(nghttp2_stream *stream,
-                               nghttp2_session *session) {
+                               nghttp2_session *session _U_) {
   DEBUGF(fprintf(stderr, "stream: stream=%d detach item=%p\n",
                  stream->stream_id, stream->item));
 
   stream->item = NULL;
   stream->flags &= ~NGHTTP2_STREAM_FLAG_DEFERRED_ALL;
 
-  return stream_update_dep_on_detach_item(stream, session);
+  if (!stream_subtree_active(stream)) {
+    stream_obq_remove(stream);
+  }
+
+  return 0;
 }
 
 int nghttp2_stream_defer_item(nghttp2_stream *stream, uint8_t flags,
-                              nghttp2_session *session) {
+                              nghttp2_session *session _U_) {
   assert(stream->item);
 
   DEBUGF(fprintf(stderr, "stream: stream=%d defer item=%p cause=%02x\n",
@@ -407,11 +402,15 @@ int nghttp2_stream_defer_item(nghttp2_stream *stream, uint8_t flags,
 
   stream->flags |= flags;
 
-  return stream_update_dep_on_detach_item(stream, session);
+  if (!stream_subtree_active(stream)) {
+    stream_obq_remove(stream);
+  }
+
+  return 0;
 }
 
 int nghttp2_stream_resume_deferred_item(nghttp2_stream *stream, uint8_t flags,
-                                        nghttp2_session *session) {
+                                        nghttp2_session *session _U_) {
   assert(stream->item);
 
   DEBUGF(fprintf(stderr, "stream: stream=%d resume item=%p flags=%02x\n",
@@ -423,7 +422,7 @@ int nghttp2_stream_resume_deferred_item(nghttp2_stream *stream, uint8_t flags,
     return 0;
   }
 
-  return stream_update_dep_on_attach_item(stream, session);
+  return stream_obq_push(stream);
 }
 
 int nghttp2_stream_check_deferred_item(nghttp2_stream *stream) {
@@ -475,6 +474,13 @@ nghttp2_stream *nghttp2_stream_get_dep_root(nghttp2_stream *stream) {
   return stream;
 }
 
+nghttp2_stream *nghttp2_stream_get_dep_parent(nghttp2_stream *stream) {
+  /* Only the left most sibling has dep_prev */
+  for (; stream->sib_prev; stream = stream->sib_prev)
+    ;
+  return stream->dep_prev;
+}
+
 int nghttp2_stream_dep_subtree_find(nghttp2_stream *stream,
                                     nghttp2_stream *target) {
   if (stream == NULL) {
@@ -492,25 +498,12 @@ int nghttp2_stream_dep_subtree_find(nghttp2_stream *stream,
   return nghttp2_stream_dep_subtree_find(stream->dep_next, target);
 }
 
-int32_t nghttp2_stream_compute_effective_weight(nghttp2_stream *stream) {
-  int32_t weight;
-
-  if (!stream->dep_prev) {
-    return stream->weight;
-  }
-
-  weight = nghttp2_stream_compute_effective_weight(stream->dep_prev) *
-           stream->weight / stream->dep_prev->sum_norest_weight;
-
-  return nghttp2_max(1, weight);
-}
-
-void nghttp2_stream_dep_insert(nghttp2_stream *dep_stream,
-                               nghttp2_stream *stream) {
+int nghttp2_stream_dep_insert(nghttp2_stream *dep_stream,
+                              nghttp2_stream *stream) {
   nghttp2_stream *si;
-  nghttp2_stream *blocking_stream;
+  int rv;
 
-  assert(stream->dpri == NGHTTP2_STREAM_DPRI_NO_ITEM);
+  assert(stream->item == NULL);
 
   DEBUGF(fprintf(stderr,
                  "stream: dep_insert dep_stream(%p)=%d, stream(%p)=%d\n",
@@ -519,10 +512,6 @@ void nghttp2_stream_dep_insert(nghttp2_stream *dep_stream,
   stream->sum_dep_weight = dep_stream->sum_dep_weight;
   dep_stream->sum_dep_weight = stream->weight;
 
-  blocking_stream = stream_get_dep_blocking(dep_stream);
-
-  stream->sum_norest_weight = 0;
-
   if (dep_stream->dep_next) {
     assert(dep_stream->num_substreams >= 1);
     /* num_substreams includes node itself */
@@ -530,11 +519,6 @@ void nghttp2_stream_dep_insert(nghttp2_stream *dep_stream,
 
     for (si = dep_stream->dep_next; si; si = si->sib_next) {
       si->dep_prev = stream;
-      if (!blocking_stream && (si->dpri == NGHTTP2_STREAM_DPRI_TOP ||
-                               (si->dpri == NGHTTP2_STREAM_DPRI_NO_ITEM &&
-                                si->sum_norest_weight))) {
-        stream->sum_norest_weight += si->weight;
-      }
     }
 
     stream->dep_next = dep_stream->dep_next;
@@ -543,13 +527,22 @@ void nghttp2_stream_dep_insert(nghttp2_stream *dep_stream,
   dep_stream->dep_next = stream;
   stream->dep_prev = dep_stream;
 
-  if (stream->sum_norest_weight) {
-    dep_stream->sum_norest_weight = stream->weight;
-  }
-
   stream_update_dep_length(dep_stream, 1);
 
   ++stream->roots->num_streams;
+
+  /* All direct descendants of dep_stream now belong to stream */
+  rv = stream_obq_move(&stream->obq, stream->descendant_last_cycle,
+                       &stream->descendant_next_seq, &dep_stream->obq);
+  if (rv != 0) {
+    return rv;
+  }
+
+  if (!nghttp2_pq_empty(&stream->obq)) {
+    return stream_obq_push(stream);
+  }
+
+  return 0;
 }
 
 static void set_dep_prev(nghttp2_stream *stream, nghttp2_stream *dep) {
@@ -663,7 +656,7 @@ static void unlink_dep(nghttp2_stream *stream) {
 
 void nghttp2_stream_dep_add(nghttp2_stream *dep_stream,
                             nghttp2_stream *stream) {
-  assert(stream->dpri == NGHTTP2_STREAM_DPRI_NO_ITEM);
+  assert(stream->item == NULL);
 
   DEBUGF(fprintf(stderr, "stream: dep_add dep_stream(%p)=%d, stream(%p)=%d\n",
                  dep_stream, dep_stream->stream_id, stream, stream->stream_id));
@@ -681,38 +674,23 @@ void nghttp2_stream_dep_add(nghttp2_stream *dep_stream,
   ++stream->roots->num_streams;
 }
 
-void nghttp2_stream_dep_remove(nghttp2_stream *stream) {
-  nghttp2_stream *next, *dep_prev, *si, *blocking_stream;
-  int32_t sum_dep_weight_delta, sum_norest_weight_delta;
+int nghttp2_stream_dep_remove(nghttp2_stream *stream) {
+  nghttp2_stream *next, *dep_prev, *si;
+  int32_t sum_dep_weight_delta;
+  int rv;
 
-  assert(stream->dpri == NGHTTP2_STREAM_DPRI_NO_ITEM);
+  assert(!stream_active(stream));
 
   DEBUGF(fprintf(stderr, "stream: dep_remove stream(%p)=%d\n", stream,
                  stream->stream_id));
 
-  blocking_stream = stream_get_dep_blocking(stream->dep_prev);
-
   /* Distribute weight of |stream| to direct descendants */
   sum_dep_weight_delta = -stream->weight;
 
-  sum_norest_weight_delta = 0;
-
-  /* blocking_stream == NULL means that ascendants are all
-     NGHTTP2_STREAM_DPRI_NO_ITEM */
-  if (!blocking_stream && stream->sum_norest_weight) {
-    sum_norest_weight_delta -= stream->weight;
-  }
-
   for (si = stream->dep_next; si; si = si->sib_next) {
     si->weight = nghttp2_stream_dep_distributed_weight(stream, si->weight);
 
     sum_dep_weight_delta += si->weight;
-
-    if (!blocking_stream &&
-        (si->dpri == NGHTTP2_STREAM_DPRI_TOP ||
-         (si->dpri == NGHTTP2_STREAM_DPRI_NO_ITEM && si->sum_norest_weight))) {
-      sum_norest_weight_delta += si->weight;
-    }
   }
 
   dep_prev = stream->dep_prev;
@@ -721,7 +699,31 @@ void nghttp2_stream_dep_remove(nghttp2_stream *stream) {
     stream_update_dep_length(dep_prev, -1);
 
     dep_prev->sum_dep_weight += sum_dep_weight_delta;
-    dep_prev->sum_norest_weight += sum_norest_weight_delta;
+  }
+
+  /* Since stream has no item ready to send, it is queued only if it
+     has queued descendants.  They now belong to the parent of stream,
+     which keeps being queued. */
+  if (stream->queued) {
+    nghttp2_pq_remove(stream_parent_obq(stream), &stream->pq_entry);
+
+    stream->queued = 0;
+    stream->cycle = 0;
+    stream->pending_penalty = 0;
+    stream->last_writelen = 0;
+
+    if (dep_prev) {
+      rv = stream_obq_move(&dep_prev->obq, dep_prev->descendant_last_cycle,
+                           &dep_prev->descendant_next_seq, &stream->obq);
+    } else {
+      rv = stream_obq_move(&stream->roots->obq,
+                           stream->roots->descendant_last_cycle,
+                           &stream->roots->descendant_next_seq, &stream->obq);
+    }
+
+    if (rv != 0) {
+      return rv;
+    }
   }
 
   if (stream->sib_prev) {
@@ -749,7 +751,6 @@ void nghttp2_stream_dep_remove(nghttp2_stream *stream) {
 
   stream->num_substreams = 1;
   stream->sum_dep_weight = 0;
-  stream->sum_norest_weight = 0;
 
   stream->dep_prev = NULL;
   stream->dep_next = NULL;
@@ -757,16 +758,18 @@ void nghttp2_stream_dep_remove(nghttp2_stream *stream) {
   stream->sib_next = NULL;
 
   --stream->roots->num_streams;
+
+  return 0;
 }
 
 int nghttp2_stream_dep_insert_subtree(nghttp2_stream *dep_stream,
                                       nghttp2_stream *stream,
-                                      nghttp2_session *session) {
+                                      nghttp2_session *session _U_) {
   nghttp2_stream *last_sib;
   nghttp2_stream *dep_next;
-  nghttp2_stream *blocking_stream;
   nghttp2_stream *si;
   size_t delta_substreams;
+  int rv;
 
   DEBUGF(fprintf(stderr, "stream: dep_insert_subtree dep_stream(%p)=%d "
                          "stream(%p)=%d\n",
@@ -774,8 +777,6 @@ int nghttp2_stream_dep_insert_subtree(nghttp2_stream *dep_stream,
 
   delta_substreams = stream->num_substreams;
 
-  blocking_stream = stream_get_dep_blocking(dep_stream);
-
   if (dep_stream->dep_next) {
     /* dep_stream->num_substreams includes dep_stream itself */
     stream->num_substreams += dep_stream->num_substreams - 1;
@@ -785,10 +786,6 @@ int nghttp2_stream_dep_insert_subtree(nghttp2_stream *dep_stream,
 
     dep_next = dep_stream->dep_next;
 
-    if (!blocking_stream && dep_stream->sum_norest_weight) {
-      stream_update_dep_set_rest(dep_next);
-    }
-
     link_dep(dep_stream, stream);
 
     if (stream->dep_next) {
@@ -802,6 +799,12 @@ int nghttp2_stream_dep_insert_subtree(nghttp2_stream *dep_stream,
     for (si = dep_next; si; si = si->sib_next) {
       si->dep_prev = stream;
     }
+
+    rv = stream_obq_move(&stream->obq, stream->descendant_last_cycle,
+                         &stream->descendant_next_seq, &dep_stream->obq);
+    if (rv != 0) {
+      return rv;
+    }
   } else {
     link_dep(dep_stream, stream);
 
@@ -811,27 +814,16 @@ int nghttp2_stream_dep_insert_subtree(nghttp2_stream *dep_stream,
 
   stream_update_dep_length(dep_stream, delta_substreams);
 
-  if (blocking_stream) {
-    stream_update_dep_set_rest(stream);
-
-    return 0;
+  if (stream_subtree_active(stream)) {
+    return stream_obq_push(stream);
   }
 
-  if (stream_update_dep_set_top(stream) == 0) {
-    return 0;
-  }
-
-  dep_stream->sum_norest_weight = stream->weight;
-  stream_update_dep_sum_norest_weight(dep_stream->dep_prev, dep_stream->weight);
-
-  return stream_update_dep_queue_top(stream, session);
+  return 0;
 }
 
 int nghttp2_stream_dep_add_subtree(nghttp2_stream *dep_stream,
                                    nghttp2_stream *stream,
-                                   nghttp2_session *session) {
-  nghttp2_stream *blocking_stream;
-
+                                   nghttp2_session *session _U_) {
   DEBUGF(fprintf(stderr, "stream: dep_add_subtree dep_stream(%p)=%d "
                          "stream(%p)=%d\n",
                  dep_stream, dep_stream->stream_id, stream, stream->stream_id));
@@ -849,38 +841,22 @@ int nghttp2_stream_dep_add_subtree(nghttp2_stream *dep_stream,
 
   stream_update_dep_length(dep_stream, stream->num_substreams);
 
-  blocking_stream = stream_get_dep_blocking(dep_stream);
-
-  if (blocking_stream) {
-    /* We cannot make any assumption for stream if its dpri is not
-       NGHTTP2_DPRI_TOP.  Just dfs under stream here. */
-    stream_update_dep_set_rest(stream);
-
-    return 0;
-  }
-
-  if (stream->dpri == NGHTTP2_STREAM_DPRI_TOP) {
-    stream_update_dep_sum_norest_weight(dep_stream, stream->weight);
-    return 0;
-  }
-
-  if (stream_update_dep_set_top(stream) == 0) {
-    return 0;
+  if (stream_subtree_active(stream)) {
+    return stream_obq_push(stream);
   }
 
-  /* Newly added subtree contributes to dep_stream's
-     sum_norest_weight */
-  stream_update_dep_sum_norest_weight(dep_stream, stream->weight);
-
-  return stream_update_dep_queue_top(stream, session);
+  return 0;
 }
 
 void nghttp2_stream_dep_remove_subtree(nghttp2_stream *stream) {
-  nghttp2_stream *next, *dep_prev, *blocking_stream;
+  nghttp2_stream *next, *dep_prev;
 
   DEBUGF(fprintf(stderr, "stream: dep_remove_subtree stream(%p)=%d\n", stream,
                  stream->stream_id));
 
+  /* This must be done while stream is still linked to its parent */
+  stream_obq_remove(stream);
+
   if (stream->sib_prev) {
     link_sib(stream->sib_prev, stream->sib_next);
     dep_prev = stream->dep_prev;
@@ -903,14 +879,6 @@ void nghttp2_stream_dep_remove_subtree(nghttp2_stream *stream) {
     dep_prev->sum_dep_weight -= stream->weight;
 
     stream_update_dep_length(dep_prev, -stream->num_substreams);
-
-    blocking_stream = stream_get_dep_blocking(dep_prev);
-
-    if (!blocking_stream && (stream->dpri == NGHTTP2_STREAM_DPRI_TOP ||
-                             (stream->dpri == NGHTTP2_STREAM_DPRI_NO_ITEM &&
-                              stream->sum_norest_weight))) {
-      stream_update_dep_sum_norest_weight(dep_prev, -stream->weight);
-    }
   }
 
   stream->sib_prev = NULL;
@@ -919,32 +887,36 @@ void nghttp2_stream_dep_remove_subtree(nghttp2_stream *stream) {
 }
 
 int nghttp2_stream_dep_make_root(nghttp2_stream *stream,
-                                 nghttp2_session *session) {
+                                 nghttp2_session *session _U_) {
   DEBUGF(fprintf(stderr, "stream: dep_make_root stream(%p)=%d\n", stream,
                  stream->stream_id));
 
   nghttp2_stream_roots_add(stream->roots, stream);
 
-  if (stream_update_dep_set_top(stream) == 0) {
-    return 0;
+  if (stream_subtree_active(stream)) {
+    return stream_obq_push(stream);
   }
 
-  return stream_update_dep_queue_top(stream, session);
+  return 0;
 }
 
 int
 nghttp2_stream_dep_all_your_stream_are_belong_to_us(nghttp2_stream *stream,
                                                     nghttp2_session *session) {
   nghttp2_stream *first, *si;
+  nghttp2_stream_roots *roots;
+  int rv;
 
   DEBUGF(fprintf(stderr, "stream: ALL YOUR STREAM ARE BELONG TO US "
                          "stream(%p)=%d\n",
                  stream, stream->stream_id));
 
-  first = stream->roots->head;
+  roots = stream->roots;
+  first = roots->head;
 
   /* stream must not be include in stream->roots->head list */
   assert(first != stream);
+  assert(!stream->queued);
 
   if (first) {
     nghttp2_stream *prev;
@@ -957,13 +929,6 @@ nghttp2_stream_dep_all_your_stream_are_belong_to_us(nghttp2_stream *stream,
     stream->sum_dep_weight += first->weight;
     stream->num_substreams += first->num_substreams;
 
-    if (stream->dpri != NGHTTP2_STREAM_DPRI_NO_ITEM &&
-        (first->dpri == NGHTTP2_STREAM_DPRI_TOP ||
-         (first->dpri == NGHTTP2_STREAM_DPRI_NO_ITEM &&
-          first->sum_norest_weight))) {
-      stream_update_dep_set_rest(first);
-    }
-
     for (si = first->root_next; si; si = si->root_next) {
 
       assert(si != stream);
@@ -974,13 +939,6 @@ nghttp2_stream_dep_all_your_stream_are_belong_to_us(nghttp2_stream *stream,
       stream->sum_dep_weight += si->weight;
       stream->num_substreams += si->num_substreams;
 
-      if (stream->dpri != NGHTTP2_STREAM_DPRI_NO_ITEM &&
-          (si->dpri == NGHTTP2_STREAM_DPRI_TOP ||
-           (si->dpri == NGHTTP2_STREAM_DPRI_NO_ITEM &&
-            si->sum_norest_weight))) {
-        stream_update_dep_set_rest(si);
-      }
-
       link_sib(prev, si);
       si->dep_prev = stream;
 
@@ -1000,7 +958,13 @@ nghttp2_stream_dep_all_your_stream_are_belong_to_us(nghttp2_stream *stream,
     }
   }
 
-  nghttp2_stream_roots_remove_all(stream->roots);
+  nghttp2_stream_roots_remove_all(roots);
+
+  rv = stream_obq_move(&stream->obq, stream->descendant_last_cycle,
+                       &stream->descendant_next_seq, &roots->obq);
+  if (rv != 0) {
+    return rv;
+  }
 
   return nghttp2_stream_dep_make_root(stream, session);
 }
@@ -1011,12 +975,17 @@ int nghttp2_stream_in_dep_tree(nghttp2_stream *stream) {
          stream->roots->head == stream;
 }
 
-void nghttp2_stream_roots_init(nghttp2_stream_roots *roots) {
+void nghttp2_stream_roots_init(nghttp2_stream_roots *roots, nghttp2_mem *mem) {
   roots->head = NULL;
+  nghttp2_pq_init(&roots->obq, stream_less, mem);
+  roots->descendant_last_cycle = 0;
+  roots->descendant_next_seq = 0;
   roots->num_streams = 0;
 }
 
-void nghttp2_stream_roots_free(nghttp2_stream_roots *roots _U_) {}
+void nghttp2_stream_roots_free(nghttp2_stream_roots *roots) {
+  nghttp2_pq_free(&roots->obq);
+}
 
 void nghttp2_stream_roots_add(nghttp2_stream_roots *roots,
                               nghttp2_stream *stream) {
@@ -136,13 +136,6 @@ typedef enum {
   NGHTTP2_HTTP_FLAG_EXPECT_FINAL_RESPONSE = 1 << 13
 } nghttp2_http_flag;
 
-typedef enum {
-  NGHTTP2_STREAM_DPRI_NONE = 0,
-  NGHTTP2_STREAM_DPRI_NO_ITEM = 0x01,
-  NGHTTP2_STREAM_DPRI_TOP = 0x02,
-  NGHTTP2_STREAM_DPRI_REST = 0x04
-} nghttp2_stream_dpri;
-
 struct nghttp2_stream_roots;
 
 typedef struct nghttp2_stream_roots nghttp2_stream_roots;
@@ -154,6 +147,13 @@ typedef struct nghttp2_stream nghttp2_stream;
 struct nghttp2_stream {
   /* Intrusive Map */
   nghttp2_map_entry map_entry;
+  /* Entry for the queue of dep_prev, or roots->obq if this stream is
+     a root of dependency tree. */
+  nghttp2_pq_entry pq_entry;
+  /* Priority queue of direct descendants (nghttp2_stream) which are
+     ready to send, that is, which have an item to send, or which have
+     such a descendant.  The streams are ordered by their cycle. */
+  nghttp2_pq obq;
   /* Content-Length of request/response body.  -1 if unknown. */
   int64_t content_length;
   /* Received body so far */
@@ -182,13 +182,28 @@ struct nghttp2_stream {
   void *stream_user_data;
   /* Item to send */
   nghttp2_outbound_item *item;
-  /* stream ID */
-  int32_t stream_id;
-  /* categorized priority of this stream.  Only stream bearing
-     NGHTTP2_STREAM_DPRI_TOP can send item. */
-  nghttp2_stream_dpri dpri;
+  /* WINDOW_UPDATE for this stream queued automatically, which is not
+     sent yet.  Further increments are merged into it. */
+  nghttp2_outbound_item *window_update_item;
+  /* The virtual finish time of this stream in the queue it is
+     scheduled.  A stream which has the smallest value is scheduled
+     first.  Each time a DATA frame is sent, this value is advanced by
+     the frame length in inverse proportion to the weight. */
+  uint64_t cycle;
+  /* The cycle of the descendant which was scheduled last.  The newly
+     scheduled descendant starts with this value. */
+  uint64_t descendant_last_cycle;
+  /* The sequence number given when this stream is scheduled.  This is
+     used to break tie among the streams of the same cycle. */
+  uint64_t seq;
+  /* The sequence number given to the next descendant scheduled. */
+  uint64_t descendant_next_seq;
   /* the number of streams in subtree */
   size_t num_substreams;
+  /* The length of DATA frame sent last in this subtree */
+  size_t last_writelen;
+  /* stream ID */
+  int32_t stream_id;
   /* Current remote window size. This value is computed against the
      current initial window size of remote endpoint. */
   int32_t remote_window_size;
@@ -211,13 +226,9 @@ struct nghttp2_stream {
   int32_t weight;
   /* sum of weight of direct descendants */
   int32_t sum_dep_weight;
-  /* sum of weight of direct descendants which have at least one
-     descendant with dpri == NGHTTP2_STREAM_DPRI_TOP.  We use this
-     value to calculate effective weight.  This value is only
-     meaningful iff dpri == NGHTTP2_STREAM_DPRI_NO_ITEM and all
-     streams along the path to the root stream (follow dep_prev) have
-     NGHTTP2_STREAM_DPRI_NO_ITEM. */
-  int32_t sum_norest_weight;
+  /* The remainder of the penalty which is not reflected to cycle
+     yet, due to the division by weight */
+  uint32_t pending_penalty;
   nghttp2_stream_state state;
   /* status code from remote server */
   int16_t status_code;
@@ -227,6 +238,29 @@ struct nghttp2_stream {
   uint8_t flags;
   /* Bitwise OR of zero or more nghttp2_shut_flag values */
   uint8_t shut_flags;
+  /* Nonzero if this stream is in the queue of dep_prev (or
+     roots->obq) */
+  uint8_t queued;
+};
+
+typedef struct nghttp2_stream_tombstone nghttp2_stream_tombstone;
+
+/*
+ * The compact record of a closed stream which had no descendant in
+ * the dependency tree.  Server keeps this instead of nghttp2_stream,
+ * so that a stream which depends on the closed stream later still
+ * gets the priority it would have got.
+ */
+struct nghttp2_stream_tombstone {
+  /* Intrusive Map.  The key is stream ID. */
+  nghttp2_map_entry map_entry;
+  /* The doubly linked list of tombstones, oldest first */
+  nghttp2_stream_tombstone *prev, *next;
+  /* The stream ID the stream depended on.  0 if it was a root of
+     dependency tree. */
+  int32_t dep_stream_id;
+  /* weight of the stream */
+  int32_t weight;
 };
 
 void nghttp2_stream_init(nghttp2_stream *stream, int32_t stream_id,
@@ -234,7 +268,7 @@ void nghttp2_stream_init(nghttp2_stream *stream, int32_t stream_id,
                          int32_t weight, nghttp2_stream_roots *roots,
                          int32_t remote_initial_window_size,
                          int32_t local_initial_window_size,
-                         void *stream_user_data);
+                         void *stream_user_data, nghttp2_mem *mem);
 
 void nghttp2_stream_free(nghttp2_stream *stream);
 
@@ -318,6 +352,12 @@ void nghttp2_stream_promise_fulfilled(nghttp2_stream *stream);
  */
 nghttp2_stream *nghttp2_stream_get_dep_root(nghttp2_stream *stream);
 
+/*
+ * Returns the stream |stream| directly depends on.  This function
+ * returns NULL if |stream| is a root of the dependency tree.
+ */
+nghttp2_stream *nghttp2_stream_get_dep_parent(nghttp2_stream *stream);
+
 /*
  * Returns nonzero if |target| is found in subtree of |stream|.
  */
@@ -331,34 +371,42 @@ int nghttp2_stream_dep_subtree_find(nghttp2_stream *stream,
 int32_t nghttp2_stream_dep_distributed_weight(nghttp2_stream *stream,
                                               int32_t weight);
 
-int32_t nghttp2_stream_compute_effective_weight(nghttp2_stream *stream);
-
 /*
  * Makes the |stream| depend on the |dep_stream|.  This dependency is
  * exclusive.  All existing direct descendants of |dep_stream| become
  * the descendants of the |stream|.  This function assumes
- * |stream->data| is NULL and no dpri members are changed in this
- * dependency tree.
+ * |stream->item| is NULL.
+ *
+ * This function returns 0 if it succeeds, or one of the following
+ * negative error codes:
+ *
+ * NGHTTP2_ERR_NOMEM
+ *     Out of memory
  */
-void nghttp2_stream_dep_insert(nghttp2_stream *dep_stream,
-                               nghttp2_stream *stream);
+int nghttp2_stream_dep_insert(nghttp2_stream *dep_stream,
+                              nghttp2_stream *stream);
 
 /*
  * Makes the |stream| depend on the |dep_stream|.  This dependency is
- * not exclusive.  This function assumes |stream->data| is NULL and no
- * dpri members are changed in this dependency tree.
+ * not exclusive.  This function assumes |stream->item| is NULL.
  */
 void nghttp2_stream_dep_add(nghttp2_stream *dep_stream, nghttp2_stream *stream);
 
 /*
  * Removes the |stream| from the current dependency tree.  This
- * function assumes |stream->data| is NULL.
+ * function assumes that |stream| has no item ready to send.
+ *
+ * This function returns 0 if it succeeds, or one of the following
+ * negative error codes:
+ *
+ * NGHTTP2_ERR_NOMEM
+ *     Out of memory
  */
-void nghttp2_stream_dep_remove(nghttp2_stream *stream);
+int nghttp2_stream_dep_remove(nghttp2_stream *stream);
 
 /*
- * Attaches |item| to |stream|.  Updates dpri members in this
- * dependency tree.
+ * Attaches |item| to |stream|, and schedules |stream| and its
+ * ancestors.
  *
  * This function returns 0 if it succeeds, or one of the following
  * negative error codes:
@@ -371,9 +419,9 @@ int nghttp2_stream_attach_item(nghttp2_stream *stream,
                                nghttp2_session *session);
 
 /*
- * Detaches |stream->item|.  Updates dpri members in this dependency
- * tree.  This function does not free |stream->item|.  The caller must
- * free it.
+ * Detaches |stream->item|.  If |stream| has nothing to send in its
+ * subtree, it is unscheduled.  This function does not free
+ * |stream->item|.  The caller must free it.
  *
  * This function returns 0 if it succeeds, or one of the following
  * negative error codes:
@@ -386,7 +434,7 @@ int nghttp2_stream_detach_item(nghttp2_stream *stream,
 
 /*
  * Makes the |stream| depend on the |dep_stream|.  This dependency is
- * exclusive.  Updates dpri members in this dependency tree.
+ * exclusive.  Updates the queues in this dependency tree.
  *
  * This function returns 0 if it succeeds, or one of the following
  * negative error codes:
@@ -400,7 +448,7 @@ int nghttp2_stream_dep_insert_subtree(nghttp2_stream *dep_stream,
 
 /*
  * Makes the |stream| depend on the |dep_stream|.  This dependency is
- * not exclusive.  Updates dpri members in this dependency tree.
+ * not exclusive.  Updates the queues in this dependency tree.
  *
  * This function returns 0 if it succeeds, or one of the following
  * negative error codes:
@@ -413,21 +461,15 @@ int nghttp2_stream_dep_add_subtree(nghttp2_stream *dep_stream,
                                    nghttp2_session *session);
 
 /*
- * Removes subtree whose root stream is |stream|.  Removing subtree
- * does not change dpri values.  The effective_weight of streams in
- * removed subtree is not updated.
- *
- * This function returns 0 if it succeeds, or one of the following
- * negative error codes:
- *
- * NGHTTP2_ERR_NOMEM
- *     Out of memory
+ * Removes subtree whose root stream is |stream|.  The |stream| is
+ * unscheduled, but the queues inside the removed subtree are kept
+ * intact.
  */
 void nghttp2_stream_dep_remove_subtree(nghttp2_stream *stream);
 
 /*
- * Makes the |stream| as root.  Updates dpri members in this
- * dependency tree.
+ * Makes the |stream| as root.  Updates the queues in this dependency
+ * tree.
  *
  * This function returns 0 if it succeeds, or one of the following
  * negative error codes:
@@ -457,13 +499,43 @@ nghttp2_stream_dep_all_your_stream_are_belong_to_us(nghttp2_stream *stream,
  */
 int nghttp2_stream_in_dep_tree(nghttp2_stream *stream);
 
+/*
+ * Returns the outbound item which should be sent next, following the
+ * priority of the streams in |roots|.  This function does not remove
+ * the item from the stream.  Returns NULL if there is no item ready
+ * to send.
+ */
+nghttp2_outbound_item *
+nghttp2_stream_roots_next_outbound_item(nghttp2_stream_roots *roots);
+
+/*
+ * Returns the number of outbound items in |roots| which are ready to
+ * send.  Deferred items are not counted.  This function visits all
+ * scheduled streams.
+ */
+size_t nghttp2_stream_roots_num_outbound_item(nghttp2_stream_roots *roots);
+
+/*
+ * Updates the cycle of |stream| and all its ancestors after DATA
+ * frame of length |stream->last_writelen| has been sent, so that the
+ * bandwidth is shared among siblings in proportion to their weight.
+ * The |stream| must be scheduled.
+ */
+void nghttp2_stream_reschedule(nghttp2_stream *stream);
+
 struct nghttp2_stream_roots {
   nghttp2_stream *head;
+  /* Priority queue of root streams which are ready to send */
+  nghttp2_pq obq;
+  /* The cycle of the root stream which was scheduled last */
+  uint64_t descendant_last_cycle;
+  /* The sequence number given to the next root stream scheduled */
+  uint64_t descendant_next_seq;
 
   int32_t num_streams;
 };
 
-void nghttp2_stream_roots_init(nghttp2_stream_roots *roots);
+void nghttp2_stream_roots_init(nghttp2_stream_roots *roots, nghttp2_mem *mem);
 
 void nghttp2_stream_roots_free(nghttp2_stream_roots *roots);
 
@@ -0,0 +1,320 @@
+/*
+ * nghttp2 - HTTP/2 C Library
+ *
+ * Copyright (c) 2015 Tatsuhiro Tsujikawa
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "nghttp2_submission_queue.h"
+
+#include <string.h>
+
+#include "nghttp2_frame.h"
+
+#if defined(__GNUC__)
+#define NGHTTP2_HAVE_ATOMIC 1
+
+#define nghttp2_atomic_load_ptr(P) __atomic_load_n((P), __ATOMIC_ACQUIRE)
+#define nghttp2_atomic_store_ptr(P, V)                                         \
+  __atomic_store_n((P), (V), __ATOMIC_RELEASE)
+#define nghttp2_atomic_exchange_ptr(P, V)                                      \
+  __atomic_exchange_n((P), (V), __ATOMIC_SEQ_CST)
+#define nghttp2_atomic_exchange_int(P, V)                                      \
+  __atomic_exchange_n((P), (V), __ATOMIC_SEQ_CST)
+
+#elif defined(_MSC_VER)
+#define NGHTTP2_HAVE_ATOMIC 1
+
+#include <windows.h>
+
+/* Interlocked functions are full barriers */
+#define nghttp2_atomic_load_ptr(P)                                             \
+  InterlockedCompareExchangePointer((P), NULL, NULL)
+#define nghttp2_atomic_store_ptr(P, V)                                         \
+  ((void)InterlockedExchangePointer((P), (V)))
+#define nghttp2_atomic_exchange_ptr(P, V)                                      \
+  InterlockedExchangePointer((P), (V))
+#define nghttp2_atomic_exchange_int(P, V)                                      \
+  ((int)InterlockedExchange((volatile LONG *)(P), (LONG)(V)))
+
+#endif /* _MSC_VER */
+
+#ifdef NGHTTP2_HAVE_ATOMIC
+
+int nghttp2_submission_queue_new(
+    nghttp2_submission_queue **q_ptr,
+    nghttp2_submission_queue_wakeup_callback wakeup_cb, void *user_data,
+    nghttp2_mem *mem) {
+  nghttp2_submission_queue *q;
+
+  if (mem == NULL) {
+    mem = nghttp2_mem_default();
+  }
+
+  q = nghttp2_mem_calloc(mem, 1, sizeof(nghttp2_submission_queue));
+  if (q == NULL) {
+    return NGHTTP2_ERR_NOMEM;
+  }
+
+  q->head = &q->stub;
+  q->tail = &q->stub;
+  q->mem = *mem;
+  q->wakeup_cb = wakeup_cb;
+  q->user_data = user_data;
+
+  *q_ptr = q;
+
+  return 0;
+}
+
+#else /* !NGHTTP2_HAVE_ATOMIC */
+
+int nghttp2_submission_queue_new(
+    nghttp2_submission_queue **q_ptr _U_,
+    nghttp2_submission_queue_wakeup_callback wakeup_cb _U_,
+    void *user_data _U_, nghttp2_mem *mem _U_) {
+  return NGHTTP2_ERR_INVALID_STATE;
+}
+
+#endif /* !NGHTTP2_HAVE_ATOMIC */
+
+void nghttp2_submission_queue_del(nghttp2_submission_queue *q) {
+  nghttp2_submission *sub;
+
+  if (q == NULL) {
+    return;
+  }
+
+  while ((sub = nghttp2_submission_queue_pop(q)) != NULL) {
+    nghttp2_submission_del(q, sub);
+  }
+
+  nghttp2_mem_free(&q->mem, q);
+}
+
+void nghttp2_submission_del(nghttp2_submission_queue *q,
+                            nghttp2_submission *sub) {
+  nghttp2_nv_array_del(sub->nva, &q->mem);
+  nghttp2_mem_free(&q->mem, sub);
+}
+
+#ifdef NGHTTP2_HAVE_ATOMIC
+
+static void submission_queue_push(nghttp2_submission_queue *q,
+                                  nghttp2_submission *sub) {
+  nghttp2_submission *prev;
+
+  sub->next = NULL;
+
+  prev = nghttp2_atomic_exchange_ptr(&q->tail, sub);
+  /* Until this store, the consumer sees the queue ending at prev */
+  nghttp2_atomic_store_ptr(&prev->next, sub);
+}
+
+nghttp2_submission *nghttp2_submission_queue_pop(nghttp2_submission_queue *q) {
+  nghttp2_submission *head, *next;
+
+  head = q->head;
+  next = nghttp2_atomic_load_ptr(&head->next);
+
+  if (head == &q->stub) {
+    if (next == NULL) {
+      return NULL;
+    }
+    q->head = next;
+    head = next;
+    next = nghttp2_atomic_load_ptr(&head->next);
+  }
+
+  if (next) {
+    q->head = next;
+    return head;
+  }
+
+  if (head != nghttp2_atomic_load_ptr(&q->tail)) {
+    /* A producer has not linked the newest node yet */
+    return NULL;
+  }
+
+  /* head is the last node.  Put stub back behind it, so that we can
+     remove head without touching tail. */
+  submission_queue_push(q, &q->stub);
+
+  next = nghttp2_atomic_load_ptr(&head->next);
+  if (next) {
+    q->head = next;
+    return head;
+  }
+
+  return NULL;
+}
+
+int nghttp2_submission_queue_empty(nghttp2_submission_queue *q) {
+  return q->head == &q->stub &&
+         nghttp2_atomic_load_ptr(&q->tail) == &q->stub;
+}
+
+void nghttp2_submission_queue_clear_wakeup(nghttp2_submission_queue *q) {
+  nghttp2_atomic_exchange_int(&q->wakeup_pending, 0);
+}
+
+/*
+ * Pushes |sub| to |q|, and calls wakeup callback unless the previous
+ * wakeup is still pending.  The exchange of |wakeup_pending| is
+ * ordered after the push, so if the consumer cleared it before
+ * draining, either the drain sees |sub| or we call wakeup callback.
+ */
+static int submission_queue_add(nghttp2_submission_queue *q,
+                                nghttp2_submission *sub) {
+  submission_queue_push(q, sub);
+
+  if (nghttp2_atomic_exchange_int(&q->wakeup_pending, 1) == 0 &&
+      q->wakeup_cb) {
+    q->wakeup_cb(q, q->user_data);
+  }
+
+  return 0;
+}
+
+#else /* !NGHTTP2_HAVE_ATOMIC */
+
+/* nghttp2_submission_queue_new() always fails, so the functions
+   below are never called with valid queue. */
+
+nghttp2_submission *
+nghttp2_submission_queue_pop(nghttp2_submission_queue *q _U_) {
+  return NULL;
+}
+
+int nghttp2_submission_queue_empty(nghttp2_submission_queue *q _U_) {
+  return 1;
+}
+
+void nghttp2_submission_queue_clear_wakeup(nghttp2_submission_queue *q _U_) {}
+
+static int submission_queue_add(nghttp2_submission_queue *q,
+                                nghttp2_submission *sub) {
+  nghttp2_submission_del(q, sub);
+
+  return NGHTTP2_ERR_INVALID_STATE;
+}
+
+#endif /* !NGHTTP2_HAVE_ATOMIC */
+
+static nghttp2_submission *submission_new(nghttp2_submission_queue *q,
+                                          uint8_t type, int32_t stream_id) {
+  nghttp2_submission *sub;
+
+  sub = nghttp2_mem_calloc(&q->mem, 1, sizeof(nghttp2_submission));
+  if (sub == NULL) {
+    return NULL;
+  }
+
+  sub->type = type;
+  sub->stream_id = stream_id;
+
+  return sub;
+}
+
+static int submission_queue_add_headers(nghttp2_submission_queue *q,
+                                        uint8_t type, uint8_t flags,
+                                        int32_t stream_id,
+                                        const nghttp2_nv *nva, size_t nvlen,
+                                        const nghttp2_data_provider *data_prd) {
+  int rv;
+  nghttp2_submission *sub;
+
+  if (stream_id <= 0) {
+    return NGHTTP2_ERR_INVALID_ARGUMENT;
+  }
+
+  sub = submission_new(q, type, stream_id);
+  if (sub == NULL) {
+    return NGHTTP2_ERR_NOMEM;
+  }
+
+  rv = nghttp2_nv_array_copy(&sub->nva, nva, nvlen, &q->mem);
+  if (rv != 0) {
+    nghttp2_mem_free(&q->mem, sub);
+    return rv;
+  }
+
+  sub->nvlen = nvlen;
+  sub->flags = flags;
+
+  if (data_prd) {
+    sub->data_prd = *data_prd;
+    sub->has_data_prd = 1;
+  }
+
+  return submission_queue_add(q, sub);
+}
+
+int nghttp2_submission_queue_submit_headers(nghttp2_submission_queue *q,
+                                            uint8_t flags, int32_t stream_id,
+                                            const nghttp2_nv *nva,
+                                            size_t nvlen) {
+  return submission_queue_add_headers(q, NGHTTP2_SUBMISSION_HEADERS,
+                                      flags & NGHTTP2_FLAG_END_STREAM,
+                                      stream_id, nva, nvlen, NULL);
+}
+
+int nghttp2_submission_queue_submit_response(
+    nghttp2_submission_queue *q, int32_t stream_id, const nghttp2_nv *nva,
+    size_t nvlen, const nghttp2_data_provider *data_prd) {
+  return submission_queue_add_headers(q, NGHTTP2_SUBMISSION_RESPONSE,
+                                      NGHTTP2_FLAG_NONE, stream_id, nva, nvlen,
+                                      data_prd);
+}
+
+int nghttp2_submission_queue_resume_data(nghttp2_submission_queue *q,
+                                         int32_t stream_id) {
+  nghttp2_submission *sub;
+
+  if (stream_id <= 0) {
+    return NGHTTP2_ERR_INVALID_ARGUMENT;
+  }
+
+  sub = submission_new(q, NGHTTP2_SUBMISSION_RESUME_DATA, stream_id);
+  if (sub == NULL) {
+    return NGHTTP2_ERR_NOMEM;
+  }
+
+  return submission_queue_add(q, sub);
+}
+
+int nghttp2_submission_queue_submit_rst_stream(nghttp2_submission_queue *q,
+                                               int32_t stream_id,
+                                               uint32_t error_code) {
+  nghttp2_submission *sub;
+
+  if (stream_id <= 0) {
+    return NGHTTP2_ERR_INVALID_ARGUMENT;
+  }
+
+  sub = submission_new(q, NGHTTP2_SUBMISSION_RST_STREAM, stream_id);
+  if (sub == NULL) {
+    return NGHTTP2_ERR_NOMEM;
+  }
+
+  sub->error_code = error_code;
+
+  return submission_queue_add(q, sub);
+}
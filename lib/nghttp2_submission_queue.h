@@ -0,0 +1,116 @@
+/*
+ * nghttp2 - HTTP/2 C Library
+ *
+ * Copyright (c) 2015 Tatsuhiro Tsujikawa
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef NGHTTP2_SUBMISSION_QUEUE_H
+#define NGHTTP2_SUBMISSION_QUEUE_H
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif /* HAVE_CONFIG_H */
+
+#include <nghttp2/nghttp2.h>
+
+#include "nghttp2_mem.h"
+
+typedef enum {
+  /* nghttp2_submit_headers() */
+  NGHTTP2_SUBMISSION_HEADERS,
+  /* nghttp2_submit_response() */
+  NGHTTP2_SUBMISSION_RESPONSE,
+  /* nghttp2_session_resume_data() */
+  NGHTTP2_SUBMISSION_RESUME_DATA,
+  /* nghttp2_submit_rst_stream() */
+  NGHTTP2_SUBMISSION_RST_STREAM
+} nghttp2_submission_type;
+
+typedef struct nghttp2_submission nghttp2_submission;
+
+/* A request made by a producer thread, which the owning thread of
+   the session replays with the corresponding API function. */
+struct nghttp2_submission {
+  /* The next submission in the queue.  This is accessed
+     atomically. */
+  nghttp2_submission *next;
+  /* The header fields, copied by the producer thread */
+  nghttp2_nv *nva;
+  size_t nvlen;
+  nghttp2_data_provider data_prd;
+  int32_t stream_id;
+  uint32_t error_code;
+  /* nghttp2_submission_type */
+  uint8_t type;
+  /* The flags for nghttp2_submit_headers() */
+  uint8_t flags;
+  /* Nonzero if |data_prd| is given */
+  uint8_t has_data_prd;
+};
+
+/*
+ * Intrusive multi-producer single-consumer queue.  Producers only
+ * touch |tail| and the |next| of the node they link to, so that
+ * pushing is a single atomic exchange followed by a store.  |stub|
+ * keeps the queue non-empty from the consumer's point of view.
+ */
+struct nghttp2_submission_queue {
+  nghttp2_submission stub;
+  /* The oldest node.  This is only accessed by the consumer. */
+  nghttp2_submission *head;
+  /* The newest node.  This is accessed atomically. */
+  nghttp2_submission *tail;
+  nghttp2_mem mem;
+  nghttp2_submission_queue_wakeup_callback wakeup_cb;
+  void *user_data;
+  /* Nonzero if wakeup_cb has been called and the consumer has not
+     started to drain the queue since then.  This is accessed
+     atomically. */
+  int wakeup_pending;
+};
+
+/*
+ * Tells |q| that the consumer is about to drain the queue.  After
+ * this call, the next push calls wakeup callback again.
+ */
+void nghttp2_submission_queue_clear_wakeup(nghttp2_submission_queue *q);
+
+/*
+ * Removes the oldest submission from |q| and returns it.  This
+ * function returns NULL if |q| is empty, or the newest submission is
+ * being linked by a producer.  In the latter case, the producer calls
+ * wakeup callback after it finishes.
+ */
+nghttp2_submission *nghttp2_submission_queue_pop(nghttp2_submission_queue *q);
+
+/*
+ * Returns nonzero if |q| has no submission.  This function must be
+ * called by the consumer.
+ */
+int nghttp2_submission_queue_empty(nghttp2_submission_queue *q);
+
+/*
+ * Frees |sub| which was removed from |q|.
+ */
+void nghttp2_submission_del(nghttp2_submission_queue *q,
+                            nghttp2_submission *sub);
+
+#endif /* NGHTTP2_SUBMISSION_QUEUE_H */
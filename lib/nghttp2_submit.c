@@ -40,8 +40,7 @@ static int32_t submit_headers_shared(nghttp2_session *session, uint8_t flags,
                                      const nghttp2_priority_spec *pri_spec,
                                      nghttp2_nv *nva_copy, size_t nvlen,
                                      const nghttp2_data_provider *data_prd,
-                                     void *stream_user_data,
-                                     uint8_t attach_stream) {
+                                     void *stream_user_data) {
   int rv;
   uint8_t flags_copy;
   nghttp2_outbound_item *item = NULL;
@@ -56,7 +55,7 @@ static int32_t submit_headers_shared(nghttp2_session *session, uint8_t flags,
     goto fail;
   }
 
-  item = nghttp2_mem_malloc(mem, sizeof(nghttp2_outbound_item));
+  item = nghttp2_mempool_alloc(&session->item_pool);
   if (item == NULL) {
     rv = NGHTTP2_ERR_NOMEM;
     goto fail;
@@ -69,7 +68,6 @@ static int32_t submit_headers_shared(nghttp2_session *session, uint8_t flags,
   }
 
   item->aux_data.headers.stream_user_data = stream_user_data;
-  item->aux_data.headers.attach_stream = attach_stream;
 
   flags_copy = (flags & (NGHTTP2_FLAG_END_STREAM | NGHTTP2_FLAG_PRIORITY)) |
                NGHTTP2_FLAG_END_HEADERS;
@@ -111,7 +109,7 @@ fail:
   /* nghttp2_frame_headers_init() takes ownership of nva_copy. */
   nghttp2_nv_array_del(nva_copy, mem);
 fail2:
-  nghttp2_mem_free(mem, item);
+  nghttp2_mempool_release(&session->item_pool, item);
 
   return rv;
 }
@@ -129,8 +127,7 @@ static int32_t submit_headers_shared_nva(nghttp2_session *session,
                                          const nghttp2_priority_spec *pri_spec,
                                          const nghttp2_nv *nva, size_t nvlen,
                                          const nghttp2_data_provider *data_prd,
-                                         void *stream_user_data,
-                                         uint8_t attach_stream) {
+                                         void *stream_user_data) {
   int rv;
   nghttp2_nv *nva_copy;
   nghttp2_priority_spec copy_pri_spec;
@@ -151,14 +148,13 @@ static int32_t submit_headers_shared_nva(nghttp2_session *session,
   }
 
   return submit_headers_shared(session, flags, stream_id, &copy_pri_spec,
-                               nva_copy, nvlen, data_prd, stream_user_data,
-                               attach_stream);
+                               nva_copy, nvlen, data_prd, stream_user_data);
 }
 
 int32_t nghttp2_submit_trailer(nghttp2_session *session, int32_t stream_id,
                                const nghttp2_nv *nva, size_t nvlen) {
   return submit_headers_shared_nva(session, NGHTTP2_FLAG_END_STREAM, stream_id,
-                                   NULL, nva, nvlen, NULL, NULL, 0);
+                                   NULL, nva, nvlen, NULL, NULL);
 }
 
 int32_t nghttp2_submit_headers(nghttp2_session *session, uint8_t flags,
@@ -175,7 +171,7 @@ int32_t nghttp2_submit_headers(nghttp2_session *session, uint8_t flags,
   }
 
   return submit_headers_shared_nva(session, flags, stream_id, pri_spec, nva,
-                                   nvlen, NULL, stream_user_data, 0);
+                                   nvlen, NULL, stream_user_data);
 }
 
 int nghttp2_submit_ping(nghttp2_session *session, uint8_t flags _U_,
@@ -190,9 +186,6 @@ int nghttp2_submit_priority(nghttp2_session *session, uint8_t flags _U_,
   nghttp2_outbound_item *item;
   nghttp2_frame *frame;
   nghttp2_priority_spec copy_pri_spec;
-  nghttp2_mem *mem;
-
-  mem = &session->mem;
 
   if (stream_id == 0 || pri_spec == NULL) {
     return NGHTTP2_ERR_INVALID_ARGUMENT;
@@ -206,7 +199,7 @@ int nghttp2_submit_priority(nghttp2_session *session, uint8_t flags _U_,
 
   adjust_priority_spec_weight(&copy_pri_spec);
 
-  item = nghttp2_mem_malloc(mem, sizeof(nghttp2_outbound_item));
+  item = nghttp2_mempool_alloc(&session->item_pool);
 
   if (item == NULL) {
     return NGHTTP2_ERR_NOMEM;
@@ -222,7 +215,7 @@ int nghttp2_submit_priority(nghttp2_session *session, uint8_t flags _U_,
 
   if (rv != 0) {
     nghttp2_frame_priority_free(&frame->priority);
-    nghttp2_mem_free(mem, item);
+    nghttp2_mempool_release(&session->item_pool, item);
 
     return rv;
   }
@@ -294,7 +287,7 @@ int32_t nghttp2_submit_push_promise(nghttp2_session *session, uint8_t flags _U_,
     return NGHTTP2_ERR_STREAM_ID_NOT_AVAILABLE;
   }
 
-  item = nghttp2_mem_malloc(mem, sizeof(nghttp2_outbound_item));
+  item = nghttp2_mempool_alloc(&session->item_pool);
   if (item == NULL) {
     return NGHTTP2_ERR_NOMEM;
   }
@@ -307,7 +300,7 @@ int32_t nghttp2_submit_push_promise(nghttp2_session *session, uint8_t flags _U_,
 
   rv = nghttp2_nv_array_copy(&nva_copy, nva, nvlen, mem);
   if (rv < 0) {
-    nghttp2_mem_free(mem, item);
+    nghttp2_mempool_release(&session->item_pool, item);
     return rv;
   }
 
@@ -323,7 +316,7 @@ int32_t nghttp2_submit_push_promise(nghttp2_session *session, uint8_t flags _U_,
 
   if (rv != 0) {
     nghttp2_frame_push_promise_free(&frame->push_promise, mem);
-    nghttp2_mem_free(mem, item);
+    nghttp2_mempool_release(&session->item_pool, item);
 
     return rv;
   }
@@ -404,7 +397,7 @@ int32_t nghttp2_submit_request(nghttp2_session *session,
   flags = set_request_flags(pri_spec, data_prd);
 
   return submit_headers_shared_nva(session, flags, -1, pri_spec, nva, nvlen,
-                                   data_prd, stream_user_data, 0);
+                                   data_prd, stream_user_data);
 }
 
 static uint8_t set_response_flags(const nghttp2_data_provider *data_prd) {
@@ -420,7 +413,7 @@ int nghttp2_submit_response(nghttp2_session *session, int32_t stream_id,
                             const nghttp2_data_provider *data_prd) {
   uint8_t flags = set_response_flags(data_prd);
   return submit_headers_shared_nva(session, flags, stream_id, NULL, nva, nvlen,
-                                   data_prd, NULL, 1);
+                                   data_prd, NULL);
 }
 
 int nghttp2_submit_data(nghttp2_session *session, uint8_t flags,
@@ -431,15 +424,12 @@ int nghttp2_submit_data(nghttp2_session *session, uint8_t flags,
   nghttp2_frame *frame;
   nghttp2_data_aux_data *aux_data;
   uint8_t nflags = flags & NGHTTP2_FLAG_END_STREAM;
-  nghttp2_mem *mem;
-
-  mem = &session->mem;
 
   if (stream_id == 0) {
     return NGHTTP2_ERR_INVALID_ARGUMENT;
   }
 
-  item = nghttp2_mem_malloc(mem, sizeof(nghttp2_outbound_item));
+  item = nghttp2_mempool_alloc(&session->item_pool);
   if (item == NULL) {
     return NGHTTP2_ERR_NOMEM;
   }
@@ -458,7 +448,7 @@ int nghttp2_submit_data(nghttp2_session *session, uint8_t flags,
   rv = nghttp2_session_add_item(session, item);
   if (rv != 0) {
     nghttp2_frame_data_free(&frame->data);
-    nghttp2_mem_free(mem, item);
+    nghttp2_mempool_release(&session->item_pool, item);
     return rv;
   }
   return 0;
@@ -392,6 +392,56 @@ def _print_transition_table(node):
 def huffman_tree_print_transition_table(ctx):
     _print_transition_table(ctx.root)
 
+# The number of bits the fast decoder looks up at once.  This must be
+# the same value of NGHTTP2_HUFF_DECODE_FAST_BITS in
+# lib/nghttp2_hd_huffman.h.
+HUFF_DECODE_FAST_BITS = 12
+
+def _decode_one(ctx, bits):
+    node = ctx.root
+    for i, b in enumerate(bits):
+        node = node.left if b == '0' else node.right
+        if node.term is not None:
+            return node.term, i + 1
+    return None, 0
+
+def huffman_build_fast_decode_table(ctx):
+    # Each entry is indexed by the next HUFF_DECODE_FAST_BITS bits
+    # from the code boundary, and tells at most 2 symbols decoded from
+    # them, and the number of bits they consume.
+    tbl = []
+    for i in range(1 << HUFF_DECODE_FAST_BITS):
+        bits = format(i, '0{}b'.format(HUFF_DECODE_FAST_BITS))
+        sym1, nbits1 = _decode_one(ctx, bits)
+        if sym1 is None:
+            tbl.append((0, 0, 0, 0))
+            continue
+        sym2, nbits2 = _decode_one(ctx, bits[nbits1:])
+        if sym2 is None:
+            tbl.append((nbits1, nbits1, sym1, 0))
+            continue
+        tbl.append((nbits1 + nbits2, nbits1, sym1, sym2))
+    return tbl
+
+def huffman_build_long_decode_table(symbol_tbl):
+    # HPACK huffman code is canonical.  Build the table to decode the
+    # codes which do not fit in the fast decode table.
+    syms = sorted(range(257), key=lambda i: (symbol_tbl[i][0], i))
+    tbl = [(0, 0, 0) for i in range(31)]
+    code = 0
+    prevnbits = symbol_tbl[syms[0]][0]
+    for offset, sym in enumerate(syms):
+        nbits = symbol_tbl[sym][0]
+        code <<= nbits - prevnbits
+        prevnbits = nbits
+        assert int(symbol_tbl[sym][1], 16) == code
+        first, count, off = tbl[nbits]
+        if count == 0:
+            first, off = code, offset
+        tbl[nbits] = (first, count + 1, off)
+        code += 1
+    return tbl, syms
+
 if __name__ == '__main__':
     ctx = Context()
     symbol_tbl = [(None, 0) for i in range(257)]
@@ -449,3 +499,27 @@ typedef struct {
 const nghttp2_huff_decode huff_decode_table[][16] = {'''
     huffman_tree_print_transition_table(ctx)
     print '};'
+
+    print ''
+
+    print '''\
+const nghttp2_huff_decode_fast huff_decode_fast_table[] = {'''
+    for ent in huffman_build_fast_decode_table(ctx):
+        print '    {{{}, {}, {}, {}}},'.format(*ent)
+    print '};'
+    print ''
+
+    long_tbl, long_syms = huffman_build_long_decode_table(symbol_tbl)
+
+    print '''\
+const nghttp2_huff_decode_long huff_decode_long_table[] = {'''
+    for first, count, offset in long_tbl:
+        print '    {{0x{:x}u, {}, {}}},'.format(first, count, offset)
+    print '};'
+    print ''
+
+    print '''\
+const uint16_t huff_decode_long_sym_table[] = {'''
+    for i in range(0, len(long_syms), 12):
+        print '    {},'.format(', '.join(str(x) for x in long_syms[i:i + 12]))
+    print '};'
@@ -38,6 +38,7 @@
 #include <cstdlib>
 #include <vector>
 #include <iostream>
+#include <chrono>
 
 #include <jansson.h>
 
@@ -56,6 +57,8 @@ namespace nghttp2 {
 typedef struct {
   size_t table_size;
   size_t deflate_table_size;
+  size_t max_indexed_valuelen;
+  nghttp2_hd_indexing_strategy indexing_strategy;
   int http1text;
   int dump_header_table;
 } deflate_config;
@@ -64,6 +67,7 @@ static deflate_config config;
 
 static size_t input_sum;
 static size_t output_sum;
+static std::chrono::steady_clock::duration deflate_time;
 
 static char to_hex_digit(uint8_t n) {
   if (n > 9) {
@@ -128,8 +132,10 @@ static void deflate_hd(nghttp2_hd_deflater *deflater,
 
   nghttp2_bufs_init2(&bufs, 4_k, 16, 0, nghttp2_mem_default());
 
+  auto start = std::chrono::steady_clock::now();
   rv = nghttp2_hd_deflate_hd_bufs(deflater, &bufs, (nghttp2_nv *)nva.data(),
                                   nva.size());
+  deflate_time += std::chrono::steady_clock::now() - start;
   if (rv < 0) {
     fprintf(stderr, "deflate failed with error code %zd at %d\n", rv, seq);
     exit(EXIT_FAILURE);
@@ -196,6 +202,8 @@ static nghttp2_hd_deflater *init_deflater() {
   nghttp2_hd_deflater *deflater;
   nghttp2_hd_deflate_new(&deflater, config.deflate_table_size);
   nghttp2_hd_deflate_change_table_size(deflater, config.table_size);
+  nghttp2_hd_deflate_set_indexing_strategy(deflater, config.indexing_strategy,
+                                           config.max_indexed_valuelen);
   return deflater;
 }
 
@@ -381,7 +389,19 @@ OPTIONS:
                       buffer.
                       Default: 4096
     -d, --dump-header-table
-                      Output dynamic header table.)" << std::endl;
+                      Output dynamic header table.
+    -i, --indexing=<STRATEGY>
+                      Select the  strategy to decide which  header field
+                      is inserted  into dynamic table.   The value is one
+                      of "default", "frequency"  and "value-size".  See
+                      nghttp2_hd_indexing_strategy for  details.  The
+                      time spent  in deflation  is reported  with the
+                      overall ratio to compare strategies.
+                      Default: default
+    -V, --max-indexed-value-length=<N>
+                      Maximum length of header field value indexed by
+                      "value-size" strategy.
+                      Default: 64)" << std::endl;
 }
 
 static struct option long_options[] = {
@@ -389,6 +409,8 @@ static struct option long_options[] = {
     {"table-size", required_argument, nullptr, 's'},
     {"deflate-table-size", required_argument, nullptr, 'S'},
     {"dump-header-table", no_argument, nullptr, 'd'},
+    {"indexing", required_argument, nullptr, 'i'},
+    {"max-indexed-value-length", required_argument, nullptr, 'V'},
     {nullptr, 0, nullptr, 0}};
 
 int main(int argc, char **argv) {
@@ -398,9 +420,12 @@ int main(int argc, char **argv) {
   config.deflate_table_size = NGHTTP2_HD_DEFAULT_MAX_DEFLATE_BUFFER_SIZE;
   config.http1text = 0;
   config.dump_header_table = 0;
+  config.indexing_strategy = NGHTTP2_HD_INDEXING_DEFAULT;
+  config.max_indexed_valuelen = 64;
   while (1) {
     int option_index = 0;
-    int c = getopt_long(argc, argv, "S:dhs:t", long_options, &option_index);
+    int c =
+        getopt_long(argc, argv, "S:V:dhi:s:t", long_options, &option_index);
     if (c == -1) {
       break;
     }
@@ -434,6 +459,28 @@ int main(int argc, char **argv) {
       // --dump-header-table
       config.dump_header_table = 1;
       break;
+    case 'i':
+      // --indexing
+      if (strcmp(optarg, "default") == 0) {
+        config.indexing_strategy = NGHTTP2_HD_INDEXING_DEFAULT;
+      } else if (strcmp(optarg, "frequency") == 0) {
+        config.indexing_strategy = NGHTTP2_HD_INDEXING_FREQUENCY;
+      } else if (strcmp(optarg, "value-size") == 0) {
+        config.indexing_strategy = NGHTTP2_HD_INDEXING_VALUE_SIZE;
+      } else {
+        fprintf(stderr, "-i: Bad option value\n");
+        exit(EXIT_FAILURE);
+      }
+      break;
+    case 'V':
+      // --max-indexed-value-length
+      errno = 0;
+      config.max_indexed_valuelen = strtoul(optarg, &end, 10);
+      if (errno == ERANGE || *end != '\0') {
+        fprintf(stderr, "-V: Bad option value\n");
+        exit(EXIT_FAILURE);
+      }
+      break;
     case '?':
       exit(EXIT_FAILURE);
     default:
@@ -448,8 +495,9 @@ int main(int argc, char **argv) {
 
   auto comp_ratio = input_sum == 0 ? 0.0 : (double)output_sum / input_sum;
 
-  fprintf(stderr, "Overall: input=%zu output=%zu ratio=%.02f\n", input_sum,
-          output_sum, comp_ratio);
+  fprintf(stderr, "Overall: input=%zu output=%zu ratio=%.02f time=%.03fms\n",
+          input_sum, output_sum, comp_ratio,
+          std::chrono::duration<double, std::milli>(deflate_time).count());
   return 0;
 }
 
@@ -35,6 +35,9 @@
 #include "shrpx_ssl_test.h"
 #include "shrpx_downstream_test.h"
 #include "shrpx_config_test.h"
+#include "shrpx_load_balancer_test.h"
+#include "shrpx_router_test.h"
+#include "shrpx_response_cache_test.h"
 #include "http2_test.h"
 #include "util_test.h"
 #include "nghttp2_gzip_test.h"
@@ -118,6 +121,27 @@ int main(int argc, char *argv[]) {
                    shrpx::test_shrpx_config_parse_log_format) ||
       !CU_add_test(pSuite, "config_read_tls_ticket_key_file",
                    shrpx::test_shrpx_config_read_tls_ticket_key_file) ||
+      !CU_add_test(pSuite, "config_parse_env_fds",
+                   shrpx::test_shrpx_config_parse_env_fds) ||
+      !CU_add_test(pSuite, "load_balancer_round_robin",
+                   shrpx::test_shrpx_load_balancer_round_robin) ||
+      !CU_add_test(pSuite, "load_balancer_least_request",
+                   shrpx::test_shrpx_load_balancer_least_request) ||
+      !CU_add_test(pSuite, "load_balancer_peak_ewma",
+                   shrpx::test_shrpx_load_balancer_peak_ewma) ||
+      !CU_add_test(pSuite, "load_balancer_p2c",
+                   shrpx::test_shrpx_load_balancer_p2c) ||
+      !CU_add_test(pSuite, "load_balancer_health",
+                   shrpx::test_shrpx_load_balancer_health) ||
+      !CU_add_test(pSuite, "router_match", shrpx::test_shrpx_router_match) ||
+      !CU_add_test(pSuite, "response_cache_parse_cache_control",
+                   shrpx::test_shrpx_response_cache_parse_cache_control) ||
+      !CU_add_test(pSuite, "response_cache_etag_match",
+                   shrpx::test_shrpx_response_cache_etag_match) ||
+      !CU_add_test(pSuite, "response_cache_check_not_modified",
+                   shrpx::test_shrpx_response_cache_check_not_modified) ||
+      !CU_add_test(pSuite, "response_cache_lru",
+                   shrpx::test_shrpx_response_cache_lru) ||
       !CU_add_test(pSuite, "util_streq", shrpx::test_util_streq) ||
       !CU_add_test(pSuite, "util_strieq", shrpx::test_util_strieq) ||
       !CU_add_test(pSuite, "util_inp_strlower",
@@ -83,6 +83,7 @@
 #include "shrpx_accept_handler.h"
 #include "shrpx_http2_upstream.h"
 #include "shrpx_http2_session.h"
+#include "shrpx_http.h"
 #include "util.h"
 #include "app_helper.h"
 #include "ssl.h"
@@ -170,44 +171,98 @@ void close_env_fd(std::initializer_list<const char *> envnames) {
     if (!envfd) {
       continue;
     }
-    auto fd = strtol(envfd, nullptr, 10);
-    close(fd);
+    for (auto fd : parse_env_fds(envfd)) {
+      close(fd);
+    }
   }
 }
 } // namespace
 
 namespace {
-std::unique_ptr<AcceptHandler>
-create_unix_domain_acceptor(ConnectionHandler *handler) {
+// Closes all but the first file descriptor in |fds|, and removes
+// them from |fds|.
+void close_extra_fds(std::vector<int> &fds) {
+  if (fds.size() > 1) {
+    LOG(WARN) << "Closing " << fds.size() - 1
+              << " listening socket(s) inherited from the old binary";
+  }
+  for (size_t i = 1; i < fds.size(); ++i) {
+    close(fds[i]);
+  }
+  fds.resize(std::min(fds.size(), static_cast<size_t>(1)));
+}
+} // namespace
+
+namespace {
+// Adds duplicates of the file descriptors in |fds| until there is one
+// for each worker, so that workers share listening sockets.
+void share_fds(std::vector<int> &fds) {
+  for (size_t i = 0; !fds.empty() && fds.size() < get_config()->num_worker;
+       ++i) {
+    auto fd = dup(fds[i]);
+    if (fd == -1) {
+      auto error = errno;
+      LOG(WARN) << "dup() syscall failed, error=" << error;
+      break;
+    }
+    fds.push_back(fd);
+  }
+}
+} // namespace
+
+namespace {
+// Returns true if SO_REUSEPORT is set to |fd|.
+bool has_reuseport(int fd) {
+#ifdef SO_REUSEPORT
+  int val = 0;
+  socklen_t len = sizeof(val);
+  if (getsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &val, &len) == -1) {
+    return false;
+  }
+  return val != 0;
+#else  // !SO_REUSEPORT
+  return false;
+#endif // !SO_REUSEPORT
+}
+} // namespace
+
+namespace {
+// Returns listening UNIX domain socket, which is inherited from the
+// old binary or newly created.  Returns -1 if it fails.
+int create_unix_domain_server_socket() {
   auto path = get_config()->host.get();
   auto pathlen = strlen(path);
   {
     auto envfd = getenv(ENV_UNIX_FD);
     auto envpath = getenv(ENV_UNIX_PATH);
     if (envfd && envpath) {
-      auto fd = strtoul(envfd, nullptr, 10);
+      auto fds = parse_env_fds(envfd);
 
-      if (util::streq(envpath, path)) {
+      if (!fds.empty() && util::streq(envpath, path)) {
         LOG(NOTICE) << "Listening on UNIX domain socket " << path;
 
-        return make_unique<AcceptHandler>(fd, handler);
+        close_extra_fds(fds);
+
+        return fds[0];
       }
 
       LOG(WARN) << "UNIX domain socket path was changed between old binary ("
                 << envpath << ") and new binary (" << path << ")";
-      close(fd);
+      for (auto fd : fds) {
+        close(fd);
+      }
     }
   }
 
 #ifdef SOCK_NONBLOCK
   auto fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0);
   if (fd == -1) {
-    return nullptr;
+    return -1;
   }
 #else  // !SOCK_NONBLOCK
   auto fd = socket(AF_UNIX, SOCK_STREAM, 0);
   if (fd == -1) {
-    return nullptr;
+    return -1;
   }
   util::make_socket_nonblocking(fd);
 #endif // !SOCK_NONBLOCK
@@ -215,7 +270,7 @@ create_unix_domain_acceptor(ConnectionHandler *handler) {
   if (setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &val,
                  static_cast<socklen_t>(sizeof(val))) == -1) {
     close(fd);
-    return nullptr;
+    return -1;
   }
 
   sockaddr_union addr;
@@ -224,7 +279,7 @@ create_unix_domain_acceptor(ConnectionHandler *handler) {
     LOG(FATAL) << "UNIX domain socket path " << path << " is too long > "
                << sizeof(addr.un.sun_path);
     close(fd);
-    return nullptr;
+    return -1;
   }
   // copy path including terminal NULL
   std::copy_n(path, pathlen + 1, addr.un.sun_path);
@@ -236,49 +291,91 @@ create_unix_domain_acceptor(ConnectionHandler *handler) {
     auto error = errno;
     LOG(FATAL) << "Failed to bind UNIX domain socket, error=" << error;
     close(fd);
-    return nullptr;
+    return -1;
   }
 
   if (listen(fd, get_config()->backlog) != 0) {
     auto error = errno;
     LOG(FATAL) << "Failed to listen to UNIX domain socket, error=" << error;
     close(fd);
-    return nullptr;
+    return -1;
   }
 
   LOG(NOTICE) << "Listening on UNIX domain socket " << path;
 
+  return fd;
+}
+} // namespace
+
+namespace {
+std::unique_ptr<AcceptHandler>
+create_unix_domain_acceptor(ConnectionHandler *handler) {
+  auto fd = create_unix_domain_server_socket();
+  if (fd == -1) {
+    return nullptr;
+  }
+
   return make_unique<AcceptHandler>(fd, handler);
 }
 } // namespace
 
 namespace {
-std::unique_ptr<AcceptHandler> create_acceptor(ConnectionHandler *handler,
-                                               int family) {
-  {
-    auto envfd =
-        getenv(family == AF_INET ? ENV_LISTENER4_FD : ENV_LISTENER6_FD);
-    auto envport = getenv(ENV_PORT);
+// Returns listening sockets for workers when --reuseport is given.
+// SO_REUSEPORT does not distribute connections to UNIX domain
+// sockets, so that workers share the same socket.
+std::vector<int> create_worker_unix_domain_server_sockets() {
+  auto fd = create_unix_domain_server_socket();
+  if (fd == -1) {
+    return {};
+  }
 
-    if (envfd && envport) {
-      auto fd = strtoul(envfd, nullptr, 10);
-      auto port = strtoul(envport, nullptr, 10);
+  std::vector<int> fds{fd};
+  share_fds(fds);
 
-      // Only do this iff NGHTTPX_PORT == get_config()->port.
-      // Otherwise, close fd, and create server socket as usual.
+  return fds;
+}
+} // namespace
 
-      if (port == get_config()->port) {
-        LOG(NOTICE) << "Listening on port " << get_config()->port;
+namespace {
+// Returns listening sockets for |family| inherited from the old
+// binary.
+std::vector<int> get_inherited_tcp_fds(int family) {
+  auto envfd = getenv(family == AF_INET ? ENV_LISTENER4_FD : ENV_LISTENER6_FD);
+  auto envport = getenv(ENV_PORT);
 
-        return make_unique<AcceptHandler>(fd, handler);
-      }
+  if (!envfd || !envport) {
+    return {};
+  }
 
-      LOG(WARN) << "Port was changed between old binary (" << port
-                << ") and new binary (" << get_config()->port << ")";
-      close(fd);
+  auto fds = parse_env_fds(envfd);
+  auto port = strtoul(envport, nullptr, 10);
+
+  // Only do this iff NGHTTPX_PORT == get_config()->port.  Otherwise,
+  // close fd, and create server socket as usual.
+
+  if (port == get_config()->port) {
+    if (!fds.empty()) {
+      LOG(NOTICE) << "Listening on port " << get_config()->port;
     }
+
+    return fds;
   }
 
+  LOG(WARN) << "Port was changed between old binary (" << port
+            << ") and new binary (" << get_config()->port << ")";
+  for (auto fd : fds) {
+    close(fd);
+  }
+
+  return {};
+}
+} // namespace
+
+namespace {
+// Creates listening socket for |family|.  If |reuseport| is true,
+// SO_REUSEPORT is set, so that the other sockets can listen on the
+// same address and port.  Returns -1 if it fails.
+int create_tcp_server_socket(int family, bool reuseport) {
   addrinfo hints;
   int fd = -1;
   int rv;
@@ -304,7 +401,7 @@ std::unique_ptr<AcceptHandler> create_acceptor(ConnectionHandler *handler,
                 << " address for " << get_config()->host.get() << ": "
                 << gai_strerror(rv);
     }
-    return nullptr;
+    return -1;
   }
   for (rp = res; rp; rp = rp->ai_next) {
 #ifdef SOCK_NONBLOCK
@@ -335,6 +432,19 @@ std::unique_ptr<AcceptHandler> create_acceptor(ConnectionHandler *handler,
       continue;
     }
 
+#ifdef SO_REUSEPORT
+    if (reuseport &&
+        setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &val,
+                   static_cast<socklen_t>(sizeof(val))) == -1) {
+      auto error = errno;
+      LOG(WARN)
+          << "Failed to set SO_REUSEPORT option to listener socket, error="
+          << error;
+      close(fd);
+      continue;
+    }
+#endif // SO_REUSEPORT
+
 #ifdef IPV6_V6ONLY
     if (family == AF_INET6) {
       if (setsockopt(fd, IPPROTO_IPV6, IPV6_V6ONLY, &val,
@@ -383,7 +493,7 @@ std::unique_ptr<AcceptHandler> create_acceptor(ConnectionHandler *handler,
 
     freeaddrinfo(res);
 
-    return nullptr;
+    return -1;
   }
 
   char host[NI_MAXHOST];
@@ -397,15 +507,76 @@ std::unique_ptr<AcceptHandler> create_acceptor(ConnectionHandler *handler,
 
     close(fd);
 
-    return nullptr;
+    return -1;
   }
 
   LOG(NOTICE) << "Listening on " << host << ", port " << get_config()->port;
 
+  return fd;
+}
+} // namespace
+
+namespace {
+std::unique_ptr<AcceptHandler> create_acceptor(ConnectionHandler *handler,
+                                               int family) {
+  auto fds = get_inherited_tcp_fds(family);
+  if (!fds.empty()) {
+    // The old binary may have passed a socket per worker if it used
+    // --reuseport.  We only accept connections from the first one.
+    close_extra_fds(fds);
+
+    return make_unique<AcceptHandler>(fds[0], handler);
+  }
+
+  auto fd = create_tcp_server_socket(family, false);
+  if (fd == -1) {
+    return nullptr;
+  }
+
   return make_unique<AcceptHandler>(fd, handler);
 }
 } // namespace
 
+namespace {
+// Returns listening sockets for workers for |family| when --reuseport
+// is given.  Each worker gets at least one socket.  We keep all
+// sockets inherited from the old binary, so that connections queued
+// in them are not lost.  If they were not created with SO_REUSEPORT,
+// or SO_REUSEPORT is not available, we cannot bind more sockets to the
+// same address, and workers share the same socket.
+std::vector<int> create_worker_tcp_server_sockets(int family) {
+  auto fds = get_inherited_tcp_fds(family);
+
+  if (!fds.empty() && !has_reuseport(fds[0])) {
+    close_extra_fds(fds);
+  }
+
+  if (fds.empty()) {
+    auto fd = create_tcp_server_socket(family, true);
+    if (fd == -1) {
+      return {};
+    }
+
+    fds.push_back(fd);
+  }
+
+  if (has_reuseport(fds[0])) {
+    while (fds.size() < get_config()->num_worker) {
+      auto fd = create_tcp_server_socket(family, true);
+      if (fd == -1) {
+        break;
+      }
+
+      fds.push_back(fd);
+    }
+  }
+
+  share_fds(fds);
+
+  return fds;
+}
+} // namespace
+
 namespace {
 void drop_privileges() {
   if (getuid() == 0 && get_config()->uid != 0) {
@@ -465,6 +636,8 @@ void reopen_log_signal_cb(struct ev_loop *loop, ev_signal *w, int revents) {
 
   if (get_config()->num_worker > 1) {
     conn_handler->worker_reopen_log_files();
+  } else {
+    conn_handler->get_single_worker()->log_response_cache_stat();
   }
 }
 } // namespace
@@ -510,28 +683,39 @@ void exec_binary_signal_cb(struct ev_loop *loop, ev_signal *w, int revents) {
   auto envp = make_unique<char *[]>(envlen + 3 + 1);
   size_t envidx = 0;
 
-  if (get_config()->host_unix) {
-    auto acceptor = conn_handler->get_acceptor();
-    std::string fd = ENV_UNIX_FD "=";
-    fd += util::utos(acceptor->get_fd());
-    envp[envidx++] = strdup(fd.c_str());
+  std::vector<int> fds4, fds6;
 
-    std::string path = ENV_UNIX_PATH "=";
-    path += get_config()->host.get();
-    envp[envidx++] = strdup(path.c_str());
+  if (get_config()->reuseport) {
+    fds4 = conn_handler->get_worker_listener_fds();
+    fds6 = conn_handler->get_worker_listener_fds6();
   } else {
     auto acceptor4 = conn_handler->get_acceptor();
     if (acceptor4) {
-      std::string fd4 = ENV_LISTENER4_FD "=";
-      fd4 += util::utos(acceptor4->get_fd());
-      envp[envidx++] = strdup(fd4.c_str());
+      fds4.push_back(acceptor4->get_fd());
     }
 
     auto acceptor6 = conn_handler->get_acceptor6();
     if (acceptor6) {
-      std::string fd6 = ENV_LISTENER6_FD "=";
-      fd6 += util::utos(acceptor6->get_fd());
-      envp[envidx++] = strdup(fd6.c_str());
+      fds6.push_back(acceptor6->get_fd());
+    }
+  }
+
+  if (get_config()->host_unix) {
+    // Workers share the same UNIX domain socket, so that passing one
+    // of them is enough.
+    fds4.resize(1);
+    envp[envidx++] = strdup(make_env_fds(ENV_UNIX_FD, fds4).c_str());
+
+    std::string path = ENV_UNIX_PATH "=";
+    path += get_config()->host.get();
+    envp[envidx++] = strdup(path.c_str());
+  } else {
+    if (!fds4.empty()) {
+      envp[envidx++] = strdup(make_env_fds(ENV_LISTENER4_FD, fds4).c_str());
+    }
+
+    if (!fds6.empty()) {
+      envp[envidx++] = strdup(make_env_fds(ENV_LISTENER6_FD, fds6).c_str());
     }
 
     std::string port = ENV_PORT "=";
@@ -671,7 +855,28 @@ int event_loop() {
     save_pid();
   }
 
-  if (get_config()->host_unix) {
+  if (get_config()->host_unix && get_config()->reuseport) {
+    close_env_fd({ENV_LISTENER4_FD, ENV_LISTENER6_FD});
+    auto fds = create_worker_unix_domain_server_sockets();
+    if (fds.empty()) {
+      LOG(FATAL) << "Failed to listen on UNIX domain socket "
+                 << get_config()->host.get();
+      exit(EXIT_FAILURE);
+    }
+
+    conn_handler->set_worker_listener_fds(std::move(fds), {});
+  } else if (get_config()->reuseport) {
+    close_env_fd({ENV_UNIX_FD});
+    auto fds6 = create_worker_tcp_server_sockets(AF_INET6);
+    auto fds4 = create_worker_tcp_server_sockets(AF_INET);
+    if (fds6.empty() && fds4.empty()) {
+      LOG(FATAL) << "Failed to listen on address " << get_config()->host.get()
+                 << ", port " << get_config()->port;
+      exit(EXIT_FAILURE);
+    }
+
+    conn_handler->set_worker_listener_fds(std::move(fds4), std::move(fds6));
+  } else if (get_config()->host_unix) {
     close_env_fd({ENV_LISTENER4_FD, ENV_LISTENER6_FD});
     auto acceptor = create_unix_domain_acceptor(conn_handler.get());
     if (!acceptor) {
@@ -949,16 +1154,66 @@ void fill_default_config() {
   mod_config()->no_server_push = false;
   mod_config()->host_unix = false;
   mod_config()->http2_downstream_connections_per_worker = 0;
+  mod_config()->downstream_addr_group_catch_all = 0;
   // ocsp update interval = 14400 secs = 4 hours, borrowed from h2o
   mod_config()->ocsp_update_interval = 4_h;
   mod_config()->fetch_ocsp_response_file =
       strcopy(PKGDATADIR "/fetch-ocsp-response");
   mod_config()->no_ocsp = false;
+  mod_config()->reuseport = false;
+  mod_config()->backend_balance = BALANCE_ROUND_ROBIN;
+  mod_config()->downstream_health_check_interval = 0.;
+  mod_config()->downstream_health_check_timeout = 2.;
+  mod_config()->downstream_health_check_rise = 2;
+  mod_config()->downstream_health_check_fall = 3;
+  mod_config()->response_cache_size = 0;
+  mod_config()->response_cache_max_object_size = 1_m;
   mod_config()->header_field_buffer = 64_k;
   mod_config()->max_header_fields = 100;
 }
 } // namespace
 
+namespace {
+// Registers header field names and values which HTTP/2 frontend adds
+// to every response, so that they are not Huffman encoded each time.
+void setup_hd_string_cache() {
+  nghttp2_hd_string_cache *cache;
+
+  if (nghttp2_hd_string_cache_new(&cache, nullptr) != 0) {
+    LOG(FATAL) << "nghttp2_hd_string_cache_new() failed";
+    exit(EXIT_FAILURE);
+  }
+
+  auto strs = std::vector<std::string>();
+
+  if (!get_config()->http2_proxy && !get_config()->client_proxy) {
+    strs.push_back(get_config()->server_name);
+  }
+
+  if (!get_config()->no_via) {
+    strs.push_back(http::create_via_header_value(1, 1));
+    strs.push_back(http::create_via_header_value(2, 0));
+  }
+
+  for (auto &p : get_config()->add_response_headers) {
+    strs.push_back(p.first);
+    strs.push_back(p.second);
+  }
+
+  for (auto &s : strs) {
+    if (nghttp2_hd_string_cache_add(
+            cache, reinterpret_cast<const uint8_t *>(s.c_str()),
+            s.size()) != 0) {
+      LOG(FATAL) << "nghttp2_hd_string_cache_add() failed";
+      exit(EXIT_FAILURE);
+    }
+  }
+
+  // cache is never freed since it is used until process exits.
+  nghttp2_option_set_hd_string_cache(get_config()->http2_option, cache);
+}
+} // namespace
+
 namespace {
 void print_version(std::ostream &out) {
   out << get_config()->server_name << std::endl;
@@ -987,11 +1242,40 @@ Options:
   The options are categorized into several groups.
 
 Connections:
-  -b, --backend=<HOST,PORT>
-              Set  backend  host  and   port.   The  multiple  backend
-              addresses are  accepted by repeating this  option.  UNIX
-              domain socket  can be  specified by prefixing  path name
+  -b, --backend=(<HOST>,<PORT>|unix:<PATH>)[;<PATTERN>[:...]]
+              Set  backend  host  and  port.    The  multiple  backend
+              addresses  are  accepted by repeating this option.  UNIX
+              domain  socket  can  be specified by prefixing path name
               with "unix:" (e.g., unix:/var/run/backend.sock)
+
+              Optionally, if <PATTERN>s are given, the backend address
+              is  only used if request matches the pattern.  <PATTERN>
+              consists  of  host  followed by path, or just path.  The
+              path  must  start  with  "/".   If  it ends with "/", it
+              matches  all  request  paths  in  its  subtree,  and the
+              request  path  which only lacks trailing "/" (e.g., path
+              "/foo/"  matches  request  path  "/foo").  Otherwise, it
+              matches the request path exactly.  Query is ignored.  If
+              host  is  given, it matches the request host (:authority
+              or  Host  header  field) exactly, ignoring case and port
+              (e.g.,  "nghttp2.org:3000"  matches "nghttp2.org"). Host
+              alone  is  equivalent  to host followed by "/". Patterns
+              with  host take precedence over patterns with just path.
+              Then, longer patterns take precedence over shorter ones.
+              If  <PATTERN> is omitted, "/" is used, which matches all
+              requests (catch-all pattern). The catch-all backend must
+              be given.
+
+              The  multiple  <PATTERN>s  can  be specified, delimiting
+              them  by  ":".   The  backend addresses sharing the same
+              <PATTERN>  form  a  group.    Each  group  has  its  own
+              connection  pool, and load balancing and health checking
+              are    done    within   the   group.      For   example,
+              -b'127.0.0.1,8080;nghttp2.org/httpbin/'    routes    the
+              request  to  host "nghttp2.org" with path "/httpbin/get"
+              to   127.0.0.1:8080,  but  not  the  request  with  path
+              "/index.html".
+
               Default: )" << DEFAULT_DOWNSTREAM_HOST << ","
       << DEFAULT_DOWNSTREAM_PORT << R"(
   -f, --frontend=<HOST,PORT>
@@ -1021,11 +1305,48 @@ Connections:
               timeouts when connecting and  making CONNECT request can
               be     specified    by     --backend-read-timeout    and
               --backend-write-timeout options.
+  --backend-health-check-interval=<DURATION>
+              Check  the  health  of each backend address periodically
+              with this interval.  A backend which is marked unhealthy
+              is  not  chosen  for new request unless all backends are
+              marked   unhealthy.     Each   worker   checks  backends
+              independently.  0 disables health check.
+              Default: )"
+      << util::duration_str(get_config()->downstream_health_check_interval)
+      << R"(
+  --backend-health-check-timeout=<DURATION>
+              Set timeout of a single health check.
+              Default: )"
+      << util::duration_str(get_config()->downstream_health_check_timeout)
+      << R"(
+  --backend-health-check-path=<PATH>
+              Send  GET  request  to <PATH> in health check, and treat
+              2xx and 3xx response as success.  The request is sent in
+              HTTP/2 if --http2-bridge or --client is given, otherwise
+              in  HTTP/1.1.  If this option is not given, health check
+              only makes TCP connection to the backend.
+  --backend-health-check-rise=<N>
+              Mark  unhealthy  backend  healthy  after <N> consecutive
+              successful health checks.
+              Default: )" << get_config()->downstream_health_check_rise << R"(
+  --backend-health-check-fall=<N>
+              Mark  healthy  backend  unhealthy  after <N> consecutive
+              failed health checks.
+              Default: )" << get_config()->downstream_health_check_fall << R"(
 
 Performance:
   -n, --workers=<N>
               Set the number of worker threads.
               Default: )" << get_config()->num_worker << R"(
+  --reuseport
+              Let  each  worker thread accept connections from its own
+              listening  socket,  instead of the main thread accepting
+              connections  and  dispatching  them to workers. For IPv4
+              and IPv6 address, the listening sockets are created with
+              SO_REUSEPORT,    and    kernel    distributes   incoming
+              connections  among them. UNIX domain socket is shared by
+              workers.  This option has effect only if -n is more than
+              1.
   --read-rate=<SIZE>
               Set maximum  average read  rate on  frontend connection.
               Setting 0 to this option means read rate is unlimited.
@@ -1069,9 +1390,10 @@ Performance:
               accepts.  Setting 0 means unlimited.
               Default: )" << get_config()->worker_frontend_connections << R"(
   --backend-http2-connections-per-worker=<N>
-              Set  maximum number  of HTTP/2  connections per  worker.
-              The  default  value is  0,  which  means the  number  of
-              backend addresses specified by -b option.
+              Set  maximum number of HTTP/2 connections per worker for
+              each  backend  address  group.   The default value is 0,
+              which  means  the  number  of  backend  addresses in the
+              group.
   --backend-http1-connections-per-host=<N>
               Set   maximum  number   of  backend   concurrent  HTTP/1
               connections per origin host.   This option is meaningful
@@ -1090,6 +1412,23 @@ Performance:
               (-s option), use --backend-http1-connections-per-host.
               Default: )" << get_config()->downstream_connections_per_frontend
       << R"(
+  --backend-balance=<POLICY>
+              Set  the  policy  to  choose  backend  address  for  new
+              request.   The  same  policy  is  used  to choose HTTP/2
+              backend  session  for new frontend connection.  <POLICY>
+              must be one of the following:
+
+              * round-robin: Choose backends in turn.
+              * least-request: Choose  the backend  which has  fewest
+                outstanding requests.
+              * peak-ewma: Choose the  backend which has the  lowest
+                peak EWMA  response latency multiplied by  the number
+                of outstanding requests plus 1.
+              * p2c:  Pick 2  backends  at random,  and  choose  the
+                one which has fewer outstanding requests.
+
+              Each  worker keeps  its own  statistics.
+              Default: round-robin
   --rlimit-nofile=<N>
               Set maximum number of open files (RLIMIT_NOFILE) to <N>.
               If 0 is given, nghttpx does not set the limit.
@@ -1104,6 +1443,27 @@ Performance:
               Default: )"
       << util::utos_with_unit(get_config()->downstream_response_buffer_size)
       << R"(
+  --response-cache-size=<SIZE>
+              Cache  responses  to  GET  requests  in  memory  of each
+              worker,  and  serve  identical  requests  from the cache
+              without contacting backend. This option sets the maximum
+              total size of cached responses per worker. Response body
+              occupies memory in 16KiB blocks. Response is stored only
+              if   it   has   explicit  freshness  lifetime  given  by
+              Cache-Control max-age, s-maxage or Expires header field,
+              and  it  is  not  marked  no-store, no-cache or private.
+              Stale  response  is not served; the request is forwarded
+              to  backend.   The  number  of  cache  hits,  misses and
+              evictions  is  logged when SIGUSR1 is received, and when
+              worker exits.  0 disables cache.
+              Default: )"
+      << util::utos_with_unit(get_config()->response_cache_size) << R"(
+  --response-cache-max-object-size=<SIZE>
+              Set  the  maximum size of response body stored in cache.
+              Larger response is not stored.
+              Default: )"
+      << util::utos_with_unit(get_config()->response_cache_max_object_size)
+      << R"(
 
 Timeout:
   --frontend-http2-read-timeout=<DURATION>
@@ -1335,6 +1695,10 @@ Logging:
               * $alpn: ALPN identifier of the protocol which generates
                 the response.   For HTTP/1,  ALPN is  always http/1.1,
                 regardless of minor version.
+              * $cache_status: HIT if  the response was served from
+                response cache, MISS if  the request was forwarded to
+                backend, BYPASS if  the request  cannot be  cached at
+                all, and - if response cache is disabled.
 
               Default: )" << DEFAULT_ACCESSLOG_FORMAT << R"(
   --errorlog-file=<PATH>
@@ -1577,6 +1941,17 @@ int main(int argc, char **argv) {
         {SHRPX_OPT_HEADER_FIELD_BUFFER, required_argument, &flag, 80},
         {SHRPX_OPT_MAX_HEADER_FIELDS, required_argument, &flag, 81},
         {SHRPX_OPT_ADD_REQUEST_HEADER, required_argument, &flag, 82},
+        {SHRPX_OPT_REUSEPORT, no_argument, &flag, 83},
+        {SHRPX_OPT_BACKEND_BALANCE, required_argument, &flag, 84},
+        {SHRPX_OPT_BACKEND_HEALTH_CHECK_INTERVAL, required_argument, &flag,
+         85},
+        {SHRPX_OPT_BACKEND_HEALTH_CHECK_TIMEOUT, required_argument, &flag, 86},
+        {SHRPX_OPT_BACKEND_HEALTH_CHECK_PATH, required_argument, &flag, 87},
+        {SHRPX_OPT_BACKEND_HEALTH_CHECK_RISE, required_argument, &flag, 88},
+        {SHRPX_OPT_BACKEND_HEALTH_CHECK_FALL, required_argument, &flag, 89},
+        {SHRPX_OPT_RESPONSE_CACHE_SIZE, required_argument, &flag, 90},
+        {SHRPX_OPT_RESPONSE_CACHE_MAX_OBJECT_SIZE, required_argument, &flag,
+         91},
         {nullptr, 0, nullptr, 0}};
 
     int option_index = 0;
@@ -1939,6 +2314,42 @@ int main(int argc, char **argv) {
         // --add-request-header
         cmdcfgs.emplace_back(SHRPX_OPT_ADD_REQUEST_HEADER, optarg);
         break;
+      case 83:
+        // --reuseport
+        cmdcfgs.emplace_back(SHRPX_OPT_REUSEPORT, "yes");
+        break;
+      case 84:
+        // --backend-balance
+        cmdcfgs.emplace_back(SHRPX_OPT_BACKEND_BALANCE, optarg);
+        break;
+      case 85:
+        // --backend-health-check-interval
+        cmdcfgs.emplace_back(SHRPX_OPT_BACKEND_HEALTH_CHECK_INTERVAL, optarg);
+        break;
+      case 86:
+        // --backend-health-check-timeout
+        cmdcfgs.emplace_back(SHRPX_OPT_BACKEND_HEALTH_CHECK_TIMEOUT, optarg);
+        break;
+      case 87:
+        // --backend-health-check-path
+        cmdcfgs.emplace_back(SHRPX_OPT_BACKEND_HEALTH_CHECK_PATH, optarg);
+        break;
+      case 88:
+        // --backend-health-check-rise
+        cmdcfgs.emplace_back(SHRPX_OPT_BACKEND_HEALTH_CHECK_RISE, optarg);
+        break;
+      case 89:
+        // --backend-health-check-fall
+        cmdcfgs.emplace_back(SHRPX_OPT_BACKEND_HEALTH_CHECK_FALL, optarg);
+        break;
+      case 90:
+        // --response-cache-size
+        cmdcfgs.emplace_back(SHRPX_OPT_RESPONSE_CACHE_SIZE, optarg);
+        break;
+      case 91:
+        // --response-cache-max-object-size
+        cmdcfgs.emplace_back(SHRPX_OPT_RESPONSE_CACHE_MAX_OBJECT_SIZE, optarg);
+        break;
       default:
         break;
       }
@@ -2056,6 +2467,8 @@ int main(int argc, char **argv) {
 
   mod_config()->alpn_prefs = ssl::set_alpn_prefs(get_config()->npn_list);
 
+  setup_hd_string_cache();
+
   if (get_config()->backend_ipv4 && get_config()->backend_ipv6) {
     LOG(FATAL) << "--backend-ipv4 and --backend-ipv6 cannot be used at the "
                << "same time.";
@@ -2067,6 +2480,12 @@ int main(int argc, char **argv) {
         std::numeric_limits<size_t>::max();
   }
 
+  if (get_config()->reuseport && get_config()->num_worker == 1) {
+    // The main thread runs the single worker, and accepts connections
+    // for it directly.
+    mod_config()->reuseport = false;
+  }
+
   if (get_config()->http2_proxy + get_config()->http2_bridge +
           get_config()->client_proxy + get_config()->client >
       1) {
@@ -2103,55 +2522,89 @@ int main(int argc, char **argv) {
     }
   }
 
-  if (get_config()->downstream_addrs.empty()) {
+  auto &addr_groups = mod_config()->downstream_addr_groups;
+
+  if (addr_groups.empty()) {
     DownstreamAddr addr;
     addr.host = strcopy(DEFAULT_DOWNSTREAM_HOST);
     addr.port = DEFAULT_DOWNSTREAM_PORT;
 
-    mod_config()->downstream_addrs.push_back(std::move(addr));
+    DownstreamAddrGroup g;
+    g.pattern = strcopy("/");
+    g.addrs.push_back(std::move(addr));
+
+    addr_groups.push_back(std::move(g));
+  }
+
+  auto catch_all_found = false;
+
+  for (size_t i = 0; i < addr_groups.size(); ++i) {
+    auto pattern = addr_groups[i].pattern.get();
+
+    if (util::streq(pattern, "/")) {
+      catch_all_found = true;
+      mod_config()->downstream_addr_group_catch_all = i;
+    }
+
+    if (LOG_ENABLED(INFO)) {
+      LOG(INFO) << "Backend address group " << i << ": pattern=" << pattern
+                << ", " << addr_groups[i].addrs.size() << " address(es)";
+    }
+
+    mod_config()->router.add_route(pattern, strlen(pattern), i);
+  }
+
+  if (!catch_all_found) {
+    LOG(FATAL) << "-b: No catch-all backend address is configured";
+    exit(EXIT_FAILURE);
   }
 
   if (LOG_ENABLED(INFO)) {
     LOG(INFO) << "Resolving backend address";
   }
 
-  for (auto &addr : mod_config()->downstream_addrs) {
-
-    if (addr.host_unix) {
-      // for AF_UNIX socket, we use "localhost" as host for backend
-      // hostport.  This is used as Host header field to backend and
-      // not going to be passed to any syscalls.
-      addr.hostport =
-          strcopy(util::make_hostport("localhost", get_config()->port));
+  for (auto &g : addr_groups) {
+    for (auto &addr : g.addrs) {
 
-      auto path = addr.host.get();
-      auto pathlen = strlen(path);
+      if (addr.host_unix) {
+        // for AF_UNIX socket, we use "localhost" as host for backend
+        // hostport.  This is used as Host header field to backend and
+        // not going to be passed to any syscalls.
+        addr.hostport =
+            strcopy(util::make_hostport("localhost", get_config()->port));
 
-      if (pathlen + 1 > sizeof(addr.addr.un.sun_path)) {
-        LOG(FATAL) << "UNIX domain socket path " << path << " is too long > "
-                   << sizeof(addr.addr.un.sun_path);
-        exit(EXIT_FAILURE);
-      }
+        auto path = addr.host.get();
+        auto pathlen = strlen(path);
 
-      LOG(INFO) << "Use UNIX domain socket path " << path
-                << " for backend connection";
+        if (pathlen + 1 > sizeof(addr.addr.un.sun_path)) {
+          LOG(FATAL) << "UNIX domain socket path " << path
+                     << " is too long > " << sizeof(addr.addr.un.sun_path);
+          exit(EXIT_FAILURE);
+        }
 
-      addr.addr.un.sun_family = AF_UNIX;
-      // copy path including terminal NULL
-      std::copy_n(path, pathlen + 1, addr.addr.un.sun_path);
-      addr.addrlen = sizeof(addr.addr.un);
+        LOG(INFO) << "Use UNIX domain socket path " << path
+                  << " for backend connection";
 
-      continue;
-    }
+        addr.addr.un.sun_family = AF_UNIX;
+        // copy path including terminal NULL
+        std::copy_n(path, pathlen + 1, addr.addr.un.sun_path);
+        addr.addrlen = sizeof(addr.addr.un);
 
-    addr.hostport = strcopy(util::make_hostport(addr.host.get(), addr.port));
+        continue;
+      }
 
-    if (resolve_hostname(
-            &addr.addr, &addr.addrlen, addr.host.get(), addr.port,
-            get_config()->backend_ipv4
-                ? AF_INET
-                : (get_config()->backend_ipv6 ? AF_INET6 : AF_UNSPEC)) == -1) {
-      exit(EXIT_FAILURE);
+      addr.hostport =
+          strcopy(util::make_hostport(addr.host.get(), addr.port));
+
+      if (resolve_hostname(&addr.addr, &addr.addrlen, addr.host.get(),
+                           addr.port,
+                           get_config()->backend_ipv4
+                               ? AF_INET
+                               : (get_config()->backend_ipv6 ? AF_INET6
+                                                             : AF_UNSPEC)) ==
+          -1) {
+        exit(EXIT_FAILURE);
+      }
     }
   }
 
@@ -2168,11 +2621,6 @@ int main(int argc, char **argv) {
     }
   }
 
-  if (get_config()->http2_downstream_connections_per_worker == 0) {
-    mod_config()->http2_downstream_connections_per_worker =
-        get_config()->downstream_addrs.size();
-  }
-
   if (get_config()->rlimit_nofile) {
     struct rlimit lim = {static_cast<rlim_t>(get_config()->rlimit_nofile),
                          static_cast<rlim_t>(get_config()->rlimit_nofile)};
@@ -32,6 +32,7 @@
 
 #include "shrpx_connection_handler.h"
 #include "shrpx_config.h"
+#include "shrpx_worker.h"
 #include "util.h"
 
 using namespace nghttp2;
@@ -46,14 +47,22 @@ void acceptcb(struct ev_loop *loop, ev_io *w, int revent) {
 } // namespace
 
 AcceptHandler::AcceptHandler(int fd, ConnectionHandler *h)
-    : conn_hnr_(h), fd_(fd) {
+    : conn_hnr_(h), worker_(nullptr), loop_(h->get_loop()), fd_(fd) {
   ev_io_init(&wev_, acceptcb, fd_, EV_READ);
   wev_.data = this;
-  ev_io_start(conn_hnr_->get_loop(), &wev_);
+  ev_io_start(loop_, &wev_);
+}
+
+AcceptHandler::AcceptHandler(int fd, Worker *worker)
+    : conn_hnr_(nullptr), worker_(worker), loop_(worker->get_loop()),
+      fd_(fd) {
+  ev_io_init(&wev_, acceptcb, fd_, EV_READ);
+  wev_.data = this;
+  ev_io_start(loop_, &wev_);
 }
 
 AcceptHandler::~AcceptHandler() {
-  ev_io_stop(conn_hnr_->get_loop(), &wev_);
+  ev_io_stop(loop_, &wev_);
   close(fd_);
 }
 
@@ -87,7 +96,11 @@ void AcceptHandler::accept_connection() {
       case ENFILE:
         LOG(WARN) << "acceptor: running out file descriptor; disable acceptor "
                      "temporarily";
-        conn_hnr_->disable_acceptor_temporary(30.);
+        if (worker_) {
+          worker_->disable_acceptor_temporary(30.);
+        } else {
+          conn_hnr_->disable_acceptor_temporary(30.);
+        }
         break;
       }
 
@@ -101,13 +114,17 @@ void AcceptHandler::accept_connection() {
 
     util::make_socket_nodelay(cfd);
 
-    conn_hnr_->handle_connection(cfd, &sockaddr.sa, addrlen);
+    if (worker_) {
+      worker_->handle_connection(cfd, &sockaddr.sa, addrlen);
+    } else {
+      conn_hnr_->handle_connection(cfd, &sockaddr.sa, addrlen);
+    }
   }
 }
 
-void AcceptHandler::enable() { ev_io_start(conn_hnr_->get_loop(), &wev_); }
+void AcceptHandler::enable() { ev_io_start(loop_, &wev_); }
 
-void AcceptHandler::disable() { ev_io_stop(conn_hnr_->get_loop(), &wev_); }
+void AcceptHandler::disable() { ev_io_stop(loop_, &wev_); }
 
 int AcceptHandler::get_fd() const { return fd_; }
 
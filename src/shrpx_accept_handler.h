@@ -32,10 +32,15 @@
 namespace shrpx {
 
 class ConnectionHandler;
+class Worker;
 
 class AcceptHandler {
 public:
   AcceptHandler(int fd, ConnectionHandler *h);
+  // Creates AcceptHandler which accepts connections in the event loop
+  // of |worker|, and passes them to |worker| directly.  This is used
+  // when each worker has its own listening socket.
+  AcceptHandler(int fd, Worker *worker);
   ~AcceptHandler();
   void accept_connection();
   void enable();
@@ -45,6 +50,9 @@ public:
 private:
   ev_io wev_;
   ConnectionHandler *conn_hnr_;
+  // Not nullptr if this object belongs to worker.
+  Worker *worker_;
+  struct ev_loop *loop_;
   int fd_;
 };
 
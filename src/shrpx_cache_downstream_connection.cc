@@ -0,0 +1,193 @@
+/*
+ * nghttp2 - HTTP/2 C Library
+ *
+ * Copyright (c) 2015 Tatsuhiro Tsujikawa
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "shrpx_cache_downstream_connection.h"
+
+#include "shrpx_client_handler.h"
+#include "shrpx_upstream.h"
+#include "shrpx_downstream.h"
+#include "shrpx_response_cache.h"
+#include "shrpx_log.h"
+#include "util.h"
+
+using namespace nghttp2;
+
+namespace shrpx {
+
+namespace {
+void readcb(struct ev_loop *loop, ev_timer *w, int revents) {
+  auto dconn = static_cast<CacheDownstreamConnection *>(w->data);
+  auto downstream = dconn->get_downstream();
+  auto upstream = downstream->get_upstream();
+  auto handler = upstream->get_client_handler();
+
+  if (upstream->downstream_read(dconn) != 0) {
+    delete handler;
+  }
+}
+} // namespace
+
+CacheDownstreamConnection::CacheDownstreamConnection(
+    std::shared_ptr<const CacheEntry> ent, struct ev_loop *loop)
+    : DownstreamConnection(nullptr), ent_(std::move(ent)), loop_(loop),
+      chunk_idx_(0), header_sent_(false) {
+  ev_timer_init(&rt_, readcb, 0., 0.);
+  rt_.data = this;
+}
+
+CacheDownstreamConnection::~CacheDownstreamConnection() {
+  ev_timer_stop(loop_, &rt_);
+
+  // Downstream and DownstreamConnection may be deleted
+  // asynchronously.
+  if (downstream_) {
+    downstream_->release_downstream_connection();
+  }
+}
+
+int CacheDownstreamConnection::attach_downstream(Downstream *downstream) {
+  if (LOG_ENABLED(INFO)) {
+    DCLOG(INFO, this) << "Attaching to DOWNSTREAM:" << downstream
+                      << ", serving from cache";
+  }
+
+  downstream_ = downstream;
+
+  return 0;
+}
+
+void CacheDownstreamConnection::detach_downstream(Downstream *downstream) {
+  if (LOG_ENABLED(INFO)) {
+    DCLOG(INFO, this) << "Detaching from DOWNSTREAM:" << downstream;
+  }
+
+  ev_timer_stop(loop_, &rt_);
+
+  downstream_ = nullptr;
+}
+
+int CacheDownstreamConnection::push_request_headers() {
+  // We only serve the request without request body, so the response
+  // can be sent right away.
+  signal_read();
+
+  return 0;
+}
+
+int CacheDownstreamConnection::push_upload_data_chunk(const uint8_t *data,
+                                                      size_t datalen) {
+  return 0;
+}
+
+int CacheDownstreamConnection::end_upload_data() { return 0; }
+
+int CacheDownstreamConnection::resume_read(IOCtrlReason reason,
+                                           size_t consumed) {
+  if (!downstream_->response_buf_full()) {
+    signal_read();
+  }
+
+  return 0;
+}
+
+void CacheDownstreamConnection::force_resume_read() { signal_read(); }
+
+void CacheDownstreamConnection::signal_read() { ev_timer_start(loop_, &rt_); }
+
+int CacheDownstreamConnection::send_header() {
+  auto upstream = downstream_->get_upstream();
+  auto not_modified = check_not_modified(*ent_, downstream_);
+
+  downstream_->set_response_http_status(not_modified ? 304 : ent_->status);
+  downstream_->set_response_major(1);
+  downstream_->set_response_minor(1);
+
+  for (auto &kv : ent_->headers) {
+    downstream_->add_response_header(kv.name, kv.value);
+  }
+
+  if (!not_modified) {
+    downstream_->add_response_header("content-length",
+                                     util::utos(ent_->bodylen));
+  }
+
+  auto age = get_current_age(*ent_, ev_now(loop_));
+  downstream_->add_response_header("age",
+                                   util::utos(static_cast<int64_t>(age)));
+
+  if (downstream_->index_response_headers() != 0) {
+    return -1;
+  }
+
+  downstream_->set_response_state(Downstream::HEADER_COMPLETE);
+  downstream_->inspect_http1_response();
+
+  return upstream->on_downstream_header_complete(downstream_);
+}
+
+int CacheDownstreamConnection::on_read() {
+  int rv;
+
+  if (downstream_->get_response_state() == Downstream::MSG_COMPLETE) {
+    return 0;
+  }
+
+  auto upstream = downstream_->get_upstream();
+
+  if (!header_sent_) {
+    header_sent_ = true;
+
+    if (send_header() != 0) {
+      return -1;
+    }
+
+    // HEAD response and 304 do not have body.
+    if (!downstream_->expect_response_body()) {
+      chunk_idx_ = ent_->body.size();
+    }
+  }
+
+  for (; chunk_idx_ < ent_->body.size(); ++chunk_idx_) {
+    if (downstream_->response_buf_full()) {
+      // resume_read() will be called when upstream drains the
+      // buffer.
+      return 0;
+    }
+
+    auto &m = ent_->body[chunk_idx_];
+
+    downstream_->add_response_bodylen(m->len());
+
+    rv = upstream->on_downstream_body(downstream_, m->pos, m->len(), true);
+    if (rv != 0) {
+      return -1;
+    }
+  }
+
+  downstream_->set_response_state(Downstream::MSG_COMPLETE);
+
+  return upstream->on_downstream_body_complete(downstream_);
+}
+
+} // namespace shrpx
@@ -0,0 +1,85 @@
+/*
+ * nghttp2 - HTTP/2 C Library
+ *
+ * Copyright (c) 2015 Tatsuhiro Tsujikawa
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef SHRPX_CACHE_DOWNSTREAM_CONNECTION_H
+#define SHRPX_CACHE_DOWNSTREAM_CONNECTION_H
+
+#include "shrpx.h"
+
+#include <memory>
+
+#include <ev.h>
+
+#include "shrpx_downstream_connection.h"
+
+namespace shrpx {
+
+struct CacheEntry;
+
+// CacheDownstreamConnection serves the response stored in
+// ResponseCache.  It behaves like HTTP/1.1 backend, so that upstream
+// does not have to know where the response comes from.
+class CacheDownstreamConnection : public DownstreamConnection {
+public:
+  CacheDownstreamConnection(std::shared_ptr<const CacheEntry> ent,
+                            struct ev_loop *loop);
+  virtual ~CacheDownstreamConnection();
+  virtual int attach_downstream(Downstream *downstream);
+  virtual void detach_downstream(Downstream *downstream);
+
+  virtual int push_request_headers();
+  virtual int push_upload_data_chunk(const uint8_t *data, size_t datalen);
+  virtual int end_upload_data();
+
+  virtual void pause_read(IOCtrlReason reason) {}
+  virtual int resume_read(IOCtrlReason reason, size_t consumed);
+  virtual void force_resume_read();
+
+  virtual int on_read();
+  virtual int on_write() { return 0; }
+
+  virtual void on_upstream_change(Upstream *upstream) {}
+  virtual int on_priority_change(int32_t pri) { return 0; }
+
+  virtual bool poolable() const { return false; }
+  virtual size_t get_addr_idx() const { return 0; }
+
+private:
+  int send_header();
+  // Schedules on_read() in the next event loop iteration.
+  void signal_read();
+
+  // Keeps the entry alive even if it is evicted while we are sending
+  // it.
+  std::shared_ptr<const CacheEntry> ent_;
+  ev_timer rt_;
+  struct ev_loop *loop_;
+  // The index of CacheEntry::body to send next.
+  size_t chunk_idx_;
+  bool header_sent_;
+};
+
+} // namespace shrpx
+
+#endif // SHRPX_CACHE_DOWNSTREAM_CONNECTION_H
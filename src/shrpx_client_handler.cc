@@ -28,6 +28,7 @@
 #include <unistd.h>
 #endif // HAVE_UNISTD_H
 #include <cerrno>
+#include <algorithm>
 
 #include "shrpx_upstream.h"
 #include "shrpx_http2_upstream.h"
@@ -35,6 +36,8 @@
 #include "shrpx_config.h"
 #include "shrpx_http_downstream_connection.h"
 #include "shrpx_http2_downstream_connection.h"
+#include "shrpx_cache_downstream_connection.h"
+#include "shrpx_response_cache.h"
 #include "shrpx_ssl.h"
 #include "shrpx_worker.h"
 #include "shrpx_downstream_connection_pool.h"
@@ -361,7 +364,6 @@ ClientHandler::ClientHandler(Worker *worker, int fd, SSL *ssl,
             get_config()->write_burst, get_config()->read_rate,
             get_config()->read_burst, writecb, readcb, timeoutcb, this),
       ipaddr_(ipaddr), port_(port), worker_(worker),
-      http2session_(worker_->next_http2_session()),
       left_connhd_len_(NGHTTP2_CLIENT_MAGIC_LEN),
       should_close_after_write_(false) {
 
@@ -591,7 +593,7 @@ void ClientHandler::pool_downstream_connection(
     CLOG(INFO, this) << "Pooling downstream connection DCONN:" << dconn.get();
   }
   dconn->set_client_handler(nullptr);
-  auto dconn_pool = worker_->get_dconn_pool();
+  auto dconn_pool = dconn->get_dconn_pool();
   dconn_pool->add_downstream_connection(std::move(dconn));
 }
 
@@ -600,14 +602,94 @@ void ClientHandler::remove_downstream_connection(DownstreamConnection *dconn) {
     CLOG(INFO, this) << "Removing downstream connection DCONN:" << dconn
                      << " from pool";
   }
-  auto dconn_pool = worker_->get_dconn_pool();
+  auto dconn_pool = dconn->get_dconn_pool();
   dconn_pool->remove_downstream_connection(dconn);
 }
 
+namespace {
+// Returns the index of Config::downstream_addr_groups which the
+// request |downstream| is routed to.
+size_t match_downstream_addr_group(Downstream *downstream) {
+  const char *host = "";
+  size_t hostlen = 0;
+
+  auto &authority = downstream->get_request_http2_authority();
+  if (!authority.empty()) {
+    host = authority.c_str();
+    hostlen = authority.size();
+  } else {
+    auto h = downstream->get_request_header(http2::HD_HOST);
+    if (h) {
+      host = h->value.c_str();
+      hostlen = h->value.size();
+    }
+  }
+
+  auto &path = downstream->get_request_path();
+  const char *p = "/";
+  size_t plen = 1;
+
+  // CONNECT and OPTIONS * do not have path.  Match them against
+  // "/".
+  if (!path.empty() && path[0] == '/') {
+    p = path.c_str();
+    // Query and fragment are not used for matching.
+    plen = std::find_if(std::begin(path), std::end(path),
+                        [](char c) { return c == '?' || c == '#'; }) -
+           std::begin(path);
+  }
+
+  auto group = get_config()->router.match(host, hostlen, p, plen);
+  if (group == -1) {
+    return get_config()->downstream_addr_group_catch_all;
+  }
+
+  return group;
+}
+} // namespace
+
 std::unique_ptr<DownstreamConnection>
-ClientHandler::get_downstream_connection() {
-  auto dconn_pool = worker_->get_dconn_pool();
-  auto dconn = dconn_pool->pop_downstream_connection();
+ClientHandler::get_downstream_connection(Downstream *downstream) {
+  size_t group = 0;
+
+  if (get_config()->downstream_addr_groups.size() > 1) {
+    group = match_downstream_addr_group(downstream);
+  }
+
+  downstream->set_downstream_addr_group(group);
+
+  if (LOG_ENABLED(INFO)) {
+    CLOG(INFO, this) << "Downstream address group: " << group;
+  }
+
+  auto cache = worker_->get_response_cache();
+  if (cache) {
+    auto ent = cache->lookup(downstream);
+    if (ent) {
+      if (LOG_ENABLED(INFO)) {
+        CLOG(INFO, this) << "Serving response from cache";
+      }
+
+      auto dconn =
+          make_unique<CacheDownstreamConnection>(std::move(ent), conn_.loop);
+      dconn->set_client_handler(this);
+      return std::move(dconn);
+    }
+  }
+
+  auto dconn_pool = worker_->get_dconn_pool(group);
+
+  if (get_config()->downstream_proto == PROTO_HTTP2) {
+    auto http2session = worker_->next_http2_session(group);
+    auto dconn =
+        make_unique<Http2DownstreamConnection>(dconn_pool, http2session);
+    dconn->set_client_handler(this);
+    return std::move(dconn);
+  }
+
+  auto addr_idx = worker_->get_addr_balancer(group)->select();
+
+  auto dconn = dconn_pool->pop_downstream_connection(addr_idx);
 
   if (!dconn) {
     if (LOG_ENABLED(INFO)) {
@@ -615,13 +697,8 @@ ClientHandler::get_downstream_connection() {
                        << " Create new one";
     }
 
-    auto dconn_pool = worker_->get_dconn_pool();
-
-    if (http2session_) {
-      dconn = make_unique<Http2DownstreamConnection>(dconn_pool, http2session_);
-    } else {
-      dconn = make_unique<HttpDownstreamConnection>(dconn_pool, conn_.loop);
-    }
+    dconn = make_unique<HttpDownstreamConnection>(dconn_pool, group, addr_idx,
+                                                  conn_.loop);
     dconn->set_client_handler(this);
     return dconn;
   }
@@ -640,8 +717,9 @@ MemchunkPool *ClientHandler::get_mcpool() { return worker_->get_mcpool(); }
 
 SSL *ClientHandler::get_ssl() const { return conn_.tls.ssl; }
 
-ConnectBlocker *ClientHandler::get_connect_blocker() const {
-  return worker_->get_connect_blocker();
+ConnectBlocker *ClientHandler::get_connect_blocker(size_t group,
+                                                   size_t addr_idx) const {
+  return worker_->get_connect_blocker(group, addr_idx);
 }
 
 void ClientHandler::direct_http2_upgrade() {
@@ -43,6 +43,7 @@ using namespace nghttp2;
 namespace shrpx {
 
 class Upstream;
+class Downstream;
 class DownstreamConnection;
 class Http2Session;
 class HttpsUpstream;
@@ -92,10 +93,14 @@ public:
 
   void pool_downstream_connection(std::unique_ptr<DownstreamConnection> dconn);
   void remove_downstream_connection(DownstreamConnection *dconn);
-  std::unique_ptr<DownstreamConnection> get_downstream_connection();
+  // Returns DownstreamConnection to the backend address group which
+  // |downstream| is routed to.  The group is also set to
+  // |downstream|.
+  std::unique_ptr<DownstreamConnection>
+  get_downstream_connection(Downstream *downstream);
   MemchunkPool *get_mcpool();
   SSL *get_ssl() const;
-  ConnectBlocker *get_connect_blocker() const;
+  ConnectBlocker *get_connect_blocker(size_t group, size_t addr_idx) const;
   // Call this function when HTTP/2 connection header is received at
   // the start of the connection.
   void direct_http2_upgrade();
@@ -141,7 +146,6 @@ private:
   std::function<int(ClientHandler &)> read_, write_;
   std::function<int(ClientHandler &)> on_read_, on_write_;
   Worker *worker_;
-  Http2Session *http2session_;
   // The number of bytes of HTTP/2 client connection header to read
   size_t left_connhd_len_;
   bool should_close_after_write_;
@@ -46,6 +46,7 @@
 #include <cerrno>
 #include <limits>
 #include <fstream>
+#include <algorithm>
 
 #include <nghttp2/nghttp2.h>
 
@@ -383,6 +384,8 @@ std::vector<LogFragment> parse_log_format(const char *optarg) {
       type = SHRPX_LOGF_PID;
     } else if (util::strieq_l("$alpn", var_start, varlen)) {
       type = SHRPX_LOGF_ALPN;
+    } else if (util::strieq_l("$cache_status", var_start, varlen)) {
+      type = SHRPX_LOGF_CACHE_STATUS;
     } else {
       LOG(WARN) << "Unrecognized log format variable: "
                 << std::string(var_start, varlen);
@@ -432,32 +435,106 @@ int parse_duration(ev_tstamp *dest, const char *opt, const char *optarg) {
 }
 } // namespace
 
+namespace {
+// Adds |addr| to the groups of the patterns in |src|, which are
+// separated by ':'.  The group is created if it does not exist yet.
+int parse_mapping(const char *opt, const DownstreamAddr &addr,
+                  const char *src) {
+  auto &groups = mod_config()->downstream_addr_groups;
+
+  for (auto first = src;;) {
+    auto last = strchr(first, ':');
+    if (!last) {
+      last = first + strlen(first);
+    }
+
+    std::string pattern(first, last);
+
+    if (pattern.empty()) {
+      LOG(ERROR) << opt << ": empty pattern is not allowed";
+      return -1;
+    }
+
+    auto slash = pattern.find('/');
+    if (slash == std::string::npos) {
+      // Host alone matches all paths under the host.
+      pattern += '/';
+      slash = pattern.size() - 1;
+    }
+
+    // Host is matched case-insensitively.
+    std::transform(std::begin(pattern), std::begin(pattern) + slash,
+                   std::begin(pattern), util::lowcase);
+
+    auto g = std::find_if(std::begin(groups), std::end(groups),
+                          [&pattern](const DownstreamAddrGroup &g) {
+      return pattern == g.pattern.get();
+    });
+
+    if (g == std::end(groups)) {
+      DownstreamAddrGroup group;
+      group.pattern = strcopy(pattern);
+      groups.push_back(std::move(group));
+      g = std::end(groups) - 1;
+    }
+
+    DownstreamAddr a;
+    a.host = strcopy(addr.host.get());
+    a.port = addr.port;
+    a.host_unix = addr.host_unix;
+
+    g->addrs.push_back(std::move(a));
+
+    if (*last == '\0') {
+      break;
+    }
+
+    first = last + 1;
+  }
+
+  return 0;
+}
+} // namespace
+
 int parse_config(const char *opt, const char *optarg) {
   char host[NI_MAXHOST];
   uint16_t port;
   if (util::strieq(opt, SHRPX_OPT_BACKEND)) {
+    auto optarglen = strlen(optarg);
+    auto pat_delim = strchr(optarg, ';');
+    if (!pat_delim) {
+      pat_delim = optarg + optarglen;
+    }
+
+    DownstreamAddr addr;
+
     if (util::istartsWith(optarg, SHRPX_UNIX_PATH_PREFIX)) {
-      DownstreamAddr addr;
       auto path = optarg + str_size(SHRPX_UNIX_PATH_PREFIX);
-      addr.host = strcopy(path);
+      addr.host = strcopy(path, pat_delim - path);
       addr.host_unix = true;
+    } else {
+      std::string hostport(optarg, pat_delim);
 
-      mod_config()->downstream_addrs.push_back(std::move(addr));
+      if (split_host_port(host, sizeof(host), &port, hostport.c_str()) ==
+          -1) {
+        return -1;
+      }
 
-      return 0;
+      addr.host = strcopy(host);
+      addr.port = port;
     }
 
-    if (split_host_port(host, sizeof(host), &port, optarg) == -1) {
-      return -1;
+    auto mapping = pat_delim;
+    if (*mapping == ';') {
+      ++mapping;
     }
 
-    DownstreamAddr addr;
-    addr.host = strcopy(host);
-    addr.port = port;
-
-    mod_config()->downstream_addrs.push_back(std::move(addr));
+    if (*mapping == '\0') {
+      // No pattern means catch-all pattern
+      mapping = "/";
+    }
 
-    return 0;
+    return parse_mapping(opt, addr, mapping);
   }
 
   if (util::strieq(opt, SHRPX_OPT_FRONTEND)) {
@@ -1136,6 +1213,94 @@ int parse_config(const char *opt, const char *optarg) {
     return parse_uint(&mod_config()->max_header_fields, opt, optarg);
   }
 
+  if (util::strieq(opt, SHRPX_OPT_REUSEPORT)) {
+    mod_config()->reuseport = util::strieq(optarg, "yes");
+
+    return 0;
+  }
+
+  if (util::strieq(opt, SHRPX_OPT_BACKEND_BALANCE)) {
+    if (util::strieq(optarg, "round-robin")) {
+      mod_config()->backend_balance = BALANCE_ROUND_ROBIN;
+    } else if (util::strieq(optarg, "least-request")) {
+      mod_config()->backend_balance = BALANCE_LEAST_REQUEST;
+    } else if (util::strieq(optarg, "peak-ewma")) {
+      mod_config()->backend_balance = BALANCE_PEAK_EWMA;
+    } else if (util::strieq(optarg, "p2c")) {
+      mod_config()->backend_balance = BALANCE_P2C;
+    } else {
+      LOG(ERROR) << opt << ": Unknown balancing policy: " << optarg;
+      return -1;
+    }
+
+    return 0;
+  }
+
+  if (util::strieq(opt, SHRPX_OPT_BACKEND_HEALTH_CHECK_INTERVAL)) {
+    return parse_duration(&mod_config()->downstream_health_check_interval, opt,
+                          optarg);
+  }
+
+  if (util::strieq(opt, SHRPX_OPT_BACKEND_HEALTH_CHECK_TIMEOUT)) {
+    return parse_duration(&mod_config()->downstream_health_check_timeout, opt,
+                          optarg);
+  }
+
+  if (util::strieq(opt, SHRPX_OPT_BACKEND_HEALTH_CHECK_PATH)) {
+    if (optarg[0] != '/') {
+      LOG(ERROR) << opt << ": path must start with '/': " << optarg;
+      return -1;
+    }
+
+    mod_config()->downstream_health_check_path = strcopy(optarg);
+
+    return 0;
+  }
+
+  if (util::strieq(opt, SHRPX_OPT_BACKEND_HEALTH_CHECK_RISE)) {
+    size_t n;
+    if (parse_uint(&n, opt, optarg) != 0) {
+      return -1;
+    }
+
+    if (n == 0) {
+      LOG(ERROR) << opt << ": specify an integer strictly more than 0";
+
+      return -1;
+    }
+
+    mod_config()->downstream_health_check_rise = n;
+
+    return 0;
+  }
+
+  if (util::strieq(opt, SHRPX_OPT_BACKEND_HEALTH_CHECK_FALL)) {
+    size_t n;
+    if (parse_uint(&n, opt, optarg) != 0) {
+      return -1;
+    }
+
+    if (n == 0) {
+      LOG(ERROR) << opt << ": specify an integer strictly more than 0";
+
+      return -1;
+    }
+
+    mod_config()->downstream_health_check_fall = n;
+
+    return 0;
+  }
+
+  if (util::strieq(opt, SHRPX_OPT_RESPONSE_CACHE_SIZE)) {
+    return parse_uint_with_unit(&mod_config()->response_cache_size, opt,
+                                optarg);
+  }
+
+  if (util::strieq(opt, SHRPX_OPT_RESPONSE_CACHE_MAX_OBJECT_SIZE)) {
+    return parse_uint_with_unit(&mod_config()->response_cache_max_object_size,
+                                opt, optarg);
+  }
+
   if (util::strieq(opt, "conf")) {
     LOG(WARN) << "conf: ignored";
 
@@ -1306,4 +1471,37 @@ int int_syslog_facility(const char *strfacility) {
   return -1;
 }
 
+std::vector<int> parse_env_fds(const char *s) {
+  std::vector<int> fds;
+
+  for (;;) {
+    auto end = strchr(s, ',');
+    auto fd = util::parse_uint(reinterpret_cast<const uint8_t *>(s),
+                               end ? end - s : strlen(s));
+    if (fd == -1 || fd > std::numeric_limits<int>::max()) {
+      return {};
+    }
+
+    fds.push_back(fd);
+
+    if (!end) {
+      return fds;
+    }
+
+    s = end + 1;
+  }
+}
+
+std::string make_env_fds(const char *envname, const std::vector<int> &fds) {
+  std::string res = envname;
+  res += "=";
+  for (size_t i = 0; i < fds.size(); ++i) {
+    if (i > 0) {
+      res += ",";
+    }
+    res += util::utos(fds[i]);
+  }
+  return res;
+}
+
 } // namespace shrpx
@@ -49,6 +49,8 @@
 
 #include <nghttp2/nghttp2.h>
 
+#include "shrpx_router.h"
+
 namespace shrpx {
 
 struct LogFragment;
@@ -165,6 +167,21 @@ constexpr char SHRPX_OPT_OCSP_UPDATE_INTERVAL[] = "ocsp-update-interval";
 constexpr char SHRPX_OPT_NO_OCSP[] = "no-ocsp";
 constexpr char SHRPX_OPT_HEADER_FIELD_BUFFER[] = "header-field-buffer";
 constexpr char SHRPX_OPT_MAX_HEADER_FIELDS[] = "max-header-fields";
+constexpr char SHRPX_OPT_REUSEPORT[] = "reuseport";
+constexpr char SHRPX_OPT_BACKEND_BALANCE[] = "backend-balance";
+constexpr char SHRPX_OPT_BACKEND_HEALTH_CHECK_INTERVAL[] =
+    "backend-health-check-interval";
+constexpr char SHRPX_OPT_BACKEND_HEALTH_CHECK_TIMEOUT[] =
+    "backend-health-check-timeout";
+constexpr char SHRPX_OPT_BACKEND_HEALTH_CHECK_PATH[] =
+    "backend-health-check-path";
+constexpr char SHRPX_OPT_BACKEND_HEALTH_CHECK_RISE[] =
+    "backend-health-check-rise";
+constexpr char SHRPX_OPT_BACKEND_HEALTH_CHECK_FALL[] =
+    "backend-health-check-fall";
+constexpr char SHRPX_OPT_RESPONSE_CACHE_SIZE[] = "response-cache-size";
+constexpr char SHRPX_OPT_RESPONSE_CACHE_MAX_OBJECT_SIZE[] =
+    "response-cache-max-object-size";
 
 union sockaddr_union {
   sockaddr_storage storage;
@@ -176,6 +193,13 @@ union sockaddr_union {
 
 enum shrpx_proto { PROTO_HTTP2, PROTO_HTTP };
 
+enum shrpx_balance {
+  BALANCE_ROUND_ROBIN,
+  BALANCE_LEAST_REQUEST,
+  BALANCE_PEAK_EWMA,
+  BALANCE_P2C
+};
+
 struct AltSvc {
   AltSvc()
       : protocol_id(nullptr), host(nullptr), origin(nullptr),
@@ -206,6 +230,13 @@ struct DownstreamAddr {
   bool host_unix;
 };
 
+// A group of backend addresses which the requests matching |pattern|
+// are routed to.
+struct DownstreamAddrGroup {
+  std::unique_ptr<char[]> pattern;
+  std::vector<DownstreamAddr> addrs;
+};
+
 struct TicketKey {
   uint8_t name[16];
   uint8_t aes_key[16];
@@ -225,7 +256,9 @@ struct Config {
   std::vector<std::pair<std::string, std::string>> add_response_headers;
   std::vector<unsigned char> alpn_prefs;
   std::vector<LogFragment> accesslog_format;
-  std::vector<DownstreamAddr> downstream_addrs;
+  std::vector<DownstreamAddrGroup> downstream_addr_groups;
+  // Router built from the patterns of |downstream_addr_groups|.
+  Router router;
   std::vector<std::string> tls_ticket_key_files;
   // binary form of http proxy host and port
   sockaddr_union downstream_http_proxy_addr;
@@ -239,6 +272,9 @@ struct Config {
   ev_tstamp downstream_idle_read_timeout;
   ev_tstamp listener_disable_timeout;
   ev_tstamp ocsp_update_interval;
+  // interval of backend health check.  0 disables health check.
+  ev_tstamp downstream_health_check_interval;
+  ev_tstamp downstream_health_check_timeout;
   // address of frontend connection.  This could be a path to UNIX
   // domain socket.  In this case, |host_unix| must be true.
   std::unique_ptr<char[]> host;
@@ -248,6 +284,9 @@ struct Config {
   std::unique_ptr<char[]> dh_param_file;
   const char *server_name;
   std::unique_ptr<char[]> backend_tls_sni_name;
+  // path to request in backend health check.  If nullptr, health
+  // check only makes TCP connection.
+  std::unique_ptr<char[]> downstream_health_check_path;
   std::unique_ptr<char[]> pid_file;
   std::unique_ptr<char[]> conf_path;
   std::unique_ptr<char[]> ciphers;
@@ -292,6 +331,8 @@ struct Config {
   size_t http2_upstream_connection_window_bits;
   size_t http2_downstream_connection_window_bits;
   size_t http2_downstream_connections_per_worker;
+  // The index of downstream_addr_groups which has catch-all pattern.
+  size_t downstream_addr_group_catch_all;
   size_t downstream_connections_per_host;
   size_t downstream_connections_per_frontend;
   // actual size of downstream_http_proxy_addr
@@ -311,11 +352,22 @@ struct Config {
   size_t downstream_response_buffer_size;
   size_t header_field_buffer;
   size_t max_header_fields;
+  // the number of consecutive successful health checks to mark
+  // backend healthy, and the number of consecutive failures to mark
+  // it unhealthy.
+  size_t downstream_health_check_rise;
+  size_t downstream_health_check_fall;
+  // The maximum total size of response cache per worker.  0 means
+  // that cache is disabled.
+  size_t response_cache_size;
+  size_t response_cache_max_object_size;
   // Bit mask to disable SSL/TLS protocol versions.  This will be
   // passed to SSL_CTX_set_options().
   long int tls_proto_mask;
   // downstream protocol; this will be determined by given options.
   shrpx_proto downstream_proto;
+  // policy to choose backend address and HTTP/2 backend session
+  shrpx_balance backend_balance;
   int syslog_facility;
   int backlog;
   int argc;
@@ -357,6 +409,9 @@ struct Config {
   // true if host contains UNIX domain socket path
   bool host_unix;
   bool no_ocsp;
+  // true if each worker has its own listening socket, and accepts
+  // connections directly.
+  bool reuseport;
 };
 
 const Config *get_config();
@@ -423,6 +478,16 @@ FILE *open_file_for_write(const char *filename);
 std::unique_ptr<TicketKeys>
 read_tls_ticket_key_file(const std::vector<std::string> &files);
 
+// Parses comma separated list of file descriptors in |s|, which the
+// old binary passes in environment variable on binary upgrade.  There
+// is more than one file descriptor per address if --reuseport is
+// used.  This function returns empty list if |s| is malformed.
+std::vector<int> parse_env_fds(const char *s);
+
+// Returns "|envname|=FD[,FD...]" for |fds|, which parse_env_fds()
+// parses back.
+std::string make_env_fds(const char *envname, const std::vector<int> &fds);
+
 } // namespace shrpx
 
 #endif // SHRPX_CONFIG_H
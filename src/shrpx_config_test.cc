@@ -33,6 +33,9 @@
 #include <CUnit/CUnit.h>
 
 #include "shrpx_config.h"
+#include "template.h"
+
+using namespace nghttp2;
 
 namespace shrpx {
 
@@ -172,4 +175,32 @@ void test_shrpx_config_read_tls_ticket_key_file(void) {
             memcmp("a..............b", key->hmac_key, sizeof(key->hmac_key)));
 }
 
+void test_shrpx_config_parse_env_fds(void) {
+  auto env = make_env_fds("NGHTTPX_LISTENER4_FD", {3, 4, 10});
+
+  CU_ASSERT("NGHTTPX_LISTENER4_FD=3,4,10" == env);
+  CU_ASSERT((std::vector<int>{3, 4, 10}) ==
+            parse_env_fds(env.c_str() + str_size("NGHTTPX_LISTENER4_FD=")));
+
+  env = make_env_fds("NGHTTPX_LISTENER4_FD", {7});
+
+  CU_ASSERT("NGHTTPX_LISTENER4_FD=7" == env);
+  CU_ASSERT(std::vector<int>{7} ==
+            parse_env_fds(env.c_str() + str_size("NGHTTPX_LISTENER4_FD=")));
+
+  env = make_env_fds("NGHTTPX_LISTENER4_FD", {});
+
+  CU_ASSERT("NGHTTPX_LISTENER4_FD=" == env);
+  CU_ASSERT(parse_env_fds("").empty());
+
+  // Malformed list is rejected as a whole.
+  CU_ASSERT(parse_env_fds("3,").empty());
+  CU_ASSERT(parse_env_fds(",3").empty());
+  CU_ASSERT(parse_env_fds("3,,4").empty());
+  CU_ASSERT(parse_env_fds("3,x").empty());
+  CU_ASSERT(parse_env_fds("3 ,4").empty());
+  CU_ASSERT(parse_env_fds("-1").empty());
+  CU_ASSERT(parse_env_fds("4294967296").empty());
+}
+
 } // namespace shrpx
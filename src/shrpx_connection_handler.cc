@@ -182,6 +182,14 @@ void ConnectionHandler::create_worker_thread(size_t num) {
 
     auto worker = make_unique<Worker>(loop, sv_ssl_ctx, cl_ssl_ctx, cert_tree,
                                       ticket_keys_);
+
+    for (auto fds : {&worker_listener_fds_, &worker_listener_fds6_}) {
+      for (size_t j = i; j < fds->size(); j += num) {
+        worker->add_acceptor(
+            make_unique<AcceptHandler>((*fds)[j], worker.get()));
+      }
+    }
+
     worker->run_async();
     workers_.push_back(std::move(worker));
 
@@ -302,6 +310,20 @@ AcceptHandler *ConnectionHandler::get_acceptor6() const {
   return acceptor6_.get();
 }
 
+void ConnectionHandler::set_worker_listener_fds(std::vector<int> fds,
+                                                std::vector<int> fds6) {
+  worker_listener_fds_ = std::move(fds);
+  worker_listener_fds6_ = std::move(fds6);
+}
+
+const std::vector<int> &ConnectionHandler::get_worker_listener_fds() const {
+  return worker_listener_fds_;
+}
+
+const std::vector<int> &ConnectionHandler::get_worker_listener_fds6() const {
+  return worker_listener_fds6_;
+}
+
 void ConnectionHandler::enable_acceptor() {
   if (acceptor_) {
     acceptor_->enable();
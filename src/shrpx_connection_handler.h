@@ -86,6 +86,14 @@ public:
   AcceptHandler *get_acceptor() const;
   void set_acceptor6(std::unique_ptr<AcceptHandler> h);
   AcceptHandler *get_acceptor6() const;
+  // Sets listening sockets which workers accept connections from
+  // directly.  This is used when --reuseport is given.  |fds| are
+  // for IPv4 address or UNIX domain socket, and |fds6| are for IPv6
+  // address.  They are distributed among workers in
+  // create_worker_thread(), and each worker owns its share of them.
+  void set_worker_listener_fds(std::vector<int> fds, std::vector<int> fds6);
+  const std::vector<int> &get_worker_listener_fds() const;
+  const std::vector<int> &get_worker_listener_fds6() const;
   void enable_acceptor();
   void disable_acceptor();
   void disable_acceptor_temporary(ev_tstamp t);
@@ -128,6 +136,11 @@ private:
   std::unique_ptr<AcceptHandler> acceptor_;
   // acceptor for IPv6 address
   std::unique_ptr<AcceptHandler> acceptor6_;
+  // listening sockets for workers for IPv4 address or UNIX domain
+  // socket.
+  std::vector<int> worker_listener_fds_;
+  // listening sockets for workers for IPv6 address
+  std::vector<int> worker_listener_fds6_;
   ev_timer disable_acceptor_timer_;
   ev_timer ocsp_timer_;
   unsigned int worker_round_robin_cnt_;
@@ -34,6 +34,7 @@
 #include "shrpx_error.h"
 #include "shrpx_downstream_connection.h"
 #include "shrpx_downstream_queue.h"
+#include "shrpx_response_cache.h"
 #include "util.h"
 #include "http2.h"
 
@@ -113,14 +114,16 @@ Downstream::Downstream(Upstream *upstream, MemchunkPool *mcpool,
       request_buf_(mcpool), response_buf_(mcpool), request_bodylen_(0),
       response_bodylen_(0), response_sent_bodylen_(0),
       request_content_length_(-1), response_content_length_(-1),
-      upstream_(upstream), blocked_link_(nullptr), request_headers_sum_(0),
+      upstream_(upstream), blocked_link_(nullptr), response_cache_(nullptr),
+      request_headers_sum_(0),
       response_headers_sum_(0), request_datalen_(0), response_datalen_(0),
-      num_retry_(0), stream_id_(stream_id), priority_(priority),
-      downstream_stream_id_(-1),
+      num_retry_(0), downstream_addr_group_(0), stream_id_(stream_id),
+      priority_(priority), downstream_stream_id_(-1),
       response_rst_stream_error_code_(NGHTTP2_NO_ERROR), request_method_(-1),
       request_state_(INITIAL), request_major_(1), request_minor_(1),
       response_state_(INITIAL), response_http_status_(0), response_major_(1),
       response_minor_(1), dispatch_state_(DISPATCH_NONE),
+      cache_status_(CACHE_NONE),
       upgrade_request_(false), upgraded_(false), http2_upgrade_seen_(false),
       chunked_request_(false), request_connection_close_(false),
       request_header_key_prev_(false), request_trailer_key_prev_(false),
@@ -201,6 +204,55 @@ DownstreamConnection *Downstream::get_downstream_connection() {
   return dconn_.get();
 }
 
+void Downstream::set_downstream_addr_group(size_t group) {
+  downstream_addr_group_ = group;
+}
+
+size_t Downstream::get_downstream_addr_group() const {
+  return downstream_addr_group_;
+}
+
+void Downstream::set_response_cache(ResponseCache *cache) {
+  response_cache_ = cache;
+  cache_entry_.reset();
+}
+
+void Downstream::add_response_cache_data(const uint8_t *data, size_t len) {
+  if (!response_cache_) {
+    return;
+  }
+
+  if (!cache_entry_) {
+    cache_entry_ = response_cache_->create_entry(this);
+  }
+
+  if (!cache_entry_ ||
+      response_cache_->append_body(cache_entry_.get(), data, len) != 0) {
+    // The response is not stored.
+    set_response_cache(nullptr);
+  }
+}
+
+void Downstream::store_response_cache() {
+  if (!response_cache_) {
+    return;
+  }
+
+  if (!cache_entry_) {
+    cache_entry_ = response_cache_->create_entry(this);
+  }
+
+  if (cache_entry_ && validate_response_bodylen()) {
+    response_cache_->store(std::move(cache_entry_));
+  }
+
+  set_response_cache(nullptr);
+}
+
+void Downstream::set_cache_status(int status) { cache_status_ = status; }
+
+int Downstream::get_cache_status() const { return cache_status_; }
+
 std::unique_ptr<DownstreamConnection> Downstream::pop_downstream_connection() {
   return std::unique_ptr<DownstreamConnection>(dconn_.release());
 }
@@ -48,6 +48,8 @@ namespace shrpx {
 class Upstream;
 class DownstreamConnection;
 struct BlockedLink;
+class ResponseCache;
+struct CacheEntry;
 
 class Downstream {
 public:
@@ -74,6 +76,22 @@ public:
   DownstreamConnection *get_downstream_connection();
   // Returns dconn_ and nullifies dconn_.
   std::unique_ptr<DownstreamConnection> pop_downstream_connection();
+  // Sets the index of Config::downstream_addr_groups which this
+  // request is routed to.
+  void set_downstream_addr_group(size_t group);
+  size_t get_downstream_addr_group() const;
+  // Tells that the response may be stored in |cache|.  Pass nullptr
+  // to stop capturing response.
+  void set_response_cache(ResponseCache *cache);
+  // Appends response body |data| of length |len| to the response
+  // being captured for cache.
+  void add_response_cache_data(const uint8_t *data, size_t len);
+  // Stores the captured response to cache.  Call this function when
+  // response is completely received.
+  void store_response_cache();
+  // CacheStatus
+  void set_cache_status(int status);
+  int get_cache_status() const;
 
   // Returns true if output buffer is full. If underlying dconn_ is
   // NULL, this function always returns false.
@@ -393,10 +411,16 @@ private:
 
   Upstream *upstream_;
   std::unique_ptr<DownstreamConnection> dconn_;
+  // The response being captured for cache.  This is created lazily
+  // when response body arrives.
+  std::unique_ptr<CacheEntry> cache_entry_;
 
   // only used by HTTP/2 or SPDY upstream
   BlockedLink *blocked_link_;
 
+  // Not nullptr if the response may be stored to this cache.
+  ResponseCache *response_cache_;
+
   size_t request_headers_sum_;
   size_t response_headers_sum_;
 
@@ -406,6 +430,9 @@ private:
 
   size_t num_retry_;
 
+  // index of Config::downstream_addr_groups
+  size_t downstream_addr_group_;
+
   int32_t stream_id_;
   int32_t priority_;
   // stream ID in backend connection
@@ -427,6 +454,9 @@ private:
   // only used by HTTP/2 or SPDY upstream
   int dispatch_state_;
 
+  // CacheStatus
+  int cache_status_;
+
   http2::HeaderIndex request_hdidx_;
   http2::HeaderIndex response_hdidx_;
 
@@ -60,6 +60,9 @@ public:
 
   // true if this object is poolable.
   virtual bool poolable() const = 0;
+  // Returns the index of DownstreamAddrGroup::addrs this object
+  // connects to.
+  virtual size_t get_addr_idx() const = 0;
 
   void set_client_handler(ClientHandler *client_handler);
   ClientHandler *get_client_handler();
@@ -30,30 +30,38 @@ namespace shrpx {
 DownstreamConnectionPool::DownstreamConnectionPool() {}
 
 DownstreamConnectionPool::~DownstreamConnectionPool() {
-  for (auto dconn : pool_) {
-    delete dconn;
+  for (auto &pool : pools_) {
+    for (auto dconn : pool) {
+      delete dconn;
+    }
   }
 }
 
 void DownstreamConnectionPool::add_downstream_connection(
     std::unique_ptr<DownstreamConnection> dconn) {
-  pool_.insert(dconn.release());
+  auto addr_idx = dconn->get_addr_idx();
+  if (pools_.size() <= addr_idx) {
+    pools_.resize(addr_idx + 1);
+  }
+  pools_[addr_idx].insert(dconn.release());
 }
 
 std::unique_ptr<DownstreamConnection>
-DownstreamConnectionPool::pop_downstream_connection() {
-  if (pool_.empty()) {
+DownstreamConnectionPool::pop_downstream_connection(size_t addr_idx) {
+  if (pools_.size() <= addr_idx || pools_[addr_idx].empty()) {
     return nullptr;
   }
 
-  auto dconn = std::unique_ptr<DownstreamConnection>(*std::begin(pool_));
-  pool_.erase(std::begin(pool_));
+  auto &pool = pools_[addr_idx];
+
+  auto dconn = std::unique_ptr<DownstreamConnection>(*std::begin(pool));
+  pool.erase(std::begin(pool));
   return dconn;
 }
 
 void DownstreamConnectionPool::remove_downstream_connection(
     DownstreamConnection *dconn) {
-  pool_.erase(dconn);
+  pools_[dconn->get_addr_idx()].erase(dconn);
   delete dconn;
 }
 
@@ -29,6 +29,7 @@
 
 #include <memory>
 #include <set>
+#include <vector>
 
 namespace shrpx {
 
@@ -40,11 +41,16 @@ public:
   ~DownstreamConnectionPool();
 
   void add_downstream_connection(std::unique_ptr<DownstreamConnection> dconn);
-  std::unique_ptr<DownstreamConnection> pop_downstream_connection();
+  // Removes idle connection to backend |addr_idx| from the pool, and
+  // returns it.  Returns nullptr if there is no such connection.
+  std::unique_ptr<DownstreamConnection>
+  pop_downstream_connection(size_t addr_idx);
   void remove_downstream_connection(DownstreamConnection *dconn);
 
 private:
-  std::set<DownstreamConnection *> pool_;
+  // Idle connections indexed by DownstreamAddrGroup::addrs index.
+  // Each backend address group has its own pool.
+  std::vector<std::set<DownstreamConnection *>> pools_;
 };
 
 } // namespace shrpx
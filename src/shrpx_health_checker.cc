@@ -0,0 +1,640 @@
+/*
+ * nghttp2 - HTTP/2 C Library
+ *
+ * Copyright (c) 2014 Tatsuhiro Tsujikawa
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "shrpx_health_checker.h"
+
+#include <unistd.h>
+
+#include <vector>
+
+#include <openssl/err.h>
+
+#include "shrpx_config.h"
+#include "shrpx_error.h"
+#include "shrpx_load_balancer.h"
+#include "shrpx_log.h"
+#include "shrpx_ssl.h"
+#include "http2.h"
+#include "util.h"
+
+using namespace nghttp2;
+
+namespace shrpx {
+
+namespace {
+void interval_cb(struct ev_loop *loop, ev_timer *w, int revents) {
+  auto hc = static_cast<HealthChecker *>(w->data);
+
+  hc->start_probe();
+}
+} // namespace
+
+namespace {
+void probe_timeoutcb(struct ev_loop *loop, ev_timer *w, int revents) {
+  auto hc = static_cast<HealthChecker *>(w->data);
+
+  if (LOG_ENABLED(INFO)) {
+    LOG(INFO) << "Health check timeout";
+  }
+
+  hc->finish_probe(false);
+}
+} // namespace
+
+namespace {
+void timeoutcb(struct ev_loop *loop, ev_timer *w, int revents) {
+  auto conn = static_cast<Connection *>(w->data);
+  auto hc = static_cast<HealthChecker *>(conn->data);
+
+  hc->finish_probe(false);
+}
+} // namespace
+
+namespace {
+void handle_io_result(HealthChecker *hc, int rv) {
+  if (rv != 0) {
+    hc->finish_probe(false);
+    return;
+  }
+
+  if (hc->probe_done()) {
+    hc->finish_probe(hc->get_probe_state() == HealthChecker::PROBE_SUCCESS);
+  }
+}
+} // namespace
+
+namespace {
+void readcb(struct ev_loop *loop, ev_io *w, int revents) {
+  auto conn = static_cast<Connection *>(w->data);
+  auto hc = static_cast<HealthChecker *>(conn->data);
+
+  auto rv = hc->do_read();
+  if (rv == 0 && !hc->probe_done()) {
+    rv = hc->do_write();
+  }
+
+  handle_io_result(hc, rv);
+}
+} // namespace
+
+namespace {
+void writecb(struct ev_loop *loop, ev_io *w, int revents) {
+  auto conn = static_cast<Connection *>(w->data);
+  auto hc = static_cast<HealthChecker *>(conn->data);
+
+  handle_io_result(hc, hc->do_write());
+}
+} // namespace
+
+HealthChecker::HealthChecker(struct ev_loop *loop, SSL_CTX *ssl_ctx,
+                             LoadBalancer *lb, size_t group, size_t addr_idx)
+    : conn_(loop, -1, nullptr, get_config()->downstream_health_check_timeout,
+            get_config()->downstream_health_check_timeout, 0, 0, 0, 0, writecb,
+            readcb, timeoutcb, this),
+      lb_(lb), ssl_ctx_(ssl_ctx), session_(nullptr),
+      addr_(&get_config()->downstream_addr_groups[group].addrs[addr_idx]),
+      addr_idx_(addr_idx), num_success_(0), num_failure_(0),
+      probe_state_(PROBE_NONE), healthy_(true) {
+  read_ = write_ = &HealthChecker::noop;
+
+  ev_timer_init(&timer_, interval_cb, 0., 0.);
+  timer_.data = this;
+
+  ev_timer_init(&probe_timer_, probe_timeoutcb, 0.,
+                get_config()->downstream_health_check_timeout);
+  probe_timer_.data = this;
+
+  // The first probe is made just after the event loop starts.
+  ev_timer_start(conn_.loop, &timer_);
+}
+
+HealthChecker::~HealthChecker() {
+  ev_timer_stop(conn_.loop, &timer_);
+  ev_timer_stop(conn_.loop, &probe_timer_);
+
+  nghttp2_session_del(session_);
+}
+
+void HealthChecker::start_probe() {
+  auto &addr = *addr_;
+
+  probe_state_ = PROBE_RUNNING;
+
+  ev_timer_again(conn_.loop, &probe_timer_);
+
+  conn_.fd = util::create_nonblock_socket(addr.addr.storage.ss_family);
+  if (conn_.fd == -1) {
+    finish_probe(false);
+    return;
+  }
+
+  auto rv = connect(conn_.fd, &addr.addr.sa, addr.addrlen);
+  if (rv != 0 && errno != EINPROGRESS) {
+    finish_probe(false);
+    return;
+  }
+
+  ev_io_set(&conn_.rev, conn_.fd, EV_READ);
+  ev_io_set(&conn_.wev, conn_.fd, EV_WRITE);
+
+  read_ = &HealthChecker::noop;
+  write_ = &HealthChecker::connected;
+
+  conn_.wlimit.startw();
+}
+
+void HealthChecker::finish_probe(bool success) {
+  ev_timer_stop(conn_.loop, &probe_timer_);
+
+  nghttp2_session_del(session_);
+  session_ = nullptr;
+
+  htp_.reset();
+
+  rb_.reset();
+  wb_.reset();
+
+  conn_.disconnect();
+
+  read_ = write_ = &HealthChecker::noop;
+
+  probe_state_ = PROBE_NONE;
+
+  auto &addr = *addr_;
+  auto name = addr.host_unix ? addr.host.get() : addr.hostport.get();
+
+  if (success) {
+    num_failure_ = 0;
+    ++num_success_;
+
+    if (!healthy_ &&
+        num_success_ >= get_config()->downstream_health_check_rise) {
+      LOG(NOTICE) << "Backend " << name << " is healthy";
+
+      healthy_ = true;
+      lb_->set_healthy(addr_idx_, true);
+    }
+  } else {
+    num_success_ = 0;
+    ++num_failure_;
+
+    if (LOG_ENABLED(INFO)) {
+      LOG(INFO) << "Health check of backend " << name << " failed";
+    }
+
+    if (healthy_ &&
+        num_failure_ >= get_config()->downstream_health_check_fall) {
+      LOG(WARN) << "Backend " << name << " is unhealthy";
+
+      healthy_ = false;
+      lb_->set_healthy(addr_idx_, false);
+    }
+  }
+
+  ev_timer_set(&timer_, get_config()->downstream_health_check_interval, 0.);
+  ev_timer_start(conn_.loop, &timer_);
+}
+
+int HealthChecker::do_read() { return read_(*this); }
+
+int HealthChecker::do_write() { return write_(*this); }
+
+bool HealthChecker::probe_done() const {
+  return probe_state_ == PROBE_SUCCESS || probe_state_ == PROBE_FAILURE;
+}
+
+int HealthChecker::get_probe_state() const { return probe_state_; }
+
+int HealthChecker::noop() { return 0; }
+
+int HealthChecker::connected() {
+  if (!util::check_socket_connected(conn_.fd)) {
+    return -1;
+  }
+
+  conn_.wlimit.stopw();
+
+  if (!get_config()->downstream_health_check_path) {
+    probe_state_ = PROBE_SUCCESS;
+    return 0;
+  }
+
+  conn_.rlimit.startw();
+
+  if (ssl_ctx_) {
+    conn_.tls.ssl = SSL_new(ssl_ctx_);
+    if (!conn_.tls.ssl) {
+      LOG(ERROR) << "SSL_new() failed: "
+                 << ERR_error_string(ERR_get_error(), nullptr);
+      return -1;
+    }
+
+    auto &addr = *addr_;
+
+    const char *sni_name;
+    if (get_config()->backend_tls_sni_name) {
+      sni_name = get_config()->backend_tls_sni_name.get();
+    } else {
+      sni_name = addr.host.get();
+    }
+
+    if (sni_name && !util::numeric_host(sni_name)) {
+      SSL_set_tlsext_host_name(conn_.tls.ssl, sni_name);
+    }
+
+    if (SSL_set_fd(conn_.tls.ssl, conn_.fd) == 0) {
+      return -1;
+    }
+
+    SSL_set_connect_state(conn_.tls.ssl);
+
+    read_ = write_ = &HealthChecker::tls_handshake;
+
+    return do_write();
+  }
+
+  read_ = &HealthChecker::read_clear;
+  write_ = &HealthChecker::write_clear;
+
+  if (connection_made() != 0) {
+    return -1;
+  }
+
+  return do_write();
+}
+
+int HealthChecker::tls_handshake() {
+  ERR_clear_error();
+
+  auto rv = conn_.tls_handshake();
+
+  if (rv == SHRPX_ERR_INPROGRESS) {
+    return 0;
+  }
+
+  if (rv < 0) {
+    return rv;
+  }
+
+  if (!get_config()->insecure && ssl::check_cert(conn_.tls.ssl, addr_) != 0) {
+    return -1;
+  }
+
+  read_ = &HealthChecker::read_tls;
+  write_ = &HealthChecker::write_tls;
+
+  if (connection_made() != 0) {
+    return -1;
+  }
+
+  return do_write();
+}
+
+int HealthChecker::read_clear() {
+  for (;;) {
+    rb_.reset();
+
+    auto nread = conn_.read_clear(rb_.last, rb_.wleft());
+
+    if (nread == 0) {
+      return 0;
+    }
+
+    if (nread < 0) {
+      return nread;
+    }
+
+    rb_.write(nread);
+
+    if (on_read() != 0) {
+      return -1;
+    }
+
+    if (probe_done()) {
+      return 0;
+    }
+  }
+}
+
+int HealthChecker::write_clear() {
+  for (;;) {
+    if (wb_.rleft() > 0) {
+      auto nwrite = conn_.write_clear(wb_.pos, wb_.rleft());
+
+      if (nwrite == 0) {
+        return 0;
+      }
+
+      if (nwrite < 0) {
+        return nwrite;
+      }
+
+      wb_.drain(nwrite);
+      continue;
+    }
+
+    wb_.reset();
+    if (on_write() != 0) {
+      return -1;
+    }
+    if (wb_.rleft() == 0) {
+      break;
+    }
+  }
+
+  conn_.wlimit.stopw();
+
+  return 0;
+}
+
+int HealthChecker::read_tls() {
+  ERR_clear_error();
+
+  for (;;) {
+    rb_.reset();
+
+    auto nread = conn_.read_tls(rb_.last, rb_.wleft());
+
+    if (nread == 0) {
+      return 0;
+    }
+
+    if (nread < 0) {
+      return nread;
+    }
+
+    rb_.write(nread);
+
+    if (on_read() != 0) {
+      return -1;
+    }
+
+    if (probe_done()) {
+      return 0;
+    }
+  }
+}
+
+int HealthChecker::write_tls() {
+  ERR_clear_error();
+
+  for (;;) {
+    if (wb_.rleft() > 0) {
+      auto nwrite = conn_.write_tls(wb_.pos, wb_.rleft());
+
+      if (nwrite == 0) {
+        return 0;
+      }
+
+      if (nwrite < 0) {
+        return nwrite;
+      }
+
+      wb_.drain(nwrite);
+      continue;
+    }
+
+    wb_.reset();
+    if (on_write() != 0) {
+      return -1;
+    }
+    if (wb_.rleft() == 0) {
+      break;
+    }
+  }
+
+  conn_.wlimit.stopw();
+
+  return 0;
+}
+
+namespace {
+int htp_hdrs_completecb(http_parser *htp) {
+  auto hc = static_cast<HealthChecker *>(htp->data);
+
+  hc->on_response_status(htp->status_code);
+
+  return 0;
+}
+} // namespace
+
+namespace {
+http_parser_settings htp_hooks = {
+    nullptr,             // http_cb on_message_begin;
+    nullptr,             // http_data_cb on_url;
+    nullptr,             // http_data_cb on_status;
+    nullptr,             // http_data_cb on_header_field;
+    nullptr,             // http_data_cb on_header_value;
+    htp_hdrs_completecb, // http_cb      on_headers_complete;
+    nullptr,             // http_data_cb on_body;
+    nullptr              // http_cb      on_message_complete;
+};
+} // namespace
+
+namespace {
+int on_header_callback(nghttp2_session *session, const nghttp2_frame *frame,
+                       const uint8_t *name, size_t namelen,
+                       const uint8_t *value, size_t valuelen, uint8_t flags,
+                       void *user_data) {
+  auto hc = static_cast<HealthChecker *>(user_data);
+
+  if (frame->hd.type != NGHTTP2_HEADERS ||
+      !util::streq_l(":status", name, namelen)) {
+    return 0;
+  }
+
+  // libnghttp2 guarantees this can be parsed
+  auto status =
+      http2::parse_http_status_code(std::string(value, value + valuelen));
+
+  hc->on_response_status(status);
+
+  return 0;
+}
+} // namespace
+
+namespace {
+int on_stream_close_callback(nghttp2_session *session, int32_t stream_id,
+                             uint32_t error_code, void *user_data) {
+  auto hc = static_cast<HealthChecker *>(user_data);
+
+  // Stream was closed before we get final response.
+  hc->on_response_status(0);
+
+  return 0;
+}
+} // namespace
+
+int HealthChecker::connection_made() {
+  int rv;
+
+  auto &addr = *addr_;
+  auto path = get_config()->downstream_health_check_path.get();
+
+  if (get_config()->downstream_proto != PROTO_HTTP2) {
+    std::string req = "GET ";
+    req += path;
+    req += " HTTP/1.1\r\nHost: ";
+    req += addr.hostport.get();
+    req += "\r\nConnection: close\r\n\r\n";
+
+    wb_.write(req.c_str(), req.size());
+
+    htp_ = make_unique<http_parser>();
+    http_parser_init(htp_.get(), HTTP_RESPONSE);
+    htp_->data = this;
+
+    return 0;
+  }
+
+  if (conn_.tls.ssl) {
+    const unsigned char *next_proto = nullptr;
+    unsigned int next_proto_len = 0;
+    SSL_get0_next_proto_negotiated(conn_.tls.ssl, &next_proto, &next_proto_len);
+#if OPENSSL_VERSION_NUMBER >= 0x10002000L
+    if (!next_proto) {
+      SSL_get0_alpn_selected(conn_.tls.ssl, &next_proto, &next_proto_len);
+    }
+#endif // OPENSSL_VERSION_NUMBER >= 0x10002000L
+    if (!next_proto ||
+        !util::check_h2_is_selected(next_proto, next_proto_len)) {
+      return -1;
+    }
+  }
+
+  nghttp2_session_callbacks *callbacks;
+  rv = nghttp2_session_callbacks_new(&callbacks);
+  if (rv != 0) {
+    return -1;
+  }
+
+  nghttp2_session_callbacks_set_on_header_callback(callbacks,
+                                                   on_header_callback);
+  nghttp2_session_callbacks_set_on_stream_close_callback(
+      callbacks, on_stream_close_callback);
+
+  rv = nghttp2_session_client_new(&session_, callbacks, this);
+
+  nghttp2_session_callbacks_del(callbacks);
+
+  if (rv != 0) {
+    return -1;
+  }
+
+  rv = nghttp2_submit_settings(session_, NGHTTP2_FLAG_NONE, nullptr, 0);
+  if (rv != 0) {
+    return -1;
+  }
+
+  auto nva = std::vector<nghttp2_nv>{
+      http2::make_nv_ll(":method", "GET"),
+      http2::make_nv_lc(":scheme", conn_.tls.ssl ? "https" : "http"),
+      http2::make_nv_lc(":authority", addr.hostport.get()),
+      http2::make_nv_lc(":path", path)};
+
+  rv = nghttp2_submit_request(session_, nullptr, nva.data(), nva.size(),
+                              nullptr, nullptr);
+  if (rv < 0) {
+    return -1;
+  }
+
+  return 0;
+}
+
+int HealthChecker::on_read() {
+  if (session_) {
+    auto rv = nghttp2_session_mem_recv(session_, rb_.pos, rb_.rleft());
+    if (rv < 0) {
+      return -1;
+    }
+
+    rb_.reset();
+
+    return 0;
+  }
+
+  if (!htp_) {
+    return 0;
+  }
+
+  http_parser_execute(htp_.get(), &htp_hooks,
+                      reinterpret_cast<const char *>(rb_.pos), rb_.rleft());
+
+  rb_.reset();
+
+  if (probe_done()) {
+    return 0;
+  }
+
+  if (HTTP_PARSER_ERRNO(htp_.get()) != HPE_OK) {
+    return -1;
+  }
+
+  return 0;
+}
+
+int HealthChecker::on_write() {
+  if (!session_) {
+    return 0;
+  }
+
+  for (;;) {
+    const uint8_t *data;
+    auto datalen = nghttp2_session_mem_send(session_, &data);
+
+    if (datalen < 0) {
+      return -1;
+    }
+
+    if (datalen == 0) {
+      break;
+    }
+
+    // We only send connection preface, SETTINGS, its ACK and a
+    // HEADERS frame, which are small enough to fit in wb_.
+    if (wb_.write(data, datalen) != static_cast<size_t>(datalen)) {
+      return -1;
+    }
+  }
+
+  return 0;
+}
+
+void HealthChecker::on_response_status(unsigned int status) {
+  if (probe_state_ != PROBE_RUNNING) {
+    return;
+  }
+
+  if (100 <= status && status <= 199) {
+    // non-final response
+    return;
+  }
+
+  probe_state_ =
+      (200 <= status && status <= 399) ? PROBE_SUCCESS : PROBE_FAILURE;
+}
+
+bool HealthChecker::healthy() const { return healthy_; }
+
+} // namespace shrpx
@@ -0,0 +1,127 @@
+/*
+ * nghttp2 - HTTP/2 C Library
+ *
+ * Copyright (c) 2014 Tatsuhiro Tsujikawa
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef SHRPX_HEALTH_CHECKER_H
+#define SHRPX_HEALTH_CHECKER_H
+
+#include "shrpx.h"
+
+#include <functional>
+#include <memory>
+
+#include <openssl/ssl.h>
+
+#include <ev.h>
+
+#include <nghttp2/nghttp2.h>
+
+#include "http-parser/http_parser.h"
+
+#include "shrpx_connection.h"
+#include "buffer.h"
+#include "template.h"
+
+using namespace nghttp2;
+
+namespace shrpx {
+
+class LoadBalancer;
+struct DownstreamAddr;
+
+// HealthChecker periodically probes a backend address, and marks it
+// healthy or unhealthy in LoadBalancer.  The probe is either TCP
+// connect, or GET request to
+// Config::downstream_health_check_path.  The latter is sent in
+// HTTP/2 if the backend protocol is HTTP/2.
+class HealthChecker {
+public:
+  // Checks backend address |addr_idx| in |group|, and reports the
+  // result to |lb|.  |ssl_ctx| is used if the backend is HTTP/2 over
+  // TLS.  Otherwise it must be nullptr.
+  HealthChecker(struct ev_loop *loop, SSL_CTX *ssl_ctx, LoadBalancer *lb,
+                size_t group, size_t addr_idx);
+  ~HealthChecker();
+
+  // Starts probe now.
+  void start_probe();
+  // Closes connection, updates health status by |success|, and
+  // schedules next probe.
+  void finish_probe(bool success);
+
+  int do_read();
+  int do_write();
+  // Returns true if the result of the current probe is known.
+  bool probe_done() const;
+  int get_probe_state() const;
+
+  int noop();
+  int connected();
+  int tls_handshake();
+  int read_clear();
+  int write_clear();
+  int read_tls();
+  int write_tls();
+
+  int on_read();
+  int on_write();
+
+  // Called when response status code |status| is received.
+  void on_response_status(unsigned int status);
+
+  bool healthy() const;
+
+  enum {
+    PROBE_NONE,
+    PROBE_RUNNING,
+    PROBE_SUCCESS,
+    PROBE_FAILURE
+  };
+
+  using ReadBuf = Buffer<8_k>;
+  using WriteBuf = Buffer<16_k>;
+
+private:
+  int connection_made();
+
+  Connection conn_;
+  ev_timer timer_;
+  ev_timer probe_timer_;
+  std::function<int(HealthChecker &)> read_, write_;
+  std::unique_ptr<http_parser> htp_;
+  LoadBalancer *lb_;
+  SSL_CTX *ssl_ctx_;
+  nghttp2_session *session_;
+  const DownstreamAddr *addr_;
+  size_t addr_idx_;
+  // the number of consecutive successful or failed probes
+  size_t num_success_, num_failure_;
+  int probe_state_;
+  bool healthy_;
+  WriteBuf wb_;
+  ReadBuf rb_;
+};
+
+} // namespace shrpx
+
+#endif // SHRPX_HEALTH_CHECKER_H
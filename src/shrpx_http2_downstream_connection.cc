@@ -37,6 +37,7 @@
 #include "shrpx_error.h"
 #include "shrpx_http.h"
 #include "shrpx_http2_session.h"
+#include "shrpx_worker.h"
 #include "http2.h"
 #include "util.h"
 
@@ -263,8 +264,11 @@ int Http2DownstreamConnection::push_request_headers() {
   // http2session_ has already in CONNECTED state, so we can get
   // addr_idx here.
   auto addr_idx = http2session_->get_addr_idx();
-  auto downstream_hostport =
-      get_config()->downstream_addrs[addr_idx].hostport.get();
+  auto group = http2session_->get_group();
+  auto downstream_hostport = get_config()
+                                 ->downstream_addr_groups[group]
+                                 .addrs[addr_idx]
+                                 .hostport.get();
 
   const char *authority = nullptr, *host = nullptr;
   if (!no_host_rewrite) {
@@ -436,6 +440,12 @@ int Http2DownstreamConnection::push_request_headers() {
     return -1;
   }
 
+  auto worker = client_handler_->get_worker();
+  addr_req_.start(worker->get_addr_balancer(group),
+                  http2session_->get_addr_idx());
+  session_req_.start(worker->get_http2session_balancer(group),
+                     http2session_->get_index());
+
   downstream_->reset_downstream_wtimer();
 
   http2session_->signal_write();
@@ -531,6 +541,20 @@ StreamData *Http2DownstreamConnection::detach_stream_data() {
   return nullptr;
 }
 
+void Http2DownstreamConnection::on_response_started() {
+  addr_req_.on_response();
+  session_req_.on_response();
+}
+
+void Http2DownstreamConnection::on_request_finished() {
+  addr_req_.end();
+  session_req_.end();
+}
+
+size_t Http2DownstreamConnection::get_addr_idx() const {
+  return http2session_->get_addr_idx();
+}
+
 int Http2DownstreamConnection::on_priority_change(int32_t pri) {
   int rv;
   if (downstream_->get_priority() == pri) {
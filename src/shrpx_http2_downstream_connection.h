@@ -32,6 +32,7 @@
 #include <nghttp2/nghttp2.h>
 
 #include "shrpx_downstream_connection.h"
+#include "shrpx_load_balancer.h"
 
 namespace shrpx {
 
@@ -65,6 +66,7 @@ public:
   // This object is not poolable because we dont' have facility to
   // migrate to another Http2Session object.
   virtual bool poolable() const { return false; }
+  virtual size_t get_addr_idx() const;
 
   int send();
 
@@ -74,9 +76,18 @@ public:
   int submit_rst_stream(Downstream *downstream,
                         uint32_t error_code = NGHTTP2_INTERNAL_ERROR);
 
+  // Called when response HEADERS is received.
+  void on_response_started();
+  // Called when the stream is closed.
+  void on_request_finished();
+
   Http2DownstreamConnection *dlnext, *dlprev;
 
 private:
+  // Outstanding request, counted against backend address and
+  // Http2Session.
+  BalancedRequest addr_req_;
+  BalancedRequest session_req_;
   Http2Session *http2session_;
   StreamData *sd_;
 };
@@ -142,13 +142,13 @@ void writecb(struct ev_loop *loop, ev_io *w, int revents) {
 } // namespace
 
 Http2Session::Http2Session(struct ev_loop *loop, SSL_CTX *ssl_ctx,
-                           ConnectBlocker *connect_blocker, Worker *worker)
+                           Worker *worker, size_t group, size_t idx)
     : conn_(loop, -1, nullptr, get_config()->downstream_write_timeout,
             get_config()->downstream_read_timeout, 0, 0, 0, 0, writecb, readcb,
             timeoutcb, this),
-      worker_(worker), connect_blocker_(connect_blocker), ssl_ctx_(ssl_ctx),
+      worker_(worker), ssl_ctx_(ssl_ctx),
       session_(nullptr), data_pending_(nullptr), data_pendinglen_(0),
-      addr_idx_(0), state_(DISCONNECTED),
+      addr_idx_(0), group_(group), index_(idx), state_(DISCONNECTED),
       connection_check_state_(CONNECTION_CHECK_NONE), flow_control_(false) {
 
   read_ = write_ = &Http2Session::noop;
@@ -233,32 +233,50 @@ int Http2Session::disconnect(bool hard) {
   return 0;
 }
 
-int Http2Session::check_cert() { return ssl::check_cert(conn_.tls.ssl); }
+int Http2Session::check_cert() {
+  return ssl::check_cert(
+      conn_.tls.ssl,
+      &get_config()->downstream_addr_groups[group_].addrs[addr_idx_]);
+}
 
 int Http2Session::initiate_connection() {
   int rv = 0;
 
+  auto &addrs = get_config()->downstream_addr_groups[group_].addrs;
+
   if (state_ == DISCONNECTED) {
-    if (connect_blocker_->blocked()) {
-      if (LOG_ENABLED(INFO)) {
-        DCLOG(INFO, this)
-            << "Downstream connection was blocked by connect_blocker";
+    auto balancer = worker_->get_addr_balancer(group_);
+    // Backends whose connection is blocked by ConnectBlocker.
+    std::vector<bool> blocked;
+    for (;;) {
+      auto idx = balancer->select(blocked.empty() ? nullptr : &blocked);
+      if (idx == -1) {
+        if (LOG_ENABLED(INFO)) {
+          DCLOG(INFO, this)
+              << "Downstream connection was blocked by connect_blocker";
+        }
+        return -1;
       }
-      return -1;
-    }
 
-    auto worker_stat = worker_->get_worker_stat();
-    addr_idx_ = worker_stat->next_downstream;
-    ++worker_stat->next_downstream;
-    worker_stat->next_downstream %= get_config()->downstream_addrs.size();
+      if (!worker_->get_connect_blocker(group_, idx)->blocked()) {
+        addr_idx_ = idx;
+        break;
+      }
+
+      if (blocked.empty()) {
+        blocked.resize(addrs.size());
+      }
+      blocked[idx] = true;
+    }
 
     if (LOG_ENABLED(INFO)) {
       SSLOG(INFO, this) << "Using downstream address idx=" << addr_idx_
-                        << " out of " << get_config()->downstream_addrs.size();
+                        << " out of " << addrs.size() << " in group "
+                        << group_;
     }
   }
 
-  auto &downstream_addr = get_config()->downstream_addrs[addr_idx_];
+  auto &downstream_addr = addrs[addr_idx_];
 
   if (get_config()->downstream_http_proxy_host && state_ == DISCONNECTED) {
     if (LOG_ENABLED(INFO)) {
@@ -271,7 +289,7 @@ int Http2Session::initiate_connection() {
         get_config()->downstream_http_proxy_addr.storage.ss_family);
 
     if (conn_.fd == -1) {
-      connect_blocker_->on_failure();
+      get_connect_blocker()->on_failure();
       return -1;
     }
 
@@ -281,7 +299,7 @@ int Http2Session::initiate_connection() {
       SSLOG(ERROR, this) << "Failed to connect to the proxy "
                          << get_config()->downstream_http_proxy_host.get()
                          << ":" << get_config()->downstream_http_proxy_port;
-      connect_blocker_->on_failure();
+      get_connect_blocker()->on_failure();
       return -1;
     }
 
@@ -341,7 +359,7 @@ int Http2Session::initiate_connection() {
         conn_.fd = util::create_nonblock_socket(
             downstream_addr.addr.storage.ss_family);
         if (conn_.fd == -1) {
-          connect_blocker_->on_failure();
+          get_connect_blocker()->on_failure();
           return -1;
         }
 
@@ -350,7 +368,7 @@ int Http2Session::initiate_connection() {
                      const_cast<sockaddr *>(&downstream_addr.addr.sa),
                      downstream_addr.addrlen);
         if (rv != 0 && errno != EINPROGRESS) {
-          connect_blocker_->on_failure();
+          get_connect_blocker()->on_failure();
           return -1;
         }
 
@@ -372,14 +390,14 @@ int Http2Session::initiate_connection() {
             downstream_addr.addr.storage.ss_family);
 
         if (conn_.fd == -1) {
-          connect_blocker_->on_failure();
+          get_connect_blocker()->on_failure();
           return -1;
         }
 
         rv = connect(conn_.fd, const_cast<sockaddr *>(&downstream_addr.addr.sa),
                      downstream_addr.addrlen);
         if (rv != 0 && errno != EINPROGRESS) {
-          connect_blocker_->on_failure();
+          get_connect_blocker()->on_failure();
           return -1;
         }
 
@@ -503,7 +521,8 @@ int Http2Session::downstream_connect_proxy() {
   if (LOG_ENABLED(INFO)) {
     SSLOG(INFO, this) << "Connected to the proxy";
   }
-  auto &downstream_addr = get_config()->downstream_addrs[addr_idx_];
+  auto &downstream_addr =
+      get_config()->downstream_addr_groups[group_].addrs[addr_idx_];
 
   std::string req = "CONNECT ";
   req += downstream_addr.hostport.get();
@@ -668,6 +687,8 @@ int on_stream_close_callback(nghttp2_session *session, int32_t stream_id,
   }
   auto dconn = sd->dconn;
   if (dconn) {
+    dconn->on_request_finished();
+
     auto downstream = dconn->get_downstream();
     if (downstream && downstream->get_downstream_stream_id() == stream_id) {
 
@@ -934,6 +955,7 @@ int on_frame_recv_callback(nghttp2_session *session, const nghttp2_frame *frame,
       if (downstream->get_response_state() == Downstream::HEADER_COMPLETE) {
 
         downstream->set_response_state(Downstream::MSG_COMPLETE);
+        downstream->store_response_cache();
 
         rv = upstream->on_downstream_body_complete(downstream);
 
@@ -959,6 +981,8 @@ int on_frame_recv_callback(nghttp2_session *session, const nghttp2_frame *frame,
     }
 
     if (frame->headers.cat == NGHTTP2_HCAT_RESPONSE) {
+      sd->dconn->on_response_started();
+
       rv = on_response_headers(http2session, downstream, session, frame);
 
       if (rv != 0) {
@@ -979,6 +1003,7 @@ int on_frame_recv_callback(nghttp2_session *session, const nghttp2_frame *frame,
 
       if (downstream->get_response_state() == Downstream::HEADER_COMPLETE) {
         downstream->set_response_state(Downstream::MSG_COMPLETE);
+        downstream->store_response_cache();
 
         auto upstream = downstream->get_upstream();
 
@@ -1088,6 +1113,7 @@ int on_data_chunk_recv_callback(nghttp2_session *session, uint8_t flags,
   downstream->reset_downstream_rtimer();
 
   downstream->add_response_bodylen(len);
+  downstream->add_response_cache_data(data, len);
 
   auto upstream = downstream->get_upstream();
   rv = upstream->on_downstream_body(downstream, data, len, false);
@@ -1539,7 +1565,7 @@ int Http2Session::connected() {
     return -1;
   }
 
-  connect_blocker_->on_success();
+  get_connect_blocker()->on_success();
 
   if (LOG_ENABLED(INFO)) {
     SSLOG(INFO, this) << "Connection established";
@@ -1744,4 +1770,12 @@ bool Http2Session::should_hard_fail() const {
 
 size_t Http2Session::get_addr_idx() const { return addr_idx_; }
 
+size_t Http2Session::get_group() const { return group_; }
+
+size_t Http2Session::get_index() const { return index_; }
+
+ConnectBlocker *Http2Session::get_connect_blocker() const {
+  return worker_->get_connect_blocker(group_, addr_idx_);
+}
+
 } // namespace shrpx
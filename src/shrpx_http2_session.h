@@ -57,8 +57,8 @@ struct StreamData {
 
 class Http2Session {
 public:
-  Http2Session(struct ev_loop *loop, SSL_CTX *ssl_ctx,
-               ConnectBlocker *connect_blocker, Worker *worker);
+  Http2Session(struct ev_loop *loop, SSL_CTX *ssl_ctx, Worker *worker,
+               size_t group, size_t idx);
   ~Http2Session();
 
   int check_cert();
@@ -150,6 +150,11 @@ public:
   void submit_pending_requests();
 
   size_t get_addr_idx() const;
+  // Returns the index of Config::downstream_addr_groups this object
+  // belongs to.
+  size_t get_group() const;
+  // Returns the index of this object in its group.
+  size_t get_index() const;
 
   enum {
     // Disconnected
@@ -181,6 +186,9 @@ public:
   using WriteBuf = Buffer<32768>;
 
 private:
+  // Returns ConnectBlocker for the backend address this object uses.
+  ConnectBlocker *get_connect_blocker() const;
+
   Connection conn_;
   ev_timer settings_timer_;
   // This timer has 2 purpose: when it first timeout, set
@@ -195,14 +203,18 @@ private:
   // Used to parse the response from HTTP proxy
   std::unique_ptr<http_parser> proxy_htp_;
   Worker *worker_;
-  ConnectBlocker *connect_blocker_;
   // NULL if no TLS is configured
   SSL_CTX *ssl_ctx_;
   nghttp2_session *session_;
   const uint8_t *data_pending_;
   size_t data_pendinglen_;
-  // index of get_config()->downstream_addrs this object uses
+  // index of DownstreamAddrGroup::addrs this object uses
   size_t addr_idx_;
+  // index of get_config()->downstream_addr_groups this object belongs
+  // to
+  size_t group_;
+  // index of this object in the group
+  size_t index_;
   int state_;
   int connection_check_state_;
   bool flow_control_;
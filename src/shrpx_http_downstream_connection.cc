@@ -109,13 +109,14 @@ void connectcb(struct ev_loop *loop, ev_io *w, int revents) {
 } // namespace
 
 HttpDownstreamConnection::HttpDownstreamConnection(
-    DownstreamConnectionPool *dconn_pool, struct ev_loop *loop)
+    DownstreamConnectionPool *dconn_pool, size_t group, size_t addr_idx,
+    struct ev_loop *loop)
     : DownstreamConnection(dconn_pool),
       conn_(loop, -1, nullptr, get_config()->downstream_write_timeout,
             get_config()->downstream_read_timeout, 0, 0, 0, 0, connectcb,
             readcb, timeoutcb, this),
-      ioctrl_(&conn_.rlimit), response_htp_{0}, addr_idx_(0),
-      connected_(false) {}
+      ioctrl_(&conn_.rlimit), response_htp_{0}, group_(group),
+      addr_idx_(addr_idx), connected_(false) {}
 
 HttpDownstreamConnection::~HttpDownstreamConnection() {
   // Downstream and DownstreamConnection may be deleted
@@ -131,26 +132,49 @@ int HttpDownstreamConnection::attach_downstream(Downstream *downstream) {
   }
 
   if (conn_.fd == -1) {
-    auto connect_blocker = client_handler_->get_connect_blocker();
+    auto &addrs = get_config()->downstream_addr_groups[group_].addrs;
+    auto balancer = client_handler_->get_worker()->get_addr_balancer(group_);
+    // Backends we failed to connect to.  This is allocated on the
+    // first failure.
+    std::vector<bool> tried;
+    // Chooses another backend which has not been tried yet.  Returns
+    // false if there is no such backend.
+    auto next_addr = [&]() {
+      if (tried.empty()) {
+        tried.resize(addrs.size());
+      }
+      tried[addr_idx_] = true;
 
-    if (connect_blocker->blocked()) {
-      if (LOG_ENABLED(INFO)) {
-        DCLOG(INFO, this)
-            << "Downstream connection was blocked by connect_blocker";
+      auto next = balancer->select(&tried);
+      if (next == -1) {
+        return false;
       }
-      return -1;
-    }
 
-    auto worker = client_handler_->get_worker();
-    auto worker_stat = worker->get_worker_stat();
-    auto end = worker_stat->next_downstream;
+      addr_idx_ = next;
+
+      return true;
+    };
+
     for (;;) {
-      auto i = worker_stat->next_downstream;
-      ++worker_stat->next_downstream;
-      worker_stat->next_downstream %= get_config()->downstream_addrs.size();
+      auto connect_blocker =
+          client_handler_->get_connect_blocker(group_, addr_idx_);
 
-      conn_.fd = util::create_nonblock_socket(
-          get_config()->downstream_addrs[i].addr.storage.ss_family);
+      if (connect_blocker->blocked()) {
+        if (LOG_ENABLED(INFO)) {
+          DCLOG(INFO, this)
+              << "Downstream connection was blocked by connect_blocker";
+        }
+
+        if (!next_addr()) {
+          return -1;
+        }
+
+        continue;
+      }
+
+      auto &addr = addrs[addr_idx_];
+
+      conn_.fd = util::create_nonblock_socket(addr.addr.storage.ss_family);
 
       if (conn_.fd == -1) {
         auto error = errno;
@@ -162,8 +186,7 @@ int HttpDownstreamConnection::attach_downstream(Downstream *downstream) {
       }
 
       int rv;
-      rv = connect(conn_.fd, &get_config()->downstream_addrs[i].addr.sa,
-                   get_config()->downstream_addrs[i].addrlen);
+      rv = connect(conn_.fd, &addr.addr.sa, addr.addrlen);
       if (rv != 0 && errno != EINPROGRESS) {
         auto error = errno;
         DCLOG(WARN, this) << "connect() failed; errno=" << error;
@@ -172,7 +195,7 @@ int HttpDownstreamConnection::attach_downstream(Downstream *downstream) {
         close(conn_.fd);
         conn_.fd = -1;
 
-        if (end == worker_stat->next_downstream) {
+        if (!next_addr()) {
           return SHRPX_ERR_NETWORK;
         }
 
@@ -184,8 +207,6 @@ int HttpDownstreamConnection::attach_downstream(Downstream *downstream) {
         DCLOG(INFO, this) << "Connecting to downstream server";
       }
 
-      addr_idx_ = i;
-
       ev_io_set(&conn_.wev, conn_.fd, EV_WRITE);
       ev_io_set(&conn_.rev, conn_.fd, EV_READ);
 
@@ -212,8 +233,10 @@ int HttpDownstreamConnection::attach_downstream(Downstream *downstream) {
 
 int HttpDownstreamConnection::push_request_headers() {
   const char *authority = nullptr, *host = nullptr;
-  auto downstream_hostport =
-      get_config()->downstream_addrs[addr_idx_].hostport.get();
+  auto downstream_hostport = get_config()
+                                 ->downstream_addr_groups[group_]
+                                 .addrs[addr_idx_]
+                                 .hostport.get();
   auto connect_method = downstream_->get_request_method() == HTTP_CONNECT;
 
   if (!get_config()->no_host_rewrite && !get_config()->http2_proxy &&
@@ -392,6 +415,9 @@ int HttpDownstreamConnection::push_request_headers() {
   auto output = downstream_->get_request_buf();
   output->append(hdrs.c_str(), hdrs.size());
 
+  req_.start(client_handler_->get_worker()->get_addr_balancer(group_),
+             addr_idx_);
+
   signal_write();
 
   return 0;
@@ -471,6 +497,7 @@ void HttpDownstreamConnection::detach_downstream(Downstream *downstream) {
   if (LOG_ENABLED(INFO)) {
     DCLOG(INFO, this) << "Detaching from DOWNSTREAM:" << downstream;
   }
+  req_.end();
   downstream_ = nullptr;
   ioctrl_.force_resume_read();
 
@@ -486,6 +513,12 @@ void HttpDownstreamConnection::detach_downstream(Downstream *downstream) {
   ev_timer_again(conn_.loop, &conn_.rt);
 }
 
+void HttpDownstreamConnection::on_response_started() { req_.on_response(); }
+
+void HttpDownstreamConnection::on_request_finished() { req_.end(); }
+
+size_t HttpDownstreamConnection::get_addr_idx() const { return addr_idx_; }
+
 void HttpDownstreamConnection::pause_read(IOCtrlReason reason) {
   ioctrl_.pause_read(reason);
 }
@@ -521,6 +554,9 @@ int htp_hdrs_completecb(http_parser *htp) {
   auto upstream = downstream->get_upstream();
   int rv;
 
+  static_cast<HttpDownstreamConnection *>(
+      downstream->get_downstream_connection())->on_response_started();
+
   downstream->set_response_http_status(htp->status_code);
   downstream->set_response_major(htp->http_major);
   downstream->set_response_minor(htp->http_minor);
@@ -676,6 +712,8 @@ int htp_bodycb(http_parser *htp, const char *data, size_t len) {
   auto downstream = static_cast<Downstream *>(htp->data);
 
   downstream->add_response_bodylen(len);
+  downstream->add_response_cache_data(reinterpret_cast<const uint8_t *>(data),
+                                      len);
 
   return downstream->get_upstream()->on_downstream_body(
       downstream, reinterpret_cast<const uint8_t *>(data), len, true);
@@ -702,6 +740,9 @@ int htp_msg_completecb(http_parser *htp) {
   }
 
   downstream->set_response_state(Downstream::MSG_COMPLETE);
+  downstream->store_response_cache();
+  static_cast<HttpDownstreamConnection *>(
+      downstream->get_downstream_connection())->on_request_finished();
   // Block reading another response message from (broken?)
   // server. This callback is not called if the connection is
   // tunneled.
@@ -851,7 +892,8 @@ int HttpDownstreamConnection::on_write() {
 }
 
 int HttpDownstreamConnection::on_connect() {
-  auto connect_blocker = client_handler_->get_connect_blocker();
+  auto connect_blocker =
+      client_handler_->get_connect_blocker(group_, addr_idx_);
 
   if (!util::check_socket_connected(conn_.fd)) {
     conn_.wlimit.stopw();
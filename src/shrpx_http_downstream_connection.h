@@ -32,6 +32,7 @@
 #include "shrpx_downstream_connection.h"
 #include "shrpx_io_control.h"
 #include "shrpx_connection.h"
+#include "shrpx_load_balancer.h"
 
 namespace shrpx {
 
@@ -39,7 +40,10 @@ class DownstreamConnectionPool;
 
 class HttpDownstreamConnection : public DownstreamConnection {
 public:
+  // |addr_idx| is the index of DownstreamAddrGroup::addrs of
+  // |group| to connect first.
   HttpDownstreamConnection(DownstreamConnectionPool *dconn_pool,
+                           size_t group, size_t addr_idx,
                            struct ev_loop *loop);
   virtual ~HttpDownstreamConnection();
   virtual int attach_downstream(Downstream *downstream);
@@ -60,15 +64,26 @@ public:
   virtual int on_priority_change(int32_t pri) { return 0; }
 
   virtual bool poolable() const { return true; }
+  virtual size_t get_addr_idx() const;
 
   int on_connect();
   void signal_write();
 
+  // Called when response header is received.
+  void on_response_started();
+  // Called when response message is completely received.
+  void on_request_finished();
+
 private:
   Connection conn_;
   IOControl ioctrl_;
   http_parser response_htp_;
-  // index of get_config()->downstream_addrs this object is using
+  // Outstanding request, counted against backend address
+  BalancedRequest req_;
+  // index of get_config()->downstream_addr_groups this object is
+  // using
+  size_t group_;
+  // index of DownstreamAddrGroup::addrs this object is using
   size_t addr_idx_;
   bool connected_;
 };
@@ -0,0 +1,298 @@
+/*
+ * nghttp2 - HTTP/2 C Library
+ *
+ * Copyright (c) 2015 Tatsuhiro Tsujikawa
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "shrpx_load_balancer.h"
+
+#include <cmath>
+#include <algorithm>
+
+namespace shrpx {
+
+namespace {
+// The time constant of peak EWMA.  A latency sample loses 1/e of its
+// weight in this many seconds.
+const ev_tstamp EWMA_DECAY = 10.;
+// The cost of a backend which has outstanding requests, but has not
+// responded yet.  This is large enough that such backend is chosen
+// only if the other backends are overloaded.
+const double NO_RESPONSE_PENALTY = 1e6;
+} // namespace
+
+LoadBalancer::LoadBalancer(struct ev_loop *loop, shrpx_balance policy,
+                           size_t n)
+    : loads_(n), gen_(std::random_device()()), loop_(loop), next_(0),
+      num_unhealthy_(0), policy_(policy) {}
+
+ssize_t LoadBalancer::select(const std::vector<bool> *excluded) {
+  if (loads_.empty()) {
+    return -1;
+  }
+
+  auto check_health = num_unhealthy_ > 0;
+
+  for (;;) {
+    ssize_t idx;
+
+    switch (policy_) {
+    case BALANCE_LEAST_REQUEST:
+      idx = select_least_request(excluded, check_health);
+      break;
+    case BALANCE_PEAK_EWMA:
+      idx = select_peak_ewma(excluded, check_health);
+      break;
+    case BALANCE_P2C:
+      idx = select_p2c(excluded, check_health);
+      break;
+    default:
+      idx = select_round_robin(excluded, check_health);
+      break;
+    }
+
+    if (idx != -1 || !check_health) {
+      return idx;
+    }
+
+    // All remaining backends are unhealthy.  Health check might be
+    // wrong, so try them anyway.
+    check_health = false;
+  }
+}
+
+bool LoadBalancer::selectable(size_t idx, const std::vector<bool> *excluded,
+                              bool check_health) const {
+  if (excluded && (*excluded)[idx]) {
+    return false;
+  }
+  return !check_health || loads_[idx].healthy;
+}
+
+ssize_t LoadBalancer::select_round_robin(const std::vector<bool> *excluded,
+                                         bool check_health) {
+  auto n = loads_.size();
+  for (size_t i = 0; i < n; ++i) {
+    auto idx = (next_ + i) % n;
+    if (!selectable(idx, excluded, check_health)) {
+      continue;
+    }
+    next_ = (idx + 1) % n;
+    return idx;
+  }
+  return -1;
+}
+
+ssize_t LoadBalancer::select_least_request(const std::vector<bool> *excluded,
+                                           bool check_health) {
+  auto n = loads_.size();
+  ssize_t best = -1;
+  for (size_t i = 0; i < n; ++i) {
+    auto idx = (next_ + i) % n;
+    if (!selectable(idx, excluded, check_health)) {
+      continue;
+    }
+    if (best == -1 || loads_[idx].num_requests < loads_[best].num_requests) {
+      best = idx;
+    }
+  }
+  if (best != -1) {
+    next_ = (best + 1) % n;
+  }
+  return best;
+}
+
+ssize_t LoadBalancer::select_peak_ewma(const std::vector<bool> *excluded,
+                                       bool check_health) {
+  auto n = loads_.size();
+  ssize_t best = -1;
+  double best_cost = 0.;
+  for (size_t i = 0; i < n; ++i) {
+    auto idx = (next_ + i) % n;
+    if (!selectable(idx, excluded, check_health)) {
+      continue;
+    }
+    auto cost = get_cost(idx);
+    if (best == -1 || cost < best_cost) {
+      best = idx;
+      best_cost = cost;
+    }
+  }
+  if (best != -1) {
+    next_ = (best + 1) % n;
+  }
+  return best;
+}
+
+ssize_t LoadBalancer::select_p2c(const std::vector<bool> *excluded,
+                                 bool check_health) {
+  auto n = loads_.size();
+  size_t m = 0;
+  for (size_t idx = 0; idx < n; ++idx) {
+    if (selectable(idx, excluded, check_health)) {
+      ++m;
+    }
+  }
+
+  if (m == 0) {
+    return -1;
+  }
+
+  // Pick 2 distinct candidates at random, and take the one with less
+  // outstanding requests.
+  size_t r1 = 0, r2 = 0;
+  if (m > 1) {
+    r1 = std::uniform_int_distribution<size_t>(0, m - 1)(gen_);
+    r2 = std::uniform_int_distribution<size_t>(0, m - 2)(gen_);
+    if (r2 >= r1) {
+      ++r2;
+    }
+  }
+
+  ssize_t a = -1, b = -1;
+  for (size_t idx = 0, k = 0; idx < n; ++idx) {
+    if (!selectable(idx, excluded, check_health)) {
+      continue;
+    }
+    if (k == r1) {
+      a = idx;
+    }
+    if (k == r2) {
+      b = idx;
+    }
+    ++k;
+  }
+
+  auto &la = loads_[a];
+  auto &lb = loads_[b];
+
+  if (la.num_requests != lb.num_requests) {
+    return la.num_requests < lb.num_requests ? a : b;
+  }
+
+  return get_cost(a) <= get_cost(b) ? a : b;
+}
+
+void LoadBalancer::start_request(size_t idx) { ++loads_[idx].num_requests; }
+
+void LoadBalancer::end_request(size_t idx) {
+  auto &load = loads_[idx];
+  if (load.num_requests > 0) {
+    --load.num_requests;
+  }
+}
+
+void LoadBalancer::update_latency(size_t idx, ev_tstamp t) {
+  auto &load = loads_[idx];
+  auto now = ev_now(loop_);
+
+  if (t > load.latency) {
+    // Peak sensitive; slow response is reflected immediately.
+    load.latency = t;
+  } else {
+    auto w = std::exp(-std::max(0., now - load.last_update) / EWMA_DECAY);
+    load.latency = load.latency * w + t * (1. - w);
+  }
+
+  load.last_update = now;
+}
+
+void LoadBalancer::set_healthy(size_t idx, bool f) {
+  auto &load = loads_[idx];
+  if (load.healthy == f) {
+    return;
+  }
+
+  load.healthy = f;
+
+  if (f) {
+    --num_unhealthy_;
+  } else {
+    ++num_unhealthy_;
+  }
+}
+
+size_t LoadBalancer::size() const { return loads_.size(); }
+
+const BackendLoad &LoadBalancer::get_load(size_t idx) const {
+  return loads_[idx];
+}
+
+double LoadBalancer::get_cost(size_t idx) const {
+  auto &load = loads_[idx];
+
+  if (load.latency == 0.) {
+    if (load.num_requests == 0) {
+      return 0.;
+    }
+    return NO_RESPONSE_PENALTY + load.num_requests;
+  }
+
+  // Latency decays while the backend is not used, so that we give
+  // it another chance eventually.
+  auto td = std::max(0., ev_now(loop_) - load.last_update);
+  auto latency = load.latency * std::exp(-td / EWMA_DECAY);
+
+  return latency * (load.num_requests + 1);
+}
+
+struct ev_loop *LoadBalancer::get_loop() const {
+  return loop_;
+}
+
+BalancedRequest::BalancedRequest()
+    : lb_(nullptr), idx_(0), start_time_(0.), latency_recorded_(false) {}
+
+BalancedRequest::~BalancedRequest() { end(); }
+
+void BalancedRequest::start(LoadBalancer *lb, size_t idx) {
+  end();
+
+  lb_ = lb;
+  idx_ = idx;
+  start_time_ = ev_now(lb_->get_loop());
+  latency_recorded_ = false;
+
+  lb_->start_request(idx_);
+}
+
+void BalancedRequest::on_response() {
+  if (!lb_ || latency_recorded_) {
+    return;
+  }
+
+  latency_recorded_ = true;
+
+  lb_->update_latency(idx_, ev_now(lb_->get_loop()) - start_time_);
+}
+
+void BalancedRequest::end() {
+  if (!lb_) {
+    return;
+  }
+
+  lb_->end_request(idx_);
+  lb_ = nullptr;
+}
+
+bool BalancedRequest::active() const { return lb_ != nullptr; }
+
+} // namespace shrpx
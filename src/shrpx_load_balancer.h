@@ -0,0 +1,134 @@
+/*
+ * nghttp2 - HTTP/2 C Library
+ *
+ * Copyright (c) 2015 Tatsuhiro Tsujikawa
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef SHRPX_LOAD_BALANCER_H
+#define SHRPX_LOAD_BALANCER_H
+
+#include "shrpx.h"
+
+#include <vector>
+#include <random>
+
+#include <ev.h>
+
+#include "shrpx_config.h"
+
+namespace shrpx {
+
+struct BackendLoad {
+  BackendLoad()
+      : num_requests(0), latency(0.), last_update(0.), healthy(true) {}
+  // The number of requests sent to the backend which have not
+  // finished yet.
+  size_t num_requests;
+  // Peak EWMA of response latency in seconds.  0 means that we have
+  // no sample yet.
+  ev_tstamp latency;
+  // The time when |latency| was updated last.
+  ev_tstamp last_update;
+  // false if health check marked the backend unhealthy.
+  bool healthy;
+};
+
+// LoadBalancer chooses one of the backends using the policy given in
+// the constructor.  The caller has to tell the outstanding requests
+// and response latency of each backend using start_request(),
+// end_request() and update_latency().  This object is not thread
+// safe; each worker has its own instance.
+class LoadBalancer {
+public:
+  LoadBalancer(struct ev_loop *loop, shrpx_balance policy, size_t n);
+
+  // Returns the index of the backend which the next request should
+  // go to.  If |excluded| is not nullptr, the backend at index i is
+  // not chosen if (*excluded)[i] is true.  Unhealthy backends are
+  // not chosen unless all the other backends are unhealthy or
+  // excluded.  This function returns -1 if there is no backend to
+  // choose.
+  ssize_t select(const std::vector<bool> *excluded = nullptr);
+
+  void start_request(size_t idx);
+  void end_request(size_t idx);
+  // Tells that backend |idx| took |t| seconds to send response
+  // header.
+  void update_latency(size_t idx, ev_tstamp t);
+  void set_healthy(size_t idx, bool f);
+
+  size_t size() const;
+  const BackendLoad &get_load(size_t idx) const;
+  // Returns the load score of backend |idx| used by peak EWMA
+  // policy.  Lower is better.
+  double get_cost(size_t idx) const;
+  struct ev_loop *get_loop() const;
+
+private:
+  // Returns true if backend |idx| can be chosen.  If |check_health|
+  // is true, unhealthy backend cannot be chosen.
+  bool selectable(size_t idx, const std::vector<bool> *excluded,
+                  bool check_health) const;
+  ssize_t select_round_robin(const std::vector<bool> *excluded,
+                             bool check_health);
+  ssize_t select_least_request(const std::vector<bool> *excluded,
+                               bool check_health);
+  ssize_t select_peak_ewma(const std::vector<bool> *excluded,
+                           bool check_health);
+  ssize_t select_p2c(const std::vector<bool> *excluded, bool check_health);
+
+  std::vector<BackendLoad> loads_;
+  std::mt19937 gen_;
+  struct ev_loop *loop_;
+  // The index where the next search starts.  This is used to break a
+  // tie so that idle backends get requests in turn.
+  size_t next_;
+  // The number of unhealthy backends.
+  size_t num_unhealthy_;
+  shrpx_balance policy_;
+};
+
+// Bookkeeping of one request for LoadBalancer.  end() is called on
+// destruction if the request is still outstanding.
+class BalancedRequest {
+public:
+  BalancedRequest();
+  ~BalancedRequest();
+
+  // Starts request to backend |idx| of |lb|.  If there is
+  // outstanding request, it is ended first.
+  void start(LoadBalancer *lb, size_t idx);
+  // Records response latency.  Only the first call after start() is
+  // taken into account.
+  void on_response();
+  void end();
+  bool active() const;
+
+private:
+  LoadBalancer *lb_;
+  size_t idx_;
+  ev_tstamp start_time_;
+  bool latency_recorded_;
+};
+
+} // namespace shrpx
+
+#endif // SHRPX_LOAD_BALANCER_H
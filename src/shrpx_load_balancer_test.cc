@@ -0,0 +1,206 @@
+/*
+ * nghttp2 - HTTP/2 C Library
+ *
+ * Copyright (c) 2014 Tatsuhiro Tsujikawa
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "shrpx_load_balancer_test.h"
+
+#include <CUnit/CUnit.h>
+
+#include "shrpx_load_balancer.h"
+
+namespace shrpx {
+
+void test_shrpx_load_balancer_round_robin(void) {
+  auto loop = EV_DEFAULT;
+  LoadBalancer lb(loop, BALANCE_ROUND_ROBIN, 3);
+
+  CU_ASSERT(0 == lb.select());
+  CU_ASSERT(1 == lb.select());
+  CU_ASSERT(2 == lb.select());
+  CU_ASSERT(0 == lb.select());
+
+  std::vector<bool> excluded{false, true, false};
+
+  CU_ASSERT(2 == lb.select(&excluded));
+  CU_ASSERT(0 == lb.select(&excluded));
+
+  excluded.assign(3, true);
+
+  CU_ASSERT(-1 == lb.select(&excluded));
+
+  LoadBalancer empty(loop, BALANCE_ROUND_ROBIN, 0);
+
+  CU_ASSERT(-1 == empty.select());
+}
+
+void test_shrpx_load_balancer_least_request(void) {
+  auto loop = EV_DEFAULT;
+  LoadBalancer lb(loop, BALANCE_LEAST_REQUEST, 3);
+
+  lb.start_request(0);
+  lb.start_request(0);
+  lb.start_request(1);
+
+  CU_ASSERT(2 == lb.select());
+
+  lb.start_request(2);
+  lb.start_request(2);
+
+  CU_ASSERT(1 == lb.select());
+
+  std::vector<bool> excluded{false, true, false};
+
+  // Ties are broken in turn.
+  CU_ASSERT(2 == lb.select(&excluded));
+  CU_ASSERT(0 == lb.select(&excluded));
+
+  lb.end_request(0);
+  lb.end_request(0);
+
+  CU_ASSERT(0 == lb.get_load(0).num_requests);
+  CU_ASSERT(0 == lb.select());
+
+  // Extra end_request() does not underflow.
+  lb.end_request(0);
+
+  CU_ASSERT(0 == lb.get_load(0).num_requests);
+}
+
+void test_shrpx_load_balancer_peak_ewma(void) {
+  auto loop = EV_DEFAULT;
+  LoadBalancer lb(loop, BALANCE_PEAK_EWMA, 2);
+
+  lb.update_latency(0, 0.1);
+  lb.update_latency(1, 0.5);
+
+  CU_ASSERT(0 == lb.select());
+  CU_ASSERT(0 == lb.select());
+
+  // Peak is taken immediately.
+  lb.update_latency(0, 1.);
+
+  CU_ASSERT(1. == lb.get_load(0).latency);
+  CU_ASSERT(1 == lb.select());
+
+  // Outstanding requests increase cost.
+  lb.start_request(1);
+  lb.start_request(1);
+
+  CU_ASSERT(0 == lb.select());
+
+  // Backend without response but with outstanding request is avoided.
+  LoadBalancer lb2(loop, BALANCE_PEAK_EWMA, 2);
+
+  lb2.start_request(0);
+  lb2.update_latency(1, 2.);
+  lb2.start_request(1);
+  lb2.start_request(1);
+
+  CU_ASSERT(1 == lb2.select());
+}
+
+void test_shrpx_load_balancer_p2c(void) {
+  auto loop = EV_DEFAULT;
+  LoadBalancer lb(loop, BALANCE_P2C, 2);
+
+  lb.start_request(0);
+
+  // With 2 backends, both are always picked.
+  for (int i = 0; i < 10; ++i) {
+    CU_ASSERT(1 == lb.select());
+  }
+
+  std::vector<bool> excluded{false, true};
+
+  CU_ASSERT(0 == lb.select(&excluded));
+
+  LoadBalancer lb3(loop, BALANCE_P2C, 3);
+
+  lb3.start_request(0);
+  lb3.start_request(1);
+  lb3.start_request(2);
+  lb3.start_request(2);
+
+  // Backend 2 is never chosen, since it is the most loaded one.
+  for (int i = 0; i < 20; ++i) {
+    CU_ASSERT(2 != lb3.select());
+  }
+
+  BalancedRequest req;
+
+  req.start(&lb3, 0);
+
+  CU_ASSERT(2 == lb3.get_load(0).num_requests);
+
+  req.on_response();
+  req.end();
+  req.end();
+
+  CU_ASSERT(1 == lb3.get_load(0).num_requests);
+  CU_ASSERT(!req.active());
+}
+
+void test_shrpx_load_balancer_health(void) {
+  auto loop = EV_DEFAULT;
+  LoadBalancer lb(loop, BALANCE_ROUND_ROBIN, 3);
+
+  lb.set_healthy(1, false);
+
+  CU_ASSERT(0 == lb.select());
+  CU_ASSERT(2 == lb.select());
+  CU_ASSERT(0 == lb.select());
+
+  std::vector<bool> excluded{true, false, true};
+
+  // Unhealthy backend is chosen if there is no other choice.
+  CU_ASSERT(1 == lb.select(&excluded));
+
+  lb.set_healthy(0, false);
+  lb.set_healthy(2, false);
+
+  CU_ASSERT(-1 != lb.select());
+
+  lb.set_healthy(0, true);
+  lb.set_healthy(2, true);
+  lb.set_healthy(1, true);
+
+  CU_ASSERT(lb.get_load(1).healthy);
+
+  LoadBalancer lr(loop, BALANCE_LEAST_REQUEST, 2);
+
+  lr.start_request(1);
+  lr.set_healthy(0, false);
+
+  CU_ASSERT(1 == lr.select());
+
+  LoadBalancer p2c(loop, BALANCE_P2C, 3);
+
+  p2c.set_healthy(0, false);
+  p2c.set_healthy(2, false);
+
+  for (int i = 0; i < 10; ++i) {
+    CU_ASSERT(1 == p2c.select());
+  }
+}
+
+} // namespace shrpx
@@ -43,6 +43,7 @@
 
 #include "shrpx_config.h"
 #include "shrpx_downstream.h"
+#include "shrpx_response_cache.h"
 #include "util.h"
 #include "template.h"
 
@@ -253,6 +254,24 @@ void upstream_accesslog(const std::vector<LogFragment> &lfv,
     case SHRPX_LOGF_ALPN:
       std::tie(p, avail) = copy(lgsp.alpn, avail, p);
       break;
+    case SHRPX_LOGF_CACHE_STATUS: {
+      auto status = "-";
+      if (downstream) {
+        switch (downstream->get_cache_status()) {
+        case CACHE_HIT:
+          status = "HIT";
+          break;
+        case CACHE_MISS:
+          status = "MISS";
+          break;
+        case CACHE_BYPASS:
+          status = "BYPASS";
+          break;
+        }
+      }
+
+      std::tie(p, avail) = copy(status, avail, p);
+    } break;
     case SHRPX_LOGF_NONE:
       break;
     default:
@@ -115,6 +115,7 @@ enum LogFragmentType {
   SHRPX_LOGF_REQUEST_TIME,
   SHRPX_LOGF_PID,
   SHRPX_LOGF_ALPN,
+  SHRPX_LOGF_CACHE_STATUS,
 };
 
 struct LogFragment {
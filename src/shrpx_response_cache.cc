@@ -0,0 +1,530 @@
+/*
+ * nghttp2 - HTTP/2 C Library
+ *
+ * Copyright (c) 2015 Tatsuhiro Tsujikawa
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "shrpx_response_cache.h"
+
+#include <algorithm>
+
+#include "http-parser/http_parser.h"
+
+#include "shrpx_downstream.h"
+#include "util.h"
+#include "template.h"
+
+using namespace nghttp2;
+
+namespace shrpx {
+
+CacheEntry::CacheEntry()
+    : bodylen(0), size(0), response_time(0.), initial_age(0.),
+      freshness_lifetime(0.), status(0) {}
+
+ResponseCache::ResponseCache(struct ev_loop *loop, size_t max_size,
+                             size_t max_object_size)
+    : loop_(loop), size_(0), max_size_(max_size),
+      max_object_size_(max_object_size) {}
+
+namespace {
+// Splits comma separated list |value|, and returns its elements
+// without surrounding white spaces.  Empty elements are omitted.
+std::vector<std::string> split_list(const std::string &value) {
+  std::vector<std::string> res;
+  auto first = std::begin(value);
+  auto last = std::end(value);
+
+  for (;;) {
+    auto end = std::find(first, last, ',');
+    auto s = first;
+    auto e = end;
+    for (; s != e && (*s == ' ' || *s == '\t'); ++s)
+      ;
+    for (; e != s && (*(e - 1) == ' ' || *(e - 1) == '\t'); --e)
+      ;
+    if (s != e) {
+      res.emplace_back(s, e);
+    }
+    if (end == last) {
+      return res;
+    }
+    first = end + 1;
+  }
+}
+} // namespace
+
+namespace {
+// Returns the delta-seconds argument of Cache-Control directive
+// |directive|, whose '=' is at |eq|.  Invalid argument is treated as
+// 0, so that the response is considered stale.
+int64_t parse_delta_seconds(const std::string &directive, size_t eq) {
+  if (eq == std::string::npos) {
+    return 0;
+  }
+
+  auto value = directive.substr(eq + 1);
+  if (value.size() >= 2 && value[0] == '"' && value.back() == '"') {
+    value = value.substr(1, value.size() - 2);
+  }
+
+  auto n = util::parse_uint(value);
+  if (n == -1) {
+    return 0;
+  }
+
+  return n;
+}
+} // namespace
+
+CacheControl parse_cache_control(const Headers &headers) {
+  CacheControl cc;
+
+  for (auto &kv : headers) {
+    if (kv.token != http2::HD_CACHE_CONTROL) {
+      continue;
+    }
+
+    for (auto &directive : split_list(kv.value)) {
+      auto eq = directive.find('=');
+      auto name = directive.substr(0, eq);
+
+      if (util::strieq_l("no-store", name)) {
+        cc.flags |= CACHE_CONTROL_NO_STORE;
+      } else if (util::strieq_l("no-cache", name)) {
+        cc.flags |= CACHE_CONTROL_NO_CACHE;
+      } else if (util::strieq_l("private", name)) {
+        cc.flags |= CACHE_CONTROL_PRIVATE;
+      } else if (util::strieq_l("max-age", name)) {
+        cc.max_age = parse_delta_seconds(directive, eq);
+      } else if (util::strieq_l("s-maxage", name)) {
+        cc.s_maxage = parse_delta_seconds(directive, eq);
+      }
+    }
+  }
+
+  return cc;
+}
+
+namespace {
+// Removes weak indicator from entity tag |etag|.
+std::string strip_weak(const std::string &etag) {
+  if (util::startsWith(etag, "W/")) {
+    return etag.substr(2);
+  }
+  return etag;
+}
+} // namespace
+
+bool etag_match(const std::string &if_none_match, const std::string &etag) {
+  if (etag.empty()) {
+    return false;
+  }
+
+  auto tag = strip_weak(etag);
+
+  for (auto &s : split_list(if_none_match)) {
+    if (s == "*" || strip_weak(s) == tag) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+ev_tstamp get_current_age(const CacheEntry &ent, ev_tstamp now) {
+  return ent.initial_age + std::max(0., now - ent.response_time);
+}
+
+bool check_not_modified(const CacheEntry &ent, const Downstream *downstream) {
+  // 304 stands in for 200 only (RFC 7232, section 4.1).
+  if (ent.status != 200) {
+    return false;
+  }
+
+  // If-None-Match takes precedence over If-Modified-Since.
+  auto inm = downstream->get_request_header("if-none-match");
+  if (inm) {
+    auto etag = http2::get_header(ent.headers, "etag");
+    return etag && etag_match(inm->value, etag->value);
+  }
+
+  auto ims = downstream->get_request_header(http2::HD_IF_MODIFIED_SINCE);
+  if (!ims) {
+    return false;
+  }
+
+  auto lm = http2::get_header(ent.headers, "last-modified");
+  if (!lm) {
+    return false;
+  }
+
+  auto t = util::parse_http_date(ims->value);
+  auto lmt = util::parse_http_date(lm->value);
+
+  return t != 0 && lmt != 0 && lmt <= t;
+}
+
+namespace {
+// Returns the cache key of |downstream|.  HEAD request shares the key
+// with GET request, so method is not included.  This function
+// returns empty string if the request has no host or path.
+std::string make_key(const Downstream *downstream) {
+  auto &path = downstream->get_request_path();
+  if (path.empty() || path[0] != '/') {
+    return "";
+  }
+
+  auto host = downstream->get_request_http2_authority();
+  if (host.empty()) {
+    auto h = downstream->get_request_header(http2::HD_HOST);
+    if (!h || h->value.empty()) {
+      return "";
+    }
+    host = h->value;
+  }
+
+  util::inp_strlower(host);
+
+  auto &scheme = downstream->get_request_http2_scheme();
+
+  std::string key;
+  key.reserve(scheme.size() + 3 + host.size() + path.size());
+  key += scheme;
+  key += "://";
+  key += host;
+  key += path;
+
+  return key;
+}
+} // namespace
+
+std::shared_ptr<CacheEntry>
+ResponseCache::get_fresh(const Downstream *downstream, const std::string &key,
+                         const CacheControl &cc) {
+  auto pragma = downstream->get_request_header("pragma");
+  if ((cc.flags & CACHE_CONTROL_NO_CACHE) ||
+      (pragma && util::strieq_l("no-cache", pragma->value))) {
+    // Client asks us to reload the response from backend.
+    return nullptr;
+  }
+
+  auto ent = get(key);
+  if (!ent) {
+    return nullptr;
+  }
+
+  auto age = get_current_age(*ent, ev_now(loop_));
+
+  if (age >= ent->freshness_lifetime) {
+    // We don't revalidate stale entry.  Backend will send full
+    // response, and it replaces this entry.
+    remove(key);
+    return nullptr;
+  }
+
+  if (cc.max_age != -1 && age > cc.max_age) {
+    return nullptr;
+  }
+
+  for (auto &kv : ent->vary) {
+    auto h = downstream->get_request_header(kv.name);
+    if (http2::value_to_str(h) != kv.value) {
+      return nullptr;
+    }
+  }
+
+  return ent;
+}
+
+std::shared_ptr<CacheEntry> ResponseCache::lookup(Downstream *downstream) {
+  downstream->set_cache_status(CACHE_BYPASS);
+
+  auto method = downstream->get_request_method();
+  if (method != HTTP_GET && method != HTTP_HEAD) {
+    return nullptr;
+  }
+
+  if (downstream->get_upgrade_request() ||
+      downstream->get_http2_upgrade_request() ||
+      downstream->get_request_content_length() > 0 ||
+      downstream->get_chunked_request() ||
+      downstream->get_request_http2_expect_body()) {
+    return nullptr;
+  }
+
+  // We don't serve partial content from cache.
+  if (downstream->get_request_header("authorization") ||
+      downstream->get_request_header("range")) {
+    return nullptr;
+  }
+
+  auto cc = parse_cache_control(downstream->get_request_headers());
+  if (cc.flags & CACHE_CONTROL_NO_STORE) {
+    return nullptr;
+  }
+
+  auto key = make_key(downstream);
+  if (key.empty()) {
+    return nullptr;
+  }
+
+  downstream->set_cache_status(CACHE_MISS);
+
+  // Response to HEAD request has no body, so it cannot be stored.
+  if (method == HTTP_GET) {
+    downstream->set_response_cache(this);
+  }
+
+  auto ent = get_fresh(downstream, key, cc);
+  if (!ent) {
+    ++stat_.misses;
+    return nullptr;
+  }
+
+  ++stat_.hits;
+
+  downstream->set_cache_status(CACHE_HIT);
+  downstream->set_response_cache(nullptr);
+
+  return ent;
+}
+
+namespace {
+// Records request header fields of |downstream| nominated by Vary
+// header field value |value| to |vary|.  This function returns -1 if
+// the response varies on "*".
+int add_vary(Headers &vary, const std::string &value,
+             const Downstream *downstream) {
+  for (auto &name : split_list(value)) {
+    if (name == "*") {
+      return -1;
+    }
+
+    util::inp_strlower(name);
+
+    auto h = downstream->get_request_header(name);
+    vary.emplace_back(name, http2::value_to_str(h));
+  }
+
+  return 0;
+}
+} // namespace
+
+std::unique_ptr<CacheEntry>
+ResponseCache::create_entry(Downstream *downstream) const {
+  auto status = downstream->get_response_http_status();
+
+  // Status codes which are cacheable by default, except for 501 and
+  // 206.  We don't store error from backend, and partial content.
+  switch (status) {
+  case 200:
+  case 203:
+  case 300:
+  case 301:
+  case 404:
+  case 410:
+    break;
+  default:
+    return nullptr;
+  }
+
+  if (downstream->get_upgraded() || downstream->get_non_final_response()) {
+    return nullptr;
+  }
+
+  auto &headers = downstream->get_response_headers();
+
+  auto cc = parse_cache_control(headers);
+  if (cc.flags & (CACHE_CONTROL_NO_STORE | CACHE_CONTROL_NO_CACHE |
+                  CACHE_CONTROL_PRIVATE)) {
+    return nullptr;
+  }
+
+  auto ent = make_unique<CacheEntry>();
+
+  time_t date = 0;
+  time_t expires = 0;
+  auto has_expires = false;
+  int64_t age_value = 0;
+
+  for (auto &kv : headers) {
+    if (kv.name.empty() || kv.name[0] == ':') {
+      continue;
+    }
+
+    switch (kv.token) {
+    case http2::HD_CONNECTION:
+    case http2::HD_CONTENT_LENGTH:
+    case http2::HD_KEEP_ALIVE:
+    case http2::HD_PROXY_CONNECTION:
+    case http2::HD_TE:
+    case http2::HD_TRAILER:
+    case http2::HD_TRANSFER_ENCODING:
+    case http2::HD_UPGRADE:
+      continue;
+    }
+
+    if (kv.name == "set-cookie") {
+      return nullptr;
+    }
+
+    if (kv.name == "age") {
+      age_value = std::max(static_cast<int64_t>(0), util::parse_uint(kv.value));
+      continue;
+    }
+
+    if (kv.name == "date") {
+      date = util::parse_http_date(kv.value);
+    } else if (kv.name == "expires") {
+      // Invalid date means that the response has already expired.
+      expires = util::parse_http_date(kv.value);
+      has_expires = true;
+    } else if (kv.name == "vary") {
+      if (add_vary(ent->vary, kv.value, downstream) != 0) {
+        return nullptr;
+      }
+    }
+
+    ent->headers.push_back(kv);
+  }
+
+  auto now = ev_now(loop_);
+
+  // We don't use heuristic freshness.
+  if (cc.s_maxage != -1) {
+    ent->freshness_lifetime = cc.s_maxage;
+  } else if (cc.max_age != -1) {
+    ent->freshness_lifetime = cc.max_age;
+  } else if (has_expires) {
+    ent->freshness_lifetime = expires - (date ? date : now);
+  } else {
+    return nullptr;
+  }
+
+  auto apparent_age = date ? std::max(0., now - date) : 0.;
+
+  ent->response_time = now;
+  ent->initial_age = std::max(apparent_age, static_cast<ev_tstamp>(age_value));
+
+  if (ent->initial_age >= ent->freshness_lifetime) {
+    return nullptr;
+  }
+
+  ent->key = make_key(downstream);
+  if (ent->key.empty()) {
+    return nullptr;
+  }
+
+  ent->status = status;
+
+  return ent;
+}
+
+int ResponseCache::append_body(CacheEntry *ent, const uint8_t *data,
+                               size_t len) const {
+  if (ent->bodylen + len > max_object_size_) {
+    return -1;
+  }
+
+  ent->bodylen += len;
+
+  while (len > 0) {
+    if (ent->body.empty() || ent->body.back()->left() == 0) {
+      ent->body.push_back(make_unique<Memchunk16K>(nullptr));
+    }
+
+    auto &m = ent->body.back();
+    auto n = std::min(len, m->left());
+    m->last = std::copy_n(data, n, m->last);
+    data += n;
+    len -= n;
+  }
+
+  return 0;
+}
+
+void ResponseCache::store(std::unique_ptr<CacheEntry> ent) {
+  ent->size = ent->key.size() + ent->body.size() * Memchunk16K::size;
+  for (auto &kv : ent->headers) {
+    ent->size += kv.name.size() + kv.value.size();
+  }
+  for (auto &kv : ent->vary) {
+    ent->size += kv.name.size() + kv.value.size();
+  }
+
+  if (ent->size > max_size_) {
+    return;
+  }
+
+  remove(ent->key);
+
+  size_ += ent->size;
+
+  lru_.push_front(std::move(ent));
+  index_.emplace(lru_.front()->key, std::begin(lru_));
+
+  ++stat_.stores;
+
+  evict();
+}
+
+std::shared_ptr<CacheEntry> ResponseCache::get(const std::string &key) {
+  auto it = index_.find(key);
+  if (it == std::end(index_)) {
+    return nullptr;
+  }
+
+  lru_.splice(std::begin(lru_), lru_, (*it).second);
+
+  return lru_.front();
+}
+
+void ResponseCache::remove(const std::string &key) {
+  auto it = index_.find(key);
+  if (it == std::end(index_)) {
+    return;
+  }
+
+  auto lit = (*it).second;
+
+  size_ -= (*lit)->size;
+  index_.erase(it);
+  lru_.erase(lit);
+}
+
+void ResponseCache::evict() {
+  while (size_ > max_size_ && !lru_.empty()) {
+    auto &ent = lru_.back();
+
+    size_ -= ent->size;
+    index_.erase(ent->key);
+    lru_.pop_back();
+
+    ++stat_.evictions;
+  }
+}
+
+size_t ResponseCache::get_size() const { return size_; }
+
+const ResponseCacheStat &ResponseCache::get_stat() const { return stat_; }
+
+} // namespace shrpx
@@ -0,0 +1,180 @@
+/*
+ * nghttp2 - HTTP/2 C Library
+ *
+ * Copyright (c) 2015 Tatsuhiro Tsujikawa
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef SHRPX_RESPONSE_CACHE_H
+#define SHRPX_RESPONSE_CACHE_H
+
+#include "shrpx.h"
+
+#include <string>
+#include <vector>
+#include <list>
+#include <memory>
+#include <unordered_map>
+
+#include <ev.h>
+
+#include "http2.h"
+#include "memchunk.h"
+
+using namespace nghttp2;
+
+namespace shrpx {
+
+class Downstream;
+
+// The result of cache lookup for a request.  This is shown in access
+// log as $cache_status.
+enum CacheStatus {
+  // Cache is disabled.
+  CACHE_NONE,
+  // The response was served from cache.
+  CACHE_HIT,
+  // The request was forwarded to the backend.  Its response may be
+  // stored.
+  CACHE_MISS,
+  // The request cannot be served from cache, and its response is not
+  // stored.
+  CACHE_BYPASS,
+};
+
+enum {
+  CACHE_CONTROL_NO_STORE = 1,
+  CACHE_CONTROL_NO_CACHE = 1 << 1,
+  CACHE_CONTROL_PRIVATE = 1 << 2,
+};
+
+// Cache-Control directives we are interested in.
+struct CacheControl {
+  CacheControl() : max_age(-1), s_maxage(-1), flags(0) {}
+  // -1 if the directive is absent.
+  int64_t max_age;
+  int64_t s_maxage;
+  // bitwise OR of CACHE_CONTROL_*
+  uint32_t flags;
+};
+
+struct CacheEntry {
+  CacheEntry();
+
+  // The request URI of GET request.
+  std::string key;
+  // Response header fields, excluding hop-by-hop header fields,
+  // content-length and age.  Names are lowercased.
+  Headers headers;
+  // Request header fields nominated by Vary.  The value is empty if
+  // the field was absent.
+  Headers vary;
+  std::vector<std::unique_ptr<Memchunk16K>> body;
+  size_t bodylen;
+  // The memory footprint of this entry, counted against the cache
+  // size limit.
+  size_t size;
+  // The time when the response was received.
+  ev_tstamp response_time;
+  // corrected_initial_age in RFC 7234, section 4.2.3.
+  ev_tstamp initial_age;
+  // The number of seconds this response is fresh for.
+  ev_tstamp freshness_lifetime;
+  unsigned int status;
+};
+
+struct ResponseCacheStat {
+  ResponseCacheStat() : hits(0), misses(0), evictions(0), stores(0) {}
+  size_t hits;
+  size_t misses;
+  // The number of entries removed to make room for new ones.
+  size_t evictions;
+  size_t stores;
+};
+
+// ResponseCache stores complete responses to GET requests in memory,
+// and evicts least recently used entries when the total size exceeds
+// the limit.  A stale entry is never served; it is discarded and the
+// request is forwarded to the backend.  Only one variant is kept per
+// request URI.  This object is not thread safe; each worker has its
+// own instance.
+class ResponseCache {
+public:
+  ResponseCache(struct ev_loop *loop, size_t max_size, size_t max_object_size);
+
+  // Returns fresh entry for the request |downstream|, or nullptr.  In
+  // the latter case, if the response may be stored, |downstream| is
+  // set up to capture it.  The cache status of |downstream| is
+  // updated.
+  std::shared_ptr<CacheEntry> lookup(Downstream *downstream);
+  // Returns the new entry holding the response header of
+  // |downstream|, or nullptr if the response must not be stored.
+  std::unique_ptr<CacheEntry> create_entry(Downstream *downstream) const;
+  // Appends |data| of length |len| to the body of |ent|.  This
+  // function returns -1 if the body exceeds the object size limit.
+  int append_body(CacheEntry *ent, const uint8_t *data, size_t len) const;
+  // Stores |ent|, replacing the existing entry with the same key.
+  void store(std::unique_ptr<CacheEntry> ent);
+  // Returns the entry with |key|, and makes it the most recently used
+  // one.  Freshness is not checked.
+  std::shared_ptr<CacheEntry> get(const std::string &key);
+  void remove(const std::string &key);
+
+  size_t get_size() const;
+  const ResponseCacheStat &get_stat() const;
+
+private:
+  // Returns the entry for |downstream| with |key| if it can be
+  // served.  |cc| is the request Cache-Control.
+  std::shared_ptr<CacheEntry> get_fresh(const Downstream *downstream,
+                                        const std::string &key,
+                                        const CacheControl &cc);
+  void evict();
+
+  // The most recently used entry comes first.
+  std::list<std::shared_ptr<CacheEntry>> lru_;
+  std::unordered_map<std::string,
+                     std::list<std::shared_ptr<CacheEntry>>::iterator> index_;
+  ResponseCacheStat stat_;
+  struct ev_loop *loop_;
+  size_t size_;
+  size_t max_size_;
+  size_t max_object_size_;
+};
+
+// Parses Cache-Control header fields in |headers|.  |headers| must be
+// indexed.
+CacheControl parse_cache_control(const Headers &headers);
+
+// Returns true if one of entity tags in If-None-Match header field
+// value |if_none_match| matches |etag| using weak comparison.
+bool etag_match(const std::string &if_none_match, const std::string &etag);
+
+// Returns current_age of |ent| in RFC 7234, section 4.2.3 at |now|.
+ev_tstamp get_current_age(const CacheEntry &ent, ev_tstamp now);
+
+// Returns true if the conditional request |downstream| should be
+// answered with 304 using |ent|.  This function returns false if the
+// status code of |ent| is not 200.
+bool check_not_modified(const CacheEntry &ent, const Downstream *downstream);
+
+} // namespace shrpx
+
+#endif // SHRPX_RESPONSE_CACHE_H
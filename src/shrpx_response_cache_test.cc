@@ -0,0 +1,192 @@
+/*
+ * nghttp2 - HTTP/2 C Library
+ *
+ * Copyright (c) 2015 Tatsuhiro Tsujikawa
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "shrpx_response_cache_test.h"
+
+#include <CUnit/CUnit.h>
+
+#include "shrpx_response_cache.h"
+#include "shrpx_downstream.h"
+#include "template.h"
+
+using namespace nghttp2;
+
+namespace shrpx {
+
+namespace {
+CacheControl parse(const char *value) {
+  Headers headers;
+  headers.emplace_back("cache-control", value, false, http2::HD_CACHE_CONTROL);
+  return parse_cache_control(headers);
+}
+} // namespace
+
+void test_shrpx_response_cache_parse_cache_control(void) {
+  auto cc = parse("public, max-age=3600");
+
+  CU_ASSERT(3600 == cc.max_age);
+  CU_ASSERT(-1 == cc.s_maxage);
+  CU_ASSERT(0 == cc.flags);
+
+  cc = parse("max-age=60 , S-MAXAGE=\"120\",private");
+
+  CU_ASSERT(60 == cc.max_age);
+  CU_ASSERT(120 == cc.s_maxage);
+  CU_ASSERT(CACHE_CONTROL_PRIVATE == cc.flags);
+
+  cc = parse("no-cache=\"set-cookie\", no-store");
+
+  CU_ASSERT((CACHE_CONTROL_NO_CACHE | CACHE_CONTROL_NO_STORE) == cc.flags);
+
+  // Invalid delta-seconds means that the response is already stale.
+  cc = parse("max-age=foo");
+
+  CU_ASSERT(0 == cc.max_age);
+
+  cc = parse("max-age");
+
+  CU_ASSERT(0 == cc.max_age);
+
+  // Multiple header fields are combined.
+  Headers headers;
+  headers.emplace_back("cache-control", "max-age=10", false,
+                       http2::HD_CACHE_CONTROL);
+  headers.emplace_back("x-cache-control", "no-store");
+  headers.emplace_back("cache-control", "no-cache", false,
+                       http2::HD_CACHE_CONTROL);
+
+  cc = parse_cache_control(headers);
+
+  CU_ASSERT(10 == cc.max_age);
+  CU_ASSERT(CACHE_CONTROL_NO_CACHE == cc.flags);
+}
+
+void test_shrpx_response_cache_etag_match(void) {
+  CU_ASSERT(etag_match("\"foo\"", "\"foo\""));
+  CU_ASSERT(etag_match("\"bar\", \"foo\"", "\"foo\""));
+  CU_ASSERT(etag_match("W/\"foo\"", "\"foo\""));
+  CU_ASSERT(etag_match("\"foo\"", "W/\"foo\""));
+  CU_ASSERT(etag_match("*", "\"foo\""));
+  CU_ASSERT(!etag_match("\"bar\"", "\"foo\""));
+  CU_ASSERT(!etag_match("\"foo\"", ""));
+}
+
+void test_shrpx_response_cache_check_not_modified(void) {
+  CacheEntry ent;
+  ent.status = 200;
+  ent.headers.emplace_back("etag", "\"foo\"");
+  ent.headers.emplace_back("last-modified", "Sun, 06 Nov 1994 08:49:37 GMT");
+
+  Downstream inm(nullptr, nullptr, 0, 0);
+  inm.add_request_header("if-none-match", "\"foo\"");
+  inm.index_request_headers();
+
+  Downstream ims(nullptr, nullptr, 0, 0);
+  ims.add_request_header("if-modified-since",
+                         "Sun, 06 Nov 1994 08:49:37 GMT");
+  ims.index_request_headers();
+
+  Downstream plain(nullptr, nullptr, 0, 0);
+  plain.index_request_headers();
+
+  CU_ASSERT(check_not_modified(ent, &inm));
+  CU_ASSERT(check_not_modified(ent, &ims));
+  CU_ASSERT(!check_not_modified(ent, &plain));
+
+  // Cached 404 is sent as is even if validators match.
+  ent.status = 404;
+
+  CU_ASSERT(!check_not_modified(ent, &inm));
+  CU_ASSERT(!check_not_modified(ent, &ims));
+}
+
+namespace {
+std::unique_ptr<CacheEntry> make_entry(const std::string &key) {
+  auto ent = make_unique<CacheEntry>();
+  ent->key = key;
+  ent->status = 200;
+  return ent;
+}
+} // namespace
+
+void test_shrpx_response_cache_lru(void) {
+  // Each entry has 1 chunk of body.
+  ResponseCache cache(EV_DEFAULT, 3 * (Memchunk16K::size + 2), 1_m);
+
+  const char *keys[] = {"/a", "/b", "/c", "/d"};
+
+  for (size_t i = 0; i < 3; ++i) {
+    auto ent = make_entry(keys[i]);
+    auto rv =
+        cache.append_body(ent.get(), reinterpret_cast<const uint8_t *>("x"), 1);
+    CU_ASSERT(0 == rv);
+    cache.store(std::move(ent));
+  }
+
+  CU_ASSERT(3 == cache.get_stat().stores);
+  CU_ASSERT(3 * (Memchunk16K::size + 2) == cache.get_size());
+
+  // "/a" becomes the most recently used one, and "/b" is evicted.
+  CU_ASSERT(nullptr != cache.get("/a"));
+
+  auto ent = make_entry("/d");
+  cache.append_body(ent.get(), reinterpret_cast<const uint8_t *>("x"), 1);
+  cache.store(std::move(ent));
+
+  CU_ASSERT(1 == cache.get_stat().evictions);
+  CU_ASSERT(nullptr == cache.get("/b"));
+  CU_ASSERT(nullptr != cache.get("/a"));
+  CU_ASSERT(nullptr != cache.get("/c"));
+  CU_ASSERT(nullptr != cache.get("/d"));
+
+  // Replacing entry is not eviction.
+  cache.store(make_entry("/c"));
+
+  CU_ASSERT(1 == cache.get_stat().evictions);
+  CU_ASSERT(0 == cache.get("/c")->bodylen);
+  CU_ASSERT(2 * (Memchunk16K::size + 2) + 2 == cache.get_size());
+
+  // Entry larger than the cache is not stored.
+  ent = make_entry("/e");
+  for (size_t i = 0; i < 4; ++i) {
+    std::array<uint8_t, Memchunk16K::size> buf{};
+    cache.append_body(ent.get(), buf.data(), buf.size());
+  }
+  cache.store(std::move(ent));
+
+  CU_ASSERT(nullptr == cache.get("/e"));
+  CU_ASSERT(5 == cache.get_stat().stores);
+
+  // Body larger than the object size limit is rejected.
+  ResponseCache small_cache(EV_DEFAULT, 1_m, 10);
+  ent = make_entry("/f");
+
+  CU_ASSERT(0 == small_cache.append_body(
+                     ent.get(), reinterpret_cast<const uint8_t *>("0123456789"),
+                     10));
+  CU_ASSERT(-1 == small_cache.append_body(
+                      ent.get(), reinterpret_cast<const uint8_t *>("a"), 1));
+}
+
+} // namespace shrpx
@@ -0,0 +1,142 @@
+/*
+ * nghttp2 - HTTP/2 C Library
+ *
+ * Copyright (c) 2015 Tatsuhiro Tsujikawa
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "shrpx_router.h"
+
+#include <algorithm>
+
+#include "util.h"
+#include "template.h"
+
+using namespace nghttp2;
+
+namespace shrpx {
+
+RNode::RNode(char c) : index(-1), c(c) {}
+
+Router::Router() : root_('\0') {}
+
+namespace {
+std::vector<std::unique_ptr<RNode>>::const_iterator
+lower_bound(const RNode *node, char c) {
+  return std::lower_bound(
+      std::begin(node->next), std::end(node->next), c,
+      [](const std::unique_ptr<RNode> &lhs, char c) { return lhs->c < c; });
+}
+} // namespace
+
+namespace {
+const RNode *find_next_node(const RNode *node, char c) {
+  auto it = lower_bound(node, c);
+  if (it == std::end(node->next) || (*it)->c != c) {
+    return nullptr;
+  }
+  return (*it).get();
+}
+} // namespace
+
+bool Router::add_route(const char *pattern, size_t patlen, size_t index) {
+  auto node = &root_;
+
+  for (size_t i = 0; i < patlen; ++i) {
+    auto c = pattern[i];
+    auto it = lower_bound(node, c);
+    if (it != std::end(node->next) && (*it)->c == c) {
+      node = (*it).get();
+      continue;
+    }
+
+    auto pos = it - std::begin(node->next);
+    node->next.insert(std::begin(node->next) + pos, make_unique<RNode>(c));
+    node = node->next[pos].get();
+  }
+
+  if (node->index != -1) {
+    return false;
+  }
+
+  node->index = index;
+
+  return true;
+}
+
+ssize_t Router::match_key(const char *host, size_t hostlen, const char *path,
+                          size_t pathlen) const {
+  ssize_t found = -1;
+  const RNode *node = &root_;
+
+  for (size_t i = 0; i < hostlen; ++i) {
+    node = find_next_node(node, util::lowcase(host[i]));
+    if (!node) {
+      return -1;
+    }
+  }
+
+  for (size_t i = 0; i < pathlen; ++i) {
+    node = find_next_node(node, path[i]);
+    if (!node) {
+      return found;
+    }
+    // The pattern ending with "/" matches its subtree.
+    if (node->c == '/' && node->index != -1) {
+      found = node->index;
+    }
+  }
+
+  if (node->index != -1) {
+    return node->index;
+  }
+
+  // The pattern "/foo/" also matches "/foo".
+  node = find_next_node(node, '/');
+  if (node && node->index != -1) {
+    return node->index;
+  }
+
+  return found;
+}
+
+ssize_t Router::match(const char *host, size_t hostlen, const char *path,
+                      size_t pathlen) const {
+  // Patterns never have port.  Keep the brackets around IPv6 address.
+  if (hostlen && host[0] == '[') {
+    auto end = std::find(host, host + hostlen, ']');
+    if (end != host + hostlen) {
+      hostlen = end + 1 - host;
+    }
+  } else {
+    hostlen = std::find(host, host + hostlen, ':') - host;
+  }
+
+  if (hostlen) {
+    auto idx = match_key(host, hostlen, path, pathlen);
+    if (idx != -1) {
+      return idx;
+    }
+  }
+
+  return match_key(nullptr, 0, path, pathlen);
+}
+
+} // namespace shrpx
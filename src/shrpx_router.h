@@ -0,0 +1,81 @@
+/*
+ * nghttp2 - HTTP/2 C Library
+ *
+ * Copyright (c) 2015 Tatsuhiro Tsujikawa
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef SHRPX_ROUTER_H
+#define SHRPX_ROUTER_H
+
+#include "shrpx.h"
+
+#include <vector>
+#include <memory>
+
+namespace shrpx {
+
+struct RNode {
+  RNode(char c);
+  // Children sorted by |c|.
+  std::vector<std::unique_ptr<RNode>> next;
+  // The index of the pattern which ends at this node.  -1 if no
+  // pattern ends here.
+  ssize_t index;
+  // The character of the edge from the parent node.
+  char c;
+};
+
+// Router finds the pattern which matches the request host and path.
+// The patterns are compiled into a trie, so that a lookup takes time
+// proportional to the length of host and path, regardless of the
+// number of patterns.
+//
+// A pattern is host followed by path, or just path.  Host must be in
+// lower case.  The path must start with "/".  If the path ends with
+// "/", it matches all request paths in its subtree, and the request
+// path which only lacks the trailing "/".  Otherwise, it matches the
+// request path exactly.  The longest match wins, and the patterns
+// with host take precedence over the patterns with just path.
+class Router {
+public:
+  Router();
+
+  // Adds route |pattern| of length |patlen| with its |index|.  This
+  // function returns false if the same pattern has already been
+  // added.
+  bool add_route(const char *pattern, size_t patlen, size_t index);
+  // Returns the index of the pattern which matches the request with
+  // |host| and |path|.  |host| is compared case-insensitively, and
+  // may be empty.  The port in |host|, if any, is ignored.  This
+  // function returns -1 if no pattern matches.
+  ssize_t match(const char *host, size_t hostlen, const char *path,
+                size_t pathlen) const;
+
+private:
+  ssize_t match_key(const char *host, size_t hostlen, const char *path,
+                    size_t pathlen) const;
+
+  RNode root_;
+};
+
+} // namespace shrpx
+
+#endif // SHRPX_ROUTER_H
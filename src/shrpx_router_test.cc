@@ -0,0 +1,93 @@
+/*
+ * nghttp2 - HTTP/2 C Library
+ *
+ * Copyright (c) 2015 Tatsuhiro Tsujikawa
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "shrpx_router_test.h"
+
+#include <CUnit/CUnit.h>
+
+#include "shrpx_router.h"
+#include "template.h"
+
+using namespace nghttp2;
+
+namespace shrpx {
+
+namespace {
+ssize_t match(const Router &router, const char *host, const char *path) {
+  return router.match(host, strlen(host), path, strlen(path));
+}
+} // namespace
+
+void test_shrpx_router_match(void) {
+  Router router;
+
+  const char *patterns[] = {"/",
+                            "/alpha",
+                            "/alpha/bravo/",
+                            "/alpha/charlie/",
+                            "nghttp2.org/",
+                            "nghttp2.org/alpha",
+                            "www.nghttp2.org/alpha/"};
+
+  for (size_t i = 0; i < array_size(patterns); ++i) {
+    CU_ASSERT(router.add_route(patterns[i], strlen(patterns[i]), i));
+  }
+
+  CU_ASSERT(!router.add_route("/alpha", str_size("/alpha"), 100));
+
+  CU_ASSERT(0 == match(router, "", "/"));
+  CU_ASSERT(0 == match(router, "", "/index.html"));
+  CU_ASSERT(1 == match(router, "", "/alpha"));
+  CU_ASSERT(0 == match(router, "", "/alpha/"));
+  CU_ASSERT(0 == match(router, "", "/alphabet"));
+  CU_ASSERT(2 == match(router, "", "/alpha/bravo"));
+  CU_ASSERT(2 == match(router, "", "/alpha/bravo/"));
+  CU_ASSERT(2 == match(router, "", "/alpha/bravo/delta"));
+  CU_ASSERT(0 == match(router, "", "/alpha/brav"));
+  CU_ASSERT(3 == match(router, "", "/alpha/charlie/x"));
+  CU_ASSERT(0 == match(router, "", "/alpha/delta"));
+
+  CU_ASSERT(4 == match(router, "nghttp2.org", "/"));
+  CU_ASSERT(4 == match(router, "NGHTTP2.ORG", "/alpha/bravo/"));
+  CU_ASSERT(5 == match(router, "nghttp2.org", "/alpha"));
+  CU_ASSERT(6 == match(router, "www.nghttp2.org", "/alpha/"));
+  CU_ASSERT(6 == match(router, "www.nghttp2.org", "/alpha"));
+  CU_ASSERT(6 == match(router, "www.nghttp2.org", "/alpha/bravo/"));
+  CU_ASSERT(0 == match(router, "www.nghttp2.org", "/"));
+  CU_ASSERT(0 == match(router, "example.com", "/"));
+  CU_ASSERT(1 == match(router, "nghttp2.or", "/alpha"));
+
+  CU_ASSERT(5 == match(router, "nghttp2.org:3000", "/alpha"));
+  CU_ASSERT(6 == match(router, "www.nghttp2.org:443", "/alpha/"));
+  CU_ASSERT(4 == match(router, "nghttp2.org:", "/"));
+  CU_ASSERT(1 == match(router, "[::1]:3000", "/alpha"));
+  CU_ASSERT(1 == match(router, "[::1", "/alpha"));
+  CU_ASSERT(1 == match(router, ":3000", "/alpha"));
+
+  Router norouter;
+
+  CU_ASSERT(-1 == match(norouter, "", "/"));
+}
+
+} // namespace shrpx
@@ -36,6 +36,9 @@
 #include "shrpx_http2_session.h"
 #include "shrpx_log_config.h"
 #include "shrpx_connect_blocker.h"
+#include "shrpx_health_checker.h"
+#include "shrpx_accept_handler.h"
+#include "shrpx_response_cache.h"
 #include "util.h"
 #include "template.h"
 
@@ -58,12 +61,33 @@ void mcpool_clear_cb(struct ev_loop *loop, ev_timer *w, int revents) {
 }
 } // namespace
 
+namespace {
+void acceptor_disable_cb(struct ev_loop *loop, ev_timer *w, int revent) {
+  auto worker = static_cast<Worker *>(w->data);
+
+  // If we are in graceful shutdown period, we must not enable
+  // acceptors again.
+  if (worker->get_graceful_shutdown()) {
+    return;
+  }
+
+  worker->enable_acceptor();
+}
+} // namespace
+
+DownstreamGroup::DownstreamGroup(struct ev_loop *loop, size_t naddrs,
+                                 size_t nsessions)
+    : addr_balancer(loop, get_config()->backend_balance, naddrs),
+      http2session_balancer(loop, get_config()->backend_balance, nsessions) {
+}
+
+DownstreamGroup::~DownstreamGroup() {}
+
 Worker::Worker(struct ev_loop *loop, SSL_CTX *sv_ssl_ctx, SSL_CTX *cl_ssl_ctx,
                ssl::CertLookupTree *cert_tree,
                const std::shared_ptr<TicketKeys> &ticket_keys)
-    : next_http2session_(0), loop_(loop), sv_ssl_ctx_(sv_ssl_ctx),
-      cl_ssl_ctx_(cl_ssl_ctx), cert_tree_(cert_tree), ticket_keys_(ticket_keys),
-      connect_blocker_(make_unique<ConnectBlocker>(loop_)),
+    : loop_(loop), sv_ssl_ctx_(sv_ssl_ctx), cl_ssl_ctx_(cl_ssl_ctx),
+      cert_tree_(cert_tree), ticket_keys_(ticket_keys),
       graceful_shutdown_(false) {
   ev_async_init(&w_, eventcb);
   w_.data = this;
@@ -72,18 +96,59 @@ Worker::Worker(struct ev_loop *loop, SSL_CTX *sv_ssl_ctx, SSL_CTX *cl_ssl_ctx,
   ev_timer_init(&mcpool_clear_timer_, mcpool_clear_cb, 0., 0.);
   mcpool_clear_timer_.data = this;
 
-  if (get_config()->downstream_proto == PROTO_HTTP2) {
-    auto n = get_config()->http2_downstream_connections_per_worker;
-    for (; n > 0; --n) {
-      http2sessions_.push_back(make_unique<Http2Session>(
-          loop_, cl_ssl_ctx, connect_blocker_.get(), this));
+  ev_timer_init(&disable_acceptor_timer_, acceptor_disable_cb, 0., 0.);
+  disable_acceptor_timer_.data = this;
+
+  auto &groups = get_config()->downstream_addr_groups;
+
+  for (size_t group = 0; group < groups.size(); ++group) {
+    auto naddrs = groups[group].addrs.size();
+    size_t nsessions = 0;
+
+    if (get_config()->downstream_proto == PROTO_HTTP2) {
+      // 0 means the number of backend addresses in the group.
+      nsessions = get_config()->http2_downstream_connections_per_worker;
+      if (nsessions == 0) {
+        nsessions = naddrs;
+      }
+    }
+
+    auto dgrp = make_unique<DownstreamGroup>(loop_, naddrs, nsessions);
+
+    for (size_t i = 0; i < naddrs; ++i) {
+      dgrp->connect_blockers.push_back(make_unique<ConnectBlocker>(loop_));
+    }
+
+    for (size_t i = 0; i < nsessions; ++i) {
+      dgrp->http2sessions.push_back(
+          make_unique<Http2Session>(loop_, cl_ssl_ctx, this, group, i));
     }
+
+    if (get_config()->downstream_health_check_interval > 0.) {
+      auto ssl_ctx =
+          get_config()->downstream_proto == PROTO_HTTP2 ? cl_ssl_ctx : nullptr;
+      for (size_t i = 0; i < naddrs; ++i) {
+        dgrp->health_checkers.push_back(make_unique<HealthChecker>(
+            loop_, ssl_ctx, &dgrp->addr_balancer, group, i));
+      }
+    }
+
+    dgrps_.push_back(std::move(dgrp));
+  }
+
+  if (get_config()->response_cache_size > 0) {
+    response_cache_ = make_unique<ResponseCache>(
+        loop_, get_config()->response_cache_size,
+        get_config()->response_cache_max_object_size);
   }
 }
 
 Worker::~Worker() {
   ev_async_stop(loop_, &w_);
   ev_timer_stop(loop_, &mcpool_clear_timer_);
+  ev_timer_stop(loop_, &disable_acceptor_timer_);
+
+  log_response_cache_stat();
 }
 
 void Worker::schedule_clear_mcpool() {
@@ -132,32 +197,8 @@ void Worker::process_events() {
                          << ", addrlen=" << wev.client_addrlen;
       }
 
-      if (worker_stat_.num_connections >=
-          get_config()->worker_frontend_connections) {
-
-        if (LOG_ENABLED(INFO)) {
-          WLOG(INFO, this) << "Too many connections >= "
-                           << get_config()->worker_frontend_connections;
-        }
-
-        close(wev.client_fd);
-
-        break;
-      }
-
-      auto client_handler = ssl::accept_connection(
-          this, wev.client_fd, &wev.client_addr.sa, wev.client_addrlen);
-      if (!client_handler) {
-        if (LOG_ENABLED(INFO)) {
-          WLOG(ERROR, this) << "ClientHandler creation failed";
-        }
-        close(wev.client_fd);
-        break;
-      }
-
-      if (LOG_ENABLED(INFO)) {
-        WLOG(INFO, this) << "CLIENT_HANDLER:" << client_handler << " created ";
-      }
+      handle_connection(wev.client_fd, &wev.client_addr.sa,
+                        wev.client_addrlen);
 
       break;
     }
@@ -171,11 +212,17 @@ void Worker::process_events() {
       WLOG(NOTICE, this) << "Reopening log files: worker(" << this << ")";
 
       reopen_log_files();
+      log_response_cache_stat();
 
       break;
     case GRACEFUL_SHUTDOWN:
       WLOG(NOTICE, this) << "Graceful shutdown commencing";
 
+      // Stop accepting new connection, and take connections in
+      // backlog before entering graceful shutdown period.
+      disable_acceptor();
+      accept_pending_connection();
+
       graceful_shutdown_ = true;
 
       if (worker_stat_.num_connections == 0) {
@@ -193,6 +240,69 @@ void Worker::process_events() {
   }
 }
 
+int Worker::handle_connection(int fd, sockaddr *addr, int addrlen) {
+  if (worker_stat_.num_connections >=
+      get_config()->worker_frontend_connections) {
+
+    if (LOG_ENABLED(INFO)) {
+      WLOG(INFO, this) << "Too many connections >= "
+                       << get_config()->worker_frontend_connections;
+    }
+
+    close(fd);
+
+    return -1;
+  }
+
+  auto client_handler = ssl::accept_connection(this, fd, addr, addrlen);
+  if (!client_handler) {
+    if (LOG_ENABLED(INFO)) {
+      WLOG(ERROR, this) << "ClientHandler creation failed";
+    }
+    close(fd);
+    return -1;
+  }
+
+  if (LOG_ENABLED(INFO)) {
+    WLOG(INFO, this) << "CLIENT_HANDLER:" << client_handler << " created ";
+  }
+
+  return 0;
+}
+
+void Worker::add_acceptor(std::unique_ptr<AcceptHandler> h) {
+  acceptors_.push_back(std::move(h));
+}
+
+void Worker::enable_acceptor() {
+  for (auto &acceptor : acceptors_) {
+    acceptor->enable();
+  }
+}
+
+void Worker::disable_acceptor() {
+  for (auto &acceptor : acceptors_) {
+    acceptor->disable();
+  }
+}
+
+void Worker::disable_acceptor_temporary(ev_tstamp t) {
+  if (t == 0. || ev_is_active(&disable_acceptor_timer_)) {
+    return;
+  }
+
+  disable_acceptor();
+
+  ev_timer_set(&disable_acceptor_timer_, t, 0.);
+  ev_timer_start(loop_, &disable_acceptor_timer_);
+}
+
+void Worker::accept_pending_connection() {
+  for (auto &acceptor : acceptors_) {
+    acceptor->accept_connection();
+  }
+}
+
 ssl::CertLookupTree *Worker::get_cert_lookup_tree() const { return cert_tree_; }
 
 const std::shared_ptr<TicketKeys> &Worker::get_ticket_keys() const {
@@ -205,24 +315,31 @@ void Worker::set_ticket_keys(std::shared_ptr<TicketKeys> ticket_keys) {
 
 WorkerStat *Worker::get_worker_stat() { return &worker_stat_; }
 
-DownstreamConnectionPool *Worker::get_dconn_pool() { return &dconn_pool_; }
+DownstreamConnectionPool *Worker::get_dconn_pool(size_t group) {
+  return &dgrps_[group]->dconn_pool;
+}
 
-Http2Session *Worker::next_http2_session() {
-  if (http2sessions_.empty()) {
+Http2Session *Worker::next_http2_session(size_t group) {
+  auto &dgrp = dgrps_[group];
+
+  if (dgrp->http2sessions.empty()) {
     return nullptr;
   }
 
-  auto res = http2sessions_[next_http2session_].get();
-  ++next_http2session_;
-  if (next_http2session_ >= http2sessions_.size()) {
-    next_http2session_ = 0;
-  }
+  return dgrp->http2sessions[dgrp->http2session_balancer.select()].get();
+}
+
+LoadBalancer *Worker::get_addr_balancer(size_t group) {
+  return &dgrps_[group]->addr_balancer;
+}
 
-  return res;
+LoadBalancer *Worker::get_http2session_balancer(size_t group) {
+  return &dgrps_[group]->http2session_balancer;
 }
 
-ConnectBlocker *Worker::get_connect_blocker() const {
-  return connect_blocker_.get();
+ConnectBlocker *Worker::get_connect_blocker(size_t group,
+                                            size_t addr_idx) const {
+  return dgrps_[group]->connect_blockers[addr_idx].get();
 }
 
 struct ev_loop *Worker::get_loop() const {
@@ -239,4 +356,21 @@ bool Worker::get_graceful_shutdown() const { return graceful_shutdown_; }
 
 MemchunkPool *Worker::get_mcpool() { return &mcpool_; }
 
+void Worker::log_response_cache_stat() {
+  if (!response_cache_) {
+    return;
+  }
+
+  auto &stat = response_cache_->get_stat();
+  WLOG(NOTICE, this) << "Response cache: hits=" << stat.hits
+                     << ", misses=" << stat.misses
+                     << ", evictions=" << stat.evictions
+                     << ", stores=" << stat.stores
+                     << ", size=" << response_cache_->get_size();
+}
+
+ResponseCache *Worker::get_response_cache() const {
+  return response_cache_.get();
+}
+
 } // namespace shrpx
@@ -41,6 +41,7 @@
 
 #include "shrpx_config.h"
 #include "shrpx_downstream_connection_pool.h"
+#include "shrpx_load_balancer.h"
 #include "memchunk.h"
 
 using namespace nghttp2;
@@ -49,19 +50,38 @@ namespace shrpx {
 
 class Http2Session;
 class ConnectBlocker;
+class AcceptHandler;
+class HealthChecker;
+class ResponseCache;
 
 namespace ssl {
 class CertLookupTree;
 } // namespace ssl
 
+// Per worker state of a backend address group.  The index of
+// |connect_blockers| and |health_checkers| is the index of
+// DownstreamAddrGroup::addrs.
+struct DownstreamGroup {
+  DownstreamGroup(struct ev_loop *loop, size_t naddrs, size_t nsessions);
+  ~DownstreamGroup();
+
+  // Load balancers are declared first, so that they outlive
+  // downstream connections which refer to them.
+  LoadBalancer addr_balancer;
+  // Chooses HTTP/2 backend session.  The index is
+  // Http2Session::get_index().
+  LoadBalancer http2session_balancer;
+  std::vector<std::unique_ptr<Http2Session>> http2sessions;
+  DownstreamConnectionPool dconn_pool;
+  std::vector<std::unique_ptr<ConnectBlocker>> connect_blockers;
+  // Empty if health check is disabled.
+  std::vector<std::unique_ptr<HealthChecker>> health_checkers;
+};
+
 struct WorkerStat {
-  WorkerStat() : num_connections(0), next_downstream(0) {}
+  WorkerStat() : num_connections(0) {}
 
   size_t num_connections;
-  // Next downstream index in Config::downstream_addrs.  For HTTP/2
-  // downstream connections, this is always 0.  For HTTP/1, this is
-  // used as load balancing.
-  size_t next_downstream;
 };
 
 enum WorkerEventType {
@@ -91,14 +111,35 @@ public:
   void wait();
   void process_events();
   void send(const WorkerEvent &event);
+  // Creates ClientHandler for accepted connection |fd|.  Returns 0 if
+  // it succeeds, or -1.  |fd| is closed on failure.
+  int handle_connection(int fd, sockaddr *addr, int addrlen);
+
+  // Adds listening socket this worker accepts connections from.  This
+  // must be called before run_async().
+  void add_acceptor(std::unique_ptr<AcceptHandler> h);
+  void enable_acceptor();
+  void disable_acceptor();
+  void disable_acceptor_temporary(ev_tstamp t);
+  void accept_pending_connection();
 
   ssl::CertLookupTree *get_cert_lookup_tree() const;
   const std::shared_ptr<TicketKeys> &get_ticket_keys() const;
   void set_ticket_keys(std::shared_ptr<TicketKeys> ticket_keys);
   WorkerStat *get_worker_stat();
-  DownstreamConnectionPool *get_dconn_pool();
-  Http2Session *next_http2_session();
-  ConnectBlocker *get_connect_blocker() const;
+  // The following functions take the index of
+  // Config::downstream_addr_groups as |group|.
+  DownstreamConnectionPool *get_dconn_pool(size_t group);
+  Http2Session *next_http2_session(size_t group);
+  // Returns LoadBalancer to choose index of
+  // DownstreamAddrGroup::addrs.
+  LoadBalancer *get_addr_balancer(size_t group);
+  // Returns LoadBalancer to choose HTTP/2 backend session.  The
+  // index is Http2Session::get_index().
+  LoadBalancer *get_http2session_balancer(size_t group);
+  // Returns ConnectBlocker for backend address |addr_idx| in
+  // |group|.
+  ConnectBlocker *get_connect_blocker(size_t group, size_t addr_idx) const;
   struct ev_loop *get_loop() const;
   SSL_CTX *get_sv_ssl_ctx() const;
   SSL_CTX *get_cl_ssl_ctx() const;
@@ -109,9 +150,13 @@ public:
   MemchunkPool *get_mcpool();
   void schedule_clear_mcpool();
 
+  // Returns nullptr if response cache is disabled.
+  ResponseCache *get_response_cache() const;
+  // Logs hits, misses and evictions of response cache so far.  Does
+  // nothing if response cache is disabled.
+  void log_response_cache_stat();
+
 private:
-  std::vector<std::unique_ptr<Http2Session>> http2sessions_;
-  size_t next_http2session_;
 #ifndef NOTHREADS
   std::future<void> fut_;
 #endif // NOTHREADS
@@ -119,8 +164,16 @@ private:
   std::vector<WorkerEvent> q_;
   ev_async w_;
   ev_timer mcpool_clear_timer_;
+  ev_timer disable_acceptor_timer_;
+  // Listening sockets owned by this worker.  Empty unless --reuseport
+  // is used.
+  std::vector<std::unique_ptr<AcceptHandler>> acceptors_;
   MemchunkPool mcpool_;
-  DownstreamConnectionPool dconn_pool_;
+  // Indexed by Config::downstream_addr_groups index.  This is
+  // declared after mcpool_, so that pooled connections are destroyed
+  // first.
+  std::vector<std::unique_ptr<DownstreamGroup>> dgrps_;
+  std::unique_ptr<ResponseCache> response_cache_;
   WorkerStat worker_stat_;
   struct ev_loop *loop_;
 
@@ -131,7 +184,6 @@ private:
   ssl::CertLookupTree *cert_tree_;
 
   std::shared_ptr<TicketKeys> ticket_keys_;
-  std::unique_ptr<ConnectBlocker> connect_blocker_;
 
   bool graceful_shutdown_;
 };
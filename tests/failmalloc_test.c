@@ -114,7 +114,7 @@ static ssize_t fixed_length_data_source_read_callback(
     nghttp2_failmalloc = 0;                                                    \
   } while (0)
 
-static void run_nghttp2_session_send(void) {
+static void session_send_with_option(const nghttp2_option *option) {
   nghttp2_session *session;
   nghttp2_session_callbacks callbacks;
   nghttp2_nv nv[] = {MAKE_NV(":host", "example.org"),
@@ -134,7 +134,7 @@ static void run_nghttp2_session_send(void) {
   iv[1].settings_id = NGHTTP2_SETTINGS_MAX_CONCURRENT_STREAMS;
   iv[1].value = 100;
 
-  rv = nghttp2_session_client_new3(&session, &callbacks, &ud, NULL,
+  rv = nghttp2_session_client_new3(&session, &callbacks, &ud, option,
                                    nghttp2_mem_fm());
   if (rv != 0) {
     goto client_new_fail;
@@ -213,8 +213,24 @@ client_new_fail:
   ;
 }
 
+static void run_nghttp2_session_send(void) { session_send_with_option(NULL); }
+
+static void run_nghttp2_session_send_slab(void) {
+  nghttp2_option *option;
+
+  /* nghttp2_option_new() does not use failmalloc */
+  nghttp2_option_new(&option);
+  /* Small slab, so that slab allocation happens several times */
+  nghttp2_option_set_slab_size(option, 2);
+
+  session_send_with_option(option);
+
+  nghttp2_option_del(option);
+}
+
 void test_nghttp2_session_send(void) {
   TEST_FAILMALLOC_RUN(run_nghttp2_session_send);
+  TEST_FAILMALLOC_RUN(run_nghttp2_session_send_slab);
 }
 
 static void run_nghttp2_session_recv(void) {
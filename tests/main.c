@@ -40,6 +40,7 @@
 #include "nghttp2_npn_test.h"
 #include "nghttp2_helper_test.h"
 #include "nghttp2_buf_test.h"
+#include "nghttp2_mempool_test.h"
 
 extern int nghttp2_enable_strict_preface;
 
@@ -67,10 +68,13 @@ int main(int argc _U_, char *argv[] _U_) {
   /* add the tests to the suite */
   if (!CU_add_test(pSuite, "pq", test_nghttp2_pq) ||
       !CU_add_test(pSuite, "pq_update", test_nghttp2_pq_update) ||
+      !CU_add_test(pSuite, "pq_remove", test_nghttp2_pq_remove) ||
       !CU_add_test(pSuite, "map", test_nghttp2_map) ||
       !CU_add_test(pSuite, "map_functional", test_nghttp2_map_functional) ||
+      !CU_add_test(pSuite, "map_random", test_nghttp2_map_random) ||
       !CU_add_test(pSuite, "map_each_free", test_nghttp2_map_each_free) ||
       !CU_add_test(pSuite, "queue", test_nghttp2_queue) ||
+      !CU_add_test(pSuite, "mempool", test_nghttp2_mempool) ||
       !CU_add_test(pSuite, "npn", test_nghttp2_npn) ||
       !CU_add_test(pSuite, "session_recv", test_nghttp2_session_recv) ||
       !CU_add_test(pSuite, "session_recv_invalid_stream_id",
@@ -80,6 +84,8 @@ int main(int argc _U_, char *argv[] _U_) {
       !CU_add_test(pSuite, "session_recv_eof", test_nghttp2_session_recv_eof) ||
       !CU_add_test(pSuite, "session_recv_data",
                    test_nghttp2_session_recv_data) ||
+      !CU_add_test(pSuite, "session_recv_control_frame_burst",
+                   test_nghttp2_session_recv_control_frame_burst) ||
       !CU_add_test(pSuite, "session_recv_data_no_auto_flow_control",
                    test_nghttp2_session_recv_data_no_auto_flow_control) ||
       !CU_add_test(pSuite, "session_recv_continuation",
@@ -177,6 +183,8 @@ int main(int argc _U_, char *argv[] _U_) {
                    test_nghttp2_submit_window_update) ||
       !CU_add_test(pSuite, "submit_window_update_local_window_size",
                    test_nghttp2_submit_window_update_local_window_size) ||
+      !CU_add_test(pSuite, "session_window_update_coalescing",
+                   test_nghttp2_session_window_update_coalescing) ||
       !CU_add_test(pSuite, "submit_shutdown_notice",
                    test_nghttp2_submit_shutdown_notice) ||
       !CU_add_test(pSuite, "submit_invalid_nv",
@@ -240,8 +248,14 @@ int main(int argc _U_, char *argv[] _U_) {
                    test_nghttp2_session_stream_attach_item) ||
       !CU_add_test(pSuite, "session_stream_attach_item_subtree",
                    test_nghttp2_session_stream_attach_item_subtree) ||
+      !CU_add_test(pSuite, "session_stream_bandwidth_share",
+                   test_nghttp2_session_stream_bandwidth_share) ||
       !CU_add_test(pSuite, "session_stream_keep_closed_stream",
                    test_nghttp2_session_keep_closed_stream) ||
+      !CU_add_test(pSuite, "session_promote_tombstone",
+                   test_nghttp2_session_promote_tombstone) ||
+      !CU_add_test(pSuite, "session_memory_budget",
+                   test_nghttp2_session_memory_budget) ||
       !CU_add_test(pSuite, "session_stream_keep_idle_stream",
                    test_nghttp2_session_keep_idle_stream) ||
       !CU_add_test(pSuite, "session_detach_idle_stream",
@@ -264,10 +278,22 @@ int main(int argc _U_, char *argv[] _U_) {
                    test_nghttp2_session_reset_pending_headers) ||
       !CU_add_test(pSuite, "session_send_data_callback",
                    test_nghttp2_session_send_data_callback) ||
+      !CU_add_test(pSuite, "session_mem_sendv",
+                   test_nghttp2_session_mem_sendv) ||
+      !CU_add_test(pSuite, "session_get_stats",
+                   test_nghttp2_session_get_stats) ||
+      !CU_add_test(pSuite, "session_window_auto_tuning",
+                   test_nghttp2_session_window_auto_tuning) ||
       !CU_add_test(pSuite, "session_on_begin_headers_temporal_failure",
                    test_nghttp2_session_on_begin_headers_temporal_failure) ||
+      !CU_add_test(pSuite, "session_on_header_callback2",
+                   test_nghttp2_session_on_header_callback2) ||
+      !CU_add_test(pSuite, "session_slab", test_nghttp2_session_slab) ||
       !CU_add_test(pSuite, "session_defer_then_close",
                    test_nghttp2_session_defer_then_close) ||
+      !CU_add_test(pSuite, "session_submission_queue",
+                   test_nghttp2_session_submission_queue) ||
+      !CU_add_test(pSuite, "session_reset", test_nghttp2_session_reset) ||
       !CU_add_test(pSuite, "http_mandatory_headers",
                    test_nghttp2_http_mandatory_headers) ||
       !CU_add_test(pSuite, "http_content_length",
@@ -326,23 +352,37 @@ int main(int argc _U_, char *argv[] _U_) {
                    test_nghttp2_hd_inflate_clearall_inc) ||
       !CU_add_test(pSuite, "hd_inflate_zero_length_huffman",
                    test_nghttp2_hd_inflate_zero_length_huffman) ||
+      !CU_add_test(pSuite, "hd_inflate_ref", test_nghttp2_hd_inflate_ref) ||
       !CU_add_test(pSuite, "hd_ringbuf_reserve",
                    test_nghttp2_hd_ringbuf_reserve) ||
       !CU_add_test(pSuite, "hd_change_table_size",
                    test_nghttp2_hd_change_table_size) ||
       !CU_add_test(pSuite, "hd_deflate_inflate",
                    test_nghttp2_hd_deflate_inflate) ||
+      !CU_add_test(pSuite, "hd_deflate_large_table",
+                   test_nghttp2_hd_deflate_large_table) ||
       !CU_add_test(pSuite, "hd_no_index", test_nghttp2_hd_no_index) ||
       !CU_add_test(pSuite, "hd_deflate_bound", test_nghttp2_hd_deflate_bound) ||
       !CU_add_test(pSuite, "hd_public_api", test_nghttp2_hd_public_api) ||
       !CU_add_test(pSuite, "hd_decode_length", test_nghttp2_hd_decode_length) ||
       !CU_add_test(pSuite, "hd_huff_encode", test_nghttp2_hd_huff_encode) ||
+      !CU_add_test(pSuite, "hd_huff_encode_count_bounded",
+                   test_nghttp2_hd_huff_encode_count_bounded) ||
+      !CU_add_test(pSuite, "hd_huff_decode", test_nghttp2_hd_huff_decode) ||
+      !CU_add_test(pSuite, "hd_deflate_indexing_strategy",
+                   test_nghttp2_hd_deflate_indexing_strategy) ||
+      !CU_add_test(pSuite, "hd_deflate_string_cache",
+                   test_nghttp2_hd_deflate_string_cache) ||
       !CU_add_test(pSuite, "adjust_local_window_size",
                    test_nghttp2_adjust_local_window_size) ||
       !CU_add_test(pSuite, "check_header_name",
                    test_nghttp2_check_header_name) ||
+      !CU_add_test(pSuite, "check_header_name_long",
+                   test_nghttp2_check_header_name_long) ||
       !CU_add_test(pSuite, "check_header_value",
                    test_nghttp2_check_header_value) ||
+      !CU_add_test(pSuite, "check_header_value_long",
+                   test_nghttp2_check_header_value_long) ||
       !CU_add_test(pSuite, "bufs_add", test_nghttp2_bufs_add) ||
       !CU_add_test(pSuite, "bufs_add_stack_buffer_overflow_bug",
                    test_nghttp2_bufs_add_stack_buffer_overflow_bug) ||
@@ -540,6 +540,113 @@ void test_nghttp2_hd_inflate_zero_length_huffman(void) {
   nghttp2_hd_inflate_free(&inflater);
 }
 
+void test_nghttp2_hd_inflate_ref(void) {
+  nghttp2_hd_inflater inflater;
+  nghttp2_bufs bufs;
+  nghttp2_nv nv1 = MAKE_NV("user-agent", "nghttp2");
+  nghttp2_nv nv2 = MAKE_NV("x-literal", "foo");
+  nghttp2_nv nv3 = MAKE_NV(":method", "GET");
+  nghttp2_nv nv_out;
+  nghttp2_hd_entry *ents[5];
+  size_t nents = 0;
+  nghttp2_mem *mem;
+  uint8_t *in;
+  ssize_t inlen, rv;
+  int inflate_flags, token;
+  const nghttp2_nv *nv;
+
+  mem = nghttp2_mem_default();
+  frame_pack_bufs_init(&bufs);
+
+  nghttp2_hd_inflate_init(&inflater, mem);
+
+  /* Literal header with incremental indexing - indexed name */
+  CU_ASSERT(0 == nghttp2_hd_emit_indname_block(&bufs, 57, &nv1,
+                                               NGHTTP2_HD_WITH_INDEXING));
+  /* Literal header without indexing - new name */
+  CU_ASSERT(0 == nghttp2_hd_emit_newname_block(&bufs, &nv2,
+                                               NGHTTP2_HD_WITHOUT_INDEXING));
+  /* Indexed header field referring to the entry added above */
+  CU_ASSERT(0 == nghttp2_bufs_addb(&bufs, 0x80 | 62));
+  /* Indexed header field in static table (:method: GET) */
+  CU_ASSERT(0 == nghttp2_bufs_addb(&bufs, 0x82));
+
+  in = bufs.head->buf.pos;
+  inlen = (ssize_t)nghttp2_bufs_len(&bufs);
+
+  for (;;) {
+    inflate_flags = 0;
+    rv = nghttp2_hd_inflate_hd_ref(&inflater, &nv_out, &inflate_flags, &token,
+                                   &ents[nents], in, (size_t)inlen, 1);
+
+    CU_ASSERT(rv >= 0);
+
+    in += rv;
+    inlen -= rv;
+
+    if (inflate_flags & NGHTTP2_HD_INFLATE_EMIT) {
+      nv = &ents[nents]->nv;
+
+      CU_ASSERT(nv_out.name == nv->name);
+      CU_ASSERT(nv_out.value == nv->value);
+      CU_ASSERT(token == ents[nents]->token);
+
+      ++nents;
+    }
+
+    if (inflate_flags & NGHTTP2_HD_INFLATE_FINAL) {
+      nghttp2_hd_inflate_end_headers(&inflater);
+      break;
+    }
+  }
+
+  CU_ASSERT(4 == nents);
+  CU_ASSERT(0 == inlen);
+
+  /* Entry in dynamic table is shared, rather than copied */
+  CU_ASSERT(ents[0] ==
+            GET_TABLE_ENT(&inflater.ctx, NGHTTP2_STATIC_TABLE_LENGTH));
+  CU_ASSERT(ents[0] == ents[2]);
+  CU_ASSERT(3 == ents[0]->ref);
+  CU_ASSERT(NGHTTP2_TOKEN_USER_AGENT == ents[0]->token);
+
+  /* Literal header field without indexing is held by its own entry */
+  CU_ASSERT(1 == ents[1]->ref);
+  assert_nv_equal(&nv2, &ents[1]->nv, 1, mem);
+  CU_ASSERT('\0' == ents[1]->nv.name[ents[1]->nv.namelen]);
+  CU_ASSERT('\0' == ents[1]->nv.value[ents[1]->nv.valuelen]);
+  CU_ASSERT(-1 == ents[1]->token);
+
+  /* Entry in static table is not refcounted */
+  CU_ASSERT(NULL == ents[3]->mem);
+  assert_nv_equal(&nv3, &ents[3]->nv, 1, mem);
+
+  /* Evict all entries from dynamic table.  The header fields are
+     still usable. */
+  nghttp2_bufs_reset(&bufs);
+  CU_ASSERT(0 == nghttp2_hd_emit_table_size(&bufs, 0));
+
+  inflate_flags = 0;
+  rv = nghttp2_hd_inflate_hd_ref(&inflater, &nv_out, &inflate_flags, &token,
+                                 &ents[nents], bufs.head->buf.pos,
+                                 nghttp2_bufs_len(&bufs), 1);
+
+  CU_ASSERT((ssize_t)nghttp2_bufs_len(&bufs) == rv);
+  CU_ASSERT(0 == inflater.ctx.hd_table.len);
+  CU_ASSERT(2 == ents[0]->ref);
+  assert_nv_equal(&nv1, &ents[0]->nv, 1, mem);
+
+  nghttp2_hd_inflate_free(&inflater);
+
+  assert_nv_equal(&nv1, &ents[2]->nv, 1, mem);
+
+  for (; nents > 0; --nents) {
+    nghttp2_hd_entry_decref(ents[nents - 1]);
+  }
+
+  nghttp2_bufs_free(&bufs);
+}
+
 void test_nghttp2_hd_ringbuf_reserve(void) {
   nghttp2_hd_deflater deflater;
   nghttp2_hd_inflater inflater;
@@ -1029,6 +1136,72 @@ void test_nghttp2_hd_deflate_inflate(void) {
   nghttp2_hd_deflate_free(&deflater);
 }
 
+void test_nghttp2_hd_deflate_large_table(void) {
+  nghttp2_hd_deflater deflater;
+  nghttp2_hd_inflater inflater;
+  nghttp2_nv nv;
+  nghttp2_bufs bufs;
+  uint8_t name[32], value[32];
+  size_t i;
+  nghttp2_mem *mem;
+
+  mem = nghttp2_mem_default();
+  frame_pack_bufs_init(&bufs);
+
+  nghttp2_hd_deflate_init2(&deflater, 65536, mem);
+  nghttp2_hd_inflate_init(&inflater, mem);
+
+  nghttp2_hd_deflate_change_table_size(&deflater, 65536);
+  nghttp2_hd_inflate_change_table_size(&inflater, 65536);
+
+  nv.name = name;
+  nv.value = value;
+  nv.flags = NGHTTP2_NV_FLAG_NONE;
+
+  /* Fill header table with entries sharing a few names */
+  for (i = 0; i < 1000; ++i) {
+    nv.namelen = (size_t)snprintf((char *)name, sizeof(name), "x-h%zu", i % 7);
+    nv.valuelen = (size_t)snprintf((char *)value, sizeof(value), "v%zu", i);
+
+    check_deflate_inflate(&deflater, &inflater, &nv, 1, mem);
+  }
+
+  CU_ASSERT(1000 == deflater.ctx.hd_table.len);
+
+  /* Each of them must be found as name/value match */
+  for (i = 0; i < 1000; ++i) {
+    nv.namelen = (size_t)snprintf((char *)name, sizeof(name), "x-h%zu", i % 7);
+    nv.valuelen = (size_t)snprintf((char *)value, sizeof(value), "v%zu", i);
+
+    nghttp2_bufs_reset(&bufs);
+    CU_ASSERT(0 == nghttp2_hd_deflate_hd_bufs(&deflater, &bufs, &nv, 1));
+    /* Indexed Header Field Representation */
+    CU_ASSERT(0x80 & bufs.head->buf.pos[0]);
+    CU_ASSERT(nghttp2_bufs_len(&bufs) ==
+              inflate_hd(&inflater, NULL, &bufs, 0, mem));
+  }
+
+  CU_ASSERT(1000 == deflater.ctx.hd_table.len);
+
+  /* Shrinking table evicts old entries.  Make sure that they are not
+     found anymore. */
+  nghttp2_hd_deflate_change_table_size(&deflater, 4096);
+  nghttp2_hd_inflate_change_table_size(&inflater, 4096);
+
+  CU_ASSERT(1000 > deflater.ctx.hd_table.len);
+
+  for (i = 0; i < 1000; ++i) {
+    nv.namelen = (size_t)snprintf((char *)name, sizeof(name), "x-h%zu", i % 7);
+    nv.valuelen = (size_t)snprintf((char *)value, sizeof(value), "v%zu", i);
+
+    check_deflate_inflate(&deflater, &inflater, &nv, 1, mem);
+  }
+
+  nghttp2_bufs_free(&bufs);
+  nghttp2_hd_inflate_free(&inflater);
+  nghttp2_hd_deflate_free(&deflater);
+}
+
 void test_nghttp2_hd_no_index(void) {
   nghttp2_hd_deflater deflater;
   nghttp2_hd_inflater inflater;
@@ -1234,6 +1407,7 @@ void test_nghttp2_hd_huff_encode(void) {
   nghttp2_hd_huff_decode_context ctx;
   const uint8_t t1[] = {22, 21, 20, 19, 18, 17, 16, 15, 14, 13, 12, 11,
                         10, 9,  8,  7,  6,  5,  4,  3,  2,  1,  0};
+  uint8_t buf[256];
 
   frame_pack_bufs_init(&bufs);
   frame_pack_bufs_init(&outbufs);
@@ -1254,4 +1428,311 @@ void test_nghttp2_hd_huff_encode(void) {
 
   nghttp2_bufs_free(&bufs);
   nghttp2_bufs_free(&outbufs);
+
+  /* Encode into small chunks, so that encoded bytes cross chunk
+     boundaries */
+  nghttp2_bufs_init(&bufs, 3, 32, nghttp2_mem_default());
+  frame_pack_bufs_init(&outbufs);
+
+  rv = nghttp2_hd_huff_encode(&bufs, t1, sizeof(t1));
+
+  CU_ASSERT(rv == 0);
+  CU_ASSERT((ssize_t)nghttp2_hd_huff_encode_count(t1, sizeof(t1)) ==
+            nghttp2_bufs_len(&bufs));
+
+  len = nghttp2_bufs_remove_copy(&bufs, buf);
+
+  nghttp2_hd_huff_decode_context_init(&ctx);
+
+  CU_ASSERT(len == nghttp2_hd_huff_decode(&ctx, &outbufs, buf, (size_t)len, 1));
+  CU_ASSERT((ssize_t)sizeof(t1) == nghttp2_bufs_len(&outbufs));
+  CU_ASSERT(0 == memcmp(t1, outbufs.cur->buf.pos, sizeof(t1)));
+
+  nghttp2_bufs_free(&bufs);
+  nghttp2_bufs_free(&outbufs);
+}
+
+void test_nghttp2_hd_huff_encode_count_bounded(void) {
+  const uint8_t t1[] = "www.example.com";
+  const uint8_t t2[] = {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+                        0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+                        0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff};
+  uint8_t t3[300];
+  size_t len, enclen, i, k;
+
+  CU_ASSERT(12 == nghttp2_hd_huff_encode_count(t1, sizeof(t1) - 1));
+  CU_ASSERT(12 == nghttp2_hd_huff_encode_count_bounded(t1, sizeof(t1) - 1));
+
+  CU_ASSERT(sizeof(t2) < nghttp2_hd_huff_encode_count(t2, sizeof(t2)));
+  CU_ASSERT(sizeof(t2) ==
+            nghttp2_hd_huff_encode_count_bounded(t2, sizeof(t2)));
+
+  /* 1 byte symbol which is encoded with 8 bits */
+  CU_ASSERT(1 == nghttp2_hd_huff_encode_count((const uint8_t *)"&", 1));
+  CU_ASSERT(1 ==
+            nghttp2_hd_huff_encode_count_bounded((const uint8_t *)"&", 1));
+
+  CU_ASSERT(0 == nghttp2_hd_huff_encode_count_bounded(NULL, 0));
+
+  /* Mix printable ASCII and other bytes in various ratios, so that
+     both sides of the lower bound check are taken. */
+  for (len = 1; len <= sizeof(t3); ++len) {
+    for (k = 1; k <= 8; ++k) {
+      for (i = 0; i < len; ++i) {
+        t3[i] = i % k == 0 ? (uint8_t)(0x80 + i) : (uint8_t)('a' + i % 26);
+      }
+
+      enclen = nghttp2_hd_huff_encode_count(t3, len);
+
+      CU_ASSERT((enclen < len ? enclen : len) ==
+                nghttp2_hd_huff_encode_count_bounded(t3, len));
+    }
+
+    /* ASCII only, including control characters */
+    for (i = 0; i < len; ++i) {
+      t3[i] = (uint8_t)((i * 37 + len) % 128);
+    }
+
+    enclen = nghttp2_hd_huff_encode_count(t3, len);
+
+    CU_ASSERT((enclen < len ? enclen : len) ==
+              nghttp2_hd_huff_encode_count_bounded(t3, len));
+
+    for (i = 0; i < len; ++i) {
+      t3[i] = (uint8_t)"0123456789aceiost"[(i + len) % 17];
+    }
+
+    enclen = nghttp2_hd_huff_encode_count(t3, len);
+
+    /* Symbols of 5 or 6 bits save at least 1 byte from 4 bytes */
+    if (len >= 4) {
+      CU_ASSERT(enclen < len);
+      CU_ASSERT(enclen == nghttp2_hd_huff_encode_count_bounded(t3, len));
+    }
+  }
+}
+
+void test_nghttp2_hd_huff_decode(void) {
+  ssize_t len;
+  nghttp2_bufs bufs, outbufs;
+  nghttp2_hd_huff_decode_context ctx;
+  uint8_t t1[256];
+  /* "www.example.com" in C.4.1 of HPACK spec */
+  const uint8_t t2[] = {0xf1, 0xe3, 0xc2, 0xe5, 0xf2, 0x3a,
+                        0x6b, 0xa0, 0xab, 0x90, 0xf4, 0xff};
+  /* 'a' followed by padding of 8 bits */
+  const uint8_t t3[] = {0x1f, 0xff};
+  /* 'a' followed by padding which is not the prefix of EOS */
+  const uint8_t t4[] = {0x1e};
+  /* EOS */
+  const uint8_t t5[] = {0xff, 0xff, 0xff, 0xff};
+  size_t i;
+
+  for (i = 0; i < sizeof(t1); ++i) {
+    t1[i] = (uint8_t)i;
+  }
+
+  frame_pack_bufs_init(&bufs);
+  frame_pack_bufs_init(&outbufs);
+
+  nghttp2_hd_huff_encode(&bufs, t1, sizeof(t1));
+
+  /* Decode whole string at once */
+  nghttp2_hd_huff_decode_context_init(&ctx);
+
+  len = nghttp2_hd_huff_decode(&ctx, &outbufs, bufs.cur->buf.pos,
+                               nghttp2_bufs_len(&bufs), 1);
+
+  CU_ASSERT(nghttp2_bufs_len(&bufs) == len);
+  CU_ASSERT((ssize_t)sizeof(t1) == nghttp2_bufs_len(&outbufs));
+  CU_ASSERT(0 == memcmp(t1, outbufs.cur->buf.pos, sizeof(t1)));
+
+  /* Decode 1 byte at a time */
+  nghttp2_bufs_reset(&outbufs);
+  nghttp2_hd_huff_decode_context_init(&ctx);
+
+  for (i = 0; i < (size_t)nghttp2_bufs_len(&bufs); ++i) {
+    len = nghttp2_hd_huff_decode(&ctx, &outbufs, bufs.cur->buf.pos + i, 1,
+                                 i + 1 == (size_t)nghttp2_bufs_len(&bufs));
+    CU_ASSERT(1 == len);
+  }
+
+  CU_ASSERT((ssize_t)sizeof(t1) == nghttp2_bufs_len(&outbufs));
+  CU_ASSERT(0 == memcmp(t1, outbufs.cur->buf.pos, sizeof(t1)));
+
+  nghttp2_bufs_reset(&outbufs);
+  nghttp2_hd_huff_decode_context_init(&ctx);
+
+  len = nghttp2_hd_huff_decode(&ctx, &outbufs, t2, sizeof(t2), 1);
+
+  CU_ASSERT((ssize_t)sizeof(t2) == len);
+  CU_ASSERT(15 == nghttp2_bufs_len(&outbufs));
+  CU_ASSERT(0 == memcmp("www.example.com", outbufs.cur->buf.pos, 15));
+
+  nghttp2_bufs_reset(&outbufs);
+  nghttp2_hd_huff_decode_context_init(&ctx);
+
+  CU_ASSERT(NGHTTP2_ERR_HEADER_COMP ==
+            nghttp2_hd_huff_decode(&ctx, &outbufs, t3, sizeof(t3), 1));
+
+  nghttp2_bufs_reset(&outbufs);
+  nghttp2_hd_huff_decode_context_init(&ctx);
+
+  CU_ASSERT(NGHTTP2_ERR_HEADER_COMP ==
+            nghttp2_hd_huff_decode(&ctx, &outbufs, t4, sizeof(t4), 1));
+
+  nghttp2_bufs_reset(&outbufs);
+  nghttp2_hd_huff_decode_context_init(&ctx);
+
+  CU_ASSERT(NGHTTP2_ERR_HEADER_COMP ==
+            nghttp2_hd_huff_decode(&ctx, &outbufs, t5, sizeof(t5), 1));
+
+  nghttp2_bufs_free(&bufs);
+  nghttp2_bufs_free(&outbufs);
+}
+
+void test_nghttp2_hd_deflate_indexing_strategy(void) {
+  nghttp2_hd_deflater deflater;
+  nghttp2_hd_inflater inflater;
+  nghttp2_nv nv1[] = {MAKE_NV("x-foo", "bar"), MAKE_NV(":path", "/alpha")};
+  nghttp2_nv nv2[] = {MAKE_NV("x-foo", "bar"), MAKE_NV(":path", "/bravo")};
+  nghttp2_nv nv3[] = {MAKE_NV("x-foo", "bar"), MAKE_NV("x-bar", "12345")};
+  nghttp2_hd_entry *ent;
+  nghttp2_bufs bufs;
+  ssize_t blocklen;
+  nva_out out;
+  nghttp2_mem *mem;
+  int rv;
+
+  mem = nghttp2_mem_default();
+  frame_pack_bufs_init(&bufs);
+  nva_out_init(&out);
+
+  nghttp2_hd_deflate_init(&deflater, mem);
+  nghttp2_hd_inflate_init(&inflater, mem);
+
+  CU_ASSERT(NGHTTP2_ERR_INVALID_ARGUMENT ==
+            nghttp2_hd_deflate_set_indexing_strategy(
+                &deflater, (nghttp2_hd_indexing_strategy)100, 0));
+
+  rv = nghttp2_hd_deflate_set_indexing_strategy(
+      &deflater, NGHTTP2_HD_INDEXING_FREQUENCY, 0);
+
+  CU_ASSERT(0 == rv);
+  CU_ASSERT(NULL != deflater.seen);
+
+  /* First occurrence is never indexed */
+  rv = nghttp2_hd_deflate_hd_bufs(&deflater, &bufs, nv1, ARRLEN(nv1));
+  blocklen = (ssize_t)nghttp2_bufs_len(&bufs);
+
+  CU_ASSERT(0 == rv);
+  CU_ASSERT(0 == deflater.ctx.hd_table.len);
+  CU_ASSERT(blocklen == inflate_hd(&inflater, &out, &bufs, 0, mem));
+  assert_nv_equal(nv1, out.nva, ARRLEN(nv1), mem);
+
+  nva_out_reset(&out, mem);
+  nghttp2_bufs_reset(&bufs);
+
+  /* "x-foo: bar" is seen again, so it is indexed.  :path value
+     differs, and is not indexed. */
+  rv = nghttp2_hd_deflate_hd_bufs(&deflater, &bufs, nv2, ARRLEN(nv2));
+  blocklen = (ssize_t)nghttp2_bufs_len(&bufs);
+
+  CU_ASSERT(0 == rv);
+  CU_ASSERT(1 == deflater.ctx.hd_table.len);
+  CU_ASSERT(blocklen == inflate_hd(&inflater, &out, &bufs, 0, mem));
+  assert_nv_equal(nv2, out.nva, ARRLEN(nv2), mem);
+
+  nva_out_reset(&out, mem);
+  nghttp2_bufs_reset(&bufs);
+
+  nghttp2_hd_inflate_free(&inflater);
+  nghttp2_hd_deflate_free(&deflater);
+
+  nghttp2_hd_deflate_init(&deflater, mem);
+
+  rv = nghttp2_hd_deflate_set_indexing_strategy(
+      &deflater, NGHTTP2_HD_INDEXING_VALUE_SIZE, 4);
+
+  CU_ASSERT(0 == rv);
+
+  /* "x-bar: 12345" has value longer than 4 bytes */
+  rv = nghttp2_hd_deflate_hd_bufs(&deflater, &bufs, nv3, ARRLEN(nv3));
+
+  CU_ASSERT(0 == rv);
+  CU_ASSERT(1 == deflater.ctx.hd_table.len);
+
+  ent = nghttp2_hd_table_get(&deflater.ctx, NGHTTP2_STATIC_TABLE_LENGTH);
+
+  CU_ASSERT(0 == memcmp("x-foo", ent->nv.name, 5));
+
+  nghttp2_hd_deflate_free(&deflater);
+  nghttp2_bufs_free(&bufs);
+}
+
+void test_nghttp2_hd_deflate_string_cache(void) {
+  nghttp2_hd_deflater deflater, deflater2;
+  nghttp2_hd_inflater inflater;
+  nghttp2_hd_string_cache *cache;
+  nghttp2_nv nva[] = {MAKE_NV("x-powered-by", "nghttp2"),
+                      MAKE_NV("server", "nghttpx nghttp2/1.0.0"),
+                      MAKE_NV("x-uncached", "alpha")};
+  nghttp2_bufs bufs, bufs2;
+  ssize_t blocklen;
+  nva_out out;
+  nghttp2_mem *mem;
+  int rv;
+
+  mem = nghttp2_mem_default();
+  frame_pack_bufs_init(&bufs);
+  frame_pack_bufs_init(&bufs2);
+  nva_out_init(&out);
+
+  rv = nghttp2_hd_string_cache_new(&cache, NULL);
+
+  CU_ASSERT(0 == rv);
+
+  CU_ASSERT(0 == nghttp2_hd_string_cache_add(
+                     cache, (const uint8_t *)"x-powered-by", 12));
+  CU_ASSERT(0 == nghttp2_hd_string_cache_add(cache,
+                                             (const uint8_t *)"nghttp2", 7));
+  CU_ASSERT(0 == nghttp2_hd_string_cache_add(
+                     cache, (const uint8_t *)"nghttpx nghttp2/1.0.0", 21));
+  /* Adding the same string again is no-op */
+  CU_ASSERT(0 == nghttp2_hd_string_cache_add(cache,
+                                             (const uint8_t *)"nghttp2", 7));
+
+  nghttp2_hd_deflate_init(&deflater, mem);
+  nghttp2_hd_deflate_init(&deflater2, mem);
+  nghttp2_hd_inflate_init(&inflater, mem);
+
+  nghttp2_hd_deflate_set_string_cache(&deflater, cache);
+
+  /* Output must be identical to the one without cache */
+  rv = nghttp2_hd_deflate_hd_bufs(&deflater, &bufs, nva, ARRLEN(nva));
+
+  CU_ASSERT(0 == rv);
+
+  rv = nghttp2_hd_deflate_hd_bufs(&deflater2, &bufs2, nva, ARRLEN(nva));
+
+  CU_ASSERT(0 == rv);
+
+  blocklen = (ssize_t)nghttp2_bufs_len(&bufs);
+
+  CU_ASSERT(blocklen == (ssize_t)nghttp2_bufs_len(&bufs2));
+  CU_ASSERT(0 == memcmp(bufs.head->buf.pos, bufs2.head->buf.pos,
+                        (size_t)blocklen));
+
+  CU_ASSERT(blocklen == inflate_hd(&inflater, &out, &bufs, 0, mem));
+
+  assert_nv_equal(nva, out.nva, ARRLEN(nva), mem);
+
+  nva_out_reset(&out, mem);
+
+  nghttp2_hd_inflate_free(&inflater);
+  nghttp2_hd_deflate_free(&deflater2);
+  nghttp2_hd_deflate_free(&deflater);
+  nghttp2_hd_string_cache_del(cache);
+  nghttp2_bufs_free(&bufs2);
+  nghttp2_bufs_free(&bufs);
 }
@@ -35,13 +35,19 @@ void test_nghttp2_hd_inflate_newname_noinc(void);
 void test_nghttp2_hd_inflate_newname_inc(void);
 void test_nghttp2_hd_inflate_clearall_inc(void);
 void test_nghttp2_hd_inflate_zero_length_huffman(void);
+void test_nghttp2_hd_inflate_ref(void);
 void test_nghttp2_hd_ringbuf_reserve(void);
 void test_nghttp2_hd_change_table_size(void);
 void test_nghttp2_hd_deflate_inflate(void);
+void test_nghttp2_hd_deflate_large_table(void);
 void test_nghttp2_hd_no_index(void);
 void test_nghttp2_hd_deflate_bound(void);
 void test_nghttp2_hd_public_api(void);
 void test_nghttp2_hd_decode_length(void);
 void test_nghttp2_hd_huff_encode(void);
+void test_nghttp2_hd_huff_encode_count_bounded(void);
+void test_nghttp2_hd_huff_decode(void);
+void test_nghttp2_hd_deflate_indexing_strategy(void);
+void test_nghttp2_hd_deflate_string_cache(void);
 
 #endif /* NGHTTP2_HD_TEST_H */
@@ -24,6 +24,8 @@
  */
 #include "nghttp2_helper_test.h"
 
+#include <string.h>
+
 #include <CUnit/CUnit.h>
 
 #include "nghttp2_helper.h"
@@ -154,6 +156,44 @@ void test_nghttp2_check_header_name(void) {
   CU_ASSERT(!check_header_name(":"));
 }
 
+static int valid_header_name_char(uint8_t c) {
+  return ('a' <= c && c <= 'z') || ('0' <= c && c <= '9') ||
+         (c != '\0' && strchr("!#$%&'*+-.^_`|~", c) != NULL);
+}
+
+void test_nghttp2_check_header_name_long(void) {
+  uint8_t name[1 + 80];
+  size_t len, i;
+  int c;
+
+  /* Place every byte at every position of names which are long enough
+     to exercise vectorized validation and its tail handling. */
+  for (len = 1; len <= 80; ++len) {
+    memset(name, 'a', sizeof(name));
+    name[0] = ':';
+
+    CU_ASSERT(nghttp2_check_header_name(name + 1, len));
+    CU_ASSERT(nghttp2_check_header_name(name, len + 1));
+
+    for (i = 0; i < len; ++i) {
+      for (c = 0; c < 256; ++c) {
+        name[1 + i] = (uint8_t)c;
+
+        /* A leading ':' makes name + 1 a pseudo header field name */
+        if (i > 0 || c != ':') {
+          CU_ASSERT(valid_header_name_char((uint8_t)c) ==
+                    nghttp2_check_header_name(name + 1, len));
+        }
+        CU_ASSERT(valid_header_name_char((uint8_t)c) ==
+                  nghttp2_check_header_name(name, len + 1));
+      }
+      name[1 + i] = (uint8_t)"!#$%&'*+-.^_`|~0"[i % 16];
+    }
+
+    CU_ASSERT(nghttp2_check_header_name(name + 1, len));
+  }
+}
+
 #define check_header_value(S)                                                  \
   nghttp2_check_header_value((const uint8_t *)S, sizeof(S) - 1)
 
@@ -167,3 +207,31 @@ void test_nghttp2_check_header_value(void) {
   CU_ASSERT(!check_header_value(badval1));
   CU_ASSERT(!check_header_value(badval2));
 }
+
+static int valid_header_value_char(uint8_t c) {
+  return c == '\t' || (c >= 0x20 && c != 0x7f);
+}
+
+void test_nghttp2_check_header_value_long(void) {
+  uint8_t value[80];
+  size_t len, i;
+  int c;
+
+  for (len = 1; len <= sizeof(value); ++len) {
+    memset(value, ' ', sizeof(value));
+
+    CU_ASSERT(nghttp2_check_header_value(value, len));
+
+    for (i = 0; i < len; ++i) {
+      for (c = 0; c < 256; ++c) {
+        value[i] = (uint8_t)c;
+
+        CU_ASSERT(valid_header_value_char((uint8_t)c) ==
+                  nghttp2_check_header_value(value, len));
+      }
+      value[i] = (uint8_t)(i % 2 ? '\t' : 0x80 + i);
+    }
+
+    CU_ASSERT(nghttp2_check_header_value(value, len));
+  }
+}
@@ -102,6 +102,12 @@ static void shuffle(int *a, int n) {
 
 static int eachfun(nghttp2_map_entry *entry _U_, void *ptr _U_) { return 0; }
 
+static int countfun(nghttp2_map_entry *entry _U_, void *ptr) {
+  size_t *pcnt = ptr;
+  ++*pcnt;
+  return 0;
+}
+
 #define NUM_ENT 6000
 strentry arr[NUM_ENT];
 int order[NUM_ENT];
@@ -109,6 +115,7 @@ int order[NUM_ENT];
 void test_nghttp2_map_functional(void) {
   nghttp2_map map;
   int i;
+  size_t cnt;
 
   nghttp2_map_init(&map, nghttp2_mem_default());
   for (i = 0; i < NUM_ENT; ++i) {
@@ -121,17 +128,35 @@ void test_nghttp2_map_functional(void) {
     CU_ASSERT(0 == nghttp2_map_insert(&map, &arr[order[i] - 1].map_entry));
   }
   /* traverse */
-  nghttp2_map_each(&map, eachfun, NULL);
+  cnt = 0;
+  nghttp2_map_each(&map, countfun, &cnt);
+  CU_ASSERT(NUM_ENT == cnt);
   /* find */
   shuffle(order, NUM_ENT);
   for (i = 0; i < NUM_ENT; ++i) {
-    nghttp2_map_find(&map, order[i]);
+    CU_ASSERT(&arr[order[i] - 1].map_entry ==
+              nghttp2_map_find(&map, order[i]));
   }
-  /* remove */
+  /* remove half of them, and make sure that the rest is still
+     found */
   shuffle(order, NUM_ENT);
-  for (i = 0; i < NUM_ENT; ++i) {
+  for (i = 0; i < NUM_ENT / 2; ++i) {
     CU_ASSERT(0 == nghttp2_map_remove(&map, order[i]));
+    CU_ASSERT(NULL == nghttp2_map_find(&map, order[i]));
   }
+  CU_ASSERT(NUM_ENT / 2 == nghttp2_map_size(&map));
+  for (i = NUM_ENT / 2; i < NUM_ENT; ++i) {
+    CU_ASSERT(&arr[order[i] - 1].map_entry ==
+              nghttp2_map_find(&map, order[i]));
+  }
+  cnt = 0;
+  nghttp2_map_each(&map, countfun, &cnt);
+  CU_ASSERT(NUM_ENT / 2 == cnt);
+  /* remove the rest */
+  for (i = NUM_ENT / 2; i < NUM_ENT; ++i) {
+    CU_ASSERT(0 == nghttp2_map_remove(&map, order[i]));
+  }
+  CU_ASSERT(0 == nghttp2_map_size(&map));
 
   /* each_free (but no op function for testing purpose) */
   for (i = 0; i < NUM_ENT; ++i) {
@@ -145,6 +170,52 @@ void test_nghttp2_map_functional(void) {
   nghttp2_map_free(&map);
 }
 
+void test_nghttp2_map_random(void) {
+  nghttp2_map map;
+  int i;
+  size_t cnt;
+
+  nghttp2_map_init(&map, nghttp2_mem_default());
+
+  /* Random keys make clusters in the table, which exercises the
+     displacement on insertion and the shift on removal. */
+  for (i = 0; i < NUM_ENT; ++i) {
+    key_type key;
+
+    do {
+      key = (key_type)rand();
+    } while (nghttp2_map_find(&map, key) != NULL);
+
+    strentry_init(&arr[i], key, "foo");
+    CU_ASSERT(0 == nghttp2_map_insert(&map, &arr[i].map_entry));
+  }
+
+  CU_ASSERT(NUM_ENT == nghttp2_map_size(&map));
+
+  for (i = 0; i < NUM_ENT; i += 2) {
+    CU_ASSERT(0 == nghttp2_map_remove(&map, arr[i].map_entry.key));
+  }
+
+  CU_ASSERT(NUM_ENT / 2 == nghttp2_map_size(&map));
+
+  for (i = 0; i < NUM_ENT; ++i) {
+    if (i % 2 == 0) {
+      CU_ASSERT(NULL == nghttp2_map_find(&map, arr[i].map_entry.key));
+    } else {
+      CU_ASSERT(&arr[i].map_entry ==
+                nghttp2_map_find(&map, arr[i].map_entry.key));
+      CU_ASSERT(NGHTTP2_ERR_INVALID_ARGUMENT ==
+                nghttp2_map_insert(&map, &arr[i].map_entry));
+    }
+  }
+
+  cnt = 0;
+  nghttp2_map_each(&map, countfun, &cnt);
+  CU_ASSERT(NUM_ENT / 2 == cnt);
+
+  nghttp2_map_free(&map);
+}
+
 static int entry_free(nghttp2_map_entry *entry, void *ptr) {
   nghttp2_mem *mem = ptr;
 
@@ -27,6 +27,7 @@
 
 void test_nghttp2_map(void);
 void test_nghttp2_map_functional(void);
+void test_nghttp2_map_random(void);
 void test_nghttp2_map_each_free(void);
 
 #endif /* NGHTTP2_MAP_TEST_H */
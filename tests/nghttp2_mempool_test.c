@@ -0,0 +1,118 @@
+/*
+ * nghttp2 - HTTP/2 C Library
+ *
+ * Copyright (c) 2015 Tatsuhiro Tsujikawa
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "nghttp2_mempool_test.h"
+
+#include <string.h>
+
+#include <CUnit/CUnit.h>
+
+#include "nghttp2_mempool.h"
+
+typedef struct {
+  int64_t a;
+  uint8_t b[13];
+} mempool_obj;
+
+void test_nghttp2_mempool(void) {
+  nghttp2_mempool pool;
+  nghttp2_mem *mem;
+  nghttp2_slab_stat stat;
+  mempool_obj *objs[7];
+  mempool_obj *obj;
+  size_t i;
+
+  mem = nghttp2_mem_default();
+
+  nghttp2_mempool_init(&pool, sizeof(mempool_obj), 3, mem);
+
+  nghttp2_mempool_get_stat(&pool, &stat);
+
+  CU_ASSERT(0 == stat.nslabs);
+  CU_ASSERT(0 == stat.capacity);
+  CU_ASSERT(0 == stat.used);
+
+  for (i = 0; i < 7; ++i) {
+    objs[i] = nghttp2_mempool_alloc(&pool);
+    CU_ASSERT(NULL != objs[i]);
+    CU_ASSERT(0 == ((uintptr_t)objs[i] & 0x7));
+    /* Make sure that objects do not overlap */
+    memset(objs[i], (int)i, sizeof(mempool_obj));
+  }
+
+  for (i = 0; i < 7; ++i) {
+    CU_ASSERT((uint8_t)i == objs[i]->b[sizeof(objs[i]->b) - 1]);
+  }
+
+  nghttp2_mempool_get_stat(&pool, &stat);
+
+  CU_ASSERT(3 == stat.nslabs);
+  CU_ASSERT(9 == stat.capacity);
+  CU_ASSERT(7 == stat.used);
+
+  /* Released object is reused */
+  nghttp2_mempool_release(&pool, objs[4]);
+  nghttp2_mempool_release(&pool, NULL);
+
+  nghttp2_mempool_get_stat(&pool, &stat);
+
+  CU_ASSERT(6 == stat.used);
+
+  obj = nghttp2_mempool_alloc(&pool);
+
+  CU_ASSERT(objs[4] == obj);
+
+  nghttp2_mempool_get_stat(&pool, &stat);
+
+  CU_ASSERT(3 == stat.nslabs);
+  CU_ASSERT(7 == stat.used);
+
+  for (i = 0; i < 7; ++i) {
+    nghttp2_mempool_release(&pool, objs[i]);
+  }
+
+  nghttp2_mempool_get_stat(&pool, &stat);
+
+  CU_ASSERT(3 == stat.nslabs);
+  CU_ASSERT(0 == stat.used);
+
+  nghttp2_mempool_free(&pool);
+
+  /* Pooling disabled */
+  nghttp2_mempool_init(&pool, sizeof(mempool_obj), 0, mem);
+
+  obj = nghttp2_mempool_alloc(&pool);
+
+  CU_ASSERT(NULL != obj);
+
+  nghttp2_mempool_get_stat(&pool, &stat);
+
+  CU_ASSERT(0 == stat.nslabs);
+  CU_ASSERT(0 == stat.capacity);
+  CU_ASSERT(0 == stat.used);
+
+  nghttp2_mempool_release(&pool, obj);
+
+  nghttp2_mempool_free(&pool);
+}
@@ -35,6 +35,7 @@
 #include "nghttp2_helper.h"
 #include "nghttp2_test_helper.h"
 #include "nghttp2_priority_spec.h"
+#include "nghttp2_time.h"
 
 extern int nghttp2_enable_strict_preface;
 
@@ -79,6 +80,10 @@ typedef struct {
   size_t data_chunk_len;
   size_t padlen;
   int begin_frame_cb_called;
+  nghttp2_rcnv *rcnvs[16];
+  size_t rcnvlen;
+  /* The number of DATA frames sent, indexed by stream_id / 2 */
+  size_t data_frames_sent[8];
 } my_user_data;
 
 static const nghttp2_nv reqnv[] = {
@@ -201,6 +206,16 @@ static int on_frame_send_callback(nghttp2_session *session _U_,
   return 0;
 }
 
+static int count_data_on_frame_send_callback(nghttp2_session *session _U_,
+                                             const nghttp2_frame *frame,
+                                             void *user_data) {
+  my_user_data *ud = (my_user_data *)user_data;
+  if (frame->hd.type == NGHTTP2_DATA) {
+    ++ud->data_frames_sent[frame->hd.stream_id / 2];
+  }
+  return 0;
+}
+
 static int on_frame_not_send_callback(nghttp2_session *session _U_,
                                       const nghttp2_frame *frame, int lib_error,
                                       void *user_data) {
@@ -272,6 +287,26 @@ static ssize_t fixed_length_data_source_read_callback(
   return wlen;
 }
 
+static ssize_t filled_data_source_read_callback(
+    nghttp2_session *session, int32_t stream_id, uint8_t *buf, size_t len,
+    uint32_t *data_flags, nghttp2_data_source *source, void *user_data) {
+  ssize_t nread;
+
+  nread = fixed_length_data_source_read_callback(
+      session, stream_id, buf, len, data_flags, source, user_data);
+
+  memset(buf, 'a', (size_t)nread);
+
+  return nread;
+}
+
+static ssize_t unlimited_data_source_read_callback(
+    nghttp2_session *session _U_, int32_t stream_id _U_, uint8_t *buf _U_,
+    size_t len, uint32_t *data_flags _U_, nghttp2_data_source *source _U_,
+    void *user_data _U_) {
+  return (ssize_t)len;
+}
+
 static ssize_t temporal_failure_data_source_read_callback(
     nghttp2_session *session _U_, int32_t stream_id _U_, uint8_t *buf _U_,
     size_t len _U_, uint32_t *data_flags _U_, nghttp2_data_source *source _U_,
@@ -340,6 +375,33 @@ static int send_data_callback(nghttp2_session *session _U_,
   return 0;
 }
 
+static const uint8_t get_data_vec_payload[16384];
+
+static ssize_t get_data_vec_callback(nghttp2_session *session _U_,
+                                     nghttp2_frame *frame _U_,
+                                     nghttp2_vec *vec, size_t veclen,
+                                     size_t length,
+                                     nghttp2_data_source *source _U_,
+                                     void *user_data) {
+  my_user_data *ud = (my_user_data *)user_data;
+
+  if (ud->block_count > 0) {
+    --ud->block_count;
+    return NGHTTP2_ERR_WOULDBLOCK;
+  }
+
+  if (veclen < 2 || length < 2) {
+    return NGHTTP2_ERR_CALLBACK_FAILURE;
+  }
+
+  vec[0].base = get_data_vec_payload;
+  vec[0].len = length / 2;
+  vec[1].base = get_data_vec_payload + length / 2;
+  vec[1].len = length - length / 2;
+
+  return 2;
+}
+
 /* static void no_stream_user_data_stream_close_callback */
 /* (nghttp2_session *session, */
 /*  int32_t stream_id, */
@@ -380,6 +442,20 @@ static int on_header_callback(nghttp2_session *session _U_,
   return 0;
 }
 
+static int keep_on_header_callback2(nghttp2_session *session _U_,
+                                    const nghttp2_frame *frame,
+                                    nghttp2_rcnv *rcnv, uint8_t flags _U_,
+                                    void *user_data) {
+  my_user_data *ud = (my_user_data *)user_data;
+  ++ud->header_cb_called;
+
+  nghttp2_rcnv_incref(rcnv);
+  ud->rcnvs[ud->rcnvlen++] = rcnv;
+
+  ud->frame = frame;
+  return 0;
+}
+
 static int pause_on_header_callback(nghttp2_session *session,
                                     const nghttp2_frame *frame,
                                     const uint8_t *name, size_t namelen,
@@ -800,6 +876,96 @@ void test_nghttp2_session_recv_data(void) {
   nghttp2_session_del(session);
 }
 
+void test_nghttp2_session_recv_control_frame_burst(void) {
+  nghttp2_session *session;
+  nghttp2_session_callbacks callbacks;
+  my_user_data ud;
+  uint8_t data[256];
+  uint8_t *p;
+  size_t datalen, i;
+  ssize_t rv;
+  nghttp2_frame_hd hd;
+  nghttp2_stream *stream;
+  nghttp2_outbound_item *item;
+  int k;
+
+  memset(&callbacks, 0, sizeof(nghttp2_session_callbacks));
+  callbacks.on_frame_recv_callback = on_frame_recv_callback;
+
+  p = data;
+
+  nghttp2_frame_hd_init(&hd, 4, NGHTTP2_WINDOW_UPDATE, NGHTTP2_FLAG_NONE, 0);
+  nghttp2_frame_pack_frame_hd(p, &hd);
+  nghttp2_put_uint32be(p + NGHTTP2_FRAME_HDLEN, 1000);
+  p += NGHTTP2_FRAME_HDLEN + 4;
+
+  nghttp2_frame_hd_init(&hd, NGHTTP2_PRIORITY_SPECLEN, NGHTTP2_PRIORITY,
+                        NGHTTP2_FLAG_NONE, 3);
+  nghttp2_frame_pack_frame_hd(p, &hd);
+  nghttp2_put_uint32be(p + NGHTTP2_FRAME_HDLEN, 0);
+  p[NGHTTP2_FRAME_HDLEN + 4] = 31;
+  p += NGHTTP2_FRAME_HDLEN + NGHTTP2_PRIORITY_SPECLEN;
+
+  nghttp2_frame_hd_init(&hd, 8, NGHTTP2_PING, NGHTTP2_FLAG_NONE, 0);
+  nghttp2_frame_pack_frame_hd(p, &hd);
+  memset(p + NGHTTP2_FRAME_HDLEN, 0, 8);
+  p += NGHTTP2_FRAME_HDLEN + 8;
+
+  nghttp2_frame_hd_init(&hd, 4, NGHTTP2_WINDOW_UPDATE, NGHTTP2_FLAG_NONE, 1);
+  nghttp2_frame_pack_frame_hd(p, &hd);
+  nghttp2_put_uint32be(p + NGHTTP2_FRAME_HDLEN, 100);
+  p += NGHTTP2_FRAME_HDLEN + 4;
+
+  nghttp2_frame_hd_init(&hd, 4, NGHTTP2_RST_STREAM, NGHTTP2_FLAG_NONE, 1);
+  nghttp2_frame_pack_frame_hd(p, &hd);
+  nghttp2_put_uint32be(p + NGHTTP2_FRAME_HDLEN, NGHTTP2_CANCEL);
+  p += NGHTTP2_FRAME_HDLEN + 4;
+
+  datalen = (size_t)(p - data);
+
+  /* Feed the burst at once, and then byte by byte.  The results must
+     be the same. */
+  for (k = 0; k < 2; ++k) {
+    nghttp2_session_server_new(&session, &callbacks, &ud);
+
+    stream = nghttp2_session_open_stream(session, 1, NGHTTP2_STREAM_FLAG_NONE,
+                                         &pri_spec_default,
+                                         NGHTTP2_STREAM_OPENED, NULL);
+
+    ud.frame_recv_cb_called = 0;
+
+    if (k == 0) {
+      rv = nghttp2_session_mem_recv(session, data, datalen);
+
+      CU_ASSERT((ssize_t)datalen == rv);
+    } else {
+      for (i = 0; i < datalen; ++i) {
+        rv = nghttp2_session_mem_recv(session, data + i, 1);
+
+        CU_ASSERT(1 == rv);
+      }
+    }
+
+    CU_ASSERT(5 == ud.frame_recv_cb_called);
+    CU_ASSERT(NGHTTP2_INITIAL_CONNECTION_WINDOW_SIZE + 1000 ==
+              session->remote_window_size);
+    CU_ASSERT(NULL == nghttp2_session_get_stream(session, 1));
+
+    stream = nghttp2_session_get_stream_raw(session, 3);
+
+    CU_ASSERT(NULL != stream);
+    CU_ASSERT(32 == stream->weight);
+
+    item = nghttp2_session_get_next_ob_item(session);
+
+    CU_ASSERT(NGHTTP2_PING == item->frame.hd.type);
+    CU_ASSERT(NGHTTP2_FLAG_ACK == item->frame.hd.flags);
+    CU_ASSERT(NGHTTP2_IB_READ_HEAD == session->iframe.state);
+
+    nghttp2_session_del(session);
+  }
+}
+
 void test_nghttp2_session_recv_data_no_auto_flow_control(void) {
   nghttp2_session *session;
   nghttp2_session_callbacks callbacks;
@@ -4272,6 +4438,77 @@ void test_nghttp2_submit_window_update_local_window_size(void) {
   nghttp2_session_del(session);
 }
 
+void test_nghttp2_session_window_update_coalescing(void) {
+  nghttp2_session *session;
+  nghttp2_session_callbacks callbacks;
+  nghttp2_option *option;
+  nghttp2_stream *stream;
+  nghttp2_outbound_item *item;
+  my_user_data ud;
+
+  memset(&callbacks, 0, sizeof(callbacks));
+  callbacks.send_callback = null_send_callback;
+  callbacks.on_frame_send_callback = on_frame_send_callback;
+
+  nghttp2_option_new(&option);
+  nghttp2_option_set_no_auto_window_update(option, 1);
+  nghttp2_option_set_connection_window_update_threshold(option, 100);
+
+  nghttp2_session_server_new2(&session, &callbacks, &ud, option);
+
+  stream = open_stream(session, 1);
+
+  stream->recv_window_size = NGHTTP2_INITIAL_WINDOW_SIZE;
+  session->recv_window_size = NGHTTP2_INITIAL_CONNECTION_WINDOW_SIZE;
+
+  /* Stream window crosses the half, but connection window does not
+     reach the threshold */
+  CU_ASSERT(0 == nghttp2_session_consume(session, 1, 40000));
+  CU_ASSERT(1 == nghttp2_outbound_queue_size(&session->ob_reg));
+  CU_ASSERT(NULL != stream->window_update_item);
+  CU_ASSERT(NULL == session->window_update_item);
+
+  /* Another WINDOW_UPDATE for stream 1 is merged into the queued
+     one */
+  stream->recv_window_size += 40000;
+
+  CU_ASSERT(0 == nghttp2_session_consume(session, 1, 40000));
+  CU_ASSERT(2 == nghttp2_outbound_queue_size(&session->ob_reg));
+
+  item = nghttp2_outbound_queue_top(&session->ob_reg);
+
+  CU_ASSERT(item == stream->window_update_item);
+  CU_ASSERT(1 == item->frame.hd.stream_id);
+  CU_ASSERT(80000 == item->frame.window_update.window_size_increment);
+
+  item = item->qnext;
+
+  CU_ASSERT(item == session->window_update_item);
+  CU_ASSERT(0 == item->frame.hd.stream_id);
+  CU_ASSERT(NGHTTP2_INITIAL_CONNECTION_WINDOW_SIZE ==
+            item->frame.window_update.window_size_increment);
+
+  ud.frame_send_cb_called = 0;
+
+  CU_ASSERT(0 == nghttp2_session_send(session));
+  CU_ASSERT(2 == ud.frame_send_cb_called);
+  CU_ASSERT(NULL == stream->window_update_item);
+  CU_ASSERT(NULL == session->window_update_item);
+
+  /* Once sent, next WINDOW_UPDATE is queued separately */
+  stream->recv_window_size += 40000;
+
+  CU_ASSERT(0 == nghttp2_session_consume(session, 1, 40000));
+  CU_ASSERT(1 == nghttp2_outbound_queue_size(&session->ob_reg));
+
+  item = nghttp2_outbound_queue_top(&session->ob_reg);
+
+  CU_ASSERT(40000 == item->frame.window_update.window_size_increment);
+
+  nghttp2_session_del(session);
+  nghttp2_option_del(option);
+}
+
 void test_nghttp2_submit_shutdown_notice(void) {
   nghttp2_session *session;
   nghttp2_session_callbacks callbacks;
@@ -4538,7 +4775,6 @@ void test_nghttp2_session_pop_next_ob_item(void) {
   nghttp2_session_callbacks callbacks;
   nghttp2_outbound_item *item;
   nghttp2_priority_spec pri_spec;
-  nghttp2_stream *stream;
   nghttp2_mem *mem;
 
   mem = nghttp2_mem_default();
@@ -4585,10 +4821,6 @@ void test_nghttp2_session_pop_next_ob_item(void) {
   CU_ASSERT(NGHTTP2_HEADERS == item->frame.hd.type);
   CU_ASSERT(1 == item->frame.hd.stream_id);
 
-  stream = nghttp2_session_get_stream(session, 1);
-
-  nghttp2_stream_detach_item(stream, session);
-
   nghttp2_outbound_item_free(item, mem);
   mem->free(item, NULL);
 
@@ -4795,7 +5027,7 @@ void test_nghttp2_session_defer_data(void) {
 
   /* Resume deferred DATA */
   CU_ASSERT(0 == nghttp2_session_resume_data(session, 1));
-  item = (nghttp2_outbound_item *)nghttp2_pq_top(&session->ob_da_pq);
+  item = stream->item;
   item->aux_data.data.data_prd.read_callback =
       fixed_length_data_source_read_callback;
   ud.block_count = 1;
@@ -4813,7 +5045,7 @@ void test_nghttp2_session_defer_data(void) {
 
   /* Resume deferred DATA */
   CU_ASSERT(0 == nghttp2_session_resume_data(session, 1));
-  item = (nghttp2_outbound_item *)nghttp2_pq_top(&session->ob_da_pq);
+  item = stream->item;
   item->aux_data.data.data_prd.read_callback =
       fixed_length_data_source_read_callback;
   ud.block_count = 1;
@@ -6081,9 +6313,9 @@ void test_nghttp2_session_stream_dep_all_your_stream_are_belong_to_us(void) {
   CU_ASSERT(NGHTTP2_DEFAULT_WEIGHT == a->sum_dep_weight);
   CU_ASSERT(0 == b->sum_dep_weight);
 
-  CU_ASSERT(0 == a->sum_norest_weight);
-  CU_ASSERT(0 == b->sum_norest_weight);
-  CU_ASSERT(0 == c->sum_norest_weight);
+  CU_ASSERT(0 == a->queued);
+  CU_ASSERT(0 == b->queued);
+  CU_ASSERT(0 == c->queued);
 
   check_stream_dep_sib(c, NULL, a, NULL, NULL);
   check_stream_dep_sib(a, c, b, NULL, NULL);
@@ -6119,9 +6351,9 @@ void test_nghttp2_session_stream_dep_all_your_stream_are_belong_to_us(void) {
   CU_ASSERT(0 == b->sum_dep_weight);
   CU_ASSERT(0 == a->sum_dep_weight);
 
-  CU_ASSERT(0 == a->sum_norest_weight);
-  CU_ASSERT(0 == b->sum_norest_weight);
-  CU_ASSERT(0 == c->sum_norest_weight);
+  CU_ASSERT(0 == a->queued);
+  CU_ASSERT(0 == b->queued);
+  CU_ASSERT(0 == c->queued);
 
   check_stream_dep_sib(c, NULL, b, NULL, NULL);
   check_stream_dep_sib(b, c, NULL, NULL, a);
@@ -6164,10 +6396,10 @@ void test_nghttp2_session_stream_dep_all_your_stream_are_belong_to_us(void) {
   CU_ASSERT(NGHTTP2_DEFAULT_WEIGHT == a->sum_dep_weight);
   CU_ASSERT(0 == b->sum_dep_weight);
 
-  CU_ASSERT(0 == a->sum_norest_weight);
-  CU_ASSERT(0 == b->sum_norest_weight);
-  CU_ASSERT(0 == c->sum_norest_weight);
-  CU_ASSERT(0 == d->sum_norest_weight);
+  CU_ASSERT(0 == a->queued);
+  CU_ASSERT(0 == b->queued);
+  CU_ASSERT(0 == c->queued);
+  CU_ASSERT(0 == d->queued);
 
   check_stream_dep_sib(c, NULL, a, NULL, NULL);
   check_stream_dep_sib(d, c, NULL, a, NULL);
@@ -6204,14 +6436,15 @@ void test_nghttp2_session_stream_dep_all_your_stream_are_belong_to_us(void) {
    * |
    * b
    */
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_NO_ITEM == a->dpri);
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_TOP == b->dpri);
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_NO_ITEM == c->dpri);
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_NO_ITEM == d->dpri);
+  CU_ASSERT(1 == a->queued);
+  CU_ASSERT(1 == b->queued);
+  CU_ASSERT(1 == c->queued);
+  CU_ASSERT(0 == d->queued);
 
-  CU_ASSERT(16 == a->sum_norest_weight);
-  CU_ASSERT(16 == c->sum_norest_weight);
-  CU_ASSERT(0 == d->sum_norest_weight);
+  CU_ASSERT(1 == nghttp2_pq_size(&a->obq));
+  CU_ASSERT(1 == nghttp2_pq_size(&c->obq));
+  CU_ASSERT(0 == nghttp2_pq_size(&d->obq));
+  CU_ASSERT(1 == nghttp2_pq_size(&session->roots.obq));
 
   check_stream_dep_sib(c, NULL, a, NULL, NULL);
   check_stream_dep_sib(d, c, NULL, a, NULL);
@@ -6251,10 +6484,13 @@ void test_nghttp2_session_stream_dep_all_your_stream_are_belong_to_us(void) {
    * b
    */
 
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_NO_ITEM == a->dpri);
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_REST == b->dpri);
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_TOP == c->dpri);
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_NO_ITEM == d->dpri);
+  CU_ASSERT(1 == a->queued);
+  CU_ASSERT(1 == b->queued);
+  CU_ASSERT(1 == c->queued);
+  CU_ASSERT(0 == d->queued);
+
+  CU_ASSERT(1 == nghttp2_pq_size(&a->obq));
+  CU_ASSERT(1 == nghttp2_pq_size(&c->obq));
 
   check_stream_dep_sib(c, NULL, a, NULL, NULL);
   check_stream_dep_sib(d, c, NULL, a, NULL);
@@ -6293,92 +6529,80 @@ void test_nghttp2_session_stream_attach_item(void) {
 
   nghttp2_stream_attach_item(b, db, session);
 
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_NO_ITEM == a->dpri);
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_TOP == b->dpri);
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_NO_ITEM == c->dpri);
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_NO_ITEM == d->dpri);
-
-  CU_ASSERT(16 == nghttp2_stream_compute_effective_weight(b));
-
-  CU_ASSERT(16 == a->sum_norest_weight);
+  CU_ASSERT(1 == a->queued);
+  CU_ASSERT(1 == b->queued);
+  CU_ASSERT(0 == c->queued);
+  CU_ASSERT(0 == d->queued);
 
-  CU_ASSERT(1 == db->queued);
+  CU_ASSERT(1 == nghttp2_pq_size(&a->obq));
+  CU_ASSERT(1 == nghttp2_pq_size(&session->roots.obq));
 
   dc = create_data_ob_item(mem);
 
   nghttp2_stream_attach_item(c, dc, session);
 
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_NO_ITEM == a->dpri);
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_TOP == b->dpri);
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_TOP == c->dpri);
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_NO_ITEM == d->dpri);
+  CU_ASSERT(1 == a->queued);
+  CU_ASSERT(1 == b->queued);
+  CU_ASSERT(1 == c->queued);
+  CU_ASSERT(0 == d->queued);
 
-  CU_ASSERT(16 * 16 / 32 == nghttp2_stream_compute_effective_weight(b));
-  CU_ASSERT(16 * 16 / 32 == nghttp2_stream_compute_effective_weight(c));
-
-  CU_ASSERT(32 == a->sum_norest_weight);
-
-  CU_ASSERT(1 == dc->queued);
+  CU_ASSERT(2 == nghttp2_pq_size(&a->obq));
 
   da = create_data_ob_item(mem);
 
   nghttp2_stream_attach_item(a, da, session);
 
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_TOP == a->dpri);
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_REST == b->dpri);
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_REST == c->dpri);
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_NO_ITEM == d->dpri);
+  CU_ASSERT(1 == a->queued);
+  CU_ASSERT(1 == b->queued);
+  CU_ASSERT(1 == c->queued);
+  CU_ASSERT(0 == d->queued);
 
-  CU_ASSERT(16 == nghttp2_stream_compute_effective_weight(a));
-
-  CU_ASSERT(1 == da->queued);
+  CU_ASSERT(2 == nghttp2_pq_size(&a->obq));
 
   nghttp2_stream_detach_item(a, session);
+  mem->free(da, NULL);
 
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_NO_ITEM == a->dpri);
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_TOP == b->dpri);
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_TOP == c->dpri);
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_NO_ITEM == d->dpri);
+  /* a is still queued, since its descendants have items to send */
+  CU_ASSERT(1 == a->queued);
+  CU_ASSERT(1 == b->queued);
+  CU_ASSERT(1 == c->queued);
+  CU_ASSERT(0 == d->queued);
 
-  CU_ASSERT(16 * 16 / 32 == nghttp2_stream_compute_effective_weight(b));
-  CU_ASSERT(16 * 16 / 32 == nghttp2_stream_compute_effective_weight(c));
+  CU_ASSERT(2 == nghttp2_pq_size(&a->obq));
 
   dd = create_data_ob_item(mem);
 
   nghttp2_stream_attach_item(d, dd, session);
 
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_NO_ITEM == a->dpri);
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_TOP == b->dpri);
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_TOP == c->dpri);
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_REST == d->dpri);
-
-  CU_ASSERT(16 * 16 / 32 == nghttp2_stream_compute_effective_weight(b));
-  CU_ASSERT(16 * 16 / 32 == nghttp2_stream_compute_effective_weight(c));
+  CU_ASSERT(1 == a->queued);
+  CU_ASSERT(1 == b->queued);
+  CU_ASSERT(1 == c->queued);
+  CU_ASSERT(1 == d->queued);
 
-  CU_ASSERT(0 == dd->queued);
+  CU_ASSERT(2 == nghttp2_pq_size(&a->obq));
+  CU_ASSERT(1 == nghttp2_pq_size(&c->obq));
 
   nghttp2_stream_detach_item(c, session);
+  mem->free(dc, NULL);
 
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_NO_ITEM == a->dpri);
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_TOP == b->dpri);
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_NO_ITEM == c->dpri);
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_TOP == d->dpri);
+  CU_ASSERT(1 == a->queued);
+  CU_ASSERT(1 == b->queued);
+  CU_ASSERT(1 == c->queued);
+  CU_ASSERT(1 == d->queued);
 
-  CU_ASSERT(16 * 16 / 32 == nghttp2_stream_compute_effective_weight(b));
-  CU_ASSERT(16 * 16 / 32 == nghttp2_stream_compute_effective_weight(d));
-
-  CU_ASSERT(1 == dd->queued);
+  CU_ASSERT(2 == nghttp2_pq_size(&a->obq));
+  CU_ASSERT(1 == nghttp2_pq_size(&c->obq));
 
   nghttp2_stream_detach_item(b, session);
+  mem->free(db, NULL);
 
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_NO_ITEM == a->dpri);
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_NO_ITEM == b->dpri);
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_NO_ITEM == c->dpri);
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_TOP == d->dpri);
-
-  CU_ASSERT(16 * 16 / 16 == nghttp2_stream_compute_effective_weight(d));
+  CU_ASSERT(1 == a->queued);
+  CU_ASSERT(0 == b->queued);
+  CU_ASSERT(1 == c->queued);
+  CU_ASSERT(1 == d->queued);
 
-  CU_ASSERT(1 == dd->queued);
+  CU_ASSERT(1 == nghttp2_pq_size(&a->obq));
+  CU_ASSERT(1 == nghttp2_pq_size(&c->obq));
 
   /* exercises insertion */
   e = open_stream_with_dep_excl(session, 9, a);
@@ -6392,21 +6616,19 @@ void test_nghttp2_session_stream_attach_item(void) {
    * d
    */
 
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_NO_ITEM == e->dpri);
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_NO_ITEM == a->dpri);
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_NO_ITEM == b->dpri);
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_NO_ITEM == c->dpri);
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_TOP == d->dpri);
+  CU_ASSERT(1 == e->queued);
+  CU_ASSERT(1 == a->queued);
+  CU_ASSERT(0 == b->queued);
+  CU_ASSERT(1 == c->queued);
+  CU_ASSERT(1 == d->queued);
 
-  CU_ASSERT(16 * 16 / 16 == nghttp2_stream_compute_effective_weight(d));
-
-  CU_ASSERT(16 == a->sum_norest_weight);
-  CU_ASSERT(16 == e->sum_norest_weight);
-  CU_ASSERT(16 == c->sum_norest_weight);
-  CU_ASSERT(0 == b->sum_norest_weight);
+  CU_ASSERT(1 == nghttp2_pq_size(&a->obq));
+  CU_ASSERT(1 == nghttp2_pq_size(&e->obq));
+  CU_ASSERT(1 == nghttp2_pq_size(&c->obq));
+  CU_ASSERT(0 == nghttp2_pq_size(&b->obq));
 
   /* exercises deletion */
-  nghttp2_stream_dep_remove(e);
+  CU_ASSERT(0 == nghttp2_stream_dep_remove(e));
 
   /* a
    * |
@@ -6415,18 +6637,19 @@ void test_nghttp2_session_stream_attach_item(void) {
    * d
    */
 
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_NO_ITEM == a->dpri);
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_NO_ITEM == b->dpri);
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_NO_ITEM == c->dpri);
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_TOP == d->dpri);
+  CU_ASSERT(1 == a->queued);
+  CU_ASSERT(0 == b->queued);
+  CU_ASSERT(1 == c->queued);
+  CU_ASSERT(1 == d->queued);
 
-  CU_ASSERT(16 * 16 / 16 == nghttp2_stream_compute_effective_weight(d));
+  CU_ASSERT(1 == nghttp2_pq_size(&a->obq));
+  CU_ASSERT(1 == nghttp2_pq_size(&c->obq));
+  CU_ASSERT(0 == nghttp2_pq_size(&b->obq));
 
   /* e's weight 16 is distributed equally among c and b, both now have
      weight 8 each. */
-  CU_ASSERT(8 == a->sum_norest_weight);
-  CU_ASSERT(16 == c->sum_norest_weight);
-  CU_ASSERT(0 == b->sum_norest_weight);
+  CU_ASSERT(8 == b->weight);
+  CU_ASSERT(8 == c->weight);
 
   nghttp2_session_del(session);
 
@@ -6452,21 +6675,21 @@ void test_nghttp2_session_stream_attach_item(void) {
   nghttp2_stream_attach_item(b, db, session);
   nghttp2_stream_attach_item(c, dc, session);
 
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_TOP == a->dpri);
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_REST == b->dpri);
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_REST == c->dpri);
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_NO_ITEM == d->dpri);
+  CU_ASSERT(1 == a->queued);
+  CU_ASSERT(1 == b->queued);
+  CU_ASSERT(1 == c->queued);
+  CU_ASSERT(0 == d->queued);
 
-  /* check that all children's item get queued */
+  /* check that all children's item are still queued */
   nghttp2_stream_detach_item(a, session);
+  mem->free(da, NULL);
 
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_NO_ITEM == a->dpri);
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_TOP == b->dpri);
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_TOP == c->dpri);
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_NO_ITEM == d->dpri);
+  CU_ASSERT(1 == a->queued);
+  CU_ASSERT(1 == b->queued);
+  CU_ASSERT(1 == c->queued);
+  CU_ASSERT(0 == d->queued);
 
-  CU_ASSERT(1 == db->queued);
-  CU_ASSERT(1 == dc->queued);
+  CU_ASSERT(2 == nghttp2_pq_size(&a->obq));
 
   nghttp2_session_del(session);
 }
@@ -6509,19 +6732,17 @@ void test_nghttp2_session_stream_attach_item_subtree(void) {
 
   nghttp2_stream_attach_item(b, db, session);
 
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_NO_ITEM == a->dpri);
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_TOP == b->dpri);
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_NO_ITEM == c->dpri);
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_NO_ITEM == d->dpri);
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_TOP == e->dpri);
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_NO_ITEM == f->dpri);
-
-  CU_ASSERT(16 == nghttp2_stream_compute_effective_weight(b));
-  CU_ASSERT(32 == nghttp2_stream_compute_effective_weight(e));
+  CU_ASSERT(1 == a->queued);
+  CU_ASSERT(1 == b->queued);
+  CU_ASSERT(0 == c->queued);
+  CU_ASSERT(0 == d->queued);
+  CU_ASSERT(1 == e->queued);
+  CU_ASSERT(0 == f->queued);
 
-  CU_ASSERT(16 == a->sum_norest_weight);
-  CU_ASSERT(0 == c->sum_norest_weight);
-  CU_ASSERT(0 == d->sum_norest_weight);
+  CU_ASSERT(1 == nghttp2_pq_size(&a->obq));
+  CU_ASSERT(0 == nghttp2_pq_size(&c->obq));
+  CU_ASSERT(0 == nghttp2_pq_size(&d->obq));
+  CU_ASSERT(2 == nghttp2_pq_size(&session->roots.obq));
 
   /* Insert subtree e under a */
 
@@ -6538,16 +6759,16 @@ void test_nghttp2_session_stream_attach_item_subtree(void) {
    *    d
    */
 
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_NO_ITEM == a->dpri);
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_REST == b->dpri);
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_NO_ITEM == c->dpri);
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_NO_ITEM == d->dpri);
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_TOP == e->dpri);
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_NO_ITEM == f->dpri);
+  CU_ASSERT(1 == a->queued);
+  CU_ASSERT(1 == b->queued);
+  CU_ASSERT(0 == c->queued);
+  CU_ASSERT(0 == d->queued);
+  CU_ASSERT(1 == e->queued);
+  CU_ASSERT(0 == f->queued);
 
-  CU_ASSERT(16 == nghttp2_stream_compute_effective_weight(e));
-
-  CU_ASSERT(32 == a->sum_norest_weight);
+  CU_ASSERT(1 == nghttp2_pq_size(&a->obq));
+  CU_ASSERT(1 == nghttp2_pq_size(&e->obq));
+  CU_ASSERT(1 == nghttp2_pq_size(&session->roots.obq));
 
   /* Remove subtree b */
 
@@ -6565,15 +6786,16 @@ void test_nghttp2_session_stream_attach_item_subtree(void) {
    *    d
    */
 
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_NO_ITEM == a->dpri);
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_TOP == b->dpri);
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_NO_ITEM == c->dpri);
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_NO_ITEM == d->dpri);
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_TOP == e->dpri);
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_NO_ITEM == f->dpri);
+  CU_ASSERT(1 == a->queued);
+  CU_ASSERT(1 == b->queued);
+  CU_ASSERT(0 == c->queued);
+  CU_ASSERT(0 == d->queued);
+  CU_ASSERT(1 == e->queued);
+  CU_ASSERT(0 == f->queued);
 
-  CU_ASSERT(16 == nghttp2_stream_compute_effective_weight(b));
-  CU_ASSERT(16 == nghttp2_stream_compute_effective_weight(e));
+  CU_ASSERT(1 == nghttp2_pq_size(&a->obq));
+  CU_ASSERT(0 == nghttp2_pq_size(&e->obq));
+  CU_ASSERT(2 == nghttp2_pq_size(&session->roots.obq));
 
   /* Remove subtree a */
 
@@ -6581,12 +6803,14 @@ void test_nghttp2_session_stream_attach_item_subtree(void) {
 
   nghttp2_stream_dep_make_root(a, session);
 
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_NO_ITEM == a->dpri);
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_TOP == b->dpri);
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_NO_ITEM == c->dpri);
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_NO_ITEM == d->dpri);
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_TOP == e->dpri);
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_NO_ITEM == f->dpri);
+  CU_ASSERT(1 == a->queued);
+  CU_ASSERT(1 == b->queued);
+  CU_ASSERT(0 == c->queued);
+  CU_ASSERT(0 == d->queued);
+  CU_ASSERT(1 == e->queued);
+  CU_ASSERT(0 == f->queued);
+
+  CU_ASSERT(2 == nghttp2_pq_size(&session->roots.obq));
 
   /* Remove subtree c */
 
@@ -6602,21 +6826,24 @@ void test_nghttp2_session_stream_attach_item_subtree(void) {
    * f
    */
 
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_NO_ITEM == a->dpri);
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_TOP == b->dpri);
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_NO_ITEM == c->dpri);
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_NO_ITEM == d->dpri);
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_TOP == e->dpri);
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_NO_ITEM == f->dpri);
+  CU_ASSERT(1 == a->queued);
+  CU_ASSERT(1 == b->queued);
+  CU_ASSERT(0 == c->queued);
+  CU_ASSERT(0 == d->queued);
+  CU_ASSERT(1 == e->queued);
+  CU_ASSERT(0 == f->queued);
 
-  CU_ASSERT(32 == a->sum_norest_weight);
-  CU_ASSERT(0 == c->sum_norest_weight);
+  CU_ASSERT(1 == nghttp2_pq_size(&a->obq));
+  CU_ASSERT(0 == nghttp2_pq_size(&c->obq));
 
   dd = create_data_ob_item(mem);
 
   nghttp2_stream_attach_item(d, dd, session);
 
-  CU_ASSERT(16 == c->sum_norest_weight);
+  CU_ASSERT(1 == c->queued);
+  CU_ASSERT(1 == d->queued);
+  CU_ASSERT(1 == nghttp2_pq_size(&c->obq));
+  CU_ASSERT(3 == nghttp2_pq_size(&session->roots.obq));
 
   /* Add subtree c to a */
 
@@ -6631,19 +6858,16 @@ void test_nghttp2_session_stream_attach_item_subtree(void) {
    * d  f
    */
 
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_NO_ITEM == a->dpri);
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_TOP == b->dpri);
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_NO_ITEM == c->dpri);
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_TOP == d->dpri);
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_TOP == e->dpri);
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_NO_ITEM == f->dpri);
+  CU_ASSERT(1 == a->queued);
+  CU_ASSERT(1 == b->queued);
+  CU_ASSERT(1 == c->queued);
+  CU_ASSERT(1 == d->queued);
+  CU_ASSERT(1 == e->queued);
+  CU_ASSERT(0 == f->queued);
 
-  CU_ASSERT(16 == nghttp2_stream_compute_effective_weight(b));
-  CU_ASSERT(16 * 16 / 48 == nghttp2_stream_compute_effective_weight(d));
-  CU_ASSERT(16 * 32 / 48 == nghttp2_stream_compute_effective_weight(e));
-
-  CU_ASSERT(48 == a->sum_norest_weight);
-  CU_ASSERT(16 == c->sum_norest_weight);
+  CU_ASSERT(2 == nghttp2_pq_size(&a->obq));
+  CU_ASSERT(1 == nghttp2_pq_size(&c->obq));
+  CU_ASSERT(2 == nghttp2_pq_size(&session->roots.obq));
 
   /* Insert b under a */
 
@@ -6660,16 +6884,16 @@ void test_nghttp2_session_stream_attach_item_subtree(void) {
    * f  d
    */
 
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_NO_ITEM == a->dpri);
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_TOP == b->dpri);
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_NO_ITEM == c->dpri);
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_REST == d->dpri);
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_REST == e->dpri);
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_NO_ITEM == f->dpri);
-
-  CU_ASSERT(16 == nghttp2_stream_compute_effective_weight(b));
+  CU_ASSERT(1 == a->queued);
+  CU_ASSERT(1 == b->queued);
+  CU_ASSERT(1 == c->queued);
+  CU_ASSERT(1 == d->queued);
+  CU_ASSERT(1 == e->queued);
+  CU_ASSERT(0 == f->queued);
 
-  CU_ASSERT(16 == a->sum_norest_weight);
+  CU_ASSERT(1 == nghttp2_pq_size(&a->obq));
+  CU_ASSERT(2 == nghttp2_pq_size(&b->obq));
+  CU_ASSERT(1 == nghttp2_pq_size(&session->roots.obq));
 
   /* Remove subtree b */
 
@@ -6684,20 +6908,23 @@ void test_nghttp2_session_stream_attach_item_subtree(void) {
    * f  d
    */
 
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_NO_ITEM == a->dpri);
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_TOP == b->dpri);
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_NO_ITEM == c->dpri);
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_REST == d->dpri);
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_REST == e->dpri);
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_NO_ITEM == f->dpri);
+  CU_ASSERT(0 == a->queued);
+  CU_ASSERT(1 == b->queued);
+  CU_ASSERT(1 == c->queued);
+  CU_ASSERT(1 == d->queued);
+  CU_ASSERT(1 == e->queued);
+  CU_ASSERT(0 == f->queued);
 
-  CU_ASSERT(0 == a->sum_norest_weight);
+  CU_ASSERT(0 == nghttp2_pq_size(&a->obq));
+  CU_ASSERT(2 == nghttp2_pq_size(&b->obq));
+  CU_ASSERT(1 == nghttp2_pq_size(&session->roots.obq));
 
   /* Remove subtree c, and detach item from b, and then re-add
      subtree c under b */
 
   nghttp2_stream_dep_remove_subtree(c);
   nghttp2_stream_detach_item(b, session);
+  mem->free(db, NULL);
   nghttp2_stream_dep_add_subtree(b, c, session);
 
   /*
@@ -6708,19 +6935,20 @@ void test_nghttp2_session_stream_attach_item_subtree(void) {
    * f  d
    */
 
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_NO_ITEM == a->dpri);
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_NO_ITEM == b->dpri);
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_NO_ITEM == c->dpri);
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_TOP == d->dpri);
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_TOP == e->dpri);
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_NO_ITEM == f->dpri);
+  CU_ASSERT(0 == a->queued);
+  CU_ASSERT(1 == b->queued);
+  CU_ASSERT(1 == c->queued);
+  CU_ASSERT(1 == d->queued);
+  CU_ASSERT(1 == e->queued);
+  CU_ASSERT(0 == f->queued);
 
-  CU_ASSERT(48 == b->sum_norest_weight);
+  CU_ASSERT(2 == nghttp2_pq_size(&b->obq));
 
   /* Attach data to a, and add subtree a under b */
 
   da = create_data_ob_item(mem);
   nghttp2_stream_attach_item(a, da, session);
+  nghttp2_stream_dep_remove_subtree(a);
   nghttp2_stream_dep_add_subtree(b, a, session);
 
   /*
@@ -6730,14 +6958,15 @@ void test_nghttp2_session_stream_attach_item_subtree(void) {
    *    |  |
    *    f  d
    */
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_TOP == a->dpri);
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_NO_ITEM == b->dpri);
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_NO_ITEM == c->dpri);
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_TOP == d->dpri);
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_TOP == e->dpri);
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_NO_ITEM == f->dpri);
+  CU_ASSERT(1 == a->queued);
+  CU_ASSERT(1 == b->queued);
+  CU_ASSERT(1 == c->queued);
+  CU_ASSERT(1 == d->queued);
+  CU_ASSERT(1 == e->queued);
+  CU_ASSERT(0 == f->queued);
 
-  CU_ASSERT(64 == b->sum_norest_weight);
+  CU_ASSERT(3 == nghttp2_pq_size(&b->obq));
+  CU_ASSERT(1 == nghttp2_pq_size(&session->roots.obq));
 
   /* Remove subtree c, and add under f */
   nghttp2_stream_dep_remove_subtree(c);
@@ -6754,14 +6983,123 @@ void test_nghttp2_session_stream_attach_item_subtree(void) {
    *    |
    *    d
    */
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_TOP == a->dpri);
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_NO_ITEM == b->dpri);
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_NO_ITEM == c->dpri);
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_REST == d->dpri);
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_TOP == e->dpri);
-  CU_ASSERT(NGHTTP2_STREAM_DPRI_NO_ITEM == f->dpri);
+  CU_ASSERT(1 == a->queued);
+  CU_ASSERT(1 == b->queued);
+  CU_ASSERT(1 == c->queued);
+  CU_ASSERT(1 == d->queued);
+  CU_ASSERT(1 == e->queued);
+  CU_ASSERT(1 == f->queued);
+
+  CU_ASSERT(2 == nghttp2_pq_size(&b->obq));
+  CU_ASSERT(1 == nghttp2_pq_size(&e->obq));
+  CU_ASSERT(1 == nghttp2_pq_size(&f->obq));
+  CU_ASSERT(1 == nghttp2_pq_size(&c->obq));
+
+  nghttp2_session_del(session);
+}
+
+static void submit_unlimited_data(nghttp2_session *session,
+                                  nghttp2_stream *stream) {
+  nghttp2_data_provider data_prd;
+
+  data_prd.read_callback = unlimited_data_source_read_callback;
+
+  stream->remote_window_size = NGHTTP2_MAX_WINDOW_SIZE;
+
+  CU_ASSERT(0 == nghttp2_submit_data(session, NGHTTP2_FLAG_NONE,
+                                     stream->stream_id, &data_prd));
+}
+
+void test_nghttp2_session_stream_bandwidth_share(void) {
+  nghttp2_session *session;
+  nghttp2_session_callbacks callbacks;
+  nghttp2_stream *a, *b, *c, *d;
+  my_user_data ud;
+
+  memset(&callbacks, 0, sizeof(callbacks));
+  callbacks.send_callback = block_count_send_callback;
+  callbacks.on_frame_send_callback = count_data_on_frame_send_callback;
+
+  /* Siblings share bandwidth in proportion to their weight */
+  memset(&ud, 0, sizeof(ud));
+  nghttp2_session_server_new(&session, &callbacks, &ud);
+  session->remote_window_size = NGHTTP2_MAX_WINDOW_SIZE;
+
+  a = open_stream(session, 1);
+  b = open_stream_with_dep_weight(session, 3, 16, a);
+  c = open_stream_with_dep_weight(session, 5, 32, a);
+
+  /*
+   * a
+   * |
+   * c--b
+   */
+
+  submit_unlimited_data(session, b);
+  submit_unlimited_data(session, c);
+
+  ud.block_count = 30;
+
+  CU_ASSERT(0 == nghttp2_session_send(session));
+  CU_ASSERT(0 == ud.data_frames_sent[0]);
+  CU_ASSERT(10 == ud.data_frames_sent[1]);
+  CU_ASSERT(20 == ud.data_frames_sent[2]);
+
+  /* The share of stream which starts sending later is not affected by
+     the amount of data sent by others before. */
+  d = open_stream_with_dep_weight(session, 7, 16, a);
+  submit_unlimited_data(session, d);
+
+  memset(ud.data_frames_sent, 0, sizeof(ud.data_frames_sent));
+  ud.block_count = 40;
+
+  CU_ASSERT(0 == nghttp2_session_send(session));
+  CU_ASSERT(10 == ud.data_frames_sent[1]);
+  CU_ASSERT(20 == ud.data_frames_sent[2]);
+  CU_ASSERT(10 == ud.data_frames_sent[3]);
+
+  nghttp2_session_del(session);
+
+  /* Bandwidth is divided at each level of dependency tree */
+  memset(&ud, 0, sizeof(ud));
+  nghttp2_session_server_new(&session, &callbacks, &ud);
+  session->remote_window_size = NGHTTP2_MAX_WINDOW_SIZE;
+
+  a = open_stream(session, 1);
+  b = open_stream_with_dep(session, 3, a);
+  c = open_stream_with_dep(session, 5, a);
+  d = open_stream(session, 7);
+
+  /*
+   * a     d
+   * |
+   * c--b
+   */
+
+  submit_unlimited_data(session, b);
+  submit_unlimited_data(session, c);
+  submit_unlimited_data(session, d);
+
+  ud.block_count = 40;
 
-  CU_ASSERT(48 == b->sum_norest_weight);
+  CU_ASSERT(0 == nghttp2_session_send(session));
+  CU_ASSERT(10 == ud.data_frames_sent[1]);
+  CU_ASSERT(10 == ud.data_frames_sent[2]);
+  CU_ASSERT(20 == ud.data_frames_sent[3]);
+
+  /* Once a has its own data, it takes the whole share of its subtree
+     from its descendants. */
+  submit_unlimited_data(session, a);
+
+  memset(ud.data_frames_sent, 0, sizeof(ud.data_frames_sent));
+  ud.block_count = 40;
+
+  CU_ASSERT(0 == nghttp2_session_send(session));
+  /* The first DATA frame is the one which was packed, but blocked in
+     the previous round. */
+  CU_ASSERT(19 == ud.data_frames_sent[0]);
+  CU_ASSERT(1 == ud.data_frames_sent[1] + ud.data_frames_sent[2]);
+  CU_ASSERT(20 == ud.data_frames_sent[3]);
 
   nghttp2_session_del(session);
 }
@@ -6786,97 +7124,316 @@ void test_nghttp2_session_keep_closed_stream(void) {
   }
 
   CU_ASSERT(0 == session->num_closed_streams);
+  CU_ASSERT(0 == session->num_tombstones);
 
   nghttp2_session_close_stream(session, 1, NGHTTP2_NO_ERROR);
 
-  CU_ASSERT(1 == session->num_closed_streams);
-  CU_ASSERT(1 == session->closed_stream_tail->stream_id);
-  CU_ASSERT(session->closed_stream_tail == session->closed_stream_head);
+  /* Nothing depends on stream 1, so only its tombstone is kept */
+  CU_ASSERT(0 == session->num_closed_streams);
+  CU_ASSERT(1 == session->num_tombstones);
+  CU_ASSERT(NULL == nghttp2_session_get_stream_raw(session, 1));
+  CU_ASSERT(1 == session->tombstone_tail->map_entry.key);
+  CU_ASSERT(session->tombstone_tail == session->tombstone_head);
 
   nghttp2_session_close_stream(session, 5, NGHTTP2_NO_ERROR);
 
-  CU_ASSERT(2 == session->num_closed_streams);
-  CU_ASSERT(5 == session->closed_stream_tail->stream_id);
-  CU_ASSERT(1 == session->closed_stream_head->stream_id);
-  CU_ASSERT(session->closed_stream_head ==
-            session->closed_stream_tail->closed_prev);
-  CU_ASSERT(NULL == session->closed_stream_tail->closed_next);
-  CU_ASSERT(session->closed_stream_tail ==
-            session->closed_stream_head->closed_next);
-  CU_ASSERT(NULL == session->closed_stream_head->closed_prev);
+  CU_ASSERT(2 == session->num_tombstones);
+  CU_ASSERT(5 == session->tombstone_tail->map_entry.key);
+  CU_ASSERT(1 == session->tombstone_head->map_entry.key);
+  CU_ASSERT(session->tombstone_head == session->tombstone_tail->prev);
+  CU_ASSERT(NULL == session->tombstone_tail->next);
+  CU_ASSERT(session->tombstone_tail == session->tombstone_head->next);
+  CU_ASSERT(NULL == session->tombstone_head->prev);
 
   open_stream(session, 11);
 
-  CU_ASSERT(1 == session->num_closed_streams);
-  CU_ASSERT(5 == session->closed_stream_tail->stream_id);
-  CU_ASSERT(session->closed_stream_tail == session->closed_stream_head);
-  CU_ASSERT(NULL == session->closed_stream_head->closed_prev);
-  CU_ASSERT(NULL == session->closed_stream_head->closed_next);
+  CU_ASSERT(1 == session->num_tombstones);
+  CU_ASSERT(5 == session->tombstone_tail->map_entry.key);
+  CU_ASSERT(session->tombstone_tail == session->tombstone_head);
+  CU_ASSERT(NULL == session->tombstone_head->prev);
+  CU_ASSERT(NULL == session->tombstone_head->next);
 
   open_stream(session, 13);
 
-  CU_ASSERT(0 == session->num_closed_streams);
-  CU_ASSERT(NULL == session->closed_stream_tail);
-  CU_ASSERT(NULL == session->closed_stream_head);
+  CU_ASSERT(0 == session->num_tombstones);
+  CU_ASSERT(NULL == session->tombstone_tail);
+  CU_ASSERT(NULL == session->tombstone_head);
+
+  /* Stream 3 has a descendant, so that it is kept as is */
+  nghttp2_session_close_stream(session, 9, NGHTTP2_NO_ERROR);
+  open_stream_with_dep(session, 15, nghttp2_session_get_stream(session, 3));
+
+  nghttp2_session_close_stream(session, 3, NGHTTP2_NO_ERROR);
+
+  CU_ASSERT(1 == session->num_closed_streams);
+  CU_ASSERT(0 == session->num_tombstones);
+  CU_ASSERT(3 == session->closed_stream_head->stream_id);
+  CU_ASSERT(session->closed_stream_tail == session->closed_stream_head);
 
   nghttp2_session_del(session);
 }
 
-void test_nghttp2_session_keep_idle_stream(void) {
+void test_nghttp2_session_promote_tombstone(void) {
   nghttp2_session *session;
   nghttp2_session_callbacks callbacks;
-  const size_t max_concurrent_streams = 1;
-  nghttp2_settings_entry iv = {NGHTTP2_SETTINGS_MAX_CONCURRENT_STREAMS,
-                               max_concurrent_streams};
-  int i;
+  nghttp2_stream *a, *b, *c;
+  nghttp2_priority_spec pri_spec;
+  nghttp2_frame frame;
 
   memset(&callbacks, 0, sizeof(callbacks));
   callbacks.send_callback = null_send_callback;
 
   nghttp2_session_server_new(&session, &callbacks, NULL);
 
-  nghttp2_submit_settings(session, NGHTTP2_FLAG_NONE, &iv, 1);
+  /*
+   *  a
+   *  |
+   *  b
+   */
+  a = open_stream(session, 1);
+  b = open_stream_with_dep_weight(session, 3, 32, a);
 
-  /* We at least allow 2 idle streams even if max concurrent streams
-     is very low. */
-  for (i = 0; i < 2; ++i) {
-    nghttp2_session_open_stream(session, i * 2 + 1, NGHTTP2_STREAM_FLAG_NONE,
-                                &pri_spec_default, NGHTTP2_STREAM_IDLE, NULL);
-  }
+  nghttp2_session_close_stream(session, 3, NGHTTP2_NO_ERROR);
 
-  CU_ASSERT(2 == session->num_idle_streams);
+  CU_ASSERT(1 == session->num_tombstones);
+  CU_ASSERT(1 == session->tombstone_head->dep_stream_id);
+  CU_ASSERT(32 == session->tombstone_head->weight);
+  CU_ASSERT(NULL == a->dep_next);
 
-  CU_ASSERT(1 == session->idle_stream_head->stream_id);
-  CU_ASSERT(3 == session->idle_stream_tail->stream_id);
+  /* New stream depends on closed stream 3 */
+  nghttp2_priority_spec_init(&pri_spec, 3, 8, 0);
 
-  nghttp2_session_open_stream(session, 5, NGHTTP2_FLAG_NONE, &pri_spec_default,
-                              NGHTTP2_STREAM_IDLE, NULL);
+  c = nghttp2_session_open_stream(session, 5, NGHTTP2_STREAM_FLAG_NONE,
+                                  &pri_spec, NGHTTP2_STREAM_OPENED, NULL);
 
-  CU_ASSERT(2 == session->num_idle_streams);
+  CU_ASSERT(0 == session->num_tombstones);
+  CU_ASSERT(1 == session->num_closed_streams);
 
-  CU_ASSERT(3 == session->idle_stream_head->stream_id);
-  CU_ASSERT(5 == session->idle_stream_tail->stream_id);
+  b = nghttp2_session_get_stream_raw(session, 3);
+
+  CU_ASSERT(NULL != b);
+  CU_ASSERT(b == session->closed_stream_head);
+  CU_ASSERT(b->flags & NGHTTP2_STREAM_FLAG_CLOSED);
+  CU_ASSERT(NULL == nghttp2_session_get_stream(session, 3));
+  CU_ASSERT(a == b->dep_prev);
+  CU_ASSERT(32 == b->weight);
+  CU_ASSERT(b == c->dep_prev);
+  CU_ASSERT(8 == c->weight);
+  CU_ASSERT(3 == a->num_substreams);
+
+  /* PRIORITY to the tombstone of root stream brings it back */
+  nghttp2_session_close_stream(session, 5, NGHTTP2_NO_ERROR);
+
+  CU_ASSERT(1 == session->num_tombstones);
+
+  nghttp2_priority_spec_init(&pri_spec, 1, 64, 0);
+  nghttp2_frame_priority_init(&frame.priority, 5, &pri_spec);
+
+  CU_ASSERT(0 == nghttp2_session_on_priority_received(session, &frame));
+
+  nghttp2_frame_priority_free(&frame.priority);
+
+  c = nghttp2_session_get_stream_raw(session, 5);
+
+  CU_ASSERT(0 == session->num_tombstones);
+  CU_ASSERT(2 == session->num_closed_streams);
+  CU_ASSERT(a == c->dep_prev);
+  CU_ASSERT(64 == c->weight);
 
   nghttp2_session_del(session);
 }
 
-void test_nghttp2_session_detach_idle_stream(void) {
+void test_nghttp2_session_memory_budget(void) {
   nghttp2_session *session;
   nghttp2_session_callbacks callbacks;
-  int i;
-  nghttp2_stream *stream;
+  nghttp2_option *option;
+  nghttp2_session_stats stats;
+  nghttp2_frame frame;
+  nghttp2_outbound_item *item;
+  nghttp2_mem *mem;
+  int32_t i;
 
+  mem = nghttp2_mem_default();
   memset(&callbacks, 0, sizeof(callbacks));
   callbacks.send_callback = null_send_callback;
 
-  nghttp2_session_server_new(&session, &callbacks, NULL);
+  nghttp2_option_new(&option);
+  nghttp2_option_set_max_session_memory(option, 1 << 20);
 
-  for (i = 1; i <= 3; ++i) {
-    nghttp2_session_open_stream(session, i, NGHTTP2_STREAM_FLAG_NONE,
-                                &pri_spec_default, NGHTTP2_STREAM_IDLE, NULL);
-  }
+  nghttp2_session_server_new2(&session, &callbacks, NULL, option);
 
-  CU_ASSERT(3 == session->num_idle_streams);
+  nghttp2_session_get_stats(session, &stats);
+
+  CU_ASSERT(stats.mem_used > 0);
+  CU_ASSERT(stats.mem_used < (1 << 20));
+
+  for (i = 1; i <= 7; i += 2) {
+    open_stream(session, i);
+    nghttp2_session_close_stream(session, i, NGHTTP2_NO_ERROR);
+  }
+
+  CU_ASSERT(4 == session->num_tombstones);
+
+  /* Budget is just reached.  Dropping the oldest closed stream makes
+     room for new stream. */
+  nghttp2_session_get_stats(session, &stats);
+  session->max_memory = stats.mem_used;
+
+  nghttp2_frame_headers_init(&frame.headers, NGHTTP2_FLAG_END_HEADERS, 9,
+                             NGHTTP2_HCAT_REQUEST, NULL, NULL, 0);
+
+  CU_ASSERT(0 == nghttp2_session_on_request_headers_received(session, &frame));
+  CU_ASSERT(NULL != nghttp2_session_get_stream(session, 9));
+  CU_ASSERT(3 == session->num_tombstones);
+  CU_ASSERT(3 == session->tombstone_head->map_entry.key);
+
+  nghttp2_session_get_stats(session, &stats);
+
+  CU_ASSERT(1 == stats.mem_trimmed_streams);
+  CU_ASSERT(0 == stats.mem_refused_streams);
+
+  nghttp2_frame_headers_free(&frame.headers, mem);
+
+  /* Budget is exhausted even after all closed streams are dropped */
+  session->max_memory = 1;
+
+  nghttp2_frame_headers_init(&frame.headers, NGHTTP2_FLAG_END_HEADERS, 11,
+                             NGHTTP2_HCAT_REQUEST, NULL, NULL, 0);
+
+  CU_ASSERT(NGHTTP2_ERR_IGN_HEADER_BLOCK ==
+            nghttp2_session_on_request_headers_received(session, &frame));
+  CU_ASSERT(NULL == nghttp2_session_get_stream(session, 11));
+  CU_ASSERT(0 == session->num_tombstones);
+
+  item = nghttp2_session_get_next_ob_item(session);
+
+  CU_ASSERT(NGHTTP2_RST_STREAM == item->frame.hd.type);
+  CU_ASSERT(11 == item->frame.hd.stream_id);
+  CU_ASSERT(NGHTTP2_REFUSED_STREAM == item->frame.rst_stream.error_code);
+
+  nghttp2_session_get_stats(session, &stats);
+
+  CU_ASSERT(4 == stats.mem_trimmed_streams);
+  CU_ASSERT(1 == stats.mem_refused_streams);
+
+  nghttp2_frame_headers_free(&frame.headers, mem);
+
+  /* Fewer closed streams are kept as the usage approaches the
+     budget */
+  session->max_memory = 1 << 20;
+  session->local_settings.max_concurrent_streams = 8;
+  session->pending_local_max_concurrent_stream = 8;
+
+  for (i = 13; i <= 17; i += 2) {
+    open_stream(session, i);
+    nghttp2_session_close_stream(session, i, NGHTTP2_NO_ERROR);
+  }
+
+  CU_ASSERT(3 == session->num_tombstones);
+
+  open_stream(session, 19);
+
+  nghttp2_session_get_stats(session, &stats);
+  session->max_memory = stats.mem_used + stats.mem_used / 4;
+
+  nghttp2_session_close_stream(session, 19, NGHTTP2_NO_ERROR);
+
+  /* About 2/5 of the half of the budget is left, so 8 * 6/16 */
+  CU_ASSERT(3 == session->num_tombstones);
+  CU_ASSERT(15 == session->tombstone_head->map_entry.key);
+
+  /* The limit does not shrink further while the usage stays the
+     same */
+  open_stream(session, 21);
+  nghttp2_session_close_stream(session, 21, NGHTTP2_NO_ERROR);
+
+  CU_ASSERT(3 == session->num_tombstones);
+  CU_ASSERT(17 == session->tombstone_head->map_entry.key);
+
+  /* With unlimited SETTINGS_MAX_CONCURRENT_STREAMS, the limit is
+     scaled from NGHTTP2_MEM_CLOSED_STREAM_MAX */
+  session->max_memory = 1 << 20;
+  session->local_settings.max_concurrent_streams =
+      NGHTTP2_INITIAL_MAX_CONCURRENT_STREAMS;
+  session->pending_local_max_concurrent_stream =
+      NGHTTP2_INITIAL_MAX_CONCURRENT_STREAMS;
+
+  for (i = 23; i <= 141; i += 2) {
+    open_stream(session, i);
+    nghttp2_session_close_stream(session, i, NGHTTP2_NO_ERROR);
+  }
+
+  CU_ASSERT(63 == session->num_tombstones);
+
+  open_stream(session, 143);
+
+  nghttp2_session_get_stats(session, &stats);
+  session->max_memory = stats.mem_used + stats.mem_used / 4;
+
+  nghttp2_session_close_stream(session, 143, NGHTTP2_NO_ERROR);
+
+  CU_ASSERT(NGHTTP2_MEM_CLOSED_STREAM_MAX * 6 / 16 ==
+            session->num_tombstones);
+
+  nghttp2_session_del(session);
+  nghttp2_option_del(option);
+}
+
+void test_nghttp2_session_keep_idle_stream(void) {
+  nghttp2_session *session;
+  nghttp2_session_callbacks callbacks;
+  const size_t max_concurrent_streams = 1;
+  nghttp2_settings_entry iv = {NGHTTP2_SETTINGS_MAX_CONCURRENT_STREAMS,
+                               max_concurrent_streams};
+  int i;
+
+  memset(&callbacks, 0, sizeof(callbacks));
+  callbacks.send_callback = null_send_callback;
+
+  nghttp2_session_server_new(&session, &callbacks, NULL);
+
+  nghttp2_submit_settings(session, NGHTTP2_FLAG_NONE, &iv, 1);
+
+  /* We at least allow 2 idle streams even if max concurrent streams
+     is very low. */
+  for (i = 0; i < 2; ++i) {
+    nghttp2_session_open_stream(session, i * 2 + 1, NGHTTP2_STREAM_FLAG_NONE,
+                                &pri_spec_default, NGHTTP2_STREAM_IDLE, NULL);
+  }
+
+  CU_ASSERT(2 == session->num_idle_streams);
+
+  CU_ASSERT(1 == session->idle_stream_head->stream_id);
+  CU_ASSERT(3 == session->idle_stream_tail->stream_id);
+
+  nghttp2_session_open_stream(session, 5, NGHTTP2_FLAG_NONE, &pri_spec_default,
+                              NGHTTP2_STREAM_IDLE, NULL);
+
+  CU_ASSERT(2 == session->num_idle_streams);
+
+  CU_ASSERT(3 == session->idle_stream_head->stream_id);
+  CU_ASSERT(5 == session->idle_stream_tail->stream_id);
+
+  nghttp2_session_del(session);
+}
+
+void test_nghttp2_session_detach_idle_stream(void) {
+  nghttp2_session *session;
+  nghttp2_session_callbacks callbacks;
+  int i;
+  nghttp2_stream *stream;
+
+  memset(&callbacks, 0, sizeof(callbacks));
+  callbacks.send_callback = null_send_callback;
+
+  nghttp2_session_server_new(&session, &callbacks, NULL);
+
+  for (i = 1; i <= 3; ++i) {
+    nghttp2_session_open_stream(session, i, NGHTTP2_STREAM_FLAG_NONE,
+                                &pri_spec_default, NGHTTP2_STREAM_IDLE, NULL);
+  }
+
+  CU_ASSERT(3 == session->num_idle_streams);
 
   /* Detach middle stream */
   stream = nghttp2_session_get_stream_raw(session, 2);
@@ -7437,6 +7994,379 @@ void test_nghttp2_session_send_data_callback(void) {
   nghttp2_session_del(session);
 }
 
+void test_nghttp2_session_mem_sendv(void) {
+  nghttp2_session *session, *session2;
+  nghttp2_session_callbacks callbacks;
+  nghttp2_data_provider data_prd;
+  my_user_data ud, ud2;
+  accumulator acc, acc2;
+  nghttp2_vec vec[16];
+  nghttp2_session_stats stats, stats2;
+  const uint8_t *data;
+  ssize_t rv;
+  ssize_t i;
+  nghttp2_frame_hd hd;
+
+  memset(&callbacks, 0, sizeof(nghttp2_session_callbacks));
+  callbacks.send_callback = null_send_callback;
+
+  data_prd.read_callback = filled_data_source_read_callback;
+
+  /* nghttp2_session_mem_sendv() produces the same byte stream as
+     nghttp2_session_mem_send() does */
+  acc.length = 0;
+  ud.data_source_length = 40000;
+  acc2.length = 0;
+  ud2.data_source_length = 40000;
+
+  nghttp2_session_client_new(&session, &callbacks, &ud);
+  nghttp2_session_client_new(&session2, &callbacks, &ud2);
+
+  nghttp2_submit_settings(session, NGHTTP2_FLAG_NONE, NULL, 0);
+  nghttp2_submit_request(session, NULL, reqnv, ARRLEN(reqnv), &data_prd, NULL);
+  nghttp2_submit_ping(session, NGHTTP2_FLAG_NONE, NULL);
+
+  nghttp2_submit_settings(session2, NGHTTP2_FLAG_NONE, NULL, 0);
+  nghttp2_submit_request(session2, NULL, reqnv, ARRLEN(reqnv), &data_prd,
+                         NULL);
+  nghttp2_submit_ping(session2, NGHTTP2_FLAG_NONE, NULL);
+
+  for (;;) {
+    rv = nghttp2_session_mem_send(session, &data);
+
+    CU_ASSERT(rv >= 0);
+
+    if (rv <= 0) {
+      break;
+    }
+
+    memcpy(acc.buf + acc.length, data, (size_t)rv);
+    acc.length += (size_t)rv;
+  }
+
+  /* SETTINGS, HEADERS, PING and first DATA */
+  rv = nghttp2_session_mem_sendv(session2, vec, 4);
+
+  CU_ASSERT(4 == rv);
+
+  for (;;) {
+    CU_ASSERT(rv >= 0);
+
+    if (rv <= 0) {
+      break;
+    }
+
+    for (i = 0; i < rv; ++i) {
+      memcpy(acc2.buf + acc2.length, vec[i].base, vec[i].len);
+      acc2.length += vec[i].len;
+    }
+
+    rv = nghttp2_session_mem_sendv(session2, vec, ARRLEN(vec));
+  }
+
+  CU_ASSERT(acc.length > 40000);
+  CU_ASSERT(acc.length == acc2.length);
+  CU_ASSERT(0 == memcmp(acc.buf, acc2.buf, acc.length));
+
+  nghttp2_session_get_stats(session, &stats);
+  nghttp2_session_get_stats(session2, &stats2);
+
+  CU_ASSERT(3 == stats.frames_sent[NGHTTP2_DATA]);
+  CU_ASSERT(0 == memcmp(stats.frames_sent, stats2.frames_sent,
+                        sizeof(stats.frames_sent)));
+  CU_ASSERT(0 == memcmp(stats.bytes_sent, stats2.bytes_sent,
+                        sizeof(stats.bytes_sent)));
+
+  nghttp2_session_del(session2);
+  nghttp2_session_del(session);
+
+  /* DATA payload refers to application memory with no copy */
+  callbacks.get_data_vec_callback = get_data_vec_callback;
+  callbacks.select_padding_callback = select_padding_callback;
+
+  data_prd.read_callback = no_copy_data_source_read_callback;
+
+  ud.data_source_length = 100;
+  ud.padlen = 10;
+  ud.block_count = 1;
+
+  nghttp2_session_client_new(&session, &callbacks, &ud);
+
+  nghttp2_session_open_stream(session, 1, NGHTTP2_STREAM_FLAG_NONE,
+                              &pri_spec_default, NGHTTP2_STREAM_OPENING, NULL);
+
+  nghttp2_submit_data(session, NGHTTP2_FLAG_END_STREAM, 1, &data_prd);
+
+  rv = nghttp2_session_mem_sendv(session, vec, ARRLEN(vec));
+
+  CU_ASSERT(0 == rv);
+
+  rv = nghttp2_session_mem_sendv(session, vec, ARRLEN(vec));
+
+  CU_ASSERT(4 == rv);
+  CU_ASSERT(NGHTTP2_FRAME_HDLEN + 1 == vec[0].len);
+
+  nghttp2_frame_unpack_frame_hd(&hd, vec[0].base);
+
+  CU_ASSERT(100 + 10 == hd.length);
+  CU_ASSERT(NGHTTP2_DATA == hd.type);
+  CU_ASSERT((NGHTTP2_FLAG_END_STREAM | NGHTTP2_FLAG_PADDED) == hd.flags);
+  CU_ASSERT(10 - 1 == vec[0].base[NGHTTP2_FRAME_HDLEN]);
+  CU_ASSERT(get_data_vec_payload == vec[1].base);
+  CU_ASSERT(50 == vec[1].len);
+  CU_ASSERT(get_data_vec_payload + 50 == vec[2].base);
+  CU_ASSERT(50 == vec[2].len);
+  CU_ASSERT(10 - 1 == vec[3].len);
+
+  CU_ASSERT(0 == nghttp2_session_mem_sendv(session, vec, ARRLEN(vec)));
+
+  nghttp2_session_del(session);
+}
+
+void test_nghttp2_session_get_stats(void) {
+  nghttp2_session *session;
+  nghttp2_session_callbacks callbacks;
+  nghttp2_session_stats stats;
+  nghttp2_data_provider data_prd;
+  my_user_data ud;
+  nghttp2_bufs bufs;
+  nghttp2_buf *buf;
+  nghttp2_hd_deflater deflater;
+  nghttp2_frame_hd hd;
+  nghttp2_stream *stream;
+  nghttp2_mem *mem;
+  uint8_t settings[NGHTTP2_FRAME_HDLEN];
+  size_t i, nvbytes;
+  ssize_t rv;
+
+  mem = nghttp2_mem_default();
+  frame_pack_bufs_init(&bufs);
+
+  memset(&callbacks, 0, sizeof(nghttp2_session_callbacks));
+  /* Short writes must not be counted twice */
+  callbacks.send_callback = fixed_bytes_send_callback;
+
+  ud.fixed_sendlen = 5;
+
+  nghttp2_session_client_new(&session, &callbacks, &ud);
+
+  nghttp2_submit_request(session, NULL, reqnv, ARRLEN(reqnv), NULL, NULL);
+  nghttp2_submit_ping(session, NGHTTP2_FLAG_NONE, NULL);
+
+  nghttp2_session_get_stats(session, &stats);
+
+  CU_ASSERT(1 == stats.ob_urgent_len);
+  CU_ASSERT(0 == stats.ob_reg_len);
+  CU_ASSERT(1 == stats.ob_syn_len);
+  CU_ASSERT(0 == stats.ob_data_len);
+
+  CU_ASSERT(0 == nghttp2_session_send(session));
+
+  nghttp2_session_get_stats(session, &stats);
+
+  CU_ASSERT(0 == stats.ob_urgent_len);
+  CU_ASSERT(0 == stats.ob_syn_len);
+  CU_ASSERT(1 == stats.frames_sent[NGHTTP2_PING]);
+  CU_ASSERT(NGHTTP2_FRAME_HDLEN + 8 == stats.bytes_sent[NGHTTP2_PING]);
+  CU_ASSERT(1 == stats.frames_sent[NGHTTP2_HEADERS]);
+  CU_ASSERT(NGHTTP2_FRAME_HDLEN + stats.deflate_hd_bytes ==
+            stats.bytes_sent[NGHTTP2_HEADERS]);
+
+  nvbytes = 0;
+  for (i = 0; i < ARRLEN(reqnv); ++i) {
+    nvbytes += reqnv[i].namelen + reqnv[i].valuelen;
+  }
+
+  CU_ASSERT(nvbytes == stats.deflate_nv_bytes);
+  CU_ASSERT(0 < stats.deflate_hd_bytes);
+  CU_ASSERT(stats.deflate_hd_bytes < stats.deflate_nv_bytes);
+
+  /* Receive SETTINGS and response HEADERS */
+  hd.length = 0;
+  hd.type = NGHTTP2_SETTINGS;
+  hd.flags = NGHTTP2_FLAG_NONE;
+  hd.stream_id = 0;
+  nghttp2_frame_pack_frame_hd(settings, &hd);
+
+  rv = nghttp2_session_mem_recv(session, settings, sizeof(settings));
+
+  CU_ASSERT(sizeof(settings) == rv);
+
+  nghttp2_hd_deflate_init(&deflater, mem);
+
+  rv = pack_headers(&bufs, &deflater, 1, NGHTTP2_FLAG_END_HEADERS, resnv,
+                    ARRLEN(resnv), mem);
+
+  CU_ASSERT(0 == rv);
+
+  buf = &bufs.head->buf;
+
+  rv = nghttp2_session_mem_recv(session, buf->pos, nghttp2_buf_len(buf));
+
+  CU_ASSERT((ssize_t)nghttp2_buf_len(buf) == rv);
+
+  nghttp2_session_get_stats(session, &stats);
+
+  CU_ASSERT(1 == stats.frames_recv[NGHTTP2_SETTINGS]);
+  CU_ASSERT(NGHTTP2_FRAME_HDLEN == stats.bytes_recv[NGHTTP2_SETTINGS]);
+  CU_ASSERT(1 == stats.frames_recv[NGHTTP2_HEADERS]);
+  CU_ASSERT(nghttp2_buf_len(buf) == stats.bytes_recv[NGHTTP2_HEADERS]);
+  CU_ASSERT(nghttp2_buf_len(buf) - NGHTTP2_FRAME_HDLEN ==
+            stats.inflate_hd_bytes);
+  CU_ASSERT(resnv[0].namelen + resnv[0].valuelen == stats.inflate_nv_bytes);
+
+  nghttp2_hd_deflate_free(&deflater);
+  nghttp2_bufs_free(&bufs);
+
+  /* DATA is blocked by stream level flow control window */
+  stream = nghttp2_session_open_stream(session, 3, NGHTTP2_STREAM_FLAG_NONE,
+                                       &pri_spec_default,
+                                       NGHTTP2_STREAM_OPENED, NULL);
+  stream->remote_window_size = 0;
+
+  data_prd.read_callback = fixed_length_data_source_read_callback;
+  ud.data_source_length = 1;
+
+  rv = nghttp2_submit_data(session, NGHTTP2_FLAG_END_STREAM, 3, &data_prd);
+
+  CU_ASSERT(0 == rv);
+
+  nghttp2_session_get_stats(session, &stats);
+
+  CU_ASSERT(1 == stats.ob_data_len);
+
+  CU_ASSERT(0 == nghttp2_session_send(session));
+
+  nghttp2_session_get_stats(session, &stats);
+
+  CU_ASSERT(1 == stats.data_blocked);
+  CU_ASSERT(0 == stats.ob_data_len);
+  CU_ASSERT(0 == stats.frames_sent[NGHTTP2_DATA]);
+
+  nghttp2_session_del(session);
+}
+
+void test_nghttp2_session_window_auto_tuning(void) {
+  nghttp2_session *session;
+  nghttp2_session_callbacks callbacks;
+  nghttp2_option *option;
+  nghttp2_outbound_item *item;
+  nghttp2_stream *stream;
+  nghttp2_frame_hd hd;
+  uint8_t data[NGHTTP2_FRAME_HDLEN + 4096];
+  uint8_t ping[NGHTTP2_FRAME_HDLEN + 8];
+  ssize_t rv;
+  int i;
+
+  memset(&callbacks, 0, sizeof(nghttp2_session_callbacks));
+  callbacks.send_callback = null_send_callback;
+
+  nghttp2_option_new(&option);
+  nghttp2_option_set_window_auto_tuning(option, 1 << 20);
+
+  nghttp2_session_client_new2(&session, &callbacks, NULL, option);
+
+  CU_ASSERT(1 << 20 == session->window_tuner.max_window_size);
+
+  stream = nghttp2_session_open_stream(session, 1, NGHTTP2_STREAM_FLAG_NONE,
+                                       &pri_spec_default,
+                                       NGHTTP2_STREAM_OPENED, NULL);
+
+  memset(data, 0, sizeof(data));
+  hd.length = 4096;
+  hd.type = NGHTTP2_DATA;
+  hd.flags = NGHTTP2_FLAG_NONE;
+  hd.stream_id = 1;
+  nghttp2_frame_pack_frame_hd(data, &hd);
+
+  memset(ping, 0, sizeof(ping));
+  hd.length = 8;
+  hd.type = NGHTTP2_PING;
+  hd.flags = NGHTTP2_FLAG_ACK;
+  hd.stream_id = 0;
+  nghttp2_frame_pack_frame_hd(ping, &hd);
+  memcpy(ping + NGHTTP2_FRAME_HDLEN, "nghttp2w", 8);
+
+  /* First DATA queues PING to measure round trip time */
+  rv = nghttp2_session_mem_recv(session, data, sizeof(data));
+  CU_ASSERT(sizeof(data) == rv);
+
+  item = nghttp2_session_get_next_ob_item(session);
+  CU_ASSERT(NGHTTP2_PING == item->frame.hd.type);
+  CU_ASSERT(0 == memcmp("nghttp2w", item->frame.ping.opaque_data, 8));
+  CU_ASSERT(session->window_tuner.ping_pending);
+  CU_ASSERT(0 == session->window_tuner.ping_sent_time);
+
+  /* The clock starts when PING is actually sent */
+  CU_ASSERT(0 == nghttp2_session_send(session));
+  CU_ASSERT(0 != session->window_tuner.ping_sent_time);
+
+  rv = nghttp2_session_mem_recv(session, ping, sizeof(ping));
+  CU_ASSERT(sizeof(ping) == rv);
+
+  CU_ASSERT(!session->window_tuner.ping_pending);
+  CU_ASSERT(0 != session->window_tuner.rtt);
+
+  /* Round trip time is not measured again so soon */
+  rv = nghttp2_session_mem_recv(session, data, sizeof(data));
+  CU_ASSERT(sizeof(data) == rv);
+
+  CU_ASSERT(!session->window_tuner.ping_pending);
+
+  /* With 1 second round trip time, consuming half of the window in
+     no time needs much larger window */
+  session->window_tuner.rtt = 1000000;
+  session->window_tuner.last_update_time = nghttp2_time_now_usec();
+
+  for (i = 2; i < 8; ++i) {
+    rv = nghttp2_session_mem_recv(session, data, sizeof(data));
+    CU_ASSERT(sizeof(data) == rv);
+  }
+
+  CU_ASSERT(2 * NGHTTP2_INITIAL_CONNECTION_WINDOW_SIZE ==
+            session->window_tuner.window_size);
+  CU_ASSERT(2 * NGHTTP2_INITIAL_CONNECTION_WINDOW_SIZE ==
+            session->local_window_size);
+  /* Stream window follows the connection window as it receives
+     DATA */
+  CU_ASSERT(2 * NGHTTP2_INITIAL_CONNECTION_WINDOW_SIZE ==
+            stream->local_window_size);
+
+  /* Consuming half of the window in 1 second with 1 microsecond
+     round trip time shrinks window, but not below the initial window
+     size */
+  session->window_tuner.rtt = 1;
+  session->window_tuner.last_update_time = nghttp2_time_now_usec() - 1000000;
+
+  for (i = 0; i < 16; ++i) {
+    rv = nghttp2_session_mem_recv(session, data, sizeof(data));
+    CU_ASSERT(sizeof(data) == rv);
+  }
+
+  CU_ASSERT(NGHTTP2_INITIAL_CONNECTION_WINDOW_SIZE ==
+            session->local_window_size);
+
+  /* PING ACK with unrelated opaque data is ignored */
+  session->window_tuner.ping_ack_time = 0;
+
+  rv = nghttp2_session_mem_recv(session, data, sizeof(data));
+  CU_ASSERT(sizeof(data) == rv);
+  CU_ASSERT(session->window_tuner.ping_pending);
+
+  CU_ASSERT(0 == nghttp2_session_send(session));
+
+  memcpy(ping + NGHTTP2_FRAME_HDLEN, "nghttp2x", 8);
+
+  rv = nghttp2_session_mem_recv(session, ping, sizeof(ping));
+  CU_ASSERT(sizeof(ping) == rv);
+
+  CU_ASSERT(session->window_tuner.ping_pending);
+  CU_ASSERT(0 != session->window_tuner.ping_sent_time);
+
+  nghttp2_session_del(session);
+  nghttp2_option_del(option);
+}
+
 void test_nghttp2_session_on_begin_headers_temporal_failure(void) {
   nghttp2_session *session;
   nghttp2_session_callbacks callbacks;
@@ -7509,6 +8439,130 @@ void test_nghttp2_session_on_begin_headers_temporal_failure(void) {
   nghttp2_bufs_free(&bufs);
 }
 
+void test_nghttp2_session_on_header_callback2(void) {
+  nghttp2_session *session;
+  nghttp2_session_callbacks callbacks;
+  my_user_data ud;
+  nghttp2_bufs bufs;
+  nghttp2_mem *mem;
+  ssize_t rv;
+  nghttp2_hd_deflater deflater;
+  size_t i;
+
+  mem = nghttp2_mem_default();
+  frame_pack_bufs_init(&bufs);
+  nghttp2_hd_deflate_init(&deflater, mem);
+
+  memset(&callbacks, 0, sizeof(nghttp2_session_callbacks));
+  callbacks.on_header_callback = on_header_callback;
+  callbacks.on_header_callback2 = keep_on_header_callback2;
+  nghttp2_session_server_new(&session, &callbacks, &ud);
+
+  ud.header_cb_called = 0;
+  ud.rcnvlen = 0;
+
+  /* The second HEADERS refers to the header fields indexed by the
+     first one. */
+  for (i = 0; i < 2; ++i) {
+    nghttp2_bufs_reset(&bufs);
+
+    rv = pack_headers(&bufs, &deflater, (int32_t)(i * 2 + 1),
+                      NGHTTP2_FLAG_END_HEADERS | NGHTTP2_FLAG_END_STREAM,
+                      reqnv, ARRLEN(reqnv), mem);
+    CU_ASSERT(0 == rv);
+
+    rv = nghttp2_session_mem_recv(session, bufs.head->buf.pos,
+                                  nghttp2_bufs_len(&bufs));
+    CU_ASSERT((ssize_t)nghttp2_bufs_len(&bufs) == rv);
+  }
+
+  CU_ASSERT(ARRLEN(reqnv) * 2 == (size_t)ud.header_cb_called);
+  CU_ASSERT(ARRLEN(reqnv) * 2 == ud.rcnvlen);
+
+  /* :authority is indexed, and shared between 2 requests */
+  CU_ASSERT(ud.rcnvs[3] == ud.rcnvs[ARRLEN(reqnv) + 3]);
+
+  /* Header fields are still valid after the callback returns */
+  for (i = 0; i < ud.rcnvlen; ++i) {
+    assert_nv_equal(&reqnv[i % ARRLEN(reqnv)],
+                    nghttp2_rcnv_get_nv(ud.rcnvs[i]), 1, mem);
+    nghttp2_rcnv_decref(ud.rcnvs[i]);
+  }
+
+  nghttp2_session_del(session);
+
+  nghttp2_hd_deflate_free(&deflater);
+  nghttp2_bufs_free(&bufs);
+}
+
+void test_nghttp2_session_slab(void) {
+  nghttp2_session *session;
+  nghttp2_session_callbacks callbacks;
+  nghttp2_option *option;
+  nghttp2_slab_stat stat;
+  size_t i;
+
+  memset(&callbacks, 0, sizeof(nghttp2_session_callbacks));
+  callbacks.send_callback = null_send_callback;
+
+  nghttp2_option_new(&option);
+  nghttp2_option_set_slab_size(option, 4);
+
+  nghttp2_session_client_new2(&session, &callbacks, NULL, option);
+
+  for (i = 0; i < 10; ++i) {
+    CU_ASSERT(0 < nghttp2_submit_request(session, NULL, reqnv, ARRLEN(reqnv),
+                                         NULL, NULL));
+  }
+
+  CU_ASSERT(0 == nghttp2_session_get_slab_stat(
+                     session, NGHTTP2_SLAB_OUTBOUND_ITEM, &stat));
+  CU_ASSERT(3 == stat.nslabs);
+  CU_ASSERT(12 == stat.capacity);
+  CU_ASSERT(10 == stat.used);
+
+  CU_ASSERT(0 ==
+            nghttp2_session_get_slab_stat(session, NGHTTP2_SLAB_STREAM, &stat));
+  CU_ASSERT(0 == stat.nslabs);
+  CU_ASSERT(0 == stat.used);
+
+  CU_ASSERT(0 == nghttp2_session_send(session));
+
+  /* Items are returned to slab after they are sent, and streams are
+     opened. */
+  CU_ASSERT(0 == nghttp2_session_get_slab_stat(
+                     session, NGHTTP2_SLAB_OUTBOUND_ITEM, &stat));
+  CU_ASSERT(3 == stat.nslabs);
+  CU_ASSERT(0 == stat.used);
+
+  CU_ASSERT(0 ==
+            nghttp2_session_get_slab_stat(session, NGHTTP2_SLAB_STREAM, &stat));
+  CU_ASSERT(3 == stat.nslabs);
+  CU_ASSERT(12 == stat.capacity);
+  CU_ASSERT(10 == stat.used);
+
+  /* Sending RST_STREAM reuses the slab of outbound items */
+  CU_ASSERT(0 == nghttp2_submit_rst_stream(session, NGHTTP2_FLAG_NONE, 1,
+                                           NGHTTP2_CANCEL));
+  CU_ASSERT(0 == nghttp2_session_send(session));
+
+  CU_ASSERT(0 == nghttp2_session_get_slab_stat(
+                     session, NGHTTP2_SLAB_OUTBOUND_ITEM, &stat));
+  CU_ASSERT(3 == stat.nslabs);
+  CU_ASSERT(0 == stat.used);
+
+  CU_ASSERT(0 ==
+            nghttp2_session_get_slab_stat(session, NGHTTP2_SLAB_STREAM, &stat));
+  CU_ASSERT(9 == stat.used);
+
+  CU_ASSERT(NGHTTP2_ERR_INVALID_ARGUMENT ==
+            nghttp2_session_get_slab_stat(session, (nghttp2_slab_type)100,
+                                          &stat));
+
+  nghttp2_session_del(session);
+  nghttp2_option_del(option);
+}
+
 void test_nghttp2_session_defer_then_close(void) {
   nghttp2_session *session;
   nghttp2_session_callbacks callbacks;
@@ -7548,6 +8602,194 @@ void test_nghttp2_session_defer_then_close(void) {
   nghttp2_session_del(session);
 }
 
+static void submission_queue_wakeup(nghttp2_submission_queue *q _U_,
+                                    void *user_data) {
+  ++*(int *)user_data;
+}
+
+/* Defers until a producer gives the data through data_source_length */
+static ssize_t defer_empty_data_source_read_callback(
+    nghttp2_session *session, int32_t stream_id, uint8_t *buf, size_t len,
+    uint32_t *data_flags, nghttp2_data_source *source, void *user_data) {
+  my_user_data *ud = (my_user_data *)user_data;
+
+  if (ud->data_source_length == 0) {
+    return NGHTTP2_ERR_DEFERRED;
+  }
+
+  return fixed_length_data_source_read_callback(session, stream_id, buf, len,
+                                                data_flags, source, user_data);
+}
+
+void test_nghttp2_session_submission_queue(void) {
+  nghttp2_session *session;
+  nghttp2_session_callbacks callbacks;
+  nghttp2_submission_queue *q;
+  nghttp2_data_provider data_prd;
+  nghttp2_stream *stream;
+  my_user_data ud;
+  int wakeup = 0;
+
+  memset(&callbacks, 0, sizeof(callbacks));
+  callbacks.send_callback = null_send_callback;
+  callbacks.on_frame_send_callback = on_frame_send_callback;
+
+  data_prd.read_callback = defer_empty_data_source_read_callback;
+
+  CU_ASSERT(0 == nghttp2_submission_queue_new(&q, submission_queue_wakeup,
+                                              &wakeup, NULL));
+
+  nghttp2_session_server_new(&session, &callbacks, &ud);
+  nghttp2_session_set_submission_queue(session, q);
+
+  open_stream(session, 1);
+  open_stream(session, 3);
+
+  CU_ASSERT(0 == nghttp2_session_want_write(session));
+
+  ud.data_source_length = 0;
+
+  CU_ASSERT(0 == nghttp2_submission_queue_submit_response(
+                     q, 1, resnv, ARRLEN(resnv), &data_prd));
+  CU_ASSERT(1 == wakeup);
+
+  /* wakeup is coalesced until the queue is drained */
+  CU_ASSERT(0 == nghttp2_submission_queue_submit_rst_stream(q, 3,
+                                                            NGHTTP2_CANCEL));
+  CU_ASSERT(1 == wakeup);
+
+  /* Stream 5 does not exist; the request is discarded */
+  CU_ASSERT(0 == nghttp2_submission_queue_submit_headers(
+                     q, NGHTTP2_FLAG_END_STREAM, 5, resnv, ARRLEN(resnv)));
+  CU_ASSERT(NGHTTP2_ERR_INVALID_ARGUMENT ==
+            nghttp2_submission_queue_resume_data(q, 0));
+  CU_ASSERT(NGHTTP2_ERR_INVALID_ARGUMENT ==
+            nghttp2_submission_queue_submit_headers(q, NGHTTP2_FLAG_NONE, -1,
+                                                    reqnv, ARRLEN(reqnv)));
+
+  CU_ASSERT(1 == nghttp2_session_want_write(session));
+
+  ud.frame_send_cb_called = 0;
+
+  CU_ASSERT(0 == nghttp2_session_send(session));
+  /* HEADERS for stream 1 and RST_STREAM for stream 3 */
+  CU_ASSERT(2 == ud.frame_send_cb_called);
+  CU_ASSERT(NULL == nghttp2_session_get_stream(session, 3));
+  CU_ASSERT(nghttp2_submission_queue_empty(q));
+
+  stream = nghttp2_session_get_stream(session, 1);
+
+  CU_ASSERT(nghttp2_stream_check_deferred_by_flow_control(stream) == 0);
+  CU_ASSERT(stream->flags & NGHTTP2_STREAM_FLAG_DEFERRED_USER);
+
+  /* Producer makes data available, and asks to resume */
+  ud.data_source_length = 100;
+
+  CU_ASSERT(0 == nghttp2_submission_queue_resume_data(q, 1));
+  CU_ASSERT(2 == wakeup);
+
+  ud.frame_send_cb_called = 0;
+
+  CU_ASSERT(0 == nghttp2_session_send(session));
+  CU_ASSERT(1 == ud.frame_send_cb_called);
+  CU_ASSERT(0 == ud.data_source_length);
+
+  /* The requests left in the queue are freed with it */
+  CU_ASSERT(0 == nghttp2_submission_queue_submit_headers(
+                     q, NGHTTP2_FLAG_NONE, 1, resnv, ARRLEN(resnv)));
+
+  nghttp2_session_set_submission_queue(session, NULL);
+
+  CU_ASSERT(0 == nghttp2_session_want_write(session));
+
+  nghttp2_session_del(session);
+  nghttp2_submission_queue_del(q);
+}
+
+void test_nghttp2_session_reset(void) {
+  nghttp2_session *session;
+  nghttp2_session_callbacks callbacks;
+  nghttp2_hd_deflater deflater;
+  nghttp2_bufs bufs;
+  nghttp2_mem *mem;
+  nghttp2_data_provider data_prd;
+  ssize_t rv;
+  my_user_data ud, ud2;
+  const nghttp2_nv nv[] = {MAKE_NV(":status", "200"),
+                           MAKE_NV("x-session", "first")};
+
+  mem = nghttp2_mem_default();
+  frame_pack_bufs_init(&bufs);
+
+  memset(&callbacks, 0, sizeof(callbacks));
+  callbacks.send_callback = null_send_callback;
+  callbacks.on_frame_recv_callback = on_frame_recv_callback;
+
+  data_prd.read_callback = fixed_length_data_source_read_callback;
+
+  nghttp2_session_server_new(&session, &callbacks, &ud);
+
+  nghttp2_hd_deflate_init(&deflater, mem);
+
+  rv = pack_headers(&bufs, &deflater, 1,
+                    NGHTTP2_FLAG_END_HEADERS | NGHTTP2_FLAG_END_STREAM, reqnv,
+                    ARRLEN(reqnv), mem);
+  CU_ASSERT(0 == rv);
+
+  rv = nghttp2_session_mem_recv(session, bufs.head->buf.pos,
+                                nghttp2_buf_len(&bufs.head->buf));
+  CU_ASSERT((ssize_t)nghttp2_buf_len(&bufs.head->buf) == rv);
+  CU_ASSERT(NULL != nghttp2_session_get_stream(session, 1));
+  CU_ASSERT(session->hd_inflater.ctx.hd_table.len > 0);
+
+  /* Leave a response and a PING in the queues, with DATA not sent
+     completely */
+  ud.data_source_length = 64 * 1024;
+  CU_ASSERT(0 == nghttp2_submit_response(session, 1, nv, ARRLEN(nv),
+                                         &data_prd));
+  CU_ASSERT(0 == nghttp2_submit_ping(session, NGHTTP2_FLAG_NONE, NULL));
+  CU_ASSERT(0 == nghttp2_session_send(session));
+  CU_ASSERT(session->hd_deflater.ctx.hd_table.len > 0);
+  CU_ASSERT(0 == nghttp2_submit_ping(session, NGHTTP2_FLAG_NONE, NULL));
+  CU_ASSERT(nghttp2_session_want_write(session));
+
+  nghttp2_session_reset(session, NULL, &ud2);
+
+  CU_ASSERT(&ud2 == session->user_data);
+  CU_ASSERT(NULL == nghttp2_session_get_stream(session, 1));
+  CU_ASSERT(0 == nghttp2_map_size(&session->streams));
+  CU_ASSERT(0 == session->hd_inflater.ctx.hd_table.len);
+  CU_ASSERT(0 == session->hd_deflater.ctx.hd_table.len);
+  CU_ASSERT(0 == session->last_recv_stream_id);
+  CU_ASSERT(2 == session->next_stream_id);
+  CU_ASSERT(NGHTTP2_INITIAL_CONNECTION_WINDOW_SIZE ==
+            session->remote_window_size);
+  CU_ASSERT(0 == nghttp2_session_want_write(session));
+  CU_ASSERT(NULL == nghttp2_session_get_next_ob_item(session));
+
+  /* The next connection starts with a fresh HPACK context */
+  nghttp2_hd_deflate_free(&deflater);
+  nghttp2_hd_deflate_init(&deflater, mem);
+  nghttp2_bufs_reset(&bufs);
+
+  rv = pack_headers(&bufs, &deflater, 1,
+                    NGHTTP2_FLAG_END_HEADERS | NGHTTP2_FLAG_END_STREAM, reqnv,
+                    ARRLEN(reqnv), mem);
+  CU_ASSERT(0 == rv);
+
+  ud2.frame_recv_cb_called = 0;
+
+  rv = nghttp2_session_mem_recv(session, bufs.head->buf.pos,
+                                nghttp2_buf_len(&bufs.head->buf));
+  CU_ASSERT((ssize_t)nghttp2_buf_len(&bufs.head->buf) == rv);
+  CU_ASSERT(1 == ud2.frame_recv_cb_called);
+  CU_ASSERT(NULL != nghttp2_session_get_stream(session, 1));
+
+  nghttp2_hd_deflate_free(&deflater);
+  nghttp2_bufs_free(&bufs);
+  nghttp2_session_del(session);
+}
+
 static void check_nghttp2_http_recv_headers_fail(
     nghttp2_session *session, nghttp2_hd_deflater *deflater, int32_t stream_id,
     int stream_state, const nghttp2_nv *nva, size_t nvlen) {
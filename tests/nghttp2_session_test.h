@@ -30,6 +30,7 @@ void test_nghttp2_session_recv_invalid_stream_id(void);
 void test_nghttp2_session_recv_invalid_frame(void);
 void test_nghttp2_session_recv_eof(void);
 void test_nghttp2_session_recv_data(void);
+void test_nghttp2_session_recv_control_frame_burst(void);
 void test_nghttp2_session_recv_data_no_auto_flow_control(void);
 void test_nghttp2_session_recv_continuation(void);
 void test_nghttp2_session_recv_headers_with_priority(void);
@@ -82,6 +83,7 @@ void test_nghttp2_submit_settings_update_local_window_size(void);
 void test_nghttp2_submit_push_promise(void);
 void test_nghttp2_submit_window_update(void);
 void test_nghttp2_submit_window_update_local_window_size(void);
+void test_nghttp2_session_window_update_coalescing(void);
 void test_nghttp2_submit_shutdown_notice(void);
 void test_nghttp2_submit_invalid_nv(void);
 void test_nghttp2_session_open_stream(void);
@@ -113,7 +115,10 @@ void test_nghttp2_session_stream_dep_remove_subtree(void);
 void test_nghttp2_session_stream_dep_all_your_stream_are_belong_to_us(void);
 void test_nghttp2_session_stream_attach_item(void);
 void test_nghttp2_session_stream_attach_item_subtree(void);
+void test_nghttp2_session_stream_bandwidth_share(void);
 void test_nghttp2_session_keep_closed_stream(void);
+void test_nghttp2_session_promote_tombstone(void);
+void test_nghttp2_session_memory_budget(void);
 void test_nghttp2_session_keep_idle_stream(void);
 void test_nghttp2_session_detach_idle_stream(void);
 void test_nghttp2_session_large_dep_tree(void);
@@ -125,8 +130,15 @@ void test_nghttp2_session_open_idle_stream(void);
 void test_nghttp2_session_cancel_reserved_remote(void);
 void test_nghttp2_session_reset_pending_headers(void);
 void test_nghttp2_session_send_data_callback(void);
+void test_nghttp2_session_mem_sendv(void);
+void test_nghttp2_session_get_stats(void);
+void test_nghttp2_session_window_auto_tuning(void);
 void test_nghttp2_session_on_begin_headers_temporal_failure(void);
+void test_nghttp2_session_on_header_callback2(void);
+void test_nghttp2_session_slab(void);
 void test_nghttp2_session_defer_then_close(void);
+void test_nghttp2_session_submission_queue(void);
+void test_nghttp2_session_reset(void);
 void test_nghttp2_http_mandatory_headers(void);
 void test_nghttp2_http_content_length(void);
 void test_nghttp2_http_content_length_mismatch(void);